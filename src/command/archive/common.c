@@ -3,9 +3,12 @@ Archive Common
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <poll.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -16,6 +19,7 @@ Archive Common
 #include "common/memContext.h"
 #include "common/regExp.h"
 #include "common/type/convert.h"
+#include "common/type/pack.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "postgres/interface.h"
@@ -31,6 +35,12 @@ STRING_EXTERN(WAL_SEGMENT_DIR_REGEXP_STR,                           WAL_SEGMENT_
 STRING_EXTERN(WAL_SEGMENT_FILE_REGEXP_STR,                          WAL_SEGMENT_FILE_REGEXP);
 STRING_EXTERN(WAL_TIMELINE_HISTORY_REGEXP_STR,                      WAL_TIMELINE_HISTORY_REGEXP);
 
+/***********************************************************************************************************************************
+WAL bundle constants
+***********************************************************************************************************************************/
+STRING_EXTERN(WAL_BUNDLE_INDEX_REGEXP_STR,                          WAL_BUNDLE_INDEX_REGEXP);
+STRING_EXTERN(WAL_SEGMENT_FILE_BUNDLE_REGEXP_STR,                   WAL_SEGMENT_FILE_BUNDLE_REGEXP);
+
 /***********************************************************************************************************************************
 Global error file constant
 ***********************************************************************************************************************************/
@@ -293,6 +303,156 @@ archiveAsyncExec(const ArchiveMode archiveMode, const StringList *const commandE
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Notify a lingering async process
+
+While lingering, the async process listens on a Unix datagram socket in the lock path so the main process can notify it rather than
+starting a new async process. Notifications are only hints so it does not matter if one is sent when the async process is not
+listening -- the main process will acquire the lock and start a new async process as usual.
+***********************************************************************************************************************************/
+struct ArchiveAsyncListen
+{
+    int fd;                                                         // Socket
+    struct sockaddr_un address;                                     // Socket address
+};
+
+// Get the socket address
+static struct sockaddr_un
+archiveAsyncNotifyAddress(const ArchiveMode archiveMode)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, archiveMode);
+    FUNCTION_TEST_END();
+
+    struct sockaddr_un result = {.sun_family = AF_UNIX};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const file = strNewFmt(
+            "%s/%s-archive-%s.sock", strZ(cfgOptionStr(cfgOptLockPath)), strZ(cfgOptionStr(cfgOptStanza)),
+            archiveMode == archiveModeGet ? "get" : "push");
+
+        if (strSize(file) >= sizeof(result.sun_path))
+        {
+            THROW_FMT(
+                OptionInvalidValueError, "socket '%s' is too long for '%s' option\nHINT: use a shorter '" CFGOPT_LOCK_PATH "'.",
+                strZ(file), archiveMode == archiveModeGet ? CFGOPT_ARCHIVE_GET_LINGER : CFGOPT_ARCHIVE_PUSH_LINGER);
+        }
+
+        memcpy(result.sun_path, strZ(file), strSize(file) + 1);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_TYPE(struct sockaddr_un, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+archiveAsyncNotify(const ArchiveMode archiveMode, const String *const message)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_ID, archiveMode);
+        FUNCTION_LOG_PARAM(STRING, message);
+    FUNCTION_LOG_END();
+
+    ASSERT(message != NULL);
+    ASSERT(strSize(message) < ARCHIVE_ASYNC_NOTIFY_SIZE);
+
+    const struct sockaddr_un address = archiveAsyncNotifyAddress(archiveMode);
+    const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+
+    THROW_ON_SYS_ERROR(fd == -1, FileOpenError, "unable to create socket");
+
+    // Errors are ignored since the async process may not be listening
+    sendto(fd, strZ(message), strSize(message), MSG_DONTWAIT, (const struct sockaddr *)&address, sizeof(address));
+    close(fd);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+static void
+archiveAsyncListenFreeResource(THIS_VOID)
+{
+    THIS(ArchiveAsyncListen);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    close(this->fd);
+    unlink(this->address.sun_path);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN ArchiveAsyncListen *
+archiveAsyncListenNew(const ArchiveMode archiveMode)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_ID, archiveMode);
+    FUNCTION_LOG_END();
+
+    const struct sockaddr_un address = archiveAsyncNotifyAddress(archiveMode);
+
+    OBJ_NEW_BEGIN(ArchiveAsyncListen, .callbackQty = 1)
+    {
+        *this = (ArchiveAsyncListen){.address = address};
+
+        // Remove the socket left by a prior async process, which is safe since the archive lock is held
+        unlink(this->address.sun_path);
+
+        this->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        THROW_ON_SYS_ERROR(this->fd == -1, FileOpenError, "unable to create socket");
+
+        memContextCallbackSet(objMemContext(this), archiveAsyncListenFreeResource, this);
+
+        THROW_ON_SYS_ERROR_FMT(
+            bind(this->fd, (const struct sockaddr *)&this->address, sizeof(this->address)) == -1, FileOpenError,
+            "unable to bind socket '%s'", this->address.sun_path);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(ARCHIVE_ASYNC_LISTEN, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+archiveAsyncListenWait(ArchiveAsyncListen *const this, const TimeMSec timeout)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(ARCHIVE_ASYNC_LISTEN, this);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    String *result = NULL;
+    struct pollfd pollFd = {.fd = this->fd, .events = POLLIN};
+    const int pollResult = poll(&pollFd, 1, (int)timeout);
+
+    THROW_ON_SYS_ERROR(pollResult == -1, FileReadError, "unable to poll socket");
+
+    // Drain all queued notifications and return the last one since it is the most recent
+    if (pollResult > 0)
+    {
+        char buffer[ARCHIVE_ASYNC_NOTIFY_SIZE];
+        ssize_t size;
+
+        result = strNew();
+
+        while ((size = recv(this->fd, buffer, sizeof(buffer), MSG_DONTWAIT)) != -1)
+        {
+            strTrunc(result);
+            strCatZN(result, buffer, (size_t)size);
+        }
+    }
+
+    FUNCTION_LOG_RETURN(STRING, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN int
 archiveIdComparator(const void *const archiveId1, const void *const archiveId2)
@@ -484,3 +644,158 @@ walSegmentRange(
 
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+walBundleIndexCover(const String *const index, const String *const walSegment)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, index);
+        FUNCTION_TEST_PARAM(STRING, walSegment);
+    FUNCTION_TEST_END();
+
+    ASSERT(index != NULL);
+    ASSERT(walSegment != NULL);
+    ASSERT(strSize(walSegment) >= WAL_SEGMENT_NAME_SIZE);
+
+    FUNCTION_TEST_RETURN(
+        BOOL,
+        strncmp(strZ(index), strZ(walSegment), WAL_SEGMENT_NAME_SIZE) <= 0 &&
+        strncmp(strZ(walSegment), strZ(index) + WAL_SEGMENT_NAME_SIZE + 1, WAL_SEGMENT_NAME_SIZE) <= 0);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN StringList *
+walBundleIndexListSplit(StringList *const fileList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, fileList);
+    FUNCTION_TEST_END();
+
+    ASSERT(fileList != NULL);
+
+    StringList *const result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        RegExp *const regExp = regExpNew(WAL_BUNDLE_INDEX_REGEXP_STR);
+
+        for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList);)
+        {
+            const String *const file = strLstGet(fileList, fileIdx);
+
+            if (strEndsWithZ(file, WAL_BUNDLE_INDEX_EXT) && regExpMatch(regExp, file))
+            {
+                strLstAdd(result, file);
+                strLstRemoveIdx(fileList, fileIdx);
+            }
+            else
+                fileIdx++;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STRING_LIST, result);
+}
+
+/***********************************************************************************************************************************
+The bundle index is a pack with the name and size of each WAL segment in the order they are stored in the bundle. Offsets are not
+stored since they can be calculated from the sizes.
+***********************************************************************************************************************************/
+FN_EXTERN List *
+walBundleIndexLoad(const Storage *const storage, const String *const path, const String *const index)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING, index);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(path != NULL);
+    ASSERT(index != NULL);
+    ASSERT(strEndsWithZ(index, WAL_BUNDLE_INDEX_EXT));
+
+    List *const result = lstNewP(sizeof(WalBundleFile), .comparator = lstComparatorStr);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackRead *const pack = pckReadNew(
+            pckFromBuf(storageGetP(storageNewReadP(storage, strNewFmt("%s/%s", strZ(path), strZ(index))))));
+        const String *bundle;
+        uint64_t offset = 0;
+
+        MEM_CONTEXT_OBJ_BEGIN(result)
+        {
+            bundle = strNewFmt("%s" WAL_BUNDLE_EXT, strZ(strSubN(index, 0, strSize(index) - (sizeof(WAL_BUNDLE_INDEX_EXT) - 1))));
+        }
+        MEM_CONTEXT_OBJ_END();
+
+        while (!pckReadNullP(pack))
+        {
+            pckReadObjBeginP(pack);
+
+            MEM_CONTEXT_OBJ_BEGIN(result)
+            {
+                WalBundleFile file = {.name = pckReadStrP(pack), .bundle = bundle, .offset = offset};
+                file.size = pckReadU64P(pack);
+
+                lstAdd(result, &file);
+                offset += file.size;
+            }
+            MEM_CONTEXT_OBJ_END();
+
+            pckReadObjEndP(pack);
+        }
+
+        pckReadEndP(pack);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+walBundleIndexSave(const Storage *const storage, const String *const path, const List *const fileList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(LIST, fileList);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(path != NULL);
+    ASSERT(fileList != NULL && !lstEmpty(fileList));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const pack = pckWriteNewP();
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
+        {
+            const WalBundleFile *const file = lstGet(fileList, fileIdx);
+
+            pckWriteObjBeginP(pack);
+            pckWriteStrP(pack, file->name);
+            pckWriteU64P(pack, file->size);
+            pckWriteObjEndP(pack);
+        }
+
+        pckWriteEndP(pack);
+
+        const String *const bundle = ((const WalBundleFile *)lstGet(fileList, 0))->bundle;
+
+        storagePutP(
+            storageNewWriteP(
+                storage,
+                strNewFmt(
+                    "%s/%s" WAL_BUNDLE_INDEX_EXT, strZ(path),
+                    strZ(strSubN(bundle, 0, strSize(bundle) - (sizeof(WAL_BUNDLE_EXT) - 1))))),
+            pckToBuf(pckWriteResult(pack)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
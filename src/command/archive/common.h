@@ -20,6 +20,8 @@ typedef enum
 } ArchiveMode;
 
 #include "common/compress/helper.h"
+#include "common/time.h"
+#include "common/type/object.h"
 #include "common/type/stringList.h"
 #include "storage/storage.h"
 
@@ -32,6 +34,14 @@ Status file extension constants
 #define STATUS_EXT_OK                                               ".ok"
 #define STATUS_EXT_OK_SIZE                                          (sizeof(STATUS_EXT_OK) - 1)
 
+/***********************************************************************************************************************************
+Async process notification object
+***********************************************************************************************************************************/
+typedef struct ArchiveAsyncListen ArchiveAsyncListen;
+
+// Maximum size of a notification
+#define ARCHIVE_ASYNC_NOTIFY_SIZE                                   64
+
 /***********************************************************************************************************************************
 WAL segment constants
 ***********************************************************************************************************************************/
@@ -62,6 +72,37 @@ STRING_DECLARE(WAL_SEGMENT_FILE_REGEXP_STR);
 #define WAL_TIMELINE_HISTORY_REGEXP                                 "^[0-F]{8}.history$"
 STRING_DECLARE(WAL_TIMELINE_HISTORY_REGEXP_STR);
 
+/***********************************************************************************************************************************
+WAL bundle constants
+
+WAL segments pushed together may be stored in a bundle, which is named for the first and last WAL segment it contains, e.g.
+000000010000000100000001-000000010000000100000008.bundle. Each WAL segment in the bundle is compressed/encrypted exactly as it would
+be if stored individually. The bundle index is written after the bundle with the same name and an .index extension. A bundle
+without an index is incomplete and will be ignored.
+***********************************************************************************************************************************/
+#define WAL_BUNDLE_EXT                                              ".bundle"
+#define WAL_BUNDLE_INDEX_EXT                                        ".index"
+
+// Match on a bundle index
+#define WAL_BUNDLE_INDEX_REGEXP                                     "^[0-F]{24}-[0-F]{24}\\.index$"
+STRING_DECLARE(WAL_BUNDLE_INDEX_REGEXP_STR);
+
+// Match on a WAL segment file or bundle index
+#define WAL_SEGMENT_FILE_BUNDLE_REGEXP                                                                                             \
+    "^([0-F]{24}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}|[0-F]{24}-[0-F]{24}\\.index)$"
+STRING_DECLARE(WAL_SEGMENT_FILE_BUNDLE_REGEXP_STR);
+
+/***********************************************************************************************************************************
+WAL segment stored in a bundle
+***********************************************************************************************************************************/
+typedef struct WalBundleFile
+{
+    const String *name;                                             // Name of the WAL segment if it were stored individually
+    const String *bundle;                                           // Bundle that contains the WAL segment
+    uint64_t offset;                                                // Offset of the WAL segment in the bundle
+    uint64_t size;                                                  // Size of the WAL segment in the bundle
+} WalBundleFile;
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
@@ -82,6 +123,21 @@ FN_EXTERN void archiveAsyncStatusErrorWrite(ArchiveMode archiveMode, const Strin
 // Execute the async process. This function will only return in the calling process and the implementation is platform dependent.
 FN_EXTERN void archiveAsyncExec(ArchiveMode archiveMode, const StringList *commandExec);
 
+// Notify a lingering async process. Errors are ignored since the async process may not be listening.
+FN_EXTERN void archiveAsyncNotify(ArchiveMode archiveMode, const String *message);
+
+// Listen for notifications in the async process. The archive lock must be held.
+FN_EXTERN ArchiveAsyncListen *archiveAsyncListenNew(ArchiveMode archiveMode);
+
+// Wait for notifications. Returns the most recent notification or NULL if the timeout expired before a notification was received.
+FN_EXTERN String *archiveAsyncListenWait(ArchiveAsyncListen *this, TimeMSec timeout);
+
+FN_INLINE_ALWAYS void
+archiveAsyncListenFree(ArchiveAsyncListen *const this)
+{
+    objFree(this);
+}
+
 // Comparator function for sorting archive ids by the database history id (the number after the dash) e.g. 9.4-1, 10-2
 FN_EXTERN int archiveIdComparator(const void *item1, const void *item2);
 
@@ -101,4 +157,25 @@ FN_EXTERN String *walSegmentNext(const String *walSegment, size_t walSegmentSize
 FN_EXTERN StringList *walSegmentRange(
     const String *walSegmentBegin, size_t walSegmentSize, unsigned int pgVersion, unsigned int range);
 
+// Is the WAL segment in the range of the bundle index? The WAL segment will only be in the bundle when it is also in the index.
+FN_EXTERN bool walBundleIndexCover(const String *index, const String *walSegment);
+
+// Move bundle indexes from a list of files to a new list, which is returned
+FN_EXTERN StringList *walBundleIndexListSplit(StringList *fileList);
+
+// Load a bundle index from the path. Returns a list of WalBundleFile in the order they are stored in the bundle, which is also
+// sorted by name.
+FN_EXTERN List *walBundleIndexLoad(const Storage *storage, const String *path, const String *index);
+
+// Save a bundle index to the path. The list of WalBundleFile must be sorted by name and stored in the bundle in that order.
+FN_EXTERN void walBundleIndexSave(const Storage *storage, const String *path, const List *fileList);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_ARCHIVE_ASYNC_LISTEN_TYPE                                                                                     \
+    ArchiveAsyncListen *
+#define FUNCTION_LOG_ARCHIVE_ASYNC_LISTEN_FORMAT(value, buffer, bufferSize)                                                        \
+    objNameToLog(value, "ArchiveAsyncListen", buffer, bufferSize)
+
 #endif
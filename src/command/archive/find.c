@@ -23,6 +23,10 @@ struct WalSegmentFind
     TimeMSec timeout;                                               // Timeout for each segment
     String *prefix;                                                 // Current list prefix
     StringList *list;                                               // List of found segments
+    StringList *indexList;                                          // List of found bundle indexes
+    List *bundleCache;                                              // Bundle indexes loaded for the current prefix
+    bool bundleFound;                                               // Was the last segment found in a bundle?
+    WalBundleFile bundle;                                           // Bundle file for the last segment found
 };
 
 /***********************************************************************************************************************************
@@ -75,6 +79,7 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
     ASSERT(walIsSegment(walSegment));
 
     String *result = NULL;
+    this->bundleFound = false;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -88,81 +93,119 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
 
         do
         {
-            // Get a list of all WAL segments that match the directory (and prefix when finding a single WAL)
+            // Get a list of all WAL segments and bundle indexes that match the directory (and prefix when finding a single WAL)
             if (this->list == NULL || !strEq(prefix, this->prefix))
             {
                 MEM_CONTEXT_OBJ_BEGIN(this)
                 {
-                    // Free and store prefix
+                    // Free and store prefix. Bundle indexes loaded for the prior prefix are no longer needed.
                     if (!strEq(prefix, this->prefix))
                     {
                         strFree(this->prefix);
                         this->prefix = strDup(prefix);
+
+                        lstFree(this->bundleCache);
+                        this->bundleCache = lstNewP(sizeof(WalBundleIndex), .comparator = lstComparatorStr);
                     }
 
-                    // Free list
+                    // Free lists
                     strLstFree(this->list);
+                    strLstFree(this->indexList);
 
                     // Get list
                     this->list = strLstSort(
-                        storageListP(this->storage, path, .expression = this->single ? expression : NULL), sortOrderAsc);
+                        storageListP(
+                            this->storage, path,
+                            .expression = this->single ?
+                                strNewFmt(
+                                    "^(%s|%s[0-F]{8}-%s[0-F]{8}\\" WAL_BUNDLE_INDEX_EXT ")$",
+                                    strZ(strSubN(expression, 1, strSize(expression) - 2)), strZ(prefix), strZ(prefix)) :
+                                NULL),
+                        sortOrderAsc);
+
+                    // Move bundle indexes to a separate list
+                    this->indexList = walBundleIndexListSplit(this->list);
                 }
                 MEM_CONTEXT_OBJ_END();
             }
 
-            // If there are results
-            if (!strLstEmpty(this->list))
-            {
-                // By default the match size is the list size since filtering happened above. When not finding a single WAL then
-                // non-matching entries before the matching WAL will need to be removed and then the matching WAL counted.
-                unsigned int match = strLstSize(this->list);
+            // By default the match size is the list size since filtering happened above. When not finding a single WAL then
+            // non-matching entries before the matching WAL will need to be removed and then the matching WAL counted.
+            unsigned int match = strLstSize(this->list);
 
-                if (!this->single)
+            if (!this->single)
+            {
+                // Build regexp if not yet built
+                if (regExp == NULL)
+                    regExp = regExpNew(expression);
+
+                // Remove list items before the WAL that do not match. This prevents us from having check them again on the next
+                // find.
+                while (
+                    !strLstEmpty(this->list) && !regExpMatch(regExp, strLstGet(this->list, 0)) &&
+                    strncmp(strZ(strLstGet(this->list, 0)), strZ(walSegment), WAL_SEGMENT_NAME_SIZE) <= 0)
                 {
-                    // Build regexp if not yet built
-                    if (regExp == NULL)
-                        regExp = regExpNew(expression);
+                    strLstRemoveIdx(this->list, 0);
+                }
 
-                    // Remove list items that do not match. This prevents us from having check them again on the next find.
-                    while (!strLstEmpty(this->list) && !regExpMatch(regExp, strLstGet(this->list, 0)))
-                        strLstRemoveIdx(this->list, 0);
+                // Find matches at the beginning of the remaining list
+                match = 0;
 
-                    // Find matches at the beginning of the remaining list
-                    match = 0;
+                while (match < strLstSize(this->list) && regExpMatch(regExp, strLstGet(this->list, match)))
+                    match++;
 
-                    while (match < strLstSize(this->list) && regExpMatch(regExp, strLstGet(this->list, match)))
-                        match++;
+                // Remove bundle indexes that end before the WAL since they cannot contain this or any later WAL
+                for (unsigned int indexIdx = 0; indexIdx < strLstSize(this->indexList);)
+                {
+                    if (strncmp(
+                            strZ(strLstGet(this->indexList, indexIdx)) + WAL_SEGMENT_NAME_SIZE + 1, strZ(walSegment),
+                            WAL_SEGMENT_NAME_SIZE) < 0)
+                    {
+                        strLstRemoveIdx(this->indexList, indexIdx);
+                    }
+                    else
+                        indexIdx++;
                 }
+            }
 
-                // Error if there is more than one match
-                if (match > 1)
-                {
-                    // Build list of duplicate WAL
-                    StringList *const matchList = strLstNew();
+            // Find matches in bundles
+            List *const bundleMatchList = lstNewP(sizeof(WalBundleFile));
+            walBundleFind(this->storage, path, this->indexList, this->bundleCache, walSegment, bundleMatchList);
 
-                    for (unsigned int matchIdx = 0; matchIdx < match; matchIdx++)
-                        strLstAdd(matchList, strLstGet(this->list, matchIdx));
+            // Error if there is more than one match
+            if (match + lstSize(bundleMatchList) > 1)
+            {
+                // Build list of duplicate WAL
+                StringList *const matchList = strLstNew();
 
-                    // Clear list for next find
-                    strLstFree(this->list);
-                    this->list = NULL;
+                for (unsigned int matchIdx = 0; matchIdx < match; matchIdx++)
+                    strLstAdd(matchList, strLstGet(this->list, matchIdx));
 
-                    THROW_FMT(
-                        ArchiveDuplicateError,
-                        "duplicates found in archive for WAL segment %s: %s\n"
-                        "HINT: are multiple primaries archiving to this stanza?",
-                        strZ(walSegment), strZ(strLstJoin(matchList, ", ")));
+                for (unsigned int matchIdx = 0; matchIdx < lstSize(bundleMatchList); matchIdx++)
+                {
+                    const WalBundleFile *const bundleMatch = lstGet(bundleMatchList, matchIdx);
+                    strLstAddFmt(matchList, "%s/%s", strZ(bundleMatch->bundle), strZ(bundleMatch->name));
                 }
 
-                // On match copy file name of WAL segment found into the prior context
-                if (match == 1)
+                // Clear list for next find
+                strLstFree(this->list);
+                this->list = NULL;
+
+                THROW_FMT(
+                    ArchiveDuplicateError,
+                    "duplicates found in archive for WAL segment %s: %s\n"
+                    "HINT: are multiple primaries archiving to this stanza?",
+                    strZ(walSegment), strZ(strLstJoin(matchList, ", ")));
+            }
+
+            // On match copy file name of WAL segment found into the prior context
+            if (match == 1)
+            {
+                MEM_CONTEXT_PRIOR_BEGIN()
                 {
-                    MEM_CONTEXT_PRIOR_BEGIN()
-                    {
-                        result = strDup(strLstGet(this->list, 0));
-                    }
-                    MEM_CONTEXT_PRIOR_END();
+                    result = strDup(strLstGet(this->list, 0));
                 }
+                MEM_CONTEXT_PRIOR_END();
 
                 // Remove matching entries so list will be reloaded when empty
                 if (!this->single)
@@ -173,9 +216,24 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
                         strLstRemoveIdx(this->list, 0);
                 }
             }
+            // Else on bundle match store the bundle file, which remains valid until the prefix changes
+            else if (!lstEmpty(bundleMatchList))
+            {
+                this->bundleFound = true;
+                this->bundle = *(WalBundleFile *)lstGet(bundleMatchList, 0);
 
-            // Clear list for next find
-            if (this->single || strLstEmpty(this->list))
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = strDup(this->bundle.name);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+
+            // Clear list for next find when finding a single WAL or when the list may be out of date because the WAL was not found
+            // or there is nothing left in the list. When there is no timeout the list is kept since WAL is not expected to arrive
+            // while searching.
+            if (this->single ||
+                (this->timeout != 0 && (result == NULL || (strLstEmpty(this->list) && strLstEmpty(this->indexList)))))
             {
                 strLstFree(this->list);
                 this->list = NULL;
@@ -200,6 +258,19 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
     FUNCTION_LOG_RETURN(STRING, result);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN const WalBundleFile *
+walSegmentFindBundle(const WalSegmentFind *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_SEGMENT_FIND, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN_TYPE_CONST_P(WalBundleFile, this->bundleFound ? &this->bundle : NULL);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 walSegmentFindOne(
@@ -228,3 +299,70 @@ walSegmentFindOne(
 
     FUNCTION_LOG_RETURN(STRING, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+walBundleFind(
+    const Storage *const storage, const String *const path, const StringList *const indexList, List *const cache,
+    const String *const walSegment, List *const result)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING_LIST, indexList);
+        FUNCTION_LOG_PARAM(LIST, cache);
+        FUNCTION_LOG_PARAM(STRING, walSegment);
+        FUNCTION_LOG_PARAM(LIST, result);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(path != NULL);
+    ASSERT(indexList != NULL);
+    ASSERT(cache != NULL);
+    ASSERT(walSegment != NULL);
+    ASSERT(result != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Files in the bundle are named for the WAL segment with a checksum appended. Partial WAL segments are never bundled.
+        const String *const fileBegin = strNewFmt("%s-", strZ(walSegment));
+
+        for (unsigned int indexIdx = 0; indexIdx < strLstSize(indexList); indexIdx++)
+        {
+            const String *const index = strLstGet(indexList, indexIdx);
+
+            if (!walBundleIndexCover(index, walSegment))
+                continue;
+
+            // Load the index if it is not in the cache. Indexes are never modified so they can be cached indefinitely.
+            const WalBundleIndex *bundleIndex = lstFind(cache, &index);
+
+            if (bundleIndex == NULL)
+            {
+                MEM_CONTEXT_OBJ_BEGIN(cache)
+                {
+                    const WalBundleIndex bundleIndexNew =
+                    {
+                        .index = strDup(index),
+                        .fileList = walBundleIndexLoad(storage, path, index),
+                    };
+
+                    bundleIndex = lstAdd(cache, &bundleIndexNew);
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+
+            // Add matching files to the result
+            for (unsigned int fileIdx = 0; fileIdx < lstSize(bundleIndex->fileList); fileIdx++)
+            {
+                const WalBundleFile *const file = lstGet(bundleIndex->fileList, fileIdx);
+
+                if (strBeginsWith(file->name, fileBegin))
+                    lstAdd(result, file);
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
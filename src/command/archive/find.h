@@ -11,9 +11,19 @@ Object type
 ***********************************************************************************************************************************/
 typedef struct WalSegmentFind WalSegmentFind;
 
+#include "command/archive/common.h"
 #include "common/type/string.h"
 #include "storage/storage.h"
 
+/***********************************************************************************************************************************
+Bundle index loaded into a cache by walBundleFind()
+***********************************************************************************************************************************/
+typedef struct WalBundleIndex
+{
+    const String *index;                                            // Bundle index name
+    List *fileList;                                                 // WalBundleFile list loaded from the index
+} WalBundleIndex;
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
@@ -25,12 +35,29 @@ Functions
 // Find a WAL segment in the repository. The file name can have several things appended such as a hash, compression extension, and
 // partial extension so it is possible to have multiple files that match the segment, though more than one match is not a good
 // thing.
+//
+// WAL segments stored in a bundle are found by loading the bundle indexes in the path that cover the WAL segment. The name returned
+// is the name the WAL segment would have if stored individually and walSegmentFindBundle() returns where it is stored.
+//
+// When timeout is zero the path is listed only once for each prefix since there is no waiting for WAL segments to be archived.
 FN_EXTERN String *walSegmentFind(WalSegmentFind *this, const String *walSegment);
 
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+// Bundle file for the WAL segment most recently found. NULL if the WAL segment is stored individually.
+FN_EXTERN const WalBundleFile *walSegmentFindBundle(const WalSegmentFind *this);
+
 /***********************************************************************************************************************************
 Helper functions
 ***********************************************************************************************************************************/
 // Find a single WAL segment (see walSegmentFind() for details)
 FN_EXTERN String *walSegmentFindOne(const Storage *storage, const String *archiveId, const String *walSegment, TimeMSec timeout);
 
+// Find a WAL segment in the bundles of a path. Indexes in indexList that cover the WAL segment are loaded into cache (a list of
+// WalBundleIndex) if they have not already been loaded. Files found are added to result (a list of WalBundleFile), which is only
+// valid while the cache exists.
+FN_EXTERN void walBundleFind(
+    const Storage *storage, const String *path, const StringList *indexList, List *cache, const String *walSegment, List *result);
+
 #endif
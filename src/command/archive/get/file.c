@@ -71,11 +71,13 @@ archiveGetFile(
                     compressible = false;
                 }
 
-                // Copy the file
+                // Copy the file, reading only the range where it is stored when the file is in a bundle
                 storageCopyP(
                     storageNewReadP(
-                        storageRepoIdx(actual->repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(actual->file)),
-                        .compressible = compressible),
+                        storageRepoIdx(actual->repoIdx),
+                        strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(actual->bundle != NULL ? actual->bundle : actual->file)),
+                        .compressible = compressible, .offset = actual->offset,
+                        .limit = actual->bundle != NULL ? VARUINT64(actual->size) : NULL),
                     destination);
             }
             MEM_CONTEXT_TEMP_END();
@@ -15,6 +15,9 @@ Functions
 typedef struct ArchiveGetFile
 {
     const String *file;                                             // File in the repo (with path, checksum, ext, etc.)
+    const String *bundle;                                           // Bundle containing the file (with path) or NULL
+    uint64_t offset;                                                // Offset of the file in the bundle
+    uint64_t size;                                                  // Size of the file in the bundle
     unsigned int repoIdx;                                           // Repo idx
     const String *archiveId;                                        // Repo archive id
     CipherType cipherType;                                          // Repo cipher type
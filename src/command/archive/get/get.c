@@ -10,14 +10,18 @@ Archive Get Command
 #include <unistd.h>
 
 #include "command/archive/common.h"
+#include "command/archive/find.h"
 #include "command/archive/get/file.h"
 #include "command/archive/get/protocol.h"
 #include "command/command.h"
+#include "command/control/common.h"
 #include "command/lock.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -38,6 +42,13 @@ Constants for log messages that are used multiple times to keep them consistent
 #define UNABLE_TO_FIND_VALID_REPO_MSG                               "unable to find a valid repository"
 #define REPO_INVALID_OR_ERR_MSG                                     "some repositories were invalid or encountered errors"
 
+/***********************************************************************************************************************************
+Notifications sent to a lingering async process contain the WAL segment requested by PostgreSQL followed by whether it was found in
+the queue
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_NOTIFY_FOUND                                    " found"
+#define ARCHIVE_GET_NOTIFY_MISSING                                  " missing"
+
 /***********************************************************************************************************************************
 Check for a list of archive files in the repository
 ***********************************************************************************************************************************/
@@ -81,7 +92,11 @@ archiveGetErrorAdd(
 typedef struct ArchiveGetFindCachePath
 {
     const String *path;                                             // Cached path in the archiveId
-    const StringList *fileList;                                     // List of files in the cache path
+    StringList *fileList;                                           // List of files in the cache path
+    StringList *indexList;                                          // List of bundle indexes in the cache path
+    List *bundleCache;                                              // Bundle indexes loaded from the cache path
+    time_t timeList;                                                // Time the path was listed
+    bool spool;                                                     // Was the listing loaded from the list cache in the spool?
 } ArchiveGetFindCachePath;
 
 typedef struct ArchiveGetFindCacheArchive
@@ -93,12 +108,88 @@ typedef struct ArchiveGetFindCacheArchive
 typedef struct ArchiveGetFindCacheRepo
 {
     unsigned int repoIdx;
-    CipherType cipherType;                                          // Repo cipher type
+    CipherType cipherType;                                          // Repo archive cipher type
     const String *cipherPassArchive;                                // Repo archive cipher pass
     List *archiveList;                                              // Cached list of archiveIds and associated paths
     StringList *warnList;                                           // Track repo warnings so each is only reported once
 } ArchiveGetFindCacheRepo;
 
+// List a path in the repository and store the result in the cache path
+static void
+archiveGetFindCachePathList(
+    ArchiveGetFindCachePath *const cachePath, const Storage *const storage, const String *const pathFull)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cachePath);
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, pathFull);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(cachePath != NULL);
+    ASSERT(storage != NULL);
+    ASSERT(pathFull != NULL);
+
+    const time_t timeList = time(NULL);
+    StringList *fileList;
+    StringList *indexList;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const expression = strNewFmt(
+            "^%s[0-F]{8}-([0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}|%s[0-F]{8}\\" WAL_BUNDLE_INDEX_EXT ")$", strZ(cachePath->path),
+            strZ(cachePath->path));
+
+        // The lists are kept with the cache path
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            fileList = storageListP(storage, pathFull, .expression = expression);
+            indexList = walBundleIndexListSplit(fileList);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Replace the listing only once the new listing has succeeded. A stale listing may have been loaded from the list cache.
+    strLstFree(cachePath->fileList);
+    strLstFree(cachePath->indexList);
+
+    cachePath->timeList = timeList;
+    cachePath->fileList = fileList;
+    cachePath->indexList = indexList;
+    cachePath->spool = false;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Is the archive file in the cache path, either as a file or in the range of a bundle index?
+static bool
+archiveGetFindCachePathHit(const ArchiveGetFindCachePath *const cachePath, const String *const archiveFileRequest)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cachePath);
+        FUNCTION_TEST_PARAM(STRING, archiveFileRequest);
+    FUNCTION_TEST_END();
+
+    ASSERT(cachePath != NULL);
+    ASSERT(archiveFileRequest != NULL);
+
+    for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
+    {
+        if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), archiveFileRequest))
+            FUNCTION_TEST_RETURN(BOOL, true);
+    }
+
+    for (unsigned int indexIdx = 0; indexIdx < strLstSize(cachePath->indexList); indexIdx++)
+    {
+        if (walBundleIndexCover(strLstGet(cachePath->indexList, indexIdx), archiveFileRequest))
+            FUNCTION_TEST_RETURN(BOOL, true);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, false);
+}
+
 static bool
 archiveGetFind(
     const String *const archiveFileRequest, ArchiveGetCheckResult *const getCheckResult, List *const cacheRepoList,
@@ -150,17 +241,25 @@ archiveGetFind(
                     // If a WAL segment then search among the possible file names
                     if (isSegment)
                     {
+                        const String *const pathFull = strNewFmt(
+                            STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path));
                         StringList *segmentList;
+                        const StringList *indexList;
+                        List *bundleCache;
 
-                        // If a single file is requested then optimize by adding a restrictive expression to reduce bandwidth
+                        // If a single file is requested then optimize by adding a restrictive expression to reduce bandwidth.
+                        // Bundle indexes in the path are also listed since they may contain the file.
                         if (single)
                         {
                             segmentList = storageListP(
-                                storageRepoIdx(cacheRepo->repoIdx),
-                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path)),
+                                storageRepoIdx(cacheRepo->repoIdx), pathFull,
                                 .expression = strNewFmt(
-                                    "^%s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(strSubN(archiveFileRequest, 0, 24)),
-                                    walIsPartial(archiveFileRequest) ? WAL_SEGMENT_PARTIAL_EXT : ""));
+                                    "^(%s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}|%s[0-F]{8}-%s[0-F]{8}\\" WAL_BUNDLE_INDEX_EXT
+                                    ")$",
+                                    strZ(strSubN(archiveFileRequest, 0, 24)),
+                                    walIsPartial(archiveFileRequest) ? WAL_SEGMENT_PARTIAL_EXT : "", strZ(path), strZ(path)));
+                            indexList = walBundleIndexListSplit(segmentList);
+                            bundleCache = lstNewP(sizeof(WalBundleIndex), .comparator = lstComparatorStr);
                         }
                         // Else multiple files will be requested so cache list results
                         else
@@ -168,30 +267,36 @@ archiveGetFind(
                             // Partial files cannot be in a list with multiple requests
                             ASSERT(!walIsPartial(archiveFileRequest));
 
-                            // If the path does not exist in the cache then fetch it
-                            const ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
+                            // If the path does not exist in the cache (or a prior listing failed) then fetch it. A listing loaded
+                            // from the list cache may be missing files pushed since it was taken so fetch it again when it does
+                            // not contain the file.
+                            ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
 
-                            if (cachePath == NULL)
+                            if (cachePath == NULL || cachePath->fileList == NULL ||
+                                (cachePath->spool && !archiveGetFindCachePathHit(cachePath, archiveFileRequest)))
                             {
                                 MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
                                 {
-                                    const ArchiveGetFindCachePath archiveGetFindCachePath =
+                                    if (cachePath == NULL)
                                     {
-                                        .path = strDup(path),
-                                        .fileList = storageListP(
-                                            storageRepoIdx(cacheRepo->repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path)),
-                                            .expression = strNewFmt(
-                                                "^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
-                                    };
-
-                                    cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
+                                        const ArchiveGetFindCachePath archiveGetFindCachePath =
+                                        {
+                                            .path = strDup(path),
+                                            .bundleCache = lstNewP(sizeof(WalBundleIndex), .comparator = lstComparatorStr),
+                                        };
+
+                                        cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
+                                    }
+
+                                    archiveGetFindCachePathList(cachePath, storageRepoIdx(cacheRepo->repoIdx), pathFull);
                                 }
                                 MEM_CONTEXT_END();
                             }
 
                             // Get a list of all WAL segments that match
                             segmentList = strLstNew();
+                            indexList = cachePath->indexList;
+                            bundleCache = cachePath->bundleCache;
 
                             for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
                             {
@@ -220,6 +325,37 @@ archiveGetFind(
                             }
                             MEM_CONTEXT_END();
                         }
+
+                        // Add segments in bundles to match list
+                        List *const bundleList = lstNewP(sizeof(WalBundleFile));
+
+                        walBundleFind(
+                            storageRepoIdx(cacheRepo->repoIdx), pathFull, indexList, bundleCache, archiveFileRequest, bundleList);
+
+                        for (unsigned int bundleIdx = 0; bundleIdx < lstSize(bundleList); bundleIdx++)
+                        {
+                            const WalBundleFile *const bundleFile = lstGet(bundleList, bundleIdx);
+
+                            MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
+                            {
+                                const ArchiveGetFile archiveGetFile =
+                                {
+                                    .file = strNewFmt(
+                                        "%s/%s/%s", strZ(cacheArchive->archiveId), strZ(path), strZ(bundleFile->name)),
+                                    .bundle = strNewFmt(
+                                        "%s/%s/%s", strZ(cacheArchive->archiveId), strZ(path), strZ(bundleFile->bundle)),
+                                    .offset = bundleFile->offset,
+                                    .size = bundleFile->size,
+                                    .repoIdx = cacheRepo->repoIdx,
+                                    .archiveId = cacheArchive->archiveId,
+                                    .cipherType = cacheRepo->cipherType,
+                                    .cipherPassArchive = cacheRepo->cipherPassArchive,
+                                };
+
+                                lstAdd(matchList, &archiveGetFile);
+                            }
+                            MEM_CONTEXT_END();
+                        }
                     }
                     // Else if not a WAL segment, see if it exists in the archiveId path
                     else if (
@@ -360,11 +496,183 @@ archiveGetFind(
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Load/save repository path listings in the list cache so they can be reused by later async processes
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_LIST_CACHE_FILE                                 STORAGE_SPOOL_ARCHIVE "/list.cache"
+#define ARCHIVE_GET_LIST_CACHE_VERSION                              1
+
+// Load listings that have not expired into the cache. Listings for repos and archiveIds that are not in the cache are skipped.
+static void
+archiveGetListCacheLoad(List *const cacheRepoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, cacheRepoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(cacheRepoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            const Buffer *const buffer = storageGetP(
+                storageNewReadP(storageSpool(), STRDEF(ARCHIVE_GET_LIST_CACHE_FILE), .ignoreMissing = true));
+
+            if (buffer != NULL)
+            {
+                PackRead *const pack = pckReadNewIo(ioBufferReadNewOpen(buffer));
+
+                // Only load the cache when it was written with the current version
+                if (pckReadU32P(pack) == ARCHIVE_GET_LIST_CACHE_VERSION)
+                {
+                    const time_t timeNow = time(NULL);
+                    const time_t timeExpire = (time_t)(cfgOptionUInt64(cfgOptArchiveGetListCache) / MSEC_PER_SEC);
+                    const unsigned int pathTotal = pckReadU32P(pack);
+
+                    for (unsigned int pathIdx = 0; pathIdx < pathTotal; pathIdx++)
+                    {
+                        pckReadObjBeginP(pack);
+
+                        const unsigned int repoKey = pckReadU32P(pack);
+                        const String *const archiveId = pckReadStrP(pack);
+                        const String *const path = pckReadStrP(pack);
+                        const time_t timeList = pckReadTimeP(pack);
+                        StringList *const fileList = pckReadStrLstP(pack);
+                        StringList *const indexList = pckReadStrLstP(pack);
+
+                        pckReadObjEndP(pack);
+
+                        // Skip listings that have expired or are from the future, e.g. the clock was changed
+                        if (timeList > timeNow || timeNow - timeList > timeExpire)
+                            continue;
+
+                        // Find the repo/archiveId and add the listing
+                        for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+                        {
+                            const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+
+                            if (cfgOptionGroupIdxToKey(cfgOptGrpRepo, cacheRepo->repoIdx) != repoKey)
+                                continue;
+
+                            for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList);
+                                 archiveCacheIdx++)
+                            {
+                                const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(
+                                    cacheRepo->archiveList, archiveCacheIdx);
+
+                                if (strEq(cacheArchive->archiveId, archiveId))
+                                {
+                                    MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
+                                    {
+                                        const ArchiveGetFindCachePath cachePath =
+                                        {
+                                            .path = strDup(path),
+                                            .fileList = strLstMove(fileList, memContextCurrent()),
+                                            .indexList = strLstMove(indexList, memContextCurrent()),
+                                            .bundleCache = lstNewP(sizeof(WalBundleIndex), .comparator = lstComparatorStr),
+                                            .timeList = timeList,
+                                            .spool = true,
+                                        };
+
+                                        lstAdd(cacheArchive->pathList, &cachePath);
+                                    }
+                                    MEM_CONTEXT_END();
+                                }
+                            }
+                        }
+                    }
+
+                    pckReadEndP(pack);
+                }
+            }
+        }
+        CATCH_ANY()
+        {
+            LOG_WARN_FMT("unable to load list cache, all paths will be listed: %s", errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Save all listings in the cache
+static void
+archiveGetListCacheSave(const List *const cacheRepoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, cacheRepoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(cacheRepoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Count the paths so the total can be written first
+        unsigned int pathTotal = 0;
+
+        for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+        {
+            const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+
+            for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList); archiveCacheIdx++)
+            {
+                const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(cacheRepo->archiveList, archiveCacheIdx);
+
+                pathTotal += lstSize(cacheArchive->pathList);
+            }
+        }
+
+        StorageWrite *const write = storageNewWriteP(storageSpoolWrite(), STRDEF(ARCHIVE_GET_LIST_CACHE_FILE));
+
+        ioWriteOpen(storageWriteIo(write));
+
+        PackWrite *const pack = pckWriteNewIo(storageWriteIo(write));
+
+        pckWriteU32P(pack, ARCHIVE_GET_LIST_CACHE_VERSION);
+        pckWriteU32P(pack, pathTotal);
+
+        for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+        {
+            const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+
+            for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList); archiveCacheIdx++)
+            {
+                const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(cacheRepo->archiveList, archiveCacheIdx);
+
+                for (unsigned int pathIdx = 0; pathIdx < lstSize(cacheArchive->pathList); pathIdx++)
+                {
+                    const ArchiveGetFindCachePath *const cachePath = lstGet(cacheArchive->pathList, pathIdx);
+
+                    pckWriteObjBeginP(pack);
+                    pckWriteU32P(pack, cfgOptionGroupIdxToKey(cfgOptGrpRepo, cacheRepo->repoIdx));
+                    pckWriteStrP(pack, cacheArchive->archiveId);
+                    pckWriteStrP(pack, cachePath->path);
+                    pckWriteTimeP(pack, cachePath->timeList);
+                    pckWriteStrLstP(pack, cachePath->fileList);
+                    pckWriteStrLstP(pack, cachePath->indexList);
+                    pckWriteObjEndP(pack);
+                }
+            }
+        }
+
+        pckWriteEndP(pack);
+        ioWriteClose(storageWriteIo(write));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Find archive files in the repositories. When listCache is set path listings are loaded from and saved to the list cache.
 static ArchiveGetCheckResult
-archiveGetCheck(const StringList *const archiveRequestList)
+archiveGetCheck(const StringList *const archiveRequestList, const bool listCache)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING_LIST, archiveRequestList);
+        FUNCTION_LOG_PARAM(BOOL, listCache);
     FUNCTION_LOG_END();
 
     FUNCTION_AUDIT_STRUCT();
@@ -407,16 +715,18 @@ archiveGetCheck(const StringList *const archiveRequestList)
                 ArchiveGetFindCacheRepo cacheRepo =
                 {
                     .repoIdx = repoIdx,
-                    .cipherType = cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx),
                     .archiveList = lstNewP(sizeof(ArchiveGetFindCacheArchive)),
                     .warnList = strLstNew(),
                 };
 
                 // Attempt to load the archive info file
                 const InfoArchive *const info = infoArchiveLoadFile(
-                    storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, cacheRepo.cipherType,
+                    storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx),
                     cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
 
+                // Get the cipher type used to encrypt WAL with the archive cipher pass
+                cacheRepo.cipherType = infoArchiveCipherType(info);
+
                 // Copy cipher pass into the result list context once rather than making a copy per candidate file later
                 MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
                 {
@@ -512,17 +822,26 @@ archiveGetCheck(const StringList *const archiveRequestList)
             }
             MEM_CONTEXT_END();
 
-            // Find files in the list
+            // Load listings from the list cache
+            if (listCache)
+                archiveGetListCacheLoad(cacheRepoList);
+
+            // Find files in the list. Listings must be complete to be cached so single file optimizations are disabled when
+            // listings are cached.
             for (unsigned int archiveRequestIdx = 0; archiveRequestIdx < strLstSize(archiveRequestList); archiveRequestIdx++)
             {
                 if (!archiveGetFind(
                         strLstGet(archiveRequestList, archiveRequestIdx), &result, cacheRepoList, warnList,
-                        strLstSize(archiveRequestList) == 1))
+                        strLstSize(archiveRequestList) == 1 && !listCache))
                 {
                     break;
                 }
             }
 
+            // Save listings to the list cache
+            if (listCache)
+                archiveGetListCacheSave(cacheRepoList);
+
             // Sort the list to make searching for files faster
             lstSort(result.archiveFileMapList, sortOrderAsc);
         }
@@ -654,6 +973,7 @@ cmdArchiveGet(void)
             bool foundOk = false;                                       // Was an OK file found which confirms the file was missing?
             bool queueFull = false;                                     // Is the queue half or more full?
             bool forked = false;                                        // Has the async process been forked yet?
+            bool notified = false;                                      // Has a running async process been notified?
 
             // Loop and wait for the WAL segment to be pushed
             Wait *const wait = waitNew(cfgOptionUInt64(cfgOptArchiveTimeout));
@@ -771,6 +1091,15 @@ cmdArchiveGet(void)
                     // enough to do the job, running it again won't help anything.
                     forked = true;
                 }
+                // Else an async process may be lingering so notify it of the WAL segment requested by PostgreSQL. This also happens
+                // when the queue is full so the async process can track replay and keep the queue full.
+                else if (!forked && !notified && cfgOptionUInt64(cfgOptArchiveGetLinger) > 0)
+                {
+                    archiveAsyncNotify(
+                        archiveModeGet,
+                        strNewFmt("%s%s", strZ(walSegment), found ? ARCHIVE_GET_NOTIFY_FOUND : ARCHIVE_GET_NOTIFY_MISSING));
+                    notified = true;
+                }
 
                 // Exit loop if WAL was found
                 if (found)
@@ -807,7 +1136,7 @@ cmdArchiveGet(void)
             StringList *const archiveRequestList = strLstNew();
             strLstAdd(archiveRequestList, walSegment);
 
-            const ArchiveGetCheckResult checkResult = archiveGetCheck(archiveRequestList);
+            const ArchiveGetCheckResult checkResult = archiveGetCheck(archiveRequestList, false);
 
             // If there was an error then throw it
             if (checkResult.errorType != NULL)
@@ -889,6 +1218,9 @@ archiveGetAsyncCallback(void *const data, const unsigned int clientIdx)
                 const ArchiveGetFile *const actual = lstGet(archiveFileMap->actualList, actualIdx);
 
                 pckWriteStrP(param, actual->file);
+                pckWriteStrP(param, actual->bundle);
+                pckWriteU64P(param, actual->offset);
+                pckWriteU64P(param, actual->size);
                 pckWriteU32P(param, actual->repoIdx);
                 pckWriteStrP(param, actual->archiveId);
                 pckWriteU64P(param, actual->cipherType);
@@ -907,163 +1239,424 @@ archiveGetAsyncCallback(void *const data, const unsigned int clientIdx)
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
-FN_EXTERN void
-cmdArchiveGetAsync(void)
+/***********************************************************************************************************************************
+Get a list of WAL segments into the queue. Returns the number of WAL segments found in the archive.
+***********************************************************************************************************************************/
+static unsigned int
+archiveGetAsyncProcess(const StringList *const walSegmentList)
 {
-    FUNCTION_LOG_VOID(logLevelDebug);
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_LIST, walSegmentList);
+    FUNCTION_LOG_END();
 
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        TRY_BEGIN()
-        {
-            // PostgreSQL must be local
-            pgIsLocalVerify();
+    ASSERT(walSegmentList != NULL);
 
-            // Check the parameters
-            if (strLstSize(cfgCommandParam()) < 1)
-                THROW(ParamInvalidError, "at least one wal segment is required");
+    unsigned int result = 0;
 
-            LOG_INFO_FMT(
-                "get %u WAL file(s) from archive: %s%s",
-                strLstSize(cfgCommandParam()), strZ(strLstGet(cfgCommandParam(), 0)),
-                strLstSize(cfgCommandParam()) == 1 ?
-                    "" : zNewFmt("...%s", strZ(strLstGet(cfgCommandParam(), strLstSize(cfgCommandParam()) - 1))));
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        LOG_INFO_FMT(
+            "get %u WAL file(s) from archive: %s%s",
+            strLstSize(walSegmentList), strZ(strLstGet(walSegmentList, 0)),
+            strLstSize(walSegmentList) == 1 ?
+                "" : zNewFmt("...%s", strZ(strLstGet(walSegmentList, strLstSize(walSegmentList) - 1))));
 
-            // Check for archive files
-            const ArchiveGetCheckResult checkResult = archiveGetCheck(cfgCommandParam());
+        // Check for archive files
+        const ArchiveGetCheckResult checkResult = archiveGetCheck(
+            walSegmentList, cfgOptionUInt64(cfgOptArchiveGetListCache) > 0);
+        result = lstSize(checkResult.archiveFileMapList);
 
-            // If any files are missing get the first one (used to construct the "unable to find" warning)
-            const String *archiveFileMissing = NULL;
+        // If any files are missing get the first one (used to construct the "unable to find" warning)
+        const String *archiveFileMissing = NULL;
 
-            if (lstSize(checkResult.archiveFileMapList) < strLstSize(cfgCommandParam()))
-                archiveFileMissing = strLstGet(cfgCommandParam(), lstSize(checkResult.archiveFileMapList));
+        if (lstSize(checkResult.archiveFileMapList) < strLstSize(walSegmentList))
+            archiveFileMissing = strLstGet(walSegmentList, lstSize(checkResult.archiveFileMapList));
 
-            // Get archive files that were found
-            if (!lstEmpty(checkResult.archiveFileMapList))
-            {
-                // Create the parallel executor
-                ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
+        // Get archive files that were found
+        if (!lstEmpty(checkResult.archiveFileMapList))
+        {
+            // Create the parallel executor
+            ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
 
-                ProtocolParallel *const parallelExec = protocolParallelNew(
-                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
+            ProtocolParallel *const parallelExec = protocolParallelNewP(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
-                // Process jobs
-                MEM_CONTEXT_TEMP_RESET_BEGIN()
+            // Process jobs
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
                 {
-                    do
-                    {
-                        const unsigned int completed = protocolParallelProcess(parallelExec);
-
-                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
-                        {
-                            // Get the job
-                            ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
-                            const unsigned int processId = protocolParallelJobProcessId(job);
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
 
-                            // Get wal segment name and archive file map
-                            const String *const walSegment = varStr(protocolParallelJobKey(job));
-                            const ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
-                            ASSERT(fileMap != NULL);
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        // Get the job
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                        const unsigned int processId = protocolParallelJobProcessId(job);
 
-                            // Build warnings for status file
-                            String *const warning = strNew();
+                        // Get wal segment name and archive file map
+                        const String *const walSegment = varStr(protocolParallelJobKey(job));
+                        const ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
+                        ASSERT(fileMap != NULL);
 
-                            if (!strLstEmpty(fileMap->warnList))
-                                strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
+                        // Build warnings for status file
+                        String *const warning = strNew();
 
-                            // The job was successful
-                            if (protocolParallelJobErrorCode(job) == 0)
-                            {
-                                // Get the actual file retrieved
-                                PackRead *const fileResult = protocolParallelJobResult(job);
-                                const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
-                                ASSERT(file != NULL);
+                        if (!strLstEmpty(fileMap->warnList))
+                            strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
 
-                                // Output file warnings
-                                const StringList *const fileWarnList = pckReadStrLstP(fileResult);
+                        // The job was successful
+                        if (protocolParallelJobErrorCode(job) == 0)
+                        {
+                            // Get the actual file retrieved
+                            PackRead *const fileResult = protocolParallelJobResult(job);
+                            const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
+                            ASSERT(file != NULL);
 
-                                for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
-                                    LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+                            // Output file warnings
+                            const StringList *const fileWarnList = pckReadStrLstP(fileResult);
 
-                                // Build file warnings for status file
-                                if (!strLstEmpty(fileWarnList))
-                                {
-                                    strCatFmt(
-                                        warning, "%s%s", strSize(warning) == 0 ? "" : "\n", strZ(strLstJoin(fileWarnList, "\n")));
-                                }
+                            for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
+                                LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
 
-                                if (strSize(warning) != 0)
-                                    archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
-
-                                LOG_DETAIL_PID_FMT(
-                                    processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
-                                    cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
-
-                                // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
-                                // is guaranteed to exist before the foreground process finds the WAL segment.
-                                storageMoveP(
-                                    storageSpoolWrite(),
-                                    storageNewReadP(
-                                        storageSpool(),
-                                        strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(walSegment))),
-                                    storageNewWriteP(
-                                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
-                            }
-                            // Else the job errored
-                            else
+                            // Build file warnings for status file
+                            if (!strLstEmpty(fileWarnList))
                             {
-                                LOG_WARN_PID_FMT(
-                                    processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
-                                    strZ(protocolParallelJobErrorMessage(job)));
-
-                                archiveAsyncStatusErrorWrite(
-                                    archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
-                                    strNewFmt(
-                                        "%s%s", strZ(protocolParallelJobErrorMessage(job)),
-                                        strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
+                                strCatFmt(
+                                    warning, "%s%s", strSize(warning) == 0 ? "" : "\n", strZ(strLstJoin(fileWarnList, "\n")));
                             }
 
-                            protocolParallelJobFree(job);
+                            if (strSize(warning) != 0)
+                                archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
+
+                            LOG_DETAIL_PID_FMT(
+                                processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
+                                cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
+
+                            // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
+                            // is guaranteed to exist before the foreground process finds the WAL segment.
+                            storageMoveP(
+                                storageSpoolWrite(),
+                                storageNewReadP(
+                                    storageSpool(),
+                                    strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(walSegment))),
+                                storageNewWriteP(
+                                    storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
+                        }
+                        // Else the job errored
+                        else
+                        {
+                            LOG_WARN_PID_FMT(
+                                processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
+                                strZ(protocolParallelJobErrorMessage(job)));
+
+                            archiveAsyncStatusErrorWrite(
+                                archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
+                                strNewFmt(
+                                    "%s%s", strZ(protocolParallelJobErrorMessage(job)),
+                                    strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
                         }
 
-                        // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                        MEM_CONTEXT_TEMP_RESET(1000);
+                        protocolParallelJobFree(job);
                     }
-                    while (!protocolParallelDone(parallelExec));
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
                 }
-                MEM_CONTEXT_TEMP_END();
+                while (!protocolParallelDone(parallelExec));
             }
+            MEM_CONTEXT_TEMP_END();
+        }
 
-            // Log an error from archiveGetCheck() after any existing files have been fetched. This ordering is important because we
-            // need to fetch as many valid files as possible before throwing an error.
-            if (checkResult.errorType != NULL)
+        // Log an error from archiveGetCheck() after any existing files have been fetched. This ordering is important because we
+        // need to fetch as many valid files as possible before throwing an error.
+        if (checkResult.errorType != NULL)
+        {
+            LOG_WARN_FMT("[%s] %s", errorTypeName(checkResult.errorType), strZ(checkResult.errorMessage));
+
+            String *const message = strCat(strNew(), checkResult.errorMessage);
+
+            if (!strLstEmpty(checkResult.warnList))
+                strCatFmt(message, "\n%s", strZ(strLstJoin(checkResult.warnList, "\n")));
+
+            archiveAsyncStatusErrorWrite(
+                archiveModeGet, checkResult.errorFile, errorTypeCode(checkResult.errorType), message);
+        }
+        // If any files were missing write an ok file for the first missing file and add any warnings. It is important that this
+        // happen right before the async process exits so the main process can immediately respawn the async process to retry
+        // missing files.
+        else if (archiveFileMissing != NULL)
+        {
+            LOG_DETAIL_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG, strZ(archiveFileMissing));
+
+            const String *message = NULL;
+
+            if (!strLstEmpty(checkResult.warnList))
+                message = strLstJoin(checkResult.warnList, "\n");
+
+            archiveAsyncStatusOkWrite(archiveModeGet, archiveFileMissing, message);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(UINT, result);
+}
+
+/***********************************************************************************************************************************
+Prefetch WAL segments ahead of replay while lingering
+
+The number of WAL segments fetched ahead of the WAL segment being replayed is enough to cover replay while a WAL segment is being
+fetched (with a margin), plus enough to keep all processes busy. Until replay and fetch times have been measured the queue is filled
+as it would be by the main process.
+***********************************************************************************************************************************/
+typedef struct ArchiveGetAsyncPrefetch
+{
+    size_t walSegmentSize;                                          // WAL segment size
+    unsigned int pgVersion;                                         // PostgreSQL version
+    unsigned int queueTotal;                                        // Maximum WAL segments in the queue
+    unsigned int processMax;                                        // Processes fetching WAL segments
+    char replayLast[WAL_SEGMENT_NAME_SIZE + 1];                     // Last WAL segment found in the queue by PostgreSQL
+    TimeMSec replayLastTime;                                        // Time when the last WAL segment was found
+    TimeMSec replayTime;                                            // Estimated time to replay a WAL segment (0 when unknown)
+    TimeMSec fetchTime;                                             // Estimated time for a process to fetch a WAL segment
+} ArchiveGetAsyncPrefetch;
+
+// Update an estimate using an exponentially weighted moving average so a single slow WAL segment does not skew the estimate
+static TimeMSec
+archiveGetAsyncEstimate(const TimeMSec estimate, const TimeMSec sample)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TIME_MSEC, estimate);
+        FUNCTION_TEST_PARAM(TIME_MSEC, sample);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(TIME_MSEC, estimate == 0 ? sample : (estimate * 3 + sample) / 4);
+}
+
+// Update replay time when PostgreSQL finds a WAL segment in the queue
+static void
+archiveGetAsyncReplay(ArchiveGetAsyncPrefetch *const prefetch, const String *const walSegment, const TimeMSec time)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, prefetch);
+        FUNCTION_TEST_PARAM(STRING, walSegment);
+        FUNCTION_TEST_PARAM(TIME_MSEC, time);
+    FUNCTION_TEST_END();
+
+    ASSERT(prefetch != NULL);
+    ASSERT(walSegment != NULL);
+
+    // Count WAL segments replayed since the last WAL segment found. Notifications may have been skipped while WAL segments were
+    // being fetched so this may be more than one. If the WAL segment is not within the queue (e.g. after a timeline switch) then
+    // replay is not measured.
+    if (prefetch->replayLast[0] != '\0')
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const StringList *const range = walSegmentRange(
+                STR(prefetch->replayLast), prefetch->walSegmentSize, prefetch->pgVersion, prefetch->queueTotal + 1);
+
+            for (unsigned int rangeIdx = 1; rangeIdx < strLstSize(range); rangeIdx++)
             {
-                LOG_WARN_FMT("[%s] %s", errorTypeName(checkResult.errorType), strZ(checkResult.errorMessage));
+                if (strEq(strLstGet(range, rangeIdx), walSegment))
+                {
+                    prefetch->replayTime = archiveGetAsyncEstimate(
+                        prefetch->replayTime, (time - prefetch->replayLastTime) / rangeIdx);
+                    break;
+                }
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    strncpy(prefetch->replayLast, strZ(walSegment), WAL_SEGMENT_NAME_SIZE);
+    prefetch->replayLastTime = time;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Get the number of WAL segments to fetch ahead
+static unsigned int
+archiveGetAsyncDepth(const ArchiveGetAsyncPrefetch *const prefetch)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, prefetch);
+    FUNCTION_TEST_END();
 
-                String *const message = strCat(strNew(), checkResult.errorMessage);
+    ASSERT(prefetch != NULL);
 
-                if (!strLstEmpty(checkResult.warnList))
-                    strCatFmt(message, "\n%s", strZ(strLstJoin(checkResult.warnList, "\n")));
+    unsigned int result = prefetch->queueTotal;
+
+    if (prefetch->replayTime != 0 && prefetch->fetchTime != 0)
+    {
+        const uint64_t depth =
+            (prefetch->fetchTime * 2 + prefetch->replayTime - 1) / prefetch->replayTime + prefetch->processMax;
 
-                archiveAsyncStatusErrorWrite(
-                    archiveModeGet, checkResult.errorFile, errorTypeCode(checkResult.errorType), message);
+        if (depth < result)
+            result = (unsigned int)depth;
+    }
+
+    FUNCTION_TEST_RETURN(UINT, result);
+}
+
+// Get WAL segments and update the fetch time
+static void
+archiveGetAsyncFetch(ArchiveGetAsyncPrefetch *const prefetch, const StringList *const walSegmentList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, prefetch);
+        FUNCTION_LOG_PARAM(STRING_LIST, walSegmentList);
+    FUNCTION_LOG_END();
+
+    ASSERT(prefetch != NULL);
+    ASSERT(walSegmentList != NULL);
+
+    const TimeMSec timeBegin = timeMSec();
+    const unsigned int total = archiveGetAsyncProcess(walSegmentList);
+
+    // Fetch time is per process so only count the processes that were busy
+    if (total > 0)
+    {
+        prefetch->fetchTime = archiveGetAsyncEstimate(
+            prefetch->fetchTime, (timeMSec() - timeBegin) * (total < prefetch->processMax ? total : prefetch->processMax) / total);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Get WAL segments ahead of the WAL segment requested by PostgreSQL
+static void
+archiveGetAsyncPrefetch(ArchiveGetAsyncPrefetch *const prefetch, const String *const notify)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, prefetch);
+        FUNCTION_LOG_PARAM(STRING, notify);
+    FUNCTION_LOG_END();
+
+    ASSERT(prefetch != NULL);
+    ASSERT(notify != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Ignore notifications that are not valid
+        const String *const walSegment = strSubN(notify, 0, strSize(notify) < WAL_SEGMENT_NAME_SIZE ? 0 : WAL_SEGMENT_NAME_SIZE);
+        const bool found = strEndsWithZ(notify, ARCHIVE_GET_NOTIFY_FOUND);
+
+        if (walIsSegment(walSegment) && (found || strEndsWithZ(notify, ARCHIVE_GET_NOTIFY_MISSING)))
+        {
+            // If the WAL segment was found then get WAL segments after it, else get the WAL segment
+            const String *walSegmentFirst = walSegment;
+
+            if (found)
+            {
+                archiveGetAsyncReplay(prefetch, walSegment, timeMSec());
+                walSegmentFirst = walSegmentNext(walSegment, prefetch->walSegmentSize, prefetch->pgVersion);
+            }
+
+            // Remove WAL segments before the first WAL segment since they will not be requested. Status files are left for the
+            // main process to remove since it may be checking them.
+            const StringList *const queue = storageListP(
+                storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .expression = WAL_SEGMENT_REGEXP_STR, .errorOnMissing = true);
+
+            for (unsigned int queueIdx = 0; queueIdx < strLstSize(queue); queueIdx++)
+            {
+                if (strCmp(strLstGet(queue, queueIdx), walSegmentFirst) < 0)
+                {
+                    storageRemoveP(
+                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(strLstGet(queue, queueIdx))));
+                }
+            }
+
+            // Build a list of WAL segments that are needed to fill the queue to the prefetch depth. WAL segments already in the
+            // queue beyond the depth are kept since they have already been fetched.
+            const StringList *const range = walSegmentRange(
+                walSegmentFirst, prefetch->walSegmentSize, prefetch->pgVersion, archiveGetAsyncDepth(prefetch));
+            StringList *const walSegmentList = strLstNew();
+
+            for (unsigned int rangeIdx = 0; rangeIdx < strLstSize(range); rangeIdx++)
+            {
+                if (!strLstExists(queue, strLstGet(range, rangeIdx)))
+                    strLstAdd(walSegmentList, strLstGet(range, rangeIdx));
             }
-            // If any files were missing write an ok file for the first missing file and add any warnings. It is important that this
-            // happen right before the async process exits so the main process can immediately respawn the async process to retry
-            // missing files.
-            else if (archiveFileMissing != NULL)
+
+            if (!strLstEmpty(walSegmentList))
+                archiveGetAsyncFetch(prefetch, walSegmentList);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+cmdArchiveGetAsync(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            // PostgreSQL must be local
+            pgIsLocalVerify();
+
+            // Check the parameters
+            if (strLstSize(cfgCommandParam()) < 1)
+                THROW(ParamInvalidError, "at least one wal segment is required");
+
+            // Listen before getting WAL segments so notifications sent while getting WAL segments are not missed. Fetch time is
+            // measured from the start in case the process lingers.
+            const TimeMSec linger = cfgOptionUInt64(cfgOptArchiveGetLinger);
+            ArchiveAsyncListen *listen = NULL;
+            ArchiveGetAsyncPrefetch prefetch = {.processMax = cfgOptionUInt(cfgOptProcessMax)};
+
+            if (linger > 0)
+            {
+                listen = archiveAsyncListenNew(archiveModeGet);
+
+                const PgControl pgControl = pgControlFromFile(storagePg(), cfgOptionStrNull(cfgOptPgVersionForce));
+
+                prefetch.walSegmentSize = pgControl.walSegmentSize;
+                prefetch.pgVersion = pgControl.version;
+
+                // The queue total must be at least 2 (see queueNeed())
+                prefetch.queueTotal = (unsigned int)(cfgOptionUInt64(cfgOptArchiveGetQueueMax) / pgControl.walSegmentSize);
+
+                if (prefetch.queueTotal < 2)
+                    prefetch.queueTotal = 2;
+            }
+
+            // Get WAL segments requested by the main process
+            archiveGetAsyncFetch(&prefetch, cfgCommandParam());
+
+            // Linger to keep the queue filled ahead of the WAL segment being replayed. This saves starting a new async process (and
+            // new local processes) each time the queue runs low, which leaves the queue empty when replay is faster than fetching.
+            if (linger > 0)
             {
-                LOG_DETAIL_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG, strZ(archiveFileMissing));
+                bool notified;
 
-                const String *message = NULL;
+                do
+                {
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        const String *const notify = archiveAsyncListenWait(listen, linger);
+                        notified = notify != NULL;
 
-                if (!strLstEmpty(checkResult.warnList))
-                    message = strLstJoin(checkResult.warnList, "\n");
+                        if (notified)
+                        {
+                            lockStopTest();
+                            archiveGetAsyncPrefetch(&prefetch, notify);
+                        }
+                    }
+                    MEM_CONTEXT_TEMP_END();
+                }
+                while (notified);
 
-                archiveAsyncStatusOkWrite(archiveModeGet, archiveFileMissing, message);
+                archiveAsyncListenFree(listen);
             }
         }
         // On any global error write a single error file to cover all unprocessed files
@@ -6,15 +6,18 @@ Archive Push File
 #include "command/archive/common.h"
 #include "command/archive/find.h"
 #include "command/archive/push/file.h"
+#include "command/archive/push/walRecordCheck.h"
 #include "command/control/common.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/log.h"
 #include "config/config.h"
 #include "postgres/interface.h"
+#include "postgres/version.h"
 #include "storage/helper.h"
 
 /***********************************************************************************************************************************
@@ -92,16 +95,128 @@ archivePushFileIo(
     FUNCTION_TEST_RETURN(BOOL, result);
 }
 
+// Helper to compare the archive version and systemId to the WAL header
+static void
+archivePushHeaderCheck(const String *const walSource, const unsigned int pgVersion, const uint64_t pgSystemId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walSource);
+        FUNCTION_TEST_PARAM(UINT, pgVersion);
+        FUNCTION_TEST_PARAM(UINT64, pgSystemId);
+    FUNCTION_TEST_END();
+
+    ASSERT(walSource != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const PgWal walInfo = pgWalFromFile(walSource, storageLocal(), cfgOptionStrNull(cfgOptPgVersionForce));
+
+        if (walInfo.version != pgVersion || walInfo.systemId != pgSystemId)
+        {
+            THROW_FMT(
+                ArchiveMismatchError,
+                "WAL file '%s' version %s, system-id %" PRIu64 " do not match stanza version %s, system-id %" PRIu64,
+                strZ(walSource), strZ(pgVersionToStr(walInfo.version)), walInfo.systemId, strZ(pgVersionToStr(pgVersion)),
+                pgSystemId);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to generate a sha1 checksum for a WAL segment. The WAL records are checked in the same pass when requested, which is only
+// possible for full segments from PostgreSQL >= 9.5.
+static String *
+archivePushChecksum(const String *const walSource, const bool recordCheck, const unsigned int pgVersion)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walSource);
+        FUNCTION_TEST_PARAM(BOOL, recordCheck);
+        FUNCTION_TEST_PARAM(UINT, pgVersion);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(walSource != NULL);
+
+    IoRead *const read = storageReadIo(storageNewReadP(storageLocal(), walSource));
+    ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+
+    if (recordCheck && pgVersion >= PG_VERSION_95 && !strEndsWithZ(walSource, WAL_SEGMENT_PARTIAL_EXT))
+        ioFilterGroupAdd(ioReadFilterGroup(read), walRecordCheckNew(walSource));
+
+    ioReadDrain(read);
+
+    FUNCTION_TEST_RETURN(
+        STRING, strNewEncode(encodingHex, pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE))));
+}
+
+// Helper to check a WAL segment found in the repo against the checksum of the WAL segment to be pushed. Returns true if the WAL
+// segment already exists in the repo so it does not need to be copied.
+static bool
+archivePushExists(
+    const String *const walSegmentFile, const String *const archiveFile, const String *const walSegmentChecksum,
+    const bool modeCheck, const unsigned int repoIdx, StringList *const warnList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walSegmentFile);
+        FUNCTION_TEST_PARAM(STRING, archiveFile);
+        FUNCTION_TEST_PARAM(STRING, walSegmentChecksum);
+        FUNCTION_TEST_PARAM(BOOL, modeCheck);
+        FUNCTION_TEST_PARAM(UINT, repoIdx);
+        FUNCTION_TEST_PARAM(STRING_LIST, warnList);
+    FUNCTION_TEST_END();
+
+    ASSERT(archiveFile != NULL);
+    ASSERT(walSegmentChecksum != NULL);
+    ASSERT(warnList != NULL);
+
+    bool result = false;
+
+    if (walSegmentFile != NULL)
+    {
+        // If the checksums are the same then succeed but warn if archive-mode-check is enabled in case this is a symptom of some
+        // other issue
+        if (strncmp(
+                strZ(walSegmentFile) + strSize(archiveFile) + 1, strZ(walSegmentChecksum), HASH_TYPE_SHA1_SIZE_HEX) == 0)
+        {
+            if (modeCheck)
+            {
+                // Add warning to the result that will be returned to the main process
+                strLstAddFmt(
+                    warnList,
+                    "WAL file '%s' already exists in the %s archive with the same checksum"
+                    "\nHINT: this is valid in some recovery scenarios but may also indicate a problem.",
+                    strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoIdx));
+            }
+
+            result = true;
+        }
+        // Else error so we don't overwrite the existing segment. Do not continue processing after this error since it indicates
+        // corruption, split brain, or some other unrecoverable error.
+        else
+        {
+            THROW_FMT(
+                ArchiveDuplicateError, "WAL file '%s' already exists in the %s archive with a different checksum",
+                strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoIdx));
+        }
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN ArchivePushFileResult
 archivePushFile(
-    const String *const walSource, const bool headerCheck, const bool modeCheck, const unsigned int pgVersion,
-    const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType, const int compressLevel,
-    const List *const repoList, const StringList *const priorErrorList)
+    const String *const walSource, const bool headerCheck, const bool recordCheck, const bool modeCheck,
+    const unsigned int pgVersion, const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType,
+    const int compressLevel, const List *const repoList, const StringList *const priorErrorList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSource);
         FUNCTION_LOG_PARAM(BOOL, headerCheck);
+        FUNCTION_LOG_PARAM(BOOL, recordCheck);
         FUNCTION_LOG_PARAM(BOOL, modeCheck);
         FUNCTION_LOG_PARAM(UINT, pgVersion);
         FUNCTION_LOG_PARAM(UINT64, pgSystemId);
@@ -131,18 +246,7 @@ archivePushFile(
 
         // If this is a segment compare archive version and systemId to the WAL header
         if (headerCheck && isSegment)
-        {
-            const PgWal walInfo = pgWalFromFile(walSource, storageLocal(), cfgOptionStrNull(cfgOptPgVersionForce));
-
-            if (walInfo.version != pgVersion || walInfo.systemId != pgSystemId)
-            {
-                THROW_FMT(
-                    ArchiveMismatchError,
-                    "WAL file '%s' version %s, system-id %" PRIu64 " do not match stanza version %s, system-id %" PRIu64,
-                    strZ(walSource), strZ(pgVersionToStr(walInfo.version)), walInfo.systemId, strZ(pgVersionToStr(pgVersion)),
-                    pgSystemId);
-            }
-        }
+            archivePushHeaderCheck(walSource, pgVersion, pgSystemId);
 
         // Set archive destination initially to the archive file, this will be updated later for wal segments
         String *const archiveDestination = strCat(strNew(), archiveFile);
@@ -161,12 +265,7 @@ archivePushFile(
             destinationCopyAny = false;
 
             // Generate a sha1 checksum for the wal segment
-            IoRead *const read = storageReadIo(storageNewReadP(storageLocal(), walSource));
-            ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
-            ioReadDrain(read);
-
-            const String *const walSegmentChecksum = strNewEncode(
-                encodingHex, pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE)));
+            const String *const walSegmentChecksum = archivePushChecksum(walSource, recordCheck, pgVersion);
 
             // Check each repo for the WAL segment
             for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
@@ -191,39 +290,12 @@ archivePushFile(
                 if (!destinationCopy[repoListIdx])
                     continue;
 
-                // If the WAL segment was found validate the checksum
-                if (walSegmentFile != NULL)
+                // If the WAL segment was found validate the checksum, else the repo needs a copy
+                if (archivePushExists(
+                        walSegmentFile, archiveFile, walSegmentChecksum, modeCheck, repoData->repoIdx, result.warnList))
                 {
-                    const String *const walSegmentRepoChecksum = strSubN(
-                        walSegmentFile, strSize(archiveFile) + 1, HASH_TYPE_SHA1_SIZE_HEX);
-
-                    // If the checksums are the same then succeed but warn if archive-mode-check is enabled in case this is a
-                    // symptom of some other issue
-                    if (strEq(walSegmentChecksum, walSegmentRepoChecksum))
-                    {
-                        if (modeCheck)
-                        {
-                            // Add warning to the result that will be returned to the main process
-                            strLstAddFmt(
-                                result.warnList,
-                                "WAL file '%s' already exists in the %s archive with the same checksum"
-                                "\nHINT: this is valid in some recovery scenarios but may also indicate a problem.",
-                                strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoData->repoIdx));
-                        }
-
-                        // No need to copy to this repo
-                        destinationCopy[repoListIdx] = false;
-                    }
-                    // Else error so we don't overwrite the existing segment. Do not continue processing after this error since it
-                    // indicates corruption, split brain, or some other unrecoverable error.
-                    else
-                    {
-                        THROW_FMT(
-                            ArchiveDuplicateError, "WAL file '%s' already exists in the %s archive with a different checksum",
-                            strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoData->repoIdx));
-                    }
+                    destinationCopy[repoListIdx] = false;
                 }
-                // Else the repo needs a copy
                 else
                     destinationCopyAny = true;
             }
@@ -339,3 +411,252 @@ archivePushFile(
 
     FUNCTION_LOG_RETURN_STRUCT(result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN ArchivePushBundleResult
+archivePushBundle(
+    const String *const walPath, const StringList *const walFileList, const bool headerCheck, const bool recordCheck,
+    const bool modeCheck, const unsigned int pgVersion, const uint64_t pgSystemId, const CompressType compressType,
+    const int compressLevel, const List *const repoList, const StringList *const priorErrorList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, walPath);
+        FUNCTION_LOG_PARAM(STRING_LIST, walFileList);
+        FUNCTION_LOG_PARAM(BOOL, headerCheck);
+        FUNCTION_LOG_PARAM(BOOL, recordCheck);
+        FUNCTION_LOG_PARAM(BOOL, modeCheck);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(UINT64, pgSystemId);
+        FUNCTION_LOG_PARAM(ENUM, compressType);
+        FUNCTION_LOG_PARAM(INT, compressLevel);
+        FUNCTION_LOG_PARAM_P(VOID, repoList);
+        FUNCTION_LOG_PARAM(STRING_LIST, priorErrorList);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_STRUCT();
+
+    ASSERT(walPath != NULL);
+    ASSERT(walFileList != NULL);
+    ASSERT(strLstSize(walFileList) > 0);
+    ASSERT(repoList != NULL);
+    ASSERT(lstSize(repoList) > 0);
+    ASSERT(priorErrorList != NULL);
+
+    ArchivePushBundleResult result = {.fileResultList = lstNewP(sizeof(ArchivePushFileResult))};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StringList *const errorList = strLstDup(priorErrorList);
+        const unsigned int walFileTotal = strLstSize(walFileList);
+        const unsigned int repoTotal = lstSize(repoList);
+        const String *const prefix = strSubN(strLstGet(walFileList, 0), 0, 16);
+
+        // Compare archive version and systemId to the WAL headers and generate checksums
+        StringList *const checksumList = strLstNew();
+
+        for (unsigned int walFileIdx = 0; walFileIdx < walFileTotal; walFileIdx++)
+        {
+            const String *const walFile = strLstGet(walFileList, walFileIdx);
+            const String *const walSource = strNewFmt("%s/%s", strZ(walPath), strZ(walFile));
+
+            // Only full WAL segments from the same path can be bundled
+            ASSERT(walIsSegment(walFile) && !walIsPartial(walFile) && strBeginsWith(walFile, prefix));
+
+            if (headerCheck)
+                archivePushHeaderCheck(walSource, pgVersion, pgSystemId);
+
+            strLstAdd(checksumList, archivePushChecksum(walSource, recordCheck, pgVersion));
+
+            MEM_CONTEXT_OBJ_BEGIN(result.fileResultList)
+            {
+                lstAdd(result.fileResultList, &(ArchivePushFileResult){.warnList = strLstNew()});
+            }
+            MEM_CONTEXT_OBJ_END();
+        }
+
+        // Determine which WAL segments each repo needs a copy of
+        bool *const destinationCopy = memNew(sizeof(bool) * repoTotal * walFileTotal);
+        String **const destinationBundle = memNew(sizeof(String *) * repoTotal);
+
+        for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+        {
+            const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
+            String **const walSegmentFile = memNew(sizeof(String *) * walFileTotal);
+            bool found = false;
+
+            destinationBundle[repoListIdx] = NULL;
+
+            // Find the WAL segments in the repo. The path is only listed once since there is no timeout.
+            TRY_BEGIN()
+            {
+                WalSegmentFind *const find = walSegmentFindNew(storageRepoIdx(repoData->repoIdx), repoData->archiveId, false, 0);
+
+                for (unsigned int walFileIdx = 0; walFileIdx < walFileTotal; walFileIdx++)
+                    walSegmentFile[walFileIdx] = walSegmentFind(find, strLstGet(walFileList, walFileIdx));
+
+                found = true;
+            }
+            CATCH_ANY()
+            {
+                archivePushErrorAdd(errorList, repoData->repoIdx);
+            }
+            TRY_END();
+
+            // Validate the checksums of WAL segments that were found. The bundle is named for the first and last WAL segment the
+            // repo needs a copy of.
+            for (unsigned int walFileIdx = 0; walFileIdx < walFileTotal; walFileIdx++)
+            {
+                const String *const walFile = strLstGet(walFileList, walFileIdx);
+                bool *const copy = &destinationCopy[repoListIdx * walFileTotal + walFileIdx];
+
+                *copy =
+                    found &&
+                    !archivePushExists(
+                        walSegmentFile[walFileIdx], walFile, strLstGet(checksumList, walFileIdx), modeCheck, repoData->repoIdx,
+                        ((ArchivePushFileResult *)lstGet(result.fileResultList, walFileIdx))->warnList);
+
+                if (*copy)
+                {
+                    if (destinationBundle[repoListIdx] == NULL)
+                        destinationBundle[repoListIdx] = strCatFmt(strNew(), "%s-", strZ(walFile));
+                    else
+                        strTruncIdx(destinationBundle[repoListIdx], WAL_SEGMENT_NAME_SIZE + 1);
+
+                    strCatFmt(destinationBundle[repoListIdx], "%s" WAL_BUNDLE_EXT, strZ(walFile));
+                }
+            }
+        }
+
+        // Initialize per-repo bundles and indexes
+        StorageWrite **const destination = memNew(sizeof(StorageWrite *) * repoTotal);
+        List **const destinationIndex = memNew(sizeof(List *) * repoTotal);
+        bool *const destinationOk = memNew(sizeof(bool) * repoTotal);
+
+        for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+        {
+            const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
+
+            destinationOk[repoListIdx] = false;
+
+            // Does this repo need a bundle?
+            if (destinationBundle[repoListIdx] != NULL)
+            {
+                destination[repoListIdx] = storageNewWriteP(
+                    storageRepoIdxWrite(repoData->repoIdx),
+                    strNewFmt(
+                        STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(repoData->archiveId), strZ(prefix),
+                        strZ(destinationBundle[repoListIdx])),
+                    .compressible = compressType == compressTypeNone);
+                destinationIndex[repoListIdx] = lstNewP(sizeof(WalBundleFile));
+
+                destinationOk[repoListIdx] = archivePushFileIo(
+                    archivePushFileIoTypeOpen, storageWriteIo(destination[repoListIdx]), NULL, repoData->repoIdx, errorList);
+            }
+        }
+
+        // Copy each WAL segment to the bundles that need it. The WAL segment is compressed once and then encrypted for each repo
+        // so it is stored exactly as it would be if stored individually.
+        uint64_t *const destinationOffset = memNew(sizeof(uint64_t) * repoTotal);
+
+        for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+            destinationOffset[repoListIdx] = 0;
+
+        for (unsigned int walFileIdx = 0; walFileIdx < walFileTotal; walFileIdx++)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                const String *const walFile = strLstGet(walFileList, walFileIdx);
+                StorageRead *const source = storageNewReadP(storageLocal(), strNewFmt("%s/%s", strZ(walPath), strZ(walFile)));
+                Buffer *compressed = NULL;
+
+                if (compressType != compressTypeNone)
+                    ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), compressFilterP(compressType, compressLevel));
+
+                for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+                {
+                    const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
+
+                    if (!destinationOk[repoListIdx] || !destinationCopy[repoListIdx * walFileTotal + walFileIdx])
+                        continue;
+
+                    // Read the source file the first time it is needed
+                    if (compressed == NULL)
+                        compressed = storageGetP(source);
+
+                    // If there is a cipher then encrypt
+                    const Buffer *buffer = compressed;
+
+                    if (repoData->cipherType != cipherTypeNone)
+                    {
+                        IoRead *const read = ioBufferReadNew(compressed);
+                        ioFilterGroupAdd(
+                            ioReadFilterGroup(read),
+                            cipherBlockNewP(cipherModeEncrypt, repoData->cipherType, BUFSTR(repoData->cipherPass)));
+                        ioReadOpen(read);
+
+                        buffer = ioReadBuf(read);
+                    }
+
+                    // Write to the bundle and add to the index. The index is never written if a write fails.
+                    destinationOk[repoListIdx] = archivePushFileIo(
+                        archivePushFileIoTypeWrite, storageWriteIo(destination[repoListIdx]), buffer, repoData->repoIdx, errorList);
+
+                    MEM_CONTEXT_OBJ_BEGIN(destinationIndex[repoListIdx])
+                    {
+                        const WalBundleFile file =
+                        {
+                            .name = strNewFmt(
+                                "%s-%s%s", strZ(walFile), strZ(strLstGet(checksumList, walFileIdx)),
+                                strZ(compressExtStr(compressType))),
+                            .bundle = strDup(destinationBundle[repoListIdx]),
+                            .offset = destinationOffset[repoListIdx],
+                            .size = bufUsed(buffer),
+                        };
+
+                        lstAdd(destinationIndex[repoListIdx], &file);
+                    }
+                    MEM_CONTEXT_OBJ_END();
+
+                    destinationOffset[repoListIdx] += bufUsed(buffer);
+                }
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+
+        // Close the bundles and then write the indexes. A bundle without an index is ignored so the index must be written last.
+        for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+        {
+            const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
+
+            if (destinationOk[repoListIdx])
+            {
+                destinationOk[repoListIdx] = archivePushFileIo(
+                    archivePushFileIoTypeClose, storageWriteIo(destination[repoListIdx]), NULL, repoData->repoIdx, errorList);
+            }
+
+            if (destinationOk[repoListIdx])
+            {
+                TRY_BEGIN()
+                {
+                    walBundleIndexSave(
+                        storageRepoIdxWrite(repoData->repoIdx),
+                        strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(repoData->archiveId), strZ(prefix)),
+                        destinationIndex[repoListIdx]);
+                }
+                CATCH_ANY()
+                {
+                    archivePushErrorAdd(errorList, repoData->repoIdx);
+                }
+                TRY_END();
+            }
+        }
+
+        // Throw any errors, even if some pushes were successful. It is important that PostgreSQL receives an error so it does not
+        // remove the files.
+        if (strLstSize(errorList) > 0)
+            THROW_FMT(CommandError, CFGCMD_ARCHIVE_PUSH " command encountered error(s):\n%s", strZ(strLstJoin(errorList, "\n")));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_STRUCT(result);
+}
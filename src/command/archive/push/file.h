@@ -31,8 +31,21 @@ typedef struct ArchivePushFileResult
 
 // Copy a file from the source to the archive
 FN_EXTERN ArchivePushFileResult archivePushFile(
-    const String *walSource, bool headerCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
+    const String *walSource, bool headerCheck, bool recordCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
     const String *archiveFile, CompressType compressType, int compressLevel, const List *repoList,
     const StringList *priorErrorList);
 
+typedef struct ArchivePushBundleResult
+{
+    List *fileResultList;                                           // ArchivePushFileResult for each WAL file
+} ArchivePushBundleResult;
+
+// Copy WAL segments from the source path to a bundle in the archive. The WAL segments must be full (not partial) segments with the
+// same 16 character prefix, i.e. in the same path in the archive. The bundle and index for each repo only contain the WAL segments
+// that do not already exist in the repo.
+FN_EXTERN ArchivePushBundleResult archivePushBundle(
+    const String *walPath, const StringList *walFileList, bool headerCheck, bool recordCheck, bool modeCheck,
+    unsigned int pgVersion, uint64_t pgSystemId, CompressType compressType, int compressLevel, const List *repoList,
+    const StringList *priorErrorList);
+
 #endif
@@ -12,6 +12,44 @@ Archive Push Protocol Handler
 #include "config/config.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Read the repo data for each repo to push to
+***********************************************************************************************************************************/
+static List *
+archivePushProtocolRepoList(PackRead *const param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_READ, param);
+    FUNCTION_TEST_END();
+
+    ASSERT(param != NULL);
+
+    List *const result = lstNewP(sizeof(ArchivePushFileRepoData));
+
+    MEM_CONTEXT_OBJ_BEGIN(result)
+    {
+        pckReadArrayBeginP(param);
+
+        while (!pckReadNullP(param))
+        {
+            pckReadObjBeginP(param);
+
+            ArchivePushFileRepoData repo = {.repoIdx = pckReadU32P(param)};
+            repo.archiveId = pckReadStrP(param);
+            repo.cipherType = pckReadU64P(param);
+            repo.cipherPass = pckReadStrP(param);
+            pckReadObjEndP(param);
+
+            lstAdd(result, &repo);
+        }
+
+        pckReadArrayEndP(param);
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN(LIST, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 archivePushFileProtocol(PackRead *const param, ProtocolServer *const server)
@@ -29,6 +67,7 @@ archivePushFileProtocol(PackRead *const param, ProtocolServer *const server)
         // Read parameters
         const String *const walSource = pckReadStrP(param);
         const bool headerCheck = pckReadBoolP(param);
+        const bool recordCheck = pckReadBoolP(param);
         const bool modeCheck = pckReadBoolP(param);
         const unsigned int pgVersion = pckReadU32P(param);
         const uint64_t pgSystemId = pckReadU64P(param);
@@ -38,32 +77,61 @@ archivePushFileProtocol(PackRead *const param, ProtocolServer *const server)
         const StringList *const priorErrorList = pckReadStrLstP(param);
 
         // Read repo data
-        List *const repoList = lstNewP(sizeof(ArchivePushFileRepoData));
+        const List *const repoList = archivePushProtocolRepoList(param);
 
-        pckReadArrayBeginP(param);
+        // Push file
+        const ArchivePushFileResult fileResult = archivePushFile(
+            walSource, headerCheck, recordCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel,
+            repoList, priorErrorList);
 
-        while (!pckReadNullP(param))
-        {
-            pckReadObjBeginP(param);
+        // Return result
+        protocolServerDataPut(server, pckWriteStrLstP(protocolPackNew(), fileResult.warnList));
+        protocolServerDataEndPut(server);
+    }
+    MEM_CONTEXT_TEMP_END();
 
-            ArchivePushFileRepoData repo = {.repoIdx = pckReadU32P(param)};
-            repo.archiveId = pckReadStrP(param);
-            repo.cipherType = pckReadU64P(param);
-            repo.cipherPass = pckReadStrP(param);
-            pckReadObjEndP(param);
+    FUNCTION_LOG_RETURN_VOID();
+}
 
-            lstAdd(repoList, &repo);
-        }
+/**********************************************************************************************************************************/
+FN_EXTERN void
+archivePushBundleProtocol(PackRead *const param, ProtocolServer *const server)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, server);
+    FUNCTION_LOG_END();
 
-        pckReadArrayEndP(param);
+    ASSERT(param != NULL);
+    ASSERT(server != NULL);
 
-        // Push file
-        const ArchivePushFileResult fileResult = archivePushFile(
-            walSource, headerCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel, repoList,
-            priorErrorList);
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read parameters
+        const String *const walPath = pckReadStrP(param);
+        const StringList *const walFileList = pckReadStrLstP(param);
+        const bool headerCheck = pckReadBoolP(param);
+        const bool recordCheck = pckReadBoolP(param);
+        const bool modeCheck = pckReadBoolP(param);
+        const unsigned int pgVersion = pckReadU32P(param);
+        const uint64_t pgSystemId = pckReadU64P(param);
+        const CompressType compressType = pckReadU32P(param);
+        const int compressLevel = pckReadI32P(param);
+        const StringList *const priorErrorList = pckReadStrLstP(param);
+        const List *const repoList = archivePushProtocolRepoList(param);
 
-        // Return result
-        protocolServerDataPut(server, pckWriteStrLstP(protocolPackNew(), fileResult.warnList));
+        // Push bundle
+        const ArchivePushBundleResult bundleResult = archivePushBundle(
+            walPath, walFileList, headerCheck, recordCheck, modeCheck, pgVersion, pgSystemId, compressType, compressLevel,
+            repoList, priorErrorList);
+
+        // Return warnings for each file
+        PackWrite *const resultPack = protocolPackNew();
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(bundleResult.fileResultList); fileIdx++)
+            pckWriteStrLstP(resultPack, ((ArchivePushFileResult *)lstGet(bundleResult.fileResultList, fileIdx))->warnList);
+
+        protocolServerDataPut(server, resultPack);
         protocolServerDataEndPut(server);
     }
     MEM_CONTEXT_TEMP_END();
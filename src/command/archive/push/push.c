@@ -231,12 +231,9 @@ archivePushCheck(const bool pgPathSet)
                 // Get the repo storage in case it is remote and encryption settings need to be pulled down
                 storageRepoIdx(repoIdx);
 
-                // Get cipher type
-                const CipherType repoCipherType = cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx);
-
                 // Attempt to load the archive info file
                 const InfoArchive *const info = infoArchiveLoadFile(
-                    storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, repoCipherType,
+                    storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx),
                     cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
 
                 // Get archive id for the most recent version -- archive-push will only operate against the most recent version
@@ -269,7 +266,7 @@ archivePushCheck(const bool pgPathSet)
                     {
                         .repoIdx = repoIdx,
                         .archiveId = strDup(archiveId),
-                        .cipherType = repoCipherType,
+                        .cipherType = infoArchiveCipherType(info),
                         .cipherPass = strDup(infoArchiveCipherPass(info)),
                     };
 
@@ -329,6 +326,7 @@ cmdArchivePush(void)
         {
             bool pushed = false;                                        // Has the WAL segment been pushed yet?
             bool forked = false;                                        // Has the async process been forked yet?
+            bool notified = false;                                      // Has a running async process been notified?
             bool throwOnError = false;                                  // Should we throw errors?
 
             // pg1-path is not optional for async mode
@@ -377,6 +375,15 @@ cmdArchivePush(void)
                     // enough to do the job, running it again won't help anything.
                     forked = true;
                 }
+                // Else an async process is already running so notify it in case it is lingering
+                else if (!pushed && !forked && !notified && cfgOptionUInt64(cfgOptArchivePushLinger) > 0)
+                {
+                    // Clear errors for the current archive file so a stale error is not thrown while the async process retries
+                    archiveAsyncErrorClear(archiveModePush, archiveFile);
+
+                    archiveAsyncNotify(archiveModePush, archiveFile);
+                    notified = true;
+                }
 
                 // Now that the async process has been launched, throw any errors that are found
                 throwOnError = true;
@@ -412,9 +419,10 @@ cmdArchivePush(void)
 
                 // Push the file to the archive
                 const ArchivePushFileResult fileResult = archivePushFile(
-                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion,
-                    archiveInfo.pgSystemId, archiveFile, compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
-                    cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList, archiveInfo.errorList);
+                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveRecordCheck),
+                    cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion, archiveInfo.pgSystemId, archiveFile,
+                    compressTypeEnum(cfgOptionStrId(cfgOptCompressType)), cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList,
+                    archiveInfo.errorList);
 
                 // If a warning was returned then log it
                 for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -433,14 +441,44 @@ cmdArchivePush(void)
 /**********************************************************************************************************************************/
 typedef struct ArchivePushAsyncData
 {
+    MemContext *memContext;                                         // Context that must outlive processing of a WAL file list
     const String *walPath;                                          // Path to pg_wal/pg_xlog
     const StringList *walFileList;                                  // List of wal files to process
     unsigned int walFileIdx;                                        // Current index in the list to be processed
+    unsigned int bundleMax;                                         // Maximum WAL segments in a bundle
     CompressType compressType;                                      // Type of compression for WAL segments
     int compressLevel;                                              // Compression level for wal files
     ArchivePushCheckResult archiveInfo;                             // Archive info
 } ArchivePushAsyncData;
 
+// Add data for each repo to push to
+static void
+archivePushAsyncRepoParam(PackWrite *const param, const List *const repoList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, param);
+        FUNCTION_TEST_PARAM(LIST, repoList);
+    FUNCTION_TEST_END();
+
+    pckWriteArrayBeginP(param);
+
+    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+    {
+        const ArchivePushFileRepoData *const data = lstGet(repoList, repoListIdx);
+
+        pckWriteObjBeginP(param);
+        pckWriteU32P(param, data->repoIdx);
+        pckWriteStrP(param, data->archiveId);
+        pckWriteU64P(param, data->cipherType);
+        pckWriteStrP(param, data->cipherPass);
+        pckWriteObjEndP(param);
+    }
+
+    pckWriteArrayEndP(param);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static ProtocolParallelJob *
 archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
 {
@@ -464,39 +502,72 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
             const String *const walFile = strLstGet(jobData->walFileList, jobData->walFileIdx);
             jobData->walFileIdx++;
 
-            ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_PUSH_FILE);
-            PackWrite *const param = protocolCommandParam(command);
+            // Add full WAL segments in the same path that follow the WAL file to a bundle
+            StringList *const walFileList = strLstNew();
+            strLstAdd(walFileList, walFile);
 
-            pckWriteStrP(param, strNewFmt("%s/%s", strZ(jobData->walPath), strZ(walFile)));
-            pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
-            pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
-            pckWriteU32P(param, jobData->archiveInfo.pgVersion);
-            pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
-            pckWriteStrP(param, walFile);
-            pckWriteU32P(param, jobData->compressType);
-            pckWriteI32P(param, jobData->compressLevel);
-            pckWriteStrLstP(param, jobData->archiveInfo.errorList);
+            if (walIsSegment(walFile) && !walIsPartial(walFile))
+            {
+                while (strLstSize(walFileList) < jobData->bundleMax && jobData->walFileIdx < strLstSize(jobData->walFileList))
+                {
+                    const String *const walFileNext = strLstGet(jobData->walFileList, jobData->walFileIdx);
+
+                    if (!walIsSegment(walFileNext) || walIsPartial(walFileNext) ||
+                        strncmp(strZ(walFile), strZ(walFileNext), 16) != 0)
+                    {
+                        break;
+                    }
+
+                    strLstAdd(walFileList, walFileNext);
+                    jobData->walFileIdx++;
+                }
+            }
 
-            // Add data for each repo to push to
-            pckWriteArrayBeginP(param);
+            ProtocolCommand *command;
 
-            for (unsigned int repoListIdx = 0; repoListIdx < lstSize(jobData->archiveInfo.repoList); repoListIdx++)
+            // Push a single WAL file
+            if (strLstSize(walFileList) == 1)
             {
-                ArchivePushFileRepoData *data = lstGet(jobData->archiveInfo.repoList, repoListIdx);
-
-                pckWriteObjBeginP(param);
-                pckWriteU32P(param, data->repoIdx);
-                pckWriteStrP(param, data->archiveId);
-                pckWriteU64P(param, data->cipherType);
-                pckWriteStrP(param, data->cipherPass);
-                pckWriteObjEndP(param);
+                command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_PUSH_FILE);
+                PackWrite *const param = protocolCommandParam(command);
+
+                pckWriteStrP(param, strNewFmt("%s/%s", strZ(jobData->walPath), strZ(walFile)));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveRecordCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
+                pckWriteU32P(param, jobData->archiveInfo.pgVersion);
+                pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
+                pckWriteStrP(param, walFile);
+                pckWriteU32P(param, jobData->compressType);
+                pckWriteI32P(param, jobData->compressLevel);
+                pckWriteStrLstP(param, jobData->archiveInfo.errorList);
+                archivePushAsyncRepoParam(param, jobData->archiveInfo.repoList);
+            }
+            // Else push a bundle of WAL segments
+            else
+            {
+                command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_PUSH_BUNDLE);
+                PackWrite *const param = protocolCommandParam(command);
+
+                pckWriteStrP(param, jobData->walPath);
+                pckWriteStrLstP(param, walFileList);
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveRecordCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
+                pckWriteU32P(param, jobData->archiveInfo.pgVersion);
+                pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
+                pckWriteU32P(param, jobData->compressType);
+                pckWriteI32P(param, jobData->compressLevel);
+                pckWriteStrLstP(param, jobData->archiveInfo.errorList);
+                archivePushAsyncRepoParam(param, jobData->archiveInfo.repoList);
             }
 
-            pckWriteArrayEndP(param);
+            // The job key is the WAL file or the list of WAL segments in the bundle
+            const Variant *const key = strLstSize(walFileList) == 1 ? VARSTR(walFile) : varNewVarLst(varLstNewStrLst(walFileList));
 
             MEM_CONTEXT_PRIOR_BEGIN()
             {
-                result = protocolParallelJobNew(VARSTR(walFile), command);
+                result = protocolParallelJobNew(key, command);
             }
             MEM_CONTEXT_PRIOR_END();
         }
@@ -506,88 +577,96 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
-FN_EXTERN void
-cmdArchivePushAsync(void)
+// Push a list of WAL files
+static void
+archivePushAsyncProcess(ArchivePushAsyncData *const jobData)
 {
-    FUNCTION_LOG_VOID(logLevelDebug);
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, jobData);
+    FUNCTION_LOG_END();
 
-    ASSERT(cfgCommand() == cfgCmdArchivePush && cfgCommandRole() == cfgCmdRoleAsync);
+    FUNCTION_AUDIT_HELPER();
 
-    // PostgreSQL must be local
-    pgIsLocalVerify();
+    ASSERT(jobData != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Make sure there is a parameter with the wal path
-        const StringList *const commandParam = cfgCommandParam();
-
-        if (strLstSize(commandParam) != 1)
-            THROW(ParamRequiredError, "WAL path to push required");
+        jobData->walFileIdx = 0;
 
-        ArchivePushAsyncData jobData =
-        {
-            .walPath = strLstGet(commandParam, 0),
-            .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
-            .compressLevel = cfgOptionInt(cfgOptCompressLevel),
-        };
+        // Limit the bundle size so WAL segments are spread across the processes
+        const unsigned int processMax = cfgOptionUInt(cfgOptProcessMax);
 
-        TRY_BEGIN()
-        {
-            // Test for stop file
-            lockStopTest();
+        jobData->bundleMax = (strLstSize(jobData->walFileList) + processMax - 1) / processMax;
 
-            // Get a list of WAL files that are ready for processing
-            jobData.walFileList = archivePushProcessList(jobData.walPath);
+        if (jobData->bundleMax > cfgOptionUInt(cfgOptArchivePushBundleMax))
+            jobData->bundleMax = cfgOptionUInt(cfgOptArchivePushBundleMax);
 
-            // The archive-push:async command should not have been called unless there are WAL files to process
-            if (strLstEmpty(jobData.walFileList))
-                THROW(AssertError, "no WAL files to process");
+        LOG_INFO_FMT(
+            "push %u WAL file(s) to archive: %s%s", strLstSize(jobData->walFileList), strZ(strLstGet(jobData->walFileList, 0)),
+            strLstSize(jobData->walFileList) == 1 ?
+                "" : zNewFmt("...%s", strZ(strLstGet(jobData->walFileList, strLstSize(jobData->walFileList) - 1))));
 
-            LOG_INFO_FMT(
-                "push %u WAL file(s) to archive: %s%s", strLstSize(jobData.walFileList), strZ(strLstGet(jobData.walFileList, 0)),
-                strLstSize(jobData.walFileList) == 1 ?
-                    "" : zNewFmt("...%s", strZ(strLstGet(jobData.walFileList, strLstSize(jobData.walFileList) - 1))));
+        // Drop files if queue max has been exceeded
+        if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(jobData->walPath, jobData->walFileList))
+        {
+            for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData->walFileList); walFileIdx++)
+            {
+                const String *const walFile = strLstGet(jobData->walFileList, walFileIdx);
+                const String *const warning = archivePushDropWarning(walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
 
-            // Drop files if queue max has been exceeded
-            if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(jobData.walPath, jobData.walFileList))
+                archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
+                LOG_WARN(strZ(warning));
+            }
+        }
+        // Else continue processing
+        else
+        {
+            // Check archive info for each repo. This only needs to be done once when the process is lingering.
+            if (jobData->archiveInfo.repoList == NULL)
             {
-                for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData.walFileList); walFileIdx++)
+                MEM_CONTEXT_BEGIN(jobData->memContext)
                 {
-                    const String *const walFile = strLstGet(jobData.walFileList, walFileIdx);
-                    const String *const warning = archivePushDropWarning(walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
-
-                    archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
-                    LOG_WARN(strZ(warning));
+                    jobData->archiveInfo = archivePushCheck(true);
                 }
+                MEM_CONTEXT_END();
             }
-            // Else continue processing
-            else
-            {
-                // Check archive info for each repo
-                jobData.archiveInfo = archivePushCheck(true);
 
-                // Create the parallel executor
-                ProtocolParallel *const parallelExec = protocolParallelNew(
-                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archivePushAsyncCallback, &jobData);
+            // Create the parallel executor. Local processes are reused when the process is lingering.
+            ProtocolParallel *const parallelExec = protocolParallelNewP(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archivePushAsyncCallback, jobData);
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
-                // Process jobs
-                MEM_CONTEXT_TEMP_RESET_BEGIN()
+            // Process jobs
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
                 {
-                    do
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
                     {
-                        const unsigned int completed = protocolParallelProcess(parallelExec);
+                        protocolKeepAlive();
+
+                        // Get the job and job key
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                        const unsigned int processId = protocolParallelJobProcessId(job);
+                        const Variant *const jobKey = protocolParallelJobKey(job);
+                        StringList *walFileList;
 
-                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                        // The job key is a WAL file or a list of WAL segments in a bundle
+                        if (varType(jobKey) == varTypeString)
                         {
-                            protocolKeepAlive();
+                            walFileList = strLstNew();
+                            strLstAdd(walFileList, varStr(jobKey));
+                        }
+                        else
+                            walFileList = strLstNewVarLst(varVarLst(jobKey));
 
-                            // Get the job and job key
-                            ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
-                            const unsigned int processId = protocolParallelJobProcessId(job);
-                            const String *const walFile = varStr(protocolParallelJobKey(job));
+                        for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(walFileList); walFileIdx++)
+                        {
+                            const String *const walFile = strLstGet(walFileList, walFileIdx);
 
                             // The job was successful
                             if (protocolParallelJobErrorCode(job) == 0)
@@ -617,16 +696,90 @@ cmdArchivePushAsync(void)
                                     archiveModePush, walFile, protocolParallelJobErrorCode(job),
                                     protocolParallelJobErrorMessage(job));
                             }
-
-                            protocolParallelJobFree(job);
                         }
 
-                        // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                        MEM_CONTEXT_TEMP_RESET(1000);
+                        protocolParallelJobFree(job);
+                    }
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+                while (!protocolParallelDone(parallelExec));
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+FN_EXTERN void
+cmdArchivePushAsync(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    ASSERT(cfgCommand() == cfgCmdArchivePush && cfgCommandRole() == cfgCmdRoleAsync);
+
+    // PostgreSQL must be local
+    pgIsLocalVerify();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Make sure there is a parameter with the wal path
+        const StringList *const commandParam = cfgCommandParam();
+
+        if (strLstSize(commandParam) != 1)
+            THROW(ParamRequiredError, "WAL path to push required");
+
+        ArchivePushAsyncData jobData =
+        {
+            .memContext = memContextCurrent(),
+            .walPath = strLstGet(commandParam, 0),
+            .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
+            .compressLevel = cfgOptionInt(cfgOptCompressLevel),
+        };
+
+        TRY_BEGIN()
+        {
+            // Test for stop file
+            lockStopTest();
+
+            // Get a list of WAL files that are ready for processing
+            jobData.walFileList = archivePushProcessList(jobData.walPath);
+
+            // The archive-push:async command should not have been called unless there are WAL files to process
+            if (strLstEmpty(jobData.walFileList))
+                THROW(AssertError, "no WAL files to process");
+
+            archivePushAsyncProcess(&jobData);
+
+            // Linger to push WAL files that are ready before the linger time expires. This saves starting a new async process (and
+            // new local processes) for each WAL file when WAL is being generated quickly.
+            const TimeMSec linger = cfgOptionUInt64(cfgOptArchivePushLinger);
+
+            if (linger > 0)
+            {
+                // Listen before checking for ready WAL files so notifications for WAL files that become ready after the check are
+                // not missed
+                ArchiveAsyncListen *const listen = archiveAsyncListenNew(archiveModePush);
+
+                do
+                {
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        lockStopTest();
+
+                        jobData.walFileList = archivePushProcessList(jobData.walPath);
+
+                        if (!strLstEmpty(jobData.walFileList))
+                            archivePushAsyncProcess(&jobData);
                     }
-                    while (!protocolParallelDone(parallelExec));
+                    MEM_CONTEXT_TEMP_END();
                 }
-                MEM_CONTEXT_TEMP_END();
+                while (archiveAsyncListenWait(listen, linger) != NULL);
+
+                archiveAsyncListenFree(listen);
             }
         }
         // On any global error write a single error file to cover all unprocessed files
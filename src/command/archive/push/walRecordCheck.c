@@ -0,0 +1,412 @@
+/***********************************************************************************************************************************
+WAL Record Check Filter
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "command/archive/push/walRecordCheck.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/macro.h"
+#include "common/type/object.h"
+#include "common/type/pack.h"
+#include "postgres/interface/crc32.h"
+
+/***********************************************************************************************************************************
+WAL page and record layout
+
+These mirror XLogPageHeaderData, XLogLongPageHeaderData, and XLogRecord, which have not changed since PostgreSQL 9.5. Page headers
+and records are aligned with MAXALIGN(), which is emulated with the alignment of a 64-bit integer.
+***********************************************************************************************************************************/
+typedef struct WalAlign
+{
+    char pad;
+    uint64_t value;
+} WalAlign;
+
+#define WAL_ALIGN(size)                                                                                                            \
+    (((size) + offsetof(WalAlign, value) - 1) & ~(offsetof(WalAlign, value) - 1))
+
+typedef struct WalPageHeader
+{
+    uint16_t magic;                                                 // Magic value for the PostgreSQL version
+    uint16_t info;                                                  // Flag bits
+    uint32_t timeline;                                              // Timeline of the first record on the page
+    uint64_t pageAddr;                                              // WAL address of the page
+    uint32_t remainSize;                                            // Bytes remaining in a record continued from the prior page
+} WalPageHeader;
+
+typedef struct WalLongPageHeader
+{
+    WalPageHeader std;                                              // Standard header fields
+    uint64_t systemId;                                              // System identifier from pg_control
+    uint32_t segmentSize;                                           // WAL segment size
+    uint32_t pageSize;                                              // WAL page size
+} WalLongPageHeader;
+
+typedef struct WalRecordHeader
+{
+    uint32_t totalSize;                                             // Total size of the record including the header
+    uint32_t xid;                                                   // Transaction id
+    uint64_t prior;                                                 // WAL address of the prior record
+    uint8_t info;                                                   // Flag bits
+    uint8_t rmgrId;                                                 // Resource manager
+    uint32_t crc;                                                   // CRC-32C of the data followed by the header up to this field
+} WalRecordHeader;
+
+#define WAL_PAGE_HEADER_SIZE                                        WAL_ALIGN(sizeof(WalPageHeader))
+#define WAL_LONG_PAGE_HEADER_SIZE                                   WAL_ALIGN(sizeof(WalLongPageHeader))
+#define WAL_RECORD_HEADER_SIZE                                      (offsetof(WalRecordHeader, crc) + sizeof(uint32_t))
+
+#define WAL_PAGE_SIZE_MIN                                           1024
+#define WAL_PAGE_SIZE_MAX                                           65536
+
+// Page header flags
+#define WAL_PAGE_FIRST_IS_CONTRECORD                                0x0001
+#define WAL_PAGE_LONG_HEADER                                        0x0002
+#define WAL_PAGE_FIRST_IS_OVERWRITE_CONTRECORD                      0x0008
+
+// XLOG_SWITCH record from the XLOG resource manager. The remainder of the segment is not used after this record.
+#define WAL_RMGR_XLOG                                               0
+#define WAL_RECORD_INFO_MASK                                        0x0F
+#define WAL_RECORD_XLOG_SWITCH                                      0x40
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef enum
+{
+    walRecordCheckStateNone,                                        // Between records
+    walRecordCheckStateSkip,                                        // Skipping a record continued from the prior segment
+    walRecordCheckStateRecord,                                      // Reading a record
+} WalRecordCheckState;
+
+typedef struct WalRecordCheck
+{
+    const String *walFile;                                          // WAL file name for error messages
+
+    unsigned char *page;                                            // Buffer to hold a page while checking records
+    size_t pageSize;                                                // Page size (zero until read from the first page)
+    size_t pageUsed;                                                // Bytes used in the page buffer
+    uint64_t pageNo;                                                // Current page number in the segment
+    uint16_t pageMagic;                                             // Magic value from the first page
+    uint64_t pageAddr;                                              // WAL address from the first page
+    bool done;                                                      // Has the end of the records been reached?
+
+    WalRecordCheckState state;                                      // Current state
+    uint64_t recordOffset;                                          // Offset of the current record in the segment
+    uint32_t recordSize;                                            // Total size of the current record
+    uint32_t recordRead;                                            // Bytes of the current record that have been read
+    WalRecordHeader recordHeader;                                   // Header of the current record (may span pages)
+    uint32_t recordCrc;                                             // CRC-32C of the current record data
+
+    uint64_t recordTotal;                                           // Total records checked
+} WalRecordCheck;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static void
+walRecordCheckToLog(const WalRecordCheck *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{pageNo: %" PRIu64 ", recordTotal: %" PRIu64 "}", this->pageNo, this->recordTotal);
+}
+
+#define FUNCTION_LOG_WAL_RECORD_CHECK_TYPE                                                                                         \
+    WalRecordCheck *
+#define FUNCTION_LOG_WAL_RECORD_CHECK_FORMAT(value, buffer, bufferSize)                                                            \
+    FUNCTION_LOG_OBJECT_FORMAT(value, walRecordCheckToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Get the page size from the long header on the first page
+***********************************************************************************************************************************/
+static void
+walRecordCheckPageSize(WalRecordCheck *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_RECORD_CHECK, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->pageUsed == WAL_LONG_PAGE_HEADER_SIZE);
+
+    const WalLongPageHeader *const header = (const WalLongPageHeader *)this->page;
+
+    if (!(header->std.info & WAL_PAGE_LONG_HEADER))
+        THROW_FMT(FormatError, "WAL file '%s' first page does not have a long header", strZ(this->walFile));
+
+    if (header->pageSize < WAL_PAGE_SIZE_MIN || header->pageSize > WAL_PAGE_SIZE_MAX ||
+        (header->pageSize & (header->pageSize - 1)) != 0)
+    {
+        THROW_FMT(FormatError, "WAL file '%s' has invalid page size %u", strZ(this->walFile), header->pageSize);
+    }
+
+    this->pageSize = header->pageSize;
+    this->pageMagic = header->std.magic;
+    this->pageAddr = header->std.pageAddr;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Check the records in a complete page
+***********************************************************************************************************************************/
+static void
+walRecordCheckPage(WalRecordCheck *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_RECORD_CHECK, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->pageUsed == this->pageSize);
+
+    const WalPageHeader *const header = (const WalPageHeader *)this->page;
+    const uint64_t pageOffset = this->pageNo * this->pageSize;
+
+    // If the page header is not valid then the records have ended, e.g. the rest of the segment is zeroed or was recycled from an
+    // older segment. A record that continues on this page is torn.
+    if (header->magic != this->pageMagic || header->pageAddr != this->pageAddr + pageOffset)
+    {
+        if (this->state != walRecordCheckStateNone)
+        {
+            THROW_FMT(
+                FormatError, "WAL file '%s' record at offset %" PRIu64 " continues on a page with an invalid header",
+                strZ(this->walFile), this->recordOffset);
+        }
+
+        this->done = true;
+        FUNCTION_TEST_RETURN_VOID();
+    }
+
+    // A record in progress that was aborted by a crash is overwritten on this page (PostgreSQL >= 15). The record will never be
+    // replayed so drop it and start checking records after the page header, as xlogreader does.
+    if (this->state != walRecordCheckStateNone && header->info & WAL_PAGE_FIRST_IS_OVERWRITE_CONTRECORD)
+        this->state = walRecordCheckStateNone;
+    // A record in progress must continue on this page with the expected remaining size
+    else if (this->state != walRecordCheckStateNone)
+    {
+        if (!(header->info & WAL_PAGE_FIRST_IS_CONTRECORD) || header->remainSize != this->recordSize - this->recordRead)
+        {
+            THROW_FMT(
+                FormatError, "WAL file '%s' record at offset %" PRIu64 " is not continued on the next page", strZ(this->walFile),
+                this->recordOffset);
+        }
+    }
+    // Else the first page may continue a record from the prior segment, which cannot be checked
+    else if (header->info & WAL_PAGE_FIRST_IS_CONTRECORD)
+    {
+        if (this->pageNo != 0)
+        {
+            THROW_FMT(
+                FormatError, "WAL file '%s' page at offset %" PRIu64 " continues a record that was not started",
+                strZ(this->walFile), pageOffset);
+        }
+
+        this->state = walRecordCheckStateSkip;
+        this->recordOffset = 0;
+        this->recordSize = header->remainSize;
+        this->recordRead = 0;
+    }
+
+    size_t offset = header->info & WAL_PAGE_LONG_HEADER ? WAL_LONG_PAGE_HEADER_SIZE : WAL_PAGE_HEADER_SIZE;
+
+    while (offset < this->pageSize)
+    {
+        // Start a new record
+        if (this->state == walRecordCheckStateNone)
+        {
+            // The size is always on the same page as the start of the record since records are aligned
+            uint32_t recordSize;
+            memcpy(&recordSize, this->page + offset, sizeof(recordSize));
+
+            // Zero size means there are no more records
+            if (recordSize == 0)
+            {
+                this->done = true;
+                break;
+            }
+
+            this->recordOffset = pageOffset + offset;
+
+            if (recordSize < WAL_RECORD_HEADER_SIZE)
+            {
+                THROW_FMT(
+                    FormatError, "WAL file '%s' record at offset %" PRIu64 " has invalid length %u", strZ(this->walFile),
+                    this->recordOffset, recordSize);
+            }
+
+            this->state = walRecordCheckStateRecord;
+            this->recordSize = recordSize;
+            this->recordRead = 0;
+            this->recordCrc = 0;
+        }
+
+        // Read as much of the record as possible from this page
+        size_t readSize = this->recordSize - this->recordRead;
+
+        if (readSize > this->pageSize - offset)
+            readSize = this->pageSize - offset;
+
+        const unsigned char *read = this->page + offset;
+
+        offset += readSize;
+
+        if (this->state == walRecordCheckStateRecord)
+        {
+            // Copy the header since it is checksummed after the data and may span pages
+            if (this->recordRead < WAL_RECORD_HEADER_SIZE)
+            {
+                const size_t headerSize =
+                    readSize < WAL_RECORD_HEADER_SIZE - this->recordRead ? readSize : WAL_RECORD_HEADER_SIZE - this->recordRead;
+
+                memcpy((unsigned char *)&this->recordHeader + this->recordRead, read, headerSize);
+                this->recordRead += (uint32_t)headerSize;
+                read += headerSize;
+                readSize -= headerSize;
+            }
+
+            this->recordCrc = crc32cUpdate(this->recordCrc, read, readSize);
+        }
+
+        this->recordRead += (uint32_t)readSize;
+
+        // Continue on the next page when the record is not complete
+        if (this->recordRead < this->recordSize)
+            break;
+
+        // Check the complete record
+        if (this->state == walRecordCheckStateRecord)
+        {
+            const uint32_t crc = crc32cUpdate(
+                this->recordCrc, (const unsigned char *)&this->recordHeader, offsetof(WalRecordHeader, crc));
+
+            if (crc != this->recordHeader.crc)
+            {
+                THROW_FMT(
+                    ChecksumError, "WAL file '%s' record at offset %" PRIu64 " has checksum %08x but expected %08x",
+                    strZ(this->walFile), this->recordOffset, crc, this->recordHeader.crc);
+            }
+
+            this->recordTotal++;
+
+            // No more records after a switch
+            if (this->recordHeader.rmgrId == WAL_RMGR_XLOG &&
+                (this->recordHeader.info & ~WAL_RECORD_INFO_MASK) == WAL_RECORD_XLOG_SWITCH)
+            {
+                this->done = true;
+                break;
+            }
+        }
+
+        // The next record is aligned
+        this->state = walRecordCheckStateNone;
+        offset = WAL_ALIGN(offset);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Check WAL records
+***********************************************************************************************************************************/
+static void
+walRecordCheckProcess(THIS_VOID, const Buffer *const input)
+{
+    THIS(WalRecordCheck);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_RECORD_CHECK, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(input != NULL);
+
+    size_t inputIdx = 0;
+
+    while (!this->done && inputIdx < bufUsed(input))
+    {
+        // Fill the page buffer. Only the long header is read until the page size is known.
+        size_t copySize = (this->pageSize == 0 ? WAL_LONG_PAGE_HEADER_SIZE : this->pageSize) - this->pageUsed;
+
+        if (copySize > bufUsed(input) - inputIdx)
+            copySize = bufUsed(input) - inputIdx;
+
+        memcpy(this->page + this->pageUsed, bufPtrConst(input) + inputIdx, copySize);
+        this->pageUsed += copySize;
+        inputIdx += copySize;
+
+        if (this->pageSize == 0)
+        {
+            if (this->pageUsed == WAL_LONG_PAGE_HEADER_SIZE)
+                walRecordCheckPageSize(this);
+        }
+        else if (this->pageUsed == this->pageSize)
+        {
+            walRecordCheckPage(this);
+
+            this->pageUsed = 0;
+            this->pageNo++;
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Return filter result
+***********************************************************************************************************************************/
+static Pack *
+walRecordCheckResult(THIS_VOID)
+{
+    THIS(WalRecordCheck);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_RECORD_CHECK, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    Pack *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteU64P(packWrite, this->recordTotal);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PACK, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilter *
+walRecordCheckNew(const String *const walFile)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STRING, walFile);
+    FUNCTION_LOG_END();
+
+    ASSERT(walFile != NULL);
+
+    OBJ_NEW_BEGIN(WalRecordCheck, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalRecordCheck)
+        {
+            .walFile = strDup(walFile),
+            .page = bufPtr(bufNew(WAL_PAGE_SIZE_MAX)),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(
+        IO_FILTER,
+        ioFilterNewP(WAL_RECORD_CHECK_FILTER_TYPE, this, NULL, .in = walRecordCheckProcess, .result = walRecordCheckResult));
+}
@@ -0,0 +1,23 @@
+/***********************************************************************************************************************************
+WAL Record Check Filter
+
+Walk the records in a WAL segment and validate their CRC-32C checksums so corrupt or torn segments are found before they are pushed
+to the repository. Only PostgreSQL >= 9.5 is supported since earlier versions use a different record format.
+***********************************************************************************************************************************/
+#ifndef COMMAND_ARCHIVE_PUSH_WAL_RECORD_CHECK_H
+#define COMMAND_ARCHIVE_PUSH_WAL_RECORD_CHECK_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define WAL_RECORD_CHECK_FILTER_TYPE                                STRID5("wal-rec-chk", 0x2d03d8cb2db0370)
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// The filter result is the number of records validated
+FN_EXTERN IoFilter *walRecordCheckNew(const String *walFile);
+
+#endif
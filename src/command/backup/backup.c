@@ -20,6 +20,7 @@ Backup Command
 #include "common/compress/helper.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/filter/size.h"
 #include "common/log.h"
 #include "common/regExp.h"
@@ -588,7 +589,7 @@ backupBuildIncrPrior(const InfoBackup *const infoBackup)
             {
                 result = manifestLoadFile(
                     storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabelPrior)),
-                    cfgOptionStrId(cfgOptRepoCipherType), infoPgCipherPass(infoBackupPg(infoBackup)));
+                    infoBackupCipherType(infoBackup), infoBackupCipherPass(infoBackup));
                 const ManifestData *const manifestPriorData = manifestData(result);
 
                 LOG_INFO_FMT(
@@ -685,9 +686,12 @@ backupBuildIncr(
             // Build incremental manifest
             manifestBuildIncr(manifest, manifestPrior, (BackupType)cfgOptionStrId(cfgOptType), archiveStart);
 
-            // Set the cipher subpass from prior manifest since we want a single subpass for the entire backup set
+            // Set the cipher subpass and type from prior manifest since we want a single subpass for the entire backup set
             manifestCipherSubPassSet(manifest, manifestCipherSubPass(manifestPrior));
 
+            if (manifestCipherSubPass(manifestPrior) != NULL)
+                manifestCipherSubTypeSet(manifest, manifestCipherSubType(manifestPrior));
+
             // Incremental was built
             result = true;
         }
@@ -697,6 +701,74 @@ backupBuildIncr(
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Load/save the manifest build cache
+***********************************************************************************************************************************/
+#define BACKUP_BUILD_CACHE_FILE                                     STORAGE_SPOOL_BACKUP "/build.cache"
+
+// Load the build cache. An empty cache is returned when the cache is missing or invalid so the next build will list all paths.
+// NULL is returned when the primary is remote since each entry in a cached listing would be checked with a separate request,
+// which is slower than a listing that returns info for all entries in one request.
+static ManifestBuildCache *
+backupBuildCacheLoad(const unsigned int pgIdxPrimary)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, pgIdxPrimary);
+    FUNCTION_LOG_END();
+
+    if (!pgIsLocal(pgIdxPrimary))
+    {
+        LOG_WARN("option " CFGOPT_BACKUP_BUILD_CACHE " is enabled but the primary is remote - all paths will be listed");
+        FUNCTION_LOG_RETURN(MANIFEST_BUILD_CACHE, NULL);
+    }
+
+    ManifestBuildCache *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            const Buffer *const buffer = storageGetP(
+                storageNewReadP(storageSpool(), STRDEF(BACKUP_BUILD_CACHE_FILE), .ignoreMissing = true));
+
+            if (buffer != NULL)
+                result = manifestBuildCacheMove(manifestBuildCacheNewLoad(ioBufferReadNewOpen(buffer)), memContextPrior());
+        }
+        CATCH_ANY()
+        {
+            LOG_WARN_FMT("unable to load build cache, all paths will be listed: %s", errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    if (result == NULL)
+        result = manifestBuildCacheNew();
+
+    FUNCTION_LOG_RETURN(MANIFEST_BUILD_CACHE, result);
+}
+
+// Save the build cache
+static void
+backupBuildCacheSave(const ManifestBuildCache *const buildCache)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST_BUILD_CACHE, buildCache);
+    FUNCTION_LOG_END();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageWrite *const write = storageNewWriteP(storageSpoolWrite(), STRDEF(BACKUP_BUILD_CACHE_FILE));
+
+        ioWriteOpen(storageWriteIo(write));
+        manifestBuildCacheSave(buildCache, storageWriteIo(write));
+        ioWriteClose(storageWriteIo(write));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Check for a backup that can be resumed and merge into the manifest if found
 ***********************************************************************************************************************************/
@@ -807,6 +879,9 @@ backupResumeClean(
                             else if (file.size == 0)
                                 // ??? don't resume zero size files because Perl wouldn't -- can be removed after the migration)
                                 removeReason = "zero size";
+                            // Blocks for a merged split file are stored in bundles which are not resumed
+                            else if (fileResume.blockIncrMapSize != 0 && fileResume.sizeRepo == fileResume.blockIncrMapSize)
+                                removeReason = "blocks stored outside of file";
                             else
                             {
                                 ASSERT(file.copy);
@@ -868,10 +943,11 @@ backupResumeClean(
 
 // Helper to find a resumable backup
 static const Manifest *
-backupResumeFind(const Manifest *const manifest, const String *const cipherPassBackup)
+backupResumeFind(const Manifest *const manifest, const CipherType cipherTypeBackup, const String *const cipherPassBackup)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
     FUNCTION_LOG_END();
 
@@ -916,8 +992,7 @@ backupResumeFind(const Manifest *const manifest, const String *const cipherPassB
                         {
                             TRY_BEGIN()
                             {
-                                manifestResume = manifestLoadFile(
-                                    storageRepo(), manifestFile, cfgOptionStrId(cfgOptRepoCipherType), cipherPassBackup);
+                                manifestResume = manifestLoadFile(storageRepo(), manifestFile, cipherTypeBackup, cipherPassBackup);
                             }
                             CATCH_ANY()
                             {
@@ -996,10 +1071,11 @@ backupResumeFind(const Manifest *const manifest, const String *const cipherPassB
 }
 
 static bool
-backupResume(Manifest *const manifest, const String *const cipherPassBackup)
+backupResume(Manifest *const manifest, const CipherType cipherTypeBackup, const String *const cipherPassBackup)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
     FUNCTION_LOG_END();
 
@@ -1009,7 +1085,7 @@ backupResume(Manifest *const manifest, const String *const cipherPassBackup)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        const Manifest *const manifestResume = backupResumeFind(manifest, cipherPassBackup);
+        const Manifest *const manifestResume = backupResumeFind(manifest, cipherTypeBackup, cipherPassBackup);
 
         // If a resumable backup was found set the label and cipher subpass
         if (manifestResume)
@@ -1024,9 +1100,12 @@ backupResume(Manifest *const manifest, const String *const cipherPassBackup)
                 "resumable backup %s of same type exists -- invalid files will be removed then the backup will resume",
                 strZ(manifestData(manifest)->backupLabel));
 
-            // Copy cipher subpass since it was used to encrypt the resumable files
+            // Copy cipher subpass and type since they were used to encrypt the resumable files
             manifestCipherSubPassSet(manifest, manifestCipherSubPass(manifestResume));
 
+            if (manifestCipherSubPass(manifestResume) != NULL)
+                manifestCipherSubTypeSet(manifest, manifestCipherSubType(manifestResume));
+
             // Clean resumed backup
             const String *const backupPath = strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(manifestData(manifest)->backupLabel));
 
@@ -1195,8 +1274,7 @@ backupFilePut(
             {
                 ioFilterGroupAdd(
                     ioWriteFilterGroup(storageWriteIo(write)),
-                    cipherBlockNewP(
-                        cipherModeEncrypt, cfgOptionStrId(cfgOptRepoCipherType), BUFSTR(manifestCipherSubPass(manifest))));
+                    cipherBlockNewP(cipherModeEncrypt, manifestCipherSubType(manifest), BUFSTR(manifestCipherSubPass(manifest))));
 
                 repoChecksum = true;
             }
@@ -1390,20 +1468,39 @@ backupJobResultPageChecksum(PackRead *const checksumPageResult)
     FUNCTION_LOG_RETURN(VARIANT_LIST, result);
 }
 
+/***********************************************************************************************************************************
+Large block incremental files may be split into ranges that are copied in parallel and then merged into a single repo file. Each
+range is a multiple of the super block size and page size and is stored in a separate bundle, so the range maps can be combined
+without modification and the super blocks stay where the ranges stored them. A file is merged as soon as all of its ranges have been
+copied.
+***********************************************************************************************************************************/
+typedef struct BackupJobSplit
+{
+    const String *name;                                             // File name (must be first member in struct)
+    const String *repoFile;                                         // Repo file
+    uint64_t rangeSize;                                             // Size of each range (except the last)
+    uint64_t bundleId;                                              // Bundle id of the first range (ranges are consecutive)
+    unsigned int rangeNext;                                         // Next range to be copied
+    unsigned int rangeComplete;                                     // Ranges that have been copied
+    List *rangeList;                                                // Range results (BackupFileRange)
+    bool merge;                                                     // Has the merge job been started?
+} BackupJobSplit;
+
 /***********************************************************************************************************************************
 Log the results of a job and throw errors
 ***********************************************************************************************************************************/
 static void
 backupJobResult(
     Manifest *const manifest, const String *const host, const Storage *const storagePg, StringList *const fileRemove,
-    ProtocolParallelJob *const job, const bool bundle, const PgPageSize pageSize, const uint64_t sizeTotal,
-    uint64_t *const sizeProgress, unsigned int *const currentPercentComplete)
+    const List *const splitList, ProtocolParallelJob *const job, const bool bundle, const PgPageSize pageSize,
+    const uint64_t sizeTotal, uint64_t *const sizeProgress, unsigned int *const currentPercentComplete)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
         FUNCTION_LOG_PARAM(STRING, host);
         FUNCTION_LOG_PARAM(STORAGE, storagePg);
         FUNCTION_LOG_PARAM(STRING_LIST, fileRemove);
+        FUNCTION_LOG_PARAM(LIST, splitList);
         FUNCTION_LOG_PARAM(PROTOCOL_PARALLEL_JOB, job);
         FUNCTION_LOG_PARAM(BOOL, bundle);
         FUNCTION_LOG_PARAM(ENUM, pageSize);
@@ -1426,7 +1523,7 @@ backupJobResult(
             const uint64_t bundleId =
                 varType(protocolParallelJobKey(job)) == varTypeUInt64 ? varUInt64(protocolParallelJobKey(job)) : 0;
             PackRead *const jobResult = protocolParallelJobResult(job);
-            unsigned int percentComplete = 0;
+            unsigned int percentComplete = *currentPercentComplete;
 
             while (!pckReadNullP(jobResult))
             {
@@ -1439,7 +1536,34 @@ backupJobResult(
                 const uint64_t repoSize = pckReadU64P(jobResult);
                 const Buffer *const copyChecksum = pckReadBinP(jobResult);
                 const Buffer *const repoChecksum = pckReadBinP(jobResult);
-                PackRead *const checksumPageResult = pckReadPackReadP(jobResult);
+                const Pack *const checksumPagePack = pckReadPackP(jobResult);
+                PackRead *const checksumPageResult = checksumPagePack != NULL ? pckReadNew(checksumPagePack) : NULL;
+
+                // If this is a range of a split file then store the result until all the ranges are complete and the file can be
+                // merged. Progress and logging will be handled when the merge is complete.
+                if (varType(protocolParallelJobKey(job)) == varTypeUInt)
+                {
+                    BackupJobSplit *const split = lstFind(splitList, &file.name);
+                    ASSERT(split != NULL);
+
+                    BackupFileRange *const range = lstGet(split->rangeList, varUInt(protocolParallelJobKey(job)));
+                    range->backupCopyResult = copyResult;
+                    range->copySize = copySize;
+                    range->repoSize = repoSize;
+                    range->blockIncrMapSize = blockIncrMapSize;
+
+                    if (checksumPagePack != NULL)
+                    {
+                        MEM_CONTEXT_BEGIN(lstMemContext(split->rangeList))
+                        {
+                            range->pageChecksumResult = pckDup(checksumPagePack);
+                        }
+                        MEM_CONTEXT_END();
+                    }
+
+                    split->rangeComplete++;
+                    continue;
+                }
 
                 // Increment backup copy progress. Use the original size since the size may have changed during the copy but for the
                 // purpose of reporting progress we need to increment by the original size used to generate the total size.
@@ -1626,10 +1750,12 @@ Save a copy of the backup manifest during processing to preserve checksums for a
 resume is disabled since an incremental copy will not be used in a future backup unless resume is enabled beforehand.
 ***********************************************************************************************************************************/
 static void
-backupManifestSaveCopy(Manifest *const manifest, const String *const cipherPassBackup, const bool final)
+backupManifestSaveCopy(
+    Manifest *const manifest, const CipherType cipherTypeBackup, const String *const cipherPassBackup, const bool final)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
         FUNCTION_LOG_PARAM(BOOL, final);
     FUNCTION_LOG_END();
@@ -1648,8 +1774,7 @@ backupManifestSaveCopy(Manifest *const manifest, const String *const cipherPassB
                         STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, strZ(manifestData(manifest)->backupLabel))));
 
             // Add encryption filter if required
-            cipherBlockFilterGroupAdd(
-                ioWriteFilterGroup(write), cfgOptionStrId(cfgOptRepoCipherType), cipherModeEncrypt, cipherPassBackup);
+            cipherBlockFilterGroupAdd(ioWriteFilterGroup(write), cipherTypeBackup, cipherModeEncrypt, cipherPassBackup);
 
             // Save file
             manifestSave(manifest, write);
@@ -1698,15 +1823,19 @@ typedef struct BackupJobData
     const PgPageSize pageSize;                                      // Page size
     const CompressType compressType;                                // Backup compression type
     const int compressLevel;                                        // Compress level if backup is compressed
+    const unsigned int compressThread;                              // Compress worker threads if backup is compressed
     const bool delta;                                               // Is this a checksum delta backup?
     const bool bundle;                                              // Bundle files?
     uint64_t bundleSize;                                            // Target bundle size
     uint64_t bundleLimit;                                           // Limit on files to bundle
     uint64_t bundleId;                                              // Bundle id
     const bool blockIncr;                                           // Block incremental?
+    const bool blockIncrStore;                                      // Store block incremental blocks in the block store?
     size_t blockIncrSizeSuper;                                      // Super block size
+    uint64_t blockIncrSplitSize;                                    // Split files larger than this into ranges (0 if no split)
 
     List *queueList;                                                // List of processing queues
+    List *splitList;                                                // List of files split into ranges
 } BackupJobData;
 
 // Identify files that must be copied from the primary
@@ -1925,6 +2054,263 @@ backupJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned in
     FUNCTION_TEST_RETURN(INT, queueIdx);
 }
 
+// Helper to add parameters that are common to all backup file jobs
+static void
+backupJobParamCommon(PackWrite *const param, const BackupJobData *const jobData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, param);
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+    FUNCTION_TEST_END();
+
+    ASSERT(param != NULL);
+    ASSERT(jobData != NULL);
+
+    // Provide the backup reference
+    pckWriteU64P(param, strLstSize(manifestReferenceList(jobData->manifest)) - 1);
+    pckWriteBoolP(param, jobData->blockIncrStore);
+
+    pckWriteU32P(param, jobData->compressType);
+    pckWriteI32P(param, jobData->compressLevel);
+    pckWriteU32P(param, jobData->compressThread);
+    pckWriteU64P(param, jobData->cipherSubPass == NULL ? cipherTypeNone : jobData->cipherType);
+    pckWriteStrP(param, jobData->cipherSubPass);
+    pckWriteU32P(param, jobData->pageSize);
+    pckWriteStrP(param, cfgOptionStrNull(cfgOptPgVersionForce));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to add the location of the prior block map for a block incremental file (null when there is no prior map)
+static void
+backupJobParamBlockMapPrior(PackWrite *const param, const ManifestFile *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, param);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(param != NULL);
+    ASSERT(file != NULL);
+
+    if (file->blockIncrMapSize != 0 && !file->resume)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            pckWriteStrP(
+                param,
+                backupFileRepoPathP(file->reference, .manifestName = file->name, .bundleId = file->bundleId, .blockIncr = true));
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        pckWriteU64P(param, file->bundleOffset + file->sizeRepo - file->blockIncrMapSize);
+        pckWriteU64P(param, file->blockIncrMapSize);
+    }
+    else
+        pckWriteNullP(param);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to get the range size when a block incremental file is large enough to be split, else 0. The range size is rounded up to a
+// multiple of the super block size (which is always a multiple of the block size). The range size must also be a multiple of the
+// page size so page checksums can be validated for each range.
+static uint64_t
+backupJobSplitSize(const BackupJobData *const jobData, const ManifestFile *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(file != NULL);
+    ASSERT(file->blockIncrSize > 0);
+
+    uint64_t result = 0;
+
+    if (jobData->blockIncrSplitSize != 0)
+    {
+        const uint64_t superBlockSize =
+            (jobData->blockIncrSizeSuper + file->blockIncrSize - 1) / file->blockIncrSize * file->blockIncrSize;
+        uint64_t rangeSize = (jobData->blockIncrSplitSize + superBlockSize - 1) / superBlockSize * superBlockSize;
+
+        while (rangeSize % jobData->pageSize != 0)
+            rangeSize += superBlockSize;
+
+        if (file->sizeOriginal > rangeSize)
+            result = rangeSize;
+    }
+
+    FUNCTION_TEST_RETURN(UINT64, result);
+}
+
+// Helper to split a block incremental file into ranges. Each range is compared to the prior map (if any) starting at the first
+// block of the range. Delta and resumed files are copied again rather than checked as a whole since no range has the whole file.
+static void
+backupJobSplitAdd(BackupJobData *const jobData, const ManifestFile *const file, const uint64_t rangeSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+        FUNCTION_TEST_PARAM(UINT64, rangeSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(jobData->bundle);
+    ASSERT(file != NULL);
+    ASSERT(rangeSize > 0);
+
+    MEM_CONTEXT_BEGIN(lstMemContext(jobData->splitList))
+    {
+        BackupJobSplit split =
+        {
+            .name = strDup(file->name),
+            .repoFile = backupFileRepoPathP(jobData->backupLabel, .manifestName = file->name, .blockIncr = true),
+            .rangeSize = rangeSize,
+            .bundleId = jobData->bundleId,
+            .rangeList = lstNewP(sizeof(BackupFileRange)),
+        };
+
+        // Each range is stored in a separate bundle that is referenced by the merged map
+        const unsigned int rangeTotal = (unsigned int)((file->sizeOriginal + rangeSize - 1) / rangeSize);
+
+        for (unsigned int rangeIdx = 0; rangeIdx < rangeTotal; rangeIdx++)
+        {
+            const BackupFileRange range =
+            {
+                .repoFile = backupFileRepoPathP(jobData->backupLabel, .bundleId = split.bundleId + rangeIdx),
+            };
+
+            lstAdd(split.rangeList, &range);
+        }
+
+        jobData->bundleId += rangeTotal;
+
+        lstAdd(jobData->splitList, &split);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to get the next job for split files. A file is merged as soon as all of its ranges have been copied, otherwise the next
+// range is copied before starting on new files.
+static ProtocolParallelJob *
+backupJobSplitNext(BackupJobData *const jobData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+
+    ProtocolParallelJob *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Merge the next file where all ranges have been copied
+        for (unsigned int splitIdx = 0; splitIdx < lstSize(jobData->splitList); splitIdx++)
+        {
+            BackupJobSplit *const split = lstGet(jobData->splitList, splitIdx);
+
+            if (!split->merge && split->rangeComplete == lstSize(split->rangeList))
+            {
+                const ManifestFile file = manifestFileFind(jobData->manifest, split->name);
+                ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_BACKUP_FILE_MERGE);
+                PackWrite *const param = protocolCommandParam(command);
+
+                pckWriteStrP(param, split->repoFile);
+                pckWriteU32P(param, jobData->compressType);
+                pckWriteU64P(param, jobData->cipherSubPass == NULL ? cipherTypeNone : jobData->cipherType);
+                pckWriteStrP(param, jobData->cipherSubPass);
+                pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
+                pckWriteU64P(param, split->rangeSize);
+
+                pckWriteStrP(param, manifestPathPg(file.name));
+                pckWriteBoolP(param, file.checksumPage);
+                pckWriteU64P(param, file.blockIncrSize);
+                pckWriteU64P(param, file.blockIncrChecksumSize);
+                pckWriteStrP(param, file.name);
+
+                for (unsigned int rangeIdx = 0; rangeIdx < lstSize(split->rangeList); rangeIdx++)
+                {
+                    const BackupFileRange *const range = lstGet(split->rangeList, rangeIdx);
+
+                    pckWriteStrP(param, range->repoFile);
+                    pckWriteU32P(param, range->backupCopyResult);
+                    pckWriteU64P(param, range->copySize);
+                    pckWriteU64P(param, range->repoSize);
+                    pckWriteU64P(param, range->blockIncrMapSize);
+                    pckWritePackP(param, range->pageChecksumResult);
+                }
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = protocolParallelJobNew(VARSTR(split->name), command);
+                }
+                MEM_CONTEXT_PRIOR_END();
+
+                split->merge = true;
+                break;
+            }
+        }
+
+        // Else copy the next range
+        for (unsigned int splitIdx = 0; result == NULL && splitIdx < lstSize(jobData->splitList); splitIdx++)
+        {
+            BackupJobSplit *const split = lstGet(jobData->splitList, splitIdx);
+
+            if (split->rangeNext < lstSize(split->rangeList))
+            {
+                const ManifestFile file = manifestFileFind(jobData->manifest, split->name);
+                const unsigned int rangeIdx = split->rangeNext;
+                ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_BACKUP_FILE);
+                PackWrite *const param = protocolCommandParam(command);
+
+                pckWriteStrP(param, ((const BackupFileRange *)lstGet(split->rangeList, rangeIdx))->repoFile);
+                pckWriteU64P(param, split->bundleId + rangeIdx);
+                pckWriteBoolP(param, manifestData(jobData->manifest)->bundleRaw);
+                backupJobParamCommon(param, jobData);
+
+                // The last range copies the remainder of the file
+                pckWriteStrP(param, manifestPathPg(file.name));
+                pckWriteU64P(param, rangeIdx * split->rangeSize);
+                pckWriteU64P(param, rangeIdx == lstSize(split->rangeList) - 1 ? 0 : split->rangeSize);
+                pckWriteBoolP(param, false);
+                pckWriteBoolP(param, true);
+                pckWriteU64P(param, file.size);
+                pckWriteU64P(param, file.sizeOriginal);
+                pckWriteBoolP(param, !backupProcessFilePrimary(jobData->standbyExp, file.name));
+                pckWriteBinP(param, NULL);
+                pckWriteBoolP(param, file.checksumPage);
+                pckWriteBoolP(param, cfgOptionBool(cfgOptPageHeaderCheck));
+                pckWriteU64P(param, file.blockIncrSize);
+                pckWriteU64P(param, file.blockIncrChecksumSize);
+                pckWriteU64P(param, jobData->blockIncrSizeSuper);
+                backupJobParamBlockMapPrior(param, &file);
+                pckWriteStrP(param, file.name);
+                pckWriteBinP(param, NULL);
+                pckWriteU64P(param, 0);
+                pckWriteBoolP(param, false);
+                pckWriteBoolP(param, false);
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = protocolParallelJobNew(VARUINT(rangeIdx), command);
+                }
+                MEM_CONTEXT_PRIOR_END();
+
+                split->rangeNext++;
+                break;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
 // Callback to fetch backup jobs for the parallel executor
 static ProtocolParallelJob *
 backupJobCallback(void *const data, const unsigned int clientIdx)
@@ -1936,13 +2322,18 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
 
     ASSERT(data != NULL);
 
-    ProtocolParallelJob *result = NULL;
+    // Merge split files and copy ranges before starting on new files
+    BackupJobData *const jobData = data;
+    ProtocolParallelJob *result = backupJobSplitNext(jobData);
+
+    if (result != NULL)
+        FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+
+    // Get a new job if there are any left
+    bool split = false;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get a new job if there are any left
-        BackupJobData *const jobData = data;
-
         // Determine where to begin scanning the queue (we'll stop when we get back here). When copying from the primary during
         // backup from standby only queue 0 will be used.
         const unsigned int queueOffset = jobData->backupStandby && clientIdx > 0 ? 1 : 0;
@@ -1977,6 +2368,24 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                 // Is this file a block incremental?
                 const bool blockIncr = jobData->blockIncr && file.blockIncrSize > 0;
 
+                // Split large block incremental files into ranges that can be copied in parallel. If files have already been added
+                // to the job then continue since the file will be split by a later job.
+                const uint64_t splitSize = blockIncr ? backupJobSplitSize(jobData, &file) : 0;
+
+                if (splitSize != 0)
+                {
+                    if (fileTotal > 0)
+                    {
+                        fileIdx++;
+                        continue;
+                    }
+
+                    backupJobSplitAdd(jobData, &file, splitSize);
+                    lstRemoveIdx(queue, fileIdx);
+                    split = true;
+                    break;
+                }
+
                 // Add common parameters before first file
                 if (param == NULL)
                 {
@@ -2003,18 +2412,12 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                         bundle = false;
                     }
 
-                    // Provide the backup reference
-                    pckWriteU64P(param, strLstSize(manifestReferenceList(jobData->manifest)) - 1);
-
-                    pckWriteU32P(param, jobData->compressType);
-                    pckWriteI32P(param, jobData->compressLevel);
-                    pckWriteU64P(param, jobData->cipherSubPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc);
-                    pckWriteStrP(param, jobData->cipherSubPass);
-                    pckWriteU32P(param, jobData->pageSize);
-                    pckWriteStrP(param, cfgOptionStrNull(cfgOptPgVersionForce));
+                    backupJobParamCommon(param, jobData);
                 }
 
                 pckWriteStrP(param, manifestPathPg(file.name));
+                pckWriteU64P(param, 0);
+                pckWriteU64P(param, 0);
                 pckWriteBoolP(param, file.delta);
                 pckWriteBoolP(param, !strEq(file.name, STRDEF(MANIFEST_TARGET_PGDATA "/" PG_PATH_GLOBAL "/" PG_FILE_PGCONTROL)));
                 pckWriteU64P(param, file.size);
@@ -2031,17 +2434,7 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                     pckWriteU64P(param, file.blockIncrChecksumSize);
                     pckWriteU64P(param, jobData->blockIncrSizeSuper);
 
-                    if (file.blockIncrMapSize != 0 && !file.resume)
-                    {
-                        pckWriteStrP(
-                            param,
-                            backupFileRepoPathP(
-                                file.reference, .manifestName = file.name, .bundleId = file.bundleId, .blockIncr = true));
-                        pckWriteU64P(param, file.bundleOffset + file.sizeRepo - file.blockIncrMapSize);
-                        pckWriteU64P(param, file.blockIncrMapSize);
-                    }
-                    else
-                        pckWriteNullP(param);
+                    backupJobParamBlockMapPrior(param, &file);
                 }
                 else
                     pckWriteU64P(param, 0);
@@ -2063,6 +2456,10 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                     break;
             }
 
+            // Stop when a file has been split so the first range can be copied
+            if (split)
+                break;
+
             if (fileTotal > 0)
             {
                 // Assign job to result
@@ -2086,15 +2483,22 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
     }
     MEM_CONTEXT_TEMP_END();
 
+    // Copy the first range of a file that was split
+    if (split)
+        result = backupJobSplitNext(jobData);
+
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
 static void
-backupProcess(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
+backupProcess(
+    const BackupData *const backupData, Manifest *const manifest, const CipherType cipherTypeBackup,
+    const String *const cipherPassBackup)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(BACKUP_DATA, backupData);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
     FUNCTION_LOG_END();
 
@@ -2111,6 +2515,28 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         const bool hardLink = cfgOptionBool(cfgOptRepoHardlink) && storageFeature(storageRepoWrite(), storageFeatureHardLink);
         const bool backupStandby = backupData->dbStandby != NULL;
 
+        // Write the block store lock before checking for expire in other stanzas, so expire will not remove blocks while the backup
+        // is running (see backupBlockStoreLockWrite() for details). The block store is not used when expire is already running in
+        // another stanza. Blocks will be stored in the backup instead.
+        bool blockIncrStore = cfgOptionBool(cfgOptRepoBlockStore);
+
+        if (blockIncrStore)
+        {
+            backupBlockStoreLockWrite(storageRepoWrite(), cfgOptionStr(cfgOptStanza), false);
+
+            const String *const stanzaExpire = backupBlockStoreLockFind(storageRepoWrite(), cfgOptionStr(cfgOptStanza), true, true);
+
+            if (stanzaExpire != NULL)
+            {
+                LOG_WARN_FMT(
+                    "block store not used because expire is removing blocks in stanza %s\n"
+                    "HINT: if expire is not running in stanza %s then run expire in that stanza to remove the stale lock.",
+                    strZ(stanzaExpire), strZ(stanzaExpire));
+
+                blockIncrStore = false;
+            }
+        }
+
         BackupJobData jobData =
         {
             .manifest = manifest,
@@ -2118,13 +2544,16 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             .backupStandby = backupData->dbStandby != NULL,
             .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
             .compressLevel = cfgOptionInt(cfgOptCompressLevel),
-            .cipherType = cfgOptionStrId(cfgOptRepoCipherType),
+            .compressThread = cfgOptionUInt(cfgOptCompressThread),
+            .cipherType = manifestCipherSubType(manifest),
             .cipherSubPass = manifestCipherSubPass(manifest),
             .pageSize = backupData->pageSize,
             .delta = cfgOptionBool(cfgOptDelta),
             .bundle = cfgOptionBool(cfgOptRepoBundle),
             .bundleId = 1,
             .blockIncr = cfgOptionBool(cfgOptRepoBlock),
+            .blockIncrStore = blockIncrStore,
+            .splitList = lstNewP(sizeof(BackupJobSplit), .comparator = lstComparatorStr),
 
             // Build expression to identify files that can be copied from the standby when standby backup is supported
             .standbyExp = regExpNew(
@@ -2146,6 +2575,12 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             jobData.blockIncrSizeSuper =
                 backupType == backupTypeFull ?
                     (size_t)cfgOptionUInt64(cfgOptRepoBlockSizeSuperFull) : (size_t)cfgOptionUInt64(cfgOptRepoBlockSizeSuper);
+
+            // Split large files into ranges only when there is more than one process to copy the ranges. Files are not split when
+            // backing up from a standby since each range would need to be assigned to a process with access to the file. Ranges are
+            // stored in bundles, which is possible because block incremental requires bundling.
+            if (!jobData.backupStandby && cfgOptionTest(cfgOptRepoBlockSplitSize) && cfgOptionUInt(cfgOptProcessMax) > 1)
+                jobData.blockIncrSplitSize = cfgOptionUInt64(cfgOptRepoBlockSplitSize);
         }
 
         // If this is a full backup or hard-linked and paths are supported then create all paths explicitly so that empty paths will
@@ -2188,21 +2623,6 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         // Generate processing queues
         sizeTotal = backupProcessQueue(backupData, manifest, &jobData);
 
-        // Create the parallel executor
-        ProtocolParallel *const parallelExec = protocolParallelNew(
-            cfgOptionUInt64(cfgOptProtocolTimeout) / 2, backupJobCallback, &jobData);
-
-        // First client is always on the primary
-        protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, backupData->pgIdxPrimary, 1));
-
-        // Create the rest of the clients on the primary or standby depending on the value of backup-standby. Note that standby
-        // backups don't count the primary client in process-max.
-        const unsigned int processMax = cfgOptionUInt(cfgOptProcessMax) + (jobData.backupStandby ? 1 : 0);
-        const unsigned int pgIdx = jobData.backupStandby ? backupData->pgIdxStandby : backupData->pgIdxPrimary;
-
-        for (unsigned int processIdx = 2; processIdx <= processMax; processIdx++)
-            protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, pgIdx, processIdx));
-
         // Maintain a list of files that need to be removed from the manifest when the backup is complete
         StringList *const fileRemove = strLstNew();
 
@@ -2222,6 +2642,22 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             .percentComplete = VARUINT(currentPercentComplete), .sizeComplete = VARUINT64(sizeProgress),
             .size = VARUINT64(sizeTotal));
 
+        // Create the parallel executor. Clients wait for jobs while ranges are being copied since a merge job will be available
+        // when all the ranges of a split file are complete.
+        ProtocolParallel *const parallelExec = protocolParallelNewP(
+            cfgOptionUInt64(cfgOptProtocolTimeout) / 2, backupJobCallback, &jobData, .jobWait = true);
+
+        // First client is always on the primary
+        protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, backupData->pgIdxPrimary, 1));
+
+        // Create the rest of the clients on the primary or standby depending on the value of backup-standby. Note that standby
+        // backups don't count the primary client in process-max.
+        const unsigned int processMax = cfgOptionUInt(cfgOptProcessMax) + (jobData.backupStandby ? 1 : 0);
+        const unsigned int pgIdx = jobData.backupStandby ? backupData->pgIdxStandby : backupData->pgIdxPrimary;
+
+        for (unsigned int processIdx = 2; processIdx <= processMax; processIdx++)
+            protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypePg, pgIdx, processIdx));
+
         MEM_CONTEXT_TEMP_RESET_BEGIN()
         {
             do
@@ -2234,9 +2670,11 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
 
                     backupJobResult(
                         manifest,
-                        backupStandby && protocolParallelJobProcessId(job) > 1 ? backupData->hostStandby : backupData->hostPrimary,
+                        backupStandby && protocolParallelJobProcessId(job) > 1 ?
+                            backupData->hostStandby : backupData->hostPrimary,
                         protocolParallelJobProcessId(job) > 1 ? storagePgIdx(pgIdx) : backupData->storagePrimary,
-                        fileRemove, job, jobData.bundle, jobData.pageSize, sizeTotal, &sizeProgress, &currentPercentComplete);
+                        fileRemove, jobData.splitList, job, jobData.bundle, jobData.pageSize, sizeTotal, &sizeProgress,
+                        &currentPercentComplete);
                 }
 
                 // A keep-alive is required here for the remote holding open the backup connection
@@ -2248,7 +2686,7 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
                 // Save the manifest periodically to preserve checksums for resume
                 if (sizeProgress - manifestSaveLast >= manifestSaveSize)
                 {
-                    backupManifestSaveCopy(manifest, cipherPassBackup, false);
+                    backupManifestSaveCopy(manifest, cipherTypeBackup, cipherPassBackup, false);
                     manifestSaveLast = sizeProgress;
                 }
 
@@ -2324,11 +2762,14 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
 Check and copy WAL segments required to make the backup consistent
 ***********************************************************************************************************************************/
 static void
-backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
+backupArchiveCheckCopy(
+    const BackupData *const backupData, Manifest *const manifest, const CipherType cipherTypeBackup,
+    const String *const cipherPassBackup)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(BACKUP_DATA, backupData);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
     FUNCTION_LOG_END();
 
@@ -2350,7 +2791,7 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                 strZ(pgLsnToWalSegment(backupData->timeline, lsnStop, backupData->walSegmentSize)));
 
             // Save the backup manifest before getting archive logs in case of failure
-            backupManifestSaveCopy(manifest, cipherPassBackup, false);
+            backupManifestSaveCopy(manifest, cipherTypeBackup, cipherPassBackup, false);
 
             // Use base path to set ownership and mode
             const ManifestPath *const basePath = manifestPathFind(manifest, MANIFEST_TARGET_PGDATA_STR);
@@ -2378,15 +2819,20 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                         const CompressType archiveCompressType = compressTypeFromName(archiveFile);
                         const CompressType backupCompressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType));
 
-                        // Open the archive file
+                        // Open the archive file, reading only the range where it is stored when the file is in a bundle
+                        const WalBundleFile *const bundleFile = walSegmentFindBundle(find);
                         StorageRead *const read = storageNewReadP(
                             storageRepo(),
-                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(backupData->archiveId), strZ(archiveFile)));
+                            strNewFmt(
+                                STORAGE_REPO_ARCHIVE "/%s/%s", strZ(backupData->archiveId),
+                                strZ(bundleFile != NULL ? bundleFile->bundle : archiveFile)),
+                            .offset = bundleFile != NULL ? bundleFile->offset : 0,
+                            .limit = bundleFile != NULL ? VARUINT64(bundleFile->size) : NULL);
                         IoFilterGroup *const filterGroup = ioReadFilterGroup(storageReadIo(read));
 
                         // Decrypt with archive key if encrypted
                         cipherBlockFilterGroupAdd(
-                            filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt,
+                            filterGroup, infoArchiveCipherType(backupData->archiveInfo), cipherModeDecrypt,
                             infoArchiveCipherPass(backupData->archiveInfo));
 
                         // Compress/decompress if archive and backup do not have the same compression settings
@@ -2404,7 +2850,7 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
 
                         // Encrypt with backup key if encrypted
                         cipherBlockFilterGroupAdd(
-                            filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeEncrypt, manifestCipherSubPass(manifest));
+                            filterGroup, manifestCipherSubType(manifest), cipherModeEncrypt, manifestCipherSubPass(manifest));
 
                         // Add size filter last to calculate repo size
                         ioFilterGroupAdd(filterGroup, ioSizeNew());
@@ -2471,7 +2917,7 @@ backupComplete(InfoBackup *const infoBackup, Manifest *const manifest)
         // -------------------------------------------------------------------------------------------------------------------------
         manifestValidate(manifest, true);
 
-        backupManifestSaveCopy(manifest, infoPgCipherPass(infoBackupPg(infoBackup)), true);
+        backupManifestSaveCopy(manifest, infoBackupCipherType(infoBackup), infoBackupCipherPass(infoBackup), true);
 
         storageCopy(
             storageNewReadP(
@@ -2487,8 +2933,8 @@ backupComplete(InfoBackup *const infoBackup, Manifest *const manifest)
             storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)));
 
         cipherBlockFilterGroupAdd(
-            ioReadFilterGroup(storageReadIo(manifestRead)), cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt,
-            infoPgCipherPass(infoBackupPg(infoBackup)));
+            ioReadFilterGroup(storageReadIo(manifestRead)), infoBackupCipherType(infoBackup), cipherModeDecrypt,
+            infoBackupCipherPass(infoBackup));
 
         StorageWrite *const manifestWrite = storageNewWriteP(
             storageRepoWrite(),
@@ -2499,8 +2945,8 @@ backupComplete(InfoBackup *const infoBackup, Manifest *const manifest)
         ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(manifestWrite)), compressFilterP(compressTypeGz, 9));
 
         cipherBlockFilterGroupAdd(
-            ioWriteFilterGroup(storageWriteIo(manifestWrite)), cfgOptionStrId(cfgOptRepoCipherType), cipherModeEncrypt,
-            infoPgCipherPass(infoBackupPg(infoBackup)));
+            ioWriteFilterGroup(storageWriteIo(manifestWrite)), infoBackupCipherType(infoBackup), cipherModeEncrypt,
+            infoBackupCipherPass(infoBackup));
 
         storageCopyP(manifestRead, manifestWrite);
 
@@ -2561,7 +3007,8 @@ cmdBackup(void)
         InfoBackup *const infoBackup = infoBackupLoadFileReconstruct(
             storageRepo(), INFO_BACKUP_PATH_FILE_STR, cfgOptionStrId(cfgOptRepoCipherType), cfgOptionStrNull(cfgOptRepoCipherPass));
         const InfoPgData infoPg = infoPgDataCurrent(infoBackupPg(infoBackup));
-        const String *const cipherPassBackup = infoPgCipherPass(infoBackupPg(infoBackup));
+        const CipherType cipherTypeBackup = infoBackupCipherType(infoBackup);
+        const String *const cipherPassBackup = infoBackupCipherPass(infoBackup);
 
         // Get pg storage and database objects
         BackupData *const backupData = backupInit(infoBackup);
@@ -2578,10 +3025,19 @@ cmdBackup(void)
         // Build the manifest
         const ManifestBlockIncrMap blockIncrMap = backupBlockIncrMap();
 
+        ManifestBuildCache *const buildCache = cfgOptionBool(cfgOptBackupBuildCache) ?
+            backupBuildCacheLoad(backupData->pgIdxPrimary) : NULL;
+
         Manifest *const manifest = manifestNewBuild(
             backupData->storagePrimary, infoPg.version, infoPg.catalogVersion, timestampStart, cfgOptionBool(cfgOptOnline),
             cfgOptionBool(cfgOptChecksumPage), cfgOptionBool(cfgOptRepoBundle), cfgOptionBool(cfgOptRepoBlock), &blockIncrMap,
-            strLstNewVarLst(cfgOptionLst(cfgOptExclude)), backupStartResult.tablespaceList);
+            strLstNewVarLst(cfgOptionLst(cfgOptExclude)), backupStartResult.tablespaceList, buildCache);
+
+        if (buildCache != NULL)
+        {
+            backupBuildCacheSave(buildCache);
+            manifestBuildCacheFree(buildCache);
+        }
 
         // Validate the manifest using the copy start time
         manifestBuildValidate(
@@ -2590,14 +3046,19 @@ cmdBackup(void)
 
         // Build an incremental backup if type is not full (manifestPrior will be freed in this call)
         if (!backupBuildIncr(infoBackup, manifest, manifestPrior, backupStartResult.walSegmentName))
+        {
             manifestCipherSubPassSet(manifest, cipherPassGen(cfgOptionStrId(cfgOptRepoCipherType)));
 
+            if (manifestCipherSubPass(manifest) != NULL)
+                manifestCipherSubTypeSet(manifest, cfgOptionStrId(cfgOptRepoCipherType));
+        }
+
         // Set delta if it is not already set and the manifest requires it
         if (!cfgOptionBool(cfgOptDelta) && varBool(manifestData(manifest)->backupOptionDelta))
             cfgOptionSet(cfgOptDelta, cfgSourceParam, BOOL_TRUE_VAR);
 
         // Resume a backup when possible
-        if (!backupResume(manifest, cipherPassBackup))
+        if (!backupResume(manifest, cipherTypeBackup, cipherPassBackup))
         {
             manifestBackupLabelSet(
                 manifest,
@@ -2606,47 +3067,64 @@ cmdBackup(void)
         }
 
         // Save the manifest before processing starts
-        backupManifestSaveCopy(manifest, cipherPassBackup, false);
-
-        // Process the backup manifest
-        backupProcess(backupData, manifest, cipherPassBackup);
+        backupManifestSaveCopy(manifest, cipherTypeBackup, cipherPassBackup, false);
 
-        // Check that the clusters are alive and correctly configured after the backup
-        backupDbPing(backupData, true);
-
-        // The standby db object and protocol won't be used anymore so free them
-        if (backupData->dbStandby != NULL)
+        // The block store lock is written while processing the backup so remove it if the backup fails. Expire will still not
+        // remove blocks while the failed backup remains in the repository since the backup is not in the backup list.
+        TRY_BEGIN()
         {
-            dbFree(backupData->dbStandby);
-            protocolRemoteFree(backupData->pgIdxStandby);
-        }
-
-        // Stop the backup
-        const BackupStopResult backupStopResult = backupStop(backupData, manifest);
+            // Process the backup manifest
+            backupProcess(backupData, manifest, cipherTypeBackup, cipherPassBackup);
 
-        // Complete manifest
-        manifestBuildComplete(
-            manifest, backupStartResult.lsn, backupStartResult.walSegmentName, backupStopResult.timestamp, backupStopResult.lsn,
-            backupStopResult.walSegmentName, infoPg.id, infoPg.systemId, backupStartResult.dbList,
-            cfgOptionBool(cfgOptArchiveCheck), cfgOptionBool(cfgOptArchiveCopy), cfgOptionUInt(cfgOptBufferSize),
-            cfgOptionUInt(cfgOptCompressLevel), cfgOptionUInt(cfgOptCompressLevelNetwork), cfgOptionBool(cfgOptRepoHardlink),
-            cfgOptionUInt(cfgOptProcessMax), backupData->dbStandby != NULL,
-            cfgOptionTest(cfgOptAnnotation) ? cfgOptionKv(cfgOptAnnotation) : NULL);
+            // Check that the clusters are alive and correctly configured after the backup
+            backupDbPing(backupData, true);
 
-        // The primary db object won't be used anymore so free it
-        dbFree(backupData->dbPrimary);
-
-        // Check and copy WAL segments required to make the backup consistent
-        backupArchiveCheckCopy(backupData, manifest, cipherPassBackup);
+            // The standby db object and protocol won't be used anymore so free them
+            if (backupData->dbStandby != NULL)
+            {
+                dbFree(backupData->dbStandby);
+                protocolRemoteFree(backupData->pgIdxStandby);
+            }
 
-        // The primary protocol connection won't be used anymore so free it. This needs to happen after backupArchiveCheckCopy() so
-        // the backup lock is held on the remote which allows conditional archiving based on the backup lock. Any further access to
-        // the primary storage object may result in an error (likely eof).
-        protocolRemoteFree(backupData->pgIdxPrimary);
+            // Stop the backup
+            const BackupStopResult backupStopResult = backupStop(backupData, manifest);
+
+            // Complete manifest
+            manifestBuildComplete(
+                manifest, backupStartResult.lsn, backupStartResult.walSegmentName, backupStopResult.timestamp, backupStopResult.lsn,
+                backupStopResult.walSegmentName, infoPg.id, infoPg.systemId, backupStartResult.dbList,
+                cfgOptionBool(cfgOptArchiveCheck), cfgOptionBool(cfgOptArchiveCopy), cfgOptionUInt(cfgOptBufferSize),
+                cfgOptionUInt(cfgOptCompressLevel), cfgOptionUInt(cfgOptCompressLevelNetwork), cfgOptionBool(cfgOptRepoHardlink),
+                cfgOptionUInt(cfgOptProcessMax), backupData->dbStandby != NULL,
+                cfgOptionTest(cfgOptAnnotation) ? cfgOptionKv(cfgOptAnnotation) : NULL);
+
+            // The primary db object won't be used anymore so free it
+            dbFree(backupData->dbPrimary);
+
+            // Check and copy WAL segments required to make the backup consistent
+            backupArchiveCheckCopy(backupData, manifest, cipherTypeBackup, cipherPassBackup);
+
+            // The primary protocol connection won't be used anymore so free it. This needs to happen after backupArchiveCheckCopy()
+            // so the backup lock is held on the remote which allows conditional archiving based on the backup lock. Any further
+            // access to the primary storage object may result in an error (likely eof).
+            protocolRemoteFree(backupData->pgIdxPrimary);
+
+            // Complete the backup
+            LOG_INFO_FMT("new backup label = %s", strZ(manifestData(manifest)->backupLabel));
+            backupComplete(infoBackup, manifest);
+
+            // Remove the block store lock now that the backup is in the backup list
+            if (cfgOptionBool(cfgOptRepoBlockStore))
+                backupBlockStoreLockRemove(storageRepoWrite(), cfgOptionStr(cfgOptStanza), false);
+        }
+        CATCH_ANY()
+        {
+            if (cfgOptionBool(cfgOptRepoBlockStore))
+                backupBlockStoreLockRemove(storageRepoWrite(), cfgOptionStr(cfgOptStanza), false);
 
-        // Complete the backup
-        LOG_INFO_FMT("new backup label = %s", strZ(manifestData(manifest)->backupLabel));
-        backupComplete(infoBackup, manifest);
+            RETHROW();
+        }
+        TRY_END();
 
         // Backup info
         LOG_INFO_FMT(
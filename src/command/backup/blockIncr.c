@@ -5,8 +5,10 @@ Block Incremental Filter
 
 #include "command/backup/blockIncr.h"
 #include "command/backup/blockMap.h"
+#include "command/backup/common.h"
 #include "common/compress/helper.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/common.h"
 #include "common/crypto/xxhash.h"
 #include "common/debug.h"
 #include "common/io/bufferRead.h"
@@ -17,6 +19,8 @@ Block Incremental Filter
 #include "common/log.h"
 #include "common/type/object.h"
 #include "common/type/pack.h"
+#include "storage/helper.h"
+#include "version.h"
 
 /***********************************************************************************************************************************
 Object type
@@ -26,6 +30,8 @@ typedef struct BlockIncr
     unsigned int reference;                                         // Current backup reference
     uint64_t bundleId;                                              // Bundle id
 
+    bool store;                                                     // Write blocks to the block store?
+    CompressType storeCompressType;                                 // Compress type used to name blocks in the block store
     StringId compressType;                                          // Compress filter type
     const Pack *compressParam;                                      // Compress filter parameters
     const Pack *encryptParam;                                       // Encrypt filter parameters
@@ -48,6 +54,7 @@ typedef struct BlockIncr
     BlockMap *blockMapOut;                                          // Output block map
     uint64_t blockMapOutSize;                                       // Output block map size (if any)
     bool blockMapWrite;                                             // Write block map (at least one new/changed block)
+    bool range;                                                     // Is the input a range of the file?
 
     size_t inputOffset;                                             // Input offset
     bool inputSame;                                                 // Input the same data
@@ -68,6 +75,81 @@ blockIncrToLog(const BlockIncr *const this, StringStatic *const debugLog)
 #define FUNCTION_LOG_BLOCK_INCR_FORMAT(value, buffer, bufferSize)                                                                  \
     FUNCTION_LOG_OBJECT_FORMAT(value, blockIncrToLog, buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Write a block to the block store, unless it is already there, and add it to the map. Blocks are found using the block store cache
+(see backupBlockStoreFind()) rather than checking the repository for each block.
+***********************************************************************************************************************************/
+static void
+blockIncrStore(BlockIncr *const this, const Buffer *const checksum)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(BLOCK_INCR, this);
+        FUNCTION_LOG_PARAM(BUFFER, checksum);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(checksum != NULL);
+    ASSERT(bufUsed(checksum) == XX_HASH_SIZE_MAX);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        BlockMapItem blockMapItem =
+        {
+            .reference = BLOCK_MAP_REFERENCE_STORE,
+            .superBlockSize = this->blockSize,
+            .size = backupBlockStoreFind(storageRepo(), bufPtrConst(checksum), this->storeCompressType),
+        };
+
+        // Compress the block separately and write it to the block store when missing
+        if (blockMapItem.size == 0)
+        {
+            const String *const blockFile = backupBlockStorePath(bufPtrConst(checksum), this->storeCompressType);
+            Buffer *const blockStore = bufNew(0);
+            IoWrite *const write = ioBufferWriteNew(blockStore);
+
+            if (this->compressParam != NULL)
+                ioFilterGroupAdd(ioWriteFilterGroup(write), compressFilterPack(this->compressType, this->compressParam));
+
+            ioWriteOpen(write);
+            ioWrite(write, this->block);
+            ioWriteClose(write);
+
+            // Other processes may be writing the same block so the default temp file cannot be used for an atomic write since all
+            // the writers would share it. Instead write to a unique temp file and move it into place. Object stores do not need
+            // this since writes are always atomic.
+            if (storageFeature(storageRepoWrite(), storageFeaturePath))
+            {
+                unsigned char tmpId[8];
+                cryptoRandomBytes(tmpId, sizeof(tmpId));
+
+                const String *const blockFileTmp = strNewFmt(
+                    "%s.%s." PROJECT_BIN ".tmp", strZ(blockFile), strZ(strNewEncode(encodingHex, BUF(tmpId, sizeof(tmpId)))));
+
+                storagePutP(storageNewWriteP(storageRepoWrite(), blockFileTmp, .noAtomic = true), blockStore);
+                storageMoveP(
+                    storageRepoWrite(), storageNewReadP(storageRepoWrite(), blockFileTmp),
+                    storageNewWriteP(storageRepoWrite(), blockFile));
+            }
+            else
+                storagePutP(storageNewWriteP(storageRepoWrite(), blockFile), blockStore);
+
+            blockMapItem.size = bufUsed(blockStore);
+            backupBlockStoreAdd(storageRepo(), bufPtrConst(checksum), this->storeCompressType, blockMapItem.size);
+        }
+
+        memcpy(blockMapItem.checksum, bufPtrConst(checksum), bufUsed(checksum));
+        blockMapAdd(this->blockMapOut, &blockMapItem);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    bufUsedZero(this->block);
+
+    // Block map must be written since there are new/changed blocks
+    this->blockMapWrite = true;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Generate block incremental
 ***********************************************************************************************************************************/
@@ -121,16 +203,26 @@ blockIncrProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
         {
             MEM_CONTEXT_TEMP_BEGIN()
             {
-                // Get block checksum
-                const Buffer *const checksum = xxHashOne(this->checksumSize, this->block);
+                // Get block checksum. The full checksum is required to locate blocks in the block store but only checksumSize bytes
+                // are compared to the prior map.
+                const Buffer *const checksum = xxHashOne(this->store ? XX_HASH_SIZE_MAX : this->checksumSize, this->block);
 
                 // Does the block exist in the input map?
                 const BlockMapItem *const blockMapItemIn =
                     this->blockMapPrior != NULL && this->blockNo < blockMapSize(this->blockMapPrior) ?
                         blockMapGet(this->blockMapPrior, this->blockNo) : NULL;
 
-                // If the block is new or has changed then write it
-                if (blockMapItemIn == NULL || memcmp(blockMapItemIn->checksum, bufPtrConst(checksum), this->checksumSize) != 0)
+                // Is the block new or changed?
+                const bool blockChanged =
+                    blockMapItemIn == NULL || memcmp(blockMapItemIn->checksum, bufPtrConst(checksum), this->checksumSize) != 0;
+
+                // If the block is new or has changed and the block store is enabled then write it to the block store
+                if (blockChanged && this->store)
+                {
+                    blockIncrStore(this, checksum);
+                }
+                // Else if the block is new or has changed then write it to the super block
+                else if (blockChanged)
                 {
                     // Begin the super block
                     if (this->blockOutWrite == NULL)
@@ -232,9 +324,10 @@ blockIncrProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
             this->blockMapWrite = true;
         }
 
-        // Write the block map if done processing and there are new/changed blocks or block list has been truncated
+        // Write the block map if done processing and there are new/changed blocks, the block list has been truncated, or the input
+        // is a range that is not empty (the file may have been truncated before the range)
         if (this->done && this->blockOutOffset == 0 &&
-            (this->blockMapWrite ||
+            (this->blockMapWrite || (this->range && blockMapSize(this->blockMapOut) > 0) ||
              (this->blockMapPrior != NULL && blockMapSize(this->blockMapOut) < blockMapSize(this->blockMapPrior))))
         {
             MEM_CONTEXT_TEMP_BEGIN()
@@ -361,7 +454,7 @@ FN_EXTERN IoFilter *
 blockIncrNew(
     const uint64_t superBlockSize, const size_t blockSize, const size_t checksumSize, const unsigned int reference,
     const uint64_t bundleId, const uint64_t bundleOffset, const Buffer *const blockMapPrior, const IoFilter *const compress,
-    const IoFilter *const encrypt)
+    const IoFilter *const encrypt, const BlockIncrNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(UINT64, superBlockSize);
@@ -373,8 +466,15 @@ blockIncrNew(
         FUNCTION_LOG_PARAM(BUFFER, blockMapPrior);
         FUNCTION_LOG_PARAM(IO_FILTER, compress);
         FUNCTION_LOG_PARAM(IO_FILTER, encrypt);
+        FUNCTION_LOG_PARAM(BOOL, param.store);
+        FUNCTION_LOG_PARAM(ENUM, param.compressType);
+        FUNCTION_LOG_PARAM(BOOL, param.range);
+        FUNCTION_LOG_PARAM(UINT, param.blockNo);
     FUNCTION_LOG_END();
 
+    ASSERT(!param.store || encrypt == NULL);
+    ASSERT(param.range || param.blockNo == 0);
+
     OBJ_NEW_BEGIN(BlockIncr, .childQty = MEM_CONTEXT_QTY_MAX)
     {
         *this = (BlockIncr)
@@ -384,6 +484,10 @@ blockIncrNew(
             .checksumSize = checksumSize,
             .reference = reference,
             .bundleId = bundleId,
+            .store = param.store,
+            .storeCompressType = param.compressType,
+            .range = param.range,
+            .blockNo = param.blockNo,
             .blockOffset = bundleOffset,
             .block = bufNew(blockSize),
             .blockOut = bufNew(0),
@@ -408,11 +512,20 @@ blockIncrNew(
             {
                 IoRead *const read = ioBufferReadNewOpen(blockMapPrior);
 
+                BlockMap *blockMap;
+
                 MEM_CONTEXT_PRIOR_BEGIN()
                 {
-                    this->blockMapPrior = blockMapNewRead(read, blockSize, checksumSize);
+                    blockMap = blockMapNewRead(read, blockSize, checksumSize);
                 }
                 MEM_CONTEXT_PRIOR_END();
+
+                // The prior map can only be used when its blocks are stored in the same way, i.e. both in the block store or both
+                // in backups. Otherwise all blocks will be stored again.
+                if ((blockMapGet(blockMap, 0)->reference == BLOCK_MAP_REFERENCE_STORE) == param.store)
+                    this->blockMapPrior = blockMap;
+                else
+                    blockMapFree(blockMap);
             }
             MEM_CONTEXT_TEMP_END();
         }
@@ -439,7 +552,13 @@ blockIncrNew(
             pckWriteStrIdP(packWrite, this->compressType);
 
         pckWritePackP(packWrite, this->encryptParam);
+        pckWriteBoolP(packWrite, param.store);
+
+        if (param.store)
+            pckWriteU32P(packWrite, param.compressType);
 
+        pckWriteBoolP(packWrite, param.range);
+        pckWriteU32P(packWrite, param.blockNo);
         pckWriteEndP(packWrite);
 
         paramList = pckMove(pckWriteResult(packWrite), memContextPrior());
@@ -483,9 +602,18 @@ blockIncrNewPack(const Pack *const paramList)
         if (encryptParam != NULL)
             encrypt = cipherBlockNewPack(encryptParam);
 
+        // Block store
+        const bool store = pckReadBoolP(paramListPack);
+        const CompressType storeCompressType = store ? (CompressType)pckReadU32P(paramListPack) : compressTypeNone;
+
+        // Range
+        const bool range = pckReadBoolP(paramListPack);
+        const unsigned int blockNo = pckReadU32P(paramListPack);
+
         result = ioFilterMove(
-            blockIncrNew(
-                superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, compress, encrypt),
+            blockIncrNewP(
+                superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, compress, encrypt,
+                .store = store, .compressType = storeCompressType, .range = range, .blockNo = blockNo),
             memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
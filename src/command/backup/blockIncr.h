@@ -17,6 +17,15 @@ backup. However, the block map may reference super block lists (or parts thereof
 
 The block incremental should be read using BlockDelta since reconstructing the delta is quite involved.
 
+A large file may be split into ranges that are processed separately. Each range must begin on a super block boundary so the block
+numbers of the range can be compared to the prior map. The map is always written for a range, even when no blocks have changed, so
+the range maps can be combined into a map for the entire file.
+
+When the block store is enabled each new/changed block is compressed separately and written to the repository-wide block store
+(unless a block with the same checksum is already there) instead of being added to a super block. The filter output is then only the
+block map. Since the block store is accessed directly the filter must run where the repository is available, i.e. not on a remote
+PostgreSQL host.
+
 The xxHash algorithm is used to determine which blocks have changed. A 128-bit xxHash is generated and then checksumSize bytes are
 used from the hash depending on the size of the block. xxHash claims to have excellent dispersion characteristics, which has been
 verified by testing with SMHasher and a custom test suite. xxHash-32 is used for up to 4MiB content blocks in lz4 and the lower
@@ -28,6 +37,7 @@ SHA1 file checksum. This will fail the backup, which is not ideal, but better th
 #ifndef COMMAND_BACKUP_BLOCK_INCR_H
 #define COMMAND_BACKUP_BLOCK_INCR_H
 
+#include "common/compress/helper.h"
 #include "common/io/filter/filter.h"
 
 /***********************************************************************************************************************************
@@ -38,9 +48,25 @@ Filter type constant
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+typedef struct BlockIncrNewParam
+{
+    VAR_PARAM_HEADER;
+    bool store;                                                     // Write blocks to the block store?
+    CompressType compressType;                                      // Compress type used to name blocks in the block store
+    bool range;                                                     // Is the input a range of the file? (map is always written)
+    unsigned int blockNo;                                           // Block number of the first block in the range
+} BlockIncrNewParam;
+
+#define blockIncrNewP(                                                                                                             \
+    superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, compress, encrypt, ...)             \
+    blockIncrNew(                                                                                                                  \
+        superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, compress, encrypt,              \
+        (BlockIncrNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 FN_EXTERN IoFilter *blockIncrNew(
     uint64_t superBlockSize, size_t blockSize, size_t checksumSize, unsigned int reference, uint64_t bundleId,
-    uint64_t bundleOffset, const Buffer *blockMapPrior, const IoFilter *compress, const IoFilter *encrypt);
+    uint64_t bundleOffset, const Buffer *blockMapPrior, const IoFilter *compress, const IoFilter *encrypt,
+    BlockIncrNewParam param);
 FN_EXTERN IoFilter *blockIncrNewPack(const Pack *paramList);
 
 #endif
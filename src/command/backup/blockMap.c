@@ -26,6 +26,18 @@ The block map is stored as a flag and a series of reference, super block, and bl
       - Checksum.
 
 References, super blocks, and blocks are encoded with a bit that indicates when the last one has been reached.
+
+When the blocks are in the repository-wide block store the flag is followed by a varint-128 encoded block total and then the
+varint-128 encoded stored size and full size checksum for each block. The full size checksum is required because it is used to
+locate the block in the store. References, super blocks, and offsets are not needed since each block is stored separately.
+
+When a reference has blocks in more than one bundle (e.g. when a file was split into ranges that were each stored in a separate
+bundle) the bundle flag is set and every reference that has appeared before and is not a continuation is followed by a varint-128
+encoded bundle id. When the bundle id changes the offset is relative to the beginning of the new bundle.
+
+Versions that predate the store and bundle flags ignore flags they do not know and would read the map incorrectly, so the version
+flag is set whenever the store or bundle flag is set. Older versions will then refuse to read the map. Maps that do not need either
+flag are written without the version flag so they can still be read by older versions.
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
@@ -50,7 +62,9 @@ References, super blocks, and blocks are encoded with a bit that indicates when
 
 typedef enum
 {
-    blockMapFlagVersion = 0,                                        // Version (currently always 0)
+    blockMapFlagVersion = 0,                                        // Version (1 when flags unknown to version 0 are set)
+    blockMapFlagStore = 1,                                          // Blocks are in the block store
+    blockMapFlagBundle = 2,                                         // References may have blocks in more than one bundle
 } BlockMapFlag;
 
 // Stores current information about a reference to avoid needed to encode it again
@@ -82,16 +96,50 @@ lstComparatorBlockMapReference(const void *const blockMapRef1, const void *const
     FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(reference1, reference2));
 }
 
-FN_EXTERN BlockMap *
-blockMapNewRead(IoRead *const map, const size_t blockSize, const size_t checksumSize)
+// Read a map with blocks in the block store
+static BlockMap *
+blockMapNewReadStore(IoRead *const map, const size_t blockSize)
 {
-    FUNCTION_LOG_BEGIN(logLevelTrace);
-        FUNCTION_LOG_PARAM(IO_READ, map);
-    FUNCTION_LOG_END();
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, map);
+        FUNCTION_TEST_PARAM(SIZE, blockSize);
+    FUNCTION_TEST_END();
 
-    // Read flags. Currently the version flag must always be zero. This may be used in the future to indicate if the map version
-    // has changed.
-    CHECK(FormatError, (ioReadVarIntU64(map) & (1 << blockMapFlagVersion)) == 0, "block map version must be zero");
+    BlockMap *const this = blockMapNew();
+    Buffer *const checksum = bufNew(XX_HASH_SIZE_MAX);
+    const uint64_t blockTotal = ioReadVarIntU64(map);
+
+    for (uint64_t blockIdx = 0; blockIdx < blockTotal; blockIdx++)
+    {
+        BlockMapItem blockMapItem =
+        {
+            .reference = BLOCK_MAP_REFERENCE_STORE,
+            .superBlockSize = blockSize,
+            .size = ioReadVarIntU64(map),
+        };
+
+        bufUsedZero(checksum);
+        ioRead(map, checksum);
+        memcpy(blockMapItem.checksum, bufPtr(checksum), bufUsed(checksum));
+
+        lstAdd((List *)this, &blockMapItem);
+    }
+
+    bufFree(checksum);
+
+    FUNCTION_TEST_RETURN(BLOCK_MAP, this);
+}
+
+// Read a map with blocks in super blocks that are stored in backups
+static BlockMap *
+blockMapNewReadReference(IoRead *const map, const size_t blockSize, const size_t checksumSize, const bool bundleMulti)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, map);
+        FUNCTION_TEST_PARAM(SIZE, blockSize);
+        FUNCTION_TEST_PARAM(SIZE, checksumSize);
+        FUNCTION_TEST_PARAM(BOOL, bundleMulti);
+    FUNCTION_TEST_END();
 
     // Read all references in packed format
     BlockMap *const this = blockMapNew();
@@ -148,6 +196,21 @@ blockMapNewRead(IoRead *const map, const size_t blockSize, const size_t checksum
             // Else this is a new reference and super block with a possible offset update
             else
             {
+                // Read bundle id and reset the offset if the bundle has changed
+                if (bundleMulti)
+                {
+                    const uint64_t bundleId = ioReadVarIntU64(map);
+
+                    if (bundleId != referenceData->bundleId)
+                    {
+                        referenceData->bundleId = bundleId;
+                        referenceData->offset = 0;
+                        referenceData->size = 0;
+                    }
+
+                    blockMapItem.bundleId = bundleId;
+                }
+
                 blockMapItem.offset = referenceData->offset + referenceData->size;
 
                 if (referenceEncoded & BLOCK_MAP_FLAG_OFFSET)
@@ -262,30 +325,95 @@ blockMapNewRead(IoRead *const map, const size_t blockSize, const size_t checksum
     lstFree(refList);
     bufFree(checksum);
 
-    FUNCTION_LOG_RETURN(BLOCK_MAP, this);
+    FUNCTION_TEST_RETURN(BLOCK_MAP, this);
 }
 
-/**********************************************************************************************************************************/
-FN_EXTERN void
-blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t blockSize, const size_t checksumSize)
+FN_EXTERN BlockMap *
+blockMapNewRead(IoRead *const map, const size_t blockSize, const size_t checksumSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
-        FUNCTION_LOG_PARAM(BLOCK_MAP, this);
-        FUNCTION_LOG_PARAM(IO_WRITE, output);
-        FUNCTION_LOG_PARAM(SIZE, blockSize);
-        FUNCTION_LOG_PARAM(SIZE, checksumSize);
+        FUNCTION_LOG_PARAM(IO_READ, map);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL);
-    ASSERT(blockMapSize(this) > 0);
-    ASSERT(blockSize > 0);
-    ASSERT(output != NULL);
+    // Read flags. The version flag must be set when the store or bundle flag is set and is not valid otherwise.
+    const uint64_t flag = ioReadVarIntU64(map);
+
+    CHECK(
+        FormatError,
+        ((flag & (1 << blockMapFlagVersion)) != 0) == ((flag & (1 << blockMapFlagStore | 1 << blockMapFlagBundle)) != 0),
+        "block map version does not match flags");
+
+    FUNCTION_LOG_RETURN(
+        BLOCK_MAP,
+        flag & (1 << blockMapFlagStore) ?
+            blockMapNewReadStore(map, blockSize) :
+            blockMapNewReadReference(map, blockSize, checksumSize, flag & (1 << blockMapFlagBundle)));
+}
+
+/**********************************************************************************************************************************/
+// Write a map with blocks in the block store
+static void
+blockMapWriteStore(const BlockMap *const this, IoWrite *const output)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_MAP, this);
+        FUNCTION_TEST_PARAM(IO_WRITE, output);
+    FUNCTION_TEST_END();
+
+    // Write flags and block total
+    ioWriteVarIntU64(output, 1 << blockMapFlagVersion | 1 << blockMapFlagStore);
+    ioWriteVarIntU64(output, blockMapSize(this));
+
+    // Write size and full checksum for each block
+    for (unsigned int blockIdx = 0; blockIdx < blockMapSize(this); blockIdx++)
+    {
+        const BlockMapItem *const block = blockMapGet(this, blockIdx);
+        ASSERT(block->reference == BLOCK_MAP_REFERENCE_STORE);
+
+        ioWriteVarIntU64(output, block->size);
+        ioWrite(output, BUF(block->checksum, XX_HASH_SIZE_MAX));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Write a map with blocks in super blocks that are stored in backups
+static void
+blockMapWriteReference(const BlockMap *const this, IoWrite *const output, const size_t blockSize, const size_t checksumSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_MAP, this);
+        FUNCTION_TEST_PARAM(IO_WRITE, output);
+        FUNCTION_TEST_PARAM(SIZE, blockSize);
+        FUNCTION_TEST_PARAM(SIZE, checksumSize);
+    FUNCTION_TEST_END();
+
+    // Determine if any reference has blocks in more than one bundle
+    List *const refList = lstNewP(sizeof(BlockMapReference), .comparator = lstComparatorBlockMapReference);
+    bool bundleMulti = false;
+
+    for (unsigned int blockIdx = 0; blockIdx < blockMapSize(this); blockIdx++)
+    {
+        const BlockMapItem *const block = blockMapGet(this, blockIdx);
+        const BlockMapReference *const referenceData = lstFind(refList, &(BlockMapReference){.reference = block->reference});
+
+        if (referenceData == NULL)
+        {
+            lstAdd(refList, &(BlockMapReference){.reference = block->reference, .bundleId = block->bundleId});
+        }
+        else if (referenceData->bundleId != block->bundleId)
+        {
+            bundleMulti = true;
+            break;
+        }
+    }
+
+    lstClear(refList);
 
     // Write flags
-    ioWriteVarIntU64(output, 0);
+    ioWriteVarIntU64(output, bundleMulti ? 1 << blockMapFlagVersion | 1 << blockMapFlagBundle : 0);
 
     // Write all references in packed format
-    List *const refList = lstNewP(sizeof(BlockMapReference), .comparator = lstComparatorBlockMapReference);
     unsigned int referenceIdx = 0;
     int64_t sizeLast = 0;
     bool referenceContinue = false;
@@ -301,7 +429,8 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
 
         for (referenceIdx++; referenceIdx < blockMapSize(this); referenceIdx++)
         {
-            if (reference->reference != blockMapGet(this, referenceIdx)->reference)
+            if (reference->reference != blockMapGet(this, referenceIdx)->reference ||
+                reference->bundleId != blockMapGet(this, referenceIdx)->bundleId)
             {
                 referenceEncoded = 0;
                 break;
@@ -347,13 +476,13 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
         else
         {
             ASSERT(reference->reference == referenceData->reference);
-            ASSERT(reference->bundleId == referenceData->bundleId);
-            ASSERT(reference->offset >= referenceData->offset);
+            ASSERT(bundleMulti || reference->bundleId == referenceData->bundleId);
+            ASSERT(reference->bundleId != referenceData->bundleId || reference->offset >= referenceData->offset);
 
             // If the offset is identical then reference is continuing an already started super block. The super block size and
             // block no should be reused. Note that writing the reference is deferred until we know if the continued super block is
             // the last one for the reference.
-            if (reference->offset == referenceData->offset)
+            if (reference->bundleId == referenceData->bundleId && reference->offset == referenceData->offset)
             {
                 ASSERT(reference->superBlockSize == referenceData->superBlockSize);
 
@@ -364,11 +493,22 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
             // prior super block
             else
             {
+                // Reset the offset if the bundle has changed
+                if (reference->bundleId != referenceData->bundleId)
+                {
+                    referenceData->bundleId = reference->bundleId;
+                    referenceData->offset = 0;
+                    referenceData->size = 0;
+                }
+
                 if (reference->offset > referenceData->offset + referenceData->size)
                     referenceEncoded |= BLOCK_MAP_FLAG_OFFSET;
 
                 ioWriteVarIntU64(output, referenceEncoded | reference->reference << BLOCK_MAP_REFERENCE_SHIFT);
 
+                if (bundleMulti)
+                    ioWriteVarIntU64(output, reference->bundleId);
+
                 if (referenceEncoded & BLOCK_MAP_FLAG_OFFSET)
                     ioWriteVarIntU64(output, reference->offset - (referenceData->offset + referenceData->size));
 
@@ -494,5 +634,28 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
 
     lstFree(refList);
 
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN void
+blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t blockSize, const size_t checksumSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(BLOCK_MAP, this);
+        FUNCTION_LOG_PARAM(IO_WRITE, output);
+        FUNCTION_LOG_PARAM(SIZE, blockSize);
+        FUNCTION_LOG_PARAM(SIZE, checksumSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(blockMapSize(this) > 0);
+    ASSERT(blockSize > 0);
+    ASSERT(output != NULL);
+
+    if (blockMapGet(this, 0)->reference == BLOCK_MAP_REFERENCE_STORE)
+        blockMapWriteStore(this, output);
+    else
+        blockMapWriteReference(this, output, blockSize, checksumSize);
+
     FUNCTION_LOG_RETURN_VOID();
 }
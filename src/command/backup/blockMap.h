@@ -4,6 +4,9 @@ Block Incremental Map
 The block incremental map stores the location of blocks of data that have been backed up incrementally. When a file changes, instead
 of copying the entire file, just the blocks that have been changed can be stored. This map does not store the blocks themselves,
 just the location where they can be found. It must be combined with a super block list to be useful (see BlockIncr filter).
+
+Blocks may also be located in the repository-wide block store. In that case every block in the map has the BLOCK_MAP_REFERENCE_STORE
+reference and is stored in a separate file named for the full block checksum (see backupBlockStorePath()).
 ***********************************************************************************************************************************/
 #ifndef COMMAND_BACKUP_BLOCKMAP_H
 #define COMMAND_BACKUP_BLOCKMAP_H
@@ -13,10 +16,15 @@ Object type
 ***********************************************************************************************************************************/
 typedef struct BlockMap BlockMap;
 
+#include <limits.h>
+
 #include "common/crypto/xxhash.h"
 #include "common/type/list.h"
 #include "common/type/object.h"
 
+// Reference for blocks located in the block store
+#define BLOCK_MAP_REFERENCE_STORE                                   UINT_MAX
+
 typedef struct BlockMapItem
 {
     unsigned int reference;                                         // Reference to backup where the block is stored
@@ -3,11 +3,18 @@ Common Functions and Definitions for Backup and Expire Commands
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <limits.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "command/backup/common.h"
+#include "command/lock.h"
+#include "common/crypto/xxhash.h"
 #include "common/debug.h"
+#include "common/encode.h"
 #include "common/log.h"
+#include "common/type/json.h"
+#include "config/config.h"
 #include "storage/helper.h"
 
 /***********************************************************************************************************************************
@@ -15,6 +22,28 @@ Constants
 ***********************************************************************************************************************************/
 #define BACKUP_LINK_LATEST                                          "latest"
 
+#define BACKUP_BLOCK_STORE_LOCK_PATH                                STORAGE_PATH_BLOCK "/lock"
+#define BACKUP_BLOCK_STORE_LOCK_EXT(expire)                         ((expire) ? ".expire" : ".backup")
+#define BACKUP_BLOCK_STORE_LOCK_KEY_EXEC_ID                         "execId"
+#define BACKUP_BLOCK_STORE_LOCK_KEY_HOST                            "host"
+
+/***********************************************************************************************************************************
+Cache of blocks in the block store, one list per block store path. The cache belongs to a storage object and is freed with it.
+***********************************************************************************************************************************/
+typedef struct BackupBlockStoreItem
+{
+    unsigned char checksum[XX_HASH_SIZE_MAX];                       // Block checksum
+    CompressType compressType;                                      // Block compress type
+    uint64_t size;                                                  // Block size in the block store
+} BackupBlockStoreItem;
+
+static struct BackupBlockStoreLocal
+{
+    MemContext *memContext;                                         // Mem context for the cache
+    const Storage *storage;                                         // Storage that the cache belongs to
+    List *pathList[UCHAR_MAX + 1];                                  // Blocks in each path (NULL until the path has been listed)
+} backupBlockStoreLocal;
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 backupFileRepoPath(const String *const backupLabel, const BackupFileRepoPathParam param)
@@ -25,12 +54,16 @@ backupFileRepoPath(const String *const backupLabel, const BackupFileRepoPathPara
         FUNCTION_TEST_PARAM(UINT64, param.bundleId);
         FUNCTION_TEST_PARAM(ENUM, param.compressType);
         FUNCTION_TEST_PARAM(BOOL, param.blockIncr);
+        FUNCTION_TEST_PARAM(STRING, param.stanza);
     FUNCTION_TEST_END();
 
     ASSERT(backupLabel != NULL);
     ASSERT(param.bundleId != 0 || param.manifestName != NULL);
 
-    String *const result = strCatFmt(strNew(), STORAGE_REPO_BACKUP "/%s/", strZ(backupLabel));
+    String *const result =
+        param.stanza != NULL ?
+            strCatFmt(strNew(), STORAGE_PATH_BACKUP "/%s/%s/", strZ(param.stanza), strZ(backupLabel)) :
+            strCatFmt(strNew(), STORAGE_REPO_BACKUP "/%s/", strZ(backupLabel));
 
     if (param.bundleId != 0)
         strCatFmt(result, MANIFEST_PATH_BUNDLE "/%" PRIu64, param.bundleId);
@@ -44,6 +77,450 @@ backupFileRepoPath(const String *const backupLabel, const BackupFileRepoPathPara
     FUNCTION_TEST_RETURN(STRING, result);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+backupBlockStorePath(const unsigned char *const checksum, const CompressType compressType)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, checksum);
+        FUNCTION_TEST_PARAM(ENUM, compressType);
+    FUNCTION_TEST_END();
+
+    ASSERT(checksum != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const checksumHex = strNewEncode(encodingHex, BUF(checksum, XX_HASH_SIZE_MAX));
+
+        // Spread the blocks over subpaths using the first byte of the checksum to keep path listings a manageable size
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = strCatFmt(strNew(), STORAGE_PATH_BLOCK "/%.2s/%s", strZ(checksumHex), strZ(checksumHex));
+            compressExtCat(result, compressType);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STRING, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+backupBlockStoreName(const String *const name, unsigned char *const checksum, CompressType *const compressType)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, checksum);
+        FUNCTION_TEST_PARAM_P(VOID, compressType);
+    FUNCTION_TEST_END();
+
+    ASSERT(name != NULL);
+    ASSERT(checksum != NULL);
+    ASSERT(compressType != NULL);
+
+    // The name must be the hex checksum followed by the compression extension (if any)
+    const char *const nameZ = strBaseZ(name);
+    char checksumHex[XX_HASH_SIZE_MAX * 2 + 1];
+
+    *compressType = compressTypeFromName(name);
+    bool result = strlen(nameZ) == sizeof(checksumHex) - 1 + strSize(compressExtStr(*compressType));
+
+    for (unsigned int charIdx = 0; result && charIdx < sizeof(checksumHex) - 1; charIdx++)
+        result = (nameZ[charIdx] >= '0' && nameZ[charIdx] <= '9') || (nameZ[charIdx] >= 'a' && nameZ[charIdx] <= 'f');
+
+    if (result)
+    {
+        memcpy(checksumHex, nameZ, sizeof(checksumHex) - 1);
+        checksumHex[sizeof(checksumHex) - 1] = '\0';
+
+        decodeToBin(encodingHex, checksumHex, checksum);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Compare block store items by checksum and then compress type
+***********************************************************************************************************************************/
+static int
+backupBlockStoreItemComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const BackupBlockStoreItem *const blockStoreItem1 = item1;
+    const BackupBlockStoreItem *const blockStoreItem2 = item2;
+    const int result = memcmp(blockStoreItem1->checksum, blockStoreItem2->checksum, XX_HASH_SIZE_MAX);
+
+    FUNCTION_TEST_RETURN(
+        INT, result != 0 ? result : LST_COMPARATOR_CMP(blockStoreItem1->compressType, blockStoreItem2->compressType));
+}
+
+/***********************************************************************************************************************************
+Clear the cache when the storage it belongs to is freed
+***********************************************************************************************************************************/
+static void
+backupBlockStoreFreeResource(void *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    (void)data;
+
+    backupBlockStoreLocal = (struct BackupBlockStoreLocal){0};
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the list of blocks in the block store path where the block is stored. The path is listed the first time it is needed.
+***********************************************************************************************************************************/
+static List *
+backupBlockStorePathList(const Storage *const storage, const unsigned char *const checksum)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, checksum);
+    FUNCTION_TEST_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(checksum != NULL);
+
+    // Create the cache for the storage, freeing the cache for any other storage
+    if (backupBlockStoreLocal.storage != storage)
+    {
+        if (backupBlockStoreLocal.memContext != NULL)
+            memContextFree(backupBlockStoreLocal.memContext);
+
+        MEM_CONTEXT_OBJ_BEGIN((Storage *)storage)
+        {
+            MEM_CONTEXT_NEW_BEGIN(BackupBlockStore, .childQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
+            {
+                backupBlockStoreLocal.memContext = MEM_CONTEXT_NEW();
+                backupBlockStoreLocal.storage = storage;
+
+                memContextCallbackSet(backupBlockStoreLocal.memContext, backupBlockStoreFreeResource, NULL);
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_OBJ_END();
+    }
+
+    // List the path when it is not in the cache
+    List *result = backupBlockStoreLocal.pathList[checksum[0]];
+
+    if (result == NULL)
+    {
+        MEM_CONTEXT_BEGIN(backupBlockStoreLocal.memContext)
+        {
+            result = lstNewP(sizeof(BackupBlockStoreItem), .comparator = backupBlockStoreItemComparator);
+        }
+        MEM_CONTEXT_END();
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            StorageIterator *const storageItr = storageNewItrP(
+                storage, strNewFmt(STORAGE_PATH_BLOCK "/%02x", checksum[0]), .level = storageInfoLevelBasic);
+
+            while (storageItrMore(storageItr))
+            {
+                const StorageInfo info = storageItrNext(storageItr);
+                BackupBlockStoreItem blockStoreItem = {.size = info.size};
+
+                if (info.type == storageTypeFile &&
+                    backupBlockStoreName(info.name, blockStoreItem.checksum, &blockStoreItem.compressType))
+                {
+                    lstAdd(result, &blockStoreItem);
+                }
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        lstSort(result, sortOrderAsc);
+        backupBlockStoreLocal.pathList[checksum[0]] = result;
+    }
+
+    FUNCTION_TEST_RETURN(LIST, result);
+}
+
+/***********************************************************************************************************************************
+Get the index of a block in a block store path list, or the index where the block should be inserted if it is not in the list. A
+binary search is done directly since the list does not stay marked as sorted when blocks are inserted.
+***********************************************************************************************************************************/
+static unsigned int
+backupBlockStoreIdx(const List *const list, const BackupBlockStoreItem *const blockStoreItem)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, list);
+        FUNCTION_TEST_PARAM_P(VOID, blockStoreItem);
+    FUNCTION_TEST_END();
+
+    ASSERT(list != NULL);
+    ASSERT(blockStoreItem != NULL);
+
+    unsigned int idxBegin = 0;
+    unsigned int idxEnd = lstSize(list);
+
+    while (idxBegin < idxEnd)
+    {
+        const unsigned int idxMid = idxBegin + (idxEnd - idxBegin) / 2;
+
+        if (backupBlockStoreItemComparator(lstGet(list, idxMid), blockStoreItem) < 0)
+            idxBegin = idxMid + 1;
+        else
+            idxEnd = idxMid;
+    }
+
+    FUNCTION_TEST_RETURN(UINT, idxBegin);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint64_t
+backupBlockStoreFind(const Storage *const storage, const unsigned char *const checksum, const CompressType compressType)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, checksum);
+        FUNCTION_TEST_PARAM(ENUM, compressType);
+    FUNCTION_TEST_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(checksum != NULL);
+
+    const List *const list = backupBlockStorePathList(storage, checksum);
+    BackupBlockStoreItem blockStoreItem = {.compressType = compressType};
+    memcpy(blockStoreItem.checksum, checksum, XX_HASH_SIZE_MAX);
+
+    const unsigned int listIdx = backupBlockStoreIdx(list, &blockStoreItem);
+    uint64_t result = 0;
+
+    if (listIdx < lstSize(list) && backupBlockStoreItemComparator(lstGet(list, listIdx), &blockStoreItem) == 0)
+        result = ((const BackupBlockStoreItem *)lstGet(list, listIdx))->size;
+
+    FUNCTION_TEST_RETURN(UINT64, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+backupBlockStoreAdd(
+    const Storage *const storage, const unsigned char *const checksum, const CompressType compressType, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, checksum);
+        FUNCTION_TEST_PARAM(ENUM, compressType);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(checksum != NULL);
+    ASSERT(size != 0);
+
+    List *const list = backupBlockStorePathList(storage, checksum);
+    BackupBlockStoreItem blockStoreItem = {.compressType = compressType, .size = size};
+    memcpy(blockStoreItem.checksum, checksum, XX_HASH_SIZE_MAX);
+
+    const unsigned int listIdx = backupBlockStoreIdx(list, &blockStoreItem);
+
+    if (listIdx == lstSize(list) || backupBlockStoreItemComparator(lstGet(list, listIdx), &blockStoreItem) != 0)
+        lstInsert(list, listIdx, &blockStoreItem);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the name of this host to identify the owner of a block store lock
+***********************************************************************************************************************************/
+static String *
+backupBlockStoreLockHost(void)
+{
+    FUNCTION_TEST_VOID();
+
+    char hostName[256];
+    THROW_ON_SYS_ERROR(gethostname(hostName, sizeof(hostName)) == -1, AssertError, "unable to get host name");
+    hostName[sizeof(hostName) - 1] = '\0';
+
+    FUNCTION_TEST_RETURN(STRING, strNewZ(hostName));
+}
+
+/***********************************************************************************************************************************
+Is a block store lock stale? Only locks written on this host can be checked. The lock is stale when the command lock for the stanza
+(expire holds the backup lock along with the archive lock) is not held by the process that wrote the block store lock. Locks that
+cannot be read are considered to be held since they may have been written by an older version, may still be in progress, or may
+have been removed after the lock path was listed.
+***********************************************************************************************************************************/
+static bool
+backupBlockStoreLockStale(const Storage *const storage, const String *const lockFile, const String *const stanza)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, lockFile);
+        FUNCTION_TEST_PARAM(STRING, stanza);
+    FUNCTION_TEST_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(lockFile != NULL);
+    ASSERT(stanza != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *execId = NULL;
+        const String *host = NULL;
+
+        TRY_BEGIN()
+        {
+            JsonRead *const json = jsonReadNew(strNewBuf(storageGetP(storageNewReadP(storage, lockFile))));
+            jsonReadObjectBegin(json);
+
+            execId = jsonReadStr(jsonReadKeyRequireZ(json, BACKUP_BLOCK_STORE_LOCK_KEY_EXEC_ID));
+            host = jsonReadStr(jsonReadKeyRequireZ(json, BACKUP_BLOCK_STORE_LOCK_KEY_HOST));
+        }
+        CATCH_ANY()
+        {
+        }
+        TRY_END();
+
+        if (host != NULL && strEq(host, backupBlockStoreLockHost()))
+        {
+            const LockReadResult lockResult = cmdLockRead(lockTypeBackup, stanza);
+
+            result =
+                lockResult.status == lockReadStatusMissing || lockResult.status == lockReadStatusUnlocked ||
+                (lockResult.status == lockReadStatusValid && !strEq(lockResult.data.execId, execId));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+backupBlockStoreLockWrite(const Storage *const storage, const String *const stanza, const bool expire)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, stanza);
+        FUNCTION_LOG_PARAM(BOOL, expire);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(stanza != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        JsonWrite *const json = jsonWriteNewP();
+        jsonWriteObjectBegin(json);
+        jsonWriteStr(jsonWriteKeyZ(json, BACKUP_BLOCK_STORE_LOCK_KEY_EXEC_ID), cfgOptionStr(cfgOptExecId));
+        jsonWriteStr(jsonWriteKeyZ(json, BACKUP_BLOCK_STORE_LOCK_KEY_HOST), backupBlockStoreLockHost());
+        jsonWriteObjectEnd(json);
+
+        storagePutP(
+            storageNewWriteP(
+                storage, strNewFmt(BACKUP_BLOCK_STORE_LOCK_PATH "/%s%s", strZ(stanza), BACKUP_BLOCK_STORE_LOCK_EXT(expire))),
+            BUFSTR(jsonWriteResult(json)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+backupBlockStoreLockRemove(const Storage *const storage, const String *const stanza, const bool expire)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, stanza);
+        FUNCTION_LOG_PARAM(BOOL, expire);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(stanza != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        storageRemoveP(
+            storage, strNewFmt(BACKUP_BLOCK_STORE_LOCK_PATH "/%s%s", strZ(stanza), BACKUP_BLOCK_STORE_LOCK_EXT(expire)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+backupBlockStoreLockFind(const Storage *const storage, const String *const stanza, const bool expire, const bool removeStale)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, stanza);
+        FUNCTION_LOG_PARAM(BOOL, expire);
+        FUNCTION_LOG_PARAM(BOOL, removeStale);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(stanza != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const char *const lockExt = BACKUP_BLOCK_STORE_LOCK_EXT(expire);
+        const StringList *const lockList = strLstSort(
+            storageListP(storage, STRDEF(BACKUP_BLOCK_STORE_LOCK_PATH), .expression = strNewFmt("\\%s$", lockExt)),
+            sortOrderAsc);
+
+        for (unsigned int lockIdx = 0; lockIdx < strLstSize(lockList); lockIdx++)
+        {
+            const String *const lock = strLstGet(lockList, lockIdx);
+            const String *const lockStanza = strSubN(lock, 0, strSize(lock) - strlen(lockExt));
+
+            // The lock for the current stanza is ignored since the stanza lock is held, so a lock left by an error is stale
+            if (strEq(lockStanza, stanza))
+                continue;
+
+            // Skip the lock if it is stale
+            const String *const lockFile = strNewFmt(BACKUP_BLOCK_STORE_LOCK_PATH "/%s", strZ(lock));
+
+            if (backupBlockStoreLockStale(storage, lockFile, lockStanza))
+            {
+                if (removeStale)
+                {
+                    LOG_WARN_FMT(
+                        "remove stale block store %s lock for stanza %s", expire ? "expire" : "backup", strZ(lockStanza));
+                    storageRemoveP(storage, lockFile);
+                }
+
+                continue;
+            }
+
+            // Return the stanza holding the lock
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = strDup(lockStanza);
+            }
+            MEM_CONTEXT_PRIOR_END();
+
+            break;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 backupLabelFormat(const BackupType type, const String *const backupLabelPrior, const time_t timestamp)
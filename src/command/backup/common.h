@@ -10,6 +10,7 @@ Common Functions and Definitions for Backup and Expire Commands
 #include "common/compress/helper.h"
 #include "common/type/string.h"
 #include "info/infoBackup.h"
+#include "storage/storage.h"
 
 /***********************************************************************************************************************************
 Backup constants
@@ -31,6 +32,7 @@ typedef struct BackupFileRepoPathParam
     uint64_t bundleId;                                              // Is the file bundled?
     CompressType compressType;                                      // Is the file compressed?
     bool blockIncr;                                                 // Is the file a block incremental?
+    const String *stanza;                                           // Stanza when not the current stanza
 } BackupFileRepoPathParam;
 
 #define backupFileRepoPathP(backupLabel, ...)                                                                                          \
@@ -38,6 +40,36 @@ typedef struct BackupFileRepoPathParam
 
 FN_EXTERN String *backupFileRepoPath(const String *backupLabel, BackupFileRepoPathParam param);
 
+// Determine the path where a block is stored in the repository-wide block store. Blocks are named for their checksum so identical
+// blocks from any file, backup, or stanza are stored only once.
+FN_EXTERN String *backupBlockStorePath(const unsigned char *checksum, CompressType compressType);
+
+// Get the checksum and compress type of a block from its file name in the block store. Returns false if the file is not a block,
+// e.g. a temp file.
+FN_EXTERN bool backupBlockStoreName(const String *name, unsigned char *checksum, CompressType *compressType);
+
+// Find a block in the block store and return the size of the block or 0 if it is missing. The block store path that contains the
+// block is listed once and cached for as long as the storage exists, so blocks can be found without a request for each block.
+FN_EXTERN uint64_t backupBlockStoreFind(const Storage *storage, const unsigned char *checksum, CompressType compressType);
+
+// Add a block that was written to the block store to the cache
+FN_EXTERN void backupBlockStoreAdd(
+    const Storage *storage, const unsigned char *checksum, CompressType compressType, uint64_t size);
+
+// Backups and expire in different stanzas cannot use the block store at the same time since expire could remove a block that a
+// backup found in the block store before the backup is able to record the reference in its manifest. Each writes a lock before
+// checking for the locks of the other, so at least one of them will see the other and back off. Backups do not use the block store
+// when an expire lock is found and expire does not remove blocks when a backup lock is found. The lock records the host and exec-id
+// of the process that wrote it so a lock left behind by a process that is no longer running can be detected.
+FN_EXTERN void backupBlockStoreLockWrite(const Storage *storage, const String *stanza, bool expire);
+FN_EXTERN void backupBlockStoreLockRemove(const Storage *storage, const String *stanza, bool expire);
+
+// Find a lock held by a stanza other than the specified stanza and return the stanza holding it, or NULL if there is none. A lock
+// written on this host is stale when the command lock for its stanza is not held by the process that wrote it. Stale locks are
+// ignored and removed when removeStale is true, in which case the storage must be writable. Locks written on other hosts cannot be
+// checked and are always considered to be held.
+FN_EXTERN String *backupBlockStoreLockFind(const Storage *storage, const String *stanza, bool expire, bool removeStale);
+
 // Format a backup label from a type and timestamp with an optional prior label
 FN_EXTERN String *backupLabelFormat(BackupType type, const String *backupLabelPrior, time_t timestamp);
 
@@ -6,13 +6,17 @@ Backup File
 #include <string.h>
 
 #include "command/backup/blockIncr.h"
+#include "command/backup/common.h"
 #include "command/backup/file.h"
 #include "command/backup/pageChecksum.h"
+#include "command/restore/blockDelta.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
 #include "common/io/filter/group.h"
+#include "common/io/filter/sink.h"
 #include "common/io/filter/size.h"
 #include "common/io/io.h"
 #include "common/log.h"
@@ -40,16 +44,19 @@ segmentNumber(const String *const pgFile)
 FN_EXTERN List *
 backupFile(
     const String *const repoFile, const uint64_t bundleId, const bool bundleRaw, const unsigned int blockIncrReference,
-    const CompressType repoFileCompressType, const int repoFileCompressLevel, const CipherType cipherType,
-    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize, const List *const fileList)
+    const bool blockIncrStore, const CompressType repoFileCompressType, const int repoFileCompressLevel,
+    const unsigned int repoFileCompressThread, const CipherType cipherType, const String *const cipherPass,
+    const String *const pgVersionForce, const PgPageSize pageSize, const List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);                       // Repo file
         FUNCTION_LOG_PARAM(UINT64, bundleId);                       // Bundle id (0 if none)
         FUNCTION_LOG_PARAM(BOOL, bundleRaw);                        // Raw compress/encrypt format in bundles?
         FUNCTION_LOG_PARAM(UINT, blockIncrReference);               // Block incremental reference to use in map
+        FUNCTION_LOG_PARAM(BOOL, blockIncrStore);                   // Store block incremental blocks in the block store?
         FUNCTION_LOG_PARAM(ENUM, repoFileCompressType);             // Compress type for repo file
         FUNCTION_LOG_PARAM(INT, repoFileCompressLevel);             // Compression level for repo file
+        FUNCTION_LOG_PARAM(UINT, repoFileCompressThread);           // Compression worker threads for repo file
         FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Encryption type
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
         FUNCTION_LOG_PARAM(ENUM, pageSize);                         // Page size
@@ -59,6 +66,7 @@ backupFile(
 
     ASSERT(repoFile != NULL);
     ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
+    ASSERT(!blockIncrStore || cipherType == cipherTypeNone);
     ASSERT(fileList != NULL && !lstEmpty(fileList));
     ASSERT(pgPageSizeValid(pageSize));
 
@@ -77,6 +85,10 @@ backupFile(
                 ASSERT(file->pgFile != NULL);
                 ASSERT(file->manifestFile != NULL);
                 ASSERT((!file->pgFileDelta && !file->manifestFileResume) || file->pgFileChecksum != NULL);
+                ASSERT(
+                    (file->pgFileOffset == 0 && file->pgFileRangeSize == 0) ||
+                    (file->blockIncrSize != 0 && !file->pgFileDelta && !file->manifestFileResume &&
+                     !file->manifestFileHasReference));
 
                 BackupFileResult *const fileResult = lstAdd(
                     result, &(BackupFileResult){.manifestFile = file->manifestFile, .backupCopyResult = backupCopyResultCopy});
@@ -194,6 +206,16 @@ backupFile(
 
                 if (fileResult->backupCopyResult == backupCopyResultCopy)
                 {
+                    // Is a range of the file being copied?
+                    const bool range = file->pgFileOffset != 0 || file->pgFileRangeSize != 0;
+
+                    // When blocks are written to the block store the block incremental filter must run locally since the repository
+                    // may not be available where the pg file is read. The filter output (only the map) is written to a buffer and
+                    // then copied to the repo file. The pg file is still compressed in transit when the pg host is remote.
+                    const bool store = blockIncrStore && file->blockIncrSize != 0;
+                    Buffer *const storeBuffer = store ? bufNew(0) : NULL;
+                    IoWrite *const storeWrite = store ? ioBufferWriteNew(storeBuffer) : NULL;
+
                     // Setup pg file for read. Only read as many bytes as passed in pgFileSize. If the file is growing it does no
                     // good to copy data past the end of the size recorded in the manifest since those blocks will need to be
                     // replayed from WAL during recovery. pg_control requires special handling since it needs to be retried on crc
@@ -205,30 +227,43 @@ backupFile(
                         readIo = ioBufferReadNew(pgControlBufferFromFile(storagePg(), pgVersionForce));
                     else
                     {
+                        // When copying a range of the file only read the range. The last range reads the remainder of the file.
                         readIo = storageReadIo(
                             storageNewReadP(
-                                storagePg(), file->pgFile, .ignoreMissing = file->pgFileIgnoreMissing, .compressible = compressible,
-                                .limit = file->pgFileCopyExactSize ? VARUINT64(file->pgFileSizeOriginal) : NULL));
+                                storagePg(), file->pgFile, .ignoreMissing = file->pgFileIgnoreMissing,
+                                .compressible = compressible || store, .offset = file->pgFileOffset,
+                                .limit = file->pgFileRangeSize != 0 ?
+                                    VARUINT64(file->pgFileRangeSize) :
+                                    (file->pgFileCopyExactSize ? VARUINT64(file->pgFileSizeOriginal - file->pgFileOffset) : NULL)));
                     }
 
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
 
-                    // Add page checksum filter
+                    // Filters that calculate the repo checksum/size are added after the filters above on the pg read, unless the
+                    // block store is used
+                    IoFilterGroup *const repoFilterGroup = store ? ioWriteFilterGroup(storeWrite) : ioReadFilterGroup(readIo);
+                    const unsigned int repoFilterIdx = store ? 0 : 1;
+
+                    // Add page checksum filter. When copying a range the pages are numbered from the beginning of the range.
                     if (file->pgFileChecksumPage)
                     {
+                        ASSERT(file->pgFileOffset % pageSize == 0);
+
                         ioFilterGroupAdd(
                             ioReadFilterGroup(readIo),
                             pageChecksumNew(
-                                segmentNumber(file->pgFile), PG_SEGMENT_SIZE_DEFAULT / pageSize, pageSize,
-                                file->pgFilePageHeaderCheck, storagePathP(storagePg(), file->pgFile)));
+                                segmentNumber(file->pgFile), PG_SEGMENT_SIZE_DEFAULT / pageSize,
+                                (unsigned int)(file->pgFileOffset / pageSize), pageSize, file->pgFilePageHeaderCheck,
+                                storagePathP(storagePg(), file->pgFile)));
                     }
 
                     // Compress filter
                     IoFilter *const compress =
                         repoFileCompressType != compressTypeNone ?
                             compressFilterP(
-                                repoFileCompressType, repoFileCompressLevel, .raw = bundleRaw || file->blockIncrSize != 0) :
+                                repoFileCompressType, repoFileCompressLevel, .raw = bundleRaw || file->blockIncrSize != 0,
+                                .thread = repoFileCompressThread) :
                             NULL;
 
                     // Encrypt filter
@@ -261,12 +296,17 @@ backupFile(
                             blockMap = storageGetP(blockMapRead);
                         }
 
-                        // Add block incremental filter
+                        // Add block incremental filter. A range begins on a super block boundary so the first block number of the
+                        // range is used to compare blocks to the prior map.
+                        ASSERT(file->pgFileOffset % file->blockIncrSize == 0);
+
                         ioFilterGroupAdd(
-                            ioReadFilterGroup(readIo),
-                            blockIncrNew(
+                            repoFilterGroup,
+                            blockIncrNewP(
                                 file->blockIncrSuperSize, file->blockIncrSize, file->blockIncrChecksumSize, blockIncrReference,
-                                bundleId, bundleOffset, blockMap, compress, encrypt));
+                                bundleId, bundleOffset, blockMap, compress, encrypt, .store = store,
+                                .compressType = repoFileCompressType, .range = range,
+                                .blockNo = (unsigned int)(file->pgFileOffset / file->blockIncrSize)));
 
                         repoChecksum = true;
                     }
@@ -290,10 +330,10 @@ backupFile(
 
                     // Capture checksum of file stored in the repo if filters that modify the output have been applied
                     if (repoChecksum)
-                        ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
+                        ioFilterGroupAdd(repoFilterGroup, cryptoHashNew(hashTypeSha1));
 
                     // Add size filter last to calculate repo size
-                    ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
+                    ioFilterGroupAdd(repoFilterGroup, ioSizeNew());
 
                     // Open the source
                     if (ioReadOpen(readIo))
@@ -316,8 +356,9 @@ backupFile(
                                 ioFilterGroupResultP(ioReadFilterGroup(readIo), SIZE_FILTER_TYPE, .idx = 0));
 
                             // If file is zero-length then it was truncated during the backup. When bundling we can simply mark it
-                            // as truncated since no file needs to be stored.
-                            if (bundleId != 0 && fileResult->copySize == 0)
+                            // as truncated since no file needs to be stored. The same is true for an empty range since the ranges
+                            // will be merged later.
+                            if ((bundleId != 0 || range) && fileResult->copySize == 0)
                             {
                                 fileResult->backupCopyResult = backupCopyResultTruncate;
                                 fileResult->copyChecksum = HASH_TYPE_SHA1_ZERO_BUF;
@@ -337,9 +378,10 @@ backupFile(
                                 // If checksum is also equal then no need to copy the file
                                 if (bufEq(file->pgFileChecksum, copyChecksum))
                                 {
-                                    // If block incremental make sure no map was returned but a prior map was provided
+                                    // If block incremental make sure no map was returned but a prior map was provided. The block
+                                    // store filter has not processed any data yet so it cannot be checked.
                                     ASSERT(
-                                        file->blockIncrSize == 0 ||
+                                        file->blockIncrSize == 0 || store ||
                                         (pckReadU64P(
                                              ioFilterGroupResultP(ioReadFilterGroup(readIo), BLOCK_INCR_FILTER_TYPE)) == 0 &&
                                          file->blockIncrMapPriorFile != NULL));
@@ -371,18 +413,30 @@ backupFile(
                             }
 
                             // Write the first buffer
-                            ioWrite(storageWriteIo(write), buffer);
+                            IoWrite *const copyWrite = store ? storeWrite : storageWriteIo(write);
+
+                            if (store)
+                                ioWriteOpen(storeWrite);
+
+                            ioWrite(copyWrite, buffer);
                             bufFree(buffer);
 
                             // Copy remainder of the file if not eof
                             if (!readEof)
                             {
-                                ioCopyP(readIo, storageWriteIo(write));
+                                ioCopyP(readIo, copyWrite);
 
                                 // Close the source
                                 ioReadClose(readIo);
                             }
 
+                            // Write the map generated by the block store to the repo file
+                            if (store)
+                            {
+                                ioWriteClose(storeWrite);
+                                ioWrite(storageWriteIo(write), storeBuffer);
+                            }
+
                             // Get copy results
                             MEM_CONTEXT_BEGIN(lstMemContext(result))
                             {
@@ -397,7 +451,7 @@ backupFile(
 
                                 // Get repo size
                                 fileResult->repoSize = pckReadU64P(
-                                    ioFilterGroupResultP(ioReadFilterGroup(readIo), SIZE_FILTER_TYPE, .idx = 1));
+                                    ioFilterGroupResultP(repoFilterGroup, SIZE_FILTER_TYPE, .idx = repoFilterIdx));
 
                                 // Get results of page checksum validation
                                 if (file->pgFileChecksumPage)
@@ -410,7 +464,7 @@ backupFile(
                                 if (file->blockIncrSize != 0)
                                 {
                                     fileResult->blockIncrMapSize = pckReadU64P(
-                                        ioFilterGroupResultP(ioReadFilterGroup(readIo), BLOCK_INCR_FILTER_TYPE));
+                                        ioFilterGroupResultP(repoFilterGroup, BLOCK_INCR_FILTER_TYPE));
 
                                     // There must be a map because the file should have changed or shrunk
                                     ASSERT(fileResult->blockIncrMapSize > 0);
@@ -420,7 +474,7 @@ backupFile(
                                 if (repoChecksum)
                                 {
                                     fileResult->repoChecksum = pckReadBinP(
-                                        ioFilterGroupResultP(ioReadFilterGroup(readIo), CRYPTO_HASH_FILTER_TYPE, .idx = 1));
+                                        ioFilterGroupResultP(repoFilterGroup, CRYPTO_HASH_FILTER_TYPE, .idx = repoFilterIdx));
                                 }
                             }
                             MEM_CONTEXT_END();
@@ -445,3 +499,297 @@ backupFile(
 
     FUNCTION_LOG_RETURN(LIST, result);
 }
+
+/**********************************************************************************************************************************/
+// Add the page checksum result of a range to the merged result
+static void
+backupFileMergePageChecksum(PackWrite **const pageChecksumWrite, bool *const valid, bool *const align, const Pack *const pageResult)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pageChecksumWrite);
+        FUNCTION_TEST_PARAM_P(BOOL, valid);
+        FUNCTION_TEST_PARAM_P(BOOL, align);
+        FUNCTION_TEST_PARAM(PACK, pageResult);
+    FUNCTION_TEST_END();
+
+    ASSERT(pageChecksumWrite != NULL);
+    ASSERT(valid != NULL);
+    ASSERT(align != NULL);
+    ASSERT(pageResult != NULL);
+
+    PackRead *const pageRead = pckReadNew(pageResult);
+
+    // Copy page errors. Pages are numbered from the beginning of the segment so errors from each range can be combined in order.
+    if (!pckReadNullP(pageRead))
+    {
+        if (*pageChecksumWrite == NULL)
+        {
+            *pageChecksumWrite = pckWriteNewP();
+            pckWriteArrayBeginP(*pageChecksumWrite);
+        }
+
+        pckReadArrayBeginP(pageRead);
+
+        while (pckReadNext(pageRead))
+        {
+            const unsigned int pageId = pckReadId(pageRead);
+
+            pckReadObjBeginP(pageRead, .id = pageId);
+            pckReadObjEndP(pageRead);
+
+            pckWriteObjBeginP(*pageChecksumWrite, .id = pageId);
+            pckWriteObjEndP(*pageChecksumWrite);
+        }
+
+        pckReadArrayEndP(pageRead);
+    }
+
+    // The file is valid/aligned only when all ranges are valid/aligned
+    *valid = pckReadBoolP(pageRead) && *valid;
+    *align = pckReadBoolP(pageRead) && *align;
+
+    pckReadFree(pageRead);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN BackupFileResult
+backupFileMerge(
+    const String *const repoFile, const CompressType repoFileCompressType, const CipherType cipherType,
+    const String *const cipherPass, const StringList *const referenceList, const uint64_t rangeSize, const BackupFile *const file,
+    const List *const rangeList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, repoFile);                       // Repo file
+        FUNCTION_LOG_PARAM(ENUM, repoFileCompressType);             // Compress type for repo file
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Encryption type
+        FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
+        FUNCTION_LOG_PARAM(STRING_LIST, referenceList);             // Backup references used in block maps
+        FUNCTION_LOG_PARAM(UINT64, rangeSize);                      // Size of each range (except the last)
+        FUNCTION_LOG_PARAM_P(VOID, file);                           // File to merge
+        FUNCTION_LOG_PARAM(LIST, rangeList);                        // List of ranges to merge
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_STRUCT();
+
+    ASSERT(repoFile != NULL);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
+    ASSERT(referenceList != NULL && !strLstEmpty(referenceList));
+    ASSERT(rangeSize > 0);
+    ASSERT(file != NULL && file->blockIncrSize != 0);
+    ASSERT(rangeList != NULL && !lstEmpty(rangeList));
+
+    BackupFileResult result = {.manifestFile = file->manifestFile, .backupCopyResult = backupCopyResultCopy};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Number of ranges referenced by the merged map
+        unsigned int rangeMergeTotal = 0;
+
+        // If the first range is missing then the file was removed during the backup
+        if (((const BackupFileRange *)lstGet(rangeList, 0))->backupCopyResult == backupCopyResultSkip)
+        {
+            result.backupCopyResult = backupCopyResultSkip;
+        }
+        else
+        {
+            // Build a single map from the range maps. The super blocks stay in the range bundles so the map items are not modified.
+            // A short range means the file was truncated during the backup so no further ranges are merged.
+            BlockMap *const blockMap = blockMapNew();
+            PackWrite *pageChecksumWrite = NULL;
+            bool pageChecksumValid = true;
+            bool pageChecksumAlign = true;
+
+            for (unsigned int rangeIdx = 0; rangeIdx < lstSize(rangeList); rangeIdx++)
+            {
+                const BackupFileRange *const range = lstGet(rangeList, rangeIdx);
+
+                if (range->copySize == 0)
+                    break;
+
+                ASSERT(range->backupCopyResult == backupCopyResultCopy);
+                ASSERT(range->blockIncrMapSize > 0 && range->blockIncrMapSize <= range->repoSize);
+
+                // Read the range map. The range is the only file in the bundle so the map is at the end of the range.
+                StorageRead *const blockMapRead = storageNewReadP(
+                    storageRepo(), range->repoFile, .offset = range->repoSize - range->blockIncrMapSize,
+                    .limit = VARUINT64(range->blockIncrMapSize));
+
+                if (cipherType != cipherTypeNone)
+                {
+                    ioFilterGroupAdd(
+                        ioReadFilterGroup(storageReadIo(blockMapRead)),
+                        cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = true));
+                }
+
+                const BlockMap *const blockMapRange = blockMapNewRead(
+                    ioBufferReadNewOpen(storageGetP(blockMapRead)), file->blockIncrSize, file->blockIncrChecksumSize);
+
+                for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMapRange); blockMapIdx++)
+                    blockMapAdd(blockMap, blockMapGet(blockMapRange, blockMapIdx));
+
+                // Combine page checksum results
+                if (file->pgFileChecksumPage)
+                {
+                    backupFileMergePageChecksum(
+                        &pageChecksumWrite, &pageChecksumValid, &pageChecksumAlign, range->pageChecksumResult);
+                }
+
+                result.copySize += range->copySize;
+                rangeMergeTotal++;
+
+                if (range->copySize < rangeSize)
+                    break;
+            }
+
+            // If nothing was copied then the file was truncated during the backup
+            if (rangeMergeTotal == 0)
+            {
+                result.backupCopyResult = backupCopyResultTruncate;
+                result.copyChecksum = HASH_TYPE_SHA1_ZERO_BUF;
+            }
+            else
+            {
+                // Write the map
+                Buffer *const blockMapBuffer = bufNew(0);
+                IoWrite *const blockMapIo = ioBufferWriteNew(blockMapBuffer);
+
+                if (cipherType != cipherTypeNone)
+                {
+                    ioFilterGroupAdd(
+                        ioWriteFilterGroup(blockMapIo),
+                        cipherBlockNewP(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), .raw = true));
+                }
+
+                ioWriteOpen(blockMapIo);
+                blockMapWrite(blockMap, blockMapIo, file->blockIncrSize, file->blockIncrChecksumSize);
+                ioWriteClose(blockMapIo);
+
+                StorageWrite *const write = storageNewWriteP(storageRepoWrite(), repoFile, .noAtomic = true, .noSyncPath = true);
+                ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), cryptoHashNew(hashTypeSha1));
+                ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), ioSizeNew());
+                ioWriteOpen(storageWriteIo(write));
+                ioWrite(storageWriteIo(write), blockMapBuffer);
+                ioWriteClose(storageWriteIo(write));
+
+                // Reconstruct the file from the repo to calculate the checksum. The checksum cannot be combined from the ranges
+                // since SHA-1 must see the file in order, so every block is read and decompressed/decrypted again by this process.
+                // This is much cheaper than compressing, e.g. the merge takes less than a tenth of the time needed to copy the
+                // file whole with gz level 6 (see the block incremental split benchmark in the storage performance test). Blocks
+                // are returned grouped by reference so the map is split into runs of blocks with the same reference to reconstruct
+                // the file in order.
+                IoWrite *const checkWrite = ioBufferWriteNew(bufNew(0));
+                ioFilterGroupAdd(ioWriteFilterGroup(checkWrite), cryptoHashNew(hashTypeSha1));
+                ioFilterGroupAdd(ioWriteFilterGroup(checkWrite), ioSizeNew());
+                ioFilterGroupAdd(ioWriteFilterGroup(checkWrite), ioSinkNew());
+                ioWriteOpen(checkWrite);
+
+                unsigned int blockMapIdx = 0;
+
+                while (blockMapIdx < blockMapSize(blockMap))
+                {
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        BlockMap *const blockMapRun = blockMapNew();
+                        const unsigned int reference = blockMapGet(blockMap, blockMapIdx)->reference;
+
+                        for (; blockMapIdx < blockMapSize(blockMap) && blockMapGet(blockMap, blockMapIdx)->reference == reference;
+                             blockMapIdx++)
+                        {
+                            blockMapAdd(blockMapRun, blockMapGet(blockMap, blockMapIdx));
+                        }
+
+                        BlockDelta *const blockDelta = blockDeltaNewP(
+                            blockMapRun, file->blockIncrSize, file->blockIncrChecksumSize, NULL, cipherType, cipherPass,
+                            repoFileCompressType);
+                        uint64_t blockOffset = 0;
+
+                        for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
+                        {
+                            const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
+                            StorageRead *const superBlockRead = storageNewReadP(
+                                storageRepo(),
+                                read->reference == BLOCK_MAP_REFERENCE_STORE ?
+                                    backupBlockStorePath(read->checksum, repoFileCompressType) :
+                                    backupFileRepoPathP(
+                                        strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
+                                        .bundleId = read->bundleId, .blockIncr = true),
+                                .offset = read->offset, .limit = VARUINT64(read->size));
+                            ioReadOpen(storageReadIo(superBlockRead));
+
+                            const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
+
+                            while (deltaWrite != NULL)
+                            {
+                                // Blocks for a single reference are returned in order
+                                CHECK(AssertError, deltaWrite->offset == blockOffset, "block is out of order");
+
+                                ioWrite(checkWrite, deltaWrite->block);
+                                blockOffset += bufUsed(deltaWrite->block);
+
+                                deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
+                            }
+
+                            storageReadFree(superBlockRead);
+                        }
+                    }
+                    MEM_CONTEXT_TEMP_END();
+                }
+
+                ioWriteClose(checkWrite);
+
+                // Get results
+                CHECK(
+                    FormatError,
+                    pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(checkWrite), SIZE_FILTER_TYPE)) == result.copySize,
+                    "merged file size does not match copy size");
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    IoFilterGroup *const repoFilterGroup = ioWriteFilterGroup(storageWriteIo(write));
+
+                    result.copyChecksum = pckReadBinP(
+                        ioFilterGroupResultP(ioWriteFilterGroup(checkWrite), CRYPTO_HASH_FILTER_TYPE));
+                    result.repoChecksum = pckReadBinP(ioFilterGroupResultP(repoFilterGroup, CRYPTO_HASH_FILTER_TYPE));
+                    result.repoSize = pckReadU64P(ioFilterGroupResultP(repoFilterGroup, SIZE_FILTER_TYPE));
+                    result.blockIncrMapSize = bufUsed(blockMapBuffer);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+
+            // Page checksum result in the same format as the page checksum filter
+            if (file->pgFileChecksumPage)
+            {
+                if (pageChecksumWrite != NULL)
+                {
+                    pckWriteArrayEndP(pageChecksumWrite);
+                    pageChecksumValid = false;
+                }
+                else
+                {
+                    pageChecksumWrite = pckWriteNewP();
+                    pckWriteNullP(pageChecksumWrite);
+                }
+
+                pckWriteBoolP(pageChecksumWrite, pageChecksumValid, .defaultWrite = true);
+                pckWriteBoolP(pageChecksumWrite, pageChecksumAlign, .defaultWrite = true);
+                pckWriteEndP(pageChecksumWrite);
+
+                result.pageChecksumResult = pckMove(pckWriteResult(pageChecksumWrite), memContextPrior());
+            }
+        }
+
+        // Remove ranges that are not referenced by the merged map, i.e. ranges that were not merged or where all blocks are in the
+        // block store
+        for (unsigned int rangeIdx = 0; rangeIdx < lstSize(rangeList); rangeIdx++)
+        {
+            const BackupFileRange *const range = lstGet(rangeList, rangeIdx);
+
+            if (rangeIdx >= rangeMergeTotal || range->repoSize == range->blockIncrMapSize)
+                storageRemoveP(storageRepoWrite(), range->repoFile);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_STRUCT(result);
+}
@@ -28,6 +28,8 @@ Functions
 typedef struct BackupFile
 {
     const String *pgFile;                                           // Pg file to backup
+    uint64_t pgFileOffset;                                          // Offset to begin copying a range of the pg file
+    uint64_t pgFileRangeSize;                                       // Size of the range to copy (0 for remainder of the file)
     bool pgFileDelta;                                               // Checksum pg file before copying
     bool pgFileIgnoreMissing;                                       // Ignore missing pg file
     uint64_t pgFileSize;                                            // Expected pg file size
@@ -64,8 +66,27 @@ typedef struct BackupFileResult
 } BackupFileResult;
 
 FN_EXTERN List *backupFile(
-    const String *repoFile, uint64_t bundleId, bool bundleRaw, unsigned int blockIncrReference, CompressType repoFileCompressType,
-    int repoFileCompressLevel, CipherType cipherType, const String *cipherPass, const String *pgVersionForce, PgPageSize pageSize,
-    const List *fileList);
+    const String *repoFile, uint64_t bundleId, bool bundleRaw, unsigned int blockIncrReference, bool blockIncrStore,
+    CompressType repoFileCompressType, int repoFileCompressLevel, unsigned int repoFileCompressThread, CipherType cipherType,
+    const String *cipherPass, const String *pgVersionForce, PgPageSize pageSize, const List *fileList);
+
+// Merge ranges of a file copied by backupFile() into a single block incremental repo file. Ranges are merged in order until a range
+// is found that is shorter than rangeSize, which indicates that the file was truncated during the backup. Each range is stored in a
+// bundle and the super blocks stay in the bundles, so only the combined map is written to the repo file. Ranges that are not
+// referenced by the map are removed. The file is read back from the repo to calculate the checksum, which is the serial cost of
+// splitting a file.
+typedef struct BackupFileRange
+{
+    const String *repoFile;                                         // Repo file containing the range
+    BackupCopyResult backupCopyResult;                              // Result of the range copy
+    uint64_t copySize;                                              // Size of the range copied from pg
+    uint64_t repoSize;                                              // Size of the range in the repo (including map)
+    uint64_t blockIncrMapSize;                                      // Size of the range block incremental map
+    const Pack *pageChecksumResult;                                 // Page checksum result for the range
+} BackupFileRange;
+
+FN_EXTERN BackupFileResult backupFileMerge(
+    const String *repoFile, CompressType repoFileCompressType, CipherType cipherType, const String *cipherPass,
+    const StringList *referenceList, uint64_t rangeSize, const BackupFile *file, const List *rangeList);
 
 #endif
@@ -226,12 +226,13 @@ pageChecksumResult(THIS_VOID)
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
 pageChecksumNew(
-    const unsigned int segmentNo, const unsigned int segmentPageTotal, const PgPageSize pageSize, const bool headerCheck,
-    const String *const fileName)
+    const unsigned int segmentNo, const unsigned int segmentPageTotal, const unsigned int pageBegin, const PgPageSize pageSize,
+    const bool headerCheck, const String *const fileName)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(UINT, segmentNo);
         FUNCTION_LOG_PARAM(UINT, segmentPageTotal);
+        FUNCTION_LOG_PARAM(UINT, pageBegin);
         FUNCTION_LOG_PARAM(ENUM, pageSize);
         FUNCTION_LOG_PARAM(BOOL, headerCheck);
         FUNCTION_LOG_PARAM(STRING, fileName);
@@ -246,7 +247,7 @@ pageChecksumNew(
         {
             .segmentPageTotal = segmentPageTotal,
             .pageSize = pageSize,
-            .pageNoOffset = segmentNo * segmentPageTotal,
+            .pageNoOffset = segmentNo * segmentPageTotal + pageBegin,
             .headerCheck = headerCheck,
             .fileName = strDup(fileName),
             .pageBuffer = bufPtr(bufNew(pageSize)),
@@ -265,6 +266,7 @@ pageChecksumNew(
 
         pckWriteU32P(packWrite, segmentNo);
         pckWriteU32P(packWrite, segmentPageTotal);
+        pckWriteU32P(packWrite, pageBegin);
         pckWriteU32P(packWrite, pageSize);
         pckWriteBoolP(packWrite, headerCheck);
         pckWriteStrP(packWrite, fileName);
@@ -289,11 +291,13 @@ pageChecksumNewPack(const Pack *const paramList)
         PackRead *const paramListPack = pckReadNew(paramList);
         const unsigned int segmentNo = pckReadU32P(paramListPack);
         const unsigned int segmentPageTotal = pckReadU32P(paramListPack);
+        const unsigned int pageBegin = pckReadU32P(paramListPack);
         const PgPageSize pageSize = (PgPageSize)pckReadU32P(paramListPack);
         const bool headerCheck = pckReadBoolP(paramListPack);
         const String *const fileName = pckReadStrP(paramListPack);
 
-        result = ioFilterMove(pageChecksumNew(segmentNo, segmentPageTotal, pageSize, headerCheck, fileName), memContextPrior());
+        result = ioFilterMove(
+            pageChecksumNew(segmentNo, segmentPageTotal, pageBegin, pageSize, headerCheck, fileName), memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
 
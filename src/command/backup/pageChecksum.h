@@ -17,8 +17,11 @@ Filter type constant
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+// The pageBegin parameter is the first page to check relative to the beginning of the segment, which allows a range of the segment
+// to be checked separately
 FN_EXTERN IoFilter *pageChecksumNew(
-    unsigned int segmentNo, unsigned int segmentPageTotal, PgPageSize pageSize, bool headerCheck, const String *fileName);
+    unsigned int segmentNo, unsigned int segmentPageTotal, unsigned int pageBegin, PgPageSize pageSize, bool headerCheck,
+    const String *fileName);
 FN_EXTERN IoFilter *pageChecksumNewPack(const Pack *paramList);
 
 #endif
@@ -14,6 +14,37 @@ Backup Protocol Handler
 #include "config/config.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Write file result
+***********************************************************************************************************************************/
+static void
+backupFileProtocolResult(PackWrite *const resultPack, const BackupFileResult *const fileResult)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, resultPack);
+        FUNCTION_TEST_PARAM_P(VOID, fileResult);
+    FUNCTION_TEST_END();
+
+    ASSERT(resultPack != NULL);
+    ASSERT(fileResult != NULL);
+    ASSERT(
+        fileResult->backupCopyResult == backupCopyResultSkip || fileResult->copySize != 0 ||
+        bufEq(fileResult->copyChecksum, HASH_TYPE_SHA1_ZERO_BUF));
+
+    pckWriteStrP(resultPack, fileResult->manifestFile);
+    pckWriteU32P(resultPack, fileResult->backupCopyResult);
+    pckWriteBoolP(resultPack, fileResult->repoInvalid);
+    pckWriteU64P(resultPack, fileResult->copySize);
+    pckWriteU64P(resultPack, fileResult->bundleOffset);
+    pckWriteU64P(resultPack, fileResult->blockIncrMapSize);
+    pckWriteU64P(resultPack, fileResult->repoSize);
+    pckWriteBinP(resultPack, fileResult->copyChecksum);
+    pckWriteBinP(resultPack, fileResult->repoChecksum);
+    pckWritePackP(resultPack, fileResult->pageChecksumResult);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 backupFileProtocol(PackRead *const param, ProtocolServer *const server)
@@ -33,8 +64,10 @@ backupFileProtocol(PackRead *const param, ProtocolServer *const server)
         const uint64_t bundleId = pckReadU64P(param);
         const bool bundleRaw = bundleId != 0 ? pckReadBoolP(param) : false;
         const unsigned int blockIncrReference = (unsigned int)pckReadU64P(param);
+        const bool blockIncrStore = pckReadBoolP(param);
         const CompressType repoFileCompressType = (CompressType)pckReadU32P(param);
         const int repoFileCompressLevel = pckReadI32P(param);
+        const unsigned int repoFileCompressThread = pckReadU32P(param);
         const CipherType cipherType = (CipherType)pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
         const PgPageSize pageSize = pckReadU32P(param);
@@ -46,6 +79,8 @@ backupFileProtocol(PackRead *const param, ProtocolServer *const server)
         while (!pckReadNullP(param))
         {
             BackupFile file = {.pgFile = pckReadStrP(param)};
+            file.pgFileOffset = pckReadU64P(param);
+            file.pgFileRangeSize = pckReadU64P(param);
             file.pgFileDelta = pckReadBoolP(param);
             file.pgFileIgnoreMissing = pckReadBoolP(param);
             file.pgFileSize = pckReadU64P(param);
@@ -80,32 +115,76 @@ backupFileProtocol(PackRead *const param, ProtocolServer *const server)
 
         // Backup file
         const List *const result = backupFile(
-            repoFile, bundleId, bundleRaw, blockIncrReference, repoFileCompressType, repoFileCompressLevel, cipherType, cipherPass,
-            pgVersionForce, pageSize, fileList);
+            repoFile, bundleId, bundleRaw, blockIncrReference, blockIncrStore, repoFileCompressType, repoFileCompressLevel,
+            repoFileCompressThread, cipherType, cipherPass, pgVersionForce, pageSize, fileList);
 
         // Return result
         PackWrite *const resultPack = protocolPackNew();
 
         for (unsigned int resultIdx = 0; resultIdx < lstSize(result); resultIdx++)
+            backupFileProtocolResult(resultPack, lstGet(result, resultIdx));
+
+        protocolServerDataPut(server, resultPack);
+        protocolServerDataEndPut(server);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+backupFileMergeProtocol(PackRead *const param, ProtocolServer *const server)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, server);
+    FUNCTION_LOG_END();
+
+    ASSERT(param != NULL);
+    ASSERT(server != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Merge options
+        const String *const repoFile = pckReadStrP(param);
+        const CompressType repoFileCompressType = (CompressType)pckReadU32P(param);
+        const CipherType cipherType = (CipherType)pckReadU64P(param);
+        const String *const cipherPass = pckReadStrP(param);
+        const StringList *const referenceList = pckReadStrLstP(param);
+        const uint64_t rangeSize = pckReadU64P(param);
+
+        // File to merge
+        BackupFile file = {.pgFile = pckReadStrP(param)};
+        file.pgFileChecksumPage = pckReadBoolP(param);
+        file.blockIncrSize = (size_t)pckReadU64P(param);
+        file.blockIncrChecksumSize = (size_t)pckReadU64P(param);
+        file.manifestFile = pckReadStrP(param);
+
+        // Build the range list
+        List *const rangeList = lstNewP(sizeof(BackupFileRange));
+
+        while (!pckReadNullP(param))
         {
-            const BackupFileResult *const fileResult = lstGet(result, resultIdx);
-
-            ASSERT(
-                fileResult->backupCopyResult == backupCopyResultSkip || fileResult->copySize != 0 ||
-                bufEq(fileResult->copyChecksum, HASH_TYPE_SHA1_ZERO_BUF));
-
-            pckWriteStrP(resultPack, fileResult->manifestFile);
-            pckWriteU32P(resultPack, fileResult->backupCopyResult);
-            pckWriteBoolP(resultPack, fileResult->repoInvalid);
-            pckWriteU64P(resultPack, fileResult->copySize);
-            pckWriteU64P(resultPack, fileResult->bundleOffset);
-            pckWriteU64P(resultPack, fileResult->blockIncrMapSize);
-            pckWriteU64P(resultPack, fileResult->repoSize);
-            pckWriteBinP(resultPack, fileResult->copyChecksum);
-            pckWriteBinP(resultPack, fileResult->repoChecksum);
-            pckWritePackP(resultPack, fileResult->pageChecksumResult);
+            BackupFileRange range = {.repoFile = pckReadStrP(param)};
+            range.backupCopyResult = (BackupCopyResult)pckReadU32P(param);
+            range.copySize = pckReadU64P(param);
+            range.repoSize = pckReadU64P(param);
+            range.blockIncrMapSize = pckReadU64P(param);
+            range.pageChecksumResult = pckReadPackP(param);
+
+            lstAdd(rangeList, &range);
         }
 
+        // Merge file
+        const BackupFileResult result = backupFileMerge(
+            repoFile, repoFileCompressType, cipherType, cipherPass, referenceList, rangeSize, &file, rangeList);
+
+        // Return result
+        PackWrite *const resultPack = protocolPackNew();
+
+        backupFileProtocolResult(resultPack, &result);
+
         protocolServerDataPut(server, resultPack);
         protocolServerDataEndPut(server);
     }
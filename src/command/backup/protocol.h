@@ -12,13 +12,16 @@ Functions
 ***********************************************************************************************************************************/
 // Process protocol requests
 FN_EXTERN void backupFileProtocol(PackRead *param, ProtocolServer *server);
+FN_EXTERN void backupFileMergeProtocol(PackRead *param, ProtocolServer *server);
 
 /***********************************************************************************************************************************
 Protocol commands for ProtocolServerHandler arrays passed to protocolServerProcess()
 ***********************************************************************************************************************************/
 #define PROTOCOL_COMMAND_BACKUP_FILE                                STRID5("bp-f", 0x36e020)
+#define PROTOCOL_COMMAND_BACKUP_FILE_MERGE                          STRID5("bp-m", 0x6ee020)
 
 #define PROTOCOL_SERVER_HANDLER_BACKUP_LIST                                                                                        \
-    {.command = PROTOCOL_COMMAND_BACKUP_FILE, .handler = backupFileProtocol},
+    {.command = PROTOCOL_COMMAND_BACKUP_FILE, .handler = backupFileProtocol},                                                      \
+    {.command = PROTOCOL_COMMAND_BACKUP_FILE_MERGE, .handler = backupFileMergeProtocol},
 
 #endif
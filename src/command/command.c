@@ -211,6 +211,8 @@ cmdEnd(const int code, const String *const errorMessage)
             if (statJson != NULL)
                 LOG_DETAIL_FMT("statistics: %s", strZ(statJson));
 
+            LOG_DEBUG_FMT("memory statistics: %s", strZ(statMemToJson()));
+
             // Basic info on command end
             String *const info = strCatFmt(strNew(), "%s command end: ", strZ(cfgCommandRoleName()));
 
@@ -4,8 +4,10 @@ Expire Command
 #include "build.auto.h"
 
 #include "command/archive/common.h"
+#include "command/backup/blockMap.h"
 #include "command/backup/common.h"
 #include "command/control/common.h"
+#include "common/crypto/xxhash.h"
 #include "common/debug.h"
 #include "common/regExp.h"
 #include "common/time.h"
@@ -18,6 +20,7 @@ Expire Command
 #include "storage/helper.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /***********************************************************************************************************************************
 Helper functions and structures
@@ -699,14 +702,30 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                         removeArchive = true;
                                         const String *const walSubPath = strLstGet(walSubPathList, subIdx);
 
-                                        // Determine if the individual archive log is used in a backup
+                                        // A bundle and its index are named for the first and last WAL segment in the bundle. The
+                                        // index is removed with the bundle so skip it when the bundle exists.
+                                        const bool bundle = strEndsWithZ(walSubPath, WAL_BUNDLE_EXT);
+                                        const bool bundleIndex = strEndsWithZ(walSubPath, WAL_BUNDLE_INDEX_EXT);
+                                        const String *const walSubPathFirst = strSubN(walSubPath, 0, 24);
+                                        const String *const walSubPathLast =
+                                            bundle || bundleIndex ? strSubN(walSubPath, 25, 24) : walSubPathFirst;
+
+                                        if (bundleIndex &&
+                                            strLstExists(
+                                                walSubPathList,
+                                                strNewFmt("%s-%s" WAL_BUNDLE_EXT, strZ(walSubPathFirst), strZ(walSubPathLast))))
+                                        {
+                                            continue;
+                                        }
+
+                                        // Determine if the individual archive log (or any archive log in the bundle) is used in a
+                                        // backup
                                         for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
                                         {
                                             const ArchiveRange *const archiveRange = lstGet(archiveRangeList, rangeIdx);
 
-                                            if (strCmp(strSubN(walSubPath, 0, 24), archiveRange->start) >= 0 &&
-                                                (archiveRange->stop == NULL ||
-                                                 strCmp(strSubN(walSubPath, 0, 24), archiveRange->stop) <= 0))
+                                            if (strCmp(walSubPathLast, archiveRange->start) >= 0 &&
+                                                (archiveRange->stop == NULL || strCmp(walSubPathFirst, archiveRange->stop) <= 0))
                                             {
                                                 removeArchive = false;
                                                 break;
@@ -719,6 +738,17 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                             // Execute the real expiration and deletion only if the dry-run mode is disabled
                                             if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                                             {
+                                                // Remove the index before the bundle so the index never references a missing bundle
+                                                if (bundle)
+                                                {
+                                                    storageRemoveP(
+                                                        storageRepoIdxWrite(repoIdx),
+                                                        strNewFmt(
+                                                            STORAGE_REPO_ARCHIVE "/%s/%s/%s-%s" WAL_BUNDLE_INDEX_EXT,
+                                                            strZ(archiveId), strZ(walPath), strZ(walSubPathFirst),
+                                                            strZ(walSubPathLast)));
+                                                }
+
                                                 storageRemoveP(
                                                     storageRepoIdxWrite(repoIdx),
                                                     strNewFmt(
@@ -728,10 +758,10 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
 
                                             // Track that this archive was removed
                                             archiveExpire.total++;
-                                            archiveExpire.stop = strDup(strSubN(walSubPath, 0, 24));
+                                            archiveExpire.stop = strDup(walSubPathLast);
 
                                             if (archiveExpire.start == NULL)
-                                                archiveExpire.start = strDup(strSubN(walSubPath, 0, 24));
+                                                archiveExpire.start = strDup(walSubPathFirst);
                                         }
                                         else
                                             logExpire(&archiveExpire, archiveId, repoIdx);
@@ -840,8 +870,8 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
                 else
                 {
                     const Manifest *const manifestResume = manifestLoadFile(
-                        storageRepoIdx(repoIdx), manifestFileName, cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx),
-                        infoPgCipherPass(infoBackupPg(infoBackup)));
+                        storageRepoIdx(repoIdx), manifestFileName, infoBackupCipherType(infoBackup),
+                        infoBackupCipherPass(infoBackup));
 
                     // If the ancestor of the resumable backup still exists in backup.info then do not remove the resumable backup
                     if (infoBackupLabelExists(infoBackup, manifestData(manifestResume)->backupLabelPrior))
@@ -970,6 +1000,372 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Block store references are stored as checksums rather than block paths to reduce memory usage
+***********************************************************************************************************************************/
+typedef struct BlockReference
+{
+    unsigned char checksum[XX_HASH_SIZE_MAX];                       // Block checksum
+    CompressType compressType;                                      // Block compress type
+} BlockReference;
+
+static int
+blockReferenceComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const BlockReference *const reference1 = item1;
+    const BlockReference *const reference2 = item2;
+    const int result = memcmp(reference1->checksum, reference2->checksum, XX_HASH_SIZE_MAX);
+
+    FUNCTION_TEST_RETURN(INT, result != 0 ? result : LST_COMPARATOR_CMP(reference1->compressType, reference2->compressType));
+}
+
+/***********************************************************************************************************************************
+Is the block in the reference list? The list is always sorted but is not marked as sorted after a merge, so bsearch() is used
+directly.
+***********************************************************************************************************************************/
+static bool
+removeExpiredBlockReferenceFind(const List *const referenceList, const BlockReference *const reference)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, referenceList);
+        FUNCTION_TEST_PARAM_P(VOID, reference);
+    FUNCTION_TEST_END();
+
+    ASSERT(referenceList != NULL);
+    ASSERT(reference != NULL);
+
+    FUNCTION_TEST_RETURN(
+        BOOL,
+        !lstEmpty(referenceList) &&
+        bsearch(reference, lstGet(referenceList, 0), lstSize(referenceList), sizeof(BlockReference), blockReferenceComparator) !=
+            NULL);
+}
+
+/***********************************************************************************************************************************
+Merge new references from a backup into the reference list. Most blocks in a backup are also referenced by other backups so only
+references that are not already in the list are added. Keeping the list free of duplicates bounds its size by the number of blocks
+in the block store rather than the number of block references in all backups.
+***********************************************************************************************************************************/
+static void
+removeExpiredBlockReferenceMerge(List *const referenceList, List *const referenceNewList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, referenceList);
+        FUNCTION_TEST_PARAM(LIST, referenceNewList);
+    FUNCTION_TEST_END();
+
+    ASSERT(referenceList != NULL);
+    ASSERT(referenceNewList != NULL);
+
+    // Sort new references and remove duplicates
+    lstSort(referenceNewList, sortOrderAsc);
+
+    unsigned int referenceNewTotal = 0;
+
+    for (unsigned int referenceNewIdx = 0; referenceNewIdx < lstSize(referenceNewList); referenceNewIdx++)
+    {
+        const BlockReference *const reference = lstGet(referenceNewList, referenceNewIdx);
+
+        if (referenceNewTotal == 0 || blockReferenceComparator(lstGet(referenceNewList, referenceNewTotal - 1), reference) != 0)
+        {
+            if (referenceNewIdx != referenceNewTotal)
+                memcpy(lstGet(referenceNewList, referenceNewTotal), reference, sizeof(BlockReference));
+
+            referenceNewTotal++;
+        }
+    }
+
+    // Add space for the new references and then merge from the end of the list so no items are moved more than once
+    unsigned int referenceIdx = lstSize(referenceList);
+
+    for (unsigned int referenceNewIdx = 0; referenceNewIdx < referenceNewTotal; referenceNewIdx++)
+        lstAdd(referenceList, lstGet(referenceNewList, referenceNewIdx));
+
+    unsigned int mergeIdx = lstSize(referenceList);
+
+    while (referenceNewTotal > 0)
+    {
+        mergeIdx--;
+
+        if (referenceIdx > 0 &&
+            blockReferenceComparator(lstGet(referenceList, referenceIdx - 1), lstGet(referenceNewList, referenceNewTotal - 1)) > 0)
+        {
+            memcpy(lstGet(referenceList, mergeIdx), lstGet(referenceList, referenceIdx - 1), sizeof(BlockReference));
+            referenceIdx--;
+        }
+        else
+        {
+            memcpy(lstGet(referenceList, mergeIdx), lstGet(referenceNewList, referenceNewTotal - 1), sizeof(BlockReference));
+            referenceNewTotal--;
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Add blocks in the block store referenced by backups in a stanza to the reference list. Returns false if there is a backup on disk
+that is not in the backup list, i.e. a backup that is in progress or has been aborted.
+***********************************************************************************************************************************/
+static bool
+removeExpiredBlockReference(
+    List *const referenceList, const String *const stanza, const StringList *const backupLabelList, const CipherType cipherType,
+    const String *const cipherPass, const unsigned int repoIdx)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, referenceList);
+        FUNCTION_LOG_PARAM(STRING, stanza);
+        FUNCTION_LOG_PARAM(STRING_LIST, backupLabelList);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+    FUNCTION_LOG_END();
+
+    ASSERT(referenceList != NULL);
+    ASSERT(stanza != NULL);
+    ASSERT(backupLabelList != NULL);
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const bool stanzaCurrent = strEq(stanza, cfgOptionStr(cfgOptStanza));
+        const StringList *const backupList = strLstSort(
+            storageListP(
+                storageRepoIdx(repoIdx), strNewFmt(STORAGE_PATH_BACKUP "/%s", strZ(stanza)),
+                .expression = backupRegExpP(.full = true, .differential = true, .incremental = true)),
+            sortOrderAsc);
+
+        for (unsigned int backupIdx = 0; backupIdx < strLstSize(backupList); backupIdx++)
+        {
+            const String *const backupLabel = strLstGet(backupList, backupIdx);
+
+            // Backups for the current stanza cannot be running since the lock is held, so include any that are not in the backup
+            // list in case they are resumed later. Backups for other stanzas that are not in the backup list may be writing blocks
+            // so the block store cannot be cleaned up.
+            if (!stanzaCurrent && !strLstExists(backupLabelList, backupLabel))
+            {
+                LOG_INFO_FMT(
+                    "%s: skip block store cleanup because backup %s/%s is in progress or aborted",
+                    cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(stanza), strZ(backupLabel));
+
+                result = false;
+                break;
+            }
+
+            // Add block store references for all block incremental files stored in this backup. Only one manifest is loaded at a
+            // time to limit memory usage.
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                const Manifest *const manifest = manifestLoadFile(
+                    storageRepoIdx(repoIdx),
+                    strNewFmt(STORAGE_PATH_BACKUP "/%s/%s/" BACKUP_MANIFEST_FILE, strZ(stanza), strZ(backupLabel)), cipherType,
+                    cipherPass);
+                const CompressType compressType = manifestData(manifest)->backupOptionCompressType;
+                List *const referenceNewList = lstNewP(sizeof(BlockReference), .comparator = blockReferenceComparator);
+
+                for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+                {
+                    const ManifestFile file = manifestFile(manifest, fileIdx);
+
+                    if (file.reference == NULL && file.blockIncrMapSize != 0)
+                    {
+                        IoRead *const read = storageReadIo(
+                            storageNewReadP(
+                                storageRepoIdx(repoIdx),
+                                backupFileRepoPathP(
+                                    backupLabel, .manifestName = file.name, .bundleId = file.bundleId,
+                                    .compressType = compressType, .blockIncr = true, .stanza = stanza),
+                                .offset = file.bundleOffset + file.sizeRepo - file.blockIncrMapSize,
+                                .limit = VARUINT64(file.blockIncrMapSize)));
+                        ioReadOpen(read);
+
+                        const BlockMap *const blockMap = blockMapNewRead(read, file.blockIncrSize, file.blockIncrChecksumSize);
+
+                        for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+                        {
+                            const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+
+                            // Block maps either reference the block store for all blocks or not at all
+                            if (blockMapItem->reference != BLOCK_MAP_REFERENCE_STORE)
+                                break;
+
+                            BlockReference reference = {.compressType = compressType};
+                            memcpy(reference.checksum, blockMapItem->checksum, XX_HASH_SIZE_MAX);
+
+                            if (!removeExpiredBlockReferenceFind(referenceList, &reference))
+                                lstAdd(referenceNewList, &reference);
+                        }
+                    }
+                }
+
+                removeExpiredBlockReferenceMerge(referenceList, referenceNewList);
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Remove blocks from the block store that are not referenced by any backup in any stanza. Reference counts are not stored since blocks
+can be shared by backups in multiple stanzas, so the references are counted here by reading the block maps of all backups in the
+repo.
+
+Blocks are not removed while a backup is running in another stanza since the backup may have found a block in the block store that
+is not yet referenced by a manifest. The block store lock (see backupBlockStoreLockWrite()) is written before checking for backups
+so a backup that starts later will not use the block store until the lock is removed.
+***********************************************************************************************************************************/
+static void
+removeExpiredBlock(const InfoBackup *const infoBackup, const unsigned int repoIdx)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+    FUNCTION_LOG_END();
+
+    ASSERT(infoBackup != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        if (storagePathExistsP(storageRepoIdx(repoIdx), STORAGE_PATH_BLOCK_STR))
+        {
+            const bool dryRun = cfgOptionValid(cfgOptDryRun) && cfgOptionBool(cfgOptDryRun);
+
+            // The lock is not needed for dry-run since no blocks will be removed
+            if (!dryRun)
+                backupBlockStoreLockWrite(storageRepoIdxWrite(repoIdx), cfgOptionStr(cfgOptStanza), true);
+
+            TRY_BEGIN()
+            {
+                List *const referenceList = lstNewP(sizeof(BlockReference), .comparator = blockReferenceComparator);
+                const String *const stanzaBackup = backupBlockStoreLockFind(
+                    dryRun ? storageRepoIdx(repoIdx) : storageRepoIdxWrite(repoIdx), cfgOptionStr(cfgOptStanza), false, !dryRun);
+                volatile bool clean = stanzaBackup == NULL;
+
+                if (!clean)
+                {
+                    LOG_INFO_FMT(
+                        "%s: skip block store cleanup because a backup is running in stanza %s",
+                        cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(stanzaBackup));
+                }
+
+                const StringList *const stanzaList = strLstSort(
+                    storageListP(storageRepoIdx(repoIdx), STORAGE_PATH_BACKUP_STR), sortOrderAsc);
+
+                for (unsigned int stanzaIdx = 0; clean && stanzaIdx < strLstSize(stanzaList); stanzaIdx++)
+                {
+                    const String *const stanza = strLstGet(stanzaList, stanzaIdx);
+
+                    TRY_BEGIN()
+                    {
+                        // Use the backup list in memory for the current stanza since it has already been updated by expiration
+                        if (strEq(stanza, cfgOptionStr(cfgOptStanza)))
+                        {
+                            clean = removeExpiredBlockReference(
+                                referenceList, stanza, infoBackupDataLabelList(infoBackup, NULL),
+                                infoBackupCipherType(infoBackup), infoBackupCipherPass(infoBackup), repoIdx);
+                        }
+                        // Else load the backup list for the stanza. The block store cannot be used with encryption so other
+                        // stanzas that share the block store are not encrypted.
+                        else
+                        {
+                            const InfoBackup *const infoBackupStanza = infoBackupLoadFile(
+                                storageRepoIdx(repoIdx), strNewFmt(STORAGE_PATH_BACKUP "/%s/" INFO_BACKUP_FILE, strZ(stanza)),
+                                cipherTypeNone, NULL);
+
+                            clean = removeExpiredBlockReference(
+                                referenceList, stanza, infoBackupDataLabelList(infoBackupStanza, NULL), cipherTypeNone, NULL,
+                                repoIdx);
+                        }
+                    }
+                    CATCH_ANY()
+                    {
+                        LOG_WARN_FMT(
+                            "%s: skip block store cleanup because stanza %s could not be read\n%s",
+                            cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(stanza), errorMessage());
+
+                        clean = false;
+                    }
+                    TRY_END();
+                }
+
+                // Remove blocks that are not referenced. Each block store path is listed separately to limit memory usage and the
+                // lock path is skipped.
+                if (clean)
+                {
+                    const StringList *const pathList = strLstSort(
+                        storageListP(storageRepoIdx(repoIdx), STORAGE_PATH_BLOCK_STR, .expression = STRDEF("^[0-9a-f]{2}$")),
+                        sortOrderAsc);
+                    unsigned int removeTotal = 0;
+
+                    for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+                    {
+                        MEM_CONTEXT_TEMP_BEGIN()
+                        {
+                            const String *const path = strNewFmt(STORAGE_PATH_BLOCK "/%s", strZ(strLstGet(pathList, pathIdx)));
+                            StorageIterator *const storageItr = storageNewItrP(
+                                storageRepoIdx(repoIdx), path, .sortOrder = sortOrderAsc);
+
+                            while (storageItrMore(storageItr))
+                            {
+                                const StorageInfo info = storageItrNext(storageItr);
+
+                                if (info.type == storageTypeFile)
+                                {
+                                    BlockReference reference;
+
+                                    // Files that are not blocks, e.g. temp files left by a backup that errored, are also removed
+                                    if (!backupBlockStoreName(info.name, reference.checksum, &reference.compressType) ||
+                                        !removeExpiredBlockReferenceFind(referenceList, &reference))
+                                    {
+                                        // Execute the real deletion only if the dry-run mode is disabled. Expire in another stanza
+                                        // may be removing the same blocks so missing blocks are ignored.
+                                        if (!dryRun)
+                                        {
+                                            storageRemoveP(
+                                                storageRepoIdxWrite(repoIdx), strNewFmt("%s/%s", strZ(path), strZ(info.name)));
+                                        }
+
+                                        removeTotal++;
+                                    }
+                                }
+                            }
+                        }
+                        MEM_CONTEXT_TEMP_END();
+                    }
+
+                    if (removeTotal > 0)
+                    {
+                        LOG_INFO_FMT(
+                            "%s: remove %u unreferenced block(s) from block store", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
+                            removeTotal);
+                    }
+                }
+            }
+            FINALLY()
+            {
+                if (!dryRun)
+                    backupBlockStoreLockRemove(storageRepoIdxWrite(repoIdx), cfgOptionStr(cfgOptStanza), true);
+            }
+            TRY_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdExpire(void)
@@ -1076,6 +1472,7 @@ cmdExpire(void)
 
                 // Remove all files on disk that are now expired
                 removeExpiredBackup(infoBackup, adhocBackupLabel, repoIdx);
+                removeExpiredBlock(infoBackup, repoIdx);
                 removeExpiredArchive(infoBackup, timeBasedFullRetention, repoIdx);
                 removeExpiredHistory(infoBackup, repoIdx);
             }
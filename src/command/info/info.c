@@ -344,12 +344,13 @@ archiveDbList(
         // Not every WAL dir has WAL files so check each
         for (unsigned int idx = 0; idx < strLstSize(walDir); idx++)
         {
-            // Get a list of all WAL in this WAL dir and sort the list from oldest to newest to get the oldest starting WAL archived
-            // for this db
+            // Get a list of all WAL (and bundle indexes) in this WAL dir and sort the list from oldest to newest to get the oldest
+            // starting WAL archived for this db. Bundle indexes are named for the first WAL segment in the bundle so they sort
+            // correctly.
             const StringList *const list = strLstSort(
                 storageListP(
                     storageRepo, strNewFmt("%s/%s", strZ(archivePath), strZ(strLstGet(walDir, idx))),
-                    .expression = WAL_SEGMENT_FILE_REGEXP_STR),
+                    .expression = WAL_SEGMENT_FILE_BUNDLE_REGEXP_STR),
                 sortOrderAsc);
 
             // If wal segments are found, get the oldest one as the archive start
@@ -363,20 +364,25 @@ archiveDbList(
         // Iterate through the directory list in reverse processing newest first. Cast comparison to an int for readability.
         for (unsigned int idx = strLstSize(walDir) - 1; (int)idx >= 0; idx--)
         {
-            // Get a list of all WAL in this WAL dir and sort the list from newest to oldest to get the newest ending WAL archived
-            // for this db
-            const StringList *const list = strLstSort(
-                storageListP(
-                    storageRepo, strNewFmt("%s/%s", strZ(archivePath), strZ(strLstGet(walDir, idx))),
-                    .expression = WAL_SEGMENT_FILE_REGEXP_STR),
-                sortOrderDesc);
-
-            // If wal segments are found, get the newest one as the archive stop
-            if (!strLstEmpty(list))
+            // Get a list of all WAL (and bundle indexes) in this WAL dir to get the newest ending WAL archived for this db
+            const StringList *const list = storageListP(
+                storageRepo, strNewFmt("%s/%s", strZ(archivePath), strZ(strLstGet(walDir, idx))),
+                .expression = WAL_SEGMENT_FILE_BUNDLE_REGEXP_STR);
+
+            // If wal segments are found, get the newest one as the archive stop. Bundle indexes are named for the last WAL segment
+            // in the bundle after the first so they do not sort correctly.
+            for (unsigned int listIdx = 0; listIdx < strLstSize(list); listIdx++)
             {
-                archiveStop = strSubN(strLstGet(list, 0), 0, 24);
-                break;
+                const String *const file = strLstGet(list, listIdx);
+                const String *const walSegment = strSubN(
+                    file, strEndsWithZ(file, WAL_BUNDLE_INDEX_EXT) ? WAL_SEGMENT_NAME_SIZE + 1 : 0, WAL_SEGMENT_NAME_SIZE);
+
+                if (archiveStop == NULL || strCmp(walSegment, archiveStop) > 0)
+                    archiveStop = walSegment;
             }
+
+            if (archiveStop != NULL)
+                break;
         }
     }
 
@@ -1291,8 +1297,8 @@ infoUpdateStanza(
                 {
                     stanzaRepo->repoList[repoIdx].manifest = manifestLoadFile(
                         storage, strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)),
-                        stanzaRepo->repoList[repoIdx].cipher,
-                        infoPgCipherPass(infoBackupPg(stanzaRepo->repoList[repoIdx].backupInfo)));
+                        infoBackupCipherType(stanzaRepo->repoList[repoIdx].backupInfo),
+                        infoBackupCipherPass(stanzaRepo->repoList[repoIdx].backupInfo));
                 }
 
                 // If a backup lock check has not already been performed, then do so
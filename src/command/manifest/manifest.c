@@ -120,9 +120,10 @@ cmdManifestBlockDelta(
             {
                 const unsigned int blockMapIdx = *(unsigned int *)lstGet(referenceData->blockList, blockIdx);
                 const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+                const bool store = blockMapItem->reference == BLOCK_MAP_REFERENCE_STORE;
 
-                // Add read when it has changed
-                if (blockMapItemPrior == NULL ||
+                // Add read when it has changed. Each block in the block store is a separate read.
+                if (blockMapItemPrior == NULL || store ||
                     (blockMapItemPrior->offset != blockMapItem->offset &&
                      blockMapItemPrior->offset + blockMapItemPrior->size != blockMapItem->offset))
                 {
@@ -142,7 +143,7 @@ cmdManifestBlockDelta(
                 }
 
                 // Add super block when it has changed
-                if (blockMapItemPrior == NULL || blockMapItemPrior->offset != blockMapItem->offset)
+                if (blockMapItemPrior == NULL || store || blockMapItemPrior->offset != blockMapItem->offset)
                 {
                     MEM_CONTEXT_OBJ_BEGIN(blockDeltaRead->superBlockList)
                     {
@@ -236,7 +237,7 @@ cmdManifestBlockDeltaRender(const Manifest *const manifest, const ManifestFile *
                 ioFilterGroupAdd(
                     ioReadFilterGroup(storageReadIo(read)),
                     cipherBlockNewP(
-                        cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(manifestCipherSubPass(manifest)), .raw = true));
+                        cipherModeDecrypt, manifestCipherSubType(manifest), BUFSTR(manifestCipherSubPass(manifest)), .raw = true));
             }
 
             ioReadOpen(storageReadIo(read));
@@ -290,21 +291,29 @@ cmdManifestBlockDeltaRender(const Manifest *const manifest, const ManifestFile *
                         else
                             strCatChr(result, ',');
 
+                        // The block store is not a reference so output null
+                        if (read->reference == BLOCK_MAP_REFERENCE_STORE)
+                            strCatZ(result, "{\"reference\":null");
+                        else
+                            strCatFmt(result, "{\"reference\":%u", read->reference);
+
                         strCatFmt(
                             result,
-                            "{\"reference\":%u,\"read\":{\"total\":%u,\"size\":%" PRIu64 "},\"superBlock\":{\"total\":%u"
-                            ",\"size\":%" PRIu64 "},\"block\":{\"total\":%u}}",
-                            read->reference, referenceRead, referenceReadSize, referenceSuperBlock, referenceSuperBlockSize,
-                            referenceBlock);
+                            ",\"read\":{\"total\":%u,\"size\":%" PRIu64 "},\"superBlock\":{\"total\":%u,\"size\":%" PRIu64 "}"
+                            ",\"block\":{\"total\":%u}}",
+                            referenceRead, referenceReadSize, referenceSuperBlock, referenceSuperBlockSize, referenceBlock);
                     }
                     else
                     {
-                        const String *const reference = strSub(
-                            backupFileRepoPathP(
-                                strLstGet(manifestReferenceList(manifest), read->reference), .manifestName = file->name,
-                                .bundleId = read->bundleId,
-                                .compressType = manifestData(manifest)->backupOptionCompressType, .blockIncr = true),
-                            sizeof(STORAGE_REPO_BACKUP));
+                        const String *const reference =
+                            read->reference == BLOCK_MAP_REFERENCE_STORE ?
+                                STORAGE_PATH_BLOCK_STR :
+                                strSub(
+                                    backupFileRepoPathP(
+                                        strLstGet(manifestReferenceList(manifest), read->reference), .manifestName = file->name,
+                                        .bundleId = read->bundleId,
+                                        .compressType = manifestData(manifest)->backupOptionCompressType, .blockIncr = true),
+                                    sizeof(STORAGE_REPO_BACKUP));
 
                         strCatFmt(
                             result, "        reference: %s, read: %u/%s, superBlock: %u/%s, block: %u/%s\n",
@@ -442,7 +451,7 @@ cmdManifestRender(void)
             storageRepo(), INFO_BACKUP_PATH_FILE_STR, cfgOptionStrId(cfgOptRepoCipherType),
             cfgOptionStrNull(cfgOptRepoCipherPass));
         const String *const cipherPass = infoPgCipherPass(infoBackupPg(infoBackup));
-        const CipherType cipherType = cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc;
+        const CipherType cipherType = infoBackupCipherType(infoBackup);
 
         // Load manifest
         const Manifest *const manifest = manifestLoadFile(
@@ -53,7 +53,9 @@ storageGetProcess(IoWrite *const destination)
 
             if (repoCipherType != cipherTypeNone)
             {
-                // Check for a passphrase parameter
+                // Check for a passphrase parameter. The cipher type is updated along with the passphrase since it is stored with
+                // the passphrase in the info files and manifest.
+                CipherType cipherType = repoCipherType;
                 const String *cipherPass = cfgOptionStrNull(cfgOptCipherPass);
 
                 // If not passed as a parameter then determine the passphrase using the following pattern:
@@ -97,6 +99,7 @@ storageGetProcess(IoWrite *const destination)
                                 const InfoArchive *const info = infoArchiveLoadFile(
                                     storageRepo(), strNewFmt(STORAGE_PATH_ARCHIVE "/%s/%s", strZ(stanza), INFO_ARCHIVE_FILE),
                                     repoCipherType, cipherPass);
+                                cipherType = infoArchiveCipherType(info);
                                 cipherPass = infoArchiveCipherPass(info);
                             }
                         }
@@ -112,6 +115,7 @@ storageGetProcess(IoWrite *const destination)
                                 const InfoBackup *const info = infoBackupLoadFile(
                                     storageRepo(), strNewFmt(STORAGE_PATH_BACKUP "/%s/%s", strZ(stanza), INFO_BACKUP_FILE),
                                     repoCipherType, cipherPass);
+                                cipherType = infoBackupCipherType(info);
                                 cipherPass = infoBackupCipherPass(info);
 
                                 // Find the manifest passphrase
@@ -124,7 +128,8 @@ storageGetProcess(IoWrite *const destination)
                                         strNewFmt(
                                             STORAGE_PATH_BACKUP "/%s/%s/%s", strZ(stanza), strZ(strLstGet(filePathSplitLst, 2)),
                                             BACKUP_MANIFEST_FILE),
-                                        repoCipherType, cipherPass);
+                                        cipherType, cipherPass);
+                                    cipherType = manifestCipherSubType(manifest);
                                     cipherPass = manifestCipherSubPass(manifest);
                                 }
                             }
@@ -137,7 +142,7 @@ storageGetProcess(IoWrite *const destination)
                     THROW_FMT(OptionInvalidValueError, "unable to determine cipher passphrase for '%s'", strZ(file));
 
                 // Add encryption filter
-                cipherBlockFilterGroupAdd(ioReadFilterGroup(source), repoCipherType, cipherModeDecrypt, cipherPass);
+                cipherBlockFilterGroupAdd(ioReadFilterGroup(source), cipherType, cipherModeDecrypt, cipherPass);
             }
         }
 
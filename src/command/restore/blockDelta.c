@@ -57,7 +57,7 @@ typedef struct BlockDeltaReference
 FN_EXTERN BlockDelta *
 blockDeltaNew(
     const BlockMap *const blockMap, const size_t blockSize, const size_t checksumSize, const Buffer *const blockChecksum,
-    const CipherType cipherType, const String *const cipherPass, const CompressType compressType)
+    const CipherType cipherType, const String *const cipherPass, const CompressType compressType, const BlockDeltaNewParam param)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(BLOCK_MAP, blockMap);
@@ -67,11 +67,14 @@ blockDeltaNew(
         FUNCTION_TEST_PARAM(STRING_ID, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
         FUNCTION_TEST_PARAM(ENUM, compressType);
+        FUNCTION_TEST_PARAM(UINT, param.partIdx);
+        FUNCTION_TEST_PARAM(UINT, param.partTotal);
     FUNCTION_TEST_END();
 
     ASSERT(blockMap != NULL);
     ASSERT(blockSize > 0);
     ASSERT(cipherType == cipherTypeNone || cipherPass != NULL);
+    ASSERT(param.partTotal == 0 || param.partIdx < param.partTotal);
 
     OBJ_NEW_BEGIN(BlockDelta, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -99,7 +102,18 @@ blockDeltaNew(
                 blockChecksum == NULL ? 0 : (unsigned int)(bufUsed(blockChecksum) / this->checksumSize);
             List *const referenceList = lstNewP(sizeof(BlockDeltaReference), .comparator = lstComparatorUInt);
 
-            for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+            // When restoring a part of the file only the blocks in the part's range are considered. The blocks are divided evenly
+            // between the parts so each part reads a contiguous range of the file.
+            unsigned int blockMapBegin = 0;
+            unsigned int blockMapEnd = blockMapSize(blockMap);
+
+            if (param.partTotal != 0)
+            {
+                blockMapBegin = (unsigned int)((uint64_t)blockMapEnd * param.partIdx / param.partTotal);
+                blockMapEnd = (unsigned int)((uint64_t)blockMapEnd * (param.partIdx + 1) / param.partTotal);
+            }
+
+            for (unsigned int blockMapIdx = blockMapBegin; blockMapIdx < blockMapEnd; blockMapIdx++)
             {
                 const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
@@ -143,14 +157,18 @@ blockDeltaNew(
                     const unsigned int blockMapIdx = *(unsigned int *)lstGet(referenceData->blockList, blockIdx);
                     const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
-                    // Add read when it has changed
-                    if (blockMapItemPrior == NULL ||
+                    // Each block in the block store is stored in a separate file so it always requires a separate read
+                    const bool store = blockMapItem->reference == BLOCK_MAP_REFERENCE_STORE;
+
+                    // Add read when it has changed. A reference may have more than one bundle when a file was split into ranges
+                    // during the backup.
+                    if (blockMapItemPrior == NULL || store || blockMapItemPrior->bundleId != blockMapItem->bundleId ||
                         (blockMapItemPrior->offset != blockMapItem->offset &&
                          blockMapItemPrior->offset + blockMapItemPrior->size != blockMapItem->offset))
                     {
                         MEM_CONTEXT_OBJ_BEGIN(this->pub.readList)
                         {
-                            const BlockDeltaRead blockDeltaReadNew =
+                            BlockDeltaRead blockDeltaReadNew =
                             {
                                 .reference = blockMapItem->reference,
                                 .bundleId = blockMapItem->bundleId,
@@ -158,13 +176,17 @@ blockDeltaNew(
                                 .superBlockList = lstNewP(sizeof(BlockDeltaSuperBlock)),
                             };
 
+                            memcpy(
+                                blockDeltaReadNew.checksum, blockMapItem->checksum,
+                                SIZE_OF_STRUCT_MEMBER(BlockDeltaRead, checksum));
                             blockDeltaRead = lstAdd(this->pub.readList, &blockDeltaReadNew);
                         }
                         MEM_CONTEXT_OBJ_END();
                     }
 
                     // Add super block when it has changed
-                    if (blockMapItemPrior == NULL || blockMapItemPrior->offset != blockMapItem->offset)
+                    if (blockMapItemPrior == NULL || store || blockMapItemPrior->bundleId != blockMapItem->bundleId ||
+                        blockMapItemPrior->offset != blockMapItem->offset)
                     {
                         MEM_CONTEXT_OBJ_BEGIN(blockDeltaRead->superBlockList)
                         {
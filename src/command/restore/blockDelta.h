@@ -23,6 +23,7 @@ typedef struct BlockDeltaRead
     uint64_t bundleId;                                              // Bundle to read from
     uint64_t offset;                                                // Offset to begin read from
     uint64_t size;                                                  // Size of the read
+    unsigned char checksum[XX_HASH_SIZE_MAX];                       // Block checksum (to locate the block in the block store)
     List *superBlockList;                                           // Super block list
 } BlockDeltaRead;
 
@@ -36,9 +37,21 @@ typedef struct BlockDeltaWrite
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+typedef struct BlockDeltaNewParam
+{
+    VAR_PARAM_HEADER;
+    unsigned int partIdx;                                           // Part of the file to restore (when partTotal > 0)
+    unsigned int partTotal;                                         // Restore only a part of the blocks (0 for all blocks)
+} BlockDeltaNewParam;
+
+#define blockDeltaNewP(blockMap, blockSize, checksumSize, blockChecksum, cipherType, cipherPass, compressType, ...)                \
+    blockDeltaNew(                                                                                                                 \
+        blockMap, blockSize, checksumSize, blockChecksum, cipherType, cipherPass, compressType,                                    \
+        (BlockDeltaNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 FN_EXTERN BlockDelta *blockDeltaNew(
     const BlockMap *blockMap, size_t blockSize, size_t checksumSize, const Buffer *blockChecksum, CipherType cipherType,
-    const String *cipherPass, const CompressType compressType);
+    const String *cipherPass, const CompressType compressType, BlockDeltaNewParam param);
 
 /***********************************************************************************************************************************
 Functions
@@ -25,11 +25,93 @@ Restore File
 #include "info/manifest.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Helper to calculate the checksum of a restored file
+***********************************************************************************************************************************/
+static Buffer *
+restoreFilePgChecksum(const String *const name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(name != NULL);
+
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        IoRead *const read = storageReadIo(storageNewReadP(storagePg(), name));
+
+        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+        ioReadDrain(read);
+
+        PackRead *const hashResult = ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE);
+
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = pckReadBinP(hashResult);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BUFFER, result);
+}
+
+/***********************************************************************************************************************************
+Helper to validate the checksum of a restored file
+***********************************************************************************************************************************/
+static void
+restoreFileChecksumValidate(const RestoreFile *const file, const Buffer *const checksum)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, file);
+        FUNCTION_TEST_PARAM(BUFFER, checksum);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+    ASSERT(checksum != NULL);
+
+    if (!bufEq(file->checksum, checksum))
+    {
+        THROW_FMT(
+            ChecksumError, "error restoring '%s': actual checksum '%s' does not match expected checksum '%s'", strZ(file->name),
+            strZ(strNewEncode(encodingHex, checksum)), strZ(strNewEncode(encodingHex, file->checksum)));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Helper to set the modification time of a restored file
+***********************************************************************************************************************************/
+static void
+restoreFileTimeModifiedSet(const char *const fileName, const time_t timeModified)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, fileName);
+        FUNCTION_TEST_PARAM(TIME, timeModified);
+    FUNCTION_TEST_END();
+
+    ASSERT(fileName != NULL);
+
+    const struct utimbuf uTimeBuf =
+    {
+        .actime = timeModified,
+        .modtime = timeModified,
+    };
+
+    THROW_ON_SYS_ERROR_FMT(utime(fileName, &uTimeBuf) == -1, FileInfoError, "unable to set time for '%s'", fileName);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN List *
 restoreFile(
     const String *const repoFile, const unsigned int repoIdx, const CompressType repoFileCompressType, const time_t copyTimeBegin,
-    const bool delta, const bool deltaForce, const bool bundleRaw, const String *const cipherPass,
+    const bool delta, const bool deltaForce, const bool bundleRaw, const CipherType cipherType, const String *const cipherPass,
     const StringList *const referenceList, List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
@@ -40,12 +122,14 @@ restoreFile(
         FUNCTION_LOG_PARAM(BOOL, delta);
         FUNCTION_LOG_PARAM(BOOL, deltaForce);
         FUNCTION_LOG_PARAM(BOOL, bundleRaw);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
         FUNCTION_LOG_PARAM(STRING_LIST, referenceList);             // List of references (for block incremental)
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to restore
     FUNCTION_LOG_END();
 
     ASSERT(repoFile != NULL);
+    ASSERT(cipherType == cipherTypeNone || cipherPass != NULL);
 
     // Restore file results
     List *const result = lstNewP(sizeof(RestoreFileResult));
@@ -55,8 +139,9 @@ restoreFile(
         // Check files to determine which ones need to be restored
         for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
         {
-            // Use a per-file mem context to reduce memory usage
-            MEM_CONTEXT_TEMP_BEGIN()
+            // Use a per-file arena mem context to reduce memory usage and allocation overhead. Nothing created here outlives the
+            // loop except the block checksum, which is created directly in the file list context.
+            MEM_CONTEXT_TEMP_ARENA_BEGIN()
             {
                 RestoreFile *const file = lstGet(fileList, fileIdx);
                 ASSERT(file->name != NULL);
@@ -156,17 +241,7 @@ restoreFile(
                                     // backup time. This helps with unit testing, but also presents a pristine version of the
                                     // database after restore.
                                     if (info.timeModified != file->timeModified)
-                                    {
-                                        const struct utimbuf uTimeBuf =
-                                        {
-                                            .actime = file->timeModified,
-                                            .modtime = file->timeModified,
-                                        };
-
-                                        THROW_ON_SYS_ERROR_FMT(
-                                            utime(fileName, &uTimeBuf) == -1, FileInfoError, "unable to set time for '%s'",
-                                            fileName);
-                                    }
+                                        restoreFileTimeModifiedSet(fileName, file->timeModified);
 
                                     fileResult->result = restoreResultPreserve;
                                 }
@@ -219,6 +294,7 @@ restoreFile(
         // Copy files from repository to database
         StorageRead *repoFileRead = NULL;
         uint64_t repoFileLimit = 0;
+        bool repoFileDirect = false;                                // Have all files from the repo file been copied directly?
 
         for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
         {
@@ -228,11 +304,26 @@ restoreFile(
                 const RestoreFile *const file = lstGet(fileList, fileIdx);
                 RestoreFileResult *const fileResult = lstGet(result, fileIdx);
 
-                // Copy file from repository to database
-                if (fileResult->result == restoreResultCopy)
+                // Verify a file that was restored in parts by separate jobs. All the blocks in the file were restored so the delta
+                // size is the same as the file size.
+                if (fileResult->result == restoreResultCopy && file->partVerify)
                 {
-                    // If no repo file is currently open
-                    if (repoFileLimit == 0)
+                    ASSERT(file->partTotal != 0);
+
+                    restoreFileChecksumValidate(file, restoreFilePgChecksum(file->name));
+
+                    // Set the modification time since it may have been updated by a part written after another part was closed
+                    restoreFileTimeModifiedSet(strZ(storagePathP(storagePg(), file->name)), file->timeModified);
+
+                    fileResult->blockIncrDeltaSize = file->size;
+                }
+                // Else copy file from repository to database
+                else if (fileResult->result == restoreResultCopy)
+                {
+                    // Open a new repo file if no repo file is currently open
+                    const bool repoFileNew = repoFileLimit == 0;
+
+                    if (repoFileNew)
                     {
                         // If a limit is specified then we need to use it, even if there is only one pg file to copy, because we
                         // might be reading from the middle of a repo file containing many pg files
@@ -285,7 +376,7 @@ restoreFile(
                     StorageWrite *const pgFileWrite = storageNewWriteP(
                         storagePgWrite(), file->name, .modeFile = file->mode, .user = file->user, .group = file->group,
                         .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true,
-                        .noTruncate = file->blockChecksum != NULL);
+                        .noTruncate = file->blockChecksum != NULL || file->partTotal != 0);
 
                     // If block incremental file
                     const Buffer *checksum = NULL;
@@ -302,7 +393,7 @@ restoreFile(
                         {
                             ioFilterGroupAdd(
                                 ioReadFilterGroup(blockMapRead),
-                                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass), .raw = true));
+                                cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = true));
                         }
 
                         ioReadOpen(blockMapRead);
@@ -317,21 +408,25 @@ restoreFile(
                         ioWriteOpen(storageWriteIo(pgFileWrite));
 
                         // Apply delta to file
-                        BlockDelta *const blockDelta = blockDeltaNew(
+                        BlockDelta *const blockDelta = blockDeltaNewP(
                             blockMap, file->blockIncrSize, file->blockIncrChecksumSize, file->blockChecksum,
-                            cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc, cipherPass, repoFileCompressType);
+                            cipherType, cipherPass, repoFileCompressType,
+                            .partIdx = file->partIdx, .partTotal = file->partTotal);
 
                         for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
                         {
                             const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
 
                             // Open the super block list for read. Using one read for all super blocks is cheaper than reading from
-                            // the file multiple times, which is especially noticeable on object stores.
+                            // the file multiple times, which is especially noticeable on object stores. Blocks in the block store
+                            // are read from a separate file for each block.
                             StorageRead *const superBlockRead = storageNewReadP(
                                 storageRepo(),
-                                backupFileRepoPathP(
-                                    strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
-                                    .bundleId = read->bundleId, .blockIncr = true),
+                                read->reference == BLOCK_MAP_REFERENCE_STORE ?
+                                    backupBlockStorePath(read->checksum, repoFileCompressType) :
+                                    backupFileRepoPathP(
+                                        strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
+                                        .bundleId = read->bundleId, .blockIncr = true),
                                 .offset = read->offset, .limit = VARUINT64(read->size));
                             ioReadOpen(storageReadIo(superBlockRead));
 
@@ -365,44 +460,72 @@ restoreFile(
 
                         // Calculate checksum. In theory this is not needed because the file should always be reconstructed
                         // correctly. However, it seems better to check and the pages should still be buffered making the operation
-                        // very fast.
-                        IoRead *const read = storageReadIo(storageNewReadP(storagePg(), file->name));
-
-                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
-                        ioReadDrain(read);
-
-                        checksum = pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE));
+                        // very fast. A file restored in parts is checked when it is verified after all parts have been restored.
+                        if (file->partTotal == 0)
+                            checksum = restoreFilePgChecksum(file->name);
                     }
                     // Else normal file
                     else
                     {
                         IoFilterGroup *const filterGroup = ioWriteFilterGroup(storageWriteIo(pgFileWrite));
 
-                        // Add decryption filter
-                        if (cipherPass != NULL)
+                        // A file that is not compressed or encrypted can be copied directly when the storage allows it, which is
+                        // much faster for local repositories since the data does not pass through user space. No filters are
+                        // added so the copy is not prevented. Later files from a repo file can only be copied directly when the
+                        // files before them were, since data read through user space may have been buffered.
+                        const bool copyDirect =
+                            repoFileCompressType == compressTypeNone && cipherPass == NULL && storageReadCopyDirect(repoFileRead) &&
+                            (repoFileNew || repoFileDirect);
+
+                        if (!copyDirect)
                         {
-                            ioFilterGroupAdd(
-                                filterGroup,
-                                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass), .raw = bundleRaw));
-                        }
+                            // Add decryption filter
+                            if (cipherPass != NULL)
+                            {
+                                ioFilterGroupAdd(
+                                    filterGroup,
+                                    cipherBlockNewP(
+                                        cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = bundleRaw));
+                            }
 
-                        // Add decompression filter
-                        if (repoFileCompressType != compressTypeNone)
-                            ioFilterGroupAdd(filterGroup, decompressFilterP(repoFileCompressType, .raw = bundleRaw));
+                            // Add decompression filter
+                            if (repoFileCompressType != compressTypeNone)
+                                ioFilterGroupAdd(filterGroup, decompressFilterP(repoFileCompressType, .raw = bundleRaw));
 
-                        // Add sha1 filter
-                        ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+                            // Add sha1 filter
+                            ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
 
-                        // Add size filter
-                        ioFilterGroupAdd(filterGroup, ioSizeNew());
+                            // Add size filter
+                            ioFilterGroupAdd(filterGroup, ioSizeNew());
+                        }
 
                         // Copy file
                         ioWriteOpen(storageWriteIo(pgFileWrite));
-                        ioCopyP(storageReadIo(repoFileRead), storageWriteIo(pgFileWrite), .limit = file->limit);
+                        repoFileDirect = storageReadCopyP(repoFileRead, storageWriteIo(pgFileWrite), .limit = file->limit);
                         ioWriteClose(storageWriteIo(pgFileWrite));
 
-                        // Get checksum result
-                        checksum = pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE));
+                        // Get checksum result. When the file was copied directly the data was never seen so the repo checksum is
+                        // used and only the size is checked. The repo file was checksummed when it was written and can be checked
+                        // with the verify command. If the direct copy was not possible after all then the checksum is calculated
+                        // from the restored file, like a block incremental file.
+                        if (repoFileDirect)
+                        {
+                            const uint64_t size = storageInfoP(storagePg(), file->name, .followLink = true).size;
+
+                            if (size != file->size)
+                            {
+                                THROW_FMT(
+                                    FileReadError,
+                                    "error restoring '%s': actual size %" PRIu64 " does not match expected size %" PRIu64,
+                                    strZ(file->name), size, file->size);
+                            }
+
+                            checksum = file->checksum;
+                        }
+                        else if (copyDirect)
+                            checksum = restoreFilePgChecksum(file->name);
+                        else
+                            checksum = pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE));
                     }
 
                     // If more than one file is being copied from a single read then decrement the limit
@@ -414,13 +537,8 @@ restoreFile(
                         storageReadFree(repoFileRead);
 
                     // Validate checksum
-                    if (!bufEq(file->checksum, checksum))
-                    {
-                        THROW_FMT(
-                            ChecksumError,
-                            "error restoring '%s': actual checksum '%s' does not match expected checksum '%s'", strZ(file->name),
-                            strZ(strNewEncode(encodingHex, checksum)), strZ(strNewEncode(encodingHex, file->checksum)));
-                    }
+                    if (file->partTotal == 0)
+                        restoreFileChecksumValidate(file, checksum);
                 }
             }
             MEM_CONTEXT_TEMP_END();
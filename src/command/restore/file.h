@@ -5,6 +5,7 @@ Restore File
 #define COMMAND_RESTORE_FILE_H
 
 #include "common/compress/helper.h"
+#include "common/crypto/common.h"
 #include "common/type/variant.h"
 
 /***********************************************************************************************************************************
@@ -36,6 +37,9 @@ typedef struct RestoreFile
     uint64_t blockIncrMapSize;                                      // Block incremental map size (0 if not incremental)
     size_t blockIncrSize;                                           // Block incremental size (when map size > 0)
     size_t blockIncrChecksumSize;                                   // Checksum size (when map size > 0)
+    unsigned int partIdx;                                           // Part to restore (when part total > 0)
+    unsigned int partTotal;                                         // Total parts when restored by separate jobs (0 if not split)
+    bool partVerify;                                                // Verify the file after all parts have been restored
     const String *manifestFile;                                     // Manifest file
     const Buffer *blockChecksum;                                    // Checksums for block incremental restore, set in restoreFile()
 } RestoreFile;
@@ -49,6 +53,7 @@ typedef struct RestoreFileResult
 
 FN_EXTERN List *restoreFile(
     const String *repoFile, unsigned int repoIdx, CompressType repoFileCompressType, time_t copyTimeBegin, bool delta,
-    bool deltaForce, bool bundleRaw, const String *cipherPass, const StringList *referenceList, List *fileList);
+    bool deltaForce, bool bundleRaw, CipherType cipherType, const String *cipherPass, const StringList *referenceList,
+    List *fileList);
 
 #endif
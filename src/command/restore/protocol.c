@@ -34,6 +34,7 @@ restoreFileProtocol(PackRead *const param, ProtocolServer *const server)
         const bool delta = pckReadBoolP(param);
         const bool deltaForce = pckReadBoolP(param);
         const bool bundleRaw = pckReadBoolP(param);
+        const CipherType cipherType = (CipherType)pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
         const StringList *const referenceList = pckReadStrLstP(param);
 
@@ -64,6 +65,9 @@ restoreFileProtocol(PackRead *const param, ProtocolServer *const server)
             {
                 file.blockIncrSize = (size_t)pckReadU64P(param);
                 file.blockIncrChecksumSize = (size_t)pckReadU64P(param);
+                file.partIdx = pckReadU32P(param);
+                file.partTotal = pckReadU32P(param);
+                file.partVerify = pckReadBoolP(param);
             }
 
             file.manifestFile = pckReadStrP(param);
@@ -73,8 +77,8 @@ restoreFileProtocol(PackRead *const param, ProtocolServer *const server)
 
         // Restore files
         const List *const result = restoreFile(
-            repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, cipherPass, referenceList,
-            fileList);
+            repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, cipherType, cipherPass,
+            referenceList, fileList);
 
         // Return result
         PackWrite *const resultPack = protocolPackNew();
@@ -197,7 +197,7 @@ Get the backup set to restore
 typedef struct RestoreBackupData
 {
     unsigned int repoIdx;                                           // Internal repo index
-    CipherType repoCipherType;                                      // Repo encryption type (0 = none)
+    CipherType backupCipherType;                                    // Cipher type of backup files if repo is encrypted (else none)
     const String *backupCipherPass;                                 // Passphrase of backup files if repo is encrypted (else NULL)
     const String *backupSet;                                        // Backup set to restore
 } RestoreBackupData;
@@ -209,7 +209,9 @@ typedef struct RestoreBackupData
 
 // Helper function for restoreBackupSet
 static RestoreBackupData
-restoreBackupData(const String *const backupLabel, const unsigned int repoIdx, const String *const backupCipherPass)
+restoreBackupData(
+    const String *const backupLabel, const unsigned int repoIdx, const CipherType backupCipherType,
+    const String *const backupCipherPass)
 {
     ASSERT(backupLabel != NULL);
 
@@ -219,7 +221,7 @@ restoreBackupData(const String *const backupLabel, const unsigned int repoIdx, c
     {
         restoreBackup.backupSet = strDup(backupLabel);
         restoreBackup.repoIdx = repoIdx;
-        restoreBackup.repoCipherType = cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx);
+        restoreBackup.backupCipherType = backupCipherType;
         restoreBackup.backupCipherPass = strDup(backupCipherPass);
     }
     MEM_CONTEXT_PRIOR_END();
@@ -338,7 +340,9 @@ restoreBackupSet(void)
                         {
                             found = true;
 
-                            result = restoreBackupData(backupData.backupLabel, repoIdx, infoPgCipherPass(infoBackupPg(infoBackup)));
+                            result = restoreBackupData(
+                                backupData.backupLabel, repoIdx, infoBackupCipherType(infoBackup),
+                                infoBackupCipherPass(infoBackup));
                             break;
                         }
                     }
@@ -365,7 +369,8 @@ restoreBackupSet(void)
                             strZ(latestBackup.backupLabel));
                     }
 
-                    result = restoreBackupData(latestBackup.backupLabel, repoIdx, infoPgCipherPass(infoBackupPg(infoBackup)));
+                    result = restoreBackupData(
+                        latestBackup.backupLabel, repoIdx, infoBackupCipherType(infoBackup), infoBackupCipherPass(infoBackup));
                     break;
                 }
             }
@@ -376,7 +381,8 @@ restoreBackupSet(void)
                 {
                     if (strEq(infoBackupData(infoBackup, backupIdx).backupLabel, backupSetRequested))
                     {
-                        result = restoreBackupData(backupSetRequested, repoIdx, infoPgCipherPass(infoBackupPg(infoBackup)));
+                        result = restoreBackupData(
+                            backupSetRequested, repoIdx, infoBackupCipherType(infoBackup), infoBackupCipherPass(infoBackup));
                         break;
                     }
                 }
@@ -2175,6 +2181,10 @@ restoreJobResult(
                 const RestoreResult result = (RestoreResult)pckReadU32P(jobResult);
                 const uint64_t blockIncrDeltaSize = pckReadU64P(jobResult);
 
+                // If this is a part of a split file then skip it. Progress and logging will be handled when the file is verified.
+                if (varType(protocolParallelJobKey(job)) == varTypeUInt)
+                    continue;
+
                 String *const log = strCatZ(strNew(), "restore");
 
                 // Note if file was zeroed (i.e. selective restore)
@@ -2268,11 +2278,27 @@ typedef struct RestoreJobData
     Manifest *manifest;                                             // Backup manifest
     List *queueList;                                                // List of processing queues
     RegExp *zeroExp;                                                // Identify files that should be sparse zeroed
+    CipherType cipherType;                                          // Cipher type used to encrypt files in the backup
     const String *cipherSubPass;                                    // Passphrase used to decrypt files in the backup
     const String *rootReplaceUser;                                  // User to replace invalid users when root
     const String *rootReplaceGroup;                                 // Group to replace invalid group when root
+    uint64_t splitSize;                                             // Split files larger than this into parts (0 if no split)
+    List *splitList;                                                // List of files split into parts
+    bool splitVerify;                                               // Only verify split files since all other jobs are complete
 } RestoreJobData;
 
+/***********************************************************************************************************************************
+Large block incremental files may be split into parts that are restored in parallel and then verified. Each part restores a range of
+blocks so the super blocks for each part are fetched from the repository with separate ranged reads.
+***********************************************************************************************************************************/
+typedef struct RestoreJobSplit
+{
+    const String *name;                                             // File name (must be first member in struct)
+    unsigned int partNext;                                          // Next part to be restored
+    unsigned int partTotal;                                         // Total parts
+    bool verify;                                                    // Has the verify job been started?
+} RestoreJobSplit;
+
 // Helper to calculate the next queue to scan based on the client index
 static int
 restoreJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned int queueTotal)
@@ -2295,6 +2321,198 @@ restoreJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned i
     FUNCTION_TEST_RETURN(INT, queueIdx);
 }
 
+// Helper to add parameters that are common to all files in a restore job
+static void
+restoreJobParamCommon(PackWrite *const param, const RestoreJobData *const jobData, const ManifestFile *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, param);
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(param != NULL);
+    ASSERT(jobData != NULL);
+    ASSERT(file != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        pckWriteStrP(
+            param,
+            backupFileRepoPathP(
+                file->reference != NULL ? file->reference : manifestData(jobData->manifest)->backupLabel,
+                .manifestName = file->name, .bundleId = file->bundleId,
+                .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
+                .blockIncr = file->blockIncrMapSize != 0));
+        pckWriteU32P(param, jobData->repoIdx);
+        pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
+        pckWriteTimeP(param, manifestData(jobData->manifest)->backupTimestampCopyStart);
+        pckWriteBoolP(param, cfgOptionBool(cfgOptDelta));
+        pckWriteBoolP(param, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
+        pckWriteBoolP(param, file->bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
+        pckWriteU64P(param, jobData->cipherType);
+        pckWriteStrP(param, jobData->cipherSubPass);
+        pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to add file parameters to a restore job
+static void
+restoreJobParamFile(
+    PackWrite *const param, const RestoreJobData *const jobData, const ManifestFile *const file, const unsigned int partIdx,
+    const unsigned int partTotal, const bool partVerify)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, param);
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+        FUNCTION_TEST_PARAM(UINT, partIdx);
+        FUNCTION_TEST_PARAM(UINT, partTotal);
+        FUNCTION_TEST_PARAM(BOOL, partVerify);
+    FUNCTION_TEST_END();
+
+    ASSERT(param != NULL);
+    ASSERT(jobData != NULL);
+    ASSERT(file != NULL);
+    ASSERT(partTotal == 0 || file->blockIncrMapSize != 0);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        pckWriteStrP(param, restoreFilePgPath(jobData->manifest, file->name));
+        pckWriteBinP(param, BUF(file->checksumSha1, HASH_TYPE_SHA1_SIZE));
+        pckWriteU64P(param, file->size);
+        pckWriteTimeP(param, file->timestamp);
+        pckWriteModeP(param, file->mode);
+        pckWriteBoolP(param, restoreFileZeroed(file->name, jobData->zeroExp));
+        pckWriteStrP(param, restoreManifestOwnerReplace(file->user, jobData->rootReplaceUser));
+        pckWriteStrP(param, restoreManifestOwnerReplace(file->group, jobData->rootReplaceGroup));
+
+        // If block incremental then modify offset and size to where the map is stored since we need to read that first.
+        if (file->blockIncrMapSize != 0)
+        {
+            pckWriteBoolP(param, true);
+            pckWriteU64P(param, file->bundleOffset + file->sizeRepo - file->blockIncrMapSize);
+            pckWriteU64P(param, file->blockIncrMapSize);
+        }
+        // Else write bundle offset/size
+        else if (file->bundleId != 0)
+        {
+            pckWriteBoolP(param, true);
+            pckWriteU64P(param, file->bundleOffset);
+            pckWriteU64P(param, file->sizeRepo);
+        }
+        // Else restore as a whole file
+        else
+            pckWriteBoolP(param, false);
+
+        // Block incremental
+        pckWriteU64P(param, file->blockIncrMapSize);
+
+        if (file->blockIncrMapSize != 0)
+        {
+            pckWriteU64P(param, file->blockIncrSize);
+            pckWriteU64P(param, file->blockIncrChecksumSize);
+            pckWriteU32P(param, partIdx);
+            pckWriteU32P(param, partTotal);
+            pckWriteBoolP(param, partVerify);
+        }
+
+        pckWriteStrP(param, file->name);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to split a block incremental file into parts when it is large enough. Bundled and zeroed files are never split.
+static bool
+restoreJobSplitAdd(RestoreJobData *const jobData, const ManifestFile *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(file != NULL);
+
+    bool result = false;
+
+    if (jobData->splitSize != 0 && file->blockIncrMapSize != 0 && file->bundleId == 0 && file->size > jobData->splitSize &&
+        !restoreFileZeroed(file->name, jobData->zeroExp))
+    {
+        MEM_CONTEXT_BEGIN(lstMemContext(jobData->splitList))
+        {
+            lstAdd(
+                jobData->splitList,
+                &(RestoreJobSplit)
+                {
+                    .name = strDup(file->name),
+                    .partTotal = (unsigned int)((file->size + jobData->splitSize - 1) / jobData->splitSize),
+                });
+        }
+        MEM_CONTEXT_END();
+
+        result = true;
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+// Helper to get the next job for split files. Parts are restored while other files are being processed and then the files are
+// verified in a second pass when all other jobs are complete.
+static ProtocolParallelJob *
+restoreJobSplitNext(RestoreJobData *const jobData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+
+    ProtocolParallelJob *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        for (unsigned int splitIdx = 0; splitIdx < lstSize(jobData->splitList); splitIdx++)
+        {
+            RestoreJobSplit *const split = lstGet(jobData->splitList, splitIdx);
+
+            // Verify the file when all parts have been restored or else restore the next part
+            if (jobData->splitVerify ? !split->verify : split->partNext < split->partTotal)
+            {
+                const ManifestFile file = manifestFileFind(jobData->manifest, split->name);
+                ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_RESTORE_FILE);
+                PackWrite *const param = protocolCommandParam(command);
+
+                restoreJobParamCommon(param, jobData, &file);
+                restoreJobParamFile(
+                    param, jobData, &file, jobData->splitVerify ? 0 : split->partNext, split->partTotal, jobData->splitVerify);
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = protocolParallelJobNew(
+                        jobData->splitVerify ? VARSTR(split->name) : VARUINT(split->partNext), command);
+                }
+                MEM_CONTEXT_PRIOR_END();
+
+                if (jobData->splitVerify)
+                    split->verify = true;
+                else
+                    split->partNext++;
+
+                break;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
 // Callback to fetch restore jobs for the parallel executor
 static ProtocolParallelJob *
 restoreJobCallback(void *const data, const unsigned int clientIdx)
@@ -2306,13 +2524,18 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
 
     ASSERT(data != NULL);
 
-    ProtocolParallelJob *result = NULL;
+    // Restore parts before starting on new files or verify split files when all other jobs are complete
+    RestoreJobData *const jobData = data;
+    ProtocolParallelJob *result = restoreJobSplitNext(jobData);
+
+    if (result != NULL || jobData->splitVerify)
+        FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+
+    // Get a new job if there are any left
+    bool split = false;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get a new job if there are any left
-        RestoreJobData *const jobData = data;
-
         // Determine where to begin scanning the queue (we'll stop when we get back here)
         ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_RESTORE_FILE);
         PackWrite *param = NULL;
@@ -2336,6 +2559,14 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
                 if (fileAdded && (bundleId != file.bundleId || !strEq(reference, file.reference)))
                     break;
 
+                // Split large block incremental files into parts that can be restored in parallel
+                if (param == NULL && restoreJobSplitAdd(jobData, &file))
+                {
+                    lstRemoveIdx(queue, 0);
+                    split = true;
+                    break;
+                }
+
                 // Add common parameters before first file
                 if (param == NULL)
                 {
@@ -2349,62 +2580,12 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
                     else
                         fileName = file.name;
 
-                    pckWriteStrP(
-                        param,
-                        backupFileRepoPathP(
-                            file.reference != NULL ? file.reference : manifestData(jobData->manifest)->backupLabel,
-                            .manifestName = file.name, .bundleId = file.bundleId,
-                            .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
-                            .blockIncr = file.blockIncrMapSize != 0));
-                    pckWriteU32P(param, jobData->repoIdx);
-                    pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
-                    pckWriteTimeP(param, manifestData(jobData->manifest)->backupTimestampCopyStart);
-                    pckWriteBoolP(param, cfgOptionBool(cfgOptDelta));
-                    pckWriteBoolP(param, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
-                    pckWriteBoolP(param, file.bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
-                    pckWriteStrP(param, jobData->cipherSubPass);
-                    pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
+                    restoreJobParamCommon(param, jobData, &file);
 
                     fileAdded = true;
                 }
 
-                pckWriteStrP(param, restoreFilePgPath(jobData->manifest, file.name));
-                pckWriteBinP(param, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE));
-                pckWriteU64P(param, file.size);
-                pckWriteTimeP(param, file.timestamp);
-                pckWriteModeP(param, file.mode);
-                pckWriteBoolP(param, restoreFileZeroed(file.name, jobData->zeroExp));
-                pckWriteStrP(param, restoreManifestOwnerReplace(file.user, jobData->rootReplaceUser));
-                pckWriteStrP(param, restoreManifestOwnerReplace(file.group, jobData->rootReplaceGroup));
-
-                // If block incremental then modify offset and size to where the map is stored since we need to read that first.
-                if (file.blockIncrMapSize != 0)
-                {
-                    pckWriteBoolP(param, true);
-                    pckWriteU64P(param, file.bundleOffset + file.sizeRepo - file.blockIncrMapSize);
-                    pckWriteU64P(param, file.blockIncrMapSize);
-                }
-                // Else write bundle offset/size
-                else if (file.bundleId != 0)
-                {
-                    pckWriteBoolP(param, true);
-                    pckWriteU64P(param, file.bundleOffset);
-                    pckWriteU64P(param, file.sizeRepo);
-                }
-                // Else restore as a whole file
-                else
-                    pckWriteBoolP(param, false);
-
-                // Block incremental
-                pckWriteU64P(param, file.blockIncrMapSize);
-
-                if (file.blockIncrMapSize != 0)
-                {
-                    pckWriteU64P(param, file.blockIncrSize);
-                    pckWriteU64P(param, file.blockIncrChecksumSize);
-                }
-
-                pckWriteStrP(param, file.name);
+                restoreJobParamFile(param, jobData, &file, 0, 0, false);
 
                 // Remove job from the queue
                 lstRemoveIdx(queue, 0);
@@ -2426,12 +2607,20 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
                 break;
             }
 
+            // Stop when a file has been split so the first part can be restored
+            if (split)
+                break;
+
             queueIdx = restoreJobQueueNext(clientIdx, queueIdx, lstSize(jobData->queueList));
         }
         while (queueIdx != queueEnd);
     }
     MEM_CONTEXT_TEMP_END();
 
+    // Restore the first part of a file that was split
+    if (split)
+        result = restoreJobSplitNext(jobData);
+
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
@@ -2461,11 +2650,23 @@ cmdRestore(void)
         const RestoreBackupData backupData = restoreBackupSet();
 
         // Load manifest
-        RestoreJobData jobData = {.repoIdx = backupData.repoIdx};
+        RestoreJobData jobData =
+        {
+            .repoIdx = backupData.repoIdx,
+            .splitList = lstNewP(sizeof(RestoreJobSplit), .comparator = lstComparatorStr),
+        };
+
+        // Split large block incremental files into parts when there is more than one process. Delta restores are not split
+        // because the existing file must be compared to the block map as a whole.
+        if (cfgOptionIdxTest(cfgOptRepoBlockSplitSize, backupData.repoIdx) && cfgOptionUInt(cfgOptProcessMax) > 1 &&
+            !cfgOptionBool(cfgOptDelta))
+        {
+            jobData.splitSize = cfgOptionIdxUInt64(cfgOptRepoBlockSplitSize, backupData.repoIdx);
+        }
 
         jobData.manifest = manifestLoadFile(
             storageRepoIdx(backupData.repoIdx),
-            strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupData.backupSet)), backupData.repoCipherType,
+            strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupData.backupSet)), backupData.backupCipherType,
             backupData.backupCipherPass);
 
         // Remotes (if any) are no longer needed since the rest of the repository reads will be done by the local processes
@@ -2481,8 +2682,9 @@ cmdRestore(void)
         // Validate manifest. Don't use strict mode because we'd rather ignore problems that won't affect a restore.
         manifestValidate(jobData.manifest, false);
 
-        // Get the cipher subpass used to decrypt files in the backup
+        // Get the cipher subpass and type used to decrypt files in the backup
         jobData.cipherSubPass = manifestCipherSubPass(jobData.manifest);
+        jobData.cipherType = manifestCipherSubType(jobData.manifest);
 
         // Validate the manifest
         restoreManifestValidate(jobData.manifest, backupData.backupSet);
@@ -2526,34 +2728,41 @@ cmdRestore(void)
         // Save manifest to the data directory so we can restart a delta restore even if the PG_VERSION file is missing
         manifestSave(jobData.manifest, storageWriteIo(storageNewWriteP(storagePgWrite(), BACKUP_MANIFEST_FILE_STR)));
 
-        // Create the parallel executor
-        ProtocolParallel *const parallelExec = protocolParallelNew(
-            cfgOptionUInt64(cfgOptProtocolTimeout) / 2, restoreJobCallback, &jobData);
-
-        for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-            protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
-
-        // Process jobs
+        // Process jobs. Split files are verified in a second pass after all parts have been restored.
         uint64_t sizeRestored = 0;
 
-        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        do
         {
-            do
-            {
-                const unsigned int completed = protocolParallelProcess(parallelExec);
+            // Create the parallel executor
+            ProtocolParallel *const parallelExec = protocolParallelNewP(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, restoreJobCallback, &jobData);
+
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
-                for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
                 {
-                    sizeRestored = restoreJobResult(
-                        jobData.manifest, protocolParallelResult(parallelExec), jobData.zeroExp, sizeTotal, sizeRestored);
-                }
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        sizeRestored = restoreJobResult(
+                            jobData.manifest, protocolParallelResult(parallelExec), jobData.zeroExp, sizeTotal, sizeRestored);
+                    }
 
-                // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                MEM_CONTEXT_TEMP_RESET(1000);
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+                while (!protocolParallelDone(parallelExec));
             }
-            while (!protocolParallelDone(parallelExec));
+            MEM_CONTEXT_TEMP_END();
+
+            // Verify split files if this was the first pass
+            jobData.splitVerify = !jobData.splitVerify && !lstEmpty(jobData.splitList);
         }
-        MEM_CONTEXT_TEMP_END();
+        while (jobData.splitVerify);
 
         // Write recovery settings. Use the data directory to set permissions and ownership for recovery files.
         StorageInfo fileInfo = storageInfoP(storagePg(), NULL);
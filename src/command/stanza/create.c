@@ -77,9 +77,13 @@ cmdStanzaCreate(void)
                 // If the repo is encrypted, generate a cipher passphrase for encrypting subsequent archive files
                 const String *cipherPassSub = cipherPassGen(cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx));
 
-                // Create and save archive info
+                // Create and save archive info. The cipher type is stored with the passphrase so files encrypted with the
+                // passphrase are always decrypted with the same cipher.
                 infoArchive = infoArchiveNew(pgControl.version, pgControl.systemId, cipherPassSub);
 
+                if (cipherPassSub != NULL)
+                    infoCipherTypeSet(infoPgInfo(infoArchivePg(infoArchive)), cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx));
+
                 infoArchiveSaveFile(
                     infoArchive, storageRepoWriteStanza, INFO_ARCHIVE_PATH_FILE_STR,
                     cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx), cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
@@ -90,6 +94,9 @@ cmdStanzaCreate(void)
                 // Create and save backup info
                 infoBackup = infoBackupNew(pgControl.version, pgControl.systemId, pgControl.catalogVersion, cipherPassSub);
 
+                if (cipherPassSub != NULL)
+                    infoCipherTypeSet(infoPgInfo(infoBackupPg(infoBackup)), cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx));
+
                 infoBackupSaveFile(
                     infoBackup, storageRepoWriteStanza, INFO_BACKUP_PATH_FILE_STR,
                     cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx), cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
@@ -3,6 +3,8 @@ Verify File
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "command/backup/blockMap.h"
+#include "command/backup/common.h"
 #include "command/verify/file.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
@@ -14,11 +16,114 @@ Verify File
 #include "common/log.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Verify the blocks referenced by a block incremental map. Blocks in the block store must exist with the size recorded in the map.
+Blocks in a backup must be contained by the referenced repo file, which may be a bundle, e.g. the bundle for a range of a split
+file. The contents of the referenced blocks are not read since they are verified with the files that contain them.
+***********************************************************************************************************************************/
+typedef struct VerifyFileBlockIncrFile
+{
+    const String *name;                                             // Referenced repo file
+    uint64_t size;                                                  // Minimum size required to contain all referenced blocks
+} VerifyFileBlockIncrFile;
+
+static VerifyResult
+verifyFileBlockIncr(const String *const filePathName, const VerifyFileBlockIncr *const blockIncr)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, filePathName);
+        FUNCTION_LOG_PARAM(STRING, blockIncr->manifestName);
+        FUNCTION_LOG_PARAM(STRING_LIST, blockIncr->referenceList);
+        FUNCTION_LOG_PARAM(UINT64, blockIncr->mapOffset);
+        FUNCTION_LOG_PARAM(UINT64, blockIncr->mapSize);
+        FUNCTION_LOG_PARAM(SIZE, blockIncr->blockSize);
+        FUNCTION_LOG_PARAM(SIZE, blockIncr->checksumSize);
+        FUNCTION_LOG_PARAM(ENUM, blockIncr->compressType);
+        FUNCTION_LOG_PARAM(STRING_ID, blockIncr->cipherType);
+        FUNCTION_TEST_PARAM(STRING, blockIncr->cipherPass);
+    FUNCTION_LOG_END();
+
+    ASSERT(filePathName != NULL);
+    ASSERT(blockIncr->manifestName != NULL);
+    ASSERT(blockIncr->referenceList != NULL);
+
+    VerifyResult result = verifyOk;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read the block map
+        IoRead *const read = storageReadIo(
+            storageNewReadP(
+                storageRepo(), filePathName, .offset = blockIncr->mapOffset, .limit = VARUINT64(blockIncr->mapSize)));
+
+        if (blockIncr->cipherPass != NULL)
+        {
+            ioFilterGroupAdd(
+                ioReadFilterGroup(read),
+                cipherBlockNewP(cipherModeDecrypt, blockIncr->cipherType, BUFSTR(blockIncr->cipherPass), .raw = true));
+        }
+
+        ioReadOpen(read);
+
+        const BlockMap *const blockMap = blockMapNewRead(read, blockIncr->blockSize, blockIncr->checksumSize);
+        List *const fileList = lstNewP(sizeof(VerifyFileBlockIncrFile), .comparator = lstComparatorStr);
+
+        for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+        {
+            const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+
+            // Check that the block is in the block store with the expected size
+            if (blockMapItem->reference == BLOCK_MAP_REFERENCE_STORE)
+            {
+                const uint64_t size = backupBlockStoreFind(storageRepo(), blockMapItem->checksum, blockIncr->compressType);
+
+                if (size != blockMapItem->size)
+                {
+                    result = size == 0 ? verifyFileMissing : verifySizeInvalid;
+                    break;
+                }
+            }
+            // Else track the size required for the referenced file
+            else
+            {
+                ASSERT(blockMapItem->reference < strLstSize(blockIncr->referenceList));
+
+                const String *const name = backupFileRepoPathP(
+                    strLstGet(blockIncr->referenceList, blockMapItem->reference), .manifestName = blockIncr->manifestName,
+                    .bundleId = blockMapItem->bundleId, .blockIncr = true);
+                VerifyFileBlockIncrFile *file = lstFind(fileList, &name);
+
+                if (file == NULL)
+                    file = lstAdd(fileList, &(VerifyFileBlockIncrFile){.name = name});
+
+                if (blockMapItem->offset + blockMapItem->size > file->size)
+                    file->size = blockMapItem->offset + blockMapItem->size;
+            }
+        }
+
+        // Check that the referenced files exist and are large enough to contain the referenced blocks
+        for (unsigned int fileIdx = 0; result == verifyOk && fileIdx < lstSize(fileList); fileIdx++)
+        {
+            const VerifyFileBlockIncrFile *const file = lstGet(fileList, fileIdx);
+            const StorageInfo info = storageInfoP(storageRepo(), file->name, .ignoreMissing = true);
+
+            if (!info.exists)
+                result = verifyFileMissing;
+            else if (info.size < file->size)
+                result = verifySizeInvalid;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_STRUCT(result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN VerifyResult
 verifyFile(
     const String *const filePathName, const uint64_t offset, const Variant *const limit, const CompressType compressType,
-    const Buffer *const fileChecksum, const uint64_t fileSize, const String *const cipherPass)
+    const Buffer *const fileChecksum, const uint64_t fileSize, const CipherType cipherType, const String *const cipherPass,
+    const VerifyFileBlockIncr *const blockIncr)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, filePathName);                   // Fully qualified file name
@@ -27,12 +132,15 @@ verifyFile(
         FUNCTION_LOG_PARAM(ENUM, compressType);                     // Compression type
         FUNCTION_LOG_PARAM(BUFFER, fileChecksum);                   // Checksum for the file
         FUNCTION_LOG_PARAM(UINT64, fileSize);                       // Size of file
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Cipher type used to encrypt the repo file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
+        FUNCTION_TEST_PARAM_P(VOID, blockIncr);                     // Block incremental map to verify (if any)
     FUNCTION_LOG_END();
 
     ASSERT(filePathName != NULL);
     ASSERT(fileChecksum != NULL);
     ASSERT(limit == NULL || varType(limit) == varTypeUInt64);
+    ASSERT(cipherPass == NULL || cipherType != cipherTypeNone);
 
     // Is the file valid?
     VerifyResult result = verifyOk;
@@ -46,7 +154,7 @@ verifyFile(
 
         // Add decryption filter
         if (cipherPass != NULL)
-            ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass)));
+            ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass)));
 
         // Add decompression filter
         if (compressType != compressTypeNone)
@@ -72,6 +180,9 @@ verifyFile(
             // If the size can be checked, do so
             else if (fileSize != pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(read), SIZE_FILTER_TYPE)))
                 result = verifySizeInvalid;
+            // Else verify the blocks referenced by the block incremental map
+            else if (blockIncr != NULL)
+                result = verifyFileBlockIncr(filePathName, blockIncr);
         }
         else
             result = verifyFileMissing;
@@ -6,6 +6,7 @@ Verify File
 
 #include "common/compress/helper.h"
 #include "common/crypto/common.h"
+#include "common/type/stringList.h"
 
 /***********************************************************************************************************************************
 File result
@@ -19,12 +20,28 @@ typedef enum
     verifyOtherError,
 } VerifyResult;
 
+/***********************************************************************************************************************************
+Block incremental map to verify. The blocks referenced by the map are checked after the file has been verified.
+***********************************************************************************************************************************/
+typedef struct VerifyFileBlockIncr
+{
+    const String *manifestName;                                     // File name in the manifest
+    const StringList *referenceList;                                // Backup references used by the map
+    uint64_t mapOffset;                                             // Offset of the map in the repo file
+    uint64_t mapSize;                                               // Size of the map
+    size_t blockSize;                                               // Block size
+    size_t checksumSize;                                            // Block checksum size
+    CompressType compressType;                                      // Compress type of the backup
+    CipherType cipherType;                                          // Cipher type used to encrypt the map
+    const String *cipherPass;                                       // Password to decrypt the map
+} VerifyFileBlockIncr;
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 // Verify a file in the pgBackRest repository
 FN_EXTERN VerifyResult verifyFile(
     const String *filePathName, uint64_t offset, const Variant *limit, CompressType compressType, const Buffer *fileChecksum,
-    uint64_t fileSize, const String *cipherPass);
+    uint64_t fileSize, CipherType cipherType, const String *cipherPass, const VerifyFileBlockIncr *blockIncr);
 
 #endif
@@ -41,9 +41,28 @@ verifyFileProtocol(PackRead *const param, ProtocolServer *const server)
         const CompressType compressType = (CompressType)pckReadU32P(param);
         const Buffer *const fileChecksum = pckReadBinP(param);
         const uint64_t fileSize = pckReadU64P(param);
+        const CipherType cipherType = (CipherType)pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
 
-        const VerifyResult result = verifyFile(filePathName, offset, limit, compressType, fileChecksum, fileSize, cipherPass);
+        // Block incremental map
+        VerifyFileBlockIncr blockIncr = {0};
+
+        if (pckReadBoolP(param))
+        {
+            blockIncr.manifestName = pckReadStrP(param);
+            blockIncr.referenceList = pckReadStrLstP(param);
+            blockIncr.mapOffset = pckReadU64P(param);
+            blockIncr.mapSize = pckReadU64P(param);
+            blockIncr.blockSize = (size_t)pckReadU64P(param);
+            blockIncr.checksumSize = (size_t)pckReadU64P(param);
+            blockIncr.compressType = (CompressType)pckReadU32P(param);
+            blockIncr.cipherType = (CipherType)pckReadU64P(param);
+            blockIncr.cipherPass = pckReadStrP(param);
+        }
+
+        const VerifyResult result = verifyFile(
+            filePathName, offset, limit, compressType, fileChecksum, fileSize, cipherType, cipherPass,
+            blockIncr.manifestName != NULL ? &blockIncr : NULL);
 
         // Return result
         protocolServerDataPut(server, pckWriteU32P(protocolPackNew(), result));
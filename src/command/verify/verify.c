@@ -116,14 +116,18 @@ typedef struct VerifyJobData
     StringList *archiveIdList;                                      // List of archive ids to verify
     StringList *walPathList;                                        // WAL path list for a single archive id
     StringList *walFileList;                                        // WAL file list for a single WAL path
+    List *walBundleList;                                            // Bundled WAL file list for a single WAL path
     StringList *backupList;                                         // List of backups to verify
     Manifest *manifest;                                             // Manifest contents with list of files to verify
     unsigned int manifestFileIdx;                                   // Index of the file within the manifest file list to process
     String *currentBackup;                                          // In progress backup, if any
     const InfoPg *pgHistory;                                        // Database history list
     bool backupProcessing;                                          // Are we processing WAL or are we processing backups
+    CipherType manifestCipherType;                                  // Cipher type for reading backup manifests
     const String *manifestCipherPass;                               // Cipher pass for reading backup manifests
+    CipherType walCipherType;                                       // Cipher type for reading WAL files
     const String *walCipherPass;                                    // Cipher pass for reading WAL files
+    CipherType backupCipherType;                                    // Cipher type for reading backup files referenced in a manifest
     const String *backupCipherPass;                                 // Cipher pass for reading backup files referenced in a manifest
     unsigned int jobErrorTotal;                                     // Total errors that occurred during the job execution
     List *archiveIdResultList;                                      // Archive results
@@ -164,28 +168,33 @@ verifyInvalidFileAdd(List *const invalidFileList, const VerifyResult reason, con
 Load a file into memory
 ***********************************************************************************************************************************/
 static StorageRead *
-verifyFileLoad(const String *const pathFileName, const String *const cipherPass)
+verifyFileLoad(
+    const String *const pathFileName, const uint64_t offset, const Variant *const limit, const CompressType compressType,
+    const CipherType cipherType, const String *const cipherPass)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(STRING, pathFileName);                  // Fully qualified path/file name
+        FUNCTION_TEST_PARAM(UINT64, offset);                        // Offset to read in file
+        FUNCTION_TEST_PARAM(VARIANT, limit);                        // Limit to read from file
+        FUNCTION_TEST_PARAM(ENUM, compressType);                    // Compression type
+        FUNCTION_TEST_PARAM(STRING_ID, cipherType);                 // Cipher type used to encrypt the file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to open file if encrypted
     FUNCTION_TEST_END();
 
     ASSERT(pathFileName != NULL);
 
     // Read the file and error if missing
-    StorageRead *const result = storageNewReadP(storageRepo(), pathFileName);
+    StorageRead *const result = storageNewReadP(storageRepo(), pathFileName, .offset = offset, .limit = limit);
 
     // *read points to a location within result so update result with contents based on necessary filters
     IoRead *const read = storageReadIo(result);
 
-    cipherBlockFilterGroupAdd(
-        ioReadFilterGroup(read), cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt, cipherPass);
+    cipherBlockFilterGroupAdd(ioReadFilterGroup(read), cipherType, cipherModeDecrypt, cipherPass);
     ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
 
     // If the file is compressed, add a decompression filter
-    if (compressTypeFromName(pathFileName) != compressTypeNone)
-        ioFilterGroupAdd(ioReadFilterGroup(read), decompressFilterP(compressTypeFromName(pathFileName)));
+    if (compressType != compressTypeNone)
+        ioFilterGroupAdd(ioReadFilterGroup(read), decompressFilterP(compressType));
 
     FUNCTION_TEST_RETURN(STORAGE_READ, result);
 }
@@ -194,11 +203,13 @@ verifyFileLoad(const String *const pathFileName, const String *const cipherPass)
 Get status of info files in the repository
 ***********************************************************************************************************************************/
 static VerifyInfoFile
-verifyInfoFile(const String *const pathFileName, const bool keepFile, const String *const cipherPass)
+verifyInfoFile(
+    const String *const pathFileName, const bool keepFile, const CipherType cipherType, const String *const cipherPass)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, pathFileName);                   // Fully qualified path/file name
         FUNCTION_LOG_PARAM(BOOL, keepFile);                         // Should the file be kept in memory?
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Cipher type used to encrypt the file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to open file if encrypted
     FUNCTION_LOG_END();
 
@@ -212,7 +223,7 @@ verifyInfoFile(const String *const pathFileName, const bool keepFile, const Stri
     {
         TRY_BEGIN()
         {
-            IoRead *const infoRead = storageReadIo(verifyFileLoad(pathFileName, cipherPass));
+            IoRead *const infoRead = storageReadIo(verifyFileLoad(pathFileName, 0, NULL, compressTypeNone, cipherType, cipherPass));
 
             // If directed to keep the loaded file in memory, then move the file into the result, else drain the io and close it
             if (keepFile)
@@ -267,7 +278,7 @@ verifyArchiveInfoFile(void)
     {
         // Get the main info file
         const VerifyInfoFile verifyArchiveInfo = verifyInfoFile(
-            INFO_ARCHIVE_PATH_FILE_STR, true, cfgOptionStrNull(cfgOptRepoCipherPass));
+            INFO_ARCHIVE_PATH_FILE_STR, true, cfgOptionStrId(cfgOptRepoCipherType), cfgOptionStrNull(cfgOptRepoCipherPass));
 
         // If the main file did not error, then report on the copy's status and check checksums
         if (verifyArchiveInfo.errorCode == 0)
@@ -277,7 +288,8 @@ verifyArchiveInfoFile(void)
 
             // Attempt to load the copy and report on it's status but don't keep it in memory
             const VerifyInfoFile verifyArchiveInfoCopy = verifyInfoFile(
-                INFO_ARCHIVE_PATH_FILE_COPY_STR, false, cfgOptionStrNull(cfgOptRepoCipherPass));
+                INFO_ARCHIVE_PATH_FILE_COPY_STR, false, cfgOptionStrId(cfgOptRepoCipherType),
+                cfgOptionStrNull(cfgOptRepoCipherPass));
 
             // If the copy loaded successfully, then check the checksums
             if (verifyArchiveInfoCopy.errorCode == 0)
@@ -292,7 +304,8 @@ verifyArchiveInfoFile(void)
         {
             // Attempt to load the copy
             const VerifyInfoFile verifyArchiveInfoCopy = verifyInfoFile(
-                INFO_ARCHIVE_PATH_FILE_COPY_STR, true, cfgOptionStrNull(cfgOptRepoCipherPass));
+                INFO_ARCHIVE_PATH_FILE_COPY_STR, true, cfgOptionStrId(cfgOptRepoCipherType),
+                cfgOptionStrNull(cfgOptRepoCipherPass));
 
             // If loaded successfully, then return the copy as usable
             if (verifyArchiveInfoCopy.errorCode == 0)
@@ -321,7 +334,7 @@ verifyBackupInfoFile(void)
     {
         // Get the main info file
         const VerifyInfoFile verifyBackupInfo = verifyInfoFile(
-            INFO_BACKUP_PATH_FILE_STR, true, cfgOptionStrNull(cfgOptRepoCipherPass));
+            INFO_BACKUP_PATH_FILE_STR, true, cfgOptionStrId(cfgOptRepoCipherType), cfgOptionStrNull(cfgOptRepoCipherPass));
 
         // If the main file did not error, then report on the copy's status and check checksums
         if (verifyBackupInfo.errorCode == 0)
@@ -331,7 +344,8 @@ verifyBackupInfoFile(void)
 
             // Attempt to load the copy and report on it's status but don't keep it in memory
             const VerifyInfoFile verifyBackupInfoCopy = verifyInfoFile(
-                INFO_BACKUP_PATH_FILE_COPY_STR, false, cfgOptionStrNull(cfgOptRepoCipherPass));
+                INFO_BACKUP_PATH_FILE_COPY_STR, false, cfgOptionStrId(cfgOptRepoCipherType),
+                cfgOptionStrNull(cfgOptRepoCipherPass));
 
             // If the copy loaded successfully, then check the checksums
             if (verifyBackupInfoCopy.errorCode == 0)
@@ -346,7 +360,7 @@ verifyBackupInfoFile(void)
         {
             // Attempt to load the copy
             const VerifyInfoFile verifyBackupInfoCopy = verifyInfoFile(
-                INFO_BACKUP_PATH_FILE_COPY_STR, true, cfgOptionStrNull(cfgOptRepoCipherPass));
+                INFO_BACKUP_PATH_FILE_COPY_STR, true, cfgOptionStrId(cfgOptRepoCipherType), cfgOptionStrNull(cfgOptRepoCipherPass));
 
             // If loaded successfully, then return the copy as usable
             if (verifyBackupInfoCopy.errorCode == 0)
@@ -366,11 +380,12 @@ Get the manifest file
 ***********************************************************************************************************************************/
 static Manifest *
 verifyManifestFile(
-    VerifyBackupResult *const backupResult, const String *const cipherPass, bool currentBackup, const InfoPg *const pgHistory,
-    unsigned int *const jobErrorTotal)
+    VerifyBackupResult *const backupResult, const CipherType cipherType, const String *const cipherPass, bool currentBackup,
+    const InfoPg *const pgHistory, unsigned int *const jobErrorTotal)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_TEST_PARAM_P(VERIFY_BACKUP_RESULT, backupResult);  // The result set for the backup being processed
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Cipher type used to encrypt the manifest file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Passphrase to access the manifest file
         FUNCTION_LOG_PARAM(BOOL, currentBackup);                    // Is this possibly a backup currently in progress?
         FUNCTION_TEST_PARAM(INFO_PG, pgHistory);                    // Database history
@@ -384,7 +399,7 @@ verifyManifestFile(
         const String *const fileName = strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupResult->backupLabel));
 
         // Get the main manifest file
-        const VerifyInfoFile verifyManifestInfo = verifyInfoFile(fileName, true, cipherPass);
+        const VerifyInfoFile verifyManifestInfo = verifyInfoFile(fileName, true, cipherType, cipherPass);
 
         // If the main file did not error, then report on the copy's status and check checksums
         if (verifyManifestInfo.errorCode == 0)
@@ -398,7 +413,7 @@ verifyManifestFile(
 
             // Attempt to load the copy and report on it's status but don't keep it in memory
             const VerifyInfoFile verifyManifestInfoCopy = verifyInfoFile(
-                strNewFmt("%s%s", strZ(fileName), INFO_COPY_EXT), false, cipherPass);
+                strNewFmt("%s%s", strZ(fileName), INFO_COPY_EXT), false, cipherType, cipherPass);
 
             // If the copy loaded successfully, then check the checksums
             if (verifyManifestInfoCopy.errorCode == 0)
@@ -419,7 +434,7 @@ verifyManifestFile(
                 currentBackup = false;
 
                 const VerifyInfoFile verifyManifestInfoCopy = verifyInfoFile(
-                    strNewFmt("%s%s", strZ(fileName), INFO_COPY_EXT), true, cipherPass);
+                    strNewFmt("%s%s", strZ(fileName), INFO_COPY_EXT), true, cipherType, cipherPass);
 
                 // If loaded successfully, then return the copy as usable
                 if (verifyManifestInfoCopy.errorCode == 0)
@@ -711,8 +726,36 @@ verifyArchive(VerifyJobData *const jobData)
 
                         MEM_CONTEXT_BEGIN(jobData->memContext)
                         {
-                            jobData->walFileList = strLstSort(
-                                storageListP(storageRepo(), walFilePath, .expression = WAL_SEGMENT_FILE_REGEXP_STR), sortOrderAsc);
+                            jobData->walFileList = storageListP(
+                                storageRepo(), walFilePath, .expression = WAL_SEGMENT_FILE_BUNDLE_REGEXP_STR);
+
+                            // Add WAL files stored in bundles to the list
+                            const StringList *const indexList = walBundleIndexListSplit(jobData->walFileList);
+
+                            lstFree(jobData->walBundleList);
+                            jobData->walBundleList = lstNewP(sizeof(WalBundleFile), .comparator = lstComparatorStr);
+
+                            for (unsigned int indexIdx = 0; indexIdx < strLstSize(indexList); indexIdx++)
+                            {
+                                const List *fileList;
+
+                                MEM_CONTEXT_OBJ_BEGIN(jobData->walBundleList)
+                                {
+                                    fileList = walBundleIndexLoad(storageRepo(), walFilePath, strLstGet(indexList, indexIdx));
+                                }
+                                MEM_CONTEXT_OBJ_END();
+
+                                for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
+                                {
+                                    const WalBundleFile *const file = lstGet(fileList, fileIdx);
+
+                                    strLstAdd(jobData->walFileList, file->name);
+                                    lstAdd(jobData->walBundleList, file);
+                                }
+                            }
+
+                            strLstSort(jobData->walFileList, sortOrderAsc);
+                            lstSort(jobData->walBundleList, sortOrderAsc);
                         }
                         MEM_CONTEXT_END();
 
@@ -721,11 +764,16 @@ verifyArchive(VerifyJobData *const jobData)
                             if (archiveResult->pgWalInfo.size == 0)
                             {
                                 // Initialize the WAL segment size from the first WAL
+                                const String *const fileName = strLstGet(jobData->walFileList, 0);
+                                const WalBundleFile *const bundleFile = lstFind(jobData->walBundleList, &fileName);
+
                                 StorageRead *const walRead = verifyFileLoad(
                                     strNewFmt(
                                         STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveResult->archiveId), strZ(walPath),
-                                        strZ(strLstGet(jobData->walFileList, 0))),
-                                    jobData->walCipherPass);
+                                        strZ(bundleFile != NULL ? bundleFile->bundle : fileName)),
+                                    bundleFile != NULL ? bundleFile->offset : 0,
+                                    bundleFile != NULL ? VARUINT64(bundleFile->size) : NULL, compressTypeFromName(fileName),
+                                    jobData->walCipherType, jobData->walCipherPass);
 
                                 const PgWal walInfo = pgWalFromBuffer(
                                     storageGetP(walRead, .exactSize = PG_WAL_HEADER_SIZE), cfgOptionStrNull(cfgOptPgVersionForce));
@@ -757,11 +805,30 @@ verifyArchive(VerifyJobData *const jobData)
                         ProtocolCommand *const command = protocolCommandNew(PROTOCOL_COMMAND_VERIFY_FILE);
                         PackWrite *const param = protocolCommandParam(command);
 
-                        pckWriteStrP(param, filePathName);
-                        pckWriteBoolP(param, false);
+                        // If the file is in a bundle then read it from the bundle
+                        const WalBundleFile *const bundleFile = lstFind(jobData->walBundleList, &fileName);
+
+                        if (bundleFile != NULL)
+                        {
+                            pckWriteStrP(
+                                param,
+                                strNewFmt(
+                                    STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveResult->archiveId), strZ(walPath),
+                                    strZ(bundleFile->bundle)));
+                            pckWriteBoolP(param, true);
+                            pckWriteU64P(param, bundleFile->offset);
+                            pckWriteU64P(param, bundleFile->size);
+                        }
+                        else
+                        {
+                            pckWriteStrP(param, filePathName);
+                            pckWriteBoolP(param, false);
+                        }
+
                         pckWriteU32P(param, compressTypeFromName(filePathName));
                         pckWriteBinP(param, checksum);
                         pckWriteU64P(param, archiveResult->pgWalInfo.size);
+                        pckWriteU64P(param, jobData->walCipherType);
                         pckWriteStrP(param, jobData->walCipherPass);
 
                         // Assign job to result, prepending the archiveId to the key for consistency with backup processing
@@ -863,7 +930,8 @@ verifyBackup(VerifyJobData *const jobData)
 
                 // Get a usable backup manifest file
                 Manifest *const manifest = verifyManifestFile(
-                    backupResult, jobData->manifestCipherPass, inProgressBackup, jobData->pgHistory, &jobData->jobErrorTotal);
+                    backupResult, jobData->manifestCipherType, jobData->manifestCipherPass, inProgressBackup, jobData->pgHistory,
+                    &jobData->jobErrorTotal);
 
                 // If a usable backup.manifest file is not found
                 if (manifest == NULL)
@@ -883,7 +951,8 @@ verifyBackup(VerifyJobData *const jobData)
                     // Initialize the jobData
                     MEM_CONTEXT_BEGIN(jobData->memContext)
                     {
-                        // Get the cipher subpass used to decrypt files in the backup and initialize the file list index
+                        // Get the cipher subpass and type used to decrypt files in the backup and initialize the file list index
+                        jobData->backupCipherType = manifestCipherSubType(jobData->manifest);
                         jobData->backupCipherPass = strDup(manifestCipherSubPass(jobData->manifest));
                         jobData->manifestFileIdx = 0;
                     }
@@ -1004,6 +1073,7 @@ verifyBackup(VerifyJobData *const jobData)
                                 pckWriteU32P(param, compressTypeNone);
                                 pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
                                 pckWriteU64P(param, fileData.sizeRepo);
+                                pckWriteU64P(param, cipherTypeNone);
                                 pckWriteStrP(param, NULL);
                             }
                             // Else use the file checksum, which may require additional filters, e.g. decompression
@@ -1012,9 +1082,27 @@ verifyBackup(VerifyJobData *const jobData)
                                 pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
                                 pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
                                 pckWriteU64P(param, fileData.size);
+                                pckWriteU64P(param, jobData->backupCipherType);
                                 pckWriteStrP(param, jobData->backupCipherPass);
                             }
 
+                            // Verify the blocks referenced by the block incremental map
+                            if (fileData.blockIncrMapSize != 0)
+                            {
+                                pckWriteBoolP(param, true);
+                                pckWriteStrP(param, fileData.name);
+                                pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
+                                pckWriteU64P(param, fileData.bundleOffset + fileData.sizeRepo - fileData.blockIncrMapSize);
+                                pckWriteU64P(param, fileData.blockIncrMapSize);
+                                pckWriteU64P(param, fileData.blockIncrSize);
+                                pckWriteU64P(param, fileData.blockIncrChecksumSize);
+                                pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
+                                pckWriteU64P(param, jobData->backupCipherType);
+                                pckWriteStrP(param, jobData->backupCipherPass);
+                            }
+                            else
+                                pckWriteBoolP(param, false);
+
                             // Assign job to result (prepend backup label being processed to the key since some files are in a prior
                             // backup)
                             const String *const jobKey = strNewFmt("%s/%s", strZ(backupResult->backupLabel), strZ(filePathName));
@@ -1529,8 +1617,10 @@ verifyProcess(const bool verboseText)
                 .walPathList = NULL,
                 .walFileList = strLstNew(),
                 .pgHistory = infoArchivePg(archiveInfo),
-                .manifestCipherPass = infoPgCipherPass(infoBackupPg(backupInfo)),
-                .walCipherPass = infoPgCipherPass(infoArchivePg(archiveInfo)),
+                .manifestCipherType = infoBackupCipherType(backupInfo),
+                .manifestCipherPass = infoBackupCipherPass(backupInfo),
+                .walCipherType = infoArchiveCipherType(archiveInfo),
+                .walCipherPass = infoArchiveCipherPass(archiveInfo),
                 .archiveIdResultList = lstNewP(sizeof(VerifyArchiveResult), .comparator = archiveIdComparator),
                 .backupResultList = lstNewP(sizeof(VerifyBackupResult), .comparator = lstComparatorStr),
             };
@@ -1566,7 +1656,7 @@ verifyProcess(const bool verboseText)
                     jobData.backupList, backupInfo, jobData.archiveIdList, jobData.pgHistory, &jobData.jobErrorTotal);
 
                 // Create the parallel executor
-                ProtocolParallel *const parallelExec = protocolParallelNew(
+                ProtocolParallel *const parallelExec = protocolParallelNewP(
                     cfgOptionUInt64(cfgOptProtocolTimeout) / 2, verifyJobCallback, &jobData);
 
                 for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
@@ -157,11 +157,12 @@ bz2CompressInputSame(const THIS_VOID)
 
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-bz2CompressNew(const int level, const bool raw)
+bz2CompressNew(const int level, const bool raw, const unsigned int thread)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
         (void)raw;                                                  // Raw unsupported
+        (void)thread;                                               // Threads unsupported
     FUNCTION_LOG_END();
 
     ASSERT(level >= BZ2_COMPRESS_LEVEL_MIN && level <= BZ2_COMPRESS_LEVEL_MAX);
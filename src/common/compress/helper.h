@@ -42,6 +42,9 @@ Functions
 // Get enum from a compression type string
 FN_EXTERN CompressType compressTypeEnum(StringId type);
 
+// Is the compression type available in this build? Type none is always available.
+FN_EXTERN bool compressTypeAvailable(CompressType type);
+
 // Get string representation of a compression type. This is the extension without the period.
 FN_EXTERN const String *compressTypeStr(CompressType type);
 
@@ -54,6 +57,7 @@ typedef struct CompressFilterParam
 {
     VAR_PARAM_HEADER;
     bool raw;                                                       // Omit headers, checksum, etc. when possible
+    unsigned int thread;                                            // Worker threads when supported (0 = compress in caller)
 } CompressFilterParam;
 
 #define compressFilterP(type, level, ...)                                                                                          \
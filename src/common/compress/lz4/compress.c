@@ -243,11 +243,12 @@ lz4CompressInputSame(const THIS_VOID)
 
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-lz4CompressNew(const int level, const bool raw)
+lz4CompressNew(const int level, const bool raw, const unsigned int thread)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
         FUNCTION_LOG_PARAM(BOOL, raw);
+        (void)thread;                                               // Threads unsupported
     FUNCTION_LOG_END();
 
     ASSERT(level >= LZ4_COMPRESS_LEVEL_MIN && level <= LZ4_COMPRESS_LEVEL_MAX);
@@ -22,6 +22,7 @@ typedef struct ZstCompress
 {
     ZSTD_CStream *context;                                          // Compression context
     int level;                                                      // Compression level
+    unsigned int thread;                                            // Worker threads (0 = compress in caller)
     IoFilter *filter;                                               // Filter interface
 
     bool inputSame;                                                 // Is the same input required on the next process call?
@@ -36,8 +37,8 @@ static void
 zstCompressToLog(const ZstCompress *const this, StringStatic *const debugLog)
 {
     strStcFmt(
-        debugLog, "{level: %d, inputSame: %s, inputOffset: %zu, flushing: %s}", this->level, cvtBoolToConstZ(this->inputSame),
-        this->inputOffset, cvtBoolToConstZ(this->flushing));
+        debugLog, "{level: %d, thread: %u, inputSame: %s, inputOffset: %zu, flushing: %s}", this->level, this->thread,
+        cvtBoolToConstZ(this->inputSame), this->inputOffset, cvtBoolToConstZ(this->flushing));
 }
 
 #define FUNCTION_LOG_ZST_COMPRESS_TYPE                                                                                             \
@@ -109,8 +110,8 @@ zstCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const co
         // If the input buffer was not entirely consumed then set inputSame and store the offset where processing will restart
         if (in.pos < in.size)
         {
-            // Output buffer should be completely full
-            ASSERT(out.pos == out.size);
+            // Output buffer should be completely full unless worker threads are still busy with prior input
+            ASSERT(this->thread != 0 || out.pos == out.size);
 
             this->inputSame = true;
             this->inputOffset += in.pos;
@@ -164,11 +165,12 @@ zstCompressInputSame(const THIS_VOID)
 
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-zstCompressNew(const int level, const bool raw)
+zstCompressNew(const int level, const bool raw, const unsigned int thread)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
         (void)raw;                                                  // Raw unsupported
+        FUNCTION_LOG_PARAM(UINT, thread);
     FUNCTION_LOG_END();
 
     ASSERT(level >= ZST_COMPRESS_LEVEL_MIN && level <= ZST_COMPRESS_LEVEL_MAX);
@@ -179,6 +181,7 @@ zstCompressNew(const int level, const bool raw)
         {
             .context = ZSTD_createCStream(),
             .level = level,
+            .thread = thread,
         };
 
         // Set callback to ensure zst context is freed
@@ -186,6 +189,12 @@ zstCompressNew(const int level, const bool raw)
 
         // Initialize context
         zstError(ZSTD_initCStream(this->context, this->level));
+
+        // Compress with worker threads when requested. The result is ignored because libzstd may have been built without thread
+        // support, in which case compression silently continues in the caller.
+#if ZSTD_VERSION_NUMBER >= 10400
+        (void)ZSTD_CCtx_setParameter(this->context, ZSTD_c_nbWorkers, (int)this->thread);
+#endif
     }
     OBJ_NEW_END();
 
@@ -197,6 +206,8 @@ zstCompressNew(const int level, const bool raw)
         PackWrite *const packWrite = pckWriteNewP();
 
         pckWriteI32P(packWrite, level);
+        pckWriteBoolP(packWrite, raw);
+        pckWriteU32P(packWrite, thread);
         pckWriteEndP(packWrite);
 
         paramList = pckMove(pckWriteResult(packWrite), memContextPrior());
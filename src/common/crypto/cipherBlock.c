@@ -26,6 +26,18 @@ Header constants and sizes
 // Total length of cipher header
 #define CIPHER_BLOCK_HEADER_SIZE                                    (CIPHER_BLOCK_MAGIC_SIZE + PKCS5_SALT_LEN)
 
+/***********************************************************************************************************************************
+Chunk constants and sizes
+
+Authenticated (AEAD) ciphers such as aes-256-gcm split the data into chunks that are encrypted and authenticated independently. Each
+chunk is followed by its tag and uses a nonce made from the initialization vector and the chunk index, so the chunks cannot be
+reordered and any chunk can be decrypted without decrypting the chunks before it. Every chunk except the last contains exactly
+CIPHER_BLOCK_CHUNK_SIZE bytes, which puts chunk n at offset header + n * (CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE). The last
+chunk is always shorter (and may be empty) so truncation at a chunk boundary is detected.
+***********************************************************************************************************************************/
+#define CIPHER_BLOCK_CHUNK_SIZE                                     ((size_t)64 * 1024)
+#define CIPHER_BLOCK_TAG_SIZE                                       16
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -42,6 +54,16 @@ typedef struct CipherBlock
     const EVP_MD *digest;                                           // Message digest object
     EVP_CIPHER_CTX *cipherContext;                                  // Encrypt/decrypt context
 
+    bool chunked;                                                   // Split into authenticated chunks?
+    unsigned char initVector[EVP_MAX_IV_LENGTH];                    // Initialization vector used to generate chunk nonces
+    uint64_t chunkIdx;                                              // Current chunk
+    bool chunkBegin;                                                // Has the current chunk been initialized?
+    size_t chunkSize;                                               // Bytes processed in the current chunk (excluding the tag)
+    size_t tagSize;                                                 // Size of partial tag read during decrypt
+    unsigned char tag[CIPHER_BLOCK_TAG_SIZE];                       // Buffer to hold partial tag during decrypt
+    size_t tailSize;                                                // Size of data held back during decrypt
+    unsigned char tail[CIPHER_BLOCK_TAG_SIZE];                      // Held back since the last bytes are the tag of the last chunk
+
     Buffer *buffer;                                                 // Internal buffer in case destination buffer isn't large enough
     bool inputSame;                                                 // Is the same input required on next process call?
     bool done;                                                      // Is processing done?
@@ -96,6 +118,10 @@ cipherBlockProcessSize(const CipherBlock *const this, const size_t sourceSize)
     // Destination size is source size plus one extra block
     size_t destinationSize = sourceSize + EVP_MAX_BLOCK_LENGTH;
 
+    // Chunks add a tag for each chunk completed plus the tag for the last chunk
+    if (this->chunked)
+        destinationSize = sourceSize + (sourceSize / CIPHER_BLOCK_CHUNK_SIZE + 2) * CIPHER_BLOCK_TAG_SIZE;
+
     // On encrypt the header size must be included before the first block
     if (this->mode == cipherModeEncrypt && !this->saltDone)
         destinationSize += CIPHER_BLOCK_MAGIC_SIZE + PKCS5_SALT_LEN;
@@ -103,6 +129,198 @@ cipherBlockProcessSize(const CipherBlock *const this, const size_t sourceSize)
     FUNCTION_LOG_RETURN(SIZE, destinationSize);
 }
 
+/***********************************************************************************************************************************
+Begin/end a chunk
+***********************************************************************************************************************************/
+static void
+cipherBlockChunkBegin(CipherBlock *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_BLOCK, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->chunkBegin);
+
+    // The nonce is the initialization vector with the chunk index xor'd into the last eight bytes
+    const int nonceSize = EVP_CIPHER_iv_length(this->cipher);
+    unsigned char nonce[EVP_MAX_IV_LENGTH];
+
+    memcpy(nonce, this->initVector, (size_t)nonceSize);
+
+    for (unsigned int byteIdx = 0; byteIdx < sizeof(this->chunkIdx); byteIdx++)
+        nonce[nonceSize - 1 - (int)byteIdx] ^= (unsigned char)(this->chunkIdx >> (byteIdx * 8));
+
+    cryptoError(
+        !EVP_CipherInit_ex(this->cipherContext, NULL, NULL, NULL, nonce, this->mode == cipherModeEncrypt),
+        "unable to initialize cipher chunk");
+
+    this->chunkBegin = true;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// On encrypt the tag is written to the tag parameter and on decrypt the tag parameter is checked
+static void
+cipherBlockChunkEnd(CipherBlock *const this, unsigned char *const tag)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_BLOCK, this);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, tag);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->chunkBegin);
+    ASSERT(tag != NULL);
+
+    // No data is output on final for AEAD ciphers
+    unsigned char final[EVP_MAX_BLOCK_LENGTH];
+    int finalSize = 0;
+
+    if (this->mode == cipherModeEncrypt)
+    {
+        cryptoError(!EVP_CipherFinal_ex(this->cipherContext, final, &finalSize), "unable to finalize cipher chunk");
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(this->cipherContext, EVP_CTRL_AEAD_GET_TAG, CIPHER_BLOCK_TAG_SIZE, tag),
+            "unable to get cipher chunk tag");
+    }
+    else
+    {
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(this->cipherContext, EVP_CTRL_AEAD_SET_TAG, CIPHER_BLOCK_TAG_SIZE, tag),
+            "unable to set cipher chunk tag");
+
+        if (!EVP_CipherFinal_ex(this->cipherContext, final, &finalSize))
+            THROW_FMT(CryptoError, "unable to authenticate cipher chunk %" PRIu64, this->chunkIdx);
+    }
+
+    ASSERT(finalSize == 0);
+
+    this->chunkIdx++;
+    this->chunkBegin = false;
+    this->chunkSize = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Encrypt/decrypt chunk data. The source must not include the tag of the last chunk.
+***********************************************************************************************************************************/
+static size_t
+cipherBlockChunkProcess(CipherBlock *const this, const unsigned char *source, size_t sourceSize, unsigned char *destination)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_BLOCK, this);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, source);
+        FUNCTION_LOG_PARAM(SIZE, sourceSize);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, destination);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL || sourceSize == 0);
+    ASSERT(destination != NULL);
+
+    size_t destinationSize = 0;
+
+    while (sourceSize > 0)
+    {
+        // Process data in the current chunk
+        if (this->chunkSize < CIPHER_BLOCK_CHUNK_SIZE)
+        {
+            if (!this->chunkBegin)
+                cipherBlockChunkBegin(this);
+
+            const size_t processSize =
+                sourceSize < CIPHER_BLOCK_CHUNK_SIZE - this->chunkSize ? sourceSize : CIPHER_BLOCK_CHUNK_SIZE - this->chunkSize;
+            int destinationUpdateSize = 0;
+
+            cryptoError(
+                !EVP_CipherUpdate(this->cipherContext, destination, &destinationUpdateSize, source, (int)processSize),
+                "unable to process cipher");
+
+            source += processSize;
+            sourceSize -= processSize;
+            destination += destinationUpdateSize;
+            destinationSize += (size_t)destinationUpdateSize;
+            this->chunkSize += processSize;
+
+            // On encrypt the tag follows a full chunk
+            if (this->mode == cipherModeEncrypt && this->chunkSize == CIPHER_BLOCK_CHUNK_SIZE)
+            {
+                cipherBlockChunkEnd(this, destination);
+
+                destination += CIPHER_BLOCK_TAG_SIZE;
+                destinationSize += CIPHER_BLOCK_TAG_SIZE;
+            }
+        }
+        // Else on decrypt read the tag that follows a full chunk
+        else
+        {
+            const size_t tagSize =
+                sourceSize < CIPHER_BLOCK_TAG_SIZE - this->tagSize ? sourceSize : CIPHER_BLOCK_TAG_SIZE - this->tagSize;
+
+            memcpy(this->tag + this->tagSize, source, tagSize);
+
+            source += tagSize;
+            sourceSize -= tagSize;
+            this->tagSize += tagSize;
+
+            if (this->tagSize == CIPHER_BLOCK_TAG_SIZE)
+            {
+                cipherBlockChunkEnd(this, this->tag);
+                this->tagSize = 0;
+            }
+        }
+    }
+
+    FUNCTION_LOG_RETURN(SIZE, destinationSize);
+}
+
+// On decrypt the last bytes seen are held back until more data arrives since they may be the tag of the last chunk
+static size_t
+cipherBlockChunkDecrypt(
+    CipherBlock *const this, const unsigned char *const source, const size_t sourceSize, unsigned char *const destination)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_BLOCK, this);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, source);
+        FUNCTION_LOG_PARAM(SIZE, sourceSize);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, destination);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->mode == cipherModeDecrypt);
+    ASSERT(source != NULL);
+    ASSERT(destination != NULL);
+
+    size_t destinationSize = 0;
+
+    // Process everything except the last tag size bytes, starting with the bytes held back from the last call
+    if (this->tailSize + sourceSize > CIPHER_BLOCK_TAG_SIZE)
+    {
+        const size_t processSize = this->tailSize + sourceSize - CIPHER_BLOCK_TAG_SIZE;
+        const size_t tailProcessSize = processSize < this->tailSize ? processSize : this->tailSize;
+
+        destinationSize += cipherBlockChunkProcess(this, this->tail, tailProcessSize, destination);
+        memmove(this->tail, this->tail + tailProcessSize, this->tailSize - tailProcessSize);
+        this->tailSize -= tailProcessSize;
+
+        destinationSize += cipherBlockChunkProcess(
+            this, source, processSize - tailProcessSize, destination + destinationSize);
+
+        memcpy(this->tail + this->tailSize, source + processSize - tailProcessSize, CIPHER_BLOCK_TAG_SIZE - this->tailSize);
+        this->tailSize = CIPHER_BLOCK_TAG_SIZE;
+    }
+    // Else hold back all the bytes
+    else
+    {
+        memcpy(this->tail + this->tailSize, source, sourceSize);
+        this->tailSize += sourceSize;
+    }
+
+    FUNCTION_LOG_RETURN(SIZE, destinationSize);
+}
+
 /***********************************************************************************************************************************
 Encrypt/decrypt data
 ***********************************************************************************************************************************/
@@ -192,11 +410,16 @@ cipherBlockProcessBlock(CipherBlock *const this, const unsigned char *source, si
             // Set free callback to ensure cipher context is freed
             memContextCallbackSet(objMemContext(this), cipherBlockFreeResource, this);
 
-            // Initialize cipher
+            // Initialize cipher. Chunks set their own nonce generated from the initialization vector.
             cryptoError(
-                !EVP_CipherInit_ex(this->cipherContext, this->cipher, NULL, key, initVector, this->mode == cipherModeEncrypt),
+                !EVP_CipherInit_ex(
+                    this->cipherContext, this->cipher, NULL, key, this->chunked ? NULL : initVector,
+                    this->mode == cipherModeEncrypt),
                 "unable to initialize cipher");
 
+            if (this->chunked)
+                memcpy(this->initVector, initVector, sizeof(this->initVector));
+
             this->saltDone = true;
         }
     }
@@ -204,14 +427,25 @@ cipherBlockProcessBlock(CipherBlock *const this, const unsigned char *source, si
     // Recheck that source size > 0 as the bytes may have been consumed reading the header
     if (sourceSize > 0)
     {
-        // Process the data
-        int destinationUpdateSize = 0;
+        // Process the data in chunks
+        if (this->chunked)
+        {
+            if (this->mode == cipherModeEncrypt)
+                destinationSize += cipherBlockChunkProcess(this, source, sourceSize, destination);
+            else
+                destinationSize += cipherBlockChunkDecrypt(this, source, sourceSize, destination);
+        }
+        // Else process the data as a single stream
+        else
+        {
+            int destinationUpdateSize = 0;
 
-        cryptoError(
-            !EVP_CipherUpdate(this->cipherContext, destination, &destinationUpdateSize, source, (int)sourceSize),
-            "unable to process cipher");
+            cryptoError(
+                !EVP_CipherUpdate(this->cipherContext, destination, &destinationUpdateSize, source, (int)sourceSize),
+                "unable to process cipher");
 
-        destinationSize += (size_t)destinationUpdateSize;
+            destinationSize += (size_t)destinationUpdateSize;
+        }
 
         // Note that data has been processed so flush is valid
         this->processDone = true;
@@ -242,8 +476,28 @@ cipherBlockFlush(CipherBlock *const this, Buffer *const destination)
     if (!this->saltDone)
         THROW(CryptoError, "cipher header missing");
 
-    // Only flush remaining data if some data was processed
-    if (!EVP_CipherFinal(this->cipherContext, bufRemainsPtr(destination), &destinationSize))
+    // End the last chunk, which is never full
+    if (this->chunked)
+    {
+        if (this->mode == cipherModeDecrypt &&
+            (this->tailSize < CIPHER_BLOCK_TAG_SIZE || this->chunkSize == CIPHER_BLOCK_CHUNK_SIZE))
+        {
+            THROW(CryptoError, "cipher data truncated");
+        }
+
+        if (!this->chunkBegin)
+            cipherBlockChunkBegin(this);
+
+        if (this->mode == cipherModeEncrypt)
+        {
+            cipherBlockChunkEnd(this, bufRemainsPtr(destination));
+            destinationSize = CIPHER_BLOCK_TAG_SIZE;
+        }
+        else
+            cipherBlockChunkEnd(this, this->tail);
+    }
+    // Else only flush remaining data if some data was processed
+    else if (!EVP_CipherFinal(this->cipherContext, bufRemainsPtr(destination), &destinationSize))
         THROW(CryptoError, "unable to flush");
 
     // Return actual destination size
@@ -429,6 +683,7 @@ cipherBlockNew(const CipherMode mode, const CipherType cipherType, const Buffer
             .raw = param.raw,
             .cipher = cipher,
             .digest = digest,
+            .chunked = EVP_CIPHER_mode(cipher) == EVP_CIPH_GCM_MODE,
             .pass = bufDup(pass),
         };
     }
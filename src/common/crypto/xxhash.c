@@ -11,11 +11,87 @@ xxHash Interface
 
 /***********************************************************************************************************************************
 Include local xxHash code
+
+When the compiler targets x86-64 without AVX2 (the usual case for distribution packages) also build the AVX2 kernels so they can be
+selected at runtime on CPUs that support them. The SSE2 kernels are used otherwise. The hash is the same for all kernels.
 ***********************************************************************************************************************************/
 #define XXH_INLINE_ALL
 
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__AVX2__)
+    #include <immintrin.h>
+
+    #define XX_HASH_AVX2
+
+    #define XXH_X86DISPATCH
+    #define XXH_DISPATCH_AVX2                                       1
+    #define XXH_TARGET_AVX2                                         __attribute__((__target__("avx2")))
+    #define XXH_TARGET_SSE2                                         __attribute__((__target__("sse2")))
+#endif
+
 #include "common/crypto/xxhash.vendor.c.inc"
 
+/***********************************************************************************************************************************
+Kernels selected at runtime based on CPU features
+***********************************************************************************************************************************/
+static struct XxHashLocal
+{
+    bool init;                                                      // Have the kernels been selected?
+    XXH_errorcode (*update)(XXH3_state_t *, const void *, size_t);  // Add data to streaming hash
+    XXH128_hash_t (*one)(const void *, size_t);                     // Hash one buffer
+} xxHashLocal;
+
+#ifdef XX_HASH_AVX2
+
+static XXH_TARGET_AVX2 XXH_errorcode
+xxHashUpdateAvx2(XXH3_state_t *const state, const void *const input, const size_t size)
+{
+    return XXH3_update(state, (const xxh_u8 *)input, size, XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+
+static XXH_TARGET_AVX2 XXH128_hash_t
+xxHashLongAvx2(
+    const void *const input, const size_t size, const XXH64_hash_t seed, const void *const secret, const size_t secretSize)
+{
+    (void)seed;                                                     // Default seed is always used
+    (void)secret;                                                   // Default secret is always used
+    (void)secretSize;                                               // Default secret is always used
+
+    return XXH3_hashLong_128b_internal(
+        input, size, XXH3_kSecret, sizeof(XXH3_kSecret), XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+
+static XXH128_hash_t
+xxHashOneAvx2(const void *const input, const size_t size)
+{
+    return XXH3_128bits_internal(input, size, 0, XXH3_kSecret, sizeof(XXH3_kSecret), xxHashLongAvx2);
+}
+
+#endif // XX_HASH_AVX2
+
+static void
+xxHashInit(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (!xxHashLocal.init)
+    {
+        xxHashLocal.update = XXH3_128bits_update;
+        xxHashLocal.one = XXH3_128bits;
+
+#ifdef XX_HASH_AVX2
+        if (__builtin_cpu_supports("avx2"))                         // {uncovered_branch - depends on CPU features}
+        {
+            xxHashLocal.update = xxHashUpdateAvx2;
+            xxHashLocal.one = xxHashOneAvx2;
+        }
+#endif
+
+        xxHashLocal.init = true;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -68,7 +144,7 @@ xxHashProcess(THIS_VOID, const Buffer *const message)
     ASSERT(this != NULL);
     ASSERT(message != NULL);
 
-    XXH3_128bits_update(this->state, bufPtrConst(message), bufUsed(message));
+    xxHashLocal.update(this->state, bufPtrConst(message), bufUsed(message));
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -116,6 +192,8 @@ xxHashNew(const size_t size)
 
     ASSERT(size >= 1 && size <= XX_HASH_SIZE_MAX);
 
+    xxHashInit();
+
     OBJ_NEW_BEGIN(XxHash, .callbackQty = 1)
     {
         *this = (XxHash){.size = size};
@@ -143,10 +221,12 @@ xxHashOne(const size_t size, const Buffer *const message)
     ASSERT(size >= 1 && size <= XX_HASH_SIZE_MAX);
     ASSERT(message != NULL);
 
+    xxHashInit();
+
     Buffer *const result = bufNew(size);
 
     XXH128_canonical_t canonical;
-    XXH128_canonicalFromHash(&canonical, XXH3_128bits(bufPtrConst(message), bufUsed(message)));
+    XXH128_canonicalFromHash(&canonical, xxHashLocal.one(bufPtrConst(message), bufUsed(message)));
 
     memcpy(bufPtr(result), canonical.digest, size);
     bufUsedSet(result, size);
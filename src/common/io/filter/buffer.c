@@ -11,11 +11,6 @@ IO Buffer Filter
 #include "common/log.h"
 #include "common/type/object.h"
 
-/***********************************************************************************************************************************
-Filter type constant
-***********************************************************************************************************************************/
-#define BUFFER_FILTER_TYPE                                          STRID5("buffer", 0x24531aa20)
-
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
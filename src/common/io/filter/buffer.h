@@ -10,6 +10,11 @@ in a FilterGroup if the last filter is not already an InOut filter, so there is
 #include "common/io/filter/filter.h"
 #include "common/type/buffer.h"
 
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define BUFFER_FILTER_TYPE                                          STRID5("buffer", 0x24531aa20)
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
@@ -160,6 +160,22 @@ ioFilterGroupClear(IoFilterGroup *const this)
     FUNCTION_LOG_RETURN(IO_FILTER_GROUP, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioFilterGroupPassThru(const IoFilterGroup *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_FILTER_GROUP, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(
+        BOOL,
+        ioFilterGroupSize(this) == 0 ||
+        (ioFilterGroupSize(this) == 1 && ioFilterType(ioFilterGroupGet(this, 0)->filter) == BUFFER_FILTER_TYPE));
+}
+
 /***********************************************************************************************************************************
 Setup the filter group and allocate any required buffers
 ***********************************************************************************************************************************/
@@ -101,6 +101,10 @@ FN_EXTERN IoFilterGroup *ioFilterGroupInsert(IoFilterGroup *this, unsigned int l
 // Clear filters
 FN_EXTERN IoFilterGroup *ioFilterGroupClear(IoFilterGroup *this);
 
+// Does the filter group pass data through unchanged? This is true when no filters have been added, ignoring the buffer filter that
+// is added when the group is opened.
+FN_EXTERN bool ioFilterGroupPassThru(const IoFilterGroup *this);
+
 // Open filter group
 FN_EXTERN void ioFilterGroupOpen(IoFilterGroup *this);
 
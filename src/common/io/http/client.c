@@ -15,6 +15,7 @@ Statistics constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(HTTP_STAT_CLIENT_STR,                                 HTTP_STAT_CLIENT);
 STRING_EXTERN(HTTP_STAT_CLOSE_STR,                                  HTTP_STAT_CLOSE);
+STRING_EXTERN(HTTP_STAT_IDLE_STR,                                   HTTP_STAT_IDLE);
 STRING_EXTERN(HTTP_STAT_REQUEST_STR,                                HTTP_STAT_REQUEST);
 STRING_EXTERN(HTTP_STAT_RETRY_STR,                                  HTTP_STAT_RETRY);
 STRING_EXTERN(HTTP_STAT_SESSION_STR,                                HTTP_STAT_SESSION);
@@ -30,6 +31,13 @@ struct HttpClient
     List *sessionReuseList;                                         // List of HTTP sessions that can be reused
 };
 
+// Session waiting to be reused
+typedef struct HttpClientSessionReuse
+{
+    HttpSession *session;                                           // HTTP session
+    TimeMSec timeIdle;                                              // Time the session became idle
+} HttpClientSessionReuse;
+
 /**********************************************************************************************************************************/
 FN_EXTERN HttpClient *
 httpClientNew(IoClient *const ioClient, const TimeMSec timeout)
@@ -50,7 +58,7 @@ httpClientNew(IoClient *const ioClient, const TimeMSec timeout)
                 .timeout = timeout,
             },
             .ioClient = ioClient,
-            .sessionReuseList = lstNewP(sizeof(HttpSession *)),
+            .sessionReuseList = lstNewP(sizeof(HttpClientSessionReuse)),
         };
 
         statInc(HTTP_STAT_CLIENT_STR);
@@ -72,18 +80,29 @@ httpClientOpen(HttpClient *const this)
 
     HttpSession *result = NULL;
 
-    // Check if there is a reusable session
-    if (!lstEmpty(this->sessionReuseList))
+    // Find a reusable session, oldest first. Sessions that have been idle too long are likely to have been closed by the server so
+    // close them rather than risk a failed request and a retry with backoff.
+    const TimeMSec timeCurrent = timeMSec();
+
+    while (result == NULL && !lstEmpty(this->sessionReuseList))
     {
         // Remove session from reusable list
-        result = *(HttpSession **)lstGet(this->sessionReuseList, 0);
+        const HttpClientSessionReuse reuse = *(HttpClientSessionReuse *)lstGet(this->sessionReuseList, 0);
         lstRemoveIdx(this->sessionReuseList, 0);
 
-        // Move session to the calling context
-        httpSessionMove(result, memContextCurrent());
+        // Close the session if it has been idle too long
+        if (timeCurrent - reuse.timeIdle > HTTP_CLIENT_SESSION_IDLE_MAX)
+        {
+            httpSessionFree(reuse.session);
+            statInc(HTTP_STAT_IDLE_STR);
+        }
+        // Else move session to the calling context
+        else
+            result = httpSessionMove(reuse.session, memContextCurrent());
     }
-    // Else create a new session
-    else
+
+    // Create a new session if there was nothing to reuse
+    if (result == NULL)
     {
         result = httpSessionNew(this, ioClientOpen(this->ioClient));
         statInc(HTTP_STAT_SESSION_STR);
@@ -105,7 +124,7 @@ httpClientReuse(HttpClient *const this, HttpSession *const session)
     ASSERT(session != NULL);
 
     httpSessionMove(session, lstMemContext(this->sessionReuseList));
-    lstAdd(this->sessionReuseList, &session);
+    lstAdd(this->sessionReuseList, &(HttpClientSessionReuse){.session = session, .timeIdle = timeMSec()});
 
     FUNCTION_LOG_RETURN_VOID();
 }
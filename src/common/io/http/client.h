@@ -32,6 +32,8 @@ Statistics constants
 STRING_DECLARE(HTTP_STAT_CLIENT_STR);
 #define HTTP_STAT_CLOSE                                             "http.close"        // Closes forced by server
 STRING_DECLARE(HTTP_STAT_CLOSE_STR);
+#define HTTP_STAT_IDLE                                              "http.idle"         // Idle sessions closed before reuse
+STRING_DECLARE(HTTP_STAT_IDLE_STR);
 #define HTTP_STAT_REQUEST                                           "http.request"      // Requests (i.e. calls to httpRequestNew())
 STRING_DECLARE(HTTP_STAT_REQUEST_STR);
 #define HTTP_STAT_RETRY                                             "http.retry"        // Request retries
@@ -39,6 +41,12 @@ STRING_DECLARE(HTTP_STAT_RETRY_STR);
 #define HTTP_STAT_SESSION                                           "http.session"      // Sessions created
 STRING_DECLARE(HTTP_STAT_SESSION_STR);
 
+/***********************************************************************************************************************************
+Sessions idle longer than this are closed rather than reused. Object stores close idle connections after a time (e.g. S3 after
+about 20 seconds) and a request sent on a closed connection fails and must be retried after a backoff.
+***********************************************************************************************************************************/
+#define HTTP_CLIENT_SESSION_IDLE_MAX                                ((TimeMSec)(15 * MSEC_PER_SEC))
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
@@ -64,7 +72,8 @@ Functions
 // Open a new session
 FN_EXTERN HttpSession *httpClientOpen(HttpClient *this);
 
-// Request/response finished cleanly so session can be reused
+// Request/response finished cleanly so session can be reused. Reusable sessions are closed on the next open if they have been idle
+// longer than HTTP_CLIENT_SESSION_IDLE_MAX.
 FN_EXTERN void httpClientReuse(HttpClient *this, HttpSession *session);
 
 /***********************************************************************************************************************************
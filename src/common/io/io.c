@@ -22,6 +22,9 @@ static size_t bufferSize = (8 * IO_BUFFER_BLOCK_SIZE);
 // I/O timeout in milliseconds
 static TimeMSec timeoutMs = 60000;
 
+// Drop file data from the page cache after read/write?
+static bool cacheDrop = false;
+
 /**********************************************************************************************************************************/
 FN_EXTERN size_t
 ioBufferSize(void)
@@ -62,6 +65,26 @@ ioTimeoutMsSet(const TimeMSec timeoutMsParam)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioCacheDrop(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN(BOOL, cacheDrop);
+}
+
+FN_EXTERN void
+ioCacheDropSet(const bool cacheDropParam)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, cacheDropParam);
+    FUNCTION_TEST_END();
+
+    cacheDrop = cacheDropParam;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN Buffer *
 ioReadBuf(IoRead *const read)
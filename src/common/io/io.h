@@ -45,4 +45,9 @@ FN_EXTERN void ioBufferSizeSet(size_t bufferSize);
 FN_EXTERN TimeMSec ioTimeoutMs(void);
 FN_EXTERN void ioTimeoutMsSet(TimeMSec timeout);
 
+// Drop file data from the page cache after it has been read/written. This prevents large files from evicting more useful data from
+// the page cache but is only a hint to the kernel so there is no guarantee that the data will be dropped.
+FN_EXTERN bool ioCacheDrop(void);
+FN_EXTERN void ioCacheDropSet(bool cacheDrop);
+
 #endif
@@ -21,6 +21,7 @@ TLS Client
 Statistics constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(TLS_STAT_CLIENT_STR,                                  TLS_STAT_CLIENT);
+STRING_EXTERN(TLS_STAT_RESUME_STR,                                  TLS_STAT_RESUME);
 STRING_EXTERN(TLS_STAT_RETRY_STR,                                   TLS_STAT_RETRY);
 STRING_EXTERN(TLS_STAT_SESSION_STR,                                 TLS_STAT_SESSION);
 
@@ -36,6 +37,7 @@ typedef struct TlsClient
     IoClient *ioClient;                                             // Underlying client (usually a SocketClient)
 
     SSL_CTX *context;                                               // TLS context
+    SSL_SESSION *session;                                           // Most recent session from the server to resume
 } TlsClient;
 
 /***********************************************************************************************************************************
@@ -73,8 +75,13 @@ tlsClientFreeResource(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    // Sessions created from the context may outlive the client so make sure the new session callback can no longer reach it
+    SSL_CTX_set_app_data(this->context, NULL);
     SSL_CTX_free(this->context);
 
+    if (this->session != NULL)
+        SSL_SESSION_free(this->session);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -180,6 +187,40 @@ tlsClientHostVerify(const String *const host, X509 *const certificate)
     FUNCTION_LOG_RETURN(BOOL, result);                                                                              // {vm_covered}
 }
 
+/***********************************************************************************************************************************
+Store a new session from the server so it can be resumed by the next connection. This is called after the handshake or, for TLS
+1.3, when the server sends a session ticket.
+***********************************************************************************************************************************/
+static int
+tlsClientSessionNew(SSL *const tlsSession, SSL_SESSION *const session)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, tlsSession);
+        FUNCTION_TEST_PARAM_P(VOID, session);
+    FUNCTION_TEST_END();
+
+    ASSERT(tlsSession != NULL);
+    ASSERT(session != NULL);
+
+    TlsClient *const this = SSL_CTX_get_app_data(SSL_get_SSL_CTX(tlsSession));
+    int result = 0;
+
+    // Ignore the session if the client has been freed
+    if (this != NULL)
+    {
+        // Replace the prior session. Only the most recent session is kept since TLS 1.3 tickets should not be used more than once.
+        if (this->session != NULL)
+            SSL_SESSION_free(this->session);
+
+        this->session = session;
+
+        // Take ownership of the session
+        result = 1;
+    }
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
 /***********************************************************************************************************************************
 Authenticate server
 
@@ -266,6 +307,11 @@ tlsClientOpen(THIS_VOID)
             // Set server host name used for validation
             cryptoError(SSL_set_tlsext_host_name(tlsSession, strZ(this->host)) != 1, "unable to set TLS host name");
 
+            // Attempt to resume the most recent session to avoid a full handshake. The server may decline, in which case a full
+            // handshake is done.
+            if (this->session != NULL)
+                cryptoError(SSL_set_session(tlsSession, this->session) != 1, "unable to set TLS session");
+
             // Open TLS session
             TRY_BEGIN()
             {
@@ -309,6 +355,10 @@ tlsClientOpen(THIS_VOID)
         ASSERT(result != NULL);
         ioSessionAuthenticatedSet(result, tlsClientAuth(this, tlsSession));
 
+        // Count resumed sessions. The pgBackRest server disables session caching so this is not covered by tests.
+        if (SSL_session_reused(tlsSession))                         // {uncovered_branch - test server does not resume}
+            statInc(TLS_STAT_RESUME_STR);                           // {uncovered - test server does not resume}
+
         // Move session
         ioSessionMove(result, memContextPrior());
     }
@@ -384,6 +434,12 @@ tlsClientNew(
         // Enable safe compatibility options
         SSL_CTX_set_options(this->context, SSL_OP_ALL);
 
+        // Store sessions from the server in the client so they can be resumed. The context is only used for connections to a
+        // single host so there is no need for the internal cache, which would be keyed on the session id.
+        SSL_CTX_set_app_data(this->context, this);
+        SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(this->context, tlsClientSessionNew);
+
         // Set location of CA certificates if the server certificate will be verified
         if (this->verifyPeer)
         {
@@ -0,0 +1,674 @@
+/***********************************************************************************************************************************
+io_uring Interface
+
+The ring is set up with raw system calls so no additional library is required. Only the features needed by the posix storage driver
+are implemented and the ring is never polled by the kernel, so all submissions happen in ioUringWait().
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_IO_URING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "common/debug.h"
+#include "common/io/io.h"
+#include "common/io/uring.h"
+#include "common/log.h"
+#include "common/memContext.h"
+
+/***********************************************************************************************************************************
+There are no library wrappers for the io_uring system calls and syscall() is not declared when only POSIX features are requested
+***********************************************************************************************************************************/
+long syscall(long number, ...);
+
+/***********************************************************************************************************************************
+Ring size. When the ring is full queued operations are submitted to make room, but operations that are linked must be submitted
+together so there must always be room for the longest chain (sync/close/rename/sync/close).
+***********************************************************************************************************************************/
+#define IO_URING_ENTRIES                                            32
+#define IO_URING_LINK_MAX                                           5
+
+/***********************************************************************************************************************************
+Operation data that the kernel writes completions to. This is owned by the ring and is only reused once the operation is complete,
+so a completion can never be written to memory that has been freed.
+***********************************************************************************************************************************/
+typedef struct IoUringOpData
+{
+    bool busy;                                                      // Has the operation been queued but not yet completed?
+    int result;                                                     // Operation result (-errno on error)
+    unsigned int ringId;                                            // Ring the operation was queued on
+    struct IoUringOpData *next;                                     // Next free operation data
+} IoUringOpData;
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct IoUringOp
+{
+    IoUringOpData *data;                                            // Operation data owned by the ring
+};
+
+/***********************************************************************************************************************************
+Local data
+***********************************************************************************************************************************/
+static struct IoUringLocal
+{
+    MemContext *memContext;                                         // Context for buffers and operation data
+    bool enabled;                                                   // Has io_uring been enabled?
+    bool init;                                                      // Has ring creation been attempted?
+    pid_t pid;                                                      // Process that created the ring
+    unsigned int ringId;                                            // Incremented each time a new ring is created
+    int fd;                                                         // Ring file descriptor (-1 when not available)
+    int error;                                                      // Error (errno) that makes the ring unusable
+    unsigned int submitTotal;                                       // Operations queued but not yet submitted
+    bool linkOpen;                                                  // Was the last operation queued linked to the next?
+    bool renameAvailable;                                           // Is the rename operation supported by the kernel?
+    IoUringOpData *opFree;                                          // Operation data available for reuse
+
+    void *sqRing;                                                   // Submission queue mapping
+    size_t sqRingSize;                                              // Submission queue mapping size
+    unsigned int *sqTail;                                           // Submission queue tail
+    unsigned int *sqMask;                                           // Submission queue index mask
+    unsigned int *sqArray;                                          // Submission queue index array
+    struct io_uring_sqe *sqeList;                                   // Submission queue entries
+    size_t sqeListSize;                                             // Submission queue entries mapping size
+
+    void *cqRing;                                                   // Completion queue mapping
+    size_t cqRingSize;                                              // Completion queue mapping size
+    unsigned int *cqHead;                                           // Completion queue head
+    unsigned int *cqTail;                                           // Completion queue tail
+    unsigned int *cqMask;                                           // Completion queue index mask
+    struct io_uring_cqe *cqeList;                                   // Completion queue entries
+
+    unsigned char *buffer;                                          // Memory for all pool buffers
+    size_t bufferSize;                                              // Size of each pool buffer
+    bool bufferFixed;                                               // Are the buffers registered with the ring?
+    bool bufferBusy[IO_URING_BUFFER_MAX];                           // Is the buffer in use?
+} ioUringLocal = {.fd = -1};
+
+/***********************************************************************************************************************************
+Register pool buffers with the ring. Registration can fail when the buffers exceed the locked memory limit, in which case the
+buffers are still used but the kernel must map them on each request.
+***********************************************************************************************************************************/
+static bool
+ioUringBufferRegister(void)
+{
+    FUNCTION_TEST_VOID();
+
+    struct iovec bufferList[IO_URING_BUFFER_MAX];
+
+    for (unsigned int bufferIdx = 0; bufferIdx < IO_URING_BUFFER_MAX; bufferIdx++)
+    {
+        bufferList[bufferIdx] = (struct iovec)
+        {
+            .iov_base = ioUringLocal.buffer + ioUringLocal.bufferSize * bufferIdx,
+            .iov_len = ioUringLocal.bufferSize,
+        };
+    }
+
+    FUNCTION_TEST_RETURN(
+        BOOL, syscall(__NR_io_uring_register, ioUringLocal.fd, IORING_REGISTER_BUFFERS, bufferList, IO_URING_BUFFER_MAX) == 0);
+}
+
+/***********************************************************************************************************************************
+Check if the rename operation is supported by the kernel
+***********************************************************************************************************************************/
+static bool
+ioUringRenameProbe(void)
+{
+    FUNCTION_TEST_VOID();
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        struct io_uring_probe *const probe = memNew(
+            sizeof(struct io_uring_probe) + (IORING_OP_RENAMEAT + 1) * sizeof(struct io_uring_probe_op));
+        memset(probe, 0, sizeof(struct io_uring_probe) + (IORING_OP_RENAMEAT + 1) * sizeof(struct io_uring_probe_op));
+
+        if (syscall(__NR_io_uring_register, ioUringLocal.fd, IORING_REGISTER_PROBE, probe, IORING_OP_RENAMEAT + 1) == 0 &&
+            probe->ops_len > IORING_OP_RENAMEAT)
+        {
+            result = probe->ops[IORING_OP_RENAMEAT].flags & IO_URING_OP_SUPPORTED;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Create the ring
+***********************************************************************************************************************************/
+static void
+ioUringInit(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ASSERT(ioUringLocal.fd == -1);
+
+    ioUringLocal.pid = getpid();
+    ioUringLocal.ringId++;
+    ioUringLocal.error = 0;
+
+    // IORING_SETUP_CLAMP is not accepted by kernels before 5.6, which also lack the read and close operations used here, so setup
+    // fails and blocking IO is used instead
+    struct io_uring_params param = {.flags = IORING_SETUP_CLAMP};
+    const int fd = (int)syscall(__NR_io_uring_setup, IO_URING_ENTRIES, &param);
+
+    if (fd == -1)
+        LOG_DETAIL_FMT("io_uring is not available: [%d] %s", errno, strerror(errno));
+    else
+    {
+        // The ring must not be shared with processes that are executed
+        THROW_ON_SYS_ERROR(fcntl(fd, F_SETFD, FD_CLOEXEC) == -1, KernelError, "unable to set close-on-exec for io_uring");
+
+        // Map the submission queue, completion queue, and submission queue entries
+        ioUringLocal.sqRingSize = param.sq_off.array + param.sq_entries * sizeof(unsigned int);
+        unsigned char *const sqRing = mmap(
+            NULL, ioUringLocal.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQ_RING);
+        THROW_ON_SYS_ERROR(sqRing == MAP_FAILED, KernelError, "unable to map io_uring submission queue");
+
+        ioUringLocal.cqRingSize = param.cq_off.cqes + param.cq_entries * sizeof(struct io_uring_cqe);
+        unsigned char *const cqRing = mmap(
+            NULL, ioUringLocal.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_CQ_RING);
+        THROW_ON_SYS_ERROR(cqRing == MAP_FAILED, KernelError, "unable to map io_uring completion queue");
+
+        ioUringLocal.sqeListSize = param.sq_entries * sizeof(struct io_uring_sqe);
+        struct io_uring_sqe *const sqeList = mmap(
+            NULL, ioUringLocal.sqeListSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQES);
+        THROW_ON_SYS_ERROR(sqeList == MAP_FAILED, KernelError, "unable to map io_uring submission queue entries");
+
+        ioUringLocal.fd = fd;
+        ioUringLocal.sqRing = sqRing;
+        ioUringLocal.sqTail = (unsigned int *)(sqRing + param.sq_off.tail);
+        ioUringLocal.sqMask = (unsigned int *)(sqRing + param.sq_off.ring_mask);
+        ioUringLocal.sqArray = (unsigned int *)(sqRing + param.sq_off.array);
+        ioUringLocal.sqeList = sqeList;
+        ioUringLocal.cqRing = cqRing;
+        ioUringLocal.cqHead = (unsigned int *)(cqRing + param.cq_off.head);
+        ioUringLocal.cqTail = (unsigned int *)(cqRing + param.cq_off.tail);
+        ioUringLocal.cqMask = (unsigned int *)(cqRing + param.cq_off.ring_mask);
+        ioUringLocal.cqeList = (struct io_uring_cqe *)(cqRing + param.cq_off.cqes);
+
+        // Allocate pool buffers for the life of the process. Buffers inherited from a parent process are reused.
+        if (ioUringLocal.memContext == NULL)
+        {
+            MEM_CONTEXT_BEGIN(memContextTop())
+            {
+                MEM_CONTEXT_NEW_BEGIN(IoUringLocal, .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX)
+                {
+                    ioUringLocal.memContext = MEM_CONTEXT_NEW();
+                    ioUringLocal.bufferSize = ioBufferSize();
+                    ioUringLocal.buffer = memNew(ioUringLocal.bufferSize * IO_URING_BUFFER_MAX);
+                }
+                MEM_CONTEXT_NEW_END();
+            }
+            MEM_CONTEXT_END();
+        }
+
+        ioUringLocal.bufferFixed = ioUringBufferRegister();
+        ioUringLocal.renameAvailable = ioUringRenameProbe();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Release a ring inherited from a parent process. The ring is shared with the parent so submitting or reaping here would steal the
+parent's operations. Operations queued by the parent are reported as cancelled since the ring id no longer matches.
+***********************************************************************************************************************************/
+static void
+ioUringForkCheck(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (ioUringLocal.init && ioUringLocal.pid != getpid())
+    {
+        if (ioUringLocal.fd != -1)
+        {
+            munmap(ioUringLocal.sqRing, ioUringLocal.sqRingSize);
+            munmap(ioUringLocal.cqRing, ioUringLocal.cqRingSize);
+            munmap(ioUringLocal.sqeList, ioUringLocal.sqeListSize);
+            close(ioUringLocal.fd);
+
+            ioUringLocal.fd = -1;
+        }
+
+        ioUringLocal.submitTotal = 0;
+        ioUringLocal.linkOpen = false;
+        ioUringLocal.init = false;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioUringAvailable(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ioUringForkCheck();
+
+    if (ioUringLocal.enabled && !ioUringLocal.init)
+    {
+        ioUringLocal.init = true;
+        ioUringInit();
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, ioUringLocal.enabled && ioUringLocal.fd != -1 && ioUringLocal.error == 0);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioUringRenameAvailable(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ASSERT(ioUringLocal.fd != -1);
+
+    FUNCTION_TEST_RETURN(BOOL, ioUringLocal.renameAvailable);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioUringBufferGet(unsigned int *const bufferIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UINT, bufferIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(ioUringLocal.fd != -1);
+    ASSERT(bufferIdx != NULL);
+
+    for (unsigned int bufferFreeIdx = 0; bufferFreeIdx < IO_URING_BUFFER_MAX; bufferFreeIdx++)
+    {
+        if (!ioUringLocal.bufferBusy[bufferFreeIdx])
+        {
+            ioUringLocal.bufferBusy[bufferFreeIdx] = true;
+            *bufferIdx = bufferFreeIdx;
+
+            FUNCTION_TEST_RETURN(BOOL, true);
+        }
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, false);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringBufferFree(const unsigned int bufferIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, bufferIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(bufferIdx < IO_URING_BUFFER_MAX);
+    ASSERT(ioUringLocal.bufferBusy[bufferIdx]);
+
+    ioUringLocal.bufferBusy[bufferIdx] = false;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Submit queued operations and store the results of completed operations, which may include operations other than the one being waited
+on. When wait is true block until at least one operation is complete. Errors other than EINTR make the ring unusable.
+***********************************************************************************************************************************/
+static void
+ioUringEnter(const bool wait)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, wait);
+    FUNCTION_TEST_END();
+
+    const int result = (int)syscall(
+        __NR_io_uring_enter, ioUringLocal.fd, ioUringLocal.submitTotal, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+
+    if (result == -1)
+    {
+        if (errno != EINTR)                                         // {uncovered_branch - ring errors cannot be forced}
+            ioUringLocal.error = errno;                             // {uncovered - ring errors cannot be forced}
+    }
+    else
+        ioUringLocal.submitTotal -= (unsigned int)result;
+
+    unsigned int head = *ioUringLocal.cqHead;
+    const unsigned int tail = __atomic_load_n(ioUringLocal.cqTail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; head++)
+    {
+        const struct io_uring_cqe *const cqe = &ioUringLocal.cqeList[head & *ioUringLocal.cqMask];
+        IoUringOpData *const dataComplete = (IoUringOpData *)(uintptr_t)cqe->user_data;
+
+        dataComplete->busy = false;
+        dataComplete->result = cqe->res;
+    }
+
+    __atomic_store_n(ioUringLocal.cqHead, head, __ATOMIC_RELEASE);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Submit queued operations and process completions until the operation is complete. Returns false with errno set if the ring is not
+usable, in which case the operation will never be complete.
+***********************************************************************************************************************************/
+static bool
+ioUringProcess(IoUringOpData *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    ioUringForkCheck();
+
+    while (data->busy)
+    {
+        // The operation was queued on a ring inherited from the parent process so it will never complete here
+        if (data->ringId != ioUringLocal.ringId || ioUringLocal.fd == -1)
+        {
+            *data = (IoUringOpData){.result = -ECANCELED};
+            break;
+        }
+
+        // Once the ring fails it is not possible to know which operations were submitted
+        if (ioUringLocal.error != 0)
+        {
+            errno = ioUringLocal.error;
+            FUNCTION_TEST_RETURN(BOOL, false);
+        }
+
+        ioUringEnter(true);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, true);
+}
+
+/***********************************************************************************************************************************
+Free operation data, waiting for the operation to complete first. If the operation cannot complete then the data is not reused since
+the kernel may still write to it. Errors are not thrown since this is called during cleanup.
+***********************************************************************************************************************************/
+static void
+ioUringOpFreeResource(THIS_VOID)
+{
+    THIS(IoUringOp);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (ioUringProcess(this->data))
+    {
+        this->data->next = ioUringLocal.opFree;
+        ioUringLocal.opFree = this->data;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoUringOp *
+ioUringOpNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ASSERT(ioUringLocal.memContext != NULL);
+
+    OBJ_NEW_BEGIN(IoUringOp, .callbackQty = 1)
+    {
+        *this = (IoUringOp){0};
+
+        // Reuse free operation data or allocate new data in the ring context
+        if (ioUringLocal.opFree != NULL)
+        {
+            this->data = ioUringLocal.opFree;
+            ioUringLocal.opFree = this->data->next;
+        }
+        else
+        {
+            MEM_CONTEXT_BEGIN(ioUringLocal.memContext)
+            {
+                this->data = memNew(sizeof(IoUringOpData));
+            }
+            MEM_CONTEXT_END();
+        }
+
+        *this->data = (IoUringOpData){0};
+
+        memContextCallbackSet(objMemContext(this), ioUringOpFreeResource, this);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_TEST_RETURN(IO_URING_OP, this);
+}
+
+/***********************************************************************************************************************************
+Queue an operation. The kernel does not see the entry until it is submitted by ioUringWait().
+***********************************************************************************************************************************/
+static void
+ioUringQueue(IoUringOp *const op, struct io_uring_sqe sqe, const bool link)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+        FUNCTION_TEST_PARAM(UINT, sqe.opcode);
+        FUNCTION_TEST_PARAM(BOOL, link);
+    FUNCTION_TEST_END();
+
+    ASSERT(ioUringLocal.fd != -1 && ioUringLocal.pid == getpid());
+    ASSERT(op != NULL && !op->data->busy);
+
+    // Submit queued operations when the ring is full. Linked operations must be submitted together so room for the longest chain is
+    // made before the first operation in a chain is queued.
+    if (!ioUringLocal.linkOpen)
+    {
+        const unsigned int queueTotal = link ? IO_URING_LINK_MAX : 1;
+
+        while (ioUringLocal.submitTotal + queueTotal > IO_URING_ENTRIES && ioUringLocal.error == 0)
+            ioUringEnter(false);
+
+        if (ioUringLocal.error != 0)                                 // {uncovered_branch - ring errors cannot be forced}
+        {
+            errno = ioUringLocal.error;                             // {uncovered - ring errors cannot be forced}
+            THROW_SYS_ERROR(KernelError, "unable to submit io_uring operations");
+        }
+    }
+
+    CHECK(AssertError, ioUringLocal.submitTotal < IO_URING_ENTRIES, "io_uring submission queue is full");
+
+    const unsigned int tail = *ioUringLocal.sqTail;
+    const unsigned int sqeIdx = tail & *ioUringLocal.sqMask;
+
+    sqe.user_data = (uint64_t)(uintptr_t)op->data;
+
+    if (link)
+        sqe.flags |= IOSQE_IO_LINK;
+
+    ioUringLocal.sqeList[sqeIdx] = sqe;
+    ioUringLocal.sqArray[sqeIdx] = sqeIdx;
+
+    __atomic_store_n(ioUringLocal.sqTail, tail + 1, __ATOMIC_RELEASE);
+    ioUringLocal.submitTotal++;
+    ioUringLocal.linkOpen = link;
+
+    *op->data = (IoUringOpData){.busy = true, .ringId = ioUringLocal.ringId};
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringRead(IoUringOp *const op, const int fd, const unsigned int bufferIdx, const size_t size, const uint64_t offset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+        FUNCTION_TEST_PARAM(INT, fd);
+        FUNCTION_TEST_PARAM(UINT, bufferIdx);
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+    FUNCTION_TEST_END();
+
+    ASSERT(bufferIdx < IO_URING_BUFFER_MAX);
+    ASSERT(ioUringLocal.bufferBusy[bufferIdx]);
+    ASSERT(size > 0 && size <= ioUringLocal.bufferSize);
+
+    ioUringQueue(
+        op,
+        (struct io_uring_sqe)
+        {
+            .opcode = (uint8_t)(ioUringLocal.bufferFixed ? IORING_OP_READ_FIXED : IORING_OP_READ),
+            .fd = fd,
+            .off = offset,
+            .addr = (uint64_t)(uintptr_t)ioUringBuffer(bufferIdx),
+            .len = (uint32_t)size,
+            .buf_index = (uint16_t)bufferIdx,
+        },
+        false);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringSync(IoUringOp *const op, const int fd, const bool link)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+        FUNCTION_TEST_PARAM(INT, fd);
+        FUNCTION_TEST_PARAM(BOOL, link);
+    FUNCTION_TEST_END();
+
+    ioUringQueue(op, (struct io_uring_sqe){.opcode = IORING_OP_FSYNC, .fd = fd}, link);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringClose(IoUringOp *const op, const int fd, const bool link)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+        FUNCTION_TEST_PARAM(INT, fd);
+        FUNCTION_TEST_PARAM(BOOL, link);
+    FUNCTION_TEST_END();
+
+    ioUringQueue(op, (struct io_uring_sqe){.opcode = IORING_OP_CLOSE, .fd = fd}, link);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringRename(IoUringOp *const op, const char *const pathFrom, const char *const pathTo, const bool link)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+        FUNCTION_TEST_PARAM(STRINGZ, pathFrom);
+        FUNCTION_TEST_PARAM(STRINGZ, pathTo);
+        FUNCTION_TEST_PARAM(BOOL, link);
+    FUNCTION_TEST_END();
+
+    ASSERT(ioUringLocal.renameAvailable);
+    ASSERT(pathFrom != NULL);
+    ASSERT(pathTo != NULL);
+
+    ioUringQueue(
+        op,
+        (struct io_uring_sqe)
+        {
+            .opcode = IORING_OP_RENAMEAT,
+            .fd = AT_FDCWD,
+            .addr = (uint64_t)(uintptr_t)pathFrom,
+            .len = (uint32_t)AT_FDCWD,
+            .addr2 = (uint64_t)(uintptr_t)pathTo,
+        },
+        link);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringWait(IoUringOp *const op)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+    FUNCTION_TEST_END();
+
+    ASSERT(op != NULL);
+
+    THROW_ON_SYS_ERROR(!ioUringProcess(op->data), KernelError, "unable to submit io_uring operations");
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN int
+ioUringResult(const IoUringOp *const op)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_URING_OP, op);
+    FUNCTION_TEST_END();
+
+    ASSERT(op != NULL && !op->data->busy);
+
+    if (op->data->result < 0)
+    {
+        errno = -op->data->result;
+        FUNCTION_TEST_RETURN(INT, -1);
+    }
+
+    FUNCTION_TEST_RETURN(INT, op->data->result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN unsigned char *
+ioUringBuffer(const unsigned int bufferIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, bufferIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(ioUringLocal.buffer != NULL);
+    ASSERT(bufferIdx < IO_URING_BUFFER_MAX);
+
+    FUNCTION_TEST_RETURN_P(UCHARDATA, ioUringLocal.buffer + ioUringLocal.bufferSize * bufferIdx);
+}
+
+FN_EXTERN size_t
+ioUringBufferSize(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ASSERT(ioUringLocal.buffer != NULL);
+
+    FUNCTION_TEST_RETURN(SIZE, ioUringLocal.bufferSize);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioUringEnabledSet(const bool enabled)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, enabled);
+    FUNCTION_TEST_END();
+
+    ioUringLocal.enabled = enabled;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+#endif // HAVE_IO_URING
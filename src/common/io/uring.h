@@ -0,0 +1,110 @@
+/***********************************************************************************************************************************
+io_uring Interface
+
+Minimal interface to the Linux io_uring API. A single ring is shared by all IO in the process and is created on first use after
+io_uring has been enabled. A small pool of IO buffers is registered with the ring so reads do not need to map user pages for every
+request. Callers must fall back to blocking IO when ioUringAvailable() returns false, e.g. when the kernel does not support io_uring
+or all buffers in the pool are in use.
+
+Operations are queued and then submitted in a batch by ioUringWait(), so multiple queued operations cost a single system call.
+Operations may be linked so the next operation starts only after the prior operation succeeds, which allows a dependent sequence of
+system calls (e.g. sync, close, rename, and path sync) to be submitted together.
+
+A ring inherited from a parent process is never used. The first call to ioUringAvailable() or ioUringWait() in a child process
+creates a new ring and operations queued by the parent are reported as cancelled.
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+
+#ifndef COMMON_IO_URING_H
+#define COMMON_IO_URING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/type/object.h"
+
+/***********************************************************************************************************************************
+Maximum number of buffers in the pool
+***********************************************************************************************************************************/
+#define IO_URING_BUFFER_MAX                                         8
+
+/***********************************************************************************************************************************
+Operation type. The operation is created in the current memory context but the kernel only writes completions to memory owned by
+the ring, so the operation may be freed at any time (e.g. when an error is thrown). An operation in progress is waited on before it
+is freed.
+***********************************************************************************************************************************/
+typedef struct IoUringOp IoUringOp;
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+FN_EXTERN IoUringOp *ioUringOpNew(void);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Is io_uring available? The ring is created on the first call after io_uring has been enabled.
+FN_EXTERN bool ioUringAvailable(void);
+
+// Is the rename operation available? Kernels before 5.11 support io_uring but not rename.
+FN_EXTERN bool ioUringRenameAvailable(void);
+
+// Get a buffer from the pool. Returns false if all buffers are in use.
+FN_EXTERN bool ioUringBufferGet(unsigned int *bufferIdx);
+
+// Return a buffer to the pool
+FN_EXTERN void ioUringBufferFree(unsigned int bufferIdx);
+
+// Queue a read into a pool buffer at the specified offset
+FN_EXTERN void ioUringRead(IoUringOp *op, int fd, unsigned int bufferIdx, size_t size, uint64_t offset);
+
+// Queue a sync of the file descriptor. When linked the next operation queued is cancelled if the sync fails.
+FN_EXTERN void ioUringSync(IoUringOp *op, int fd, bool link);
+
+// Queue a close of the file descriptor. When linked the next operation queued is cancelled if the close fails.
+FN_EXTERN void ioUringClose(IoUringOp *op, int fd, bool link);
+
+// Queue a rename. The paths are copied when the operation is submitted so they must remain valid until ioUringWait() is called.
+// When linked the next operation queued is cancelled if the rename fails.
+FN_EXTERN void ioUringRename(IoUringOp *op, const char *pathFrom, const char *pathTo, bool link);
+
+// Submit queued operations and wait for the operation to complete
+FN_EXTERN void ioUringWait(IoUringOp *op);
+
+// Get operation result. If the operation failed then errno is set and -1 is returned, like a system call. An operation that was
+// cancelled because a linked operation failed returns -1 with errno set to ECANCELED.
+FN_EXTERN int ioUringResult(const IoUringOp *op);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+// Pool buffer
+FN_EXTERN unsigned char *ioUringBuffer(unsigned int bufferIdx);
+
+// Size of each pool buffer
+FN_EXTERN size_t ioUringBufferSize(void);
+
+// Enable io_uring. This must be set before first use, usually from configuration.
+FN_EXTERN void ioUringEnabledSet(bool enabled);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+ioUringOpFree(IoUringOp *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_IO_URING_OP_TYPE                                                                                              \
+    IoUringOp *
+#define FUNCTION_LOG_IO_URING_OP_FORMAT(value, buffer, bufferSize)                                                                 \
+    objNameToLog(value, "IoUringOp", buffer, bufferSize)
+
+#endif
+
+#endif // HAVE_IO_URING
@@ -60,6 +60,8 @@ struct MemContext
     bool allocInitialized : 1;                                      // Has the allocation list been initialized?
     MemQty callbackQty : 2;                                         // How many callbacks can this context have?
     bool callbackInitialized : 1;                                   // Has the callback been initialized?
+    bool arena : 1;                                                 // Are allocations carved from an arena?
+    bool arenaRoot : 1;                                             // Does this context own the arena?
     size_t allocExtra : 16;                                         // Size of extra allocation (1kB max)
 
     unsigned int contextParentIdx;                                  // Index in the parent context list
@@ -101,6 +103,20 @@ typedef struct MemContextCallbackOne
     void *argument;                                                 // Argument to pass to callback function
 } MemContextCallbackOne;
 
+// Arena block. Blocks are linked so they can all be freed with the arena.
+typedef struct MemContextArenaBlock
+{
+    struct MemContextArenaBlock *prior;                             // Prior block in the arena
+    size_t size;                                                    // Size of the block (excluding this header)
+} MemContextArenaBlock;
+
+// Mem context that owns an arena
+typedef struct MemContextArena
+{
+    MemContextArenaBlock *block;                                    // Current block
+    size_t blockUsed;                                               // Bytes used in the current block
+} MemContextArena;
+
 /***********************************************************************************************************************************
 Possible sizes for the manifest based on options
 ***********************************************************************************************************************************/
@@ -183,6 +199,16 @@ memContextCallbackOne(MemContext *const memContext)
          memContextSizePossible[memContext->childQty][memContext->allocQty][0] + memContext->allocExtra);
 }
 
+// Get pointer to arena part (only present when the context owns the arena)
+static MemContextArena *
+memContextArena(MemContext *const memContext)
+{
+    return
+        (MemContextArena *)
+        ((unsigned char *)(memContext + 1) +
+         memContextSizePossible[memContext->childQty][memContext->allocQty][memContext->callbackQty] + memContext->allocExtra);
+}
+
 /***********************************************************************************************************************************
 Top context
 
@@ -390,6 +416,11 @@ memContextAuditAllocExtraName(void *const allocExtra, const char *const name)
 
 #endif
 
+/***********************************************************************************************************************************
+Allocation statistics
+***********************************************************************************************************************************/
+static MemContextStat memContextStatLocal;
+
 /***********************************************************************************************************************************
 Wrapper around malloc() with error handling
 ***********************************************************************************************************************************/
@@ -407,26 +438,7 @@ memAllocInternal(const size_t size)
     if (buffer == NULL)
         THROW_FMT(MemoryError, "unable to allocate %zu bytes", size);
 
-    // Return the buffer
-    FUNCTION_TEST_RETURN_P(VOID, buffer);
-}
-
-/***********************************************************************************************************************************
-Allocate an array of pointers and set all entries to NULL
-***********************************************************************************************************************************/
-static void *
-memAllocPtrArrayInternal(const size_t size)
-{
-    FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(SIZE, size);
-    FUNCTION_TEST_END();
-
-    // Allocate memory
-    void **const buffer = memAllocInternal(size * sizeof(void *));
-
-    // Set all pointers to NULL
-    for (size_t ptrIdx = 0; ptrIdx < size; ptrIdx++)
-        buffer[ptrIdx] = NULL;
+    memContextStatLocal.allocTotal++;
 
     // Return the buffer
     FUNCTION_TEST_RETURN_P(VOID, buffer);
@@ -452,50 +464,247 @@ memReAllocInternal(void *const bufferOld, const size_t sizeNew)
     if (bufferNew == NULL)
         THROW_FMT(MemoryError, "unable to reallocate %zu bytes", sizeNew);
 
+    memContextStatLocal.reAllocTotal++;
+
     // Return the buffer
     FUNCTION_TEST_RETURN_P(VOID, bufferNew);
 }
 
 /***********************************************************************************************************************************
-Wrapper around realloc() with error handling
+Wrapper around free()
+***********************************************************************************************************************************/
+static void
+memFreeInternal(void *const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(buffer != NULL);
+
+    free(buffer);
+
+    memContextStatLocal.freeTotal++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Find the context that owns the arena (NULL if the context is not in an arena)
+***********************************************************************************************************************************/
+static MemContext *
+memContextArenaRoot(MemContext *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (this->arena)
+    {
+        // Contexts carved from an arena can only have parents in the same arena so the owner must be found before leaving the arena
+        while (!this->arenaRoot)
+        {
+            this = this->contextParent;
+            ASSERT(this->arena);
+        }
+    }
+    else
+        this = NULL;
+
+    FUNCTION_TEST_RETURN(MEM_CONTEXT, this);
+}
+
+/***********************************************************************************************************************************
+Carve memory from the arena of a context
 ***********************************************************************************************************************************/
 static void *
-memReAllocPtrArrayInternal(void *const bufferOld, const size_t sizeOld, const size_t sizeNew)
+memContextArenaAlloc(MemContext *const memContext, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(memContext != NULL);
+    ASSERT(memContext->arena);
+
+    MemContextArena *const arena = memContextArena(memContextArenaRoot(memContext));
+    void *result;
+
+    // Round up the size so the next allocation will be aligned for any type stored in a mem context
+    if (size % ALIGN_OF(uint64_t) != 0)
+        size += ALIGN_OFFSET(uint64_t, size);
+
+    // Large allocations get their own block, which is linked behind the current block so the current block can still be used
+    if (arena->block != NULL && size > MEM_CONTEXT_ARENA_BLOCK_SIZE / 4)
+    {
+        MemContextArenaBlock *const block = memAllocInternal(sizeof(MemContextArenaBlock) + size);
+        *block = (MemContextArenaBlock){.prior = arena->block->prior, .size = size};
+
+        arena->block->prior = block;
+        memContextStatLocal.arenaBlockTotal++;
+
+        result = block + 1;
+    }
+    else
+    {
+        // Allocate a new block when there is not enough space left in the current block
+        if (arena->block == NULL || arena->blockUsed + size > arena->block->size)
+        {
+            const size_t blockSize = size > MEM_CONTEXT_ARENA_BLOCK_SIZE ? size : MEM_CONTEXT_ARENA_BLOCK_SIZE;
+            MemContextArenaBlock *const block = memAllocInternal(sizeof(MemContextArenaBlock) + blockSize);
+            *block = (MemContextArenaBlock){.prior = arena->block, .size = blockSize};
+
+            arena->block = block;
+            arena->blockUsed = 0;
+            memContextStatLocal.arenaBlockTotal++;
+        }
+
+        result = (unsigned char *)(arena->block + 1) + arena->blockUsed;
+        arena->blockUsed += size;
+    }
+
+    memContextStatLocal.arenaAllocTotal++;
+
+    FUNCTION_TEST_RETURN_P(VOID, result);
+}
+
+/***********************************************************************************************************************************
+Free all blocks in the arena owned by a context
+***********************************************************************************************************************************/
+static void
+memContextArenaFree(MemContext *const memContext)
 {
     FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+    FUNCTION_TEST_END();
+
+    ASSERT(memContext != NULL);
+    ASSERT(memContext->arenaRoot);
+
+    MemContextArena *const arena = memContextArena(memContext);
+
+    while (arena->block != NULL)
+    {
+        MemContextArenaBlock *const block = arena->block;
+
+        arena->block = block->prior;
+        memFreeInternal(block);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Allocate/reallocate/free memory owned by a context. Memory is carved from the arena when the context is in an arena.
+***********************************************************************************************************************************/
+static void *
+memContextAllocInternal(MemContext *const memContext, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(memContext != NULL);
+
+    FUNCTION_TEST_RETURN_P(VOID, memContext->arena ? memContextArenaAlloc(memContext, size) : memAllocInternal(size));
+}
+
+static void *
+memContextReAllocInternal(MemContext *const memContext, void *const bufferOld, const size_t sizeOld, const size_t sizeNew)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
         FUNCTION_TEST_PARAM_P(VOID, bufferOld);
         FUNCTION_TEST_PARAM(SIZE, sizeOld);
         FUNCTION_TEST_PARAM(SIZE, sizeNew);
     FUNCTION_TEST_END();
 
-    // Allocate memory
-    void **const bufferNew = memReAllocInternal(bufferOld, sizeNew * sizeof(void *));
+    ASSERT(memContext != NULL);
+    ASSERT(bufferOld != NULL);
 
-    // Set all new pointers to NULL
-    for (size_t ptrIdx = sizeOld; ptrIdx < sizeNew; ptrIdx++)
-        bufferNew[ptrIdx] = NULL;
+    void *bufferNew;
+
+    if (memContext->arena)
+    {
+        // Arena memory cannot be resized in place so copy to a new allocation. The old allocation is freed with the arena.
+        bufferNew = memContextArenaAlloc(memContext, sizeNew);
+        memcpy(bufferNew, bufferOld, sizeOld < sizeNew ? sizeOld : sizeNew);
+    }
+    else
+        bufferNew = memReAllocInternal(bufferOld, sizeNew);
 
-    // Return the buffer
     FUNCTION_TEST_RETURN_P(VOID, bufferNew);
 }
 
-/***********************************************************************************************************************************
-Wrapper around free()
-***********************************************************************************************************************************/
 static void
-memFreeInternal(void *const buffer)
+memContextFreeInternal(MemContext *const memContext, void *const buffer)
 {
     FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
         FUNCTION_TEST_PARAM_P(VOID, buffer);
     FUNCTION_TEST_END();
 
+    ASSERT(memContext != NULL);
     ASSERT(buffer != NULL);
 
-    free(buffer);
+    // Arena memory is freed with the arena
+    if (!memContext->arena)
+        memFreeInternal(buffer);
 
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Allocate an array of pointers and set all entries to NULL
+***********************************************************************************************************************************/
+static void *
+memAllocPtrArrayInternal(MemContext *const memContext, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    // Allocate memory
+    void **const buffer = memContextAllocInternal(memContext, size * sizeof(void *));
+
+    // Set all pointers to NULL
+    for (size_t ptrIdx = 0; ptrIdx < size; ptrIdx++)
+        buffer[ptrIdx] = NULL;
+
+    // Return the buffer
+    FUNCTION_TEST_RETURN_P(VOID, buffer);
+}
+
+/***********************************************************************************************************************************
+Reallocate an array of pointers and set all new entries to NULL
+***********************************************************************************************************************************/
+static void *
+memReAllocPtrArrayInternal(MemContext *const memContext, void *const bufferOld, const size_t sizeOld, const size_t sizeNew)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+        FUNCTION_TEST_PARAM_P(VOID, bufferOld);
+        FUNCTION_TEST_PARAM(SIZE, sizeOld);
+        FUNCTION_TEST_PARAM(SIZE, sizeNew);
+    FUNCTION_TEST_END();
+
+    // Allocate memory
+    void **const bufferNew = memContextReAllocInternal(
+        memContext, bufferOld, sizeOld * sizeof(void *), sizeNew * sizeof(void *));
+
+    // Set all new pointers to NULL
+    for (size_t ptrIdx = sizeOld; ptrIdx < sizeNew; ptrIdx++)
+        bufferNew[ptrIdx] = NULL;
+
+    // Return the buffer
+    FUNCTION_TEST_RETURN_P(VOID, bufferNew);
+}
+
 /***********************************************************************************************************************************
 Find space for a new mem context
 ***********************************************************************************************************************************/
@@ -515,7 +724,7 @@ memContextNewIndex(MemContext *const memContext, MemContextChildMany *const memC
     {
         *memContextChild = (MemContextChildMany)
         {
-            .list = memAllocPtrArrayInternal(MEM_CONTEXT_INITIAL_SIZE),
+            .list = memAllocPtrArrayInternal(memContext, MEM_CONTEXT_INITIAL_SIZE),
             .listSize = MEM_CONTEXT_INITIAL_SIZE,
         };
 
@@ -537,7 +746,8 @@ memContextNewIndex(MemContext *const memContext, MemContextChildMany *const memC
             const unsigned int listSizeNew = memContextChild->listSize * 2;
 
             // ReAllocate memory before modifying anything else in case there is an error
-            memContextChild->list = memReAllocPtrArrayInternal(memContextChild->list, memContextChild->listSize, listSizeNew);
+            memContextChild->list = memReAllocPtrArrayInternal(
+                memContext, memContextChild->list, memContextChild->listSize, listSizeNew);
 
             // Set new list size
             memContextChild->listSize = listSizeNew;
@@ -561,6 +771,7 @@ memContextNew(
         FUNCTION_TEST_PARAM(UINT, param.allocQty);
         FUNCTION_TEST_PARAM(UINT, param.callbackQty);
         FUNCTION_TEST_PARAM(SIZE, param.allocExtra);
+        FUNCTION_TEST_PARAM(BOOL, param.arena);
     FUNCTION_TEST_END();
 
     ASSERT(name != NULL);
@@ -585,8 +796,13 @@ memContextNew(
     const MemQty allocQty = param.allocQty > 1 ? memQtyMany : (MemQty)param.allocQty;
     const MemQty callbackQty = (MemQty)param.callbackQty;
 
-    MemContext *const this = memAllocInternal(
-        sizeof(MemContext) + allocExtra + memContextSizePossible[childQty][allocQty][callbackQty]);
+    // Contexts created in an arena are carved from the arena. Otherwise a new arena is created if requested.
+    const bool arenaRoot = param.arena && !contextCurrent->arena;
+    const size_t size =
+        sizeof(MemContext) + allocExtra + memContextSizePossible[childQty][allocQty][callbackQty] +
+        (arenaRoot ? sizeof(MemContextArena) : 0);
+
+    MemContext *const this = memContextAllocInternal(contextCurrent, size);
 
     *this = (MemContext)
     {
@@ -604,6 +820,8 @@ memContextNew(
         .childQty = childQty,
         .allocQty = allocQty,
         .callbackQty = callbackQty,
+        .arena = contextCurrent->arena || arenaRoot,
+        .arenaRoot = arenaRoot,
 
         // Set extra allocation
         .allocExtra = (uint16_t)allocExtra,
@@ -612,6 +830,9 @@ memContextNew(
         .contextParent = contextCurrent,
     };
 
+    if (arenaRoot)
+        *memContextArena(this) = (MemContextArena){0};
+
     // Find space for the new context
     if (contextCurrent->childQty == memQtyOne)
     {
@@ -732,13 +953,13 @@ memContextAllocNew(const size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
-    // Allocate memory
-    MemContextAlloc *const result = memAllocInternal(sizeof(MemContextAlloc) + size);
-
-    // Find space for the new allocation
     MemContext *const contextCurrent = memContextStack[memContextCurrentStackIdx].memContext;
     ASSERT(contextCurrent->allocQty != memQtyNone);
 
+    // Allocate memory
+    MemContextAlloc *const result = memContextAllocInternal(contextCurrent, sizeof(MemContextAlloc) + size);
+
+    // Find space for the new allocation
     if (contextCurrent->allocQty == memQtyOne)
     {
         MemContextAllocOne *const contextAlloc = memContextAllocOne(contextCurrent);
@@ -762,7 +983,7 @@ memContextAllocNew(const size_t size)
         {
             *contextAlloc = (MemContextAllocMany)
             {
-                .list = memAllocPtrArrayInternal(MEM_CONTEXT_ALLOC_INITIAL_SIZE),
+                .list = memAllocPtrArrayInternal(contextCurrent, MEM_CONTEXT_ALLOC_INITIAL_SIZE),
                 .listSize = contextAlloc->listSize = MEM_CONTEXT_ALLOC_INITIAL_SIZE,
             };
 
@@ -781,7 +1002,8 @@ memContextAllocNew(const size_t size)
                 const unsigned int listSizeNew = contextAlloc->listSize * 2;
 
                 // Reallocate memory before modifying anything else in case there is an error
-                contextAlloc->list = memReAllocPtrArrayInternal(contextAlloc->list, contextAlloc->listSize, listSizeNew);
+                contextAlloc->list = memReAllocPtrArrayInternal(
+                    contextCurrent, contextAlloc->list, contextAlloc->listSize, listSizeNew);
 
                 // Set new size
                 contextAlloc->listSize = listSizeNew;
@@ -812,15 +1034,15 @@ memContextAllocResize(MemContextAlloc *alloc, const size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
-    // Resize the allocation
-    alloc = memReAllocInternal(alloc, sizeof(MemContextAlloc) + size);
-    alloc->size = (unsigned int)(sizeof(MemContextAlloc) + size);
-
-    // Update pointer in allocation list in case the realloc moved the allocation
     MemContext *const currentContext = memContextStack[memContextCurrentStackIdx].memContext;
     ASSERT(currentContext->allocQty != memQtyNone);
     ASSERT(currentContext->allocInitialized);
 
+    // Resize the allocation
+    alloc = memContextReAllocInternal(currentContext, alloc, alloc->size, sizeof(MemContextAlloc) + size);
+    alloc->size = (unsigned int)(sizeof(MemContextAlloc) + size);
+
+    // Update pointer in allocation list in case the realloc moved the allocation
     if (currentContext->allocQty == memQtyOne)
     {
         ASSERT(memContextAllocOne(currentContext)->alloc != NULL);
@@ -914,7 +1136,7 @@ memFree(void *const buffer)
     }
 
     // Free the allocation
-    memFreeInternal(alloc);
+    memContextFreeInternal(contextCurrent, alloc);
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -933,6 +1155,12 @@ memContextMove(MemContext *const this, MemContext *const parentNew)
     // Only move if a valid mem context is provided and the old and new parents are not the same
     if (this != NULL && this->contextParent != parentNew)
     {
+        // Contexts carved from an arena cannot be moved out of the arena since their memory will be freed with the arena
+        CHECK(
+            AssertError,
+            !this->arena || this->arenaRoot || memContextArenaRoot(parentNew) == memContextArenaRoot(this->contextParent),
+            "cannot move context out of arena");
+
         ASSERT(this->active);
         ASSERT(this->contextParent->active);
         ASSERT(this->contextParent->childQty != memQtyNone);
@@ -1195,11 +1423,23 @@ memContextSize(const MemContext *const this)
     if (this->callbackQty != memQtyNone)
         offset += sizeof(MemContextCallbackOne);
 
+    // Size of arena
+    if (this->arenaRoot)
+        offset += sizeof(MemContextArena);
+
     FUNCTION_TEST_RETURN(SIZE, (size_t)(offset - (unsigned char *)this) + total);
 }
 
 #endif // DEBUG
 
+/**********************************************************************************************************************************/
+FN_EXTERN MemContextStat
+memContextStat(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN_TYPE(MemContextStat, memContextStatLocal);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 memContextClean(const unsigned int tryDepth, const bool fatal)
@@ -1324,12 +1564,12 @@ memContextFreeRecurse(MemContext *const this)
             }
 
             // Free child context allocation list
-            memFreeInternal(memContextChildMany(this)->list);
+            memContextFreeInternal(this, memContextChildMany(this)->list);
         }
     }
 
-    // Free memory allocations and list
-    if (this->allocInitialized)
+    // Free memory allocations and list. Allocations in an arena are freed with the arena.
+    if (this->allocInitialized && !this->arena)
     {
         ASSERT(this->allocQty != memQtyNone);
 
@@ -1374,7 +1614,13 @@ memContextFreeRecurse(MemContext *const this)
             memContextChildMany(this->contextParent)->list[this->contextParentIdx] = NULL;
         }
 
-        memFreeInternal(this);
+        // Free the arena, which frees all the memory carved from it
+        if (this->arenaRoot)
+            memContextArenaFree(this);
+
+        // Free the context unless it was carved from an arena
+        if (!this->arena || this->arenaRoot)
+            memFreeInternal(this);
     }
     // Else reset top context. In practice it is uncommon for the top mem context to be freed and then used again.
     else
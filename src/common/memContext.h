@@ -38,6 +38,14 @@ Space is reserved for this many allocations when a context is created. When more
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_ALLOC_INITIAL_SIZE                              4
 
+/***********************************************************************************************************************************
+Define arena block size
+
+Arena contexts carve allocations from blocks of this size. Allocations larger than a quarter of the block size get a block of their
+own so a large allocation does not waste the remainder of the current block.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_ARENA_BLOCK_SIZE                                ((size_t)64 * 1024)
+
 /***********************************************************************************************************************************
 Functions and macros to audit a mem context by detecting new child contexts/allocations that were created begin the begin/end but
 are not the expected return type.
@@ -181,6 +189,27 @@ MEM_CONTEXT_TEMP_END();
             "temporary", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX);                                        \
         memContextSwitch(MEM_CONTEXT_TEMP());
 
+/***********************************************************************************************************************************
+Create a temporary arena memory context and make sure it is freed when done (even on error)
+
+MEM_CONTEXT_TEMP_ARENA_BEGIN()
+{
+    <An arena temp memory context is now the current context>
+}
+MEM_CONTEXT_TEMP_END();
+
+Allocations and child contexts created in an arena context are carved from large blocks that are freed all at once with the context,
+which is much cheaper than calling malloc()/free() for each allocation. However, memory released with memFree()/memResize() is not
+reused until the arena is freed and contexts created in the arena cannot be moved out of it (memContextMove() will error). Use this
+only for short-lived contexts in hot loops where nothing created in the context needs to outlive it.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_TEMP_ARENA_BEGIN()                                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        MemContext *MEM_CONTEXT_TEMP() = memContextNewP(                                                                           \
+            "temporary", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX, .arena = true);                         \
+        memContextSwitch(MEM_CONTEXT_TEMP());
+
 #define MEM_CONTEXT_TEMP_RESET_BEGIN()                                                                                             \
     MEM_CONTEXT_TEMP_BEGIN()                                                                                                       \
     unsigned int MEM_CONTEXT_TEMP_loopTotal = 0;
@@ -236,6 +265,7 @@ typedef struct MemContextNewParam
     uint8_t allocQty;                                               // How many allocations can this context have?
     uint8_t callbackQty;                                            // How many callbacks can this context have?
     uint16_t allocExtra;                                            // Extra memory to allocate with the context
+    bool arena;                                                     // Carve allocations from blocks freed with the context?
 } MemContextNewParam;
 
 // Maximum amount of extra memory that can be allocated with the context using allocExtra
@@ -315,6 +345,21 @@ FN_EXTERN MemContext *memContextTop(void);
 FN_EXTERN size_t memContextSize(const MemContext *this);
 #endif // DEBUG
 
+/***********************************************************************************************************************************
+Memory allocation statistics
+***********************************************************************************************************************************/
+typedef struct MemContextStat
+{
+    uint64_t allocTotal;                                            // Allocations from the system allocator
+    uint64_t reAllocTotal;                                          // Reallocations from the system allocator
+    uint64_t freeTotal;                                             // Frees to the system allocator
+    uint64_t arenaAllocTotal;                                       // Allocations carved from arena blocks
+    uint64_t arenaBlockTotal;                                       // Arena blocks allocated
+} MemContextStat;
+
+// Get cumulative allocation statistics for the process
+FN_EXTERN MemContextStat memContextStat(void);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
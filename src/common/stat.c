@@ -135,3 +135,40 @@ statToJson(void)
 
     FUNCTION_TEST_RETURN(STRING, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+statMemToJson(void)
+{
+    FUNCTION_TEST_VOID();
+
+    // Get stats before any allocations are made for the output
+    const MemContextStat memStat = memContextStat();
+    String *const result = strNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Stat statList[] =
+        {
+            {.key = STRDEF("mem.alloc"), .total = memStat.allocTotal},
+            {.key = STRDEF("mem.arena.alloc"), .total = memStat.arenaAllocTotal},
+            {.key = STRDEF("mem.arena.block"), .total = memStat.arenaBlockTotal},
+            {.key = STRDEF("mem.free"), .total = memStat.freeTotal},
+            {.key = STRDEF("mem.realloc"), .total = memStat.reAllocTotal},
+        };
+
+        JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP(.json = result));
+
+        for (unsigned int statIdx = 0; statIdx < LENGTH_OF(statList); statIdx++)
+        {
+            jsonWriteObjectBegin(jsonWriteKey(json, statList[statIdx].key));
+            jsonWriteUInt64(jsonWriteKeyZ(json, "total"), statList[statIdx].total);
+            jsonWriteObjectEnd(json);
+        }
+
+        jsonWriteObjectEnd(json);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STRING, result);
+}
@@ -26,4 +26,8 @@ FN_EXTERN void statInc(const String *key);
 // Output stats to JSON
 FN_EXTERN String *statToJson(void);
 
+// Output memory allocation stats to JSON. These are counted by the mem context manager since allocations are too frequent to be
+// counted with statInc().
+FN_EXTERN String *statMemToJson(void);
+
 #endif
@@ -48,13 +48,19 @@ Option constants
 #define CFGOPT_ARCHIVE_ASYNC                                        "archive-async"
 #define CFGOPT_ARCHIVE_CHECK                                        "archive-check"
 #define CFGOPT_ARCHIVE_COPY                                         "archive-copy"
+#define CFGOPT_ARCHIVE_GET_LINGER                                   "archive-get-linger"
+#define CFGOPT_ARCHIVE_GET_LIST_CACHE                               "archive-get-list-cache"
 #define CFGOPT_ARCHIVE_GET_QUEUE_MAX                                "archive-get-queue-max"
 #define CFGOPT_ARCHIVE_HEADER_CHECK                                 "archive-header-check"
 #define CFGOPT_ARCHIVE_MISSING_RETRY                                "archive-missing-retry"
 #define CFGOPT_ARCHIVE_MODE                                         "archive-mode"
 #define CFGOPT_ARCHIVE_MODE_CHECK                                   "archive-mode-check"
+#define CFGOPT_ARCHIVE_PUSH_BUNDLE_MAX                              "archive-push-bundle-max"
+#define CFGOPT_ARCHIVE_PUSH_LINGER                                  "archive-push-linger"
 #define CFGOPT_ARCHIVE_PUSH_QUEUE_MAX                               "archive-push-queue-max"
+#define CFGOPT_ARCHIVE_RECORD_CHECK                                 "archive-record-check"
 #define CFGOPT_ARCHIVE_TIMEOUT                                      "archive-timeout"
+#define CFGOPT_BACKUP_BUILD_CACHE                                   "backup-build-cache"
 #define CFGOPT_BACKUP_STANDBY                                       "backup-standby"
 #define CFGOPT_BETA                                                 "beta"
 #define CFGOPT_BUFFER_SIZE                                          "buffer-size"
@@ -65,7 +71,9 @@ Option constants
 #define CFGOPT_COMPRESS                                             "compress"
 #define CFGOPT_COMPRESS_LEVEL                                       "compress-level"
 #define CFGOPT_COMPRESS_LEVEL_NETWORK                               "compress-level-network"
+#define CFGOPT_COMPRESS_THREAD                                      "compress-thread"
 #define CFGOPT_COMPRESS_TYPE                                        "compress-type"
+#define CFGOPT_COMPRESS_TYPE_NETWORK                                "compress-type-network"
 #define CFGOPT_CONFIG                                               "config"
 #define CFGOPT_CONFIG_INCLUDE_PATH                                  "config-include-path"
 #define CFGOPT_CONFIG_PATH                                          "config-path"
@@ -80,7 +88,9 @@ Option constants
 #define CFGOPT_FILTER                                               "filter"
 #define CFGOPT_FORCE                                                "force"
 #define CFGOPT_IGNORE_MISSING                                       "ignore-missing"
+#define CFGOPT_IO_CACHE_DROP                                        "io-cache-drop"
 #define CFGOPT_IO_TIMEOUT                                           "io-timeout"
+#define CFGOPT_IO_URING                                             "io-uring"
 #define CFGOPT_JOB_RETRY                                            "job-retry"
 #define CFGOPT_JOB_RETRY_INTERVAL                                   "job-retry-interval"
 #define CFGOPT_LINK_ALL                                             "link-all"
@@ -115,6 +125,7 @@ Option constants
 #define CFGOPT_SET                                                  "set"
 #define CFGOPT_SORT                                                 "sort"
 #define CFGOPT_SPOOL_PATH                                           "spool-path"
+#define CFGOPT_SSH_MUX                                              "ssh-mux"
 #define CFGOPT_STANZA                                               "stanza"
 #define CFGOPT_START_FAST                                           "start-fast"
 #define CFGOPT_STOP_AUTO                                            "stop-auto"
@@ -136,7 +147,7 @@ Option constants
 #define CFGOPT_TYPE                                                 "type"
 #define CFGOPT_VERBOSE                                              "verbose"
 
-#define CFG_OPTION_TOTAL                                            180
+#define CFG_OPTION_TOTAL                                            195
 
 /***********************************************************************************************************************************
 Option value constants
@@ -157,6 +168,15 @@ Option value constants
 #define CFGOPTVAL_COMPRESS_TYPE_ZST                                 STRID5("zst", 0x527a0)
 #define CFGOPTVAL_COMPRESS_TYPE_ZST_Z                               "zst"
 
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_GZ                          STRID5("gz", 0x3470)
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_GZ_Z                        "gz"
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_LZ4                         STRID6("lz4", 0x2068c1)
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_LZ4_Z                       "lz4"
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_NONE                        STRID5("none", 0x2b9ee0)
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_NONE_Z                      "none"
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_ZST                         STRID5("zst", 0x527a0)
+#define CFGOPTVAL_COMPRESS_TYPE_NETWORK_ZST_Z                       "zst"
+
 #define CFGOPTVAL_LOG_LEVEL_CONSOLE_DEBUG                           STRID5("debug", 0x7a88a40)
 #define CFGOPTVAL_LOG_LEVEL_CONSOLE_DEBUG_Z                         "debug"
 #define CFGOPTVAL_LOG_LEVEL_CONSOLE_DETAIL                          STRID5("detail", 0x1890d0a40)
@@ -231,6 +251,8 @@ Option value constants
 
 #define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC                      STRID5("aes-256-cbc", 0xc43dfbbcdcca10)
 #define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC_Z                    "aes-256-cbc"
+#define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM                      STRID5("aes-256-gcm", 0x3467dfbbcdcca10)
+#define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM_Z                    "aes-256-gcm"
 #define CFGOPTVAL_REPO_CIPHER_TYPE_NONE                             STRID5("none", 0x2b9ee0)
 #define CFGOPTVAL_REPO_CIPHER_TYPE_NONE_Z                           "none"
 
@@ -388,13 +410,19 @@ typedef enum
     cfgOptArchiveAsync,
     cfgOptArchiveCheck,
     cfgOptArchiveCopy,
+    cfgOptArchiveGetLinger,
+    cfgOptArchiveGetListCache,
     cfgOptArchiveGetQueueMax,
     cfgOptArchiveHeaderCheck,
     cfgOptArchiveMissingRetry,
     cfgOptArchiveMode,
     cfgOptArchiveModeCheck,
+    cfgOptArchivePushBundleMax,
+    cfgOptArchivePushLinger,
     cfgOptArchivePushQueueMax,
+    cfgOptArchiveRecordCheck,
     cfgOptArchiveTimeout,
+    cfgOptBackupBuildCache,
     cfgOptBackupStandby,
     cfgOptBeta,
     cfgOptBufferSize,
@@ -405,7 +433,9 @@ typedef enum
     cfgOptCompress,
     cfgOptCompressLevel,
     cfgOptCompressLevelNetwork,
+    cfgOptCompressThread,
     cfgOptCompressType,
+    cfgOptCompressTypeNetwork,
     cfgOptConfig,
     cfgOptConfigIncludePath,
     cfgOptConfigPath,
@@ -420,7 +450,9 @@ typedef enum
     cfgOptFilter,
     cfgOptForce,
     cfgOptIgnoreMissing,
+    cfgOptIoCacheDrop,
     cfgOptIoTimeout,
+    cfgOptIoUring,
     cfgOptJobRetry,
     cfgOptJobRetryInterval,
     cfgOptLinkAll,
@@ -478,6 +510,8 @@ typedef enum
     cfgOptRepoBlockSizeMap,
     cfgOptRepoBlockSizeSuper,
     cfgOptRepoBlockSizeSuperFull,
+    cfgOptRepoBlockSplitSize,
+    cfgOptRepoBlockStore,
     cfgOptRepoBundle,
     cfgOptRepoBundleLimit,
     cfgOptRepoBundleSize,
@@ -533,8 +567,10 @@ typedef enum
     cfgOptRepoStorageCaPath,
     cfgOptRepoStorageHost,
     cfgOptRepoStoragePort,
+    cfgOptRepoStorageRequestMax,
     cfgOptRepoStorageTag,
     cfgOptRepoStorageUploadChunkSize,
+    cfgOptRepoStorageUploadMax,
     cfgOptRepoStorageVerifyTls,
     cfgOptRepoType,
     cfgOptReport,
@@ -544,6 +580,7 @@ typedef enum
     cfgOptSet,
     cfgOptSort,
     cfgOptSpoolPath,
+    cfgOptSshMux,
     cfgOptStanza,
     cfgOptStartFast,
     cfgOptStopAuto,
@@ -14,6 +14,7 @@ Configuration Load
 #include "common/debug.h"
 #include "common/io/io.h"
 #include "common/io/socket/common.h"
+#include "common/io/uring.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "config/config.intern.h"
@@ -166,6 +167,24 @@ cfgLoadUpdateOption(void)
         }
     }
 
+    // Archive get/push linger should be less than protocol timeout since idle local processes will exit after protocol timeout
+    static const ConfigOption lingerOptionList[] = {cfgOptArchiveGetLinger, cfgOptArchivePushLinger};
+
+    for (unsigned int lingerIdx = 0; lingerIdx < LENGTH_OF(lingerOptionList); lingerIdx++)
+    {
+        const ConfigOption lingerOption = lingerOptionList[lingerIdx];
+
+        if (cfgOptionTest(lingerOption) && cfgOptionUInt64(lingerOption) >= cfgOptionUInt64(cfgOptProtocolTimeout))
+        {
+            THROW_FMT(
+                OptionInvalidValueError,
+                "'%s' is not valid for '%s' option\nHINT '%s' option (%s) should be less than '" CFGOPT_PROTOCOL_TIMEOUT "' option"
+                " (%s).",
+                strZ(cfgOptionDisplay(lingerOption)), cfgOptionName(lingerOption), cfgOptionName(lingerOption),
+                strZ(cfgOptionDisplay(lingerOption)), strZ(cfgOptionDisplay(cfgOptProtocolTimeout)));
+        }
+    }
+
     // Make sure that repo and pg host settings are not both set - cannot both be remote
     if (cfgOptionValid(cfgOptPgHost) && cfgOptionValid(cfgOptRepoHost))
     {
@@ -389,6 +408,31 @@ cfgLoadUpdateOption(void)
         }
     }
 
+    // Update compress-level-network default when the network compression type is not gz. The gz default is tuned for the network
+    // but the other types have their own defaults, all of which fall within the range allowed for compress-level-network.
+    if (cfgOptionValid(cfgOptCompressTypeNetwork) && cfgOptionSource(cfgOptCompressLevelNetwork) == cfgSourceDefault)
+    {
+        const CompressType compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressTypeNetwork));
+
+        if (compressType != compressTypeGz && compressType != compressTypeNone)
+            cfgOptionSet(cfgOptCompressLevelNetwork, cfgSourceDefault, VARINT64(compressLevelDefault(compressType)));
+    }
+
+    // Error if repo-block-store is enabled on an encrypted repo since blocks in the store are shared by all backups
+    if (cfgOptionValid(cfgOptRepoBlockStore))
+    {
+        for (unsigned int repoIdx = 0; repoIdx < cfgOptionGroupIdxTotal(cfgOptGrpRepo); repoIdx++)
+        {
+            if (cfgOptionIdxBool(cfgOptRepoBlockStore, repoIdx) &&
+                cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx) != CFGOPTVAL_REPO_CIPHER_TYPE_NONE)
+            {
+                THROW_FMT(
+                    OptionInvalidError, "option '%s' not valid with option '%s'", cfgOptionIdxName(cfgOptRepoBlockStore, repoIdx),
+                    cfgOptionIdxName(cfgOptRepoCipherType, repoIdx));
+            }
+        }
+    }
+
     // Error if repo-sftp--host-key-check-type is explicitly set to anything other than fingerprint and repo-sftp-host-fingerprint
     // is also specified. For backward compatibility we need to allow repo-sftp-host-fingerprint when
     // repo-sftp-host-key-check-type defaults to yes, but emit a warning to let the user know to change the configuration. Also
@@ -548,6 +592,16 @@ cfgLoad(const unsigned int argListSize, const char *argList[])
             if (cfgOptionValid(cfgOptIoTimeout))
                 ioTimeoutMsSet(cfgOptionUInt64(cfgOptIoTimeout));
 
+            // Set page cache drop
+            if (cfgOptionValid(cfgOptIoCacheDrop))
+                ioCacheDropSet(cfgOptionBool(cfgOptIoCacheDrop));
+
+#ifdef HAVE_IO_URING
+            // Enable io_uring
+            if (cfgOptionValid(cfgOptIoUring))
+                ioUringEnabledSet(cfgOptionBool(cfgOptIoUring));
+#endif
+
             // Open the log file if this command logs to a file
             cfgLoadLogFile();
 
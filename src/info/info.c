@@ -102,7 +102,7 @@ infoNew(const String *const cipherPass)
 
     OBJ_NEW_BEGIN(Info, .childQty = MEM_CONTEXT_QTY_MAX)
     {
-        *this = (Info){};
+        *this = (Info){.pub = {.cipherType = cipherTypeAes256Cbc}};
 
         // Cipher used to encrypt/decrypt subsequent dependent files. Value may be NULL.
         infoCipherPassSet(this, cipherPass);
@@ -118,6 +118,12 @@ infoNew(const String *const cipherPass)
 #define INFO_KEY_CHECKSUM                                           "backrest-checksum"
 #define INFO_SECTION_CIPHER                                         "cipher"
 #define INFO_KEY_CIPHER_PASS                                        "cipher-pass"
+#define INFO_KEY_CIPHER_TYPE                                        "cipher-type"
+
+// Format of files that store the cipher type. Versions that do not know the cipher type would ignore it and decrypt dependent files
+// with the configured type, so the format is incremented to make them refuse to read the file instead. Files that do not store the
+// cipher type keep the repository format.
+#define INFO_FORMAT_CIPHER_TYPE                                     (REPOSITORY_FORMAT + 1)
 
 FN_EXTERN Info *
 infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, void *const callbackData)
@@ -136,13 +142,16 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
 
     OBJ_NEW_BEGIN(Info, .childQty = MEM_CONTEXT_QTY_MAX)
     {
-        *this = (Info){};
+        // The cipher type is only stored when it is not the default
+        *this = (Info){.pub = {.cipherType = cipherTypeAes256Cbc}};
 
         MEM_CONTEXT_TEMP_BEGIN()
         {
             String *const sectionLast = strNew();                               // The last section seen during load
             IoFilter *const checksumActualFilter = cryptoHashNew(hashTypeSha1); // Checksum calculated from the file
             const String *checksumExpected = NULL;                              // Checksum found in ini file
+            bool formatCipherType = false;                                      // Does the format require the cipher type?
+            bool cipherTypeFound = false;                                       // Was the cipher type found?
 
             INFO_CHECKSUM_BEGIN(checksumActualFilter);
 
@@ -179,12 +188,12 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
                             // Validate format
                             if (strEqZ(value->key, INFO_KEY_FORMAT))
                             {
-                                if (varUInt64(jsonToVar(value->value)) != REPOSITORY_FORMAT)
-                                {
-                                    THROW_FMT(
-                                        FormatError, "expected format %d but found %" PRIu64, REPOSITORY_FORMAT,
-                                        varUInt64(jsonToVar(value->value)));
-                                }
+                                const uint64_t format = varUInt64(jsonToVar(value->value));
+
+                                if (format != REPOSITORY_FORMAT && format != INFO_FORMAT_CIPHER_TYPE)
+                                    THROW_FMT(FormatError, "expected format %d but found %" PRIu64, REPOSITORY_FORMAT, format);
+
+                                formatCipherType = format == INFO_FORMAT_CIPHER_TYPE;
                             }
                             // Store pgBackRest version
                             else if (strEqZ(value->key, INFO_KEY_VERSION))
@@ -217,6 +226,17 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
                                 }
                                 MEM_CONTEXT_END();
                             }
+                            // Validate cipher type
+                            else if (strEqZ(value->key, INFO_KEY_CIPHER_TYPE))
+                            {
+                                const String *const cipherType = varStr(jsonToVar(value->value));
+
+                                if (!strEqZ(cipherType, "aes-256-gcm") && !strEqZ(cipherType, "aes-256-cbc"))
+                                    THROW_FMT(FormatError, "invalid cipher type '%s'", strZ(cipherType));
+
+                                this->pub.cipherType = strIdFromStr(cipherType);
+                                cipherTypeFound = true;
+                            }
                         }
                         // Else pass to callback for processing
                         else
@@ -234,6 +254,9 @@ infoNewLoad(IoRead *const read, InfoLoadNewCallback *const callbackFunction, voi
             }
             TRY_END();
 
+            // The cipher type must be stored with its format and only with its format
+            CHECK(FormatError, formatCipherType == cipherTypeFound, "format does not match cipher type");
+
             INFO_CHECKSUM_END(checksumActualFilter);
 
             // Verify the checksum
@@ -360,9 +383,14 @@ infoSave(Info *const this, IoWrite *const write, InfoSaveCallback *const callbac
         data.checksum = cryptoHashNew(hashTypeSha1);
         INFO_CHECKSUM_BEGIN(data.checksum);
 
-        // Add version and format
+        // Add version and format. The cipher type is only stored when it is not the default so files remain readable by versions
+        // that do not store it.
+        const bool cipherTypeSave = infoCipherPass(this) != NULL && infoCipherType(this) != cipherTypeAes256Cbc;
+
         callbackFunction(callbackData, STRDEF(INFO_SECTION_BACKREST), &data);
-        infoSaveValue(&data, INFO_SECTION_BACKREST, INFO_KEY_FORMAT, jsonFromVar(VARUINT(REPOSITORY_FORMAT)));
+        infoSaveValue(
+            &data, INFO_SECTION_BACKREST, INFO_KEY_FORMAT,
+            jsonFromVar(VARUINT(cipherTypeSave ? INFO_FORMAT_CIPHER_TYPE : REPOSITORY_FORMAT)));
         infoSaveValue(&data, INFO_SECTION_BACKREST, INFO_KEY_VERSION, jsonFromVar(VARSTRDEF(PROJECT_VERSION)));
 
         // Add cipher passphrase if defined
@@ -370,6 +398,12 @@ infoSave(Info *const this, IoWrite *const write, InfoSaveCallback *const callbac
         {
             callbackFunction(callbackData, STRDEF(INFO_SECTION_CIPHER), &data);
             infoSaveValue(&data, INFO_SECTION_CIPHER, INFO_KEY_CIPHER_PASS, jsonFromVar(VARSTR(infoCipherPass(this))));
+
+            if (cipherTypeSave)
+            {
+                infoSaveValue(
+                    &data, INFO_SECTION_CIPHER, INFO_KEY_CIPHER_TYPE, jsonFromVar(VARSTR(strIdToStr(infoCipherType(this)))));
+            }
         }
 
         // Flush out any additional sections
@@ -415,6 +449,22 @@ infoCipherPassSet(Info *const this, const String *const cipherPass)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+FN_EXTERN void
+infoCipherTypeSet(Info *const this, const CipherType cipherType)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO, this);
+        FUNCTION_TEST_PARAM(STRING_ID, cipherType);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(cipherType != cipherTypeNone);
+
+    this->pub.cipherType = cipherType;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 infoLoad(const String *const error, InfoLoadCallback *const callbackFunction, void *const callbackData)
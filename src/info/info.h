@@ -10,6 +10,7 @@ Object type
 typedef struct Info Info;
 typedef struct InfoSave InfoSave;
 
+#include "common/crypto/common.h"
 #include "common/ini.h"
 #include "storage/storage.h"
 
@@ -49,6 +50,7 @@ typedef struct InfoPub
 {
     const String *backrestVersion;                                  // pgBackRest version
     const String *cipherPass;                                       // Cipher passphrase if set
+    CipherType cipherType;                                          // Cipher type used with the passphrase
 } InfoPub;
 
 // Cipher passphrase if set
@@ -60,6 +62,16 @@ infoCipherPass(const Info *const this)
 
 FN_EXTERN void infoCipherPassSet(Info *this, const String *cipherPass);
 
+// Cipher type used to encrypt dependent files with the passphrase. Files written before the cipher type was stored always used
+// aes-256-cbc.
+FN_INLINE_ALWAYS CipherType
+infoCipherType(const Info *const this)
+{
+    return infoCipherPass(this) == NULL ? cipherTypeNone : THIS_PUB(Info)->cipherType;
+}
+
+FN_EXTERN void infoCipherTypeSet(Info *this, CipherType cipherType);
+
 // pgBackRest version
 FN_INLINE_ALWAYS const String *
 infoBackrestVersion(const Info *const this)
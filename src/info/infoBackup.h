@@ -108,6 +108,13 @@ infoBackupCipherPass(const InfoBackup *const this)
     return infoPgCipherPass(infoBackupPg(this));
 }
 
+// Cipher type used with the cipher passphrase
+FN_INLINE_ALWAYS CipherType
+infoBackupCipherType(const InfoBackup *const this)
+{
+    return infoPgCipherType(infoBackupPg(this));
+}
+
 // Return a structure of the backup data from a specific index
 FN_EXTERN InfoBackupData infoBackupData(const InfoBackup *this, unsigned int backupDataIdx);
 
@@ -78,6 +78,13 @@ infoPgCipherPass(const InfoPg *const this)
     return infoCipherPass(infoPgInfo(this));
 }
 
+// Return the cipher type used with the cipher passphrase
+FN_INLINE_ALWAYS CipherType
+infoPgCipherType(const InfoPg *const this)
+{
+    return infoCipherType(infoPgInfo(this));
+}
+
 // Return current pgId from the history
 FN_EXTERN unsigned int infoPgCurrentDataId(const InfoPg *this);
 
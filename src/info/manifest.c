@@ -770,6 +770,169 @@ manifestLinkCheck(const Manifest *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Build cache
+***********************************************************************************************************************************/
+// Increment the version when the format changes so prior caches will be ignored
+#define MANIFEST_BUILD_CACHE_VERSION                                1
+
+struct ManifestBuildCache
+{
+    List *pathList;                                                 // Paths found during the prior build
+};
+
+typedef struct ManifestBuildCachePath
+{
+    const String *path;                                             // Path (must be first member in struct)
+    time_t timeModified;                                            // Path modification time when listed
+    time_t timeList;                                                // Time when path was listed
+    StringList *nameList;                                           // Names found in the path
+} ManifestBuildCachePath;
+
+FN_EXTERN ManifestBuildCache *
+manifestBuildCacheNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    OBJ_NEW_BEGIN(ManifestBuildCache, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (ManifestBuildCache)
+        {
+            .pathList = lstNewP(sizeof(ManifestBuildCachePath), .sortOrder = sortOrderAsc, .comparator = lstComparatorStr),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_TEST_RETURN(MANIFEST_BUILD_CACHE, this);
+}
+
+// Add a path to a build cache path list
+static void
+manifestBuildCachePathAdd(
+    List *const pathList, const String *const path, const time_t timeModified, const time_t timeList, StringList *const nameList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, pathList);
+        FUNCTION_TEST_PARAM(STRING, path);
+        FUNCTION_TEST_PARAM(TIME, timeModified);
+        FUNCTION_TEST_PARAM(TIME, timeList);
+        FUNCTION_TEST_PARAM(STRING_LIST, nameList);
+    FUNCTION_TEST_END();
+
+    ASSERT(pathList != NULL);
+    ASSERT(path != NULL);
+    ASSERT(nameList != NULL);
+
+    MEM_CONTEXT_OBJ_BEGIN(pathList)
+    {
+        const ManifestBuildCachePath cachePath =
+        {
+            .path = strDup(path),
+            .timeModified = timeModified,
+            .timeList = timeList,
+            .nameList = strLstMove(nameList, objMemContext(pathList)),
+        };
+
+        lstAdd(pathList, &cachePath);
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN ManifestBuildCache *
+manifestBuildCacheNewLoad(IoRead *const read)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_READ, read);
+    FUNCTION_LOG_END();
+
+    ASSERT(read != NULL);
+
+    ManifestBuildCache *const this = manifestBuildCacheNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackRead *const pack = pckReadNewIo(read);
+
+        // Only load the cache when it was written with the current version
+        if (pckReadU32P(pack) == MANIFEST_BUILD_CACHE_VERSION)
+        {
+            const unsigned int pathTotal = pckReadU32P(pack);
+
+            for (unsigned int pathIdx = 0; pathIdx < pathTotal; pathIdx++)
+            {
+                pckReadObjBeginP(pack);
+
+                const String *const path = pckReadStrP(pack);
+                const time_t timeModified = pckReadTimeP(pack);
+                const time_t timeList = pckReadTimeP(pack);
+
+                manifestBuildCachePathAdd(this->pathList, path, timeModified, timeList, pckReadStrLstP(pack));
+
+                pckReadObjEndP(pack);
+            }
+
+            pckReadEndP(pack);
+        }
+
+        // Sort so paths can be found with lstFind()
+        lstSort(this->pathList, sortOrderAsc);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(MANIFEST_BUILD_CACHE, this);
+}
+
+FN_EXTERN void
+manifestBuildCacheSave(const ManifestBuildCache *const this, IoWrite *const write)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST_BUILD_CACHE, this);
+        FUNCTION_LOG_PARAM(IO_WRITE, write);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(write != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const pack = pckWriteNewIo(write);
+
+        pckWriteU32P(pack, MANIFEST_BUILD_CACHE_VERSION);
+        pckWriteU32P(pack, lstSize(this->pathList));
+
+        for (unsigned int pathIdx = 0; pathIdx < lstSize(this->pathList); pathIdx++)
+        {
+            const ManifestBuildCachePath *const cachePath = lstGet(this->pathList, pathIdx);
+
+            pckWriteObjBeginP(pack);
+            pckWriteStrP(pack, cachePath->path);
+            pckWriteTimeP(pack, cachePath->timeModified);
+            pckWriteTimeP(pack, cachePath->timeList);
+            pckWriteStrLstP(pack, cachePath->nameList);
+            pckWriteObjEndP(pack);
+        }
+
+        pckWriteEndP(pack);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+FN_EXTERN unsigned int
+manifestBuildCacheSize(const ManifestBuildCache *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST_BUILD_CACHE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(UINT, lstSize(this->pathList));
+}
+
 /**********************************************************************************************************************************/
 typedef struct ManifestBuildData
 {
@@ -786,6 +949,8 @@ typedef struct ManifestBuildData
     StringList *excludeContent;                                     // Exclude contents of directories
     StringList *excludeSingle;                                      // Exclude a single file/link/path
     const ManifestBlockIncrMap *blockIncrMap;                       // Block incremental maps
+    const ManifestBuildCache *cache;                                // Listings from the prior build
+    List *cachePathList;                                            // Listings from this build
 } ManifestBuildData;
 
 // Calculate block incremental size for a file. The block size is based on the size and age of the file. Larger files get larger
@@ -859,6 +1024,102 @@ manifestBuildBlockIncrChecksumSize(const ManifestBuildData *const buildData, con
 }
 
 // Process files/links/paths and add them to the manifest
+static void manifestBuildInfo(
+    ManifestBuildData *buildData, const String *manifestParentName, const String *pgPath, bool dbPath, const StorageInfo *info);
+
+// Process the contents of a path. When there is a build cache the path will only be listed if it has been modified since the prior
+// listing, but every entry is still checked with storageInfoP() because modifying a file does not update the modification time of
+// the path that contains it.
+static void
+manifestBuildPath(
+    ManifestBuildData *const buildData, const String *const manifestName, const String *const pgPath, const bool dbPath,
+    const time_t timeModified, const bool errorOnMissing)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buildData);
+        FUNCTION_TEST_PARAM(STRING, manifestName);
+        FUNCTION_TEST_PARAM(STRING, pgPath);
+        FUNCTION_TEST_PARAM(BOOL, dbPath);
+        FUNCTION_TEST_PARAM(TIME, timeModified);
+        FUNCTION_TEST_PARAM(BOOL, errorOnMissing);
+    FUNCTION_TEST_END();
+
+    ASSERT(buildData != NULL);
+    ASSERT(manifestName != NULL);
+    ASSERT(pgPath != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        if (buildData->cache == NULL)
+        {
+            StorageIterator *const storageItr = storageNewItrP(
+                buildData->storagePg, pgPath, .errorOnMissing = errorOnMissing, .sortOrder = sortOrderAsc);
+
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                while (storageItrMore(storageItr))
+                {
+                    const StorageInfo info = storageItrNext(storageItr);
+
+                    manifestBuildInfo(buildData, manifestName, pgPath, dbPath, &info);
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+        else
+        {
+            // Use the cached listing when the path has not been modified since it was listed. The listing must also have happened
+            // after the second of the modification time or a modification in the same second might have been missed.
+            const ManifestBuildCachePath *const cachePath = lstFind(buildData->cache->pathList, &pgPath);
+            StringList *nameList;
+            time_t timeList;
+
+            if (cachePath != NULL && cachePath->timeModified == timeModified && timeModified < cachePath->timeList)
+            {
+                nameList = strLstDup(cachePath->nameList);
+                timeList = cachePath->timeList;
+            }
+            // Else list the path. The time is taken before listing so a modification during listing will invalidate the cache.
+            else
+            {
+                timeList = time(NULL);
+                nameList = strLstSort(
+                    storageListP(buildData->storagePg, pgPath, .errorOnMissing = errorOnMissing), sortOrderAsc);
+            }
+
+            // Add the listing to the cache for the next build
+            manifestBuildCachePathAdd(buildData->cachePathList, pgPath, timeModified, timeList, nameList);
+
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                for (unsigned int nameIdx = 0; nameIdx < strLstSize(nameList); nameIdx++)
+                {
+                    const String *const name = strLstGet(nameList, nameIdx);
+                    StorageInfo info = storageInfoP(
+                        buildData->storagePg, strNewFmt("%s/%s", strZ(pgPath), strZ(name)), .ignoreMissing = true);
+
+                    // Skip entries that have been removed since the path was listed
+                    if (info.exists)
+                    {
+                        info.name = name;
+                        manifestBuildInfo(buildData, manifestName, pgPath, dbPath, &info);
+                    }
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static void
 manifestBuildInfo(
     ManifestBuildData *const buildData, const String *manifestParentName, const String *pgPath, const bool dbPath,
@@ -978,23 +1239,9 @@ manifestBuildInfo(
             }
 
             // Recurse into the path
-            const String *const pgPathSub = strNewFmt("%s/%s", strZ(pgPath), strZ(info->name));
-            const bool dbPathSub = regExpMatch(buildData->dbPathExp, manifestName);
-            StorageIterator *const storageItr = storageNewItrP(buildData->storagePg, pgPathSub, .sortOrder = sortOrderAsc);
-
-            MEM_CONTEXT_TEMP_RESET_BEGIN()
-            {
-                while (storageItrMore(storageItr))
-                {
-                    const StorageInfo info = storageItrNext(storageItr);
-
-                    manifestBuildInfo(buildData, manifestName, pgPathSub, dbPathSub, &info);
-
-                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                    MEM_CONTEXT_TEMP_RESET(1000);
-                }
-            }
-            MEM_CONTEXT_TEMP_END();
+            manifestBuildPath(
+                buildData, manifestName, strNewFmt("%s/%s", strZ(pgPath), strZ(info->name)),
+                regExpMatch(buildData->dbPathExp, manifestName), info->timeModified, false);
 
             break;
         }
@@ -1282,7 +1529,7 @@ FN_EXTERN Manifest *
 manifestNewBuild(
     const Storage *const storagePg, const unsigned int pgVersion, const unsigned int pgCatalogVersion, const time_t timestampStart,
     const bool online, const bool checksumPage, const bool bundle, const bool blockIncr, const ManifestBlockIncrMap *blockIncrMap,
-    const StringList *const excludeList, const Pack *const tablespaceList)
+    const StringList *const excludeList, const Pack *const tablespaceList, ManifestBuildCache *const buildCache)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, storagePg);
@@ -1296,6 +1543,7 @@ manifestNewBuild(
         FUNCTION_LOG_PARAM(VOID, blockIncrMap);
         FUNCTION_LOG_PARAM(STRING_LIST, excludeList);
         FUNCTION_LOG_PARAM(PACK, tablespaceList);
+        FUNCTION_LOG_PARAM(MANIFEST_BUILD_CACHE, buildCache);
     FUNCTION_LOG_END();
 
     ASSERT(storagePg != NULL);
@@ -1334,8 +1582,20 @@ manifestNewBuild(
                 .linkCheck = &linkCheck,
                 .manifestWalName = strNewFmt(MANIFEST_TARGET_PGDATA "/%s", strZ(pgWalPath(pgVersion))),
                 .blockIncrMap = blockIncrMap,
+                .cache = buildCache,
             };
 
+            // Listings from this build are stored in the build cache so they will be available for the next build
+            if (buildCache != NULL)
+            {
+                MEM_CONTEXT_OBJ_BEGIN(buildCache)
+                {
+                    buildData.cachePathList = lstNewP(
+                        sizeof(ManifestBuildCachePath), .sortOrder = sortOrderAsc, .comparator = lstComparatorStr);
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+
             // Build expressions to identify databases paths and temp relations
             // ---------------------------------------------------------------------------------------------------------------------
             ASSERT(buildData.tablespaceId != NULL);
@@ -1407,22 +1667,14 @@ manifestNewBuild(
             manifestTargetAdd(this, &target);
 
             // Gather info for the rest of the files/links/paths
-            StorageIterator *const storageItr = storageNewItrP(
-                storagePg, pgPath, .errorOnMissing = true, .sortOrder = sortOrderAsc);
+            manifestBuildPath(&buildData, MANIFEST_TARGET_PGDATA_STR, pgPath, false, info.timeModified, true);
 
-            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            // Replace the cached listings with listings from this build so paths that no longer exist are removed
+            if (buildCache != NULL)
             {
-                while (storageItrMore(storageItr))
-                {
-                    const StorageInfo info = storageItrNext(storageItr);
-
-                    manifestBuildInfo(&buildData, MANIFEST_TARGET_PGDATA_STR, pgPath, false, &info);
-
-                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                    MEM_CONTEXT_TEMP_RESET(1000);
-                }
+                lstFree(buildCache->pathList);
+                buildCache->pathList = lstSort(buildData.cachePathList, sortOrderAsc);
             }
-            MEM_CONTEXT_TEMP_END();
 
             // These may not be in order even if the incoming data was sorted
             lstSort(this->pub.fileList, sortOrderAsc);
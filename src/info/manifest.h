@@ -34,6 +34,7 @@ STRING_DECLARE(MANIFEST_TARGET_PGTBLSPC_STR);
 Object type
 ***********************************************************************************************************************************/
 typedef struct Manifest Manifest;
+typedef struct ManifestBuildCache ManifestBuildCache;
 
 #include "command/backup/common.h"
 #include "common/compress/helper.h"
@@ -214,11 +215,12 @@ typedef struct ManifestTarget
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-// Build a new manifest for a PostgreSQL data directory
+// Build a new manifest for a PostgreSQL data directory. If a build cache is provided then paths that have not been modified since
+// the prior build will not be listed again, and the cache will be updated with the paths found during this build.
 FN_EXTERN Manifest *manifestNewBuild(
     const Storage *storagePg, unsigned int pgVersion, unsigned int pgCatalogVersion, time_t timestampStart, bool online,
     bool checksumPage, bool bundle, bool blockIncr, const ManifestBlockIncrMap *blockIncrMap, const StringList *excludeList,
-    const Pack *tablespaceList);
+    const Pack *tablespaceList, ManifestBuildCache *buildCache);
 
 // Load a manifest from IO
 FN_EXTERN Manifest *manifestNewLoad(IoRead *read);
@@ -252,6 +254,19 @@ manifestCipherSubPassSet(Manifest *const this, const String *const cipherSubPass
     infoCipherPassSet(THIS_PUB(Manifest)->info, cipherSubPass);
 }
 
+// Get/set the cipher type used with the cipher subpassphrase
+FN_INLINE_ALWAYS CipherType
+manifestCipherSubType(const Manifest *const this)
+{
+    return infoCipherType(THIS_PUB(Manifest)->info);
+}
+
+FN_INLINE_ALWAYS void
+manifestCipherSubTypeSet(Manifest *const this, const CipherType cipherSubType)
+{
+    infoCipherTypeSet(THIS_PUB(Manifest)->info, cipherSubType);
+}
+
 // Get manifest configuration and options
 FN_INLINE_ALWAYS const ManifestData *
 manifestData(const Manifest *const this)
@@ -496,6 +511,37 @@ manifestFree(Manifest *const this)
     objFree(this);
 }
 
+/***********************************************************************************************************************************
+Build cache
+
+The build cache stores the names found in each path during manifestNewBuild() so they can be reused by the next build when the path
+has not been modified. Files are always checked since modifying a file does not update the modification time of its path.
+***********************************************************************************************************************************/
+// Create empty build cache
+FN_EXTERN ManifestBuildCache *manifestBuildCacheNew(void);
+
+// Load build cache from IO. An empty cache is returned if the cache was written by a different version.
+FN_EXTERN ManifestBuildCache *manifestBuildCacheNewLoad(IoRead *read);
+
+// Save build cache to IO
+FN_EXTERN void manifestBuildCacheSave(const ManifestBuildCache *this, IoWrite *write);
+
+// Number of paths in the build cache
+FN_EXTERN unsigned int manifestBuildCacheSize(const ManifestBuildCache *this);
+
+// Move to a new parent mem context
+FN_INLINE_ALWAYS ManifestBuildCache *
+manifestBuildCacheMove(ManifestBuildCache *const this, MemContext *const parentNew)
+{
+    return objMove(this, parentNew);
+}
+
+FN_INLINE_ALWAYS void
+manifestBuildCacheFree(ManifestBuildCache *const this)
+{
+    objFree(this);
+}
+
 /***********************************************************************************************************************************
 Helper functions
 ***********************************************************************************************************************************/
@@ -511,6 +557,11 @@ Macros for function logging
 #define FUNCTION_LOG_MANIFEST_FORMAT(value, buffer, bufferSize)                                                                    \
     objNameToLog(value, "Manifest", buffer, bufferSize)
 
+#define FUNCTION_LOG_MANIFEST_BUILD_CACHE_TYPE                                                                                     \
+    ManifestBuildCache *
+#define FUNCTION_LOG_MANIFEST_BUILD_CACHE_FORMAT(value, buffer, bufferSize)                                                        \
+    objNameToLog(value, "ManifestBuildCache", buffer, bufferSize)
+
 #define FUNCTION_LOG_MANIFEST_DB_TYPE                                                                                              \
     ManifestDb *
 #define FUNCTION_LOG_MANIFEST_DB_FORMAT(value, buffer, bufferSize)                                                                 \
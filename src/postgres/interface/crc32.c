@@ -3,8 +3,28 @@ CRC-32 Calculation
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <stdbool.h>
+#include <string.h>
+
 #include "postgres/interface/crc32.h"
 
+/***********************************************************************************************************************************
+Include hardware CRC-32C support
+
+The table-driven calculation below is portable but slow. x86-64 (SSE 4.2) and arm64 (ARMv8 CRC extension) have instructions that
+calculate CRC-32C directly so also build kernels that use them and select them at runtime on CPUs that support them.
+***********************************************************************************************************************************/
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <nmmintrin.h>
+
+    #define CRC32C_SSE42
+#elif defined(__aarch64__) && defined(__GNUC__) && defined(__linux__)
+    #include <arm_acle.h>
+    #include <sys/auxv.h>
+
+    #define CRC32C_ARMV8
+#endif
+
 /**********************************************************************************************************************************/
 static const uint32_t crc32_lookup[256] =
 {
@@ -90,13 +110,103 @@ static const uint32_t crc32c_lookup[256] =
     0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351,
 };
 
-FN_EXTERN uint32_t
-crc32cOne(const unsigned char *data, size_t size)
+static uint32_t
+crc32cUpdateTable(uint32_t result, const unsigned char *data, size_t size)
 {
-    uint32_t result = 0xffffffff;
-
     while (size--)
         result = crc32c_lookup[(result ^ *data++) & 0xFF] ^ (result >> 8);
 
-    return result ^ 0xffffffff;
+    return result;
+}
+
+#ifdef CRC32C_SSE42
+
+static __attribute__((__target__("sse4.2"))) uint32_t
+crc32cUpdateSse42(uint32_t result, const unsigned char *data, size_t size)
+{
+    uint64_t result64 = result;
+
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+
+        result64 = _mm_crc32_u64(result64, value);
+    }
+
+    result = (uint32_t)result64;
+
+    while (size--)
+        result = _mm_crc32_u8(result, *data++);
+
+    return result;
+}
+
+#endif // CRC32C_SSE42
+
+#ifdef CRC32C_ARMV8
+
+static __attribute__((__target__("+crc"))) uint32_t
+crc32cUpdateArmv8(uint32_t result, const unsigned char *data, size_t size)
+{
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+
+        result = __crc32cd(result, value);
+    }
+
+    while (size--)
+        result = __crc32cb(result, *data++);
+
+    return result;
+}
+
+#endif // CRC32C_ARMV8
+
+/***********************************************************************************************************************************
+Kernel selected at runtime based on CPU features
+***********************************************************************************************************************************/
+static struct Crc32Local
+{
+    bool init;                                                      // Has the kernel been selected?
+    uint32_t (*update)(uint32_t, const unsigned char *, size_t);    // Add data to CRC-32C
+} crc32Local;
+
+static void
+crc32cInit(void)
+{
+    if (!crc32Local.init)
+    {
+        crc32Local.update = crc32cUpdateTable;
+
+#ifdef CRC32C_SSE42
+        if (__builtin_cpu_supports("sse4.2"))                       // {uncovered_branch - depends on CPU features}
+            crc32Local.update = crc32cUpdateSse42;
+#endif
+
+#ifdef CRC32C_ARMV8
+        if (getauxval(AT_HWCAP) & HWCAP_CRC32)                      // {uncovered_branch - depends on CPU features}
+            crc32Local.update = crc32cUpdateArmv8;
+#endif
+
+        crc32Local.init = true;
+    }
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint32_t
+crc32cOne(const unsigned char *const data, const size_t size)
+{
+    return crc32cUpdate(0, data, size);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint32_t
+crc32cUpdate(const uint32_t crc, const unsigned char *const data, const size_t size)
+{
+    crc32cInit();
+
+    return crc32Local.update(crc ^ 0xffffffff, data, size) ^ 0xffffffff;
 }
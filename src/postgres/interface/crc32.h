@@ -1,7 +1,7 @@
 /***********************************************************************************************************************************
 CRC-32 Calculation
 
-CRC-32 and CRC-32C calculations required to validate the integrity of pg_control.
+CRC-32 and CRC-32C calculations required to validate the integrity of pg_control and WAL records.
 ***********************************************************************************************************************************/
 #ifndef POSTGRES_INTERFACE_CRC32_H
 #define POSTGRES_INTERFACE_CRC32_H
@@ -18,4 +18,8 @@ FN_EXTERN uint32_t crc32One(const unsigned char *data, size_t size);
 // Generate CRC-32C checksum (required by >= 9.5)
 FN_EXTERN uint32_t crc32cOne(const unsigned char *data, size_t size);
 
+// Add data to a CRC-32C checksum. Pass zero as the initial checksum, e.g. crc32cUpdate(crc32cOne(a, aSize), b, bSize) is equal to
+// the checksum of a and b concatenated.
+FN_EXTERN uint32_t crc32cUpdate(uint32_t crc, const unsigned char *data, size_t size);
+
 #endif
@@ -52,21 +52,29 @@ CHECKSUM_UNION(pgPageSize8);
 CHECKSUM_UNION(pgPageSize16);
 CHECKSUM_UNION(pgPageSize32);
 
-/**********************************************************************************************************************************/
-FN_EXTERN uint16_t
-pgPageChecksum(unsigned char *const page, const uint32_t blockNo, const PgPageSize pageSize)
+/***********************************************************************************************************************************
+Calculate the checksum of a page before the block number is mixed in
+
+The algorithm was designed to be vectorized across the parallel sums. Release builds vectorize the loops below for the baseline
+vector extension of the architecture (e.g. NEON on arm64) but on x86 the baseline is SSE2, which has no packed 32-bit multiply. When
+possible the function is cloned for wider x86 vector extensions and the best clone for the CPU is selected at startup. Every clone
+is compiled from the same code so the results are identical.
+***********************************************************************************************************************************/
+#ifdef HAVE_TARGET_CLONES
+    #define CHECKSUM_TARGET_CLONES                                                                                                 \
+        __attribute__((target_clones("avx512f", "avx2", "sse4.1", "default")))
+#else
+    #define CHECKSUM_TARGET_CLONES
+#endif
+
+static CHECKSUM_TARGET_CLONES uint32_t
+pgPageChecksumBlock(unsigned char *const page, const PgPageSize pageSize)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM_P(UCHARDATA, page);
-        FUNCTION_TEST_PARAM(UINT, blockNo);
         FUNCTION_TEST_PARAM(ENUM, pageSize);
     FUNCTION_TEST_END();
 
-    // Save pd_checksum and temporarily set it to zero, so that the checksum calculation isn't affected by the old checksum stored
-    // on the page. Restore it after, because actually updating the checksum is NOT part of the API of this function.
-    const uint16_t checksumPrior = ((PageHeaderData *)page)->pd_checksum;
-    ((PageHeaderData *)page)->pd_checksum = 0;
-
     // Initialize partial checksums to their corresponding offsets
     uint32_t sums[PARALLEL_SUM] =
     {
@@ -101,6 +109,26 @@ pgPageChecksum(unsigned char *const page, const uint32_t blockNo, const PgPageSi
     for (uint32_t i = 0; i < PARALLEL_SUM; i++)
         result ^= sums[i];
 
+    FUNCTION_TEST_RETURN(UINT32, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint16_t
+pgPageChecksum(unsigned char *const page, const uint32_t blockNo, const PgPageSize pageSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, page);
+        FUNCTION_TEST_PARAM(UINT, blockNo);
+        FUNCTION_TEST_PARAM(ENUM, pageSize);
+    FUNCTION_TEST_END();
+
+    // Save pd_checksum and temporarily set it to zero, so that the checksum calculation isn't affected by the old checksum stored
+    // on the page. Restore it after, because actually updating the checksum is NOT part of the API of this function.
+    const uint16_t checksumPrior = ((PageHeaderData *)page)->pd_checksum;
+    ((PageHeaderData *)page)->pd_checksum = 0;
+
+    uint32_t result = pgPageChecksumBlock(page, pageSize);
+
     // Restore prior checksum
     ((PageHeaderData *)page)->pd_checksum = checksumPrior;
 
@@ -210,6 +210,37 @@ protocolClientDataPut(ProtocolClient *const this, PackWrite *const data)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolClientDataRawPut(ProtocolClient *const this, const Buffer *const data)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+        FUNCTION_LOG_PARAM(BUFFER, data);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL && !bufEmpty(data));
+
+    // Expect data-put state before data put
+    protocolClientStateExpect(this, protocolClientStateDataPut);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Write the size of the raw data
+        PackWrite *const dataMessage = pckWriteNewIo(this->write);
+        pckWriteU32P(dataMessage, protocolMessageTypeDataRaw);
+        pckWriteU64P(dataMessage, bufUsed(data));
+        pckWriteEndP(dataMessage);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Write the raw data
+    ioWrite(this->write, data);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 // Helper to process errors
 static void
@@ -246,12 +277,15 @@ protocolClientError(ProtocolClient *const this, const ProtocolMessageType type,
     FUNCTION_LOG_RETURN_VOID();
 }
 
-/**********************************************************************************************************************************/
-FN_EXTERN PackRead *
-protocolClientDataGet(ProtocolClient *const this)
+/***********************************************************************************************************************************
+Get data from the server. Raw data is only allowed when rawSize is not NULL.
+***********************************************************************************************************************************/
+static PackRead *
+protocolClientDataGetInternal(ProtocolClient *const this, size_t *const rawSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+        FUNCTION_LOG_PARAM_P(SIZE, rawSize);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -269,13 +303,24 @@ protocolClientDataGet(ProtocolClient *const this)
 
         protocolClientError(this, type, response);
 
-        CHECK(FormatError, type == protocolMessageTypeData, "expected data message");
-
-        MEM_CONTEXT_PRIOR_BEGIN()
+        // Get the size of raw data, which will be read separately
+        if (rawSize != NULL && type == protocolMessageTypeDataRaw)
+        {
+            *rawSize = (size_t)pckReadU64P(response);
+        }
+        else
         {
-            result = pckReadPackReadP(response);
+            CHECK(FormatError, type == protocolMessageTypeData, "expected data message");
+
+            if (rawSize != NULL)
+                *rawSize = 0;
+
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = pckReadPackReadP(response);
+            }
+            MEM_CONTEXT_PRIOR_END();
         }
-        MEM_CONTEXT_PRIOR_END();
 
         pckReadEndP(response);
 
@@ -288,6 +333,66 @@ protocolClientDataGet(ProtocolClient *const this)
     FUNCTION_LOG_RETURN(PACK_READ, result);
 }
 
+FN_EXTERN PackRead *
+protocolClientDataGet(ProtocolClient *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    FUNCTION_LOG_RETURN(PACK_READ, protocolClientDataGetInternal(this, NULL));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN PackRead *
+protocolClientDataRawGet(ProtocolClient *const this, size_t *const rawSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+        FUNCTION_LOG_PARAM_P(SIZE, rawSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(rawSize != NULL);
+
+    FUNCTION_LOG_RETURN(PACK_READ, protocolClientDataGetInternal(this, rawSize));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN size_t
+protocolClientDataRawRead(ProtocolClient *const this, Buffer *const buffer, const size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL && !bufFull(buffer));
+    ASSERT(size > 0);
+
+    // If the buffer is larger than the raw data then limit the buffer size so the read won't block or read too far. The prior limit
+    // (or lack of one) is restored afterward so the caller's buffer is left as it was passed.
+    const bool sizeLimitPrior = bufSizeLimit(buffer);
+    const size_t sizePrior = bufSize(buffer);
+
+    if (bufRemains(buffer) > size)
+        bufLimitSet(buffer, bufUsed(buffer) + size);
+
+    const size_t result = ioRead(this->pub.read, buffer);
+
+    if (sizeLimitPrior)
+        bufLimitSet(buffer, sizePrior);
+    else
+        bufLimitClear(buffer);
+
+    // Error if EOF but raw data read is not complete
+    if (result == 0)
+        THROW(ProtocolError, "unexpected EOF reading raw data");
+
+    FUNCTION_LOG_RETURN(SIZE, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolClientDataEndGet(ProtocolClient *const this)
@@ -20,6 +20,10 @@ typedef enum
 
     // An error occurred on the server and the command ended abnormally. protocolMessageTypeDataEnd will not be sent to the client.
     protocolMessageTypeError = 3,
+
+    // Raw data passed between client and server in either direction. The message contains only the size of the data, which follows
+    // the message without any encoding. This avoids copying large buffers (e.g. file contents) into and out of packs.
+    protocolMessageTypeDataRaw = 4,
 } ProtocolMessageType;
 
 /***********************************************************************************************************************************
@@ -103,12 +107,23 @@ FN_EXTERN void protocolClientNoOp(ProtocolClient *this);
 FN_EXTERN PackRead *protocolClientDataGet(ProtocolClient *this);
 FN_EXTERN void protocolClientDataEndGet(ProtocolClient *this);
 
+// Get data or raw data put by the server. When raw data is received NULL is returned and rawSize is set to the size of the
+// raw data, which must be read with protocolClientDataRawRead() before the next message is read. Otherwise rawSize is set to zero.
+FN_EXTERN PackRead *protocolClientDataRawGet(ProtocolClient *this, size_t *rawSize);
+
+// Read raw data into the buffer. No more than size bytes will be read but less may be read if the buffer fills first. Returns the
+// number of bytes read.
+FN_EXTERN size_t protocolClientDataRawRead(ProtocolClient *this, Buffer *buffer, size_t size);
+
 // Put command to the server
 FN_EXTERN void protocolClientCommandPut(ProtocolClient *this, ProtocolCommand *command, const bool dataPut);
 
 // Put data to the server
 FN_EXTERN void protocolClientDataPut(ProtocolClient *this, PackWrite *data);
 
+// Put raw data to the server. The data is written directly to the transport and must not be empty.
+FN_EXTERN void protocolClientDataRawPut(ProtocolClient *this, const Buffer *data);
+
 /***********************************************************************************************************************************
 Destructor
 ***********************************************************************************************************************************/
@@ -634,6 +634,20 @@ protocolRemoteParamSsh(const ProtocolStorageType protocolStorageType, const unsi
         strLstAddZ(result, "-o");
         strLstAddZ(result, "PasswordAuthentication=no");
 
+        // Share a single connection to the host between processes. The first process to connect becomes the master and the
+        // connection persists in the background after the last process disconnects. ControlPersist=0 means forever so round up.
+        const TimeMSec sshMux = cfgOptionUInt64(cfgOptSshMux);
+
+        if (sshMux > 0)
+        {
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlMaster=auto");
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlPath=~/.ssh/" PROJECT_BIN "-%C");
+            strLstAddZ(result, "-o");
+            strLstAddFmt(result, "ControlPersist=%" PRIu64, (sshMux + MSEC_PER_SEC - 1) / MSEC_PER_SEC);
+        }
+
         // Append port if specified
         ConfigOption optHostPort = isRepo ? cfgOptRepoHostPort : cfgOptPgHostPort;
 
@@ -23,6 +23,7 @@ struct ProtocolParallel
     TimeMSec timeout;                                               // Max time to wait for jobs before returning
     ParallelJobCallback *callbackFunction;                          // Function to get new jobs
     void *callbackData;                                             // Data to pass to callback function
+    bool jobWait;                                                   // Wait for new jobs while jobs are outstanding?
 
     List *clientList;                                               // List of clients to process jobs
     List *jobList;                                                  // List of jobs to be processed
@@ -34,12 +35,15 @@ struct ProtocolParallel
 
 /**********************************************************************************************************************************/
 FN_EXTERN ProtocolParallel *
-protocolParallelNew(TimeMSec timeout, ParallelJobCallback *callbackFunction, void *callbackData)
+protocolParallelNew(
+    const TimeMSec timeout, ParallelJobCallback *const callbackFunction, void *const callbackData,
+    const ProtocolParallelNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(UINT64, timeout);
         FUNCTION_LOG_PARAM(FUNCTIONP, callbackFunction);
         FUNCTION_LOG_PARAM_P(VOID, callbackData);
+        FUNCTION_LOG_PARAM(BOOL, param.jobWait);
     FUNCTION_LOG_END();
 
     ASSERT(callbackFunction != NULL);
@@ -52,6 +56,7 @@ protocolParallelNew(TimeMSec timeout, ParallelJobCallback *callbackFunction, voi
             .timeout = timeout,
             .callbackFunction = callbackFunction,
             .callbackData = callbackData,
+            .jobWait = param.jobWait,
             .clientList = lstNewP(sizeof(ProtocolClient *)),
             .jobList = lstNewP(sizeof(ProtocolParallelJob *)),
             .state = protocolParallelJobStatePending,
@@ -83,6 +88,63 @@ protocolParallelClientAdd(ProtocolParallel *this, ProtocolClient *client)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Find new jobs for clients that are not running a job
+***********************************************************************************************************************************/
+static void
+protocolParallelJobNext(ProtocolParallel *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+    {
+        // If nothing is running for this client
+        if (this->clientJobList[clientIdx] == NULL)
+        {
+            // Get a new job
+            ProtocolParallelJob *job = NULL;
+
+            MEM_CONTEXT_BEGIN(lstMemContext(this->jobList))
+            {
+                job = this->callbackFunction(this->callbackData, clientIdx);
+            }
+            MEM_CONTEXT_END();
+
+            // If a new job was found
+            if (job != NULL)
+            {
+                // Add to the job list
+                lstAdd(this->jobList, &job);
+
+                // Put command
+                protocolClientCommandPut(
+                    *(ProtocolClient **)lstGet(this->clientList, clientIdx), protocolParallelJobCommand(job), false);
+
+                // Set client id and running state
+                protocolParallelJobProcessIdSet(job, clientIdx + 1);
+                protocolParallelJobStateSet(job, protocolParallelJobStateRunning);
+                this->clientJobList[clientIdx] = job;
+            }
+            // Else no more jobs for this client so free it, unless waiting for jobs
+            else if (!this->jobWait)
+                protocolLocalFree(clientIdx + 1);
+        }
+    }
+
+    // When waiting for jobs the clients are kept while there are outstanding jobs since their results may make new jobs available
+    if (this->jobWait && lstEmpty(this->jobList))
+    {
+        for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+            protocolLocalFree(clientIdx + 1);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN unsigned int
 protocolParallelProcess(ProtocolParallel *this)
@@ -109,6 +171,9 @@ protocolParallelProcess(ProtocolParallel *this)
 
             this->state = protocolParallelJobStateRunning;
         }
+        // Else when waiting for jobs check for new jobs that were made available by the results retrieved since the last call
+        else if (this->jobWait)
+            protocolParallelJobNext(this);
 
         // Initialize the file descriptor set used for select
         fd_set selectSet;
@@ -183,40 +248,7 @@ protocolParallelProcess(ProtocolParallel *this)
         }
 
         // Find new jobs to be run
-        for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
-        {
-            // If nothing is running for this client
-            if (this->clientJobList[clientIdx] == NULL)
-            {
-                // Get a new job
-                ProtocolParallelJob *job = NULL;
-
-                MEM_CONTEXT_BEGIN(lstMemContext(this->jobList))
-                {
-                    job = this->callbackFunction(this->callbackData, clientIdx);
-                }
-                MEM_CONTEXT_END();
-
-                // If a new job was found
-                if (job != NULL)
-                {
-                    // Add to the job list
-                    lstAdd(this->jobList, &job);
-
-                    // Put command
-                    protocolClientCommandPut(
-                        *(ProtocolClient **)lstGet(this->clientList, clientIdx), protocolParallelJobCommand(job), false);
-
-                    // Set client id and running state
-                    protocolParallelJobProcessIdSet(job, clientIdx + 1);
-                    protocolParallelJobStateSet(job, protocolParallelJobStateRunning);
-                    this->clientJobList[clientIdx] = job;
-                }
-                // Else no more jobs for this client so free it
-                else
-                    protocolLocalFree(clientIdx + 1);
-            }
-        }
+        protocolParallelJobNext(this);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -263,9 +295,22 @@ protocolParallelDone(ProtocolParallel *this)
     ASSERT(this != NULL);
     ASSERT(this->state != protocolParallelJobStatePending);
 
-    // If there are no jobs left then we are done
+    // If there are no jobs left then we are done. When waiting for jobs the results retrieved since the last call may have made new
+    // jobs available so check before deciding.
     if (this->state != protocolParallelJobStateDone && lstEmpty(this->jobList))
-        this->state = protocolParallelJobStateDone;
+    {
+        if (this->jobWait)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                protocolParallelJobNext(this);
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+
+        if (lstEmpty(this->jobList))
+            this->state = protocolParallelJobStateDone;
+    }
 
     FUNCTION_LOG_RETURN(BOOL, this->state == protocolParallelJobStateDone);
 }
@@ -19,13 +19,27 @@ Job request callback
 
 Called whenever a new job is required for processing. If no more jobs are available then NULL is returned. Note that NULL must be
 returned to each clientIdx in case job distribution varies by clientIdx.
+
+By default a client is freed as soon as NULL is returned for it. When jobWait is set, NULL only means that no job is available yet,
+e.g. because a job depends on the results of jobs that are still running. The client is kept and the callback is called again after
+the results have been retrieved. Clients are freed when NULL is returned and no jobs are running or waiting to be retrieved.
 ***********************************************************************************************************************************/
 typedef ProtocolParallelJob *ParallelJobCallback(void *data, unsigned int clientIdx);
 
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN ProtocolParallel *protocolParallelNew(TimeMSec timeout, ParallelJobCallback *callbackFunction, void *callbackData);
+typedef struct ProtocolParallelNewParam
+{
+    VAR_PARAM_HEADER;
+    bool jobWait;                                                   // Wait for new jobs while jobs are outstanding?
+} ProtocolParallelNewParam;
+
+#define protocolParallelNewP(timeout, callbackFunction, callbackData, ...)                                                         \
+    protocolParallelNew(timeout, callbackFunction, callbackData, (ProtocolParallelNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN ProtocolParallel *protocolParallelNew(
+    TimeMSec timeout, ParallelJobCallback *callbackFunction, void *callbackData, ProtocolParallelNewParam param);
 
 /***********************************************************************************************************************************
 Getters/Setters
@@ -286,12 +286,15 @@ protocolServerProcess(
     FUNCTION_LOG_RETURN_VOID();
 }
 
-/**********************************************************************************************************************************/
-FN_EXTERN PackRead *
-protocolServerDataGet(ProtocolServer *const this)
+/***********************************************************************************************************************************
+Get data from the client. Raw data is only allowed when rawSize is not NULL.
+***********************************************************************************************************************************/
+static PackRead *
+protocolServerDataGetInternal(ProtocolServer *const this, size_t *const rawSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
+        FUNCTION_LOG_PARAM_P(SIZE, rawSize);
     FUNCTION_LOG_END();
 
     PackRead *result = NULL;
@@ -301,13 +304,24 @@ protocolServerDataGet(ProtocolServer *const this)
         PackRead *data = pckReadNewIo(this->read);
         ProtocolMessageType type = (ProtocolMessageType)pckReadU32P(data);
 
-        CHECK(FormatError, type == protocolMessageTypeData, "expected data message");
-
-        MEM_CONTEXT_PRIOR_BEGIN()
+        // Get the size of raw data, which will be read separately
+        if (rawSize != NULL && type == protocolMessageTypeDataRaw)
         {
-            result = pckReadPackReadP(data);
+            *rawSize = (size_t)pckReadU64P(data);
+        }
+        else
+        {
+            CHECK(FormatError, type == protocolMessageTypeData, "expected data message");
+
+            if (rawSize != NULL)
+                *rawSize = 0;
+
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = pckReadPackReadP(data);
+            }
+            MEM_CONTEXT_PRIOR_END();
         }
-        MEM_CONTEXT_PRIOR_END();
 
         pckReadEndP(data);
     }
@@ -316,6 +330,66 @@ protocolServerDataGet(ProtocolServer *const this)
     FUNCTION_LOG_RETURN(PACK_READ, result);
 }
 
+FN_EXTERN PackRead *
+protocolServerDataGet(ProtocolServer *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
+    FUNCTION_LOG_END();
+
+    FUNCTION_LOG_RETURN(PACK_READ, protocolServerDataGetInternal(this, NULL));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN PackRead *
+protocolServerDataRawGet(ProtocolServer *const this, size_t *const rawSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
+        FUNCTION_LOG_PARAM_P(SIZE, rawSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(rawSize != NULL);
+
+    FUNCTION_LOG_RETURN(PACK_READ, protocolServerDataGetInternal(this, rawSize));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN size_t
+protocolServerDataRawRead(ProtocolServer *const this, Buffer *const buffer, const size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL && !bufFull(buffer));
+    ASSERT(size > 0);
+
+    // If the buffer is larger than the raw data then limit the buffer size so the read won't block or read too far. The prior limit
+    // (or lack of one) is restored afterward so the caller's buffer is left as it was passed.
+    const bool sizeLimitPrior = bufSizeLimit(buffer);
+    const size_t sizePrior = bufSize(buffer);
+
+    if (bufRemains(buffer) > size)
+        bufLimitSet(buffer, bufUsed(buffer) + size);
+
+    const size_t result = ioRead(this->read, buffer);
+
+    if (sizeLimitPrior)
+        bufLimitSet(buffer, sizePrior);
+    else
+        bufLimitClear(buffer);
+
+    // Error if EOF but raw data read is not complete
+    if (result == 0)
+        THROW(ProtocolError, "unexpected EOF reading raw data");
+
+    FUNCTION_LOG_RETURN(SIZE, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolServerDataPut(ProtocolServer *const this, PackWrite *const data)
@@ -346,6 +420,34 @@ protocolServerDataPut(ProtocolServer *const this, PackWrite *const data)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolServerDataRawPut(ProtocolServer *const this, const Buffer *const data)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
+        FUNCTION_LOG_PARAM(BUFFER, data);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL && !bufEmpty(data));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Write the size of the raw data
+        PackWrite *const resultMessage = pckWriteNewIo(this->write);
+        pckWriteU32P(resultMessage, protocolMessageTypeDataRaw);
+        pckWriteU64P(resultMessage, bufUsed(data));
+        pckWriteEndP(resultMessage);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Write the raw data
+    ioWrite(this->write, data);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolServerDataEndPut(ProtocolServer *const this)
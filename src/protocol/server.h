@@ -51,9 +51,20 @@ FN_EXTERN ProtocolServerCommandGetResult protocolServerCommandGet(ProtocolServer
 // Get data from the client
 FN_EXTERN PackRead *protocolServerDataGet(ProtocolServer *this);
 
+// Get data or raw data from the client. When raw data is received NULL is returned and rawSize is set to the size of the
+// raw data, which must be read with protocolServerDataRawRead() before the next message is read. Otherwise rawSize is set to zero.
+FN_EXTERN PackRead *protocolServerDataRawGet(ProtocolServer *this, size_t *rawSize);
+
+// Read raw data into the buffer. No more than size bytes will be read but less may be read if the buffer fills first. Returns the
+// number of bytes read.
+FN_EXTERN size_t protocolServerDataRawRead(ProtocolServer *this, Buffer *buffer, size_t size);
+
 // Put data to the client
 FN_EXTERN void protocolServerDataPut(ProtocolServer *this, PackWrite *data);
 
+// Put raw data to the client. The data is written directly to the transport and must not be empty.
+FN_EXTERN void protocolServerDataRawPut(ProtocolServer *this, const Buffer *data);
+
 // Put data end to the client. This ends command processing and no more data should be sent.
 FN_EXTERN void protocolServerDataEndPut(ProtocolServer *this);
 
@@ -80,6 +80,7 @@ storageAzureHelper(const unsigned int repoIdx, const bool write, StoragePathExpr
                 cfgOptionIdxStr(cfgOptRepoPath, repoIdx), write, pathExpressionCallback,
                 cfgOptionIdxStr(cfgOptRepoAzureContainer, repoIdx), cfgOptionIdxStr(cfgOptRepoAzureAccount, repoIdx), keyType, key,
                 (size_t)cfgOptionIdxUInt64(cfgOptRepoStorageUploadChunkSize, repoIdx),
+                cfgOptionIdxUInt(cfgOptRepoStorageUploadMax, repoIdx), cfgOptionIdxUInt(cfgOptRepoStorageRequestMax, repoIdx),
                 cfgOptionIdxKvNull(cfgOptRepoStorageTag, repoIdx), endpoint, uriStyle, port, ioTimeoutMs(),
                 cfgOptionIdxBool(cfgOptRepoStorageVerifyTls, repoIdx), cfgOptionIdxStrNull(cfgOptRepoStorageCaFile, repoIdx),
                 cfgOptionIdxStrNull(cfgOptRepoStorageCaPath, repoIdx));
@@ -67,6 +67,8 @@ struct StorageAzure
     const HttpQuery *sasKey;                                        // SAS key
     const String *host;                                             // Host name
     size_t blockSize;                                               // Block size for multi-block upload
+    unsigned int blockMax;                                          // Maximum blocks uploading concurrently
+    unsigned int requestMax;                                        // Maximum remove requests in progress concurrently
     const String *tag;                                              // Tags to be applied to objects
     const String *pathPrefix;                                       // Account/container prefix
 
@@ -593,7 +595,7 @@ storageAzureNewWrite(THIS_VOID, const String *const file, const StorageInterface
     ASSERT(param.group == NULL);
     ASSERT(param.timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteAzureNew(this, file, this->fileId++, this->blockSize));
+    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteAzureNew(this, file, this->fileId++, this->blockSize, this->blockMax));
 }
 
 /**********************************************************************************************************************************/
@@ -601,10 +603,30 @@ typedef struct StorageAzurePathRemoveData
 {
     StorageAzure *this;                                             // Storage object
     MemContext *memContext;                                         // Mem context to create requests in
-    HttpRequest *request;                                           // Async remove request
+    List *requestList;                                              // Async remove requests in progress (oldest first)
     const String *path;                                             // Root path of remove
 } StorageAzurePathRemoveData;
 
+// Get the response for the oldest async remove request
+static void
+storageAzurePathRemoveResponse(StorageAzurePathRemoveData *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+    ASSERT(!lstEmpty(data->requestList));
+
+    HttpRequest *const request = *(HttpRequest **)lstGet(data->requestList, 0);
+
+    httpResponseFree(storageAzureResponseP(request, .allowMissing = true));
+    httpRequestFree(request);
+    lstRemoveIdx(data->requestList, 0);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static void
 storageAzurePathRemoveCallback(void *const callbackData, const StorageInfo *const info)
 {
@@ -618,21 +640,19 @@ storageAzurePathRemoveCallback(void *const callbackData, const StorageInfo *cons
 
     StorageAzurePathRemoveData *const data = callbackData;
 
-    // Get response from prior async request
-    if (data->request != NULL)
-    {
-        httpResponseFree(storageAzureResponseP(data->request, .allowMissing = true));
-        httpRequestFree(data->request);
-        data->request = NULL;
-    }
-
     // Only delete files since paths don't really exist
     if (info->type == storageTypeFile)
     {
+        // Complete prior async requests until there is room for another
+        while (lstSize(data->requestList) >= data->this->requestMax)
+            storageAzurePathRemoveResponse(data);
+
         MEM_CONTEXT_BEGIN(data->memContext)
         {
-            data->request = storageAzureRequestAsyncP(
+            HttpRequest *const request = storageAzureRequestAsyncP(
                 data->this, HTTP_VERB_DELETE_STR, strNewFmt("%s/%s", strZ(data->path), strZ(info->name)));
+
+            lstAdd(data->requestList, &request);
         }
         MEM_CONTEXT_END();
     }
@@ -661,14 +681,15 @@ storageAzurePathRemove(THIS_VOID, const String *const path, const bool recurse,
         {
             .this = this,
             .memContext = memContextCurrent(),
+            .requestList = lstNewP(sizeof(HttpRequest *)),
             .path = strEq(path, FSLASH_STR) ? EMPTY_STR : path,
         };
 
         storageAzureListInternal(this, path, storageInfoLevelType, NULL, true, storageAzurePathRemoveCallback, &data);
 
-        // Check response on last async request
-        if (data.request != NULL)
-            storageAzureResponseP(data.request, .allowMissing = true);
+        // Check responses on remaining async requests
+        while (!lstEmpty(data.requestList))
+            storageAzurePathRemoveResponse(&data);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -711,8 +732,9 @@ FN_EXTERN Storage *
 storageAzureNew(
     const String *const path, const bool write, StoragePathExpressionCallback pathExpressionFunction, const String *const container,
     const String *const account, const StorageAzureKeyType keyType, const String *const key, const size_t blockSize,
-    const KeyValue *const tag, const String *const endpoint, const StorageAzureUriStyle uriStyle, const unsigned int port,
-    const TimeMSec timeout, const bool verifyPeer, const String *const caFile, const String *const caPath)
+    const unsigned int blockMax, const unsigned int requestMax, const KeyValue *const tag, const String *const endpoint,
+    const StorageAzureUriStyle uriStyle, const unsigned int port, const TimeMSec timeout, const bool verifyPeer,
+    const String *const caFile, const String *const caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -723,6 +745,8 @@ storageAzureNew(
         FUNCTION_LOG_PARAM(STRING_ID, keyType);
         FUNCTION_TEST_PARAM(STRING, key);
         FUNCTION_LOG_PARAM(SIZE, blockSize);
+        FUNCTION_LOG_PARAM(UINT, blockMax);
+        FUNCTION_LOG_PARAM(UINT, requestMax);
         FUNCTION_LOG_PARAM(KEY_VALUE, tag);
         FUNCTION_LOG_PARAM(STRING, endpoint);
         FUNCTION_LOG_PARAM(ENUM, uriStyle);
@@ -739,6 +763,8 @@ storageAzureNew(
     ASSERT(endpoint != NULL);
     ASSERT(key != NULL);
     ASSERT(blockSize != 0);
+    ASSERT(blockMax != 0);
+    ASSERT(requestMax != 0);
 
     OBJ_NEW_BEGIN(StorageAzure, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -748,6 +774,8 @@ storageAzureNew(
             .container = strDup(container),
             .account = strDup(account),
             .blockSize = blockSize,
+            .blockMax = blockMax,
+            .requestMax = requestMax,
             .host = uriStyle == storageAzureUriStyleHost ? strNewFmt("%s.%s", strZ(account), strZ(endpoint)) : strDup(endpoint),
             .pathPrefix =
                 uriStyle == storageAzureUriStyleHost ?
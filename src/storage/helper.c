@@ -5,6 +5,7 @@ Storage Helper
 
 #include <string.h>
 
+#include "common/compress/helper.h"
 #include "common/debug.h"
 #include "common/io/io.h"
 #include "common/memContext.h"
@@ -21,12 +22,14 @@ Storage path constants
 STRING_EXTERN(STORAGE_SPOOL_ARCHIVE_STR,                            STORAGE_SPOOL_ARCHIVE);
 STRING_EXTERN(STORAGE_SPOOL_ARCHIVE_IN_STR,                         STORAGE_SPOOL_ARCHIVE_IN);
 STRING_EXTERN(STORAGE_SPOOL_ARCHIVE_OUT_STR,                        STORAGE_SPOOL_ARCHIVE_OUT);
+STRING_EXTERN(STORAGE_SPOOL_BACKUP_STR,                             STORAGE_SPOOL_BACKUP);
 
 STRING_EXTERN(STORAGE_REPO_ARCHIVE_STR,                             STORAGE_REPO_ARCHIVE);
 STRING_EXTERN(STORAGE_REPO_BACKUP_STR,                              STORAGE_REPO_BACKUP);
 
 STRING_EXTERN(STORAGE_PATH_ARCHIVE_STR,                             STORAGE_PATH_ARCHIVE);
 STRING_EXTERN(STORAGE_PATH_BACKUP_STR,                              STORAGE_PATH_BACKUP);
+STRING_EXTERN(STORAGE_PATH_BLOCK_STR,                               STORAGE_PATH_BLOCK);
 
 /***********************************************************************************************************************************
 Error message when writable storage is requested in dry-run mode
@@ -190,7 +193,8 @@ storagePgGet(const unsigned int pgIdx, const bool write)
     {
         result = storageRemoteNew(
             STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, write, NULL,
-            protocolRemoteGet(protocolStorageTypePg, pgIdx), cfgOptionUInt(cfgOptCompressLevelNetwork));
+            protocolRemoteGet(protocolStorageTypePg, pgIdx), compressTypeEnum(cfgOptionStrId(cfgOptCompressTypeNetwork)),
+            cfgOptionUInt(cfgOptCompressLevelNetwork));
     }
     // Use Posix storage
     else
@@ -361,7 +365,8 @@ storageRepoGet(const unsigned int repoIdx, const bool write)
     {
         result = storageRemoteNew(
             STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, write, storageRepoPathExpression,
-            protocolRemoteGet(protocolStorageTypeRepo, repoIdx), cfgOptionUInt(cfgOptCompressLevelNetwork));
+            protocolRemoteGet(protocolStorageTypeRepo, repoIdx), compressTypeEnum(cfgOptionStrId(cfgOptCompressTypeNetwork)),
+            cfgOptionUInt(cfgOptCompressLevelNetwork));
     }
     // Use local storage
     else
@@ -514,6 +519,13 @@ storageSpoolPathExpression(const String *const expression, const String *const p
         else
             result = strNewFmt(STORAGE_PATH_ARCHIVE "/%s/out/%s", strZ(storageHelper.stanza), strZ(path));
     }
+    else if (strEqZ(expression, STORAGE_SPOOL_BACKUP))
+    {
+        if (path == NULL)
+            result = strNewFmt(STORAGE_PATH_BACKUP "/%s", strZ(storageHelper.stanza));
+        else
+            result = strNewFmt(STORAGE_PATH_BACKUP "/%s/%s", strZ(storageHelper.stanza), strZ(path));
+    }
     else
         THROW_FMT(AssertError, "invalid expression '%s'", strZ(expression));
 
@@ -15,6 +15,8 @@ STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_STR);
 STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_IN_STR);
 #define STORAGE_SPOOL_ARCHIVE_OUT                                   "<SPOOL:ARCHIVE:OUT>"
 STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_OUT_STR);
+#define STORAGE_SPOOL_BACKUP                                        "<SPOOL:BACKUP>"
+STRING_DECLARE(STORAGE_SPOOL_BACKUP_STR);
 
 #define STORAGE_REPO_ARCHIVE                                        "<REPO:ARCHIVE>"
 STRING_DECLARE(STORAGE_REPO_ARCHIVE_STR);
@@ -25,6 +27,8 @@ STRING_DECLARE(STORAGE_REPO_BACKUP_STR);
 STRING_DECLARE(STORAGE_PATH_ARCHIVE_STR);
 #define STORAGE_PATH_BACKUP                                         "backup"
 STRING_DECLARE(STORAGE_PATH_BACKUP_STR);
+#define STORAGE_PATH_BLOCK                                          "block"
+STRING_DECLARE(STORAGE_PATH_BLOCK_STR);
 
 /***********************************************************************************************************************************
 Functions
@@ -4,15 +4,46 @@ Posix Storage Read
 #include "build.auto.h"
 
 #include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef HAVE_COPY_FILE_RANGE
+#include <sys/syscall.h>
+#endif
+
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/io/read.h"
+#include "common/io/uring.h"
 #include "common/log.h"
 #include "common/type/object.h"
 #include "storage/posix/read.h"
 #include "storage/read.intern.h"
 
+#ifdef HAVE_COPY_FILE_RANGE
+/***********************************************************************************************************************************
+syscall() is not declared when only POSIX features are requested. Requesting GNU features would also change other declarations (e.g.
+strerror_r()) and would not be reliable in a single module since the system headers may already have been included.
+***********************************************************************************************************************************/
+long syscall(long number, ...);
+#endif
+
+/***********************************************************************************************************************************
+Maximum reads that can be in progress for a file when io_uring is available
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+#define STORAGE_READ_POSIX_AHEAD_MAX                                4
+
+typedef struct StorageReadPosixAhead
+{
+    IoUringOp *op;                                                  // Read operation
+    unsigned int bufferIdx;                                         // Pool buffer read into
+    size_t size;                                                    // Size requested (0 when no read was queued)
+    size_t used;                                                    // Bytes already copied out of the buffer
+} StorageReadPosixAhead;
+#endif
+
 /***********************************************************************************************************************************
 Object types
 ***********************************************************************************************************************************/
@@ -24,7 +55,15 @@ typedef struct StorageReadPosix
     int fd;                                                         // File descriptor
     uint64_t current;                                               // Current bytes read from file
     uint64_t limit;                                                 // Limit bytes to be read from file (UINT64_MAX for no limit)
+    uint64_t cacheDropped;                                          // Bytes read that have been dropped from the page cache
     bool eof;
+
+#ifdef HAVE_IO_URING
+    StorageReadPosixAhead aheadList[STORAGE_READ_POSIX_AHEAD_MAX]; // Reads in progress (oldest at aheadIdx)
+    unsigned int aheadTotal;                                        // Total reads in use (0 when reading with blocking IO)
+    unsigned int aheadIdx;                                          // Read to copy data from next
+    uint64_t aheadOffset;                                           // Offset of the next read to queue
+#endif
 } StorageReadPosix;
 
 /***********************************************************************************************************************************
@@ -35,6 +74,32 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_POSIX_FORMAT(value, buffer, bufferSize)                                                          \
     objNameToLog(value, "StorageReadPosix", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Free reads in progress and return their buffers to the pool. Freeing a read waits for it to complete so the buffer is not written to
+after it has been returned.
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+static void
+storageReadPosixAheadFree(StorageReadPosix *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_POSIX, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int aheadIdx = 0; aheadIdx < this->aheadTotal; aheadIdx++)
+    {
+        ioUringOpFree(this->aheadList[aheadIdx].op);
+        ioUringBufferFree(this->aheadList[aheadIdx].bufferIdx);
+    }
+
+    this->aheadTotal = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+#endif
+
 /***********************************************************************************************************************************
 Close file descriptor
 ***********************************************************************************************************************************/
@@ -49,12 +114,72 @@ storageReadPosixFreeResource(THIS_VOID)
 
     ASSERT(this != NULL);
 
+#ifdef HAVE_IO_URING
+    // Wait for reads in progress before the buffers are returned and the file descriptor is closed
+    storageReadPosixAheadFree(this);
+#endif
+
     if (this->fd != -1)
         THROW_ON_SYS_ERROR_FMT(close(this->fd) == -1, FileCloseError, STORAGE_ERROR_READ_CLOSE, strZ(this->interface.name));
 
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Drop data that has been read from the page cache. Unless forced, the request is only made when enough data has been read since the
+last request to be worth the system call.
+***********************************************************************************************************************************/
+static void
+storageReadPosixCacheDrop(StorageReadPosix *const this, const bool force)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_POSIX, this);
+        FUNCTION_TEST_PARAM(BOOL, force);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL && this->fd != -1);
+
+    const uint64_t size = this->current - this->cacheDropped;
+
+    if (ioCacheDrop() && size > 0 && (force || size >= ioBufferSize() * STORAGE_POSIX_CACHE_DROP_BUFFER))
+    {
+        posix_fadvise(this->fd, (off_t)(this->interface.offset + this->cacheDropped), (off_t)size, POSIX_FADV_DONTNEED);
+        this->cacheDropped = this->current;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Queue a read ahead of the data that has been returned so far. No read is queued when the limit has been reached.
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+static void
+storageReadPosixAheadQueue(StorageReadPosix *const this, StorageReadPosixAhead *const ahead)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_POSIX, this);
+        FUNCTION_TEST_PARAM_P(VOID, ahead);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(ahead != NULL);
+
+    const uint64_t remains = this->limit - (this->aheadOffset - this->interface.offset);
+
+    ahead->size = remains < ioUringBufferSize() ? (size_t)remains : ioUringBufferSize();
+    ahead->used = 0;
+
+    if (ahead->size > 0)
+    {
+        ioUringRead(ahead->op, this->fd, ahead->bufferIdx, ahead->size, this->aheadOffset);
+        this->aheadOffset += ahead->size;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+#endif
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -90,6 +215,41 @@ storageReadPosixOpen(THIS_VOID)
         // Set free callback to ensure the file descriptor is freed
         memContextCallbackSet(objMemContext(this), storageReadPosixFreeResource, this);
 
+#ifdef HAVE_IO_URING
+        // Queue reads ahead when io_uring is available so the file is read while the caller processes data. Reads are positioned
+        // so the file offset is not used. No more reads are queued than are needed to read the file (or up to the limit) so buffers
+        // are not held for data that does not exist. A file smaller than a buffer is read with blocking IO since there would be
+        // nothing for a single read to overlap with.
+        struct stat statFile;
+
+        if (ioUringAvailable() && fstat(this->fd, &statFile) == 0)
+        {
+            const uint64_t fileSize = (uint64_t)statFile.st_size;
+            uint64_t aheadSize = fileSize > this->interface.offset ? fileSize - this->interface.offset : 0;
+
+            if (aheadSize > this->limit)
+                aheadSize = this->limit;
+
+            const uint64_t aheadMax = aheadSize < ioUringBufferSize() ? 0 : (aheadSize - 1) / ioUringBufferSize() + 1;
+
+            this->aheadOffset = this->interface.offset;
+
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                while (
+                    this->aheadTotal < STORAGE_READ_POSIX_AHEAD_MAX && this->aheadTotal < aheadMax &&
+                    ioUringBufferGet(&this->aheadList[this->aheadTotal].bufferIdx))
+                {
+                    this->aheadList[this->aheadTotal].op = ioUringOpNew();
+                    this->aheadTotal++;
+
+                    storageReadPosixAheadQueue(this, &this->aheadList[this->aheadTotal - 1]);
+                }
+            }
+            MEM_CONTEXT_OBJ_END();
+        }
+#endif
+
         // Seek to offset
         if (this->interface.offset != 0)
         {
@@ -97,11 +257,84 @@ storageReadPosixOpen(THIS_VOID)
                 lseek(this->fd, (off_t)this->interface.offset, SEEK_SET) == -1, FileOpenError, STORAGE_ERROR_READ_SEEK,
                 this->interface.offset, strZ(this->interface.name));
         }
+
+        // Advise that the file will be read sequentially so the kernel reads ahead more aggressively
+        posix_fadvise(this->fd, (off_t)this->interface.offset, 0, POSIX_FADV_SEQUENTIAL);
     }
 
     FUNCTION_LOG_RETURN(BOOL, this->fd != -1);
 }
 
+/***********************************************************************************************************************************
+Read from a file using reads in progress
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+static size_t
+storageReadPosixAhead(StorageReadPosix *const this, Buffer *const buffer)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_POSIX, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL && this->aheadTotal > 0);
+    ASSERT(buffer != NULL && !bufFull(buffer));
+
+    // Copy data until the buffer is full or EOF
+    size_t actualBytes = 0;
+
+    while (!this->eof && !bufFull(buffer))
+    {
+        StorageReadPosixAhead *const ahead = &this->aheadList[this->aheadIdx];
+
+        // If no read was queued then the limit has been reached
+        if (ahead->size == 0)
+        {
+            this->eof = true;
+            break;
+        }
+
+        ioUringWait(ahead->op);
+
+        const int result = ioUringResult(ahead->op);
+
+        if (result == -1)
+            THROW_SYS_ERROR_FMT(FileReadError, "unable to read '%s'", strZ(this->interface.name));
+
+        // Copy as much data as possible to the buffer
+        size_t copyBytes = (size_t)result - ahead->used;
+
+        if (copyBytes > bufRemains(buffer))
+            copyBytes = bufRemains(buffer);
+
+        memcpy(bufRemainsPtr(buffer), ioUringBuffer(ahead->bufferIdx) + ahead->used, copyBytes);
+        bufUsedInc(buffer, copyBytes);
+        ahead->used += copyBytes;
+        this->current += copyBytes;
+        actualBytes += copyBytes;
+
+        // When all data has been copied from the read then EOF if the read was short, else queue the next read
+        if (ahead->used == (size_t)result)
+        {
+            if ((size_t)result != ahead->size)
+                this->eof = true;
+            else
+            {
+                storageReadPosixAheadQueue(this, ahead);
+                this->aheadIdx = (this->aheadIdx + 1) % this->aheadTotal;
+            }
+        }
+
+        if (this->current == this->limit)
+            this->eof = true;
+    }
+
+    storageReadPosixCacheDrop(this, false);
+
+    FUNCTION_LOG_RETURN(SIZE, actualBytes);
+}
+#endif
+
 /***********************************************************************************************************************************
 Read from a file
 ***********************************************************************************************************************************/
@@ -119,6 +352,12 @@ storageReadPosix(THIS_VOID, Buffer *const buffer, const bool block)
     ASSERT(this != NULL && this->fd != -1);
     ASSERT(buffer != NULL && !bufFull(buffer));
 
+#ifdef HAVE_IO_URING
+    // Copy data from reads in progress when io_uring is being used
+    if (this->aheadTotal > 0)
+        FUNCTION_LOG_RETURN(SIZE, storageReadPosixAhead(this, buffer));
+#endif
+
     // Read if EOF has not been reached
     ssize_t actualBytes = 0;
 
@@ -145,11 +384,83 @@ storageReadPosix(THIS_VOID, Buffer *const buffer, const bool block)
         // not concerned with files that are growing. Just read up to the point where the file is being extended.
         if ((size_t)actualBytes != expectedBytes || this->current == this->limit)
             this->eof = true;
+
+        storageReadPosixCacheDrop(this, false);
     }
 
     FUNCTION_LOG_RETURN(SIZE, (size_t)actualBytes);
 }
 
+/***********************************************************************************************************************************
+Copy directly to a file descriptor with copy_file_range(). The data does not pass through user space and filesystems that support
+cloning (e.g. btrfs and XFS) share extents rather than copying data. The copy is done in chunks so data can be dropped from the page
+cache at the same interval as reads.
+***********************************************************************************************************************************/
+#ifdef HAVE_COPY_FILE_RANGE
+static bool
+storageReadPosixCopy(THIS_VOID, const int fd, const uint64_t size)
+{
+    THIS(StorageReadPosix);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_POSIX, this);
+        FUNCTION_LOG_PARAM(INT, fd);
+        FUNCTION_LOG_PARAM(UINT64, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL && this->fd != -1);
+    ASSERT(fd != -1);
+
+#ifdef HAVE_IO_URING
+    // Reads ahead will not be used
+    storageReadPosixAheadFree(this);
+#endif
+
+    // Copy from the current position until EOF or the size has been copied. The position is passed explicitly since reads ahead do
+    // not update the file offset.
+    const uint64_t copySize = size < this->limit - this->current ? size : this->limit - this->current;
+    int64_t offset = (int64_t)(this->interface.offset + this->current);
+    const size_t chunkSize = ioBufferSize() * STORAGE_POSIX_CACHE_DROP_BUFFER;
+    uint64_t copied = 0;
+    bool result = true;
+
+    while (!this->eof && copied < copySize)
+    {
+        const uint64_t remains = copySize - copied;
+        const ssize_t actualBytes = (ssize_t)syscall(
+            __NR_copy_file_range, this->fd, &offset, fd, NULL, remains < chunkSize ? (size_t)remains : chunkSize, 0);
+
+        if (actualBytes == -1)
+        {
+            // If nothing has been copied then the caller can copy through user space instead, e.g. when the kernel does not
+            // support copies between filesystems or the destination is not a regular file
+            if (copied == 0)
+            {
+                result = false;
+                break;
+            }
+
+            THROW_SYS_ERROR_FMT(FileReadError, "unable to copy '%s'", strZ(this->interface.name));
+        }
+
+        copied += (uint64_t)actualBytes;
+        this->current += (uint64_t)actualBytes;
+
+        if (actualBytes == 0 || this->current == this->limit)
+            this->eof = true;
+
+        storageReadPosixCacheDrop(this, false);
+    }
+
+    // Update the file offset so reads continue after the copied data
+    THROW_ON_SYS_ERROR_FMT(
+        lseek(this->fd, (off_t)offset, SEEK_SET) == -1, FileReadError, STORAGE_ERROR_READ_SEEK, (uint64_t)offset,
+        strZ(this->interface.name));
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+#endif
+
 /***********************************************************************************************************************************
 Close the file
 ***********************************************************************************************************************************/
@@ -164,6 +475,8 @@ storageReadPosixClose(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    storageReadPosixCacheDrop(this, true);
+
     memContextCallbackClear(objMemContext(this));
     storageReadPosixFreeResource(this);
     this->fd = -1;
@@ -239,6 +552,9 @@ storageReadPosixNew(
                 .ignoreMissing = ignoreMissing,
                 .offset = offset,
                 .limit = varDup(limit),
+#ifdef HAVE_COPY_FILE_RANGE
+                .copy = storageReadPosixCopy,
+#endif
 
                 .ioInterface = (IoReadInterface)
                 {
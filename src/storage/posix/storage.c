@@ -13,6 +13,7 @@ Posix Storage
 #include <unistd.h>
 
 #include "common/debug.h"
+#include "common/io/uring.h"
 #include "common/log.h"
 #include "common/regExp.h"
 #include "common/user.h"
@@ -529,18 +530,50 @@ storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterface
     }
     else
     {
-        // Attempt to sync the directory
-        if (fsync(fd) == -1)
+#ifdef HAVE_IO_URING
+        // Submit the sync and close together when io_uring is available
+        if (ioUringAvailable())
         {
-            const int errNo = errno;
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                IoUringOp *const opSync = ioUringOpNew();
+                IoUringOp *const opClose = ioUringOpNew();
+
+                ioUringSync(opSync, fd, true);
+                ioUringClose(opClose, fd, false);
+                ioUringWait(opSync);
+                ioUringWait(opClose);
+
+                // If the sync failed then the close was cancelled so close the file descriptor but don't check for failure
+                if (ioUringResult(opSync) == -1)
+                {
+                    const int errNo = errno;
 
-            // Close the file descriptor to free resources but don't check for failure
-            close(fd);
+                    close(fd);
 
-            THROW_SYS_ERROR_CODE_FMT(errNo, PathSyncError, STORAGE_ERROR_PATH_SYNC, strZ(path));
+                    THROW_SYS_ERROR_CODE_FMT(errNo, PathSyncError, STORAGE_ERROR_PATH_SYNC, strZ(path));
+                }
+
+                THROW_ON_SYS_ERROR_FMT(ioUringResult(opClose) == -1, PathCloseError, STORAGE_ERROR_PATH_SYNC_CLOSE, strZ(path));
+            }
+            MEM_CONTEXT_TEMP_END();
         }
+        else
+#endif
+        {
+            // Attempt to sync the directory
+            if (fsync(fd) == -1)
+            {
+                const int errNo = errno;
 
-        THROW_ON_SYS_ERROR_FMT(close(fd) == -1, PathCloseError, STORAGE_ERROR_PATH_SYNC_CLOSE, strZ(path));
+                // Close the file descriptor to free resources but don't check for failure
+                close(fd);
+
+                THROW_SYS_ERROR_CODE_FMT(errNo, PathSyncError, STORAGE_ERROR_PATH_SYNC, strZ(path));
+            }
+
+            THROW_ON_SYS_ERROR_FMT(close(fd) == -1, PathCloseError, STORAGE_ERROR_PATH_SYNC_CLOSE, strZ(path));
+        }
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -6,6 +6,11 @@ Posix Storage Internal
 
 #include "storage/posix/storage.h"
 
+/***********************************************************************************************************************************
+Number of IO buffers read or written between requests to drop file data from the page cache when ioCacheDrop() is enabled
+***********************************************************************************************************************************/
+#define STORAGE_POSIX_CACHE_DROP_BUFFER                             8
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -3,12 +3,16 @@ Posix Storage File write
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <utime.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
+#include "common/io/uring.h"
 #include "common/io/write.h"
 #include "common/log.h"
 #include "common/type/object.h"
@@ -27,6 +31,7 @@ typedef struct StorageWritePosix
     const String *nameTmp;
     const String *path;
     int fd;                                                         // File descriptor
+    uint64_t cacheWritten;                                          // Bytes written since the last page cache drop
 } StorageWritePosix;
 
 /***********************************************************************************************************************************
@@ -154,6 +159,25 @@ storageWritePosixOpen(THIS_VOID)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Drop written data from the page cache. Only clean pages can be dropped but on Linux the request also starts writeback of dirty
+pages, which can then be dropped by a later request. This keeps dirty pages from accumulating while a large file is written.
+***********************************************************************************************************************************/
+static void
+storageWritePosixCacheDrop(StorageWritePosix *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_POSIX, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL && this->fd != -1);
+
+    posix_fadvise(this->fd, 0, 0, POSIX_FADV_DONTNEED);
+    this->cacheWritten = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Write to the file
 ***********************************************************************************************************************************/
@@ -175,9 +199,113 @@ storageWritePosix(THIS_VOID, const Buffer *const buffer)
     if (write(this->fd, bufPtrConst(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
         THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strZ(this->nameTmp));
 
+    // Drop written data from the page cache when enough has been written since the last drop
+    if (ioCacheDrop())
+    {
+        this->cacheWritten += bufUsed(buffer);
+
+        if (this->cacheWritten >= ioBufferSize() * STORAGE_POSIX_CACHE_DROP_BUFFER)
+            storageWritePosixCacheDrop(this);
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Sync and close the file with io_uring. When the file will be renamed and the path synced (and the kernel supports rename) the rename
+and path sync are linked to the close, so all the syncs for the file are submitted together with a single system call. Returns true
+when the modified time, rename, and path sync have been done.
+***********************************************************************************************************************************/
+#ifdef HAVE_IO_URING
+static bool
+storageWritePosixCloseUring(StorageWritePosix *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE_POSIX, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL && this->fd != -1);
+
+    // Open the path before anything is queued. If the path cannot be opened then the path sync will report the error later.
+    int fdPath = -1;
+
+    if (this->interface.atomic && this->interface.syncPath && ioUringRenameAvailable())
+        fdPath = open(strZ(this->path), O_RDONLY, 0);
+
+    const bool link = fdPath != -1;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Set the modified time on the file descriptor since the file will be renamed before it is possible to set it by name
+        if (link && this->interface.timeModified != 0)
+        {
+            const struct timespec timeModified = {.tv_sec = this->interface.timeModified};
+
+            if (futimens(this->fd, (const struct timespec[]){timeModified, timeModified}) == -1)
+            {
+                const int errNo = errno;
+
+                close(fdPath);
+
+                THROW_SYS_ERROR_CODE_FMT(errNo, FileInfoError, "unable to set time for '%s'", strZ(this->nameTmp));
+            }
+        }
+
+        // Queue operations, each linked to the next so the rest are cancelled on failure
+        IoUringOp *const opSync = ioUringOpNew();
+        IoUringOp *const opClose = ioUringOpNew();
+        IoUringOp *const opRename = link ? ioUringOpNew() : NULL;
+        IoUringOp *const opPathSync = link ? ioUringOpNew() : NULL;
+        IoUringOp *const opPathClose = link ? ioUringOpNew() : NULL;
+
+        ioUringSync(opSync, this->fd, true);
+        ioUringClose(opClose, this->fd, link);
+
+        if (link)
+        {
+            ioUringRename(opRename, strZ(this->nameTmp), strZ(this->interface.name), true);
+            ioUringSync(opPathSync, fdPath, true);
+            ioUringClose(opPathClose, fdPath, false);
+        }
+
+        // Wait for operations in order
+        ioUringWait(opSync);
+        ioUringWait(opClose);
+
+        if (link)
+        {
+            ioUringWait(opRename);
+            ioUringWait(opPathSync);
+            ioUringWait(opPathClose);
+
+            // Close the path if the close was cancelled because an operation it was linked to failed
+            if (ioUringResult(opPathClose) == -1 && errno == ECANCELED)
+                close(fdPath);
+        }
+
+        // If the sync failed then the close was cancelled and the file will be closed by the free callback
+        THROW_ON_SYS_ERROR_FMT(ioUringResult(opSync) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+
+        memContextCallbackClear(objMemContext(this));
+        THROW_ON_SYS_ERROR_FMT(ioUringResult(opClose) == -1, FileCloseError, STORAGE_ERROR_WRITE_CLOSE, strZ(this->nameTmp));
+        this->fd = -1;
+
+        if (link)
+        {
+            THROW_ON_SYS_ERROR_FMT(
+                ioUringResult(opRename) == -1, FileMoveError, "unable to move '%s' to '%s'", strZ(this->nameTmp),
+                strZ(this->interface.name));
+            THROW_ON_SYS_ERROR_FMT(ioUringResult(opPathSync) == -1, PathSyncError, STORAGE_ERROR_PATH_SYNC, strZ(this->path));
+            THROW_ON_SYS_ERROR_FMT(
+                ioUringResult(opPathClose) == -1, PathCloseError, STORAGE_ERROR_PATH_SYNC_CLOSE, strZ(this->path));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, link);
+}
+#endif
+
 /***********************************************************************************************************************************
 Close the file
 ***********************************************************************************************************************************/
@@ -195,35 +323,56 @@ storageWritePosixClose(THIS_VOID)
     // Close if the file has not already been closed
     if (this->fd != -1)
     {
-        // Sync the file
-        if (this->interface.syncFile)
-            THROW_ON_SYS_ERROR_FMT(fsync(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+        bool renamed = false;                                       // Have the modified time, rename, and path sync been done?
 
-        // Close the file
-        memContextCallbackClear(objMemContext(this));
-        THROW_ON_SYS_ERROR_FMT(close(this->fd) == -1, FileCloseError, STORAGE_ERROR_WRITE_CLOSE, strZ(this->nameTmp));
-        this->fd = -1;
-
-        // Update modified time
-        if (this->interface.timeModified != 0)
+#ifdef HAVE_IO_URING
+        // Submit the syncs and closes together when io_uring is available. This is not possible when the page cache will be dropped
+        // since the file must still be open after the sync.
+        if (this->interface.syncFile && !ioCacheDrop() && ioUringAvailable())
+            renamed = storageWritePosixCloseUring(this);
+        else
+#endif
         {
-            THROW_ON_SYS_ERROR_FMT(
-                utime(
-                    strZ(this->nameTmp),
-                    &((struct utimbuf){.actime = this->interface.timeModified, .modtime = this->interface.timeModified})) == -1,
-                FileInfoError, "unable to set time for '%s'", strZ(this->nameTmp));
+            // Sync the file
+            if (this->interface.syncFile)
+                THROW_ON_SYS_ERROR_FMT(fsync(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+
+            // Drop the file from the page cache. If the file was synced then all pages are clean and can be dropped.
+            if (ioCacheDrop())
+                storageWritePosixCacheDrop(this);
+
+            // Close the file
+            memContextCallbackClear(objMemContext(this));
+            THROW_ON_SYS_ERROR_FMT(close(this->fd) == -1, FileCloseError, STORAGE_ERROR_WRITE_CLOSE, strZ(this->nameTmp));
+            this->fd = -1;
         }
 
-        // Rename from temp file
-        if (this->interface.atomic)
+        if (!renamed)
         {
-            if (rename(strZ(this->nameTmp), strZ(this->interface.name)) == -1)
-                THROW_SYS_ERROR_FMT(FileMoveError, "unable to move '%s' to '%s'", strZ(this->nameTmp), strZ(this->interface.name));
-        }
+            // Update modified time
+            if (this->interface.timeModified != 0)
+            {
+                THROW_ON_SYS_ERROR_FMT(
+                    utime(
+                        strZ(this->nameTmp),
+                        &((struct utimbuf){.actime = this->interface.timeModified, .modtime = this->interface.timeModified})) == -1,
+                    FileInfoError, "unable to set time for '%s'", strZ(this->nameTmp));
+            }
 
-        // Sync the path
-        if (this->interface.syncPath)
-            storageInterfacePathSyncP(this->storage, this->path);
+            // Rename from temp file
+            if (this->interface.atomic)
+            {
+                if (rename(strZ(this->nameTmp), strZ(this->interface.name)) == -1)
+                {
+                    THROW_SYS_ERROR_FMT(
+                        FileMoveError, "unable to move '%s' to '%s'", strZ(this->nameTmp), strZ(this->interface.name));
+                }
+            }
+
+            // Sync the path
+            if (this->interface.syncPath)
+                storageInterfacePathSyncP(this->storage, this->path);
+        }
     }
 
     FUNCTION_LOG_RETURN_VOID();
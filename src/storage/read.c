@@ -4,6 +4,7 @@ Storage Read Interface
 #include "build.auto.h"
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "storage/read.h"
@@ -56,6 +57,39 @@ storageReadNew(void *const driver, const StorageReadInterface *const interface)
     FUNCTION_LOG_RETURN(STORAGE_READ, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+storageReadCopy(StorageRead *const this, IoWrite *const destination, const StorageReadCopyParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ, this);
+        FUNCTION_LOG_PARAM(IO_WRITE, destination);
+        FUNCTION_LOG_PARAM(VARIANT, param.limit);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(destination != NULL);
+
+    bool copied = false;
+
+    // Copy directly when possible. Filters need to see the data so they prevent a direct copy.
+    if (this->pub.interface->copy != NULL && ioWriteFd(destination) != -1 &&
+        ioFilterGroupPassThru(ioReadFilterGroup(storageReadIo(this))) && ioFilterGroupPassThru(ioWriteFilterGroup(destination)))
+    {
+        // Write any data buffered by the destination before the copied data
+        ioWriteFlush(destination);
+
+        copied = this->pub.interface->copy(
+            this->driver, ioWriteFd(destination), param.limit == NULL ? UINT64_MAX : varUInt64(param.limit));
+    }
+
+    // Else copy through user space
+    if (!copied)
+        ioCopyP(storageReadIo(this), destination, .limit = param.limit);
+
+    FUNCTION_LOG_RETURN(BOOL, copied);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageReadToLog(const StorageRead *const this, StringStatic *const debugLog)
@@ -10,6 +10,7 @@ Object type
 typedef struct StorageRead StorageRead;
 
 #include "common/io/read.h"
+#include "common/io/write.h"
 #include "common/type/object.h"
 #include "common/type/stringId.h"
 #include "storage/read.intern.h"
@@ -23,6 +24,20 @@ storageReadMove(StorageRead *const this, MemContext *const parentNew)
     return objMove(this, parentNew);
 }
 
+// Copy to a write. The data is copied directly to the destination file without passing through user space when the driver supports
+// it, the destination is a file, and neither side has filters. Otherwise ioCopy() is used. Both must be open and no data can have
+// been read from the source with ioRead() since it may be buffered. Returns true if the data was copied directly.
+typedef struct StorageReadCopyParam
+{
+    VAR_PARAM_HEADER;
+    const Variant *limit;                                           // Limit bytes to copy (NULL for no limit)
+} StorageReadCopyParam;
+
+#define storageReadCopyP(this, destination, ...)                                                                                   \
+    storageReadCopy(this, destination, (StorageReadCopyParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN bool storageReadCopy(StorageRead *this, IoWrite *destination, StorageReadCopyParam param);
+
 /***********************************************************************************************************************************
 Getters/Setters
 ***********************************************************************************************************************************/
@@ -32,6 +47,13 @@ typedef struct StorageReadPub
     IoRead *io;                                                     // Read interface
 } StorageReadPub;
 
+// Can the driver copy directly to a file with storageReadCopy()?
+FN_INLINE_ALWAYS bool
+storageReadCopyDirect(const StorageRead *const this)
+{
+    return THIS_PUB(StorageRead)->interface->copy != NULL;
+}
+
 // Should a missing file be ignored?
 FN_INLINE_ALWAYS bool
 storageReadIgnoreMissing(const StorageRead *const this)
@@ -18,6 +18,11 @@ typedef struct StorageReadInterface
     bool ignoreMissing;
     uint64_t offset;                                                // Where to start reading in the file
     const Variant *limit;                                           // Limit how many bytes are read (NULL for no limit)
+
+    // Copy up to size bytes directly to a file descriptor without passing the data through user space (optional). Returns false
+    // when the copy is not possible, in which case no data was copied.
+    bool (*copy)(void *driver, int fd, uint64_t size);
+
     IoReadInterface ioInterface;
 } StorageReadInterface;
 
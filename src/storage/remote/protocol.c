@@ -163,6 +163,17 @@ storageRemoteFeatureProtocol(PackRead *const param, ProtocolServer *const server
         pckWriteStrP(result, storagePathP(storage, NULL));
         pckWriteU64P(result, storageInterface(storage).feature);
 
+        // Return compression types available for network compression since the remote may not be built with the same libraries
+        unsigned int compressTypeMask = 0;
+
+        for (CompressType compressType = compressTypeNone; compressType <= compressTypeXz; compressType++)
+        {
+            if (compressTypeAvailable(compressType))
+                compressTypeMask |= 1U << compressType;
+        }
+
+        pckWriteU32P(result, compressTypeMask);
+
         protocolServerDataPut(server, result);
         protocolServerDataEndPut(server);
     }
@@ -416,16 +427,10 @@ storageRemoteOpenReadProtocol(PackRead *const param, ProtocolServer *const serve
             {
                 ioRead(fileRead, buffer);
 
+                // Write raw data directly from the buffer to avoid copying it into a pack
                 if (!bufEmpty(buffer))
                 {
-                    MEM_CONTEXT_TEMP_BEGIN()
-                    {
-                        PackWrite *write = pckWriteNewP(.size = ioBufferSize() + PROTOCOL_PACK_DEFAULT_SIZE);
-                        pckWriteBinP(write, buffer);
-                        protocolServerDataPut(server, write);
-                    }
-                    MEM_CONTEXT_TEMP_END();
-
+                    protocolServerDataRawPut(server, buffer);
                     bufUsedZero(buffer);
                 }
             }
@@ -486,12 +491,26 @@ storageRemoteOpenWriteProtocol(PackRead *const param, ProtocolServer *const serv
         protocolServerDataPut(server, NULL);
 
         // Write data
+        Buffer *const buffer = bufNew(ioBufferSize());
+
         do
         {
-            PackRead *read = protocolServerDataGet(server);
+            size_t rawSize;
+            PackRead *read = protocolServerDataRawGet(server, &rawSize);
 
+            // Write raw data. The raw data may be larger than the buffer when the client buffer size is larger so read in chunks.
+            if (rawSize > 0)
+            {
+                do
+                {
+                    bufUsedZero(buffer);
+                    rawSize -= protocolServerDataRawRead(server, buffer, rawSize);
+                    ioWrite(fileWrite, buffer);
+                }
+                while (rawSize > 0);
+            }
             // Write is complete
-            if (read == NULL)
+            else if (read == NULL)
             {
                 ioWriteClose(fileWrite);
 
@@ -500,26 +519,12 @@ storageRemoteOpenWriteProtocol(PackRead *const param, ProtocolServer *const serv
                     server, pckWritePackP(protocolPackNew(), ioFilterGroupResultAll(ioWriteFilterGroup(fileWrite))));
                 break;
             }
-            // Else more data to write
+            // Else write terminated unexpectedly
             else
             {
-                pckReadNext(read);
-
-                // Write data
-                if (pckReadType(read) == pckTypeBin)
-                {
-                    Buffer *const buffer = pckReadBinP(read);
-
-                    ioWrite(fileWrite, buffer);
-                    bufFree(buffer);
-                }
-                // Else write terminated unexpectedly
-                else
-                {
-                    protocolServerDataGet(server);
-                    ioWriteFree(fileWrite);
-                    break;
-                }
+                protocolServerDataGet(server);
+                ioWriteFree(fileWrite);
+                break;
             }
         }
         while (true);
@@ -27,8 +27,8 @@ typedef struct StorageReadRemote
     StorageRead *read;                                              // Storage read interface
 
     ProtocolClient *client;                                         // Protocol client for requests
-    size_t remaining;                                               // Bytes remaining to be read in block
-    Buffer *block;                                                  // Block currently being read
+    CompressType compressType;                                      // Protocol compression type
+    size_t remaining;                                               // Raw bytes remaining to be read from the protocol
     bool eof;                                                       // Has the file reached eof?
 
 #ifdef DEBUG
@@ -62,30 +62,29 @@ storageReadRemoteFreeResource(THIS_VOID)
     // Read if eof has not been reached
     if (!this->eof)
     {
-        do
+        MEM_CONTEXT_TEMP_BEGIN()
         {
-            MEM_CONTEXT_TEMP_BEGIN()
-            {
-                PackRead *const read = protocolClientDataGet(this->client);
-                pckReadNext(read);
+            Buffer *const buffer = bufNew(ioBufferSize());
 
-                // If binary then discard
-                if (pckReadType(read) == pckTypeBin)
+            do
+            {
+                // Discard raw data
+                while (this->remaining > 0)
                 {
-                    pckReadBinP(read);
+                    bufUsedZero(buffer);
+                    this->remaining -= protocolClientDataRawRead(this->client, buffer, this->remaining);
                 }
-                // Else read is complete so discard the filter list
-                else
+
+                // If not raw data then read is complete so discard the filter list
+                if (protocolClientDataRawGet(this->client, &this->remaining) != NULL)
                 {
-                    pckReadPackP(read);
                     protocolClientDataEndGet(this->client);
-
                     this->eof = true;
                 }
             }
-            MEM_CONTEXT_TEMP_END();
+            while (!this->eof);
         }
-        while (!this->eof);
+        MEM_CONTEXT_TEMP_END();
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -115,29 +114,16 @@ storageReadRemote(THIS_VOID, Buffer *buffer, bool block)
     {
         do
         {
-            // If no bytes remaining then read a new block
+            // If no bytes remaining then get the size of the next block of raw data
             if (this->remaining == 0)
             {
                 MEM_CONTEXT_TEMP_BEGIN()
                 {
-                    PackRead *const read = protocolClientDataGet(this->client);
-                    pckReadNext(read);
+                    PackRead *const read = protocolClientDataRawGet(this->client, &this->remaining);
 
-                    // If binary then read the next block
-                    if (pckReadType(read) == pckTypeBin)
-                    {
-                        MEM_CONTEXT_OBJ_BEGIN(this)
-                        {
-                            this->block = pckReadBinP(read);
-                            this->remaining = bufUsed(this->block);
-                        }
-                        MEM_CONTEXT_OBJ_END();
-                    }
-                    // Else read is complete and get the filter list
-                    else
+                    // If not raw data then read is complete and get the filter list
+                    if (read != NULL)
                     {
-                        bufFree(this->block);
-
                         ioFilterGroupResultAllSet(ioReadFilterGroup(storageReadIo(this->read)), pckReadPackP(read));
                         this->eof = true;
 
@@ -151,23 +137,13 @@ storageReadRemote(THIS_VOID, Buffer *buffer, bool block)
                 MEM_CONTEXT_TEMP_END();
             }
 
-            // Read if not eof
+            // Read raw data directly into the caller's buffer
             if (!this->eof)
             {
-                // Copy as much as possible into the output buffer
-                const size_t remains = this->remaining < bufRemains(buffer) ? this->remaining : bufRemains(buffer);
-
-                bufCatSub(buffer, this->block, bufUsed(this->block) - this->remaining, remains);
+                const size_t remains = protocolClientDataRawRead(this->client, buffer, this->remaining);
 
                 result += remains;
                 this->remaining -= remains;
-
-                // If there is no more to copy from the block buffer then free it
-                if (this->remaining == 0)
-                {
-                    bufFree(this->block);
-                    this->block = NULL;
-                }
             }
         }
         while (!this->eof && !bufFull(buffer));
@@ -216,7 +192,7 @@ storageReadRemoteOpen(THIS_VOID)
         {
             ioFilterGroupAdd(
                 ioReadFilterGroup(storageReadIo(this->read)),
-                compressFilterP(compressTypeGz, (int)this->interface.compressLevel, .raw = true));
+                compressFilterP(this->compressType, (int)this->interface.compressLevel, .raw = true));
         }
 
         ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_OPEN_READ);
@@ -245,7 +221,7 @@ storageReadRemoteOpen(THIS_VOID)
 
             // If the file is compressible add decompression filter locally
             if (this->interface.compressible)
-                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(this->read)), decompressFilterP(compressTypeGz, .raw = true));
+                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(this->read)), decompressFilterP(this->compressType, .raw = true));
 
             // Set free callback to ensure the protocol is cleared on a short read
             memContextCallbackSet(objMemContext(this), storageReadRemoteFreeResource, this);
@@ -284,7 +260,8 @@ storageReadRemoteClose(THIS_VOID)
 FN_EXTERN StorageRead *
 storageReadRemoteNew(
     StorageRemote *const storage, ProtocolClient *const client, const String *const name, const bool ignoreMissing,
-    const bool compressible, const unsigned int compressLevel, const uint64_t offset, const Variant *const limit)
+    const bool compressible, const CompressType compressType, const unsigned int compressLevel, const uint64_t offset,
+    const Variant *const limit)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_REMOTE, storage);
@@ -292,6 +269,7 @@ storageReadRemoteNew(
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
         FUNCTION_LOG_PARAM(BOOL, compressible);
+        FUNCTION_LOG_PARAM(ENUM, compressType);
         FUNCTION_LOG_PARAM(UINT, compressLevel);
         FUNCTION_LOG_PARAM(UINT64, offset);
         FUNCTION_LOG_PARAM(VARIANT, limit);
@@ -307,6 +285,7 @@ storageReadRemoteNew(
         {
             .storage = storage,
             .client = client,
+            .compressType = compressType,
 
             .interface = (StorageReadInterface)
             {
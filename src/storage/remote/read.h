@@ -4,6 +4,7 @@ Remote Storage Read
 #ifndef STORAGE_REMOTE_READ_H
 #define STORAGE_REMOTE_READ_H
 
+#include "common/compress/helper.h"
 #include "protocol/client.h"
 #include "storage/read.h"
 #include "storage/remote/storage.intern.h"
@@ -13,6 +14,6 @@ Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN StorageRead *storageReadRemoteNew(
     StorageRemote *storage, ProtocolClient *client, const String *name, bool ignoreMissing, bool compressible,
-    unsigned int compressLevel, uint64_t offset, const Variant *limit);
+    CompressType compressType, unsigned int compressLevel, uint64_t offset, const Variant *limit);
 
 #endif
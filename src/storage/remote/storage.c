@@ -3,6 +3,7 @@ Remote Storage
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "common/compress/helper.h"
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
@@ -19,6 +20,7 @@ struct StorageRemote
 {
     STORAGE_COMMON_MEMBER;
     ProtocolClient *client;                                         // Protocol client
+    CompressType compressType;                                      // Protocol compression type
     unsigned int compressLevel;                                     // Protocol compression level
 };
 
@@ -290,8 +292,9 @@ storageRemoteNewRead(THIS_VOID, const String *file, bool ignoreMissing, StorageI
     FUNCTION_LOG_RETURN(
         STORAGE_READ,
         storageReadRemoteNew(
-            this, this->client, file, ignoreMissing, this->compressLevel > 0 ? param.compressible : false, this->compressLevel,
-            param.offset, param.limit));
+            this, this->client, file, ignoreMissing,
+            this->compressType != compressTypeNone && this->compressLevel > 0 ? param.compressible : false, this->compressType,
+            this->compressLevel, param.offset, param.limit));
 }
 
 /**********************************************************************************************************************************/
@@ -324,7 +327,8 @@ storageRemoteNewWrite(
         STORAGE_WRITE,
         storageWriteRemoteNew(
             this, this->client, file, param.modeFile, param.modePath, param.user, param.group, param.timeModified, param.createPath,
-            param.syncFile, param.syncPath, param.atomic, this->compressLevel > 0 ? param.compressible : false,
+            param.syncFile, param.syncPath, param.atomic,
+            this->compressType != compressTypeNone && this->compressLevel > 0 ? param.compressible : false, this->compressType,
             this->compressLevel));
 }
 
@@ -471,7 +475,7 @@ static const StorageInterface storageInterfaceRemote =
 FN_EXTERN Storage *
 storageRemoteNew(
     const mode_t modeFile, const mode_t modePath, const bool write, StoragePathExpressionCallback pathExpressionFunction,
-    ProtocolClient *const client, const unsigned int compressLevel)
+    ProtocolClient *const client, const CompressType compressType, const unsigned int compressLevel)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MODE, modeFile);
@@ -479,6 +483,7 @@ storageRemoteNew(
         FUNCTION_LOG_PARAM(BOOL, write);
         FUNCTION_LOG_PARAM(FUNCTIONP, pathExpressionFunction);
         FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+        FUNCTION_LOG_PARAM(ENUM, compressType);
         FUNCTION_LOG_PARAM(UINT, compressLevel);
     FUNCTION_LOG_END();
 
@@ -493,6 +498,7 @@ storageRemoteNew(
         *this = (StorageRemote)
         {
             .client = client,
+            .compressType = compressType,
             .compressLevel = compressLevel,
             .interface = storageInterfaceRemote,
         };
@@ -511,6 +517,16 @@ storageRemoteNew(
             MEM_CONTEXT_PRIOR_END();
 
             this->interface.feature = pckReadU64P(result);
+
+            // Fall back to gz when the remote was not built with the requested network compression type. gz is always available.
+            if (!(pckReadU32P(result) & (1U << this->compressType)))
+            {
+                LOG_DETAIL_FMT(
+                    "remote does not support network compression type '%s', using '%s' instead",
+                    strZ(compressTypeStr(this->compressType)), strZ(compressTypeStr(compressTypeGz)));
+
+                this->compressType = compressTypeGz;
+            }
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -4,6 +4,7 @@ Remote Storage File write
 #ifndef STORAGE_REMOTE_WRITE_H
 #define STORAGE_REMOTE_WRITE_H
 
+#include "common/compress/helper.h"
 #include "protocol/client.h"
 #include "storage/remote/storage.intern.h"
 #include "storage/write.h"
@@ -14,6 +15,6 @@ Constructors
 FN_EXTERN StorageWrite *storageWriteRemoteNew(
     StorageRemote *storage, ProtocolClient *client, const String *name, mode_t modeFile, mode_t modePath, const String *user,
     const String *group, time_t timeModified, bool createPath, bool syncFile, bool syncPath, bool atomic, bool compressible,
-    unsigned int compressLevel);
+    CompressType compressType, unsigned int compressLevel);
 
 #endif
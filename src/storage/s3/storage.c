@@ -47,6 +47,7 @@ STRING_STATIC(S3_QUERY_DELETE_STR,                                  "delete");
 STRING_STATIC(S3_QUERY_DELIMITER_STR,                               "delimiter");
 STRING_STATIC(S3_QUERY_LIST_TYPE_STR,                               "list-type");
 STRING_STATIC(S3_QUERY_PREFIX_STR,                                  "prefix");
+STRING_STATIC(S3_QUERY_START_AFTER_STR,                             "start-after");
 
 STRING_STATIC(S3_QUERY_VALUE_LIST_TYPE_2_STR,                       "2");
 
@@ -101,8 +102,10 @@ struct StorageS3
     const String *sseCustomerKey;                                   // Base64 of SSE-C encryption key
     const String *sseCustomerKeyMd5;                                // Base64 of MD5 of SSE-C key
     size_t partSize;                                                // Part size for multi-part upload
+    unsigned int partMax;                                           // Maximum parts uploading concurrently
     const String *tag;                                              // Tags to be applied to objects
     unsigned int deleteMax;                                         // Maximum objects that can be deleted in one request
+    unsigned int requestMax;                                        // Maximum remove requests in progress concurrently
     StorageS3UriStyle uriStyle;                                     // Path or host style URIs
     const String *bucketEndpoint;                                   // Set to {bucket}.{endpoint}
 
@@ -629,9 +632,200 @@ storageS3Request(StorageS3 *const this, const String *const verb, const String *
     FUNCTION_LOG_RETURN(HTTP_RESPONSE, result);
 }
 
+/***********************************************************************************************************************************
+Range of keys listed by a list query
+***********************************************************************************************************************************/
+typedef struct StorageS3ListRange
+{
+    HttpQuery *query;                                               // Query for the range
+    HttpRequest *request;                                           // Async request for the next page (NULL if not sent)
+    const String *end;                                              // Last key in the range (NULL for no limit)
+} StorageS3ListRange;
+
+/***********************************************************************************************************************************
+Get a page for a list range and return true if there are more pages. Keys after the end of the range are skipped and no more pages
+are requested once the end has been passed.
+
+When first/last are not NULL they are set to the first and last keys on the page so the rest of the list can be split into ranges.
+In that case the next page is not requested.
+***********************************************************************************************************************************/
+static bool
+storageS3ListPage(
+    StorageS3 *const this, StorageS3ListRange *const range, const String *const basePrefix, const StorageInfoLevel level,
+    StorageListCallback callback, void *const callbackData, String **const first, String **const last)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM_P(VOID, range);
+        FUNCTION_LOG_PARAM(STRING, basePrefix);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+        FUNCTION_LOG_PARAM_P(STRING, first);
+        FUNCTION_LOG_PARAM_P(STRING, last);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(this != NULL);
+    ASSERT(range != NULL);
+    ASSERT(range->query != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT((first == NULL && last == NULL) || (first != NULL && last != NULL));
+
+    bool result = false;
+
+    // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to free
+    // memory at regular intervals
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        HttpResponse *response = NULL;
+
+        // If there is an outstanding async request then wait for the response
+        if (range->request != NULL)
+        {
+            response = storageS3ResponseP(range->request);
+
+            httpRequestFree(range->request);
+            range->request = NULL;
+        }
+        // Else get the response immediately from a sync request
+        else
+            response = storageS3RequestP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = range->query);
+
+        const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+        const XmlNodeList *const subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
+        const XmlNodeList *const fileList = xmlNodeChildList(xmlRoot, S3_XML_TAG_CONTENTS_STR);
+
+        // Prefixes and keys are each sorted so the range is complete if the last prefix or key is past the end of the range
+        const String *const subPathLast =
+            xmlNodeLstSize(subPathList) == 0 ? NULL : xmlNodeContent(
+                xmlNodeChild(xmlNodeLstGet(subPathList, xmlNodeLstSize(subPathList) - 1), S3_XML_TAG_PREFIX_STR, true));
+        const String *const fileLast =
+            xmlNodeLstSize(fileList) == 0 ? NULL : xmlNodeContent(
+                xmlNodeChild(xmlNodeLstGet(fileList, xmlNodeLstSize(fileList) - 1), S3_XML_TAG_KEY_STR, true));
+        const String *const pageLast = subPathLast == NULL || (fileLast != NULL && strCmp(fileLast, subPathLast) > 0) ?
+            fileLast : subPathLast;
+
+        result =
+            strEq(xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_IS_TRUNCATED_STR, true)), TRUE_STR) &&
+            (range->end == NULL || pageLast == NULL || strCmp(pageLast, range->end) <= 0);
+
+        // If list is truncated then get the continuation token
+        if (result)
+        {
+            const String *const nextContinuationToken = xmlNodeContent(
+                xmlNodeChild(xmlRoot, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR, true));
+            CHECK(FormatError, !strEmpty(nextContinuationToken), S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
+
+            // Return the first and last keys so the rest of the list can be split
+            if (first != NULL)
+            {
+                CHECK(FormatError, pageLast != NULL, "truncated list page may not be empty");
+
+                const String *const subPathFirst =
+                    xmlNodeLstSize(subPathList) == 0 ?
+                        NULL : xmlNodeContent(xmlNodeChild(xmlNodeLstGet(subPathList, 0), S3_XML_TAG_PREFIX_STR, true));
+                const String *const fileFirst =
+                    xmlNodeLstSize(fileList) == 0 ?
+                        NULL : xmlNodeContent(xmlNodeChild(xmlNodeLstGet(fileList, 0), S3_XML_TAG_KEY_STR, true));
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    *first = strDup(
+                        subPathFirst == NULL || (fileFirst != NULL && strCmp(fileFirst, subPathFirst) < 0) ?
+                            fileFirst : subPathFirst);
+                    *last = strDup(pageLast);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+            // Else send an async request to get more data
+            else
+            {
+                httpQueryPut(range->query, S3_QUERY_CONTINUATION_TOKEN_STR, nextContinuationToken);
+
+                // Store request in the calling context
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    range->request = storageS3RequestAsyncP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = range->query);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+        }
+
+        // Get prefix list
+        for (unsigned int subPathIdx = 0; subPathIdx < xmlNodeLstSize(subPathList); subPathIdx++)
+        {
+            const XmlNode *const subPathNode = xmlNodeLstGet(subPathList, subPathIdx);
+
+            // Get path name
+            StorageInfo info =
+            {
+                .level = level,
+                .name = xmlNodeContent(xmlNodeChild(subPathNode, S3_XML_TAG_PREFIX_STR, true)),
+                .exists = true,
+            };
+
+            // Skip paths after the end of the range
+            if (range->end != NULL && strCmp(info.name, range->end) > 0)
+                break;
+
+            // Strip off base prefix and final /
+            info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
+
+            // Add type info if requested
+            if (level >= storageInfoLevelType)
+                info.type = storageTypePath;
+
+            // Callback with info
+            callback(callbackData, &info);
+        }
+
+        // Get file list
+        for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
+        {
+            const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
+
+            // Get file name
+            StorageInfo info =
+            {
+                .level = level,
+                .name = xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_KEY_STR, true)),
+                .exists = true,
+            };
+
+            // Skip files after the end of the range
+            if (range->end != NULL && strCmp(info.name, range->end) > 0)
+                break;
+
+            // Strip off the base prefix when present
+            if (!strEmpty(basePrefix))
+                info.name = strSub(info.name, strSize(basePrefix));
+
+            // Add basic info if requested (no need to add type info since file is default type)
+            if (level >= storageInfoLevelBasic)
+            {
+                info.size = cvtZToUInt64(strZ(xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_SIZE_STR, true))));
+                info.timeModified = storageS3CvtTime(xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+            }
+
+            // Callback with info
+            callback(callbackData, &info);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 General function for listing files to be used by other list routines
 ***********************************************************************************************************************************/
+// Characters used to split a list into key ranges. Most keys in the repo are named with hex digits (WAL segments, archive paths,
+// relation files, and backup labels) so splitting on these characters spreads most lists evenly. Other keys are still listed since
+// the ranges together cover every key after the first page.
+#define STORAGE_S3_LIST_SPLIT                                       "0123456789ABCDEF"
+
 static void
 storageS3ListInternal(
     StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
@@ -687,108 +881,68 @@ storageS3ListInternal(
         if (!strEmpty(queryPrefix))
             httpQueryAdd(query, S3_QUERY_PREFIX_STR, queryPrefix);
 
-        // Loop as long as a continuation token returned
-        HttpRequest *request = NULL;
+        // When concurrent requests are allowed, the rest of a list that does not fit on the first page is split into key ranges
+        // that are listed concurrently. Splitting by key range works for both single level and recursive lists, so a single large
+        // path (e.g. an archive path with thousands of WAL paths) is listed concurrently as well as a large tree.
+        StorageS3ListRange range = {.query = query};
+        String *first = NULL;
+        String *last = NULL;
 
-        do
+        if (this->requestMax == 1)
         {
-            // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to
-            // free memory at regular intervals
-            MEM_CONTEXT_TEMP_BEGIN()
-            {
-                HttpResponse *response = NULL;
-
-                // If there is an outstanding async request then wait for the response
-                if (request != NULL)
-                {
-                    response = storageS3ResponseP(request);
-
-                    httpRequestFree(request);
-                    request = NULL;
-                }
-                // Else get the response immediately from a sync request
-                else
-                    response = storageS3RequestP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
+            while (storageS3ListPage(this, &range, basePrefix, level, callback, callbackData, NULL, NULL));
+        }
+        else if (storageS3ListPage(this, &range, basePrefix, level, callback, callbackData, &first, &last))
+        {
+            // Split at the first character that varies on the first page since the keys that follow are likely to vary there too.
+            // Each split is the last key of a range and the first range starts after the last key on the first page.
+            size_t splitIdx = 0;
 
-                const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+            while (splitIdx < strSize(first) && splitIdx < strSize(last) && strZ(first)[splitIdx] == strZ(last)[splitIdx])
+                splitIdx++;
 
-                // If list is truncated then send an async request to get more data
-                if (strEq(xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_IS_TRUNCATED_STR, true)), TRUE_STR))
-                {
-                    const String *const nextContinuationToken = xmlNodeContent(
-                        xmlNodeChild(xmlRoot, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR, true));
-                    CHECK(FormatError, !strEmpty(nextContinuationToken), S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
+            StringList *const endList = strLstNew();
 
-                    httpQueryPut(query, S3_QUERY_CONTINUATION_TOKEN_STR, nextContinuationToken);
+            for (const char *split = STORAGE_S3_LIST_SPLIT; *split != '\0'; split++)
+            {
+                String *const end = strCatChr(strCatN(strNew(), last, splitIdx), *split);
 
-                    // Store request in the outer temp context
-                    MEM_CONTEXT_PRIOR_BEGIN()
-                    {
-                        request = storageS3RequestAsyncP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
-                    }
-                    MEM_CONTEXT_PRIOR_END();
-                }
+                if (strCmp(end, last) > 0)
+                    strLstAdd(endList, end);
+            }
 
-                // Get prefix list
-                const XmlNodeList *const subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
+            // List ranges in order while keeping first page requests in flight for the ranges that follow
+            List *const rangeList = lstNewP(sizeof(StorageS3ListRange));
+            unsigned int rangeIdx = 0;
 
-                for (unsigned int subPathIdx = 0; subPathIdx < xmlNodeLstSize(subPathList); subPathIdx++)
+            while (rangeIdx <= strLstSize(endList) || !lstEmpty(rangeList))
+            {
+                // Send first page requests until the max requests are in flight
+                while (rangeIdx <= strLstSize(endList) && lstSize(rangeList) < this->requestMax)
                 {
-                    const XmlNode *const subPathNode = xmlNodeLstGet(subPathList, subPathIdx);
-
-                    // Get path name
-                    StorageInfo info =
+                    StorageS3ListRange rangeNext =
                     {
-                        .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(subPathNode, S3_XML_TAG_PREFIX_STR, true)),
-                        .exists = true,
+                        .query = httpQueryDupP(query),
+                        .end = rangeIdx == strLstSize(endList) ? NULL : strLstGet(endList, rangeIdx),
                     };
 
-                    // Strip off base prefix and final /
-                    info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
+                    httpQueryAdd(
+                        rangeNext.query, S3_QUERY_START_AFTER_STR, rangeIdx == 0 ? last : strLstGet(endList, rangeIdx - 1));
+                    rangeNext.request = storageS3RequestAsyncP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = rangeNext.query);
+                    lstAdd(rangeList, &rangeNext);
 
-                    // Add type info if requested
-                    if (level >= storageInfoLevelType)
-                        info.type = storageTypePath;
-
-                    // Callback with info
-                    callback(callbackData, &info);
+                    rangeIdx++;
                 }
 
-                // Get file list
-                const XmlNodeList *const fileList = xmlNodeChildList(xmlRoot, S3_XML_TAG_CONTENTS_STR);
-
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
-                {
-                    const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
-
-                    // Get file name
-                    StorageInfo info =
-                    {
-                        .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_KEY_STR, true)),
-                        .exists = true,
-                    };
+                // Get all pages for the oldest range
+                StorageS3ListRange *const rangeOldest = lstGet(rangeList, 0);
 
-                    // Strip off the base prefix when present
-                    if (!strEmpty(basePrefix))
-                        info.name = strSub(info.name, strSize(basePrefix));
-
-                    // Add basic info if requested (no need to add type info since file is default type)
-                    if (level >= storageInfoLevelBasic)
-                    {
-                        info.size = cvtZToUInt64(strZ(xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_SIZE_STR, true))));
-                        info.timeModified = storageS3CvtTime(
-                            xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
-                    }
+                while (storageS3ListPage(this, rangeOldest, basePrefix, level, callback, callbackData, NULL, NULL));
 
-                    // Callback with info
-                    callback(callbackData, &info);
-                }
+                httpQueryFree(rangeOldest->query);
+                lstRemoveIdx(rangeList, 0);
             }
-            MEM_CONTEXT_TEMP_END();
         }
-        while (request != NULL);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -915,7 +1069,7 @@ storageS3NewWrite(THIS_VOID, const String *const file, const StorageInterfaceNew
     ASSERT(param.group == NULL);
     ASSERT(param.timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteS3New(this, file, this->partSize));
+    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteS3New(this, file, this->partSize, this->partMax));
 }
 
 /**********************************************************************************************************************************/
@@ -924,66 +1078,88 @@ typedef struct StorageS3PathRemoveData
     StorageS3 *this;                                                // Storage object
     MemContext *memContext;                                         // Mem context to create xml document in
     unsigned int size;                                              // Size of delete request
-    HttpRequest *request;                                           // Async delete request
+    List *requestList;                                              // Async delete requests in progress (oldest first)
     XmlDocument *xml;                                               // Delete xml
     const String *path;                                             // Root path of remove
 } StorageS3PathRemoveData;
 
-static HttpRequest *
-storageS3PathRemoveInternal(StorageS3 *const this, HttpRequest *const request, XmlDocument *const xml)
+// Get the response for the oldest async delete request
+static void
+storageS3PathRemoveResponse(StorageS3PathRemoveData *const data)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(STORAGE_S3, this);
-        FUNCTION_TEST_PARAM(HTTP_REQUEST, request);
-        FUNCTION_TEST_PARAM(XML_DOCUMENT, xml);
+        FUNCTION_TEST_PARAM_P(VOID, data);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL);
+    ASSERT(data != NULL);
+    ASSERT(!lstEmpty(data->requestList));
 
-    // Get response for async request
-    if (request != NULL)
+    HttpRequest *const request = *(HttpRequest **)lstGet(data->requestList, 0);
+
+    MEM_CONTEXT_TEMP_BEGIN()
     {
-        MEM_CONTEXT_TEMP_BEGIN()
+        const Buffer *const response = httpResponseContent(storageS3ResponseP(request));
+
+        // Nothing is returned when there are no errors
+        if (!bufEmpty(response))
         {
-            const Buffer *const response = httpResponseContent(storageS3ResponseP(request));
+            const XmlNodeList *const errorList = xmlNodeChildList(
+                xmlDocumentRoot(xmlDocumentNewBuf(response)), S3_XML_TAG_ERROR_STR);
 
-            // Nothing is returned when there are no errors
-            if (!bufEmpty(response))
+            // Attempt to remove errored files one at a time rather than retrying the batch
+            for (unsigned int errorIdx = 0; errorIdx < xmlNodeLstSize(errorList); errorIdx++)
             {
-                const XmlNodeList *const errorList = xmlNodeChildList(
-                    xmlDocumentRoot(xmlDocumentNewBuf(response)), S3_XML_TAG_ERROR_STR);
-
-                // Attempt to remove errored files one at a time rather than retrying the batch
-                for (unsigned int errorIdx = 0; errorIdx < xmlNodeLstSize(errorList); errorIdx++)
-                {
-                    storageS3RequestP(
-                        this, HTTP_VERB_DELETE_STR,
-                        strNewFmt(
-                            "/%s",
-                            strZ(xmlNodeContent(xmlNodeChild(xmlNodeLstGet(errorList, errorIdx), S3_XML_TAG_KEY_STR, true)))));
-                }
+                storageS3RequestP(
+                    data->this, HTTP_VERB_DELETE_STR,
+                    strNewFmt(
+                        "/%s", strZ(xmlNodeContent(xmlNodeChild(xmlNodeLstGet(errorList, errorIdx), S3_XML_TAG_KEY_STR, true)))));
             }
         }
-        MEM_CONTEXT_TEMP_END();
-
-        httpRequestFree(request);
     }
+    MEM_CONTEXT_TEMP_END();
 
-    // Send new async request if there is more to remove
-    HttpRequest *result = NULL;
+    httpRequestFree(request);
+    lstRemoveIdx(data->requestList, 0);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Send an async delete request for the current delete xml. The request is added to the request list in the remove mem context.
+static void
+storageS3PathRemoveInternal(StorageS3PathRemoveData *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
 
-    if (xml != NULL)
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(data != NULL);
+    ASSERT(data->xml != NULL);
+
+    // Complete prior async requests until there is room for another
+    while (lstSize(data->requestList) >= data->this->requestMax)
+        storageS3PathRemoveResponse(data);
+
+    MEM_CONTEXT_BEGIN(data->memContext)
     {
         HttpQuery *const query = httpQueryAdd(httpQueryNewP(), S3_QUERY_DELETE_STR, EMPTY_STR);
-        Buffer *const content = xmlDocumentBuf(xml);
+        Buffer *const content = xmlDocumentBuf(data->xml);
 
-        result = storageS3RequestAsyncP(this, HTTP_VERB_POST_STR, FSLASH_STR, .query = query, .content = content);
+        HttpRequest *const request = storageS3RequestAsyncP(
+            data->this, HTTP_VERB_POST_STR, FSLASH_STR, .query = query, .content = content);
+        lstAdd(data->requestList, &request);
 
         httpQueryFree(query);
         bufFree(content);
     }
+    MEM_CONTEXT_END();
+
+    xmlDocumentFree(data->xml);
+    data->xml = NULL;
+    data->size = 0;
 
-    FUNCTION_TEST_RETURN(HTTP_REQUEST, result);
+    FUNCTION_TEST_RETURN_VOID();
 }
 
 static void
@@ -1026,17 +1202,7 @@ storageS3PathRemoveCallback(void *const callbackData, const StorageInfo *const i
 
         // Delete list when it is full
         if (data->size == data->this->deleteMax)
-        {
-            MEM_CONTEXT_BEGIN(data->memContext)
-            {
-                data->request = storageS3PathRemoveInternal(data->this, data->request, data->xml);
-            }
-            MEM_CONTEXT_END();
-
-            xmlDocumentFree(data->xml);
-            data->xml = NULL;
-            data->size = 0;
-        }
+            storageS3PathRemoveInternal(data);
     }
 
     FUNCTION_TEST_RETURN_VOID();
@@ -1063,6 +1229,7 @@ storageS3PathRemove(THIS_VOID, const String *const path, const bool recurse, con
         {
             .this = this,
             .memContext = memContextCurrent(),
+            .requestList = lstNewP(sizeof(HttpRequest *)),
             .path = strEq(path, FSLASH_STR) ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1))),
         };
 
@@ -1070,10 +1237,11 @@ storageS3PathRemove(THIS_VOID, const String *const path, const bool recurse, con
 
         // Call if there is more to be removed
         if (data.xml != NULL)
-            data.request = storageS3PathRemoveInternal(this, data.request, data.xml);
+            storageS3PathRemoveInternal(&data);
 
-        // Check response on last async request
-        storageS3PathRemoveInternal(this, data.request, NULL);
+        // Check responses on remaining async requests
+        while (!lstEmpty(data.requestList))
+            storageS3PathRemoveResponse(&data);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -1118,8 +1286,8 @@ storageS3New(
     const String *const endPoint, const StorageS3UriStyle uriStyle, const String *const region, const StorageS3KeyType keyType,
     const String *const accessKey, const String *const secretAccessKey, const String *const securityToken,
     const String *const kmsKeyId, const String *sseCustomerKey, const String *const credRole, const String *const webIdToken,
-    const size_t partSize, const KeyValue *const tag, const String *host, const unsigned int port, const TimeMSec timeout,
-    const bool verifyPeer, const String *const caFile, const String *const caPath)
+    const size_t partSize, const unsigned int partMax, const unsigned int requestMax, const KeyValue *const tag, const String *host,
+    const unsigned int port, const TimeMSec timeout, const bool verifyPeer, const String *const caFile, const String *const caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -1138,6 +1306,8 @@ storageS3New(
         FUNCTION_TEST_PARAM(STRING, credRole);
         FUNCTION_TEST_PARAM(STRING, webIdToken);
         FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(UINT, partMax);
+        FUNCTION_LOG_PARAM(UINT, requestMax);
         FUNCTION_LOG_PARAM(KEY_VALUE, tag);
         FUNCTION_LOG_PARAM(STRING, host);
         FUNCTION_LOG_PARAM(UINT, port);
@@ -1152,6 +1322,8 @@ storageS3New(
     ASSERT(endPoint != NULL);
     ASSERT(region != NULL);
     ASSERT(partSize != 0);
+    ASSERT(partMax != 0);
+    ASSERT(requestMax != 0);
 
     OBJ_NEW_BEGIN(StorageS3, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -1164,7 +1336,9 @@ storageS3New(
             .kmsKeyId = strDup(kmsKeyId),
             .sseCustomerKey = strDup(sseCustomerKey),
             .partSize = partSize,
+            .partMax = partMax,
             .deleteMax = STORAGE_S3_DELETE_MAX,
+            .requestMax = requestMax,
             .uriStyle = uriStyle,
             .bucketEndpoint =
                 uriStyle == storageS3UriStyleHost ? strNewFmt("%s.%s", strZ(bucket), strZ(endPoint)) : strDup(endPoint),
@@ -34,8 +34,9 @@ typedef struct StorageWriteS3
     StorageWriteInterface interface;                                // Interface
     StorageS3 *storage;                                             // Storage that created this object
 
-    HttpRequest *request;                                           // Async request
+    List *requestList;                                              // Async requests in progress (oldest first)
     size_t partSize;
+    unsigned int partMax;                                           // Maximum async requests in progress
     Buffer *partBuffer;
     const String *uploadId;
     StringList *uploadPartList;
@@ -64,10 +65,11 @@ storageWriteS3Open(THIS_VOID)
     ASSERT(this != NULL);
     ASSERT(this->partBuffer == NULL);
 
-    // Allocate the part buffer
+    // Allocate the part buffer and async request list
     MEM_CONTEXT_OBJ_BEGIN(this)
     {
         this->partBuffer = bufNew(this->partSize);
+        this->requestList = lstNewP(sizeof(HttpRequest *));
     }
     MEM_CONTEXT_OBJ_END();
 
@@ -86,18 +88,19 @@ storageWriteS3Part(StorageWriteS3 *const this)
 
     ASSERT(this != NULL);
 
-    // If there is an outstanding async request then wait for the response and store the part id
-    if (this->request != NULL)
-    {
-        HttpResponse *const response = storageS3ResponseP(this->request);
+    ASSERT(!lstEmpty(this->requestList));
 
-        strLstAdd(this->uploadPartList, httpHeaderGet(httpResponseHeader(response), HTTP_HEADER_ETAG_STR));
-        ASSERT(strLstGet(this->uploadPartList, strLstSize(this->uploadPartList) - 1) != NULL);
+    // Wait for the response to the oldest async request and store the part id. Requests are completed in the order they were sent
+    // so the part ids are stored in part number order.
+    HttpRequest *const request = *(HttpRequest **)lstGet(this->requestList, 0);
+    HttpResponse *const response = storageS3ResponseP(request);
 
-        httpResponseFree(response);
-        httpRequestFree(this->request);
-        this->request = NULL;
-    }
+    strLstAdd(this->uploadPartList, httpHeaderGet(httpResponseHeader(response), HTTP_HEADER_ETAG_STR));
+    ASSERT(strLstGet(this->uploadPartList, strLstSize(this->uploadPartList) - 1) != NULL);
+
+    httpResponseFree(response);
+    httpRequestFree(request);
+    lstRemoveIdx(this->requestList, 0);
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -115,8 +118,9 @@ storageWriteS3PartAsync(StorageWriteS3 *const this)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Complete prior async request, if any
-        storageWriteS3Part(this);
+        // Complete prior async requests until there is room for another
+        while (lstSize(this->requestList) >= this->partMax)
+            storageWriteS3Part(this);
 
         // Get the upload id if we have not already
         if (this->uploadId == NULL)
@@ -142,12 +146,16 @@ storageWriteS3PartAsync(StorageWriteS3 *const this)
         // Upload the part async
         HttpQuery *const query = httpQueryNewP();
         httpQueryAdd(query, S3_QUERY_UPLOAD_ID_STR, this->uploadId);
-        httpQueryAdd(query, S3_QUERY_PART_NUMBER_STR, strNewFmt("%u", strLstSize(this->uploadPartList) + 1));
+        httpQueryAdd(
+            query, S3_QUERY_PART_NUMBER_STR,
+            strNewFmt("%u", strLstSize(this->uploadPartList) + lstSize(this->requestList) + 1));
 
         MEM_CONTEXT_OBJ_BEGIN(this)
         {
-            this->request = storageS3RequestAsyncP(
+            HttpRequest *const request = storageS3RequestAsyncP(
                 this->storage, HTTP_VERB_PUT_STR, this->interface.name, .query = query, .content = this->partBuffer, .sseC = true);
+
+            lstAdd(this->requestList, &request);
         }
         MEM_CONTEXT_OBJ_END();
     }
@@ -224,8 +232,9 @@ storageWriteS3Close(THIS_VOID)
                 if (!bufEmpty(this->partBuffer))
                     storageWriteS3PartAsync(this);
 
-                // Complete prior async request, if any
-                storageWriteS3Part(this);
+                // Complete prior async requests
+                while (!lstEmpty(this->requestList))
+                    storageWriteS3Part(this);
 
                 // Generate the xml part list
                 XmlDocument *const partList = xmlDocumentNew(S3_XML_TAG_COMPLETE_MULTIPART_UPLOAD_STR);
@@ -261,6 +270,8 @@ storageWriteS3Close(THIS_VOID)
 
             bufFree(this->partBuffer);
             this->partBuffer = NULL;
+            lstFree(this->requestList);
+            this->requestList = NULL;
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -270,15 +281,18 @@ storageWriteS3Close(THIS_VOID)
 
 /**********************************************************************************************************************************/
 FN_EXTERN StorageWrite *
-storageWriteS3New(StorageS3 *const storage, const String *const name, const size_t partSize)
+storageWriteS3New(StorageS3 *const storage, const String *const name, const size_t partSize, const unsigned int partMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_S3, storage);
         FUNCTION_LOG_PARAM(STRING, name);
+        FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(UINT, partMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
+    ASSERT(partMax != 0);
 
     OBJ_NEW_BEGIN(StorageWriteS3, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -286,6 +300,7 @@ storageWriteS3New(StorageS3 *const storage, const String *const name, const size
         {
             .storage = storage,
             .partSize = partSize,
+            .partMax = partMax,
 
             .interface = (StorageWriteInterface)
             {
@@ -124,7 +124,7 @@ storageCopy(StorageRead *const source, StorageWrite *const destination)
             ioWriteOpen(storageWriteIo(destination));
 
             // Copy data from source to destination
-            ioCopyP(storageReadIo(source), storageWriteIo(destination));
+            storageReadCopyP(source, storageWriteIo(destination));
 
             // Close the source and destination files
             ioReadClose(storageReadIo(source));
@@ -94,11 +94,14 @@ hrnBackupScriptSet(const HrnBackupScript *const script, const unsigned int scrip
 
 /**********************************************************************************************************************************/
 static void
-backupProcess(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
+backupProcess(
+    const BackupData *const backupData, Manifest *const manifest, const CipherType cipherTypeBackup,
+    const String *const cipherPassBackup)
 {
     FUNCTION_HARNESS_BEGIN();
         FUNCTION_HARNESS_PARAM(BACKUP_DATA, backupData);
         FUNCTION_HARNESS_PARAM(MANIFEST, manifest);
+        FUNCTION_HARNESS_PARAM(STRING_ID, cipherTypeBackup);
         FUNCTION_HARNESS_PARAM(STRING, cipherPassBackup);
     FUNCTION_HARNESS_END();
 
@@ -141,7 +144,7 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         hrnBackupLocal.scriptSize = 0;
     }
 
-    backupProcess_SHIMMED(backupData, manifest, cipherPassBackup);
+    backupProcess_SHIMMED(backupData, manifest, cipherTypeBackup, cipherPassBackup);
 
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -36,6 +36,7 @@ typedef enum
     hrnServerCmdDone,
     hrnServerCmdExpect,
     hrnServerCmdReply,
+    hrnServerCmdSession,
     hrnServerCmdSleep,
 } HrnServerCmd;
 
@@ -221,6 +222,21 @@ hrnServerScriptReplyZ(IoWrite *write, const char *data)
     FUNCTION_HARNESS_RETURN_VOID();
 }
 
+void
+hrnServerScriptSession(IoWrite *write, unsigned int sessionIdx)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_WRITE, write);
+        FUNCTION_HARNESS_PARAM(UINT, sessionIdx);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(sessionIdx < HRN_SERVER_SESSION_MAX);
+
+    hrnServerScriptCommand(write, hrnServerCmdSession, VARUINT(sessionIdx));
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 void
 hrnServerScriptSleep(IoWrite *write, TimeMSec sleepMs)
 {
@@ -271,7 +287,8 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
     IoServer *socketServer = sckServerNew(STRDEF("127.0.0.1"), port, 5000);
 
     // Loop until no more commands
-    IoSession *serverSession = NULL;
+    IoSession *serverSessionList[HRN_SERVER_SESSION_MAX] = {NULL};
+    unsigned int sessionIdx = 0;
     bool done = false;
 
     do
@@ -286,31 +303,31 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
                 // Only makes since to abort in TLS, otherwise it is just a close
                 ASSERT(protocol == hrnServerProtocolTls);
 
-                ioSessionFree(serverSession);
-                serverSession = NULL;
+                ioSessionFree(serverSessionList[sessionIdx]);
+                serverSessionList[sessionIdx] = NULL;
 
                 break;
             }
 
             case hrnServerCmdAccept:
             {
-                serverSession = ioServerAccept(socketServer, NULL);
+                serverSessionList[sessionIdx] = ioServerAccept(socketServer, NULL);
 
                 // Start TLS if requested
                 if (protocol == hrnServerProtocolTls)
-                    serverSession = ioServerAccept(tlsServer, serverSession);
+                    serverSessionList[sessionIdx] = ioServerAccept(tlsServer, serverSessionList[sessionIdx]);
 
                 break;
             }
 
             case hrnServerCmdClose:
             {
-                if (serverSession == NULL)
+                if (serverSessionList[sessionIdx] == NULL)
                     THROW(AssertError, "session is already closed");
 
-                ioSessionClose(serverSession);
-                ioSessionFree(serverSession);
-                serverSession = NULL;
+                ioSessionClose(serverSessionList[sessionIdx]);
+                ioSessionFree(serverSessionList[sessionIdx]);
+                serverSessionList[sessionIdx] = NULL;
 
                 break;
             }
@@ -328,7 +345,7 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
 
                 TRY_BEGIN()
                 {
-                    ioRead(ioSessionIoReadP(serverSession), buffer);
+                    ioRead(ioSessionIoReadP(serverSessionList[sessionIdx]), buffer);
                 }
                 CATCH(FileReadError)
                 {
@@ -355,8 +372,12 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
             }
 
             case hrnServerCmdReply:
-                ioWrite(ioSessionIoWrite(serverSession), BUFSTR(varStr(data)));
-                ioWriteFlush(ioSessionIoWrite(serverSession));
+                ioWrite(ioSessionIoWrite(serverSessionList[sessionIdx]), BUFSTR(varStr(data)));
+                ioWriteFlush(ioSessionIoWrite(serverSessionList[sessionIdx]));
+                break;
+
+            case hrnServerCmdSession:
+                sessionIdx = varUIntForce(data);
                 break;
 
             case hrnServerCmdSleep:
@@ -28,6 +28,9 @@ Port constants
 // Maximum number of ports allowed for each test
 #define HRN_SERVER_PORT_MAX                                         768
 
+// Maximum number of sessions that can be open at the same time
+#define HRN_SERVER_SESSION_MAX                                      4
+
 // Bogus port to be used where the port does not matter or must fail
 #define HRN_SERVER_PORT_BOGUS                                       34342
 
@@ -85,6 +88,10 @@ void hrnServerScriptExpectZ(IoWrite *write, const char *data);
 void hrnServerScriptReply(IoWrite *write, const String *data);
 void hrnServerScriptReplyZ(IoWrite *write, const char *data);
 
+// Select the session that subsequent commands will operate on. This allows scripting multiple connections that are open at the same
+// time, e.g. concurrent requests. Session 0 is selected by default.
+void hrnServerScriptSession(IoWrite *write, unsigned int sessionIdx);
+
 // Sleep specified milliseconds
 void hrnServerScriptSleep(IoWrite *write, TimeMSec sleepMs);
 
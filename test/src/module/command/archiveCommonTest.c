@@ -374,6 +374,127 @@ testRun(void)
             " 123456781234567912345679-dddddddddddddddddddddddddddddddddddddddd.zst"
             ", 123456781234567912345679-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee.gz\n"
             "HINT: are multiple primaries archiving to this stanza?");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle index save, load, and cover");
+
+        List *bundleFileList = lstNewP(sizeof(WalBundleFile));
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("123456781234568000000001-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"),
+                .bundle = STRDEF("123456781234568000000001-123456781234568000000003.bundle"), .size = 4});
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("123456781234568000000003-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz"),
+                .bundle = STRDEF("123456781234568000000001-123456781234568000000003.bundle"), .offset = 4, .size = 3});
+
+        TEST_RESULT_VOID(
+            walBundleIndexSave(storageTest, STRDEF("archive/db/9.6-2/1234567812345680"), bundleFileList), "save index");
+        HRN_STORAGE_PUT_Z(
+            storageTest, "archive/db/9.6-2/1234567812345680/123456781234568000000001-123456781234568000000003.bundle", "AAAABBB");
+
+        TEST_ASSIGN(
+            bundleFileList,
+            walBundleIndexLoad(
+                storageTest, STRDEF("archive/db/9.6-2/1234567812345680"),
+                STRDEF("123456781234568000000001-123456781234568000000003.index")),
+            "load index");
+        TEST_RESULT_UINT(lstSize(bundleFileList), 2, "file total");
+
+        const WalBundleFile *bundleFile = lstGet(bundleFileList, 1);
+        TEST_RESULT_STR_Z(bundleFile->name, "123456781234568000000003-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz", "name");
+        TEST_RESULT_STR_Z(bundleFile->bundle, "123456781234568000000001-123456781234568000000003.bundle", "bundle");
+        TEST_RESULT_UINT(bundleFile->offset, 4, "offset");
+        TEST_RESULT_UINT(bundleFile->size, 3, "size");
+
+        const String *const index = STRDEF("123456781234568000000001-123456781234568000000003.index");
+
+        TEST_RESULT_BOOL(walBundleIndexCover(index, STRDEF("123456781234568000000000")), false, "before index");
+        TEST_RESULT_BOOL(walBundleIndexCover(index, STRDEF("123456781234568000000002")), true, "in index");
+        TEST_RESULT_BOOL(walBundleIndexCover(index, STRDEF("123456781234568000000004")), false, "after index");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("split bundle indexes from file list");
+
+        StringList *fileList = strLstNew();
+        strLstAddZ(fileList, "123456781234568000000001-123456781234568000000003.bundle");
+        strLstAddZ(fileList, "123456781234568000000001-123456781234568000000003.index");
+        strLstAddZ(fileList, "bogus.index");
+
+        TEST_RESULT_STRLST_Z(
+            walBundleIndexListSplit(fileList), "123456781234568000000001-123456781234568000000003.index\n", "index list");
+        TEST_RESULT_STRLST_Z(fileList, "123456781234568000000001-123456781234568000000003.bundle\nbogus.index\n", "file list");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("find single segment in bundle");
+
+        TEST_RESULT_STR_Z(
+            walSegmentFindOne(storageRepo(), STRDEF("9.6-2"), STRDEF("123456781234568000000003"), 0),
+            "123456781234568000000003-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz", "find in bundle");
+        TEST_RESULT_STR(
+            walSegmentFindOne(storageRepo(), STRDEF("9.6-2"), STRDEF("123456781234568000000002"), 0), NULL,
+            "covered by index but not in bundle");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("find more than one segment in bundles with caching");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageTest, "archive/db/9.6-2/1234567812345680/123456781234568000000002-cccccccccccccccccccccccccccccccccccccccc");
+        HRN_STORAGE_PUT_EMPTY(
+            storageTest, "archive/db/9.6-2/1234567812345680/123456781234568000000005-123456781234568000000006.index");
+
+        TEST_ASSIGN(find, walSegmentFindNew(storageRepo(), STRDEF("9.6-2"), false, 500), "new find");
+
+        TEST_RESULT_STR_Z(
+            walSegmentFind(find, STRDEF("123456781234568000000001")),
+            "123456781234568000000001-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz", "find in bundle");
+        TEST_ASSIGN(bundleFile, walSegmentFindBundle(find), "get bundle");
+        TEST_RESULT_STR_Z(bundleFile->bundle, "123456781234568000000001-123456781234568000000003.bundle", "bundle");
+        TEST_RESULT_UINT(bundleFile->offset, 0, "offset");
+        TEST_RESULT_UINT(bundleFile->size, 4, "size");
+
+        TEST_RESULT_STR_Z(
+            walSegmentFind(find, STRDEF("123456781234568000000002")),
+            "123456781234568000000002-cccccccccccccccccccccccccccccccccccccccc", "find individual");
+        TEST_RESULT_PTR(walSegmentFindBundle(find), NULL, "not in bundle");
+        TEST_RESULT_STRLST_Z(find->list, NULL, "list is empty but not cleared");
+        TEST_RESULT_STRLST_Z(
+            find->indexList,
+            "123456781234568000000001-123456781234568000000003.index\n123456781234568000000005-123456781234568000000006.index\n",
+            "index list");
+
+        TEST_RESULT_STR_Z(
+            walSegmentFind(find, STRDEF("123456781234568000000003")),
+            "123456781234568000000003-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz", "find in cached bundle");
+        TEST_RESULT_UINT(walSegmentFindBundle(find)->offset, 4, "offset");
+        TEST_RESULT_UINT(lstSize(find->bundleCache), 1, "one index loaded");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("segment not found without timeout does not reload the list");
+
+        TEST_ASSIGN(find, walSegmentFindNew(storageRepo(), STRDEF("9.6-2"), false, 0), "new find");
+
+        TEST_RESULT_STR(walSegmentFind(find, STRDEF("123456781234568000000004")), NULL, "not found");
+        TEST_RESULT_STRLST_Z(find->list, NULL, "list is empty but not cleared");
+        TEST_RESULT_STRLST_Z(
+            find->indexList, "123456781234568000000005-123456781234568000000006.index\n", "index ending before segment removed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("duplicate in bundle");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageTest, "archive/db/9.6-2/1234567812345680/123456781234568000000003-dddddddddddddddddddddddddddddddddddddddd");
+
+        TEST_ERROR(
+            walSegmentFindOne(storageRepo(), STRDEF("9.6-2"), STRDEF("123456781234568000000003"), 0),
+            ArchiveDuplicateError,
+            "duplicates found in archive for WAL segment 123456781234568000000003:"
+            " 123456781234568000000003-dddddddddddddddddddddddddddddddddddddddd"
+            ", 123456781234568000000001-123456781234568000000003.bundle/"
+            "123456781234568000000003-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz\n"
+            "HINT: are multiple primaries archiving to this stanza?");
     }
 
     // *****************************************************************************************************************************
@@ -1,8 +1,11 @@
 /***********************************************************************************************************************************
 Test Archive Get Command
 ***********************************************************************************************************************************/
+#include "common/compress/helper.h"
+#include "common/io/bufferWrite.h"
 #include "common/io/fdRead.h"
 #include "common/io/fdWrite.h"
+#include "storage/posix/storage.h"
 
 #include "common/harnessConfig.h"
 #include "common/harnessFork.h"
@@ -11,6 +14,47 @@ Test Archive Get Command
 #include "common/harnessProtocol.h"
 #include "common/harnessStorage.h"
 
+/***********************************************************************************************************************************
+Write a list cache with a listing of the 0000000100000001 path
+***********************************************************************************************************************************/
+static void
+testListCachePut(
+    const unsigned int version, const unsigned int repoKey, const char *const archiveId, const time_t timeList,
+    const char *const file)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(UINT, version);
+        FUNCTION_HARNESS_PARAM(UINT, repoKey);
+        FUNCTION_HARNESS_PARAM(STRINGZ, archiveId);
+        FUNCTION_HARNESS_PARAM(TIME, timeList);
+        FUNCTION_HARNESS_PARAM(STRINGZ, file);
+    FUNCTION_HARNESS_END();
+
+    Buffer *const buffer = bufNew(0);
+    IoWrite *const write = ioBufferWriteNewOpen(buffer);
+    PackWrite *const pack = pckWriteNewIo(write);
+    StringList *const fileList = strLstNew();
+
+    strLstAddZ(fileList, file);
+
+    pckWriteU32P(pack, version);
+    pckWriteU32P(pack, 1);
+    pckWriteObjBeginP(pack);
+    pckWriteU32P(pack, repoKey);
+    pckWriteStrP(pack, STR(archiveId));
+    pckWriteStrP(pack, STRDEF("0000000100000001"));
+    pckWriteTimeP(pack, timeList);
+    pckWriteStrLstP(pack, fileList);
+    pckWriteStrLstP(pack, strLstNew());
+    pckWriteObjEndP(pack);
+    pckWriteEndP(pack);
+    ioWriteClose(write);
+
+    HRN_STORAGE_PUT(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/list.cache", buffer);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -19,6 +63,9 @@ testRun(void)
 {
     FUNCTION_HARNESS_VOID();
 
+    // Storage for the lock path where async processes listen for notifications
+    const Storage *const storageHrn = storagePosixNewP(HRN_PATH_STR);
+
     // *****************************************************************************************************************************
     if (testBegin("queueNeed()"))
     {
@@ -246,6 +293,276 @@ testRun(void)
         TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
         TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("prefetch depth");
+
+        ArchiveGetAsyncPrefetch prefetch =
+        {
+            .walSegmentSize = 16 * 1024 * 1024, .pgVersion = PG_VERSION_10, .queueTotal = 64, .processMax = 2,
+        };
+
+        TEST_RESULT_UINT(archiveGetAsyncDepth(&prefetch), 64, "queue total when replay time is unknown");
+
+        TEST_RESULT_VOID(archiveGetAsyncReplay(&prefetch, STRDEF("000000010000000100000001"), 1000), "first replay");
+        TEST_RESULT_UINT(prefetch.replayTime, 0, "replay time unknown");
+
+        TEST_RESULT_VOID(archiveGetAsyncReplay(&prefetch, STRDEF("000000010000000100000004"), 4000), "replay three segments");
+        TEST_RESULT_UINT(prefetch.replayTime, 1000, "replay time");
+        TEST_RESULT_UINT(archiveGetAsyncDepth(&prefetch), 64, "queue total when fetch time is unknown");
+
+        prefetch.fetchTime = 2500;
+        TEST_RESULT_UINT(archiveGetAsyncDepth(&prefetch), 7, "depth covers replay during fetch plus processes");
+
+        TEST_RESULT_VOID(archiveGetAsyncReplay(&prefetch, STRDEF("000000010000000100000005"), 7000), "slower replay");
+        TEST_RESULT_UINT(prefetch.replayTime, 1500, "replay time estimate");
+        TEST_RESULT_UINT(archiveGetAsyncDepth(&prefetch), 6, "depth");
+
+        TEST_RESULT_VOID(archiveGetAsyncReplay(&prefetch, STRDEF("000000020000000100000005"), 8000), "timeline switch");
+        TEST_RESULT_UINT(prefetch.replayTime, 1500, "replay time unchanged");
+        TEST_RESULT_Z(prefetch.replayLast, "000000020000000100000005", "last replay");
+
+        prefetch.fetchTime = 1000000;
+        TEST_RESULT_UINT(archiveGetAsyncDepth(&prefetch), 64, "depth limited to queue total");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("linger and get WAL segments ahead of replay");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        StringList *argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveGetLinger, "1");
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveGetQueueMax, "32MiB");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp, .role = cfgCmdRoleAsync);
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                // Wait for the first WAL segment to be fetched, then move it out of the queue like the main process would
+                while (!storageExistsP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001")))
+                    sleepMSec(10);
+
+                HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001");
+
+                TEST_RESULT_VOID(archiveAsyncNotify(archiveModeGet, STRDEF("000000010000000100000001 found")), "notify");
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                // The async process holds the archive lock, which also creates the lock path where the socket is bound
+                lockInit(cfgOptionStr(cfgOptLockPath), STRDEF("999-dededede"));
+                cmdLockAcquireP(.returnOnNoLock = true);
+
+                TEST_RESULT_VOID(cmdArchiveGetAsync(), "get async");
+                TEST_RESULT_LOG(
+                    "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+                    "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive\n"
+                    "P00   INFO: get 2 WAL file(s) from archive: 000000010000000100000002...000000010000000100000003\n"
+                    "P01 DETAIL: found 000000010000000100000002 in the repo1: 10-1 archive\n"
+                    "P00 DETAIL: unable to find 000000010000000100000003 in the archive");
+
+                cmdLockReleaseP();
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000100000002\n000000010000000100000003.ok\n",
+            .remove = true);
+        TEST_RESULT_BOOL(
+            storageInfoP(storageHrn, STRDEF("lock/test2-archive-get.sock"), .ignoreMissing = true).exists, false, "socket removed");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("segments in a bundle");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        argList = strLstDup(argBaseList);
+        strLstAddZ(argList, "000000010000000100000001");
+        strLstAddZ(argList, "000000010000000100000002");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        List *bundleFileList = lstNewP(sizeof(WalBundleFile));
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("000000010000000100000001-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"),
+                .bundle = STRDEF("000000010000000100000001-000000010000000100000002.bundle"), .size = 4});
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("000000010000000100000002-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"),
+                .bundle = STRDEF("000000010000000100000001-000000010000000100000002.bundle"), .size = 3});
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-000000010000000100000002.bundle", "AAAABBB");
+        walBundleIndexSave(storageRepoWrite(), STRDEF(STORAGE_REPO_ARCHIVE "/10-1/0000000100000001"), bundleFileList);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000100000001...000000010000000100000002\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000100000002 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", "AAAA", .remove = true);
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000002", "BBB", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/0000000100000001", .recurse = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("listing in the list cache is used");
+
+        argListTemp = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveGetListCache, "60");
+        strLstAddZ(argListTemp, "000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp, .role = cfgCmdRoleAsync);
+
+        // Without the list cache this would be a duplicate
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-ffffffffffffffffffffffffffffffffffffffff",
+            "FFF");
+        testListCachePut(1, 1, "10-1", time(NULL), "000000010000000100000001-ffffffffffffffffffffffffffffffffffffffff");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", "FFF", .remove = true);
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-ffffffffffffffffffffffffffffffffffffffff");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expired, future, other version, other repo, and other archive id listings are not used");
+
+        testListCachePut(1, 1, "10-1", time(NULL) - 120, "000000010000000100000001-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+
+        testListCachePut(1, 1, "10-1", time(NULL) + 120, "000000010000000100000001-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+
+        testListCachePut(2, 1, "10-1", time(NULL), "000000010000000100000001-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+        testListCachePut(1, 2, "10-1", time(NULL), "000000010000000100000001-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+        testListCachePut(1, 1, "9.6-1", time(NULL), "000000010000000100000001-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("listing without the segment is listed again and saved");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+        testListCachePut(1, 1, "10-1", time(NULL), "000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        strLstAddZ(argListTemp, "000000010000000100000002");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000100000001...000000010000000100000002\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000100000002 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000002", .remove = true);
+
+        PackRead *listCache = pckReadNewIo(
+            ioBufferReadNewOpen(storageGetP(storageNewReadP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE "/list.cache")))));
+
+        TEST_RESULT_UINT(pckReadU32P(listCache), 1, "version");
+        TEST_RESULT_UINT(pckReadU32P(listCache), 1, "path total");
+        TEST_RESULT_VOID(pckReadObjBeginP(listCache), "path begin");
+        TEST_RESULT_UINT(pckReadU32P(listCache), 1, "repo key");
+        TEST_RESULT_STR_Z(pckReadStrP(listCache), "10-1", "archive id");
+        TEST_RESULT_STR_Z(pckReadStrP(listCache), "0000000100000001", "path");
+        TEST_RESULT_BOOL(pckReadTimeP(listCache) >= time(NULL) - 60, true, "list time");
+        TEST_RESULT_STRLST_Z(
+            pckReadStrLstP(listCache),
+            "000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n"
+            "000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd\n",
+            "file list");
+        TEST_RESULT_STRLST_Z(pckReadStrLstP(listCache), NULL, "index list");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000002-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("warn when list cache cannot be loaded");
+
+        HRN_STORAGE_MODE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/list.cache", .mode = 0200);
+
+        argListTemp = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveGetListCache, "60");
+        strLstAddZ(argListTemp, "000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000100000001\n"
+            "P00   WARN: unable to load list cache, all paths will be listed: unable to open file '" TEST_PATH
+            "/spool/archive/test2/list.cache' for read: [13] Permission denied\n"
+            "P01 DETAIL: found 000000010000000100000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/list.cache");
+
+        argList = strLstDup(argBaseList);
+        strLstAddZ(argList, "000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("single segment with one invalid file");
 
@@ -772,6 +1089,54 @@ testRun(void)
         }
         HRN_FORK_END();
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("with lock, notify lingering async process");
+
+        StringList *argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveGetLinger, "5");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp, .exeBogus = true);
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                lockInit(cfgOptionStr(cfgOptLockPath), STRDEF("999-dededede"));
+                cmdLockAcquireP(.returnOnNoLock = true);
+                ArchiveAsyncListen *const listen = archiveAsyncListenNew(archiveModeGet);
+
+                // Notify parent that lock has been acquired and the async process is listening
+                HRN_FORK_CHILD_NOTIFY_PUT();
+
+                TEST_RESULT_STR_Z(
+                    archiveAsyncListenWait(listen, 5000), "000000010000000100000001 missing", "notification received");
+
+                // Wait for parent to allow release lock
+                HRN_FORK_CHILD_NOTIFY_GET();
+
+                archiveAsyncListenFree(listen);
+                cmdLockReleaseP();
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                // Wait for child to acquire lock
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                TEST_ERROR(
+                    cmdArchiveGet(), ArchiveTimeoutError,
+                    "unable to get WAL file '000000010000000100000001' from the archive asynchronously after 1 second(s)\n"
+                    "HINT: check '" HRN_PATH "/test1-archive-get-async.log' for errors.");
+
+                // Notify child to release lock
+                HRN_FORK_PARENT_NOTIFY_PUT(0);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .exeBogus = true);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("too many parameters specified");
 
@@ -857,7 +1222,7 @@ testRun(void)
             "unexpected control version = 1501 and catalog version = 202211111\n"
             "HINT: is this version of PostgreSQL supported?");
 
-        StringList *argListTemp = strLstDup(argList);
+        argListTemp = strLstDup(argList);
         hrnCfgArgRawZ(argListTemp, cfgOptPgVersionForce, "10");
         HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
 
@@ -929,6 +1294,50 @@ testRun(void)
             storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-4/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
             .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get WAL segment from a bundle");
+
+        List *bundleFileList = lstNewP(sizeof(WalBundleFile));
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("01ABCDEF01ABCDEF01ABCDEE-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"),
+                .bundle = STRDEF("01ABCDEF01ABCDEF01ABCDEE-01ABCDEF01ABCDEF01ABCDEF.bundle"), .size = 4});
+        lstAdd(
+            bundleFileList,
+            &(WalBundleFile){
+                .name = STRDEF("01ABCDEF01ABCDEF01ABCDEF-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz"),
+                .bundle = STRDEF("01ABCDEF01ABCDEF01ABCDEE-01ABCDEF01ABCDEF01ABCDEF.bundle")});
+
+        Buffer *bundle = bufNew(0);
+        bufCat(bundle, BUFSTRDEF("JUNK"));
+
+        buffer = bufNew(16 * 1024 * 1024);
+        memset(bufPtr(buffer), 0xAA, bufSize(buffer));
+        bufUsedSet(buffer, bufSize(buffer));
+
+        Buffer *compressed = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(compressed);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), compressFilterP(compressTypeGz, 1));
+        ioWriteOpen(write);
+        ioWrite(write, buffer);
+        ioWriteClose(write);
+
+        bufCat(bundle, compressed);
+        ((WalBundleFile *)lstGet(bundleFileList, 1))->size = bufUsed(compressed);
+
+        HRN_STORAGE_PUT(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-4/01ABCDEF01ABCDEF01ABCDEE-01ABCDEF01ABCDEF01ABCDEF.bundle", bundle);
+        walBundleIndexSave(storageRepoWrite(), STRDEF(STORAGE_REPO_ARCHIVE "/10-4/01ABCDEF01ABCDEF"), bundleFileList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+
+        TEST_RESULT_LOG("P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo1: 10-4 archive");
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storagePg(), STRDEF("pg_wal/RECOVERYXLOG"))), buffer), true, "check WAL");
+        TEST_STORAGE_LIST(storagePgWrite(), "pg_wal", "RECOVERYXLOG\n", .remove = true);
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-4/01ABCDEF01ABCDEF", .recurse = true);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("get partial");
 
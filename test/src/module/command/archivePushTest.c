@@ -1,9 +1,12 @@
 /***********************************************************************************************************************************
 Test Archive Push Command
 ***********************************************************************************************************************************/
+#include "common/compress/helper.h"
+#include "common/crypto/cipherBlock.h"
 #include "common/io/fdRead.h"
 #include "common/io/fdWrite.h"
 #include "common/time.h"
+#include "postgres/interface/crc32.h"
 #include "postgres/version.h"
 #include "storage/posix/storage.h"
 
@@ -13,6 +16,144 @@ Test Archive Push Command
 #include "common/harnessPostgres.h"
 #include "common/harnessProtocol.h"
 
+/***********************************************************************************************************************************
+Build WAL segments with valid records for testing the record check filter. Pages after the last record written are left as they
+were in the buffer, which is zeroed for most tests.
+***********************************************************************************************************************************/
+#define TEST_WAL_PAGE_SIZE                                          1024
+#define TEST_WAL_PAGE_ADDR                                          0x1000000
+#define TEST_WAL_PAGE_MAGIC                                         0xD101
+
+typedef struct TestWal
+{
+    Buffer *buffer;                                                 // WAL segment
+    size_t offset;                                                  // Current write offset
+    size_t recordOffset;                                            // Offset of the last record written
+    uint32_t recordCrc;                                             // CRC-32C of the last record written
+} TestWal;
+
+// Initialize the long header on the first page, keeping the magic when one has already been written. When remainSize > 0 the first
+// page continues a record from the prior segment.
+static TestWal
+testWalNew(Buffer *const buffer, const uint32_t remainSize)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, buffer);
+        FUNCTION_HARNESS_PARAM(UINT, remainSize);
+    FUNCTION_HARNESS_END();
+
+    WalLongPageHeader *const header = (WalLongPageHeader *)bufPtr(buffer);
+
+    if (header->std.magic == 0)
+        header->std.magic = TEST_WAL_PAGE_MAGIC;
+
+    header->std.info = WAL_PAGE_LONG_HEADER | (remainSize > 0 ? WAL_PAGE_FIRST_IS_CONTRECORD : 0);
+    header->std.pageAddr = TEST_WAL_PAGE_ADDR;
+    header->std.remainSize = remainSize;
+    header->pageSize = TEST_WAL_PAGE_SIZE;
+
+    FUNCTION_HARNESS_RETURN(STRUCT, (TestWal){.buffer = buffer, .offset = WAL_LONG_PAGE_HEADER_SIZE});
+}
+
+// Write a short page header at the current offset
+static void
+testWalPageHeader(TestWal *const wal, const uint32_t remainSize)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM_P(VOID, wal);
+        FUNCTION_HARNESS_PARAM(UINT, remainSize);
+    FUNCTION_HARNESS_END();
+
+    WalPageHeader *const header = (WalPageHeader *)(bufPtr(wal->buffer) + wal->offset);
+
+    header->magic = ((WalPageHeader *)bufPtr(wal->buffer))->magic;
+    header->info = remainSize > 0 ? WAL_PAGE_FIRST_IS_CONTRECORD : 0;
+    header->pageAddr = TEST_WAL_PAGE_ADDR + wal->offset;
+    header->remainSize = remainSize;
+
+    wal->offset += WAL_PAGE_HEADER_SIZE;
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+// Write data that may continue on following pages
+static void
+testWalWrite(TestWal *const wal, const unsigned char *const data, const size_t size)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM_P(VOID, wal);
+        FUNCTION_HARNESS_PARAM_P(VOID, data);
+        FUNCTION_HARNESS_PARAM(SIZE, size);
+    FUNCTION_HARNESS_END();
+
+    for (size_t dataIdx = 0; dataIdx < size; dataIdx++)
+    {
+        if (wal->offset % TEST_WAL_PAGE_SIZE == 0)
+            testWalPageHeader(wal, (uint32_t)(size - dataIdx));
+
+        bufPtr(wal->buffer)[wal->offset++] = data[dataIdx];
+    }
+
+    wal->offset = WAL_ALIGN(wal->offset);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+// Write a record with a valid CRC-32C
+static void
+testWalRecord(TestWal *const wal, const size_t dataSize, const uint8_t rmgrId, const uint8_t info)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM_P(VOID, wal);
+        FUNCTION_HARNESS_PARAM(SIZE, dataSize);
+        FUNCTION_HARNESS_PARAM(UINT, rmgrId);
+        FUNCTION_HARNESS_PARAM(UINT, info);
+    FUNCTION_HARNESS_END();
+
+    if (wal->offset % TEST_WAL_PAGE_SIZE == 0)
+        testWalPageHeader(wal, 0);
+
+    Buffer *const record = bufNew(WAL_RECORD_HEADER_SIZE + dataSize);
+    bufUsedSet(record, bufSize(record));
+    memset(bufPtr(record), 0, bufSize(record));
+
+    WalRecordHeader *const header = (WalRecordHeader *)bufPtr(record);
+    unsigned char *const data = bufPtr(record) + WAL_RECORD_HEADER_SIZE;
+
+    for (size_t dataIdx = 0; dataIdx < dataSize; dataIdx++)
+        data[dataIdx] = (unsigned char)(dataIdx * 7 + dataSize);
+
+    header->totalSize = (uint32_t)bufUsed(record);
+    header->xid = 1;
+    header->prior = TEST_WAL_PAGE_ADDR + wal->recordOffset;
+    header->info = info;
+    header->rmgrId = rmgrId;
+    header->crc = crc32cUpdate(crc32cOne(data, dataSize), (const unsigned char *)header, offsetof(WalRecordHeader, crc));
+
+    wal->recordOffset = wal->offset;
+    wal->recordCrc = header->crc;
+
+    testWalWrite(wal, bufPtr(record), bufUsed(record));
+    bufFree(record);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+// Run the record check filter on a WAL segment and return the number of records checked
+static uint64_t
+testWalCheck(const Buffer *const buffer)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, buffer);
+    FUNCTION_HARNESS_END();
+
+    IoRead *const read = ioBufferReadNew(buffer);
+    ioFilterGroupAdd(ioReadFilterGroup(read), walRecordCheckNew(STRDEF("000000010000000100000001")));
+    ioReadDrain(read);
+
+    FUNCTION_HARNESS_RETURN(UINT64, pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(read), WAL_RECORD_CHECK_FILTER_TYPE)));
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -23,6 +164,7 @@ testRun(void)
 
     // Create default storage object for testing
     Storage *storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+    const Storage *const storageHrn = storagePosixNewP(HRN_PATH_STR);
 
     // *****************************************************************************************************************************
     if (testBegin("archivePushReadyList(), archivePushProcessList(), and archivePushDrop()"))
@@ -95,6 +237,189 @@ testRun(void)
         TEST_RESULT_BOOL(archivePushDrop(STRDEF("pg_wal"), strLstNew()), false, "no WAL to be processed");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("walRecordCheckNew()"))
+    {
+        Buffer *const walBuffer = bufNew(TEST_WAL_PAGE_SIZE * 8);
+        bufUsedSet(walBuffer, bufSize(walBuffer));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("records spanning pages");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        TestWal wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, 100, 1, 0);                             // Fits on the first page
+        testWalRecord(&wal, 1500, 2, 0);                            // Spans two pages
+        testWalRecord(&wal, 296, 3, 0);                             // Ends eight bytes before the next page
+        testWalRecord(&wal, 16, 4, 0);                              // Header spans two pages
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 4, "check records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("walRecordCheckToLog()");
+
+        char logBuffer[STACK_TRACE_PARAM_MAX];
+        WalRecordCheck *const walRecordCheck = (WalRecordCheck *)ioFilterDriver(
+            walRecordCheckNew(STRDEF("000000010000000100000001")));
+
+        TEST_RESULT_VOID(
+            FUNCTION_LOG_OBJECT_FORMAT(walRecordCheck, walRecordCheckToLog, logBuffer, sizeof(logBuffer)), "walRecordCheckToLog");
+        TEST_RESULT_Z(logBuffer, "{pageNo: 0, recordTotal: 0}", "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("records spanning pages read in small chunks");
+
+        const size_t bufferSize = ioBufferSize();
+        ioBufferSizeSet(333);
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 4, "check records");
+
+        ioBufferSizeSet(bufferSize);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("records end at an XLOG switch");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, 100, 1, 0);
+        testWalRecord(&wal, 100, WAL_RMGR_XLOG, 0x10);              // Not a switch
+        testWalRecord(&wal, 0, WAL_RMGR_XLOG, WAL_RECORD_XLOG_SWITCH | 0x01);
+        testWalRecord(&wal, 100, 1, 0);
+        ((WalRecordHeader *)(bufPtr(walBuffer) + wal.recordOffset))->crc++;
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 3, "check records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("first page continues a record from the prior segment");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 1200);
+
+        testWalWrite(&wal, bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE * 4, 1200);
+        testWalRecord(&wal, 100, 1, 0);
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 1, "check records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("records end at a page recycled from an older segment");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, TEST_WAL_PAGE_SIZE - WAL_LONG_PAGE_HEADER_SIZE - WAL_RECORD_HEADER_SIZE, 1, 0);
+        testWalRecord(&wal, 100, 1, 0);
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->pageAddr -= TEST_WAL_PAGE_SIZE * 8;
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 1, "check records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid first page");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+        ((WalLongPageHeader *)bufPtr(walBuffer))->std.info = 0;
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError, "WAL file '000000010000000100000001' first page does not have a long header");
+
+        wal = testWalNew(walBuffer, 0);
+        ((WalLongPageHeader *)bufPtr(walBuffer))->pageSize = 512;
+
+        TEST_ERROR(testWalCheck(walBuffer), FormatError, "WAL file '000000010000000100000001' has invalid page size 512");
+
+        ((WalLongPageHeader *)bufPtr(walBuffer))->pageSize = 131072;
+
+        TEST_ERROR(testWalCheck(walBuffer), FormatError, "WAL file '000000010000000100000001' has invalid page size 131072");
+
+        ((WalLongPageHeader *)bufPtr(walBuffer))->pageSize = 1000;
+
+        TEST_ERROR(testWalCheck(walBuffer), FormatError, "WAL file '000000010000000100000001' has invalid page size 1000");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid record length");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+        *(uint32_t *)(bufPtr(walBuffer) + wal.offset) = 10;
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError, "WAL file '000000010000000100000001' record at offset 40 has invalid length 10");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("checksum mismatch");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, 100, 1, 0);
+        testWalRecord(&wal, 1500, 1, 0);
+        ((WalRecordHeader *)(bufPtr(walBuffer) + wal.recordOffset))->crc ^= 0xFF;
+
+        TEST_ERROR_FMT(
+            testWalCheck(walBuffer), ChecksumError,
+            "WAL file '000000010000000100000001' record at offset 168 has checksum %08x but expected %08x", wal.recordCrc,
+            wal.recordCrc ^ 0xFF);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("torn record");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, 1500, 1, 0);
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->magic = 0;
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError,
+            "WAL file '000000010000000100000001' record at offset 40 continues on a page with an invalid header");
+
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->magic = TEST_WAL_PAGE_MAGIC;
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->info = 0;
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError,
+            "WAL file '000000010000000100000001' record at offset 40 is not continued on the next page");
+
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->info = WAL_PAGE_FIRST_IS_CONTRECORD;
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->remainSize++;
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError,
+            "WAL file '000000010000000100000001' record at offset 40 is not continued on the next page");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("aborted record overwritten on the next page");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, 100, 1, 0);
+        testWalRecord(&wal, 1500, 1, 0);
+        memset(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE, 0, bufSize(walBuffer) - TEST_WAL_PAGE_SIZE);
+
+        wal.offset = TEST_WAL_PAGE_SIZE;
+        testWalPageHeader(&wal, 0);
+        ((WalPageHeader *)(bufPtr(walBuffer) + TEST_WAL_PAGE_SIZE))->info = WAL_PAGE_FIRST_IS_OVERWRITE_CONTRECORD;
+        testWalRecord(&wal, 16, WAL_RMGR_XLOG, 0xD0);               // XLOG_OVERWRITE_CONTRECORD
+
+        TEST_RESULT_UINT(testWalCheck(walBuffer), 2, "check records");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("page continues a record that was not started");
+
+        memset(bufPtr(walBuffer), 0, bufSize(walBuffer));
+        wal = testWalNew(walBuffer, 0);
+
+        testWalRecord(&wal, TEST_WAL_PAGE_SIZE - WAL_LONG_PAGE_HEADER_SIZE - WAL_RECORD_HEADER_SIZE, 1, 0);
+        testWalPageHeader(&wal, 100);
+
+        TEST_ERROR(
+            testWalCheck(walBuffer), FormatError,
+            "WAL file '000000010000000100000001' page at offset 1024 continues a record that was not started");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("archivePushCheck()"))
     {
@@ -386,6 +711,47 @@ testRun(void)
             cmdArchivePush(), ArchiveDuplicateError,
             "WAL file '000000010000000100000001' already exists in the repo1 archive with a different checksum");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("WAL record check");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000001");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        Buffer *walBufferRecord = bufDup(walBuffer1);
+        TestWal wal = testWalNew(walBufferRecord, 0);
+
+        testWalRecord(&wal, 100, 1, 0);
+        ((WalRecordHeader *)(bufPtr(walBufferRecord) + wal.recordOffset))->crc ^= 0xFF;
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001", walBufferRecord);
+
+        TEST_ERROR_FMT(
+            cmdArchivePush(), ChecksumError,
+            "WAL file '" TEST_PATH "/pg/pg_wal/000000010000000100000001' record at offset 40 has checksum %08x but expected %08x",
+            wal.recordCrc, wal.recordCrc ^ 0xFF);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("WAL record check skipped for partial WAL");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000001.partial");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001.partial", walBufferRecord);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the partial WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000001.partial' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageRepoIdxWrite(0),
+            zNewFmt(
+                STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000001.partial-%s.gz",
+                strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, walBufferRecord)))),
+            .remove = true, .comment = "check repo for partial WAL file, then remove");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("WAL with absolute path and no pg1-path");
 
@@ -642,6 +1008,144 @@ testRun(void)
             .remove = true);
 
         HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in a bundle to both repos");
+
+        HRN_STORAGE_PUT(storageTest, "pg/pg_wal/000000010000000100000003", walBuffer2);
+        HRN_STORAGE_PUT(storageTest, "pg/pg_wal/000000010000000100000004", walBuffer2);
+
+        const ArchivePushCheckResult checkResult = archivePushCheck(true);
+        const String *const walPath = STRDEF(TEST_PATH "/pg/pg_wal");
+        StringList *walFileList = strLstNew();
+        strLstAddZ(walFileList, "000000010000000100000002");
+        strLstAddZ(walFileList, "000000010000000100000003");
+
+        ArchivePushBundleResult bundleResult;
+
+        TEST_ASSIGN(
+            bundleResult,
+            archivePushBundle(
+                walPath, walFileList, true, false, true, checkResult.pgVersion, checkResult.pgSystemId, compressTypeGz, 1,
+                checkResult.repoList, checkResult.errorList),
+            "push bundle");
+        TEST_RESULT_UINT(lstSize(bundleResult.fileResultList), 2, "check result size");
+        TEST_RESULT_STRLST_Z(((ArchivePushFileResult *)lstGet(bundleResult.fileResultList, 0))->warnList, NULL, "check warnings");
+
+        TEST_STORAGE_LIST(
+            storageTest, "repo3/archive/test/11-1/0000000100000001",
+            "000000010000000100000002-000000010000000100000003.bundle\n"
+            "000000010000000100000002-000000010000000100000003.index\n",
+            .comment = "check repo3 for bundle");
+
+        WalSegmentFind *find = walSegmentFindNew(storageRepoIdx(0), STRDEF("11-1"), false, 0);
+
+        TEST_RESULT_STR(
+            walSegmentFind(find, STRDEF("000000010000000100000003")),
+            strNewFmt("000000010000000100000003-%s.gz", walBuffer2Sha1), "find WAL segment in repo2 bundle");
+        TEST_RESULT_STR_Z(
+            walSegmentFindBundle(find)->bundle, "000000010000000100000002-000000010000000100000003.bundle", "check bundle");
+
+        StorageRead *read = storageNewReadP(
+            storageRepoIdx(0),
+            STRDEF(STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000002-000000010000000100000003.bundle"),
+            .offset = walSegmentFindBundle(find)->offset, .limit = VARUINT64(walSegmentFindBundle(find)->size));
+        ioFilterGroupAdd(
+            ioReadFilterGroup(storageReadIo(read)),
+            cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTRDEF("badsubpassphrase")));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), decompressFilterP(compressTypeGz));
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(read), walBuffer2), true, "check encrypted WAL segment in repo2 bundle");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in a bundle when some already exist");
+
+        strLstAddZ(walFileList, "000000010000000100000004");
+
+        TEST_ASSIGN(
+            bundleResult,
+            archivePushBundle(
+                walPath, walFileList, false, false, true, checkResult.pgVersion, checkResult.pgSystemId, compressTypeNone, 1,
+                checkResult.repoList, checkResult.errorList),
+            "push bundle");
+        TEST_RESULT_STRLST_Z(
+            ((ArchivePushFileResult *)lstGet(bundleResult.fileResultList, 1))->warnList,
+            "WAL file '000000010000000100000003' already exists in the repo2 archive with the same checksum\n"
+            "HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "WAL file '000000010000000100000003' already exists in the repo3 archive with the same checksum\n"
+            "HINT: this is valid in some recovery scenarios but may also indicate a problem.\n",
+            "check warnings");
+        TEST_RESULT_STRLST_Z(((ArchivePushFileResult *)lstGet(bundleResult.fileResultList, 2))->warnList, NULL, "check warnings");
+
+        TEST_STORAGE_LIST(
+            storageTest, "repo3/archive/test/11-1/0000000100000001",
+            "000000010000000100000002-000000010000000100000003.bundle\n"
+            "000000010000000100000002-000000010000000100000003.index\n"
+            "000000010000000100000004-000000010000000100000004.bundle\n"
+            "000000010000000100000004-000000010000000100000004.index\n",
+            .comment = "check repo3 for bundles");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in a bundle with a different checksum");
+
+        Buffer *walBuffer3 = bufDup(walBuffer2);
+        bufPtr(walBuffer3)[bufUsed(walBuffer3) - 1] = 0xFE;
+        HRN_STORAGE_PUT(storageTest, "pg/pg_wal/000000010000000100000004", walBuffer3);
+
+        TEST_ERROR(
+            archivePushBundle(
+                walPath, walFileList, true, false, true, checkResult.pgVersion, checkResult.pgSystemId, compressTypeNone, 1,
+                checkResult.repoList, checkResult.errorList),
+            ArchiveDuplicateError,
+            "WAL file '000000010000000100000004' already exists in the repo2 archive with a different checksum");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle write error on one repo and index write error on the other repo");
+
+        HRN_STORAGE_PUT(storageTest, "pg/pg_wal/000000010000000100000005", walBuffer2);
+        HRN_STORAGE_PUT(storageTest, "pg/pg_wal/000000010000000100000006", walBuffer2);
+        HRN_STORAGE_PATH_CREATE(
+            storageTest,
+            "repo3/archive/test/11-1/0000000100000001/000000010000000100000005-000000010000000100000006.index.pgbackrest.tmp");
+        HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1/0000000100000001", .mode = 0500);
+
+        walFileList = strLstNew();
+        strLstAddZ(walFileList, "000000010000000100000005");
+        strLstAddZ(walFileList, "000000010000000100000006");
+
+        TEST_ERROR(
+            archivePushBundle(
+                walPath, walFileList, true, false, true, checkResult.pgVersion, checkResult.pgSystemId, compressTypeNone, 1,
+                checkResult.repoList, checkResult.errorList),
+            CommandError,
+            "archive-push command encountered error(s):\n"
+            "repo2: [FileOpenError] unable to open file '" TEST_PATH "/repo2/archive/test/11-1/0000000100000001"
+            "/000000010000000100000005-000000010000000100000006.bundle' for write: [13] Permission denied\n"
+            "repo3: [FileOpenError] unable to open file '" TEST_PATH "/repo3/archive/test/11-1/0000000100000001"
+            "/000000010000000100000005-000000010000000100000006.index' for write: [21] Is a directory");
+
+        HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1/0000000100000001");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle find error on one repo");
+
+        HRN_STORAGE_PATH_REMOVE(
+            storageTest,
+            "repo3/archive/test/11-1/0000000100000001/000000010000000100000005-000000010000000100000006.index.pgbackrest.tmp",
+            .errorOnMissing = true);
+
+        HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1", .mode = 0200);
+
+        TEST_ERROR(
+            archivePushBundle(
+                walPath, walFileList, true, false, true, checkResult.pgVersion, checkResult.pgSystemId, compressTypeNone, 1,
+                checkResult.repoList, checkResult.errorList),
+            CommandError,
+            "archive-push command encountered error(s):\n"
+            "repo2: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo2/archive/test/11-1/0000000100000001':"
+            " [13] Permission denied");
+
+        HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1");
     }
 
     // *****************************************************************************************************************************
@@ -782,11 +1286,67 @@ testRun(void)
         }
         HRN_FORK_END();
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("with lock, notify lingering async process");
+
+        hrnCfgArgRawZ(argListTemp, cfgOptArchivePushLinger, "5");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                lockInit(cfgOptionStr(cfgOptLockPath), STRDEF("555-fefefefe"));
+                cmdLockAcquireP(.returnOnNoLock = true);
+                ArchiveAsyncListen *const listen = archiveAsyncListenNew(archiveModePush);
+
+                // Notify parent that lock has been acquired and the async process is listening
+                HRN_FORK_CHILD_NOTIFY_PUT();
+
+                TEST_RESULT_STR_Z(archiveAsyncListenWait(listen, 5000), "000000010000000100000001", "notification received");
+
+                // Wait for parent to allow release lock
+                HRN_FORK_CHILD_NOTIFY_GET();
+
+                archiveAsyncListenFree(listen);
+                cmdLockReleaseP();
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                // Wait for child to acquire lock
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                // Stale error from a prior attempt is cleared before notifying so it is not thrown while the async process retries
+                HRN_STORAGE_PUT_Z(
+                    storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000001.error", "25\nstale error");
+
+                TEST_ERROR(
+                    cmdArchivePush(), ArchiveTimeoutError,
+                    "unable to push WAL file '000000010000000100000001' to the archive asynchronously after 1 second(s)\n"
+                    "HINT: check '" HRN_PATH "/test-archive-push-async.log' for errors.");
+
+                TEST_RESULT_BOOL(
+                    storageExistsP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000001.error")), false,
+                    "error cleared");
+
+                // Notify child to release lock
+                HRN_FORK_PARENT_NOTIFY_PUT(0);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        TEST_RESULT_BOOL(
+            storageInfoP(storageHrn, STRDEF("lock/test-archive-push.sock"), .ignoreMissing = true).exists, false, "socket removed");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("async WAL push");
 
-        // Actually push a WAL file
+        // Actually push a WAL file. The record check is skipped since PostgreSQL < 9.5 uses a different record format.
         argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchiveRecordCheck, true);
         strLstAddZ(argListTemp, TEST_PATH "/pg/pg_xlog/000000010000000100000001");
         HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
 
@@ -822,6 +1382,19 @@ testRun(void)
 
         TEST_ERROR(cmdArchivePushAsync(), ParamRequiredError, "WAL path to push required");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("notification socket path too long");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawFmt(argListTemp, cfgOptLockPath, "/%0100d", 0);
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .noStd = true);
+
+        TEST_ERROR_FMT(
+            archiveAsyncNotify(archiveModePush, STRDEF("000000010000000100000001")), OptionInvalidValueError,
+            "socket '/%0100d/test-archive-push.sock' is too long for 'archive-push-linger' option\n"
+            "HINT: use a shorter 'lock-path'.",
+            0);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("async, check that global.error is created");
 
@@ -1002,6 +1575,152 @@ testRun(void)
             "000000010000000100000002.ok\n",
             .comment = "check status files");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("linger and push WAL that is ready before linger expires");
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000004", walBuffer3);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000004.ready");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchivePushLinger, "1");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                // Wait for the async process to listen
+                while (!storageInfoP(storageHrn, STRDEF("lock/test-archive-push.sock"), .ignoreMissing = true).exists)
+                    sleepMSec(10);
+
+                HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000005", walBuffer3);
+                HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000005.ready");
+
+                TEST_RESULT_VOID(archiveAsyncNotify(archiveModePush, STRDEF("000000010000000100000005")), "notify");
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+                TEST_RESULT_LOG(
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000004\n"
+                    "P01 DETAIL: pushed WAL file '000000010000000100000004' to the archive\n"
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000005\n"
+                    "P01 DETAIL: pushed WAL file '000000010000000100000005' to the archive");
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT,
+            "000000010000000100000001.ok\n"
+            "000000010000000100000002.ok\n"
+            "000000010000000100000004.ok\n"
+            "000000010000000100000005.ok\n",
+            .comment = "check status files");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in bundles");
+
+        HRN_STORAGE_PATH_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT, .recurse = true);
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), "pg_xlog/archive_status", .recurse = true);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000006", walBuffer3);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000007", walBuffer3);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000008", walBuffer3);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000200000000", walBuffer3);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000200000001.partial", walBuffer3);
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_xlog/00000002.history", "HISTORY");
+
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000006.ready");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000007.ready");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000008.ready");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000200000000.ready");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000200000001.partial.ready");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/00000002.history.ready");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchivePushBundleMax, "2");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG(
+            "P00   INFO: push 6 WAL file(s) to archive: 000000010000000100000006...00000002.history\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000006' to the archive\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000007' to the archive\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000008' to the archive\n"
+            "P01 DETAIL: pushed WAL file '000000010000000200000000' to the archive\n"
+            "P01 DETAIL: pushed WAL file '000000010000000200000001.partial' to the archive\n"
+            "P01 DETAIL: pushed WAL file '00000002.history' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageTest, "repo/archive/test/9.4-1/0000000100000001/000000010000000100000006-000000010000000100000007.index",
+            .comment = "check repo1 for bundle index");
+        TEST_STORAGE_EXISTS(
+            storageTest, "repo3/archive/test/9.4-1/0000000100000001/000000010000000100000006-000000010000000100000007.index",
+            .comment = "check repo3 for bundle index");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/9.4-1/0000000100000001/000000010000000100000008-%s", walBuffer3Sha1),
+            .comment = "check repo3 for WAL 8 file");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT,
+            "000000010000000100000006.ok\n"
+            "000000010000000100000007.ok\n"
+            "000000010000000100000008.ok\n"
+            "000000010000000200000000.ok\n"
+            "000000010000000200000001.partial.ok\n"
+            "00000002.history.ok\n",
+            .comment = "check status files");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in a bundle again to get warnings");
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000006.ok");
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000007.ok");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000008.ready");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000200000000.ready");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000200000001.partial.ready");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/00000002.history.ready");
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG(
+            "P00   INFO: push 2 WAL file(s) to archive: 000000010000000100000006...000000010000000100000007\n"
+            "P01   WARN: WAL file '000000010000000100000006' already exists in the repo1 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P01   WARN: WAL file '000000010000000100000006' already exists in the repo3 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000006' to the archive\n"
+            "P01   WARN: WAL file '000000010000000100000007' already exists in the repo1 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P01   WARN: WAL file '000000010000000100000007' already exists in the repo3 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000007' to the archive");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL segments in a bundle with error");
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000006.ok");
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000007.ok");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/000000010000000100000007");
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG_FMT(
+            "P00   INFO: push 2 WAL file(s) to archive: 000000010000000100000006...000000010000000100000007\n"
+            "P01   WARN: could not push WAL file '000000010000000100000006' to the archive (will be retried): "
+            "[55] raised from local-1 shim protocol: " STORAGE_ERROR_READ_MISSING "\n"
+            "P01   WARN: could not push WAL file '000000010000000100000007' to the archive (will be retried): "
+            "[55] raised from local-1 shim protocol: " STORAGE_ERROR_READ_MISSING,
+            TEST_PATH "/pg/pg_xlog/000000010000000100000007", TEST_PATH "/pg/pg_xlog/000000010000000100000007");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT,
+            "000000010000000100000006.error\n"
+            "000000010000000100000007.error\n",
+            .comment = "check status files");
+
         // Uninstall local command handler shim
         hrnProtocolLocalShimUninstall();
     }
@@ -1,6 +1,8 @@
 /***********************************************************************************************************************************
 Test Backup Command
 ***********************************************************************************************************************************/
+#include <unistd.h>
+
 #include "command/stanza/create.h"
 #include "command/stanza/upgrade.h"
 #include "common/crypto/hash.h"
@@ -99,41 +101,50 @@ testBackupValidateFile(
         String *const mapLog = strNew();
         const BlockMapItem *blockMapItemLast = NULL;
 
-        for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+        // Blocks in the block store are not in super blocks so only log the total
+        if (blockMapGet(blockMap, 0)->reference == BLOCK_MAP_REFERENCE_STORE)
+            strCatFmt(mapLog, "s:{%u blocks", blockMapSize(blockMap));
+        else
         {
-            const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
-            const bool superBlockChange =
-                blockMapItemLast == NULL || blockMapItemLast->reference != blockMapItem->reference ||
-                blockMapItemLast->offset != blockMapItem->offset;
+            for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+            {
+                const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+                const bool superBlockChange =
+                    blockMapItemLast == NULL || blockMapItemLast->reference != blockMapItem->reference ||
+                    blockMapItemLast->bundleId != blockMapItem->bundleId || blockMapItemLast->offset != blockMapItem->offset;
 
-            if (superBlockChange && blockMapIdx != 0)
-                strCatChr(mapLog, '}');
+                if (superBlockChange && blockMapIdx != 0)
+                    strCatChr(mapLog, '}');
 
-            if (!strEmpty(mapLog))
-                strCatChr(mapLog, ',');
+                if (!strEmpty(mapLog))
+                    strCatChr(mapLog, ',');
 
-            if (superBlockChange)
-                strCatFmt(mapLog, "%u:{", blockMapItem->reference);
+                if (superBlockChange)
+                    strCatFmt(mapLog, "%u:{", blockMapItem->reference);
 
-            strCatFmt(mapLog, "%" PRIu64, blockMapItem->block);
+                strCatFmt(mapLog, "%" PRIu64, blockMapItem->block);
 
-            blockMapItemLast = blockMapItem;
+                blockMapItemLast = blockMapItem;
+            }
         }
 
         // Check blocks
         Buffer *fileBuffer = bufNew((size_t)file.size);
         bufUsedSet(fileBuffer, bufSize(fileBuffer));
 
-        BlockDelta *const blockDelta = blockDeltaNew(
+        BlockDelta *const blockDelta = blockDeltaNewP(
             blockMap, file.blockIncrSize, file.blockIncrChecksumSize, NULL, cipherType, cipherPass,
             manifestData->backupOptionCompressType);
 
         for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
         {
             const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
-            const String *const blockName = backupFileRepoPathP(
-                strLstGet(manifestReferenceList(manifest), read->reference), .manifestName = file.name,
-                .bundleId = read->bundleId, .blockIncr = true);
+            const String *const blockName =
+                read->reference == BLOCK_MAP_REFERENCE_STORE ?
+                    backupBlockStorePath(read->checksum, manifestData->backupOptionCompressType) :
+                    backupFileRepoPathP(
+                        strLstGet(manifestReferenceList(manifest), read->reference), .manifestName = file.name,
+                        .bundleId = read->bundleId, .blockIncr = true);
 
             IoRead *blockRead = storageReadIo(
                 storageNewReadP(
@@ -686,7 +697,7 @@ testRun(void)
         ioFilterGroupAdd(
             ioWriteFilterGroup(write),
             pageChecksumNewPack(
-                ioFilterParamList(pageChecksumNew(0, PG_SEGMENT_PAGE_DEFAULT, pgPageSize8, true, STRDEF(BOGUS_STR)))));
+                ioFilterParamList(pageChecksumNew(0, PG_SEGMENT_PAGE_DEFAULT, 0, pgPageSize8, true, STRDEF(BOGUS_STR)))));
         ioWriteOpen(write);
         ioWrite(write, buffer);
         TEST_ERROR(ioWrite(write, buffer), AssertError, "should not be possible to see two misaligned pages in a row");
@@ -717,7 +728,7 @@ testRun(void)
         write = ioBufferWriteNew(bufferOut);
         ioFilterGroupAdd(
             ioWriteFilterGroup(write),
-            pageChecksumNew(0, PG_SEGMENT_PAGE_DEFAULT, pgPageSize8, true, storagePathP(storageTest, STRDEF("relation"))));
+            pageChecksumNew(0, PG_SEGMENT_PAGE_DEFAULT, 0, pgPageSize8, true, storagePathP(storageTest, STRDEF("relation"))));
         ioWriteOpen(write);
         ioWrite(write, buffer);
         ioWriteClose(write);
@@ -725,6 +736,24 @@ testRun(void)
         TEST_RESULT_STR_Z(
             hrnPackToStr(ioFilterGroupResultPackP(ioWriteFilterGroup(write), PAGE_CHECKSUM_FILTER_TYPE)),
             "2:bool:true, 3:bool:true", "valid on retry");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("check a range of the segment");
+
+        // The page checksum is still invalid in the file so the retry will not find a change
+        HRN_STORAGE_PUT(storageTest, "relation", buffer);
+
+        write = ioBufferWriteNew(bufferOut);
+        ioFilterGroupAdd(
+            ioWriteFilterGroup(write),
+            pageChecksumNew(0, PG_SEGMENT_PAGE_DEFAULT, 2, pgPageSize8, true, storagePathP(storageTest, STRDEF("relation"))));
+        ioWriteOpen(write);
+        ioWrite(write, BUF(bufPtr(buffer) + pgPageSize8 * 2, pgPageSize8 * 2));
+        ioWriteClose(write);
+
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(ioFilterGroupResultPackP(ioWriteFilterGroup(write), PAGE_CHECKSUM_FILTER_TYPE)),
+            "1:array:[4:obj:{}], 2:bool:false, 3:bool:true", "page number is relative to the segment");
     }
 
     // *****************************************************************************************************************************
@@ -1086,6 +1115,131 @@ testRun(void)
             "  super block {max: 2, size: 6}\n"
             "    block {no: 0, offset: 21}\n",
             "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write block store map");
+
+        BlockMap *blockMapStore = blockMapNew();
+
+        BlockMapItem blockMapItemStore =
+        {
+            .reference = BLOCK_MAP_REFERENCE_STORE,
+            .superBlockSize = 3,
+            .size = 2,
+            .checksum = {0xee, 0xee, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08},
+        };
+
+        TEST_RESULT_VOID(blockMapAdd(blockMapStore, &blockMapItemStore), "add");
+
+        blockMapItemStore.size = 99;
+        blockMapItemStore.checksum[2] = 0x02;
+        TEST_RESULT_VOID(blockMapAdd(blockMapStore, &blockMapItemStore), "add");
+
+        buffer = bufNew(256);
+        write = ioBufferWriteNewOpen(buffer);
+        TEST_RESULT_VOID(blockMapWrite(blockMapStore, write, 3, 8), "save");
+        ioWriteClose(write);
+
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, buffer),
+            "03"                                        // Version 1, block store
+            "02"                                        // block total 2
+
+            "02"                                        // size 2
+            "eeee01000000ffff0102030405060708"          // checksum
+
+            "63"                                        // size 99
+            "eeee02000000ffff0102030405060708",         // checksum
+            "compare");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read block store map");
+
+        bufferCompare = bufNew(256);
+        write = ioBufferWriteNewOpen(bufferCompare);
+        TEST_RESULT_VOID(blockMapWrite(blockMapNewRead(ioBufferReadNewOpen(buffer), 3, 8), write, 3, 8), "read and save");
+        ioWriteClose(write);
+
+        TEST_RESULT_STR(strNewEncode(encodingHex, bufferCompare), strNewEncode(encodingHex, buffer), "compare");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block store delta");
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapNewRead(ioBufferReadNewOpen(buffer), 3, 8), 3, 8),
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 2}\n"
+            "  super block {max: 3, size: 2}\n"
+            "    block {no: 0, offset: 0}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 99}\n"
+            "  super block {max: 3, size: 99}\n"
+            "    block {no: 0, offset: 3}\n",
+            "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write map with a reference in more than one bundle");
+
+        BlockMap *blockMapBundle = blockMapNew();
+
+        BlockMapItem blockMapItemBundle =
+        {
+            .reference = 0,
+            .superBlockSize = 3,
+            .bundleId = 1,
+            .offset = 0,
+            .size = 5,
+            .checksum = {0xee, 0xee, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff},
+        };
+
+        TEST_RESULT_VOID(blockMapAdd(blockMapBundle, &blockMapItemBundle), "add");
+
+        blockMapItemBundle.bundleId = 2;
+        blockMapItemBundle.size = 6;
+        blockMapItemBundle.checksum[2] = 0x02;
+        TEST_RESULT_VOID(blockMapAdd(blockMapBundle, &blockMapItemBundle), "add");
+
+        blockMapItemBundle.offset = 6;
+        blockMapItemBundle.size = 4;
+        blockMapItemBundle.checksum[2] = 0x03;
+        TEST_RESULT_VOID(blockMapAdd(blockMapBundle, &blockMapItemBundle), "add");
+
+        buffer = bufNew(256);
+        write = ioBufferWriteNewOpen(buffer);
+        TEST_RESULT_VOID(blockMapWrite(blockMapBundle, write, 3, 8), "save");
+        ioWriteClose(write);
+
+        TEST_RESULT_UINT(*bufPtr(buffer), 0x05, "version 1, bundle");
+
+        bufferCompare = bufNew(256);
+        write = ioBufferWriteNewOpen(bufferCompare);
+        TEST_RESULT_VOID(blockMapWrite(blockMapNewRead(ioBufferReadNewOpen(buffer), 3, 8), write, 3, 8), "read and save");
+        ioWriteClose(write);
+
+        TEST_RESULT_STR(strNewEncode(encodingHex, bufferCompare), strNewEncode(encodingHex, buffer), "compare");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("reference in more than one bundle delta");
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapNewRead(ioBufferReadNewOpen(buffer), 3, 8), 3, 8),
+            "read {reference: 0, bundleId: 1, offset: 0, size: 5}\n"
+            "  super block {max: 3, size: 5}\n"
+            "    block {no: 0, offset: 0}\n"
+            "read {reference: 0, bundleId: 2, offset: 0, size: 10}\n"
+            "  super block {max: 3, size: 6}\n"
+            "    block {no: 0, offset: 3}\n"
+            "  super block {max: 3, size: 4}\n"
+            "    block {no: 0, offset: 6}\n",
+            "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on version that does not match flags");
+
+        TEST_ERROR(
+            blockMapNewRead(ioBufferReadNewOpen(BUFSTRDEF("\x04")), 3, 8), FormatError, "block map version does not match flags");
+        TEST_ERROR(
+            blockMapNewRead(ioBufferReadNewOpen(BUFSTRDEF("\x02")), 3, 8), FormatError, "block map version does not match flags");
+        TEST_ERROR(
+            blockMapNewRead(ioBufferReadNewOpen(BUFSTRDEF("\x01")), 3, 8), FormatError, "block map version does not match flags");
     }
 
     // *****************************************************************************************************************************
@@ -1116,7 +1270,7 @@ testRun(void)
         IoWrite *write = ioBufferWriteNew(destination);
 
         TEST_RESULT_VOID(
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 6, 0, 0, 0, NULL, NULL, NULL)), "block incr");
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNewP(3, 3, 6, 0, 0, 0, NULL, NULL, NULL)), "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
         TEST_RESULT_VOID(ioWriteClose(write), "close");
@@ -1132,7 +1286,7 @@ testRun(void)
         write = ioBufferWriteNew(destination);
 
         TEST_RESULT_VOID(
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 8, 0, 0, 0, NULL, NULL, NULL)), "block incr");
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNewP(3, 3, 8, 0, 0, 0, NULL, NULL, NULL)), "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
         TEST_RESULT_VOID(ioWriteClose(write), "close");
@@ -1167,7 +1321,7 @@ testRun(void)
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
                 ioWriteFilterGroup(write),
-                blockIncrNewPack(ioFilterParamList(blockIncrNew(2, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
+                blockIncrNewPack(ioFilterParamList(blockIncrNewP(2, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1209,7 +1363,7 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
+                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNewP(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1253,7 +1407,7 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
+                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNewP(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1276,7 +1430,7 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(6, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
+                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNewP(6, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1310,10 +1464,284 @@ testRun(void)
         TEST_RESULT_VOID(
             blockIncrNewPack(
                 ioFilterParamList(
-                    blockIncrNew(
+                    blockIncrNewP(
                         3, 3, 8, 2, 4, 5, NULL, compressFilterP(compressTypeGz, 1, .raw = true),
                         cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Cbc, BUFSTRDEF(TEST_CIPHER_PASS), .raw = true)))),
             "block incr pack");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block store and other stanza paths");
+
+        TEST_RESULT_STR_Z(
+            backupBlockStorePath(
+                (const unsigned char [XX_HASH_SIZE_MAX]){0xee, 0xee, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0x01, 0x02},
+                compressTypeGz),
+            "block/ee/eeee01000000ffff0102000000000000.gz", "block store path");
+        TEST_RESULT_STR_Z(
+            backupFileRepoPathP(
+                STRDEF("20191020-193320F"), .manifestName = STRDEF("pg_data/base/1/2"), .blockIncr = true,
+                .stanza = STRDEF("other")),
+            "backup/other/20191020-193320F/pg_data/base/1/2.pgbi", "other stanza path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("full backup with block store");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        ioBufferSizeSet(2);
+
+        source = BUFSTRZ("ABCXYZABC12");
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(
+                    ioFilterParamList(
+                        blockIncrNewP(
+                            3, 3, 8, 0, 0, 0, NULL, compressFilterP(compressTypeGz, 1, .raw = true), NULL, .store = true,
+                            .compressType = compressTypeGz)))),
+            "block incr");
+        TEST_RESULT_VOID(ioWriteOpen(write), "open");
+        TEST_RESULT_VOID(ioWrite(write, source), "write");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+
+        TEST_ASSIGN(mapSize, pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE)), "map size");
+        TEST_RESULT_UINT(mapSize, bufUsed(destination), "only map is written");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "26/\n"
+            "26/26251b11a5c02cb9933c068887eb6b65.gz\n"
+            "3f/\n"
+            "3f/3f99c012c83676377ecd2e572c949f74.gz\n"
+            "9e/\n"
+            "9e/9e947f00ecd6acb2244da40f405c870e.gz\n",
+            .level = storageInfoLevelType);
+
+        map = bufDup(destination);
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapNewRead(ioBufferReadNewOpen(map), 3, 8), 3, 8),
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 0}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 3}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 6}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 10}\n"
+            "  super block {max: 3, size: 10}\n"
+            "    block {no: 0, offset: 9}\n",
+            "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("diff/incr backup with block store");
+
+        // Disable path feature to write blocks the same way as object stores
+        ((Storage *)storageRepoWrite())->pub.interface.feature ^= 1 << storageFeaturePath;
+
+        source = BUFSTRZ("ABCXYYABC12");
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(write),
+                blockIncrNewP(
+                    3, 3, 8, 1, 0, 0, map, compressFilterP(compressTypeGz, 1, .raw = true), NULL, .store = true,
+                    .compressType = compressTypeGz)),
+            "block incr");
+        TEST_RESULT_VOID(ioWriteOpen(write), "open");
+        TEST_RESULT_VOID(ioWrite(write, source), "write");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+
+        ((Storage *)storageRepoWrite())->pub.interface.feature |= 1 << storageFeaturePath;
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "26/\n"
+            "26/26251b11a5c02cb9933c068887eb6b65.gz\n"
+            "3f/\n"
+            "3f/3f99c012c83676377ecd2e572c949f74.gz\n"
+            "40/\n"
+            "40/403233144fe18bf49cb843d0dc8ba925.gz\n"
+            "9e/\n"
+            "9e/9e947f00ecd6acb2244da40f405c870e.gz\n",
+            .level = storageInfoLevelType);
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapNewRead(ioBufferReadNewOpen(destination), 3, 8), 3, 8),
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 0}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 3}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 11}\n"
+            "    block {no: 0, offset: 6}\n"
+            "read {reference: 4294967295, bundleId: 0, offset: 0, size: 10}\n"
+            "  super block {max: 3, size: 10}\n"
+            "    block {no: 0, offset: 9}\n",
+            "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("prior map not in block store is not used");
+
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNewP(3, 3, 8, 1, 0, 0, map, NULL, NULL)), "block incr");
+        TEST_RESULT_VOID(ioWriteOpen(write), "open");
+        TEST_RESULT_VOID(ioWrite(write, source), "write");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+
+        TEST_ASSIGN(mapSize, pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE)), "map size");
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(
+                blockMapNewRead(
+                    ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3,
+                    8),
+                3, 8),
+            "read {reference: 1, bundleId: 0, offset: 0, size: 11}\n"
+            "  super block {max: 3, size: 3}\n"
+            "    block {no: 0, offset: 0}\n"
+            "  super block {max: 3, size: 3}\n"
+            "    block {no: 0, offset: 3}\n"
+            "  super block {max: 3, size: 3}\n"
+            "    block {no: 0, offset: 6}\n"
+            "  super block {max: 2, size: 2}\n"
+            "    block {no: 0, offset: 9}\n",
+            "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block store names");
+
+        unsigned char checksum[XX_HASH_SIZE_MAX];
+        CompressType compressType;
+
+        TEST_RESULT_BOOL(
+            backupBlockStoreName(STRDEF("26/26251b11a5c02cb9933c068887eb6b65.gz"), checksum, &compressType), true, "block");
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, BUF(checksum, sizeof(checksum))), "26251b11a5c02cb9933c068887eb6b65", "checksum");
+        TEST_RESULT_UINT(compressType, compressTypeGz, "compress type");
+        TEST_RESULT_BOOL(backupBlockStoreName(STRDEF("26251b11a5c02cb9933c068887eb6b65"), checksum, &compressType), true, "block");
+        TEST_RESULT_UINT(compressType, compressTypeNone, "compress type");
+        TEST_RESULT_BOOL(
+            backupBlockStoreName(STRDEF("26251b11a5c02cb9933c068887eb6b65.gz.0011." PROJECT_BIN ".tmp"), checksum, &compressType),
+            false, "temp file");
+        TEST_RESULT_BOOL(
+            backupBlockStoreName(STRDEF("26251b11a5c02cb9933c068887eb6b6X.gz"), checksum, &compressType), false, "invalid hex");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("find and add blocks in the block store cache");
+
+        const unsigned char checksumFind[XX_HASH_SIZE_MAX] =
+            {0x26, 0x25, 0x1b, 0x11, 0xa5, 0xc0, 0x2c, 0xb9, 0x93, 0x3c, 0x06, 0x88, 0x87, 0xeb, 0x6b, 0x65};
+        const unsigned char checksumAdd[XX_HASH_SIZE_MAX] = {0x26, 0x01};
+
+        TEST_RESULT_VOID(storageHelperFree(), "free storage and cache");
+        storageHelperDryRunInit(false);
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_PATH_BLOCK, .recurse = true);
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), "block/26/26251b11a5c02cb9933c068887eb6b65.gz", "BLOCKDATA11");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), "block/26/26251b11a5c02cb9933c068887eb6b65.gz.0011." PROJECT_BIN ".tmp", "X");
+
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumFind, compressTypeGz), 11, "find block");
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumFind, compressTypeNone), 0, "block with other compress type");
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumAdd, compressTypeGz), 0, "missing block");
+        TEST_RESULT_VOID(backupBlockStoreAdd(storageRepo(), checksumAdd, compressTypeGz, 99), "add block");
+        TEST_RESULT_VOID(backupBlockStoreAdd(storageRepo(), checksumAdd, compressTypeGz, 99), "add block again");
+        TEST_RESULT_UINT(lstSize(backupBlockStoreLocal.pathList[0x26]), 2, "blocks in cache");
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumAdd, compressTypeGz), 99, "find added block");
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_PATH_BLOCK, .recurse = true);
+
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumFind, compressTypeGz), 11, "find block in cache");
+
+        TEST_RESULT_VOID(storageHelperFree(), "free storage");
+        storageHelperDryRunInit(false);
+
+        TEST_RESULT_PTR(backupBlockStoreLocal.memContext, NULL, "cache freed");
+        TEST_RESULT_UINT(backupBlockStoreFind(storageRepo(), checksumFind, compressTypeGz), 0, "block missing");
+        TEST_RESULT_UINT(backupBlockStoreFind(storageTest, checksumFind, compressTypeGz), 0, "block missing in other storage");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block store locks");
+
+        TEST_RESULT_PTR(backupBlockStoreLockFind(storageRepo(), STRDEF("test1"), false, false), NULL, "no lock path");
+
+        TEST_RESULT_BOOL(lockAcquireP(STRDEF("test1-backup.lock")), true, "acquire test1 command lock");
+        TEST_RESULT_BOOL(lockAcquireP(STRDEF("other-backup.lock")), true, "acquire other command lock");
+
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("test1"), false), "write backup lock");
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("other"), true), "write expire lock");
+        TEST_RESULT_PTR(
+            backupBlockStoreLockFind(storageRepo(), STRDEF("test1"), false, false), NULL, "current stanza lock ignored");
+        TEST_RESULT_STR_Z(
+            backupBlockStoreLockFind(storageRepo(), STRDEF("test1"), true, false), "other", "expire lock in other stanza");
+        TEST_RESULT_STR_Z(
+            backupBlockStoreLockFind(storageRepo(), STRDEF("other"), false, false), "test1", "backup lock in other stanza");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block store locks that cannot be checked are held");
+
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_PATH_BLOCK "/lock/test1.backup");
+        TEST_RESULT_STR_Z(backupBlockStoreLockFind(storageRepo(), STRDEF("other"), false, false), "test1", "empty lock");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_PATH_BLOCK "/lock/test1.backup", "{\"execId\":\"2-test\",\"host\":\"bogus\"}");
+        TEST_RESULT_STR_Z(backupBlockStoreLockFind(storageRepo(), STRDEF("other"), false, false), "test1", "lock on other host");
+
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("test1"), false), "write backup lock");
+        THROW_ON_SYS_ERROR(truncate(HRN_PATH "/lock/test1-backup.lock", 0) == -1, FileWriteError, "unable to truncate");
+        TEST_RESULT_STR_Z(
+            backupBlockStoreLockFind(storageRepo(), STRDEF("other"), false, false), "test1", "command lock is invalid");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stale block store locks");
+
+        TEST_RESULT_BOOL(lockReleaseP(), true, "release command locks");
+
+        TEST_RESULT_PTR(backupBlockStoreLockFind(storageRepo(), STRDEF("other"), false, false), NULL, "command lock is missing");
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_BLOCK "/lock/test1.backup", .comment = "stale lock not removed");
+
+        TEST_RESULT_PTR(
+            backupBlockStoreLockFind(storageRepoWrite(), STRDEF("other"), false, true), NULL, "remove stale lock");
+        TEST_RESULT_LOG("P00   WARN: remove stale block store backup lock for stanza test1");
+        TEST_STORAGE_LIST(storageRepo(), STORAGE_PATH_BLOCK "/lock", "other.expire\n");
+
+        HRN_STORAGE_PUT_EMPTY(storagePosixNewP(HRN_PATH_STR, .write = true), "lock/other-backup.lock");
+        TEST_RESULT_PTR(
+            backupBlockStoreLockFind(storageRepoWrite(), STRDEF("test1"), true, true), NULL, "command lock is unlocked");
+        TEST_RESULT_LOG("P00   WARN: remove stale block store expire lock for stanza other");
+
+        TEST_RESULT_BOOL(lockAcquireP(STRDEF("test1-backup.lock")), true, "acquire test1 command lock");
+        cfgOptionSet(cfgOptExecId, cfgSourceParam, VARSTRDEF("2-test"));
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("test1"), false), "write backup lock");
+        cfgOptionSet(cfgOptExecId, cfgSourceParam, VARSTRDEF("1-test"));
+        TEST_RESULT_PTR(
+            backupBlockStoreLockFind(storageRepoWrite(), STRDEF("other"), false, true), NULL, "command lock held by other exec-id");
+        TEST_RESULT_LOG("P00   WARN: remove stale block store backup lock for stanza test1");
+        TEST_RESULT_BOOL(lockReleaseP(), true, "release command lock");
+
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("test1"), false), "write backup lock");
+        TEST_RESULT_VOID(backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("other"), true), "write expire lock");
+        TEST_RESULT_VOID(backupBlockStoreLockRemove(storageRepoWrite(), STRDEF("test1"), false), "remove backup lock");
+        TEST_RESULT_VOID(backupBlockStoreLockRemove(storageRepoWrite(), STRDEF("other"), true), "remove expire lock");
+        TEST_STORAGE_LIST(storageRepo(), STORAGE_PATH_BLOCK, "lock/\n", .level = storageInfoLevelType);
     }
 
     // *****************************************************************************************************************************
@@ -1600,6 +2028,30 @@ testRun(void)
                 backupInit(infoBackupNew(PG_VERSION_94, HRN_PG_SYSTEMID_94, hrnPgCatalogVersion(PG_VERSION_94), NULL))->dbPrimary),
             "backup init");
         TEST_RESULT_BOOL(cfgOptionBool(cfgOptChecksumPage), false, "check checksum-page");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("build cache is not used when the primary is remote");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptPgHost, "pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawBool(argList, cfgOptBackupBuildCache, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_PTR(backupBuildCacheLoad(0), NULL, "no build cache");
+        TEST_RESULT_LOG(
+            "P00   WARN: option backup-build-cache is enabled but the primary is remote - all paths will be listed");
+
+        // Load a config with a local primary so the next test does not start a remote
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
     }
 
     // *****************************************************************************************************************************
@@ -1670,7 +2122,7 @@ testRun(void)
 
         HRN_STORAGE_PATH_CREATE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191003-105320F");
 
-        TEST_RESULT_PTR(backupResumeFind((Manifest *)1, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind((Manifest *)1, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed: partially deleted by prior resume or invalid");
@@ -1684,7 +2136,7 @@ testRun(void)
 
         HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT);
 
-        TEST_RESULT_PTR(backupResumeFind((Manifest *)1, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind((Manifest *)1, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG("P00   INFO: backup '20191003-105320F' cannot be resumed: resume is disabled");
 
@@ -1707,7 +2159,7 @@ testRun(void)
 
         HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, "X");
 
-        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed: unable to read"
@@ -1738,7 +2190,7 @@ testRun(void)
                 storageNewWriteP(
                     storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
 
-        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed:"
@@ -1760,7 +2212,7 @@ testRun(void)
                 storageNewWriteP(
                     storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
 
-        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed:"
@@ -1782,7 +2234,7 @@ testRun(void)
                 storageNewWriteP(
                     storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
 
-        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed:"
@@ -1803,7 +2255,7 @@ testRun(void)
                 storageNewWriteP(
                     storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
 
-        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherTypeNone, NULL), NULL, "find resumable backup");
 
         TEST_RESULT_LOG(
             "P00   WARN: backup '20191003-105320F' cannot be resumed:"
@@ -1830,7 +2282,7 @@ testRun(void)
 
         TEST_ERROR(
             backupJobResult(
-                (Manifest *)1, NULL, storageTest, strLstNew(), job, false, pgPageSize8, 0, NULL, &currentPercentComplete),
+                (Manifest *)1, NULL, storageTest, strLstNew(), NULL, job, false, pgPageSize8, 0, NULL, &currentPercentComplete),
             AssertError, "error message");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1865,7 +2317,7 @@ testRun(void)
 
         TEST_RESULT_VOID(
             backupJobResult(
-                manifest, STRDEF("host"), storageTest, strLstNew(), job, false, pgPageSize8, 0, &sizeProgress,
+                manifest, STRDEF("host"), storageTest, strLstNew(), NULL, job, false, pgPageSize8, 0, &sizeProgress,
                 &currentPercentComplete),
             "log noop result");
         TEST_RESULT_VOID(cmdLockReleaseP(), "release backup lock");
@@ -2168,7 +2620,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL,
+                NULL);
             ManifestData *manifestResumeData = (ManifestData *)manifestData(manifestResume);
 
             manifestResumeData->backupType = backupTypeFull;
@@ -2247,7 +2700,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL,
+                NULL);
             ManifestData *manifestResumeData = (ManifestData *)manifestData(manifestResume);
 
             manifestResumeData->backupType = backupTypeFull;
@@ -2405,7 +2859,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL,
+                NULL);
             ManifestData *manifestResumeData = (ManifestData *)manifestData(manifestResume);
 
             manifestResumeData->backupOptionCompressType = compressTypeGz;
@@ -2821,28 +3276,176 @@ testRun(void)
         }
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_TITLE("online 11 full backup with tablespaces and page checksums");
+        TEST_TITLE("online 9.6 backup-standby incr backup with block store");
 
-        backupTimeStart = BACKUP_EPOCH + 2200000;
+        backupTimeStart = BACKUP_EPOCH + 1800000;
 
         {
-            // Update pg_control
-            HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_11, .pageChecksumVersion = 1, .walSegmentSize = 1024 * 1024);
-
-            // Update version
-            HRN_STORAGE_PUT_Z(storagePgWrite(), PG_FILE_PGVERSION, PG_VERSION_11_Z, .timeModified = backupTimeStart);
-
-            // Update wal path
-            HRN_STORAGE_PATH_REMOVE(storagePgWrite(), strZ(pgWalPath(PG_VERSION_95)));
-            HRN_STORAGE_PATH_CREATE(storagePgWrite(), strZ(pgWalPath(PG_VERSION_11)), .noParentCreate = true);
-
-            // Upgrade stanza
+            // Load options
             StringList *argList = strLstNew();
             hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
             hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
-            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
-            hrnCfgArgRawBool(argList, cfgOptOnline, false);
-            HRN_CFG_LOAD(cfgCmdStanzaUpgrade, argList);
+            hrnCfgArgKeyRaw(argList, cfgOptPgPath, 1, pg1Path);
+            hrnCfgArgKeyRaw(argList, cfgOptPgPath, 2, pg2Path);
+            hrnCfgArgKeyRawZ(argList, cfgOptPgPort, 2, "5433");
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockStore, true);
+            hrnCfgArgRawBool(argList, cfgOptCompress, false);
+            hrnCfgArgRawBool(argList, cfgOptBackupStandby, true);
+            hrnCfgArgRawBool(argList, cfgOptStartFast, true);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Change a block in each file. All blocks are written to the block store since the prior block maps reference backups
+            // but identical blocks are only stored once.
+            Buffer *relation = bufNew(pgPageSize8 * 4);
+            memset(bufPtr(relation), 0, bufSize(relation));
+            bufUsedSet(relation, bufSize(relation));
+            bufPtr(relation)[pgPageSize8] = 1;
+
+            HRN_STORAGE_PUT(storagePgIdxWrite(1), PG_PATH_BASE "/1/3", relation);
+            HRN_STORAGE_PUT(storagePgIdxWrite(1), PG_PATH_BASE "/1/4", relation);
+
+            // Set log level to warn because the following test uses multiple processes so the log order will not be deterministic
+            harnessLogLevelSet(logLevelWarn);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_96, backupTimeStart, .backupStandby = true, .startFast = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            // Set log level back to detail
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191020-193320F_20191023-030640I}\n"
+                "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                "bundle/2/pg_data/base/1/3 {s=32768, so=40960, m=s:{4 blocks}, ts=-200000}\n"
+                "bundle/2/pg_data/base/1/4 {s=32768, so=40960, m=s:{4 blocks}, ts=-200000}\n"
+                "pg_data/backup_label {s=17, ts=+2}\n"
+                "20191020-193320F/bundle/1/pg_data/PG_VERSION {s=3, ts=-600000}\n"
+                "20191020-193320F/bundle/1/pg_data/postgresql.conf {s=11, ts=-1800000}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            TEST_STORAGE_LIST(
+                storageRepo(), STORAGE_PATH_BLOCK,
+                "6c/\n"
+                "6c/6c8a36bd5451c725620797930ab0991a\n"
+                "94/\n"
+                "94/94e751b4db4fef9c134b2c29ea2d198c\n"
+                "lock/\n",
+                .level = storageInfoLevelType);
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 9.6 backup-standby incr backup with block store and prior block store map");
+
+        backupTimeStart = BACKUP_EPOCH + 1900000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgKeyRaw(argList, cfgOptPgPath, 1, pg1Path);
+            hrnCfgArgKeyRaw(argList, cfgOptPgPath, 2, pg2Path);
+            hrnCfgArgKeyRawZ(argList, cfgOptPgPort, 2, "5433");
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockStore, true);
+            hrnCfgArgRawBool(argList, cfgOptCompress, false);
+            hrnCfgArgRawBool(argList, cfgOptBackupStandby, true);
+            hrnCfgArgRawBool(argList, cfgOptStartFast, true);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Change another block in one file so only the changed block is stored
+            Buffer *relation = bufNew(pgPageSize8 * 4);
+            memset(bufPtr(relation), 0, bufSize(relation));
+            bufUsedSet(relation, bufSize(relation));
+            bufPtr(relation)[pgPageSize8] = 1;
+            bufPtr(relation)[pgPageSize8 * 3] = 2;
+
+            HRN_STORAGE_PUT(storagePgIdxWrite(1), PG_PATH_BASE "/1/3", relation);
+
+            // Set log level to warn because the following test uses multiple processes so the log order will not be deterministic
+            harnessLogLevelSet(logLevelWarn);
+
+            // Run backup but error on archive check. The block store lock is removed when the backup fails.
+            hrnBackupPqScriptP(PG_VERSION_96, backupTimeStart, .noWal = true, .backupStandby = true, .startFast = true);
+            TEST_ERROR(
+                hrnCmdBackup(), ArchiveTimeoutError,
+                "WAL segment 0000000105DB14A000000000 was not archived before the 100ms timeout\n"
+                "HINT: check the archive_command to ensure that all options are correct (especially --stanza).\n"
+                "HINT: check the PostgreSQL server log for errors.\n"
+                "HINT: run the 'start' command if the stanza was previously stopped.");
+            TEST_STORAGE_LIST_EMPTY(storageRepo(), STORAGE_PATH_BLOCK "/lock");
+
+            // Remove halted backup so there's no resume
+            HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191020-193320F_20191024-065320I", .recurse = true);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_96, backupTimeStart, .backupStandby = true, .startFast = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            // Set log level back to detail
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191020-193320F_20191024-065320I}\n"
+                "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                "bundle/2/pg_data/base/1/3 {s=32768, so=40960, m=s:{4 blocks}, ts=-300000}\n"
+                "pg_data/backup_label {s=17, ts=+2}\n"
+                "20191020-193320F/bundle/1/pg_data/PG_VERSION {s=3, ts=-700000}\n"
+                "20191020-193320F_20191023-030640I/bundle/2/pg_data/base/1/4 {s=32768, so=40960, m=s:{4 blocks}, ts=-300000}\n"
+                "20191020-193320F/bundle/1/pg_data/postgresql.conf {s=11, ts=-1900000}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            TEST_STORAGE_LIST(
+                storageRepo(), STORAGE_PATH_BLOCK,
+                "65/\n"
+                "65/658814c615e20b416e2a38ec159ab04c\n"
+                "6c/\n"
+                "6c/6c8a36bd5451c725620797930ab0991a\n"
+                "94/\n"
+                "94/94e751b4db4fef9c134b2c29ea2d198c\n"
+                "lock/\n",
+                .level = storageInfoLevelType);
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 full backup with tablespaces and page checksums");
+
+        backupTimeStart = BACKUP_EPOCH + 2200000;
+
+        {
+            // Update pg_control
+            HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_11, .pageChecksumVersion = 1, .walSegmentSize = 1024 * 1024);
+
+            // Update version
+            HRN_STORAGE_PUT_Z(storagePgWrite(), PG_FILE_PGVERSION, PG_VERSION_11_Z, .timeModified = backupTimeStart);
+
+            // Update wal path
+            HRN_STORAGE_PATH_REMOVE(storagePgWrite(), strZ(pgWalPath(PG_VERSION_95)));
+            HRN_STORAGE_PATH_CREATE(storagePgWrite(), strZ(pgWalPath(PG_VERSION_11)), .noParentCreate = true);
+
+            // Upgrade stanza
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawBool(argList, cfgOptOnline, false);
+            HRN_CFG_LOAD(cfgCmdStanzaUpgrade, argList);
 
             cmdStanzaUpgrade();
             TEST_RESULT_LOG("P00   INFO: stanza-upgrade for stanza 'test1' on repo1");
@@ -3264,11 +3867,16 @@ testRun(void)
             hrnCfgArgRawStrId(argList, cfgOptType, backupTypeDiff);
             hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
             hrnCfgArgRawBool(argList, cfgOptDelta, true);
+            hrnCfgArgRawBool(argList, cfgOptBackupBuildCache, true);
+            hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Zero-length file to be stored
             HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "zero", .timeModified = backupTimeStart);
 
+            // Invalid build cache
+            HRN_STORAGE_PUT_EMPTY(storageTest, "spool/backup/test1/build.cache");
+
             // Run backup
             hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
             TEST_RESULT_VOID(hrnCmdBackup(), "backup");
@@ -3279,6 +3887,7 @@ testRun(void)
                 "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
                 "P00   INFO: backup start archive = 0000000105DBBF8000000000, lsn = 5dbbf80/0\n"
                 "P00   INFO: check archive for segment 0000000105DBBF8000000000\n"
+                "P00   WARN: unable to load build cache, all paths will be listed: unexpected EOF\n"
                 "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/zero\n"
                 "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/0, 8KB, [PCT]) checksum [SHA1]\n"
                 "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/PG_VERSION (2B, [PCT]) checksum [SHA1]\n"
@@ -3340,8 +3949,13 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "b=" STRINGIFY(BLOCK_MAX_SIZE) "b");
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
+            hrnCfgArgRawBool(argList, cfgOptBackupBuildCache, true);
+            hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
+            // Missing build cache
+            HRN_STORAGE_REMOVE(storageTest, "spool/backup/test1/build.cache");
+
             // File that uses block incr and will grow
             Buffer *file = bufNew(BLOCK_MIN_SIZE * 3);
             memset(bufPtr(file), 0, bufSize(file));
@@ -3563,6 +4177,7 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeSuper, "1MiB");
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Grow file size to check block incr delta. This is large enough that it would get a new block size if it were a new
@@ -3678,6 +4293,370 @@ testRun(void)
             HRN_STORAGE_REMOVE(storagePgWrite(), "truncate-to-zero");
         }
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 full backup with block incr split");
+
+        backupTimeStart = BACKUP_EPOCH + 3100000;
+
+        {
+            // Update pg_control to enable page checksums
+            HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_11, .pageChecksumVersion = 1, .walSegmentSize = 2 * 1024 * 1024);
+
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Zeroed buffers used to create files
+            Buffer *const fileRange = bufNew(1024 * 1024);
+            memset(bufPtr(fileRange), 0, bufSize(fileRange));
+            bufUsedSet(fileRange, bufSize(fileRange));
+
+            Buffer *const fileShort = bufNew(1024 * 1024 * 3 / 2);
+            memset(bufPtr(fileShort), 0, bufSize(fileShort));
+            bufUsedSet(fileShort, bufSize(fileShort));
+
+            Buffer *const fileExact = bufNew(1024 * 1024 * 3);
+            memset(bufPtr(fileExact), 0, bufSize(fileExact));
+            bufUsedSet(fileExact, bufSize(fileExact));
+
+            Buffer *const file = bufNew(1024 * 1024 * 5 / 2);
+            memset(bufPtr(file), 0, bufSize(file));
+            bufUsedSet(file, bufSize(file));
+
+            // Relation that is split into three ranges with page checksums validated during the merge
+            HRN_STORAGE_PUT(storagePgWrite(), PG_PATH_BASE "/1/2", file, .timeModified = backupTimeStart);
+
+            // File that is split into ranges of exactly the split size
+            HRN_STORAGE_PUT(storagePgWrite(), "split-exact", fileExact, .timeModified = backupTimeStart);
+
+            // File that is not split because it is not larger than the split size and file that is split even though it is small
+            // enough to be bundled
+            HRN_STORAGE_PUT(storagePgWrite(), "split-none", fileRange, .timeModified = backupTimeStart);
+            HRN_STORAGE_PUT(storagePgWrite(), "split-bundle", fileShort, .timeModified = backupTimeStart - 400000);
+
+            // Files that change size during the backup
+            HRN_STORAGE_PUT(storagePgWrite(), "split-short", file, .timeModified = backupTimeStart);
+            HRN_STORAGE_PUT(storagePgWrite(), "split-range", file, .timeModified = backupTimeStart);
+            HRN_STORAGE_PUT(storagePgWrite(), "split-zero", file, .timeModified = backupTimeStart);
+            HRN_STORAGE_PUT(storagePgWrite(), "split-remove", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            HRN_BACKUP_SCRIPT_SET(
+                {.op = hrnBackupScriptOpUpdate, .file = storagePathP(storagePg(), STRDEF("split-short")),
+                 .time = backupTimeStart + 1, .content = fileShort},
+                {.op = hrnBackupScriptOpUpdate, .file = storagePathP(storagePg(), STRDEF("split-range")),
+                 .time = backupTimeStart + 1, .content = fileRange},
+                {.op = hrnBackupScriptOpUpdate, .file = storagePathP(storagePg(), STRDEF("split-zero")),
+                 .time = backupTimeStart + 1},
+                {.op = hrnBackupScriptOpRemove, .file = storagePathP(storagePg(), STRDEF("split-remove"))});
+            hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
+
+            // Ranges are copied in parallel so only log info to get deterministic output
+            harnessLogLevelSet(logLevelInfo);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_LOG(
+                "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC399000000000, lsn = 5dc3990/0\n"
+                "P00   INFO: check archive for segment 0000000105DC399000000000\n"
+                "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC399000000001, lsn = 5dc3990/300000\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC399000000000:0000000105DC399000000001\n"
+                "P00   INFO: new backup label = 20191107-041320F\n"
+                "P00   INFO: full backup size = [SIZE], file total = 10");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191107-041320F}\n"
+                "bundle/21/pg_data/PG_VERSION {s=2, ts=-300000}\n"
+                "bundle/21/pg_data/global/pg_control {s=8192}\n"
+                "bundle/21/pg_data/split-none {s=1048576}\n"
+                "pg_data/backup_label.gz {s=17, ts=+2}\n"
+                "pg_data/base/1/2.pgbi {s=2621440, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7}, ckp=t}\n"
+                "pg_data/split-bundle.pgbi {s=1572864, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7},"
+                " ts=-400000}\n"
+                "pg_data/split-exact.pgbi {s=3145728, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15}}\n"
+                "pg_data/split-range.pgbi {s=1048576, so=2621440, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15}}\n"
+                "pg_data/split-short.pgbi {s=1572864, so=2621440, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7}}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 diff backup with block incr split");
+
+        backupTimeStart = BACKUP_EPOCH + 3120000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeDiff);
+            hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "3MiB");
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // File that is split into two ranges that are compared to the prior map
+            Buffer *const file = bufNew(1024 * 1024 * 7 / 2);
+            memset(bufPtr(file), 0, bufSize(file));
+            bufUsedSet(file, bufSize(file));
+
+            HRN_STORAGE_PUT(storagePgWrite(), "split-exact", file, .timeModified = backupTimeStart);
+
+            // File that is not split because it is smaller than the split size
+            bufUsedSet(file, 1024 * 1024 * 5 / 2);
+
+            HRN_STORAGE_PUT(storagePgWrite(), "split-small", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
+
+            // Ranges are copied in parallel so only log info to get deterministic output
+            harnessLogLevelSet(logLevelInfo);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191107-041320F, version = 2.53dev\n"
+                "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC3E8000000000, lsn = 5dc3e80/0\n"
+                "P00   INFO: check archive for segment 0000000105DC3E8000000000\n"
+                "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC3E8000000001, lsn = 5dc3e80/300000\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC3E8000000000:0000000105DC3E8000000001\n"
+                "P00   INFO: new backup label = 20191107-041320F_20191107-094640D\n"
+                "P00   INFO: diff backup size = [SIZE], file total = 11");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191107-041320F_20191107-094640D}\n"
+                "bundle/3/pg_data/global/pg_control {s=8192}\n"
+                "pg_data/backup_label.gz {s=17, ts=+2}\n"
+                "pg_data/split-exact.pgbi {s=3670016, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},1:{0,1,2,3},1:{0,1,2,3}}\n"
+                "pg_data/split-small.pgbi {s=2621440, m=1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3},"
+                "1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3},1:{0,1,2,3}}\n"
+                "20191107-041320F/bundle/21/pg_data/PG_VERSION {s=2, ts=-320000}\n"
+                "20191107-041320F/pg_data/base/1/2.pgbi {s=2621440, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7}, ts=-20000, ckp=t}\n"
+                "20191107-041320F/pg_data/split-bundle.pgbi {s=1572864, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7}, ts=-420000}\n"
+                "20191107-041320F/bundle/21/pg_data/split-none {s=1048576, ts=-20000}\n"
+                "20191107-041320F/pg_data/split-range.pgbi {s=1048576, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15}, ts=-19999}\n"
+                "20191107-041320F/pg_data/split-short.pgbi {s=1572864, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7}, ts=-19999}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            HRN_STORAGE_PATH_REMOVE(storagePgWrite(), PG_PATH_BASE, .recurse = true);
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-bundle");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-exact");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-none");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-small");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-short");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-range");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-zero");
+            HRN_PG_CONTROL_PUT(storagePgWrite(), PG_VERSION_11, .pageChecksumVersion = 0, .walSegmentSize = 2 * 1024 * 1024);
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 full backup with block store split");
+
+        backupTimeStart = BACKUP_EPOCH + 3140000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockStore, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // File that is split into three ranges. Only the first block of each range differs so the rest of the blocks are stored
+            // once.
+            Buffer *const file = bufNew(1024 * 1024 * 5 / 2);
+            memset(bufPtr(file), 0, bufSize(file));
+            bufUsedSet(file, bufSize(file));
+            bufPtr(file)[0] = 1;
+            bufPtr(file)[1024 * 1024] = 2;
+            bufPtr(file)[1024 * 1024 * 2] = 3;
+
+            HRN_STORAGE_PUT(storagePgWrite(), "split-store", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
+
+            // Ranges are copied in parallel so only log info to get deterministic output
+            harnessLogLevelSet(logLevelInfo);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_LOG(
+                "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC436000000000, lsn = 5dc4360/0\n"
+                "P00   INFO: check archive for segment 0000000105DC436000000000\n"
+                "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC436000000001, lsn = 5dc4360/300000\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC436000000000:0000000105DC436000000001\n"
+                "P00   INFO: new backup label = 20191107-152000F\n"
+                "P00   INFO: full backup size = [SIZE], file total = 4");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191107-152000F}\n"
+                "bundle/4/pg_data/PG_VERSION {s=2, ts=-340000}\n"
+                "bundle/4/pg_data/global/pg_control {s=8192}\n"
+                "pg_data/backup_label.gz {s=17, ts=+2}\n"
+                "pg_data/split-store.pgbi {s=2621440, m=s:{40 blocks}}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            TEST_STORAGE_LIST(
+                storageRepo(), STORAGE_PATH_BLOCK,
+                "10/\n"
+                "10/108add2f97f62432b93640fd20a8805f.gz\n"
+                "65/\n"
+                "65/658814c615e20b416e2a38ec159ab04c\n"
+                "6c/\n"
+                "6c/6c8a36bd5451c725620797930ab0991a\n"
+                "80/\n"
+                "80/80e8407e92eb5a8b68dd65b81afebf92.gz\n"
+                "92/\n"
+                "92/921a5fd0dd79b216254bdc07217382ef.gz\n"
+                "94/\n"
+                "94/94e751b4db4fef9c134b2c29ea2d198c\n"
+                "fd/\n"
+                "fd/fd5ee061c8433a0f33b202d302b65caa.gz\n"
+                "lock/\n",
+                .level = storageInfoLevelType);
+
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split-store");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 full backup with block incr split and enc");
+
+        backupTimeStart = BACKUP_EPOCH + 3150000;
+
+        {
+            // Create encrypted stanza
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawBool(argList, cfgOptOnline, false);
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdStanzaCreate, argList);
+
+            HRN_STORAGE_PATH_REMOVE(storageRepoIdxWrite(0), NULL, .recurse = true);
+
+            cmdStanzaCreate();
+            TEST_RESULT_LOG("P00   INFO: stanza-create for stanza 'test1' on repo1");
+
+            // Load options
+            argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // File that is split into three ranges
+            Buffer *const file = bufNew(1024 * 1024 * 5 / 2);
+            memset(bufPtr(file), 0, bufSize(file));
+            bufUsedSet(file, bufSize(file));
+
+            HRN_STORAGE_PUT(storagePgWrite(), "split", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(
+                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeNone, .cipherType = cipherTypeAes256Cbc,
+                .cipherPass = TEST_CIPHER_PASS, .walTotal = 2, .walSwitch = true);
+
+            // Ranges are copied in parallel so only log info to get deterministic output
+            harnessLogLevelSet(logLevelInfo);
+
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            harnessLogLevelSet(logLevelDetail);
+
+            TEST_RESULT_LOG(
+                "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC45D000000000, lsn = 5dc45d0/0\n"
+                "P00   INFO: check archive for segment 0000000105DC45D000000000\n"
+                "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC45D000000001, lsn = 5dc45d0/300000\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC45D000000000:0000000105DC45D000000001\n"
+                "P00   INFO: new backup label = 20191107-180640F\n"
+                "P00   INFO: full backup size = [SIZE], file total = 4");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(
+                    storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest"), .cipherType = cipherTypeAes256Cbc,
+                    .cipherPass = TEST_CIPHER_PASS),
+                ".> {d=20191107-180640F}\n"
+                "bundle/4/pg_data/PG_VERSION {s=2, ts=-350000}\n"
+                "bundle/4/pg_data/global/pg_control {s=8192}\n"
+                "pg_data/backup_label.gz {s=17, ts=+2}\n"
+                "pg_data/split.pgbi {s=2621440, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},"
+                "0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6,7}}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            HRN_STORAGE_REMOVE(storagePgWrite(), "split");
+        }
+
         // It is better to put as few tests here as possible because cmp/enc makes tests more expensive (especially with valgrind)
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("online 11 full backup with comp/enc");
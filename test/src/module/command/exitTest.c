@@ -84,6 +84,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdArchivePush, argList, .role = cfgCmdRoleAsync, .noStd = true);
 
         harnessLogLevelSet(logLevelDebug);
+        hrnLogReplaceAdd("memory statistics: \\{[a-z.\"{}:,0-9]+\\}", "\\{[a-z.\"{}:,0-9]+\\}", "STATS", false);
 
         TRY_BEGIN()
         {
@@ -105,11 +106,13 @@ testRun(void)
                 "            stack trace:\n"
                 "            ERR_STACK_TRACE\n"
                 "            --------------------------------------------------------------------\n"
+                "P00  DEBUG:     " TEST_PGB_PATH "/src/command/command::cmdEnd: memory statistics: [STATS]\n"
                 "P00   INFO: archive-push:async command end: aborted with exception [122]\n"
                 "P00  DEBUG:     " TEST_PGB_PATH "/src/command/exit::exitSafe: => 122");
         }
         TRY_END();
 
+        hrnLogReplaceClear();
         harnessLogLevelReset();
 
         // -------------------------------------------------------------------------------------------------------------------------
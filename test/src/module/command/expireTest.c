@@ -3,8 +3,10 @@ Test Expire Command
 ***********************************************************************************************************************************/
 #include <unistd.h>
 
+#include "command/backup/blockMap.h"
 #include "command/backup/common.h"
 #include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
 #include "storage/posix/storage.h"
 
 #include "common/harnessConfig.h"
@@ -62,6 +64,42 @@ archiveExpectList(const unsigned int start, unsigned int end, const char *majorW
     return strZ(result);
 }
 
+/***********************************************************************************************************************************
+Write a block map with one block for each character in the block list and return the map size. When the map references the block
+store the blocks are also written to the block store.
+***********************************************************************************************************************************/
+static uint64_t
+blockMapPut(const Storage *const storage, const char *const file, const unsigned int reference, const char *const blockList)
+{
+    BlockMap *const blockMap = blockMapNew();
+
+    for (const char *block = blockList; *block != '\0'; block++)
+    {
+        const BlockMapItem blockMapItem =
+        {
+            .reference = reference,
+            .superBlockSize = 8192,
+            .size = 1,
+            .checksum = {(unsigned char)*block},
+        };
+
+        blockMapAdd(blockMap, &blockMapItem);
+
+        if (reference == BLOCK_MAP_REFERENCE_STORE)
+            HRN_STORAGE_PUT_Z(storage, strZ(backupBlockStorePath(blockMapItem.checksum, compressTypeNone)), "X");
+    }
+
+    Buffer *const buffer = bufNew(0);
+    IoWrite *const write = ioBufferWriteNewOpen(buffer);
+
+    blockMapWrite(blockMap, write, 8192, 8);
+    ioWriteClose(write);
+
+    HRN_STORAGE_PUT(storage, file, buffer);
+
+    return bufUsed(buffer);
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -2552,5 +2590,305 @@ testRun(void)
         harnessLogLevelReset();
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("removeExpiredBlock()"))
+    {
+        // Manifest with block incremental files
+        #define TEST_MANIFEST_BLOCK(backupType, file)                                                                              \
+            "[backup]\n"                                                                                                           \
+            "backup-label=null\n"                                                                                                  \
+            "backup-timestamp-copy-start=0\n"                                                                                      \
+            "backup-timestamp-start=0\n"                                                                                           \
+            "backup-timestamp-stop=0\n"                                                                                            \
+            "backup-type=\"" backupType "\"\n"                                                                                    \
+            "\n"                                                                                                                   \
+            "[backup:db]\n"                                                                                                        \
+            "db-catalog-version=201909212\n"                                                                                       \
+            "db-control-version=1201\n"                                                                                            \
+            "db-id=2\n"                                                                                                            \
+            "db-system-id=6626363367545678089\n"                                                                                   \
+            "db-version=\"12\"\n"                                                                                                  \
+            "\n"                                                                                                                   \
+            "[backup:option]\n"                                                                                                    \
+            "option-archive-check=false\n"                                                                                         \
+            "option-archive-copy=false\n"                                                                                          \
+            "option-checksum-page=false\n"                                                                                         \
+            "option-compress=false\n"                                                                                              \
+            "option-compress-type=\"none\"\n"                                                                                      \
+            "option-hardlink=false\n"                                                                                              \
+            "option-online=false\n"                                                                                                \
+            "\n"                                                                                                                   \
+            "[backup:target]\n"                                                                                                    \
+            "pg_data={\"path\":\"" TEST_PATH "/pg\",\"type\":\"path\"}\n"                                                        \
+            "\n"                                                                                                                   \
+            "[target:file]\n"                                                                                                      \
+            "pg_data/PG_VERSION={\"size\":3,\"timestamp\":1565282100}\n"                                                          \
+            file                                                                                                                   \
+            "\n"                                                                                                                   \
+            "[target:file:default]\n"                                                                                              \
+            "group=\"postgres\"\n"                                                                                                 \
+            "mode=\"0600\"\n"                                                                                                      \
+            "user=\"postgres\"\n"                                                                                                  \
+            "\n"                                                                                                                   \
+            "[target:path]\n"                                                                                                      \
+            "pg_data={}\n"                                                                                                         \
+            "\n"                                                                                                                   \
+            "[target:path:default]\n"                                                                                              \
+            "group=\"postgres\"\n"                                                                                                 \
+            "mode=\"0700\"\n"                                                                                                      \
+            "user=\"postgres\"\n"
+
+        StringList *argList = strLstDup(argListAvoidWarn);
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("keep blocks referenced by the current stanza");
+
+        HRN_INFO_PUT(storageRepoWrite(), INFO_BACKUP_PATH_FILE, TEST_BACKUP_CURRENT TEST_BACKUP_DB);
+        HRN_INFO_PUT(
+            storageRepoWrite(), INFO_ARCHIVE_PATH_FILE,
+            "[db]\n"
+            "db-id=2\n"
+            "db-system-id=6626363367545678089\n"
+            "db-version=\"12\"\n"
+            "\n"
+            "[db:history]\n"
+            "1={\"db-id\":6625592122879095702,\"db-version\":\"9.4\"}\n"
+            "2={\"db-id\":6626363367545678089,\"db-version\":\"12\"}");
+        archiveGenerate(storageRepoWrite(), STORAGE_REPO_ARCHIVE, 2, 7, "12-2", "0000000100000000");
+
+        // Full backup with a file in the block store, a file not in the block store, and a file that is not block incremental
+        uint64_t mapSizeStore = blockMapPut(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152850F/pg_data/base/1/1.pgbi", BLOCK_MAP_REFERENCE_STORE, "ab");
+        uint64_t mapSize = blockMapPut(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152850F/pg_data/base/1/2.pgbi", 0, "c");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152850F/" BACKUP_MANIFEST_FILE,
+            zNewFmt(
+                TEST_MANIFEST_BLOCK(
+                    "full",
+                    "pg_data/base/1/1={\"bi\":1,\"bic\":8,\"bim\":%" PRIu64 ",\"repo-size\":%" PRIu64 ",\"size\":16384,"
+                    "\"timestamp\":1565282100}\n"
+                    "pg_data/base/1/2={\"bi\":1,\"bic\":8,\"bim\":%" PRIu64 ",\"repo-size\":%" PRIu64 ",\"size\":8192,"
+                    "\"timestamp\":1565282100}\n"),
+                mapSizeStore, mapSizeStore, mapSize, mapSize));
+
+        // Diff backup with a file referencing the full backup and a new file in the block store
+        mapSizeStore = blockMapPut(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152850F_20181119-152252D/pg_data/base/1/3.pgbi",
+            BLOCK_MAP_REFERENCE_STORE, "bd");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152850F_20181119-152252D/" BACKUP_MANIFEST_FILE,
+            zNewFmt(
+                TEST_MANIFEST_BLOCK(
+                    "diff",
+                    "pg_data/base/1/1={\"bi\":1,\"bic\":8,\"bim\":%" PRIu64 ",\"reference\":\"20181119-152850F\","
+                    "\"repo-size\":%" PRIu64 ",\"size\":16384,\"timestamp\":1565282100}\n"
+                    "pg_data/base/1/3={\"bi\":1,\"bic\":8,\"bim\":%" PRIu64 ",\"repo-size\":%" PRIu64 ",\"size\":16384,"
+                    "\"timestamp\":1565282100}\n"),
+                mapSize, mapSize, mapSizeStore, mapSizeStore));
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG("P00   INFO: repo1: 12-2 no archive to remove");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("another stanza has a backup in progress");
+
+        // Stanza sharing the block store
+        HRN_INFO_PUT(storageRepoWrite(), STORAGE_PATH_BACKUP "/other/" INFO_BACKUP_FILE, TEST_BACKUP_CURRENT TEST_BACKUP_DB);
+
+        mapSizeStore = blockMapPut(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20181119-152850F/pg_data/base/1/1.pgbi", BLOCK_MAP_REFERENCE_STORE,
+            "e");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20181119-152850F/" BACKUP_MANIFEST_FILE,
+            zNewFmt(
+                TEST_MANIFEST_BLOCK(
+                    "full",
+                    "pg_data/base/1/1={\"bi\":1,\"bic\":8,\"bim\":%" PRIu64 ",\"repo-size\":%" PRIu64 ",\"size\":8192,"
+                    "\"timestamp\":1565282100}\n"),
+                mapSizeStore, mapSizeStore));
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20181119-152850F_20181119-152252D/" BACKUP_MANIFEST_FILE,
+            TEST_MANIFEST_BLOCK("diff", ""));
+
+        // Backup in progress that has written a block
+        const unsigned char checksumInProgress[XX_HASH_SIZE_MAX] = {'f'};
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20181119-152850F_20181119-152300I/pg_data/PG_VERSION");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(backupBlockStorePath(checksumInProgress, compressTypeNone)), "X");
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip block store cleanup because backup other/20181119-152850F_20181119-152300I is in progress or"
+            " aborted\n"
+            "P00   INFO: repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "66/66000000000000000000000000000000\n"
+            "lock/\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("another stanza cannot be read");
+
+        HRN_STORAGE_PATH_REMOVE(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20181119-152850F_20181119-152300I", .recurse = true);
+        HRN_STORAGE_REMOVE(storageRepoWrite(), STORAGE_PATH_BACKUP "/other/" INFO_BACKUP_FILE);
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   WARN: repo1: skip block store cleanup because stanza other could not be read\n"
+            "            unable to load info file '" TEST_PATH "/repo/backup/other/backup.info' or '" TEST_PATH
+            "/repo/backup/other/backup.info.copy':\n"
+            "            FileMissingError: unable to open missing file '" TEST_PATH "/repo/backup/other/backup.info' for read\n"
+            "            FileMissingError: unable to open missing file '" TEST_PATH "/repo/backup/other/backup.info.copy'"
+            " for read\n"
+            "            HINT: backup.info cannot be opened and is required to perform a backup.\n"
+            "            HINT: has a stanza-create been performed?\n"
+            "P00   INFO: repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "66/66000000000000000000000000000000\n"
+            "lock/\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove unreferenced blocks (dry-run)");
+
+        HRN_INFO_PUT(storageRepoWrite(), STORAGE_PATH_BACKUP "/other/" INFO_BACKUP_FILE, TEST_BACKUP_CURRENT TEST_BACKUP_DB);
+
+        argList = strLstDup(argListAvoidWarn);
+        hrnCfgArgRawBool(argList, cfgOptDryRun, true);
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   INFO: [DRY-RUN] repo1: remove 1 unreferenced block(s) from block store\n"
+            "P00   INFO: [DRY-RUN] repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "66/66000000000000000000000000000000\n"
+            "lock/\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove unreferenced blocks via backup command");
+
+        argList = strLstDup(argListAvoidWarn);
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: remove 1 unreferenced block(s) from block store\n"
+            "P00   INFO: repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "lock/\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("another stanza has a backup lock");
+
+        HRN_CFG_LOAD(cfgCmdExpire, argListAvoidWarn);
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(backupBlockStorePath(checksumInProgress, compressTypeNone)), "X");
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_PATH_BLOCK "/lock/other.backup");
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_PATH_BLOCK "/lock/db.backup");
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip block store cleanup because a backup is running in stanza other\n"
+            "P00   INFO: repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "66/66000000000000000000000000000000\n"
+            "lock/\n"
+            "lock/db.backup\n"
+            "lock/other.backup\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove unreferenced blocks and stale backup lock");
+
+        // Lock written on this host by a backup that is no longer running
+        backupBlockStoreLockWrite(storageRepoWrite(), STRDEF("other"), false);
+
+        TEST_RESULT_VOID(cmdExpire(), "expire");
+        TEST_RESULT_LOG(
+            "P00   WARN: remove stale block store backup lock for stanza other\n"
+            "P00   INFO: repo1: remove 1 unreferenced block(s) from block store\n"
+            "P00   INFO: repo1: 12-2 no archive to remove");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_BLOCK,
+            "61/\n"
+            "61/61000000000000000000000000000000\n"
+            "62/\n"
+            "62/62000000000000000000000000000000\n"
+            "64/\n"
+            "64/64000000000000000000000000000000\n"
+            "65/\n"
+            "65/65000000000000000000000000000000\n"
+            "66/\n"
+            "lock/\n"
+            "lock/db.backup\n",
+            .level = storageInfoLevelType);
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -235,6 +235,7 @@ testRun(void)
             "                                      [default=/path/to/pgbackrest]\n"
             "  --cmd-ssh                           SSH client command [default=ssh]\n"
             "  --compress-level-network            network compression level [default=3]\n"
+            "  --compress-type-network             network compression type [default=gz]\n"
             "  --config                            pgBackRest configuration file\n"
             "                                      [default=/etc/pgbackrest/pgbackrest.conf]\n"
             "  --config-include-path               path to additional pgBackRest\n"
@@ -244,7 +245,10 @@ testRun(void)
             "                                      files [default=/etc/pgbackrest]\n"
             "  --delta                             restore or backup using checksums\n"
             "                                      [default=n]\n"
+            "  --io-cache-drop                     drop file data from the page cache after\n"
+            "                                      I/O [default=n]\n"
             "  --io-timeout                        I/O timeout [default=60]\n"
+            "  --io-uring                          use io_uring for file I/O [default=n]\n"
             "  --lock-path                         path where lock files are stored\n"
             "                                      [default=/tmp/pgbackrest]\n"
             "  --neutral-umask                     use a neutral umask [default=y]\n"
@@ -252,6 +256,8 @@ testRun(void)
             "                                      compress/transfer [default=1]\n"
             "  --protocol-timeout                  protocol timeout [default=1830]\n"
             "  --sck-keep-alive                    keep-alive enable [default=y]\n"
+            "  --ssh-mux                           share one SSH connection per host between\n"
+            "                                      processes [default=0]\n"
             "  --stanza                            defines the stanza\n"
             "  --tcp-keep-alive-count              keep-alive count\n"
             "  --tcp-keep-alive-idle               keep-alive idle time\n"
@@ -281,6 +287,7 @@ testRun(void)
             "  --repo-azure-key                    azure repository key\n"
             "  --repo-azure-key-type               azure repository key type [default=shared]\n"
             "  --repo-azure-uri-style              azure URI Style [default=host]\n"
+            "  --repo-block-split-size             block incremental split size\n"
             "  --repo-cipher-pass                  repository cipher passphrase\n"
             "                                      [current=<redacted>]\n"
             "  --repo-cipher-type                  cipher used to encrypt the repository\n"
@@ -338,8 +345,12 @@ testRun(void)
             "  --repo-storage-ca-path              repository storage CA path\n"
             "  --repo-storage-host                 repository storage host\n"
             "  --repo-storage-port                 repository storage port [default=443]\n"
+            "  --repo-storage-request-max          repository storage request maximum\n"
+            "                                      [default=1]\n"
             "  --repo-storage-tag                  repository storage tag(s)\n"
             "  --repo-storage-upload-chunk-size    repository storage upload chunk size\n"
+            "  --repo-storage-upload-max           repository storage upload maximum\n"
+            "                                      [default=1]\n"
             "  --repo-storage-verify-tls           repository storage certificate verify\n"
             "                                      [default=y]\n"
             "  --repo-type                         type of storage used for the repository\n"
@@ -220,7 +220,8 @@ testRun(void)
         IoWrite *write = ioBufferWriteNew(destination);
 
         ioFilterGroupAdd(
-            ioWriteFilterGroup(write), blockIncrNew(6, 3, 5, 0, 0, 0, NULL, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
+            ioWriteFilterGroup(write),
+            blockIncrNewP(6, 3, 5, 0, 0, 0, NULL, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
         ioWriteOpen(write);
         ioWrite(write, source);
         ioWriteClose(write);
@@ -231,7 +232,7 @@ testRun(void)
             ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3, 5);
 
         // Perform block delta
-        BlockDelta *blockDelta = blockDeltaNew(blockMap, 3, 5, NULL, cipherTypeNone, NULL, compressTypeGz);
+        BlockDelta *blockDelta = blockDeltaNewP(blockMap, 3, 5, NULL, cipherTypeNone, NULL, compressTypeGz);
         const BlockDeltaRead *blockDeltaRead = blockDeltaReadGet(blockDelta, 0);
         IoRead *read = ioBufferReadNewOpen(destination);
 
@@ -306,10 +307,25 @@ testRun(void)
         TEST_ERROR(
             restoreFile(
                 strNewFmt(STORAGE_REPO_BACKUP "/%s/%s.gz", strZ(repoFileReferenceFull), strZ(repoFile1)), repoIdx, compressTypeGz,
-                0, false, false, false, STRDEF("badpass"), NULL, fileList),
+                0, false, false, false, cipherTypeAes256Cbc, STRDEF("badpass"), NULL, fileList),
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
             " 'ffffffffffffffffffffffffffffffffffffffff'");
+
+#ifdef HAVE_COPY_FILE_RANGE
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("repo file copied directly - size mismatch");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), zNewFmt(STORAGE_REPO_BACKUP "/%s/%s", strZ(repoFileReferenceFull), strZ(repoFile1)), "acef",
+            .comment = "create a short repo file");
+
+        TEST_ERROR(
+            restoreFile(
+                strNewFmt(STORAGE_REPO_BACKUP "/%s/%s", strZ(repoFileReferenceFull), strZ(repoFile1)), repoIdx, compressTypeNone,
+                0, false, false, false, cipherTypeNone, NULL, NULL, fileList),
+            FileReadError, "error restoring 'normal': actual size 4 does not match expected size 7");
+#endif // HAVE_COPY_FILE_RANGE
     }
 
     // *****************************************************************************************************************************
@@ -2122,6 +2138,45 @@ testRun(void)
         TEST_RESULT_INT(restoreJobQueueNext(0, 1, 2), 0, "client idx 0, queue idx 1, 2 queues");
         TEST_RESULT_INT(restoreJobQueueNext(1, 0, 2), 1, "client idx 1, queue idx 0, 2 queues");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("split block incremental files into parts");
+
+        RestoreJobData jobDataSplit =
+        {
+            .splitSize = 1024 * 1024,
+            .splitList = lstNewP(sizeof(RestoreJobSplit), .comparator = lstComparatorStr),
+            .zeroExp = regExpNew(STRDEF("^pg_data/base/2/")),
+        };
+
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(&jobDataSplit, &(ManifestFile){.name = STRDEF("pg_data/base/1/1"), .size = 4 * 1024 * 1024}), false,
+            "not block incr");
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(
+                &jobDataSplit,
+                &(ManifestFile){.name = STRDEF("pg_data/base/1/1"), .size = 4 * 1024 * 1024, .blockIncrMapSize = 1, .bundleId = 1}),
+            false, "bundled");
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(
+                &jobDataSplit, &(ManifestFile){.name = STRDEF("pg_data/base/1/1"), .size = 1024 * 1024, .blockIncrMapSize = 1}),
+            false, "not larger than split size");
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(
+                &jobDataSplit, &(ManifestFile){.name = STRDEF("pg_data/base/2/1"), .size = 4 * 1024 * 1024, .blockIncrMapSize = 1}),
+            false, "zeroed");
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(
+                &jobDataSplit, &(ManifestFile){.name = STRDEF("pg_data/base/1/1"), .size = 5 * 512 * 1024, .blockIncrMapSize = 1}),
+            true, "split");
+        TEST_RESULT_UINT(((RestoreJobSplit *)lstGet(jobDataSplit.splitList, 0))->partTotal, 3, "part total");
+
+        jobDataSplit.splitSize = 0;
+
+        TEST_RESULT_BOOL(
+            restoreJobSplitAdd(
+                &jobDataSplit, &(ManifestFile){.name = STRDEF("pg_data/base/1/1"), .size = 4 * 1024 * 1024, .blockIncrMapSize = 1}),
+            false, "split disabled");
+
         // Locality error
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("incorrect locality");
@@ -2722,7 +2777,7 @@ testRun(void)
             bufUsedSet(fileBuffer, bufSize(fileBuffer));
 
             IoWrite *write = storageWriteIo(storageNewWriteP(storageRepoWrite(), STRDEF(TEST_REPO_PATH "base/1/bi-no-ref.pgbi")));
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 3, 0, 0, NULL, NULL, NULL));
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNewP(8192, 8192, 11, 3, 0, 0, NULL, NULL, NULL));
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
 
             ioWriteOpen(write);
@@ -2737,6 +2792,24 @@ testRun(void)
                 .blockIncrSize = 8192, .blockIncrChecksumSize = 11, .blockIncrMapSize = blockIncrMapSize, .timestamp = 1482182860,
                 .checksumSha1 = "953cdcc904c5d4135d96fc0833f121bf3033c74c");
 
+            // Block incremental with blocks in the block store
+            write = storageWriteIo(storageNewWriteP(storageRepoWrite(), STRDEF(TEST_REPO_PATH "base/1/bi-store.pgbi")));
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(write), blockIncrNewP(8192, 8192, 11, 3, 0, 0, NULL, NULL, NULL, .store = true));
+            ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
+
+            ioWriteOpen(write);
+            ioWrite(write, fileBuffer);
+            ioWriteClose(write);
+
+            blockIncrMapSize = pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+            repoSize = pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), SIZE_FILTER_TYPE));
+
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = TEST_PGDATA "base/1/bi-store", .size = bufUsed(fileBuffer), .sizeRepo = repoSize,
+                .blockIncrSize = 8192, .blockIncrChecksumSize = 11, .blockIncrMapSize = blockIncrMapSize, .timestamp = 1482182860,
+                .checksumSha1 = "953cdcc904c5d4135d96fc0833f121bf3033c74c");
+
             // Block incremental with a broken reference to show that unneeded references will not be used
             Buffer *fileUnused = bufNew(8192 * 6);
             memset(bufPtr(fileUnused), 1, bufSize(fileUnused));
@@ -2744,7 +2817,7 @@ testRun(void)
 
             Buffer *fileUnusedMap = bufNew(0);
             write = ioBufferWriteNew(fileUnusedMap);
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 0, 0, 0, NULL, NULL, NULL));
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNewP(8192, 8192, 11, 0, 0, 0, NULL, NULL, NULL));
 
             ioWriteOpen(write);
             ioWrite(write, fileUnused);
@@ -2762,7 +2835,7 @@ testRun(void)
             write = storageWriteIo(storageNewWriteP(storageRepoWrite(), STRDEF(TEST_REPO_PATH "base/1/bi-unused-ref.pgbi")));
             ioFilterGroupAdd(
                 ioWriteFilterGroup(write),
-                blockIncrNew(
+                blockIncrNewP(
                     8192, 8192, 11, 3, 0, 0,
                     BUF(bufPtr(fileUnusedMap) + bufUsed(fileUnusedMap) - fileUnusedMapSize, fileUnusedMapSize), NULL, NULL));
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
@@ -2866,6 +2939,8 @@ testRun(void)
             " febd680181d4cd315dce942348862c25fbd731f3\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/32768/32769 (32KB, [PCT]) checksum"
             " a40f0986acb1531ce0cc75a23dcf8aa406ae9081\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-store (bi 24KB, [PCT]) checksum"
+            " 953cdcc904c5d4135d96fc0833f121bf3033c74c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-no-ref (bi 24KB, [PCT]) checksum"
             " 953cdcc904c5d4135d96fc0833f121bf3033c74c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/16384/16385 (16KB, [PCT]) checksum"
@@ -2917,7 +2992,7 @@ testRun(void)
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1/PG_10_201707211'\n"
             "P00   INFO: restore global/pg_control (performed last to ensure aborted restores cannot be started)\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/global'\n"
-            "P00   INFO: restore size = [SIZE], file total = 23",
+            "P00   INFO: restore size = [SIZE], file total = 24",
             pgControlSha1);
 
         TEST_STORAGE_LIST(
@@ -2934,6 +3009,7 @@ testRun(void)
             "base/1/31 {s=1, t=1482182860}\n"
             "base/1/PG_VERSION {s=4, t=1482182860}\n"
             "base/1/bi-no-ref {s=24576, t=1482182860}\n"
+            "base/1/bi-store {s=24576, t=1482182860}\n"
             "base/1/bi-unused-ref {s=49152, t=1482182860}\n"
             "base/16384/\n"
             "base/16384/16385 {s=16384, t=1482182860}\n"
@@ -3060,6 +3136,8 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-unused-ref - exists and matches backup (48KB, [PCT]) checksum"
             " febd680181d4cd315dce942348862c25fbd731f3\n"
             "P01 DETAIL: restore zeroed file " TEST_PATH "/pg/base/32768/32769 (32KB, [PCT])\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-store - exists and matches backup (24KB, [PCT]) checksum"
+            " 953cdcc904c5d4135d96fc0833f121bf3033c74c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-no-ref - exists and matches backup (24KB, [PCT]) checksum"
             " 953cdcc904c5d4135d96fc0833f121bf3033c74c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/16384/16385 - exists and matches backup (16KB, [PCT])"
@@ -3111,7 +3189,7 @@ testRun(void)
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1/PG_10_201707211'\n"
             "P00   INFO: restore global/pg_control (performed last to ensure aborted restores cannot be started)\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/global'\n"
-            "P00   INFO: restore size = [SIZE], file total = 23",
+            "P00   INFO: restore size = [SIZE], file total = 24",
             pgControlSha1);
 
         // Check stanza archive spool path was removed
@@ -3236,11 +3314,12 @@ testRun(void)
         hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
         hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
         hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
         hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
         hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
-        TEST_RESULT_VOID(cmdRestore(), "restore");
+        TEST_RESULT_VOID(cmdRestore(), "restore (split disabled with one process)");
 
         TEST_STORAGE_LIST(
             storagePg(), NULL,
@@ -3277,11 +3356,13 @@ testRun(void)
         hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
         hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
         hrnCfgArgRawBool(argList, cfgOptDelta, true);
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
         hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
         hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
-        TEST_RESULT_VOID(cmdRestore(), "restore");
+        TEST_RESULT_VOID(cmdRestore(), "restore (split disabled with delta)");
 
         TEST_STORAGE_LIST(
             storagePg(), NULL,
@@ -3298,6 +3379,76 @@ testRun(void)
 
         // Check that file was restored to full size with a partial write
         TEST_RESULT_LOG_EMPTY_OR_CONTAINS(", bi 128KB/256KB, ");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("incr backup with large block incr file");
+
+        // File large enough to be stored outside of a bundle. Each page has different contents so misplaced blocks are detected.
+        relation = bufNew(5 * 512 * 1024);
+
+        for (size_t relationIdx = 0; relationIdx < bufSize(relation); relationIdx++)
+            bufPtr(relation)[relationIdx] = (unsigned char)(relationIdx / 8192);
+
+        bufUsedSet(relation, bufSize(relation));
+
+        HRN_STORAGE_PUT(storagePgWrite(), PG_PATH_BASE "/1/5", relation, .timeModified = timeBase - 1);
+
+        // Backup
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+        hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+        hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("restore with block incr split into parts");
+
+        // Remove all files from pg path
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+        hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        hrnCfgArgRawZ(argList, cfgOptRepoBlockSplitSize, "1MiB");
+        hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+        hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+        HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+        TEST_RESULT_VOID(cmdRestore(), "restore");
+
+        TEST_STORAGE_LIST(
+            storagePg(), NULL,
+            "PG_VERSION\n"
+            "base/\n"
+            "base/1/\n"
+            "base/1/2\n"
+            "base/1/3\n"
+            "base/1/44\n"
+            "base/1/5\n"
+            "global/\n"
+            "global/pg_control\n"
+            "postgresql.auto.conf\n",
+            .level = storageInfoLevelType);
+
+        TEST_RESULT_BOOL(
+            bufEq(storageGetP(storageNewReadP(storagePg(), STRDEF(PG_PATH_BASE "/1/5"))), relation), true, "check contents");
+        TEST_RESULT_INT(
+            storageInfoP(storagePg(), STRDEF(PG_PATH_BASE "/1/5")).timeModified, timeBase - 1, "check time modified");
+
+        // Check that the file was logged once when verified
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("/base/1/5 (bi 2.5MB, ");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
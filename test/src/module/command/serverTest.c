@@ -53,7 +53,7 @@ testRun(void)
                     storageRemote,
                     storageRemoteNew(
                         STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL,
-                        protocolRemoteGet(protocolStorageTypeRepo, 0), cfgOptionUInt(cfgOptCompressLevelNetwork)),
+                        protocolRemoteGet(protocolStorageTypeRepo, 0), compressTypeGz, cfgOptionUInt(cfgOptCompressLevelNetwork)),
                     "new storage 1");
 
                 HRN_STORAGE_PUT_Z(storageRemote, "client1.txt", "CLIENT1");
@@ -65,7 +65,7 @@ testRun(void)
                     storageRemote,
                     storageRemoteNew(
                         STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL,
-                        protocolRemoteGet(protocolStorageTypeRepo, 0), cfgOptionUInt(cfgOptCompressLevelNetwork)),
+                        protocolRemoteGet(protocolStorageTypeRepo, 0), compressTypeGz, cfgOptionUInt(cfgOptCompressLevelNetwork)),
                     "new storage 2");
 
                 HRN_STORAGE_PUT_Z(storageRemote, "client2.txt", "CLIENT2");
@@ -100,7 +100,7 @@ testRun(void)
                     storageRemote,
                     storageRemoteNew(
                         STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL,
-                        protocolRemoteGet(protocolStorageTypePg, 0), cfgOptionUInt(cfgOptCompressLevelNetwork)),
+                        protocolRemoteGet(protocolStorageTypePg, 0), compressTypeGz, cfgOptionUInt(cfgOptCompressLevelNetwork)),
                     "new storage 3");
 
                 HRN_STORAGE_PUT_Z(storageRemote, "client3.txt", "CLIENT3");
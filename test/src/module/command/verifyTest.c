@@ -1,7 +1,11 @@
 /***********************************************************************************************************************************
 Test Verify Command
 ***********************************************************************************************************************************/
+#include "command/backup/blockMap.h"
+#include "command/backup/common.h"
+#include "common/crypto/hash.h"
 #include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
 #include "postgres/interface.h"
 #include "postgres/version.h"
 #include "storage/posix/storage.h"
@@ -13,6 +17,28 @@ Test Verify Command
 
 #include "common/harnessProtocol.h"
 
+/***********************************************************************************************************************************
+Write a block map to the repo and return the map
+***********************************************************************************************************************************/
+static Buffer *
+testBlockMapPut(const char *const file, const BlockMapItem *const itemList, const unsigned int itemTotal)
+{
+    BlockMap *const blockMap = blockMapNew();
+
+    for (unsigned int itemIdx = 0; itemIdx < itemTotal; itemIdx++)
+        blockMapAdd(blockMap, &itemList[itemIdx]);
+
+    Buffer *const result = bufNew(0);
+    IoWrite *const write = ioBufferWriteNewOpen(result);
+
+    blockMapWrite(blockMap, write, 8192, 8);
+    ioWriteClose(write);
+
+    HRN_STORAGE_PUT(storageRepoWrite(), file, result);
+
+    return result;
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -250,7 +276,8 @@ testRun(void)
         harnessLogLevelSet(logLevelDetail);
 
         backupResult.status = backupValid;
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_PTR(manifest, NULL, "manifest not set - pg version mismatch");
         TEST_RESULT_UINT(backupResult.status, backupInvalid, "manifest unusable - backup invalid");
         TEST_RESULT_LOG(
@@ -285,7 +312,8 @@ testRun(void)
             .comment = "manifest copy - invalid system-id");
 
         backupResult.status = backupValid;
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_PTR(manifest, NULL, "manifest not set - pg system-id mismatch");
         TEST_RESULT_UINT(backupResult.status, backupInvalid, "manifest unusable - backup invalid");
         TEST_RESULT_LOG(
@@ -319,7 +347,8 @@ testRun(void)
             .comment = "manifest copy - invalid db-id");
 
         backupResult.status = backupValid;
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_PTR(manifest, NULL, "manifest not set - pg db-id mismatch");
         TEST_RESULT_UINT(backupResult.status, backupInvalid, "manifest unusable - backup invalid");
         TEST_RESULT_LOG(
@@ -337,7 +366,8 @@ testRun(void)
             storageRepoWrite(), TEST_PATH "/repo/" STORAGE_PATH_BACKUP "/db/" TEST_BACKUP_LABEL_FULL "/" BACKUP_MANIFEST_FILE
             INFO_COPY_EXT, TEST_INVALID_BACKREST_INFO, .comment = "invalid manifest copy");
 
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, false, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_UINT(backupResult.status, backupInvalid, "manifest unusable - backup invalid");
         TEST_RESULT_LOG(
             "P00 DETAIL: unable to open missing file '" TEST_PATH "/repo/backup/db/20181119-152138F/backup.manifest' for read\n"
@@ -351,7 +381,8 @@ testRun(void)
             storageRepoWrite(), TEST_PATH "/repo/" STORAGE_PATH_BACKUP "/db/" TEST_BACKUP_LABEL_FULL "/" BACKUP_MANIFEST_FILE,
             TEST_INVALID_BACKREST_INFO, .comment = "invalid manifest");
 
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, true, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, true, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_PTR(manifest, NULL, "manifest not set");
         TEST_RESULT_UINT(backupResult.status, backupInvalid, "manifest unusable - backup invalid");
         TEST_RESULT_LOG(
@@ -377,7 +408,8 @@ testRun(void)
             .comment = "valid manifest");
 
         backupResult.status = backupValid;
-        TEST_ASSIGN(manifest, verifyManifestFile(&backupResult, NULL, true, infoPg, &jobErrorTotal), "verify manifest");
+        TEST_ASSIGN(
+            manifest, verifyManifestFile(&backupResult, cipherTypeNone, NULL, true, infoPg, &jobErrorTotal), "verify manifest");
         TEST_RESULT_PTR_NE(manifest, NULL, "manifest set");
         TEST_RESULT_UINT(backupResult.status, backupValid, "manifest usable");
         TEST_RESULT_LOG("P00 DETAIL: backup '20181119-152138F' manifest.copy does not match manifest");
@@ -856,20 +888,24 @@ testRun(void)
         String *filePathName = strNewZ(STORAGE_REPO_ARCHIVE "/testfile");
         HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), strZ(filePathName));
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, HASH_TYPE_SHA1_ZERO_BUF, 0, NULL), verifyOk, "file ok");
+            verifyFile(filePathName, 0, NULL, compressTypeNone, HASH_TYPE_SHA1_ZERO_BUF, 0, cipherTypeNone, NULL, NULL),
+            verifyOk, "file ok");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("file size invalid in archive");
 
         HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(filePathName), fileContents);
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, fileChecksum, 0, NULL), verifySizeInvalid, "file size invalid");
+            verifyFile(filePathName, 0, NULL, compressTypeNone, fileChecksum, 0, cipherTypeNone, NULL, NULL), verifySizeInvalid,
+            "file size invalid");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("file missing in archive");
 
         TEST_RESULT_UINT(
-            verifyFile(strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), 0, NULL, compressTypeNone, fileChecksum, 0, NULL),
+            verifyFile(
+                strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), 0, NULL, compressTypeNone, fileChecksum, 0, cipherTypeNone, NULL,
+                NULL),
             verifyFileMissing, "file missing");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -883,11 +919,117 @@ testRun(void)
 
         strCatZ(filePathName, ".gz");
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeGz, fileChecksum, fileSize, STRDEF("pass")),
+            verifyFile(filePathName, 0, NULL, compressTypeGz, fileChecksum, fileSize, cipherTypeAes256Cbc, STRDEF("pass"), NULL),
             verifyOk, "file encrypted compressed ok");
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeGz, bufNewDecode(encodingHex, STRDEF("aa")), fileSize, STRDEF("pass")),
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, bufNewDecode(encodingHex, STRDEF("aa")), fileSize, cipherTypeAes256Cbc,
+                STRDEF("pass"), NULL),
             verifyChecksumMismatch, "file encrypted compressed checksum mismatch");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block incremental map referencing backups");
+
+        StringList *const referenceList = strLstNew();
+        strLstAddZ(referenceList, "20181119-152138F");
+        strLstAddZ(referenceList, "20181119-152138F_20181119-152152D");
+
+        filePathName = strNewZ(STORAGE_REPO_BACKUP "/20181119-152138F_20181119-152152D/pg_data/test.pgbi");
+
+        Buffer *map = testBlockMapPut(
+            strZ(filePathName),
+            (const BlockMapItem [])
+            {
+                {.reference = 0, .superBlockSize = 8192, .bundleId = 1, .offset = 0, .size = 8, .checksum = {0xaa}},
+                {.reference = 1, .superBlockSize = 8192, .offset = 0, .size = 4, .checksum = {0xbb}},
+            },
+            2);
+
+        VerifyFileBlockIncr blockIncr =
+        {
+            .manifestName = STRDEF("pg_data/test"),
+            .referenceList = referenceList,
+            .mapSize = bufUsed(map),
+            .blockSize = 8192,
+            .checksumSize = 8,
+            .compressType = compressTypeNone,
+        };
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F/bundle/1", "12345678");
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifyOk, "referenced blocks ok");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F/bundle/1", "1234");
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifySizeInvalid, "referenced bundle too small");
+
+        HRN_STORAGE_REMOVE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F/bundle/1");
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifyFileMissing, "referenced bundle missing");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block incremental map referencing the block store");
+
+        const BlockMapItem blockStoreItem =
+        {
+            .reference = BLOCK_MAP_REFERENCE_STORE,
+            .superBlockSize = 8192,
+            .size = 1,
+            .checksum = {'a'},
+        };
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(backupBlockStorePath(blockStoreItem.checksum, compressTypeNone)), "X");
+        map = testBlockMapPut(strZ(filePathName), &blockStoreItem, 1);
+        blockIncr.mapSize = bufUsed(map);
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifyOk, "block store blocks ok");
+
+        map = testBlockMapPut(
+            strZ(filePathName),
+            (const BlockMapItem [])
+            {
+                {.reference = BLOCK_MAP_REFERENCE_STORE, .superBlockSize = 8192, .size = 2, .checksum = {'a'}},
+            },
+            1);
+        blockIncr.mapSize = bufUsed(map);
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifySizeInvalid, "block store block size invalid");
+
+        map = testBlockMapPut(
+            strZ(filePathName),
+            (const BlockMapItem [])
+            {
+                {.reference = BLOCK_MAP_REFERENCE_STORE, .superBlockSize = 8192, .size = 1, .checksum = {'a'}},
+                {.reference = BLOCK_MAP_REFERENCE_STORE, .superBlockSize = 8192, .size = 1, .checksum = {'b'}},
+            },
+            2);
+        blockIncr.mapSize = bufUsed(map);
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeNone, cryptoHashOne(hashTypeSha1, map), bufUsed(map), cipherTypeNone, NULL,
+                &blockIncr),
+            verifyFileMissing, "block store block missing");
     }
 
     // *****************************************************************************************************************************
@@ -1531,10 +1673,18 @@ testRun(void)
             storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152900F_20181119-152909D/" BACKUP_MANIFEST_FILE INFO_COPY_EXT,
             strZ(manifestContent), .comment = "valid manifest copy - diff");
 
+        // Block incremental file with a map that references a block stored in the same file
+        Buffer *const biindFile = bufNewC("X", 1);
+        const Buffer *const biindMap = testBlockMapPut(
+            STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/biind.pgbi",
+            &(BlockMapItem){.reference = 0, .superBlockSize = 8192, .size = 1, .checksum = {0xaa}}, 1);
+        bufCat(biindFile, biindMap);
+
         // Create valid full backup and valid diff backup
         manifestContent = strNewFmt(
             TEST_MANIFEST_HEADER
             "backup-bundle=true\n"
+            "backup-reference=\"20201119-163000F\"\n"
             "\n"
             "[backup:db]\n"
             TEST_BACKUP_DB2_11
@@ -1545,14 +1695,14 @@ testRun(void)
             "[target:file]\n"
             "pg_data/validfile={\"bni\":1,\"bno\":3,\"checksum\":\"%s\",\"size\":%u,\"timestamp\":1565282114}\n"
             "pg_data/zerofile={\"size\":0,\"timestamp\":1565282114}\n"
-            "pg_data/biind={\"bi\":1,\"bim\":3,\"checksum\":\"9865d483bc5a94f2e30056fc256ed3066af54d04\",\"size\":4"
-            ",\"timestamp\":1565282114}\n"
+            "pg_data/biind={\"bi\":1,\"bic\":8,\"bim\":%zu,\"checksum\":\"%s\",\"size\":%zu,\"timestamp\":1565282114}\n"
             TEST_MANIFEST_FILE_DEFAULT
             TEST_MANIFEST_LINK
             TEST_MANIFEST_LINK_DEFAULT
             TEST_MANIFEST_PATH
             TEST_MANIFEST_PATH_DEFAULT,
-            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize);
+            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize, bufUsed(biindMap),
+            strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, biindFile))), bufUsed(biindFile));
 
         HRN_INFO_PUT(
             storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/" BACKUP_MANIFEST_FILE, strZ(manifestContent),
@@ -1564,8 +1714,8 @@ testRun(void)
         HRN_STORAGE_PUT_Z(
             storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/bundle/1", zNewFmt("XXX%s", fileContents),
             .comment = "valid file");
-        HRN_STORAGE_PUT_Z(
-            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/biind.pgbi", "ZZZZ", .comment = "pgbi file");
+        HRN_STORAGE_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/biind.pgbi", biindFile, .comment = "pgbi file");
 
         // Create WAL file with just header info and small WAL size
         Buffer *walBuffer = bufNew((size_t)(1024 * 1024));
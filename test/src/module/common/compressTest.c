@@ -294,7 +294,7 @@ testRun(void)
 
         char buffer[STACK_TRACE_PARAM_MAX];
 
-        Bz2Compress *compress = (Bz2Compress *)ioFilterDriver(bz2CompressNew(1, false));
+        Bz2Compress *compress = (Bz2Compress *)ioFilterDriver(bz2CompressNew(1, false, 0));
 
         compress->stream.avail_in = 999;
 
@@ -335,7 +335,7 @@ testRun(void)
 
         char buffer[STACK_TRACE_PARAM_MAX];
 
-        Lz4Compress *compress = (Lz4Compress *)ioFilterDriver(lz4CompressNew(7, false));
+        Lz4Compress *compress = (Lz4Compress *)ioFilterDriver(lz4CompressNew(7, false, 0));
 
         compress->inputSame = true;
         compress->flushing = true;
@@ -363,6 +363,26 @@ testRun(void)
         // Run standard test suite
         testSuite(compressTypeZst, "zstd -dc", 0);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with worker threads");
+
+        Buffer *decompressed = bufNew(4 * 1024 * 1024);
+        unsigned char *chr = bufPtr(decompressed);
+
+        for (size_t chrIdx = 0; chrIdx < bufSize(decompressed); chrIdx++)
+            chr[chrIdx] = (unsigned char)(chrIdx % 94 + 32);
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .thread = 2), decompressed, 65536, 32),
+            "compress large in/small out buffer");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(decompressFilterP(compressTypeZst), compressed, bufSize(compressed), 1024 * 256)),
+            true, "decompress");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("zstError()");
 
@@ -381,14 +401,14 @@ testRun(void)
 
         char buffer[STACK_TRACE_PARAM_MAX];
 
-        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNew(14, false));
+        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNew(14, false, 2));
 
         compress->inputSame = true;
         compress->inputOffset = 49;
         compress->flushing = true;
 
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(compress, zstCompressToLog, buffer, sizeof(buffer)), "zstCompressToLog");
-        TEST_RESULT_Z(buffer, "{level: 14, inputSame: true, inputOffset: 49, flushing: true}", "check log");
+        TEST_RESULT_Z(buffer, "{level: 14, thread: 2, inputSame: true, inputOffset: 49, flushing: true}", "check log");
 
         ZstDecompress *decompress = (ZstDecompress *)ioFilterDriver(zstDecompressNew(false));
 
@@ -418,6 +438,13 @@ testRun(void)
 
         TEST_RESULT_STR_Z(compressTypeStr(compressTypeGz), "gz", "gz str");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compressTypeAvailable()");
+
+        TEST_RESULT_BOOL(compressTypeAvailable(compressTypeNone), true, "type none always available");
+        TEST_RESULT_BOOL(compressTypeAvailable(compressTypeGz), true, "type gz available");
+        TEST_RESULT_BOOL(compressTypeAvailable(compressTypeXz), false, "type xz not available");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("compressTypePresent()");
 
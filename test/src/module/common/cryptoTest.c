@@ -14,6 +14,42 @@ Data for testing
 #define TEST_PLAINTEXT                                              "plaintext"
 #define TEST_BUFFER_SIZE                                            256
 
+/***********************************************************************************************************************************
+Process data through a cipher filter using the specified input buffer size
+***********************************************************************************************************************************/
+static Buffer *
+testCipher(IoFilter *const cipher, const Buffer *const source, const size_t inputSize)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_FILTER, cipher);
+        FUNCTION_HARNESS_PARAM(BUFFER, source);
+        FUNCTION_HARNESS_PARAM(SIZE, inputSize);
+    FUNCTION_HARNESS_END();
+
+    Buffer *const result = bufNew(bufUsed(source) + 1024);
+    Buffer *const output = bufNew(4096);
+    const size_t bufferSize = ioBufferSize();
+    ioBufferSizeSet(inputSize);
+
+    IoRead *const read = ioBufferReadNew(source);
+    ioFilterGroupAdd(ioReadFilterGroup(read), cipher);
+    ioReadOpen(read);
+
+    while (!ioReadEof(read))
+    {
+        ioRead(read, output);
+        bufCat(result, output);
+        bufUsedZero(output);
+    }
+
+    ioReadClose(read);
+    ioReadFree(read);
+    bufFree(output);
+    ioBufferSizeSet(bufferSize);
+
+    FUNCTION_HARNESS_RETURN(BUFFER, result);
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -302,6 +338,142 @@ testRun(void)
         TEST_RESULT_UINT(ioFilterGroupSize(filterGroup), 1, "    check filter add");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("CipherBlock chunked"))
+    {
+        // Source with three full chunks and a partial chunk
+        Buffer *const source = bufNew(CIPHER_BLOCK_CHUNK_SIZE * 3 + 100);
+
+        for (size_t byteIdx = 0; byteIdx < bufSize(source); byteIdx++)
+            bufPtr(source)[byteIdx] = (unsigned char)(byteIdx * 7);
+
+        bufUsedSet(source, bufSize(source));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("process size");
+
+        CipherBlock *const cipherBlock = (CipherBlock *)ioFilterDriver(
+            cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Gcm, testPass));
+
+        TEST_RESULT_BOOL(cipherBlock->chunked, true, "cipher is chunked");
+        TEST_RESULT_UINT(
+            cipherBlockProcessSize(cipherBlock, CIPHER_BLOCK_CHUNK_SIZE + 1),
+            CIPHER_BLOCK_CHUNK_SIZE + 1 + CIPHER_BLOCK_TAG_SIZE * 3 + CIPHER_BLOCK_HEADER_SIZE, "check process size");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("encrypt/decrypt with partial last chunk");
+
+        Buffer *encrypt = NULL;
+
+        TEST_ASSIGN(
+            encrypt,
+            testCipher(
+                cipherBlockNewPack(ioFilterParamList(cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Gcm, testPass))), source,
+                65535),
+            "encrypt");
+        TEST_RESULT_UINT(
+            bufUsed(encrypt), CIPHER_BLOCK_HEADER_SIZE + bufUsed(source) + CIPHER_BLOCK_TAG_SIZE * 4, "check encrypt size");
+
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass), encrypt, 1000), source), true,
+            "decrypt in small pieces");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass), encrypt, 1024 * 1024), source),
+            true, "decrypt in one piece");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("decrypt chunk at computed offset");
+
+        IoFilter *blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+        CipherBlock *blockDecrypt = (CipherBlock *)ioFilterDriver(blockDecryptFilter);
+        Buffer *decryptBuffer = bufNew(CIPHER_BLOCK_CHUNK_SIZE * 2);
+        const size_t chunkOffset = CIPHER_BLOCK_HEADER_SIZE + 2 * (CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE);
+
+        ioFilterProcessInOut(blockDecryptFilter, bufNewC(bufPtr(encrypt), CIPHER_BLOCK_HEADER_SIZE), decryptBuffer);
+        blockDecrypt->chunkIdx = 2;
+
+        ioFilterProcessInOut(
+            blockDecryptFilter, bufNewC(bufPtr(encrypt) + chunkOffset, bufUsed(encrypt) - chunkOffset), decryptBuffer);
+        ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer);
+
+        TEST_RESULT_BOOL(
+            bufEq(decryptBuffer, bufNewC(bufPtr(source) + CIPHER_BLOCK_CHUNK_SIZE * 2, CIPHER_BLOCK_CHUNK_SIZE + 100)), true,
+            "check decrypt");
+
+        ioFilterFree(blockDecryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on tampered, reordered, and truncated chunks");
+
+        Buffer *const tamper = bufDup(encrypt);
+        bufPtr(tamper)[CIPHER_BLOCK_HEADER_SIZE + CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE + 1] ^= 0x01;
+
+        TEST_ERROR(
+            testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass), tamper, 65536), CryptoError,
+            "unable to authenticate cipher chunk 1");
+
+        Buffer *const reorder = bufDup(encrypt);
+        memcpy(
+            bufPtr(reorder) + CIPHER_BLOCK_HEADER_SIZE,
+            bufPtr(encrypt) + CIPHER_BLOCK_HEADER_SIZE + CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE,
+            CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE);
+        memcpy(
+            bufPtr(reorder) + CIPHER_BLOCK_HEADER_SIZE + CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE,
+            bufPtr(encrypt) + CIPHER_BLOCK_HEADER_SIZE, CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE);
+
+        TEST_ERROR(
+            testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass), reorder, 65536), CryptoError,
+            "unable to authenticate cipher chunk 0");
+
+        TEST_ERROR(
+            testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, BUFSTRDEF("badpass")), encrypt, 65536),
+            CryptoError, "unable to authenticate cipher chunk 0");
+
+        TEST_ERROR(
+            testCipher(
+                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass),
+                bufNewC(bufPtr(encrypt), CIPHER_BLOCK_HEADER_SIZE + (CIPHER_BLOCK_CHUNK_SIZE + CIPHER_BLOCK_TAG_SIZE) * 3),
+                65536),
+            CryptoError, "cipher data truncated");
+
+        TEST_ERROR(
+            testCipher(
+                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass),
+                bufNewC(bufPtr(encrypt), CIPHER_BLOCK_HEADER_SIZE + CIPHER_BLOCK_TAG_SIZE - 1), 65536),
+            CryptoError, "cipher data truncated");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("encrypt/decrypt exact multiple of chunk size");
+
+        const Buffer *const sourceExact = bufNewC(bufPtr(source), CIPHER_BLOCK_CHUNK_SIZE * 2);
+
+        TEST_ASSIGN(
+            encrypt, testCipher(cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Gcm, testPass), sourceExact, 65536),
+            "encrypt");
+        TEST_RESULT_UINT(
+            bufUsed(encrypt), CIPHER_BLOCK_HEADER_SIZE + bufUsed(sourceExact) + CIPHER_BLOCK_TAG_SIZE * 3, "check encrypt size");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass), encrypt, 4096), sourceExact),
+            true, "decrypt");
+
+        TEST_ERROR(
+            testCipher(
+                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass),
+                bufNewC(bufPtr(encrypt), bufUsed(encrypt) - CIPHER_BLOCK_TAG_SIZE), 65536),
+            CryptoError, "cipher data truncated");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("encrypt/decrypt zero bytes with no magic");
+
+        TEST_ASSIGN(
+            encrypt, testCipher(cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Gcm, testPass, .raw = true), BUFSTRDEF(""), 16),
+            "encrypt");
+        TEST_RESULT_UINT(bufUsed(encrypt), PKCS5_SALT_LEN + CIPHER_BLOCK_TAG_SIZE, "check encrypt size");
+        TEST_RESULT_UINT(
+            bufUsed(testCipher(cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass, .raw = true), encrypt, 16)), 0,
+            "decrypt");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("CryptoHash"))
     {
@@ -464,6 +636,33 @@ testRun(void)
         TEST_RESULT_STR_Z(
             strNewEncode(encodingHex, pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), XX_HASH_FILTER_TYPE))),
             "1a3e11127b", "check small hash 5");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("kernel selected at runtime matches compiled kernel");
+
+        Buffer *large = bufNew(65536 + 7);
+
+        for (size_t largeIdx = 0; largeIdx < bufSize(large); largeIdx++)
+            bufPtr(large)[largeIdx] = (unsigned char)(largeIdx * 31 % 251);
+
+        bufUsedSet(large, bufSize(large));
+
+        XXH128_canonical_t canonical;
+        XXH128_canonicalFromHash(&canonical, XXH3_128bits(bufPtrConst(large), bufUsed(large)));
+        const Buffer *const largeHash = BUF(canonical.digest, sizeof(canonical.digest));
+
+        TEST_RESULT_BOOL(bufEq(xxHashOne(16, large), largeHash), true, "check large hash one");
+
+        ioBufferSizeSet(4096);
+
+        read = ioBufferReadNew(large);
+        ioFilterGroupAdd(ioReadFilterGroup(read), xxHashNew(16));
+
+        ioReadDrain(read);
+
+        TEST_RESULT_BOOL(
+            bufEq(pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), XX_HASH_FILTER_TYPE)), largeHash), true,
+            "check large hash");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
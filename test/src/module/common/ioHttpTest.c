@@ -597,6 +597,18 @@ testRun(void)
                     "httpHeaderToLog");
                 TEST_RESULT_Z(logBuf, "{transfer-encoding: 'chunked'}", "check response headers");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("idle session is closed rather than reused");
+
+                TEST_RESULT_UINT(lstSize(client->sessionReuseList), 1, "one reusable session");
+
+                // Make the session look like it has been idle too long
+                ((HttpClientSessionReuse *)lstGet(client->sessionReuseList, 0))->timeIdle =
+                    timeMSec() - HTTP_CLIENT_SESSION_IDLE_MAX - 1000;
+
+                hrnServerScriptClose(http);
+                hrnServerScriptAccept(http);
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("head request with connection close but no content");
 
@@ -3,6 +3,8 @@ Test IO
 ***********************************************************************************************************************************/
 #include <fcntl.h>
 #include <netdb.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
 #include "common/type/json.h"
 
@@ -248,7 +250,7 @@ testRun(void)
     FUNCTION_HARNESS_VOID();
 
     // *****************************************************************************************************************************
-    if (testBegin("ioBufferSize()/ioBufferSizeSet() and ioTimeoutMs()/ioTimeoutMsSet()"))
+    if (testBegin("ioBufferSize()/ioBufferSizeSet(), ioTimeoutMs()/ioTimeoutMsSet(), and ioCacheDrop()/ioCacheDropSet()"))
     {
         TEST_RESULT_UINT(ioBufferSize(), 65536, "check initial buffer size");
         TEST_RESULT_VOID(ioBufferSizeSet(16384), "set buffer size");
@@ -257,6 +259,11 @@ testRun(void)
         TEST_RESULT_UINT(ioTimeoutMs(), 60000, "check initial timeout ms");
         TEST_RESULT_VOID(ioTimeoutMsSet(77777), "set timeout ms");
         TEST_RESULT_UINT(ioTimeoutMs(), 77777, "check timeout ms");
+
+        TEST_RESULT_BOOL(ioCacheDrop(), false, "check initial cache drop");
+        TEST_RESULT_VOID(ioCacheDropSet(true), "set cache drop");
+        TEST_RESULT_BOOL(ioCacheDrop(), true, "check cache drop");
+        TEST_RESULT_VOID(ioCacheDropSet(false), "reset cache drop");
     }
 
     // *****************************************************************************************************************************
@@ -331,7 +338,14 @@ testRun(void)
         TEST_ASSIGN(bufferRead, ioBufferReadNew(bufferOriginal), "create buffer read object");
 
         TEST_RESULT_VOID(ioFilterGroupClear(ioReadFilterGroup(bufferRead)), "    clear does nothing when no filters");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(ioReadFilterGroup(bufferRead)), true, "    pass thru with no filters");
+        TEST_RESULT_VOID(ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioBufferNew()), "    add buffer filter");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(ioReadFilterGroup(bufferRead)), true, "    pass thru with buffer filter");
+        TEST_RESULT_VOID(ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioSizeNew()), "    add filter to be cleared");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(ioReadFilterGroup(bufferRead)), false, "    not pass thru with size filter");
+        TEST_RESULT_VOID(ioFilterGroupClear(ioReadFilterGroup(bufferRead)), "    clear filters");
         TEST_RESULT_VOID(ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioSizeNew()), "    add filter to be cleared");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(ioReadFilterGroup(bufferRead)), false, "    not pass thru with one size filter");
         TEST_RESULT_VOID(ioFilterGroupClear(ioReadFilterGroup(bufferRead)), "    clear size filter");
 
         IoFilter *sizeFilter = ioSizeNew();
@@ -809,5 +823,308 @@ testRun(void)
         TEST_RESULT_STR_Z(strNewBuf(output), "E", "check");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("ioUring*()"))
+    {
+#ifdef HAVE_IO_URING
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("not available when not enabled");
+
+        TEST_RESULT_BOOL(ioUringAvailable(), false, "not available");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("not available when ring cannot be created");
+
+        struct rlimit limitFile;
+        THROW_ON_SYS_ERROR(getrlimit(RLIMIT_NOFILE, &limitFile) == -1, AssertError, "unable to get file limit");
+        THROW_ON_SYS_ERROR(
+            setrlimit(RLIMIT_NOFILE, &(struct rlimit){.rlim_cur = 0, .rlim_max = limitFile.rlim_max}) == -1, AssertError,
+            "unable to set file limit");
+
+        harnessLogLevelSet(logLevelDetail);
+        ioUringEnabledSet(true);
+
+        TEST_RESULT_BOOL(ioUringAvailable(), false, "not available");
+
+        THROW_ON_SYS_ERROR(setrlimit(RLIMIT_NOFILE, &limitFile) == -1, AssertError, "unable to reset file limit");
+
+        TEST_RESULT_LOG("P00 DETAIL: io_uring is not available: [24] Too many open files");
+        harnessLogLevelReset();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("create ring");
+
+        ioUringLocal.init = false;
+        ioBufferSizeSet(8);
+
+        TEST_RESULT_BOOL(ioUringAvailable(), true, "available");
+        TEST_RESULT_BOOL(ioUringAvailable(), true, "still available");
+        TEST_RESULT_UINT(ioUringBufferSize(), 8, "buffer size");
+        TEST_RESULT_BOOL(ioUringLocal.bufferFixed, true, "buffers registered");
+        TEST_RESULT_BOOL(ioUringBufferRegister(), false, "buffers cannot be registered twice");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get and free buffers");
+
+        unsigned int bufferIdx = 0;
+
+        for (unsigned int bufferTotal = 0; bufferTotal < IO_URING_BUFFER_MAX; bufferTotal++)
+        {
+            TEST_RESULT_BOOL(ioUringBufferGet(&bufferIdx), true, "get buffer");
+            TEST_RESULT_UINT(bufferIdx, bufferTotal, "check buffer");
+        }
+
+        TEST_RESULT_BOOL(ioUringBufferGet(&bufferIdx), false, "no buffers free");
+        TEST_RESULT_VOID(ioUringBufferFree(3), "free buffer");
+        TEST_RESULT_BOOL(ioUringBufferGet(&bufferIdx), true, "get buffer");
+        TEST_RESULT_UINT(bufferIdx, 3, "check buffer");
+
+        for (unsigned int bufferTotal = 0; bufferTotal < IO_URING_BUFFER_MAX; bufferTotal++)
+            ioUringBufferFree(bufferTotal);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read");
+
+        const int fd = open(TEST_PATH "/test.txt", O_CREAT | O_TRUNC | O_RDWR, 0640);
+        THROW_ON_SYS_ERROR(write(fd, "ABCDEFGHIJ", 10) != 10, FileWriteError, "unable to write file");
+
+        IoUringOp *op1 = ioUringOpNew();
+        IoUringOp *const op2 = ioUringOpNew();
+
+        TEST_RESULT_BOOL(ioUringBufferGet(&bufferIdx), true, "get buffer");
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 4, 3), "queue read");
+        TEST_RESULT_BOOL(op1->data->busy, true, "read is busy");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+        TEST_RESULT_INT(ioUringResult(op1), 4, "check result");
+        TEST_RESULT_Z(strZ(strNewZN((char *)ioUringBuffer(bufferIdx), 4)), "DEFG", "check data");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for completed read");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read without registered buffers");
+
+        ioUringLocal.bufferFixed = false;
+
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 8, 6), "queue read");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+        TEST_RESULT_INT(ioUringResult(op1), 4, "check result");
+        TEST_RESULT_Z(strZ(strNewZN((char *)ioUringBuffer(bufferIdx), 4)), "GHIJ", "check data");
+
+        ioUringLocal.bufferFixed = true;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read error");
+
+        TEST_RESULT_VOID(ioUringRead(op1, -1, bufferIdx, 8, 0), "queue read");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+        TEST_RESULT_INT(ioUringResult(op1), -1, "check result");
+        TEST_RESULT_INT(errno, EBADF, "check errno");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("wait for read that completes after other reads");
+
+        int pipeFd[2];
+        THROW_ON_SYS_ERROR(pipe(pipeFd) == -1, KernelError, "unable to create pipe");
+
+        unsigned int bufferPipeIdx = 0;
+
+        TEST_RESULT_BOOL(ioUringBufferGet(&bufferPipeIdx), true, "get buffer");
+        TEST_RESULT_VOID(ioUringRead(op2, pipeFd[0], bufferPipeIdx, 8, 0), "queue pipe read");
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue file read");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for file read");
+        TEST_RESULT_INT(ioUringResult(op1), 2, "check result");
+        TEST_RESULT_BOOL(op2->data->busy, true, "pipe read is busy");
+
+        THROW_ON_SYS_ERROR(write(pipeFd[1], "XYZ", 3) != 3, KernelError, "unable to write pipe");
+
+        TEST_RESULT_VOID(ioUringWait(op2), "wait for pipe read");
+        TEST_RESULT_INT(ioUringResult(op2), 3, "check result");
+        TEST_RESULT_Z(strZ(strNewZN((char *)ioUringBuffer(bufferPipeIdx), 3)), "XYZ", "check data");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("free read in progress");
+
+        IoUringOp *opFree = ioUringOpNew();
+        IoUringOpData *const opFreeData = opFree->data;
+
+        TEST_RESULT_VOID(ioUringRead(opFree, pipeFd[0], bufferPipeIdx, 8, 0), "queue pipe read");
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue file read");
+        TEST_RESULT_VOID(ioUringWait(op1), "submit pipe read");
+        TEST_RESULT_BOOL(opFreeData->busy, true, "pipe read is busy");
+
+        THROW_ON_SYS_ERROR(write(pipeFd[1], "UV", 2) != 2, KernelError, "unable to write pipe");
+
+        TEST_RESULT_VOID(ioUringOpFree(opFree), "free pipe read");
+        TEST_RESULT_BOOL(opFreeData->busy, false, "pipe read complete");
+        TEST_RESULT_INT(opFreeData->result, 2, "pipe read result");
+        TEST_RESULT_PTR(ioUringLocal.opFree, opFreeData, "data is free");
+
+        TEST_ASSIGN(opFree, ioUringOpNew(), "new op");
+        TEST_RESULT_PTR(opFree->data, opFreeData, "data is reused");
+        TEST_RESULT_PTR(ioUringLocal.opFree, NULL, "no data is free");
+
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        ioUringBufferFree(bufferPipeIdx);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("queued operations are submitted when the ring is full");
+
+        IoUringOp *opList[IO_URING_ENTRIES * 2];
+        unsigned int opTotal = 0;
+
+        for (; opTotal <= IO_URING_ENTRIES; opTotal++)
+        {
+            opList[opTotal] = ioUringOpNew();
+            ioUringRead(opList[opTotal], fd, bufferIdx, 2, 0);
+        }
+
+        TEST_RESULT_UINT(ioUringLocal.submitTotal, 1, "full ring submitted");
+
+        for (; ioUringLocal.submitTotal < IO_URING_ENTRIES - IO_URING_LINK_MAX + 1; opTotal++)
+        {
+            opList[opTotal] = ioUringOpNew();
+            ioUringRead(opList[opTotal], fd, bufferIdx, 2, 0);
+        }
+
+        const int fdDup = dup(fd);
+        IoUringOp *const opSync = ioUringOpNew();
+        IoUringOp *const opClose = ioUringOpNew();
+
+        TEST_RESULT_VOID(ioUringSync(opSync, fdDup, true), "queue linked sync");
+        TEST_RESULT_UINT(ioUringLocal.submitTotal, 1, "ring submitted to make room for the chain");
+        TEST_RESULT_VOID(ioUringClose(opClose, fdDup, false), "queue close");
+        TEST_RESULT_UINT(ioUringLocal.submitTotal, 2, "chain queued");
+
+        TEST_RESULT_VOID(ioUringWait(opClose), "wait for close");
+        TEST_RESULT_INT(ioUringResult(opSync), 0, "check sync result");
+        TEST_RESULT_INT(ioUringResult(opClose), 0, "check close result");
+
+        for (unsigned int opIdx = 0; opIdx < opTotal; opIdx++)
+        {
+            ioUringWait(opList[opIdx]);
+
+            if (ioUringResult(opList[opIdx]) != 2)
+                THROW_FMT(AssertError, "unexpected result for read %u", opIdx);
+
+            ioUringOpFree(opList[opIdx]);
+        }
+
+        ioUringOpFree(opSync);
+        ioUringOpFree(opClose);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("ring created again in a child process");
+
+        // Queue a read in the parent that will be submitted after the child exits
+        TEST_RESULT_VOID(ioUringRead(op2, fd, bufferIdx, 2, 0), "queue read");
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                const unsigned int ringId = ioUringLocal.ringId;
+
+                TEST_RESULT_BOOL(ioUringAvailable(), true, "available");
+                TEST_RESULT_UINT(ioUringLocal.ringId, ringId + 1, "new ring");
+                TEST_RESULT_INT(fcntl(ioUringLocal.fd, F_GETFD), FD_CLOEXEC, "ring is closed on exec");
+
+                TEST_RESULT_VOID(ioUringWait(op2), "wait for parent read");
+                TEST_RESULT_INT(ioUringResult(op2), -1, "check result");
+                TEST_RESULT_INT(errno, ECANCELED, "check errno");
+
+                TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue read");
+                TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+                TEST_RESULT_INT(ioUringResult(op1), 2, "check result");
+                TEST_RESULT_Z(strZ(strNewZN((char *)ioUringBuffer(bufferIdx), 2)), "AB", "check data");
+
+                // Ring is released when it was created by another process even if a new ring will not be created
+                TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue read");
+
+                ioUringLocal.pid = 0;
+                ioUringLocal.enabled = false;
+
+                TEST_RESULT_BOOL(ioUringAvailable(), false, "not available");
+                TEST_RESULT_INT(ioUringLocal.fd, -1, "ring released");
+                TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+                TEST_RESULT_INT(ioUringResult(op1), -1, "check result");
+                TEST_RESULT_INT(errno, ECANCELED, "check errno");
+            }
+            HRN_FORK_CHILD_END();
+        }
+        HRN_FORK_END();
+
+        TEST_RESULT_VOID(ioUringWait(op2), "wait for read");
+        TEST_RESULT_INT(ioUringResult(op2), 2, "check result");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("ring is not used after an error");
+
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue read");
+
+        ioUringLocal.error = EFAULT;
+
+        TEST_ERROR(ioUringWait(op1), KernelError, "unable to submit io_uring operations: [14] Bad address");
+        TEST_RESULT_BOOL(ioUringAvailable(), false, "not available");
+
+        IoUringOpData *const opErrorData = op1->data;
+
+        TEST_RESULT_VOID(ioUringOpFree(op1), "free op");
+        TEST_RESULT_BOOL(ioUringLocal.opFree != opErrorData, true, "data is not reused");
+
+        // Complete the read that was queued
+        ioUringLocal.error = 0;
+        op1 = ioUringOpNew();
+
+        TEST_RESULT_VOID(ioUringRead(op1, fd, bufferIdx, 2, 0), "queue read");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for read");
+        TEST_RESULT_BOOL(opErrorData->busy, false, "read complete");
+
+        ioUringBufferFree(bufferIdx);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sync and close");
+
+        TEST_RESULT_VOID(ioUringSync(op1, fd, true), "queue sync");
+        TEST_RESULT_VOID(ioUringClose(op2, fd, false), "queue close");
+        TEST_RESULT_VOID(ioUringWait(op2), "wait for close");
+        TEST_RESULT_INT(ioUringResult(op1), 0, "check sync result");
+        TEST_RESULT_INT(ioUringResult(op2), 0, "check close result");
+        TEST_RESULT_INT(fcntl(fd, F_GETFD), -1, "file is closed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("close is cancelled when sync fails");
+
+        TEST_RESULT_VOID(ioUringSync(op1, fd, true), "queue sync");
+        TEST_RESULT_VOID(ioUringClose(op2, fd, false), "queue close");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for sync");
+        TEST_RESULT_VOID(ioUringWait(op2), "wait for close");
+        TEST_RESULT_INT(ioUringResult(op1), -1, "check sync result");
+        TEST_RESULT_INT(errno, EBADF, "check errno");
+        TEST_RESULT_INT(ioUringResult(op2), -1, "check close result");
+        TEST_RESULT_INT(errno, ECANCELED, "check errno");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("rename");
+
+        TEST_RESULT_BOOL(ioUringRenameAvailable(), true, "rename available");
+        TEST_RESULT_VOID(ioUringRename(op1, TEST_PATH "/test.txt", TEST_PATH "/test2.txt", false), "queue rename");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for rename");
+        TEST_RESULT_INT(ioUringResult(op1), 0, "check result");
+        TEST_RESULT_INT(access(TEST_PATH "/test2.txt", F_OK), 0, "file renamed");
+
+        TEST_RESULT_VOID(ioUringRename(op1, TEST_PATH "/test.txt", TEST_PATH "/test2.txt", false), "queue rename");
+        TEST_RESULT_VOID(ioUringWait(op1), "wait for rename");
+        TEST_RESULT_INT(ioUringResult(op1), -1, "check result");
+        TEST_RESULT_INT(errno, ENOENT, "check errno");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("not available when disabled");
+
+        ioUringEnabledSet(false);
+
+        TEST_RESULT_BOOL(ioUringAvailable(), false, "not available");
+#endif // HAVE_IO_URING
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
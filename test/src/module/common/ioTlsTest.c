@@ -1110,6 +1110,20 @@ testRun(void)
                 TEST_RESULT_STR_Z(strNewBuf(output), "AND MORE", "check output");
                 TEST_RESULT_BOOL(ioReadEof(ioSessionIoReadP(session)), false, "check eof = false");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("store session from server");
+
+                // The server does not issue resumable sessions so store sessions directly. The next open offers the stored session.
+                TlsClient *const tlsClient = client->pub.driver;
+                SSL *const sslStore = SSL_new(tlsClient->context);
+                SSL_SESSION *const sslSessionStore = SSL_SESSION_new();
+
+                TEST_RESULT_INT(tlsClientSessionNew(sslStore, SSL_SESSION_new()), 1, "session stored");
+                TEST_RESULT_INT(tlsClientSessionNew(sslStore, sslSessionStore), 1, "session replaced");
+                TEST_RESULT_BOOL(tlsClient->session == sslSessionStore, true, "check session");
+
+                SSL_free(sslStore);
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("read eof");
 
@@ -1156,6 +1170,9 @@ testRun(void)
                 TEST_ASSIGN(session, ioClientOpen(client), "open client again (was closed by server)");
                 socketLocal.block = false;
 
+                // The server disables session caching so the stored session is offered but not resumed
+                TEST_RESULT_BOOL(SSL_session_reused(((TlsSession *)session->pub.driver)->session), false, "session not resumed");
+
                 output = bufNew(13);
                 TEST_ERROR(
                     ioRead(ioSessionIoReadP(session), output), ServiceError,
@@ -1184,6 +1201,19 @@ testRun(void)
 
                 TEST_RESULT_VOID(ioClientFree(client), "free client");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("session from server ignored after client is freed");
+
+                SSL_CTX *const context = tlsContext();
+                SSL *const ssl = SSL_new(context);
+                SSL_SESSION *const sslSession = SSL_SESSION_new();
+
+                TEST_RESULT_INT(tlsClientSessionNew(ssl, sslSession), 0, "session not stored");
+
+                SSL_SESSION_free(sslSession);
+                SSL_free(ssl);
+                SSL_CTX_free(context);
+
                 // -----------------------------------------------------------------------------------------------------------------
                 hrnServerScriptEnd(tls);
             }
@@ -536,6 +536,147 @@ testRun(void)
         TEST_RESULT_PTR(memContextChildOne(memContextParent2)->context, memContextChild, "check parent2");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("MEM_CONTEXT_TEMP_ARENA_BEGIN()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("allocations and child contexts are carved from the arena");
+
+        MemContextStat statBegin = {0};
+        MemContextStat statEnd = {0};
+
+        MEM_CONTEXT_TEMP_ARENA_BEGIN()
+        {
+            MemContext *const arenaContext = MEM_CONTEXT_TEMP();
+            statBegin = memContextStat();
+
+            TEST_RESULT_BOOL(arenaContext->arena, true, "context is in arena");
+            TEST_RESULT_BOOL(arenaContext->arenaRoot, true, "context owns arena");
+            TEST_RESULT_PTR(memContextArena(arenaContext)->block, NULL, "no block yet");
+
+            unsigned char *mem1 = memNew(1);
+            unsigned char *const mem2 = memNew(1);
+
+            TEST_RESULT_UINT(memContextStat().arenaBlockTotal - statBegin.arenaBlockTotal, 1, "one block");
+            TEST_RESULT_UINT(memContextStat().arenaAllocTotal - statBegin.arenaAllocTotal, 3, "two allocations and alloc list");
+            TEST_RESULT_UINT(memContextStat().allocTotal - statBegin.allocTotal, 1, "block allocated");
+            TEST_RESULT_UINT((uintptr_t)mem2 % ALIGN_OF(uint64_t), 0, "allocation is aligned");
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("resize copies and free is deferred to the arena");
+
+            *mem1 = 0xAA;
+            TEST_ASSIGN(mem1, memResize(mem1, 16), "resize");
+            TEST_RESULT_UINT(*mem1, 0xAA, "check data");
+
+            TEST_RESULT_VOID(memFree(mem2), "free");
+            TEST_RESULT_UINT(memContextStat().freeTotal - statBegin.freeTotal, 0, "nothing freed");
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("large allocation gets its own block");
+
+            MemContextArenaBlock *const block = memContextArena(arenaContext)->block;
+            void *const large = memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE);
+
+            TEST_RESULT_PTR(memContextArena(arenaContext)->block, block, "current block unchanged");
+            TEST_RESULT_PTR(block->prior + 1, MEM_CONTEXT_ALLOC_HEADER(large), "large block is behind current block");
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("new block when current block is full");
+
+            for (unsigned int allocIdx = 0; allocIdx < 8; allocIdx++)
+                memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE / 8);
+
+            TEST_RESULT_BOOL(memContextArena(arenaContext)->block != block, true, "new block");
+            TEST_RESULT_PTR(memContextArena(arenaContext)->block->prior, block, "prior block");
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("child contexts are carved from the arena");
+
+            MemContext *child = NULL;
+            MemContext *parent = NULL;
+
+            MEM_CONTEXT_NEW_BEGIN("child", .allocQty = 1)
+            {
+                child = MEM_CONTEXT_NEW();
+                memNew(8);
+            }
+            MEM_CONTEXT_NEW_END();
+
+            TEST_RESULT_BOOL(child->arena, true, "child is in arena");
+            TEST_RESULT_BOOL(child->arenaRoot, false, "child does not own arena");
+
+            MEM_CONTEXT_TEMP_ARENA_BEGIN()
+            {
+                TEST_RESULT_BOOL(MEM_CONTEXT_TEMP()->arenaRoot, false, "nested arena uses outer arena");
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("contexts can only be moved within the arena");
+
+            TEST_ERROR(memContextMove(child, memContextTop()), AssertError, "cannot move context out of arena");
+
+            MEM_CONTEXT_NEW_BEGIN("parent", .childQty = MEM_CONTEXT_QTY_MAX)
+            {
+                parent = MEM_CONTEXT_NEW();
+            }
+            MEM_CONTEXT_NEW_END();
+
+            TEST_RESULT_VOID(memContextMove(child, parent), "move within arena");
+            TEST_RESULT_PTR(child->contextParent, parent, "check parent");
+
+            // -----------------------------------------------------------------------------------------------------------------
+            TEST_TITLE("context created outside the arena can be moved into the arena");
+
+            MemContext *outside = NULL;
+
+            MEM_CONTEXT_BEGIN(memContextTop())
+            {
+                MEM_CONTEXT_NEW_BEGIN("outside", .allocQty = 1)
+                {
+                    outside = MEM_CONTEXT_NEW();
+                    memNew(8);
+                }
+                MEM_CONTEXT_NEW_END();
+            }
+            MEM_CONTEXT_END();
+
+            TEST_RESULT_BOOL(outside->arena, false, "context is not in arena");
+            TEST_RESULT_VOID(memContextMove(outside, parent), "move into arena");
+            TEST_RESULT_BOOL(memContextSize(arenaContext) > MEM_CONTEXT_ARENA_BLOCK_SIZE, true, "check size");
+
+            statEnd = memContextStat();
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        // Blocks, the context that owns the arena, and the context moved into the arena along with its allocation are freed
+        const uint64_t freeTotal = memContextStat().freeTotal - statEnd.freeTotal;
+
+        TEST_RESULT_UINT(freeTotal, statEnd.arenaBlockTotal - statBegin.arenaBlockTotal + 3, "check free total");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("large first allocation");
+
+        // Use a context with a single allocation so the large allocation is the first carved from the arena
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            MEM_CONTEXT_NEW_BEGIN(testArenaLarge, .allocQty = 1, .arena = true)
+            {
+                memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE);
+
+                TEST_RESULT_UINT(
+                    memContextArena(MEM_CONTEXT_NEW())->block->size, MEM_CONTEXT_ARENA_BLOCK_SIZE + sizeof(MemContextAlloc),
+                    "block sized for allocation");
+                TEST_RESULT_UINT(
+                    memContextArena(MEM_CONTEXT_NEW())->blockUsed, MEM_CONTEXT_ARENA_BLOCK_SIZE + sizeof(MemContextAlloc),
+                    "block is full");
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("memContextAudit*s()"))
     {
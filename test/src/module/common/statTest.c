@@ -30,6 +30,11 @@ testRun(void)
 
         TEST_RESULT_STR_Z(
             statToJson(), "{\"http.session\":{\"total\":1},\"tls.client\":{\"total\":2}}", "stat output");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("memory stats");
+
+        TEST_RESULT_BOOL(strBeginsWithZ(statMemToJson(), "{\"mem.alloc\":{\"total\":"), true, "mem stat output");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
@@ -253,6 +253,37 @@ testRun(void)
         TEST_RESULT_UINT(cfgOptionUInt64(cfgOptProtocolTimeout), 11000, "check protocol-timeout");
         TEST_RESULT_UINT(cfgOptionUInt64(cfgOptDbTimeout), 5500, "check db-timeout");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("archive-push-linger must be less than protocol-timeout");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argList, cfgOptArchivePushLinger, "30");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+        TEST_RESULT_UINT(cfgOptionUInt64(cfgOptArchivePushLinger), 30000, "check archive-push-linger");
+
+        hrnCfgArgRawZ(argList, cfgOptProtocolTimeout, "30");
+        TEST_ERROR(
+            hrnCfgLoadP(cfgCmdArchivePush, argList), OptionInvalidValueError,
+            "'30' is not valid for 'archive-push-linger' option\n"
+            "HINT 'archive-push-linger' option (30) should be less than 'protocol-timeout' option (30).");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("archive-get-linger must be less than protocol-timeout");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/pg1");
+        hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetLinger, "60");
+        hrnCfgArgRawZ(argList, cfgOptProtocolTimeout, "45");
+        TEST_ERROR(
+            hrnCfgLoadP(cfgCmdArchiveGet, argList), OptionInvalidValueError,
+            "'60' is not valid for 'archive-get-linger' option\n"
+            "HINT 'archive-get-linger' option (60) should be less than 'protocol-timeout' option (45).");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("pg and repo cannot both be remote");
 
@@ -588,6 +619,43 @@ testRun(void)
             "P00   WARN: 'compress' and 'compress-type' options should not both be set\n"
             "            HINT: 'compress-type' is preferred and 'compress' is deprecated.");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress-level-network default when compress-type-network = gz or none");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+        TEST_RESULT_UINT(cfgOptionStrId(cfgOptCompressTypeNetwork), CFGOPTVAL_COMPRESS_TYPE_NETWORK_GZ, "compress-type-network=gz");
+        TEST_RESULT_UINT(cfgOptionUInt(cfgOptCompressLevelNetwork), 3, "compress-level-network=3");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argList, cfgOptCompressTypeNetwork, "none");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+        TEST_RESULT_UINT(cfgOptionUInt(cfgOptCompressLevelNetwork), 3, "compress-level-network=3");
+
+#ifdef HAVE_LIBLZ4
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress-level-network default when compress-type-network = lz4");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argList, cfgOptCompressTypeNetwork, "lz4");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+        TEST_RESULT_UINT(cfgOptionUInt(cfgOptCompressLevelNetwork), 1, "compress-level-network=1");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argList, cfgOptCompressTypeNetwork, "lz4");
+        hrnCfgArgRawZ(argList, cfgOptCompressLevelNetwork, "5");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+        TEST_RESULT_UINT(cfgOptionUInt(cfgOptCompressLevelNetwork), 5, "compress-level-network=5");
+#endif
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("S3 default chunk size");
 
@@ -643,6 +711,32 @@ testRun(void)
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoAzureAccount, 1);
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoAzureKey, 1);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on block store with encryption");
+
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, "xxx");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/path/to/pg");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 1, "/repo1");
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBundle, 1, true);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlock, 1, true);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlockStore, 1, true);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 1, "1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 2, "/repo2");
+        hrnCfgArgKeyRawStrId(argList, cfgOptRepoCipherType, 2, cipherTypeAes256Cbc);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBundle, 2, true);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlock, 2, true);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlockStore, 2, true);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 2, "1");
+
+        TEST_ERROR(
+            hrnCfgLoadP(cfgCmdBackup, argList), OptionInvalidError,
+            "option 'repo2-block-store' not valid with option 'repo2-cipher-type'");
+
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+
         // -------------------------------------------------------------------------------------------------------------------------
 #ifdef HAVE_LIBSSH2
         TEST_TITLE("error on missing SFTP fingerprint");
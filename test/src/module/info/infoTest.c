@@ -80,9 +80,14 @@ testRun(void)
 
         TEST_ASSIGN(info, infoNew(STRDEF("123xyz")), "infoNew(cipher)");
         TEST_RESULT_STR_Z(infoCipherPass(info), "123xyz", "    cipherPass is set");
+        TEST_RESULT_UINT(infoCipherType(info), cipherTypeAes256Cbc, "    cipherType is default");
+
+        TEST_RESULT_VOID(infoCipherTypeSet(info, cipherTypeAes256Gcm), "set cipherType");
+        TEST_RESULT_UINT(infoCipherType(info), cipherTypeAes256Gcm, "    cipherType is set");
 
         TEST_ASSIGN(info, infoNew(NULL), "infoNew(NULL)");
         TEST_RESULT_STR(infoCipherPass(info), NULL, "    cipherPass is NULL");
+        TEST_RESULT_UINT(infoCipherType(info), cipherTypeNone, "    cipherType is none");
     }
 
     // *****************************************************************************************************************************
@@ -197,12 +202,71 @@ testRun(void)
             infoNewLoad(ioBufferReadNew(contentLoad), harnessInfoLoadNewCallback, callbackContent), "info with content and cipher");
         TEST_RESULT_STR_Z(callbackContent, "[c] key=1\n[d] key=1\n", "    check callback content");
         TEST_RESULT_STR_Z(infoCipherPass(info), "somepass", "    check cipher pass set");
+        TEST_RESULT_UINT(infoCipherType(info), cipherTypeAes256Cbc, "    check cipher type default");
         TEST_RESULT_STR_Z(infoBackrestVersion(info), PROJECT_VERSION, "    check backrest version");
 
         contentSave = bufNew(0);
 
         TEST_RESULT_VOID(infoSave(info, ioBufferWriteNew(contentSave), testInfoSaveCallback, strNewZ("1")), "info save");
         TEST_RESULT_STR(strNewBuf(contentSave), strNewBuf(contentLoad), "   check save");
+
+        // File with cipher type
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_VOID(infoCipherTypeSet(info, cipherTypeAes256Gcm), "set cipher type");
+
+        contentSave = bufNew(0);
+
+        TEST_RESULT_VOID(infoSave(info, ioBufferWriteNew(contentSave), testInfoSaveCallback, strNewZ("1")), "info save");
+        TEST_RESULT_BOOL(strBeginsWithZ(strNewBuf(contentSave), "[backrest]\nbackrest-format=6\n"), true, "    check format");
+
+        contentLoad = contentSave;
+
+        TEST_ASSIGN(
+            info, infoNewLoad(ioBufferReadNew(contentLoad), harnessInfoLoadNewCallback, strNew()), "info with cipher type");
+        TEST_RESULT_STR_Z(infoCipherPass(info), "somepass", "    check cipher pass set");
+        TEST_RESULT_UINT(infoCipherType(info), cipherTypeAes256Gcm, "    check cipher type set");
+
+        contentSave = bufNew(0);
+
+        TEST_RESULT_VOID(infoSave(info, ioBufferWriteNew(contentSave), testInfoSaveCallback, strNewZ("1")), "info save");
+        TEST_RESULT_STR(strNewBuf(contentSave), strNewBuf(contentLoad), "   check save");
+
+        // File with cipher type and a format that does not store it
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            infoNewLoad(
+                ioBufferReadNew(
+                    harnessInfoChecksumZ(
+                        "[cipher]\n"
+                        "cipher-pass=\"somepass\"\n"
+                        "cipher-type=\"aes-256-gcm\"\n")),
+                harnessInfoLoadNewCallback, strNew()),
+            FormatError, "format does not match cipher type");
+
+        // File with a format that stores the cipher type but without the cipher type
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            infoNewLoad(
+                ioBufferReadNew(
+                    BUFSTRDEF(
+                        "[backrest]\n"
+                        "backrest-format=6\n"
+                        "\n"
+                        "[cipher]\n"
+                        "cipher-pass=\"somepass\"\n")),
+                harnessInfoLoadNewCallback, strNew()),
+            FormatError, "format does not match cipher type");
+
+        // File with invalid cipher type
+        // -------------------------------------------------------------------------------------------------------------------------
+        contentLoad = harnessInfoChecksumZ(
+            "[cipher]\n"
+            "cipher-pass=\"somepass\"\n"
+            "cipher-type=\"bogus\"\n");
+
+        TEST_ERROR(
+            infoNewLoad(ioBufferReadNew(contentLoad), harnessInfoLoadNewCallback, strNew()), FormatError,
+            "invalid cipher type 'bogus'");
     }
 
     // *****************************************************************************************************************************
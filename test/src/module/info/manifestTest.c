@@ -289,7 +289,7 @@ testRun(void)
         TEST_ERROR(
             manifestNewBuild(
                 storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, exclusionList,
-                pckWriteResult(tablespaceList)),
+                pckWriteResult(tablespaceList), NULL),
             AssertError,
             "tablespace with oid 1 not found in tablespace map\n"
             "HINT: was a tablespace created or dropped during the backup?");
@@ -314,7 +314,7 @@ testRun(void)
             manifest,
             manifestNewBuild(
                 storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL,
-                pckWriteResult(tablespaceList)),
+                pckWriteResult(tablespaceList), NULL),
             "build manifest");
         TEST_RESULT_VOID(manifestBackupLabelSet(manifest, STRDEF("20190818-084502F")), "backup label set");
 
@@ -410,7 +410,7 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, true, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, true, false, false, false, NULL, NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -483,7 +483,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_96, hrnPgCatalogVersion(PG_VERSION_96), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_96, hrnPgCatalogVersion(PG_VERSION_96), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             LinkDestinationError,
             "link 'pg_xlog/wal' (" TEST_PATH "/wal) destination is the same directory as link 'pg_xlog' (" TEST_PATH "/wal)");
 
@@ -539,7 +540,7 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, true, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, true, false, false, NULL, NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -634,7 +635,8 @@ testRun(void)
         // Tablespace link errors when correct verion not found
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             FileOpenError, "unable to get info for missing path/file '" TEST_PATH "/pg/pg_tblspc/1/PG_12_201909212'");
 
         // Remove the link inside pg/pg_tblspc
@@ -653,7 +655,7 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, true, false, true, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, true, false, true, false, NULL, NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -780,7 +782,7 @@ testRun(void)
             manifest,
             manifestNewBuild(
                 storagePg, PG_VERSION_13, hrnPgCatalogVersion(PG_VERSION_13), 1570000000, false, false, true, true,
-                &manifestBuildBlockIncrMap, NULL, NULL),
+                &manifestBuildBlockIncrMap, NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -855,7 +857,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             LinkDestinationError, "link 'link' destination '" TEST_PATH "/pg/base' is in PGDATA");
 
         THROW_ON_SYS_ERROR(unlink(TEST_PATH "/pg/link") == -1, FileRemoveError, "unable to remove symlink");
@@ -867,7 +870,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             LinkExpectedError, "'pg_data/pg_tblspc/somedir' is not a symlink - pg_tblspc should contain only symlinks");
 
         HRN_STORAGE_PATH_REMOVE(storagePgWrite, MANIFEST_TARGET_PGTBLSPC "/somedir");
@@ -879,7 +883,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             LinkExpectedError, "'pg_data/pg_tblspc/somefile' is not a symlink - pg_tblspc should contain only symlinks");
 
         TEST_STORAGE_EXISTS(storagePgWrite, MANIFEST_TARGET_PGTBLSPC "/somefile", .remove = true);
@@ -891,7 +896,7 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, true, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, true, false, false, NULL, NULL, NULL, NULL),
             FileOpenError, "unable to get info for missing path/file '" TEST_PATH "/pg/link-to-link'");
 
         THROW_ON_SYS_ERROR(unlink(TEST_PATH "/pg/link-to-link") == -1, FileRemoveError, "unable to remove symlink");
@@ -907,7 +912,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                NULL),
             LinkDestinationError, "link '" TEST_PATH "/pg/linktolink' cannot reference another link '" TEST_PATH "/linktest'");
 
         #undef TEST_MANIFEST_HEADER
@@ -925,6 +931,135 @@ testRun(void)
         #undef TEST_MANIFEST_PATH_DEFAULT
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("manifestNewBuild() with build cache"))
+    {
+        const Storage *const storagePg = storagePosixNewP(STRDEF(TEST_PATH "/pg"));
+        const Storage *const storagePgWrite = storagePosixNewP(STRDEF(TEST_PATH "/pg"), .write = true);
+
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_FILE_PGVERSION, "9.4\n", .timeModified = 1565282100);
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_PATH_BASE "/1/2", "DATA", .timeModified = 1565282100);
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_PATH_BASE "/1/3", "DATA", .timeModified = 1565282100);
+        HRN_STORAGE_TIME(storagePgWrite, PG_PATH_BASE "/1", 1565282100);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("build with empty cache");
+
+        ManifestBuildCache *buildCache = manifestBuildCacheNew();
+        Manifest *manifest = NULL;
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 3, "file total");
+        TEST_RESULT_UINT(manifestBuildCacheSize(buildCache), 3, "cache size");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("cached listing is used when path is not modified but files are still checked");
+
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_PATH_BASE "/1/2", "DATADATA", .timeModified = 1565282101);
+        HRN_STORAGE_REMOVE(storagePgWrite, PG_PATH_BASE "/1/3");
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_PATH_BASE "/1/4", "DATA", .timeModified = 1565282100);
+        HRN_STORAGE_TIME(storagePgWrite, PG_PATH_BASE "/1", 1565282100);
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 2, "file total");
+        TEST_RESULT_UINT(manifestFileFind(manifest, STRDEF("pg_data/base/1/2")).size, 8, "file size updated");
+        TEST_RESULT_BOOL(manifestFileExists(manifest, STRDEF("pg_data/base/1/4")), false, "new file not listed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("path is listed when modified");
+
+        HRN_STORAGE_TIME(storagePgWrite, PG_PATH_BASE "/1", 1565282101);
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 3, "file total");
+        TEST_RESULT_BOOL(manifestFileExists(manifest, STRDEF("pg_data/base/1/4")), true, "new file listed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("path is listed when modification time is not before the prior listing");
+
+        HRN_STORAGE_TIME(storagePgWrite, PG_PATH_BASE "/1", 4000000000);
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+
+        HRN_STORAGE_PUT_Z(storagePgWrite, PG_PATH_BASE "/1/5", "DATA", .timeModified = 1565282100);
+        HRN_STORAGE_TIME(storagePgWrite, PG_PATH_BASE "/1", 4000000000);
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 4, "file total");
+        TEST_RESULT_BOOL(manifestFileExists(manifest, STRDEF("pg_data/base/1/5")), true, "new file listed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("removed path is removed from cache");
+
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite, PG_PATH_BASE "/1", .recurse = true);
+
+        TEST_ASSIGN(
+            manifest,
+            manifestNewBuild(
+                storagePg, PG_VERSION_94, hrnPgCatalogVersion(PG_VERSION_94), 0, false, false, false, false, NULL, NULL, NULL,
+                buildCache),
+            "build manifest");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 1, "file total");
+        TEST_RESULT_UINT(manifestBuildCacheSize(buildCache), 2, "cache size");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("save and load cache");
+
+        Buffer *const buffer = bufNew(0);
+        IoWrite *write = ioBufferWriteNewOpen(buffer);
+
+        TEST_RESULT_VOID(manifestBuildCacheSave(buildCache, write), "save cache");
+        ioWriteClose(write);
+        TEST_RESULT_VOID(manifestBuildCacheFree(buildCache), "free cache");
+
+        TEST_ASSIGN(buildCache, manifestBuildCacheNewLoad(ioBufferReadNewOpen(buffer)), "load cache");
+        TEST_RESULT_UINT(manifestBuildCacheSize(buildCache), 2, "cache size");
+
+        Buffer *const bufferLoad = bufNew(0);
+
+        write = ioBufferWriteNewOpen(bufferLoad);
+
+        TEST_RESULT_VOID(manifestBuildCacheSave(buildCache, write), "save loaded cache");
+        ioWriteClose(write);
+        TEST_RESULT_BOOL(bufEq(buffer, bufferLoad), true, "loaded cache matches");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("cache with a different version is ignored");
+
+        PackWrite *const pack = pckWriteNewP();
+
+        pckWriteU32P(pack, 999);
+        pckWriteEndP(pack);
+
+        TEST_ASSIGN(buildCache, manifestBuildCacheNewLoad(ioBufferReadNewOpen(pckToBuf(pckWriteResult(pack)))), "load cache");
+        TEST_RESULT_UINT(manifestBuildCacheSize(buildCache), 0, "cache size");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("manifestBuildValidate()"))
     {
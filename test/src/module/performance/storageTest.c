@@ -7,13 +7,21 @@ Generally speaking, the starting values should be high enough to "blow up" in te
 problems without taking very long if everything is running smoothly. These starting values can then be scaled up for profiling and
 stress testing as needed.
 ***********************************************************************************************************************************/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "common/harnessConfig.h"
 #include "common/harnessFork.h"
 #include "common/harnessStorage.h"
 
+#include "command/backup/common.h"
+#include "command/backup/file.h"
 #include "common/compress/gz/compress.h"
 #include "common/compress/lz4/compress.h"
 #include "common/crypto/hash.h"
+#include "common/crypto/xxhash.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
 #include "common/io/fdRead.h"
@@ -110,6 +118,46 @@ testIoRateNew(uint64_t bytesPerSec)
     return ioFilterNewP(STRID5("test-io-rate", 0x2d032dbd3ba4cb40), this, NULL, .in = testIoRateProcess);
 }
 
+/***********************************************************************************************************************************
+Get the percentage of a file that is resident in the page cache. mincore() is not part of POSIX so it must be declared here.
+***********************************************************************************************************************************/
+int mincore(void *addr, size_t length, unsigned char *vec);
+
+static unsigned int
+testCacheResident(const String *file)
+{
+    unsigned int result = 0;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const int fd = open(strZ(file), O_RDONLY);
+        ASSERT(fd != -1);
+
+        const size_t size = (size_t)lseek(fd, 0, SEEK_END);
+        const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        const size_t pageTotal = (size_t)(size + pageSize - 1) / pageSize;
+
+        void *const map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+        ASSERT(map != MAP_FAILED);
+
+        Buffer *const vec = bufNew(pageTotal);
+        ASSERT(mincore(map, size, bufPtr(vec)) == 0);
+
+        size_t pageResident = 0;
+
+        for (size_t pageIdx = 0; pageIdx < pageTotal; pageIdx++)
+            pageResident += bufPtr(vec)[pageIdx] & 1;
+
+        munmap(map, size);
+        close(fd);
+
+        result = (unsigned int)(pageResident * 100 / pageTotal);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    return result;
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -178,7 +226,7 @@ testRun(void)
 
                 // Create remote storage
                 Storage *storageRemote = storageRemoteNew(
-                    STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, false, NULL, client, 1);
+                    STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, false, NULL, client, compressTypeGz, 1);
 
                 TimeMSec timeBegin = timeMSec();
 
@@ -271,6 +319,7 @@ testRun(void)
         uint64_t md5Total = 1;
         uint64_t sha1Total = 1;
         uint64_t sha256Total = 1;
+        uint64_t xxHashTotal = 1;
         uint64_t gzip6Total = 1;
 
 #ifdef HAVE_LIBLZ4
@@ -322,13 +371,24 @@ testRun(void)
             }
             MEM_CONTEXT_TEMP_END();
 
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("xxhash iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(xxHashNew(XX_HASH_SIZE_MAX));
+                BENCHMARK_END(xxHashTotal);
+            }
+            MEM_CONTEXT_TEMP_END();
+
             // -------------------------------------------------------------------------------------------------------------------------
             TEST_LOG_FMT("gzip -6 iteration %u", idx + 1);
 
             MEM_CONTEXT_TEMP_BEGIN()
             {
                 BENCHMARK_BEGIN();
-                BENCHMARK_FILTER_ADD(gzCompressNew(6, false));
+                BENCHMARK_FILTER_ADD(gzCompressNew(6, false, 0));
                 BENCHMARK_END(gzip6Total);
             }
             MEM_CONTEXT_TEMP_END();
@@ -340,7 +400,7 @@ testRun(void)
             MEM_CONTEXT_TEMP_BEGIN()
             {
                 BENCHMARK_BEGIN();
-                BENCHMARK_FILTER_ADD(lz4CompressNew(1, false));
+                BENCHMARK_FILTER_ADD(lz4CompressNew(1, false, 0));
                 BENCHMARK_END(lz41Total);
             }
             MEM_CONTEXT_TEMP_END();
@@ -359,6 +419,7 @@ testRun(void)
         TEST_RESULT("md5", md5Total);
         TEST_RESULT("sha1", sha1Total);
         TEST_RESULT("sha256", sha256Total);
+        TEST_RESULT("xxhash", xxHashTotal);
         TEST_RESULT("gzip -6", gzip6Total);
 
 #ifdef HAVE_LIBLZ4
@@ -366,5 +427,159 @@ testRun(void)
 #endif // HAVE_LIBLZ4
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("benchmark page cache hints"))
+    {
+        // 4MB buffers are the current default
+        ioBufferSizeSet(4 * 1024 * 1024);
+
+        // Write and read 64MiB for each unit of scale
+        ASSERT(TEST_SCALE <= 1024);
+        const size_t fileSize = (size_t)64 * 1024 * 1024 * TEST_SCALE;
+
+        Buffer *const input = bufNew(fileSize);
+        memset(bufPtr(input), 0xAA, fileSize);
+        bufUsedSet(input, fileSize);
+
+        const Storage *const storageTest = storagePosixNewP(STRDEF(TEST_PATH), .write = true);
+        const String *const file = STRDEF(TEST_PATH "/cache.bin");
+
+        for (unsigned int cacheDropIdx = 0; cacheDropIdx < 2; cacheDropIdx++)
+        {
+            const bool cacheDrop = cacheDropIdx == 1;
+            ioCacheDropSet(cacheDrop);
+
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_TITLE_FMT("%zuMiB with cache drop %s", fileSize / 1024 / 1024, cvtBoolToConstZ(cacheDrop));
+
+            uint64_t timeBegin = timeMSec();
+            storagePutP(storageNewWriteP(storageTest, file), input);
+
+            TEST_LOG_FMT("write time %" PRIu64 "ms, resident %u%%", timeMSec() - timeBegin, testCacheResident(file));
+
+            timeBegin = timeMSec();
+            storageGetP(storageNewReadP(storageTest, file));
+
+            TEST_LOG_FMT("read time %" PRIu64 "ms, resident %u%%", timeMSec() - timeBegin, testCacheResident(file));
+
+            storageRemoveP(storageTest, file, .errorOnMissing = true);
+        }
+
+        ioCacheDropSet(false);
+    }
+
+    // The checksum of a split file is calculated by the merge, which reads the ranges back from the repository in a single process.
+    // Compare the time to copy the file whole to the time to copy the ranges and merge them.
+    // *****************************************************************************************************************************
+    if (testBegin("benchmark block incremental split"))
+    {
+        // 4MB buffers are the current default
+        ioBufferSizeSet(4 * 1024 * 1024);
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // Write 64MiB for each unit of scale and split it into four ranges. Half of each page is random so the data compresses about
+        // as well as a typical relation.
+        ASSERT(TEST_SCALE <= 1024);
+        const uint64_t fileSize = (uint64_t)64 * 1024 * 1024 * TEST_SCALE;
+        const uint64_t rangeSize = fileSize / 4;
+
+        Buffer *const input = bufNew((size_t)fileSize);
+        memset(bufPtr(input), 0, (size_t)fileSize);
+
+        for (size_t byteIdx = 0; byteIdx < fileSize; byteIdx += 2)
+            bufPtr(input)[byteIdx] = (unsigned char)rand();
+
+        bufUsedSet(input, (size_t)fileSize);
+        HRN_STORAGE_PUT(storagePgWrite(), "relation", input);
+
+        const String *const backupLabel = STRDEF("20191107-041320F");
+        const String *const manifestFile = STRDEF("pg_data/relation");
+        StringList *const referenceList = strLstNew();
+        strLstAdd(referenceList, backupLabel);
+
+        BackupFile file =
+        {
+            .pgFile = STRDEF("relation"),
+            .pgFileSize = fileSize,
+            .pgFileSizeOriginal = fileSize,
+            .pgFileCopyExactSize = true,
+            .blockIncrSize = 16 * 1024,
+            .blockIncrChecksumSize = 6,
+            .blockIncrSuperSize = 1024 * 1024,
+            .manifestFile = manifestFile,
+        };
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE_FMT("%" PRIu64 "MiB copied whole", fileSize / 1024 / 1024);
+
+        List *fileList = lstNewP(sizeof(BackupFile));
+        lstAdd(fileList, &file);
+
+        TimeMSec timeBegin = timeMSec();
+
+        backupFile(
+            backupFileRepoPathP(backupLabel, .manifestName = manifestFile, .blockIncr = true), 0, true, 0, false, compressTypeGz, 6, 0,
+            cipherTypeNone, NULL, NULL, pgPageSize8, fileList);
+
+        TEST_LOG_FMT("copy time %" PRIu64 "ms", timeMSec() - timeBegin);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE_FMT("%" PRIu64 "MiB copied in four ranges and merged", fileSize / 1024 / 1024);
+
+        List *const rangeList = lstNewP(sizeof(BackupFileRange));
+        TimeMSec rangeTimeMax = 0;
+
+        for (unsigned int rangeIdx = 0; rangeIdx < 4; rangeIdx++)
+        {
+            file.pgFileOffset = rangeIdx * rangeSize;
+            file.pgFileRangeSize = rangeSize;
+
+            fileList = lstNewP(sizeof(BackupFile));
+            lstAdd(fileList, &file);
+
+            const String *const repoFile = backupFileRepoPathP(backupLabel, .bundleId = rangeIdx + 1);
+
+            timeBegin = timeMSec();
+
+            const BackupFileResult *const result = lstGet(
+                backupFile(
+                    repoFile, rangeIdx + 1, true, 0, false, compressTypeGz, 6, 0, cipherTypeNone, NULL, NULL, pgPageSize8, fileList),
+                0);
+
+            const TimeMSec rangeTime = timeMSec() - timeBegin;
+
+            if (rangeTime > rangeTimeMax)
+                rangeTimeMax = rangeTime;
+
+            const BackupFileRange range =
+            {
+                .repoFile = repoFile,
+                .backupCopyResult = result->backupCopyResult,
+                .copySize = result->copySize,
+                .repoSize = result->repoSize,
+                .blockIncrMapSize = result->blockIncrMapSize,
+            };
+
+            lstAdd(rangeList, &range);
+        }
+
+        timeBegin = timeMSec();
+
+        backupFileMerge(
+            backupFileRepoPathP(backupLabel, .manifestName = manifestFile, .blockIncr = true), compressTypeGz, cipherTypeNone, NULL,
+            referenceList, rangeSize, &file, rangeList);
+
+        const TimeMSec mergeTime = timeMSec() - timeBegin;
+
+        TEST_LOG_FMT(
+            "slowest range %" PRIu64 "ms, merge %" PRIu64 "ms, total with four processes %" PRIu64 "ms", rangeTimeMax, mergeTime,
+            rangeTimeMax + mergeTime);
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
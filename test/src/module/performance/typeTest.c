@@ -19,6 +19,7 @@ running out of memory on the test systems or taking an undue amount of time. It
 #include "common/type/list.h"
 #include "common/type/object.h"
 #include "info/manifest.h"
+#include "postgres/interface.h"
 #include "postgres/version.h"
 #include "storage/posix/storage.h"
 
@@ -41,6 +42,7 @@ typedef struct
 {
     STORAGE_COMMON_MEMBER;
     uint64_t fileTotal;
+    unsigned int listTotal;                                         // Number of paths listed
 } StorageTestManifestNewBuild;
 
 STRING_STATIC(TEST_MANIFEST_PATH_USER_STR,                          "test");
@@ -68,6 +70,18 @@ storageTestManifestNewBuildInfo(THIS_VOID, const String *file, StorageInfoLevel
     {
         result.type = storageTypePath;
     }
+    // Paths and files are only checked individually when the build cache is used
+    else if (strEq(file, STRDEF("/pg/base")) || strEq(file, STRDEF("/pg/base/1000000000")))
+    {
+        result.mode = 0700;
+        result.timeModified = 1595627966;
+    }
+    else if (strBeginsWithZ(file, "/pg/base/1000000000/"))
+    {
+        result.type = storageTypeFile;
+        result.size = 8192;
+        result.timeModified = 1595627966;
+    }
     else
         THROW_FMT(AssertError, "unhandled file info '%s'", strZ(file));
 
@@ -84,6 +98,7 @@ storageTestManifestNewBuildList(THIS_VOID, const String *path, StorageInfoLevel
     (void)param;
 
     StorageList *const result = storageLstNew(storageInfoLevelDetail);
+    this->listTotal++;
 
     MEM_CONTEXT_TEMP_RESET_BEGIN()
     {
@@ -97,6 +112,7 @@ storageTestManifestNewBuildList(THIS_VOID, const String *path, StorageInfoLevel
             .groupId = 100,
             .user = STRDEF("test"),
             .group = STRDEF("test"),
+            .timeModified = 1595627966,
         };
 
         if (strEq(path, STRDEF("/pg")))
@@ -271,7 +287,8 @@ testRun(void)
         MEM_CONTEXT_BEGIN(testContext)
         {
             TEST_ASSIGN(
-                manifest, manifestNewBuild(storagePg, PG_VERSION_15, 999999999, 0, false, false, false, false, NULL, NULL, NULL),
+                manifest,
+                manifestNewBuild(storagePg, PG_VERSION_15, 999999999, 0, false, false, false, false, NULL, NULL, NULL, NULL),
                 "build files");
         }
         MEM_CONTEXT_END();
@@ -323,6 +340,59 @@ testRun(void)
         }
 
         TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        memContextFree(testContext);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("build manifest with empty build cache");
+
+        ManifestBuildCache *const buildCache = manifestBuildCacheNew();
+        testContext = memContextNewP("test", .childQty = MEM_CONTEXT_QTY_MAX);
+        memContextKeep();
+        driver->listTotal = 0;
+        timeBegin = timeMSec();
+
+        MEM_CONTEXT_BEGIN(testContext)
+        {
+            TEST_ASSIGN(
+                manifest,
+                manifestNewBuild(storagePg, PG_VERSION_15, 999999999, 0, false, false, false, false, NULL, NULL, NULL, buildCache),
+                "build files");
+        }
+        MEM_CONTEXT_END();
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        TEST_RESULT_UINT(manifestFileTotal(manifest), driver->fileTotal, "   check file total");
+        TEST_RESULT_UINT(driver->listTotal, 3, "   check paths listed");
+        TEST_RESULT_UINT(manifestBuildCacheSize(buildCache), 3, "   check paths cached");
+
+        memContextFree(testContext);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("build manifest with build cache");
+
+        testContext = memContextNewP("test", .childQty = MEM_CONTEXT_QTY_MAX);
+        memContextKeep();
+        driver->listTotal = 0;
+        timeBegin = timeMSec();
+
+        MEM_CONTEXT_BEGIN(testContext)
+        {
+            TEST_ASSIGN(
+                manifest,
+                manifestNewBuild(storagePg, PG_VERSION_15, 999999999, 0, false, false, false, false, NULL, NULL, NULL, buildCache),
+                "build files");
+        }
+        MEM_CONTEXT_END();
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        TEST_RESULT_UINT(manifestFileTotal(manifest), driver->fileTotal, "   check file total");
+        TEST_RESULT_UINT(driver->listTotal, 0, "   check paths listed");
+
+        memContextFree(testContext);
+        manifestBuildCacheFree(buildCache);
     }
 
     // Make sure statistics collector performs well
@@ -354,6 +424,36 @@ testRun(void)
         TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
     }
 
+    // Make sure page checksums perform well since every page is checksummed during backup when checksum-page is enabled
+    // *****************************************************************************************************************************
+    if (testBegin("pgPageChecksum()"))
+    {
+        ASSERT(TEST_SCALE <= 1000000);
+
+        // Fill a page with data that is different for every lane of the parallel sums
+        unsigned char page[pgPageSize8];
+
+        for (unsigned int pageIdx = 0; pageIdx < sizeof(page); pageIdx++)
+            page[pageIdx] = (unsigned char)(pageIdx * 31 + (pageIdx >> 8));
+
+        const uint64_t runTotal = (uint64_t)TEST_SCALE * (uint64_t)100000;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE_FMT("checksum %" PRIu64 " 8KiB pages", runTotal);
+
+        const TimeMSec timeBegin = timeMSec();
+        uint16_t checksum = 0;
+
+        for (uint64_t runIdx = 0; runIdx < runTotal; runIdx++)
+            checksum ^= pgPageChecksum(page, (uint32_t)runIdx, pgPageSize8);
+
+        const TimeMSec timeElapsed = timeMSec() - timeBegin;
+
+        TEST_LOG_FMT(
+            "completed in %ums (%" PRIu64 "MiB/s, checksum %04X)", (unsigned int)timeElapsed,
+            runTotal * pgPageSize8 / 1024 / 1024 * MSEC_PER_SEC / (timeElapsed == 0 ? 1 : timeElapsed), checksum);
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("SocketClient"))
     {
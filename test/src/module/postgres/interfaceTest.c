@@ -358,6 +358,34 @@ testRun(void)
         TEST_RESULT_STR_Z(pgXactPath(PG_VERSION_10), "pg_xact", "check pg_xact name");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("crc32cOne() and crc32cUpdate()"))
+    {
+        const unsigned char *const check = (const unsigned char *)"123456789";
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("check value");
+
+        TEST_RESULT_UINT(crc32cOne(check, 9), 0xE3069283, "crc32c");
+        TEST_RESULT_UINT(crc32cOne(check, 0), 0, "crc32c of no data");
+        TEST_RESULT_UINT(crc32cUpdate(crc32cOne(check, 4), check + 4, 5), 0xE3069283, "crc32c in two parts");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("each kernel");
+
+        TEST_RESULT_UINT(crc32cUpdateTable(0xffffffff, check, 9) ^ 0xffffffff, 0xE3069283, "table");
+
+#ifdef CRC32C_SSE42
+        if (__builtin_cpu_supports("sse4.2"))                       // {uncovered_branch - depends on CPU features}
+            TEST_RESULT_UINT(crc32cUpdateSse42(0xffffffff, check, 9) ^ 0xffffffff, 0xE3069283, "sse 4.2");
+#endif
+
+#ifdef CRC32C_ARMV8
+        if (getauxval(AT_HWCAP) & HWCAP_CRC32)                      // {uncovered_branch - depends on CPU features}
+            TEST_RESULT_UINT(crc32cUpdateArmv8(0xffffffff, check, 9) ^ 0xffffffff, 0xE3069283, "armv8 crc");
+#endif
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("pgPageChecksum()"))
     {
@@ -408,6 +436,23 @@ testRun(void)
                 pgPageChecksum(page, 999, sizeof(page)), TEST_BIG_ENDIAN() ? 0xF1B9 : 0x0EC3, "check 0xFF filled page, block 999");
         }
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("8KiB page checksum with varied content");
+        {
+            // Every lane of the parallel sums gets different data so a vectorized calculation that mixes up lanes will not match.
+            // The word containing pd_checksum is zeroed so the big-endian result can be calculated by swapping the bytes of each
+            // word.
+            unsigned char page[pgPageSize8];
+
+            for (unsigned int pageIdx = 0; pageIdx < sizeof(page); pageIdx++)
+                page[pageIdx] = (unsigned char)(pageIdx * 31 + (pageIdx >> 8));
+
+            memset(page + 8, 0, 4);
+
+            TEST_RESULT_UINT(pgPageChecksum(page, 0, sizeof(page)), TEST_BIG_ENDIAN() ? 0x257C : 0x4E38, "check block 0");
+            TEST_RESULT_UINT(pgPageChecksum(page, 999, sizeof(page)), TEST_BIG_ENDIAN() ? 0x2559 : 0x4DDB, "check block 999");
+        }
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("16KiB page checksum");
         {
@@ -103,8 +103,25 @@ testCommandRequestComplexProtocol(PackRead *const param, ProtocolServer *const s
 
         TEST_RESULT_BOOL(pckReadBoolP(protocolServerDataGet(server)), true, "data get");
         TEST_RESULT_UINT(pckReadModeP(protocolServerDataGet(server)), 0644, "data get");
-        TEST_RESULT_PTR(protocolServerDataGet(server), NULL, "data end get");
 
+        size_t rawSize = 0;
+        Buffer *const buffer = bufNew(8);
+        bufLimitSet(buffer, 4);
+
+        TEST_RESULT_PTR(protocolServerDataRawGet(server, &rawSize), NULL, "raw data get");
+        TEST_RESULT_UINT(rawSize, 7, "raw data size");
+        TEST_RESULT_UINT(protocolServerDataRawRead(server, buffer, rawSize), 4, "raw data read (buffer full)");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "RAWD", "raw data");
+        bufUsedZero(buffer);
+        TEST_RESULT_UINT(protocolServerDataRawRead(server, buffer, rawSize - 4), 3, "raw data read (limited)");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "ATA", "raw data");
+        TEST_RESULT_UINT(bufSize(buffer), 4, "buffer limit restored");
+        TEST_RESULT_BOOL(bufSizeLimit(buffer), true, "buffer still limited");
+
+        TEST_RESULT_PTR(protocolServerDataRawGet(server, &rawSize), NULL, "data end get");
+        TEST_RESULT_UINT(rawSize, 0, "not raw data");
+
+        TEST_RESULT_VOID(protocolServerDataRawPut(server, BUFSTRDEF("SERVER")), "raw data put");
         TEST_RESULT_VOID(protocolServerDataPut(server, pckWriteBoolP(protocolPackNew(), true)), "data put");
         TEST_RESULT_VOID(protocolServerDataPut(server, pckWriteI32P(protocolPackNew(), -1)), "data put");
         TEST_RESULT_VOID(protocolServerDataEndPut(server), "data end put");
@@ -371,6 +388,20 @@ testRun(void)
             " --pg1-path=/path/to/pg --process=0 --remote-type=repo --repo=1 --stanza=test1 archive-get:remote\n",
             "check config");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("share ssh connection");
+
+        hrnCfgArgRawZ(argList, cfgOptSshMux, "0.5");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .noStd = true);
+
+        TEST_RESULT_STRLST_Z(
+            protocolRemoteParamSsh(protocolStorageTypeRepo, 0),
+            "-o\nLogLevel=error\n-o\nCompression=no\n-o\nPasswordAuthentication=no\n-o\nControlMaster=auto\n"
+            "-o\nControlPath=~/.ssh/pgbackrest-%C\n-o\nControlPersist=1\nrepo-host-user@repo-host\n"
+            TEST_PROJECT_EXE " --exec-id=1-test --log-level-console=off --log-level-file=off --log-level-stderr=error"
+            " --pg1-path=/path/to/pg --process=0 --remote-type=repo --repo=1 --stanza=test1 archive-get:remote\n",
+            "check config");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("replace and exclude certain params for repo remote");
 
@@ -669,10 +700,23 @@ testRun(void)
                 // Write data to the server
                 TEST_RESULT_VOID(protocolClientDataPut(client, pckWriteBoolP(protocolPackNew(), true)), "data put");
                 TEST_RESULT_VOID(protocolClientDataPut(client, pckWriteModeP(protocolPackNew(), 0644)), "data put");
+                TEST_RESULT_VOID(protocolClientDataRawPut(client, BUFSTRDEF("RAWDATA")), "raw data put");
                 TEST_RESULT_VOID(protocolClientDataPut(client, NULL), "data end put");
 
+                // Get raw data from the server
+                size_t rawSize = 0;
+                Buffer *const buffer = bufNew(16);
+
+                TEST_RESULT_PTR(protocolClientDataRawGet(client, &rawSize), NULL, "raw data get");
+                TEST_RESULT_UINT(rawSize, 6, "raw data size");
+                TEST_RESULT_UINT(protocolClientDataRawRead(client, buffer, rawSize), 6, "raw data read");
+                TEST_RESULT_STR_Z(strNewBuf(buffer), "SERVER", "raw data");
+                TEST_RESULT_UINT(bufSize(buffer), 16, "buffer size restored");
+                TEST_RESULT_BOOL(bufSizeLimit(buffer), false, "buffer not limited");
+
                 // Get data from the server
-                TEST_RESULT_BOOL(pckReadBoolP(protocolClientDataGet(client)), true, "data get");
+                TEST_RESULT_BOOL(pckReadBoolP(protocolClientDataRawGet(client, &rawSize)), true, "data get");
+                TEST_RESULT_UINT(rawSize, 0, "not raw data");
                 TEST_RESULT_INT(pckReadI32P(protocolClientDataGet(client)), -1, "data get");
                 TEST_RESULT_VOID(protocolClientDataEndGet(client), "data end get");
 
@@ -712,6 +756,29 @@ testRun(void)
             HRN_FORK_PARENT_END();
         }
         HRN_FORK_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("raw data read EOF");
+
+        ProtocolServer *server = NULL;
+        TEST_ASSIGN(
+            server,
+            protocolServerNew(
+                STRDEF("test server"), STRDEF("test"), ioBufferReadNewOpen(bufNew(0)), ioBufferWriteNewOpen(bufNew(0))),
+            "new server");
+        TEST_ERROR(protocolServerDataRawRead(server, bufNew(8), 8), ProtocolError, "unexpected EOF reading raw data");
+
+        ProtocolClient *client = NULL;
+        TEST_ASSIGN(
+            client,
+            protocolClientNew(
+                STRDEF("test client"), STRDEF("test"),
+                ioBufferReadNewOpen(
+                    BUFSTRDEF("{\"name\":\"" PROJECT_NAME "\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}\n")),
+                ioBufferWriteNewOpen(bufNew(0))),
+            "new client");
+        protocolClientNoExit(client);
+        TEST_ERROR(protocolClientDataRawRead(client, bufNew(8), 8), ProtocolError, "unexpected EOF reading raw data");
     }
 
     // *****************************************************************************************************************************
@@ -946,6 +1013,15 @@ testRun(void)
                 TEST_RESULT_VOID(protocolServerDataPut(server, pckWriteU32P(protocolPackNew(), 1)), "data end put");
                 TEST_RESULT_VOID(protocolServerDataEndPut(server), "data end put");
 
+                // Commands for jobs that are made available while waiting for jobs
+                TEST_RESULT_UINT(protocolServerCommandGet(server).id, strIdFromZ("c-four"), "c-four command get");
+                TEST_RESULT_VOID(protocolServerDataPut(server, pckWriteU32P(protocolPackNew(), 4)), "data put");
+                TEST_RESULT_VOID(protocolServerDataEndPut(server), "data end put");
+
+                TEST_RESULT_UINT(protocolServerCommandGet(server).id, strIdFromZ("c-five"), "c-five command get");
+                TEST_RESULT_VOID(protocolServerDataPut(server, pckWriteU32P(protocolPackNew(), 5)), "data put");
+                TEST_RESULT_VOID(protocolServerDataEndPut(server), "data end put");
+
                 // Wait for exit
                 TEST_RESULT_UINT(protocolServerCommandGet(server).id, PROTOCOL_COMMAND_EXIT, "noop command get");
             }
@@ -982,7 +1058,7 @@ testRun(void)
             {
                 TestParallelJobCallback data = {.jobList = lstNewP(sizeof(ProtocolParallelJob *))};
                 ProtocolParallel *parallel = NULL;
-                TEST_ASSIGN(parallel, protocolParallelNew(2000, testParallelJobCallback, &data), "create parallel");
+                TEST_ASSIGN(parallel, protocolParallelNewP(2000, testParallelJobCallback, &data), "create parallel");
                 TEST_RESULT_VOID(
                     FUNCTION_LOG_OBJECT_FORMAT(parallel, protocolParallelToLog, logBuf, sizeof(logBuf)), "protocolParallelToLog");
                 TEST_RESULT_Z(logBuf, "{state: pending, clientTotal: 0, jobTotal: 0}", "check log");
@@ -1103,7 +1179,7 @@ testRun(void)
                 TEST_TITLE("process zero jobs");
 
                 data = (TestParallelJobCallback){.jobList = lstNewP(sizeof(ProtocolParallelJob *))};
-                TEST_ASSIGN(parallel, protocolParallelNew(2000, testParallelJobCallback, &data), "create parallel");
+                TEST_ASSIGN(parallel, protocolParallelNewP(2000, testParallelJobCallback, &data), "create parallel");
                 TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client[0]), "add client");
 
                 TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process zero jobs");
@@ -1111,6 +1187,36 @@ testRun(void)
 
                 TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("wait for jobs made available by results");
+
+                data = (TestParallelJobCallback){.jobList = lstNewP(sizeof(ProtocolParallelJob *))};
+                TEST_ASSIGN(
+                    parallel, protocolParallelNewP(2000, testParallelJobCallback, &data, .jobWait = true), "create parallel");
+                TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client[0]), "add client");
+
+                job = protocolParallelJobNew(varNewStr(STRDEF("job4")), protocolCommandNew(strIdFromZ("c-four")));
+                TEST_RESULT_VOID(lstAdd(data.jobList, &job), "add job");
+
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process jobs");
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_UINT(pckReadU32P(protocolParallelJobResult(job)), 4, "check result is 4");
+
+                // The client was not freed when no job was available so the job made available by the result can run
+                job = protocolParallelJobNew(varNewStr(STRDEF("job5")), protocolCommandNew(strIdFromZ("c-five")));
+                TEST_RESULT_VOID(lstAdd(data.jobList, &job), "add job");
+
+                TEST_RESULT_BOOL(protocolParallelDone(parallel), false, "check not done");
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR_Z(varStr(protocolParallelJobKey(job)), "job5", "check key is job5");
+                TEST_RESULT_UINT(pckReadU32P(protocolParallelJobResult(job)), 5, "check result is 5");
+
+                TEST_RESULT_BOOL(protocolParallelDone(parallel), true, "check done");
+
+                TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("free clients");
 
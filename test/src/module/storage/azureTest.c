@@ -209,6 +209,7 @@ testRun(void)
         TEST_RESULT_STR_Z(((StorageAzure *)storageDriver(storage))->host, TEST_ACCOUNT ".blob.core.windows.net", "check host");
         TEST_RESULT_STR_Z(((StorageAzure *)storageDriver(storage))->pathPrefix, "/" TEST_CONTAINER, "check path prefix");
         TEST_RESULT_UINT(((StorageAzure *)storageDriver(storage))->blockSize, 4 * 1024 * 1024, "check block size");
+        TEST_RESULT_UINT(((StorageAzure *)storageDriver(storage))->blockMax, 1, "check block max");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeaturePath), false, "check path feature");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -398,8 +399,8 @@ testRun(void)
             (StorageAzure *)storageDriver(
                 storageAzureNew(
                     STRDEF("/repo"), false, NULL, TEST_CONTAINER_STR, TEST_ACCOUNT_STR, storageAzureKeyTypeShared,
-                    TEST_KEY_SHARED_STR, 16, NULL, STRDEF("blob.core.windows.net"), storageAzureUriStyleHost, 443, 1000, true, NULL,
-                    NULL)),
+                    TEST_KEY_SHARED_STR, 16, 1, 1, NULL, STRDEF("blob.core.windows.net"), storageAzureUriStyleHost, 443, 1000, true,
+                    NULL, NULL)),
             "new azure storage - shared key");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -440,7 +441,8 @@ testRun(void)
             (StorageAzure *)storageDriver(
                 storageAzureNew(
                     STRDEF("/repo"), false, NULL, TEST_CONTAINER_STR, TEST_ACCOUNT_STR, storageAzureKeyTypeSas, TEST_KEY_SAS_STR,
-                    16, NULL, STRDEF("blob.core.usgovcloudapi.net"), storageAzureUriStyleHost, 443, 1000, true, NULL, NULL)),
+                    16, 1, 1, NULL, STRDEF("blob.core.usgovcloudapi.net"), storageAzureUriStyleHost, 443, 1000, true, NULL,
+                    NULL)),
             "new azure storage - sas key");
 
         query = httpQueryAdd(httpQueryNewP(), STRDEF("a"), STRDEF("b"));
@@ -896,6 +898,53 @@ testRun(void)
                     "test3.txt\n",
                     .level = storageInfoLevelExists, .noRecurse = true, .expression = "^test(1|3)");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("write file in chunks with concurrent block uploads");
+
+                // Allow two blocks to be uploaded at the same time. The second block requires a new connection since the first is
+                // busy.
+                driver->blockMax = 2;
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?blockid=0AAAAAAACCCCCCCEx0000000&comp=block", .content = "1234567890123456");
+
+                hrnServerScriptSession(service, 1);
+                hrnServerScriptAccept(service);
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?blockid=0AAAAAAACCCCCCCEx0000001&comp=block", .content = "7890123456789012");
+
+                // The oldest block must complete before the third block can be sent
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+                testRequestP(service, HTTP_VERB_PUT, "/file.txt?blockid=0AAAAAAACCCCCCCEx0000002&comp=block", .content = "3456");
+
+                hrnServerScriptSession(service, 1);
+                testResponseP(service);
+
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+
+                // The first connection to be freed is reused to commit the block list
+                hrnServerScriptSession(service, 1);
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?comp=blocklist",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<BlockList>"
+                        "<Uncommitted>0AAAAAAACCCCCCCEx0000000</Uncommitted>"
+                        "<Uncommitted>0AAAAAAACCCCCCCEx0000001</Uncommitted>"
+                        "<Uncommitted>0AAAAAAACCCCCCCEx0000002</Uncommitted>"
+                        "</BlockList>\n");
+                testResponseP(service);
+                hrnServerScriptClose(service);
+
+                hrnServerScriptSession(service, 0);
+
+                driver->fileId = 0x0AAAAAAACCCCCCCE;
+
+                TEST_ASSIGN(write, storageNewWriteP(storage, STRDEF("file.txt")), "new write");
+                TEST_RESULT_VOID(storagePutP(write, BUFSTRDEF("123456789012345678901234567890123456")), "write");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to SAS auth");
 
@@ -1026,6 +1075,55 @@ testRun(void)
 
                 TEST_RESULT_VOID(storagePathRemoveP(storage, STRDEF("/path"), .recurse = true), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove files with concurrent requests");
+
+                // Allow two remove requests at the same time. The second request requires a new connection since the first is busy.
+                driver->requestMax = 2;
+
+                testRequestP(service, HTTP_VERB_GET, "?comp=list&prefix=path%2F&restype=container");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<EnumerationResults>"
+                        "    <Blobs>"
+                        "        <Blob>"
+                        "            <Name>path/test1.txt</Name>"
+                        "            <Properties/>"
+                        "        </Blob>"
+                        "        <Blob>"
+                        "            <Name>path/test2.txt</Name>"
+                        "            <Properties/>"
+                        "        </Blob>"
+                        "        <Blob>"
+                        "            <Name>path/test3.txt</Name>"
+                        "            <Properties/>"
+                        "        </Blob>"
+                        "    </Blobs>"
+                        "    <NextMarker/>"
+                        "</EnumerationResults>");
+
+                testRequestP(service, HTTP_VERB_DELETE, "/path/test1.txt");
+
+                hrnServerScriptSession(service, 1);
+                hrnServerScriptAccept(service);
+                testRequestP(service, HTTP_VERB_DELETE, "/path/test2.txt");
+
+                // The oldest request must complete before the third request can be sent
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+                testRequestP(service, HTTP_VERB_DELETE, "/path/test3.txt");
+
+                hrnServerScriptSession(service, 1);
+                testResponseP(service, .code = 404);
+                hrnServerScriptClose(service);
+
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storagePathRemoveP(storage, STRDEF("/path"), .recurse = true), "remove");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 hrnServerScriptEnd(service);
             }
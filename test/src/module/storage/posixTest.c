@@ -1,7 +1,14 @@
 /***********************************************************************************************************************************
 Test Posix/CIFS Storage
 ***********************************************************************************************************************************/
+#include <signal.h>
+#include <sys/resource.h>
+
+#include "common/io/bufferWrite.h"
+#include "common/io/fdWrite.h"
+#include "common/io/filter/size.h"
 #include "common/io/io.h"
+#include "common/io/uring.h"
 #include "common/time.h"
 #include "storage/read.h"
 #include "storage/write.h"
@@ -602,6 +609,136 @@ testRun(void)
 
         storageRemoveP(storageTest, sourceFile, .errorOnMissing = true);
         storageRemoveP(storageTest, destinationFile, .errorOnMissing = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy directly with offset and limit");
+
+        HRN_STORAGE_PUT_Z(storageTest, "source.txt", "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdef");
+
+        source = storageNewReadP(storageTest, sourceFile, .offset = 2, .limit = VARUINT64(36));
+        destination = storageNewWriteP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(source)), true, "open source");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(destination)), "open destination");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(destination), BUFSTRDEF("--")), "write buffered data");
+        TEST_RESULT_VOID(storageReadCopyP(source, storageWriteIo(destination), .limit = VARUINT64(20)), "copy");
+        TEST_RESULT_VOID(storageReadCopyP(source, storageWriteIo(destination)), "copy remainder");
+        TEST_RESULT_VOID(ioReadClose(storageReadIo(source)), "close source");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(destination)), "close destination");
+
+        TEST_STORAGE_GET(storageTest, "destination.txt", "--CDEFGHIJKLMNOPQRSTUVWXYZ0123456789ab");
+
+#ifdef HAVE_COPY_FILE_RANGE
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy directly to eof");
+
+        source = storageNewReadP(storageTest, sourceFile);
+        destination = storageNewWriteP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(source)), true, "open source");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(destination)), "open destination");
+        TEST_RESULT_BOOL(storageReadCopyP(source, storageWriteIo(destination)), true, "copy");
+        TEST_RESULT_UINT(((StorageReadPosix *)source->driver)->current, 42, "copied directly");
+        TEST_RESULT_BOOL(((StorageReadPosix *)source->driver)->eof, true, "eof");
+        TEST_RESULT_VOID(ioReadClose(storageReadIo(source)), "close source");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(destination)), "close destination");
+
+        TEST_STORAGE_GET(storageTest, "destination.txt", "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdef");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy through user space when the destination is not a regular file");
+
+        int pipeFd[2];
+        THROW_ON_SYS_ERROR(pipe(pipeFd) == -1, KernelError, "unable to create pipe");
+
+        IoWrite *const pipeWrite = ioFdWriteNewOpen(STRDEF("pipe"), pipeFd[1], 1000);
+
+        source = storageNewReadP(storageTest, sourceFile, .limit = VARUINT64(8));
+
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(source)), true, "open source");
+        TEST_RESULT_BOOL(storageReadCopyP(source, pipeWrite), false, "copy");
+        TEST_RESULT_VOID(ioWriteClose(pipeWrite), "close pipe");
+        TEST_RESULT_VOID(ioReadClose(storageReadIo(source)), "close source");
+
+        char pipeBuffer[16];
+        TEST_RESULT_INT(read(pipeFd[0], pipeBuffer, sizeof(pipeBuffer)), 8, "read pipe");
+        TEST_RESULT_Z(zNewFmt("%.8s", pipeBuffer), "ABCDEFGH", "check pipe");
+
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error when copy fails after data has been copied");
+
+        struct rlimit limitSize;
+        THROW_ON_SYS_ERROR(getrlimit(RLIMIT_FSIZE, &limitSize) == -1, AssertError, "unable to get file size limit");
+        signal(SIGXFSZ, SIG_IGN);
+
+        source = storageNewReadP(storageTest, sourceFile);
+        destination = storageNewWriteP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(source)), true, "open source");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(destination)), "open destination");
+
+        THROW_ON_SYS_ERROR(
+            setrlimit(RLIMIT_FSIZE, &(struct rlimit){.rlim_cur = 16, .rlim_max = limitSize.rlim_max}) == -1, AssertError,
+            "unable to set file size limit");
+
+        TEST_ERROR_FMT(
+            storageReadCopyP(source, storageWriteIo(destination)), FileReadError, "unable to copy '%s': [27] File too large",
+            strZ(sourceFile));
+
+        THROW_ON_SYS_ERROR(setrlimit(RLIMIT_FSIZE, &limitSize) == -1, AssertError, "unable to reset file size limit");
+        signal(SIGXFSZ, SIG_DFL);
+
+        TEST_RESULT_UINT(((StorageReadPosix *)source->driver)->current, 16, "copied before error");
+
+        storageReadFree(source);
+        storageWriteFree(destination);
+#endif // HAVE_COPY_FILE_RANGE
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy through user space when the driver cannot copy directly");
+
+        source = storageNewReadP(storageTest, sourceFile, .limit = VARUINT64(4));
+        destination = storageNewWriteP(storageTest, destinationFile);
+        ((StorageReadPosix *)source->driver)->interface.copy = NULL;
+
+        TEST_RESULT_BOOL(storageCopyP(source, destination), true, "copy");
+        TEST_STORAGE_GET(storageTest, "destination.txt", "ABCD");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy through user space when the destination has no file descriptor");
+
+        Buffer *const bufferCopy = bufNew(0);
+
+        source = storageNewReadP(storageTest, sourceFile, .limit = VARUINT64(4));
+
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(source)), true, "open source");
+        IoWrite *const bufferWrite = ioBufferWriteNew(bufferCopy);
+        ioWriteOpen(bufferWrite);
+        TEST_RESULT_BOOL(storageReadCopyP(source, bufferWrite), false, "copy");
+        ioWriteClose(bufferWrite);
+        TEST_RESULT_STR_Z(strNewBuf(bufferCopy), "ABCD", "check buffer");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy through user space when there are filters");
+
+        source = storageNewReadP(storageTest, sourceFile, .limit = VARUINT64(4));
+        destination = storageNewWriteP(storageTest, destinationFile);
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), ioSizeNew());
+
+        TEST_RESULT_BOOL(storageCopyP(source, destination), true, "copy with read filter");
+        TEST_STORAGE_GET(storageTest, "destination.txt", "ABCD");
+
+        source = storageNewReadP(storageTest, sourceFile, .limit = VARUINT64(4));
+        destination = storageNewWriteP(storageTest, destinationFile);
+        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), ioSizeNew());
+
+        TEST_RESULT_BOOL(storageCopyP(source, destination), true, "copy with write filter");
+        TEST_STORAGE_GET(storageTest, "destination.txt", "ABCD", .remove = true);
+
+        storageRemoveP(storageTest, sourceFile, .errorOnMissing = true);
     }
 
     // *****************************************************************************************************************************
@@ -1271,6 +1408,24 @@ testRun(void)
         TEST_RESULT_VOID(storageReadFree(storageNewReadP(storageTest, fileName)), "free file");
 
         TEST_RESULT_VOID(storageReadMove(NULL, memContextTop()), "move null file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("drop read data from page cache");
+
+        ioBufferSizeSet(2);
+        ioCacheDropSet(true);
+
+        HRN_STORAGE_PUT_Z(storageTest, "cache.file", "0123456789ABCDEFGHIJKLMNOPQRSTUV");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, STRDEF("cache.file")), "new read file");
+        TEST_RESULT_STR_Z(strNewBuf(storageGetP(file)), "0123456789ABCDEFGHIJKLMNOPQRSTUV", "read file");
+        TEST_RESULT_UINT(((StorageReadPosix *)file->driver)->cacheDropped, 32, "all data dropped");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, STRDEF("cache.file"), .offset = 4, .limit = VARUINT64(20)), "new read file");
+        TEST_RESULT_STR_Z(strNewBuf(storageGetP(file)), "456789ABCDEFGHIJKLMN", "read file");
+        TEST_RESULT_UINT(((StorageReadPosix *)file->driver)->cacheDropped, 20, "all data dropped");
+
+        ioCacheDropSet(false);
     }
 
     // *****************************************************************************************************************************
@@ -1431,6 +1586,215 @@ testRun(void)
         TEST_STORAGE_GET(storageTest, "no-truncate", "ABC");
         TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("no-truncate")).mode, 0600, "check mode");
         TEST_RESULT_INT(storageInfoP(storageTest, STRDEF("no-truncate")).timeModified, 77777, "check time");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("drop written data from page cache");
+
+        ioBufferSizeSet(2);
+        ioCacheDropSet(true);
+
+        TEST_ASSIGN(file, storageNewWriteP(storageTest, STRDEF("cache.file")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("0123456789ABCDEFGHIJ")), "write");
+        TEST_RESULT_UINT(((StorageWritePosix *)file->driver)->cacheWritten, 4, "data written since drop");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+        TEST_RESULT_UINT(((StorageWritePosix *)file->driver)->cacheWritten, 0, "data dropped on close");
+
+        TEST_STORAGE_GET(storageTest, "cache.file", "0123456789ABCDEFGHIJ");
+
+        ioCacheDropSet(false);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("StorageRead, StorageWrite, and storagePathSync() with io_uring"))
+    {
+#ifdef HAVE_IO_URING
+        ioBufferSizeSet(4);
+        ioUringEnabledSet(true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write file with sync, close, rename, and path sync submitted together");
+
+        TEST_RESULT_VOID(
+            storagePutP(storageNewWriteP(storageTest, STRDEF("test.file"), .timeModified = 1555160000), BUFSTRDEF("ABC")),
+            "put file");
+        TEST_RESULT_INT(storageInfoP(storageTest, STRDEF("test.file")).timeModified, 1555160000, "check mod time");
+        TEST_RESULT_BOOL(storageExistsP(storageTest, STRDEF("test.file.pgbackrest.tmp")), false, "temp file renamed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write file with sync and close submitted together when rename is not available");
+
+        ioUringLocal.renameAvailable = false;
+
+        TEST_RESULT_VOID(
+            storagePutP(storageNewWriteP(storageTest, STRDEF("test.file"), .timeModified = 1555155555), BUFSTRDEF("ABC")),
+            "put file");
+        TEST_RESULT_INT(storageInfoP(storageTest, STRDEF("test.file")).timeModified, 1555155555, "check mod time");
+
+        ioUringLocal.renameAvailable = true;
+
+        HRN_STORAGE_PUT_Z(storageTest, "test.file", "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file");
+
+        TEST_STORAGE_GET(storageTest, "test.file", "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file with offset and limit into a buffer smaller than the reads");
+
+        StorageRead *file = NULL;
+        Buffer *buffer = bufNew(3);
+
+        TEST_ASSIGN(
+            file, storageNewReadP(storageTest, STRDEF("test.file"), .offset = 1, .limit = VARUINT64(12)), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file)), true, "open file");
+        TEST_RESULT_UINT(((StorageReadPosix *)file->driver)->aheadTotal, 3, "reads ahead limited to the read size");
+
+        TEST_RESULT_UINT(storageReadPosix(file->driver, buffer, true), 3, "read");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "BCD", "check buffer");
+        TEST_RESULT_BOOL(storageReadPosixEof(file->driver), false, "not eof");
+
+        bufUsedZero(buffer);
+        TEST_RESULT_UINT(storageReadPosix(file->driver, buffer, true), 3, "read");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "EFG", "check buffer");
+
+        bufUsedZero(buffer);
+        TEST_RESULT_UINT(storageReadPosix(file->driver, buffer, true), 3, "read");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "HIJ", "check buffer");
+
+        bufUsedZero(buffer);
+        TEST_RESULT_UINT(storageReadPosix(file->driver, buffer, true), 3, "read");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "KLM", "check buffer");
+        TEST_RESULT_BOOL(storageReadPosixEof(file->driver), true, "eof");
+
+        bufUsedZero(buffer);
+        TEST_RESULT_UINT(storageReadPosix(file->driver, buffer, true), 0, "read at eof");
+        TEST_RESULT_VOID(ioReadClose(storageReadIo(file)), "close file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file with zero limit");
+
+        TEST_RESULT_STR_Z(
+            strNewBuf(storageGetP(storageNewReadP(storageTest, STRDEF("test.file"), .limit = VARUINT64(0)))), "", "read file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file smaller than a buffer with blocking IO");
+
+        HRN_STORAGE_PUT_Z(storageTest, "test.small", "ABC");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, STRDEF("test.small")), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file)), true, "open file");
+        TEST_RESULT_UINT(((StorageReadPosix *)file->driver)->aheadTotal, 0, "no reads ahead");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(storageReadIo(file))), "ABC", "read file");
+        TEST_RESULT_VOID(storageReadFree(file), "free file");
+
+        HRN_STORAGE_REMOVE(storageTest, "test.small");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("free files with reads in progress and read with blocking IO when no buffers are free");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, STRDEF("test.file")), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file)), true, "open file");
+
+        StorageRead *file2 = NULL;
+
+        TEST_ASSIGN(file2, storageNewReadP(storageTest, STRDEF("test.file")), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file2)), true, "open file");
+
+        StorageRead *file3 = NULL;
+
+        TEST_ASSIGN(file3, storageNewReadP(storageTest, STRDEF("test.file"), .offset = 20), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file3)), true, "open file");
+        TEST_RESULT_UINT(((StorageReadPosix *)file3->driver)->aheadTotal, 0, "no reads ahead");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(storageReadIo(file3))), "UVWXYZ", "read file");
+
+        TEST_RESULT_VOID(storageReadFree(file), "free file");
+        TEST_RESULT_VOID(storageReadFree(file2), "free file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read error");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, STRDEF(TEST_PATH)), "new read path");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file)), true, "open path");
+        TEST_ERROR(
+            ioRead(storageReadIo(file), buffer), FileReadError, "unable to read '" TEST_PATH "': [21] Is a directory");
+        TEST_RESULT_VOID(storageReadFree(file), "free path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sync error");
+
+        StorageWrite *fileWrite = NULL;
+
+        TEST_ASSIGN(fileWrite, storageNewWriteP(storageTest, STRDEF("test.file")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(fileWrite)), "open file");
+
+        // Replace the file descriptor with one that is not open so operations will fail. Closing the file descriptor is not enough
+        // since the path would then be opened with the same file descriptor.
+        close(((StorageWritePosix *)fileWrite->driver)->fd);
+        ((StorageWritePosix *)fileWrite->driver)->fd = INT_MAX;
+
+        TEST_ERROR(
+            storageWritePosixClose(fileWrite->driver), FileSyncError,
+            "unable to sync file '" TEST_PATH "/test.file.pgbackrest.tmp' after write: [9] Bad file descriptor");
+
+        // Clear the free callback so the close on free will not fail
+        memContextCallbackClear(objMemContext(fileWrite->driver));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("set time error");
+
+        TEST_ASSIGN(
+            fileWrite, storageNewWriteP(storageTest, STRDEF("test.file"), .timeModified = 1555160000), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(fileWrite)), "open file");
+
+        // Replace the file descriptor with one that is not open so operations will fail. Closing the file descriptor is not enough
+        // since the path would then be opened with the same file descriptor.
+        close(((StorageWritePosix *)fileWrite->driver)->fd);
+        ((StorageWritePosix *)fileWrite->driver)->fd = INT_MAX;
+
+        TEST_ERROR(
+            storageWritePosixClose(fileWrite->driver), FileInfoError,
+            "unable to set time for '" TEST_PATH "/test.file.pgbackrest.tmp': [9] Bad file descriptor");
+
+        // Clear the free callback so the close on free will not fail
+        memContextCallbackClear(objMemContext(fileWrite->driver));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("rename error");
+
+        HRN_STORAGE_PATH_CREATE(storageTest, "test.path/sub");
+
+        TEST_ERROR(
+            storagePutP(storageNewWriteP(storageTest, STRDEF("test.path")), BUFSTRDEF("ABC")), FileMoveError,
+            "unable to move '" TEST_PATH "/test.path.pgbackrest.tmp' to '" TEST_PATH "/test.path': [21] Is a directory");
+
+        HRN_STORAGE_PATH_REMOVE(storageTest, "test.path", .recurse = true);
+        HRN_STORAGE_REMOVE(storageTest, "test.path.pgbackrest.tmp");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("path sync");
+
+        TEST_ERROR_FMT(
+            storagePathSyncP(storagePosixNewP(STRDEF("/"), .write = true), STRDEF("/proc")),
+            PathSyncError, STORAGE_ERROR_PATH_SYNC ": [22] Invalid argument", "/proc");
+        TEST_RESULT_VOID(storagePathSyncP(storageTest, TEST_PATH_STR), "sync path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sync and close without io_uring when dropping written data from page cache");
+
+        ioCacheDropSet(true);
+
+        TEST_ASSIGN(fileWrite, storageNewWriteP(storageTest, STRDEF("test.file")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(fileWrite)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(fileWrite), BUFSTRDEF("AB")), "write");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(fileWrite)), "close file");
+        TEST_RESULT_UINT(((StorageWritePosix *)fileWrite->driver)->cacheWritten, 0, "data dropped on close");
+
+        ioCacheDropSet(false);
+
+        ioUringEnabledSet(false);
+#endif // HAVE_IO_URING
     }
 
     // *****************************************************************************************************************************
@@ -1584,6 +1948,11 @@ testRun(void)
             storagePathP(storage, STRDEF(STORAGE_SPOOL_ARCHIVE_IN "/file.ext")), TEST_PATH "/archive/db/in/file.ext",
             "check spool in file");
 
+        TEST_RESULT_STR_Z(storagePathP(storage, STORAGE_SPOOL_BACKUP_STR), TEST_PATH "/backup/db", "check spool backup path");
+        TEST_RESULT_STR_Z(
+            storagePathP(storage, STRDEF(STORAGE_SPOOL_BACKUP "/file.ext")), TEST_PATH "/backup/db/file.ext",
+            "check spool backup file");
+
         TEST_ERROR(storagePathP(storage, STRDEF("<" BOGUS_STR ">")), AssertError, "invalid expression '<BOGUS>'");
 
         TEST_ERROR(storageNewWriteP(storage, writeFile), AssertError, "assertion 'this->write' failed");
@@ -94,6 +94,28 @@ testRun(void)
         TEST_RESULT_STR_Z(storagePathP(storageRepo, NULL), TEST_PATH "/repo128", "check repo path");
         TEST_RESULT_STR_Z(storagePathP(storageRepoWrite, NULL), TEST_PATH "/repo128", "check repo write path");
         TEST_RESULT_STR_Z(storagePathP(storagePgWrite, NULL), TEST_PATH "/pg256", "check pg write path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("network compression type supported by remote");
+
+        TEST_RESULT_UINT(((StorageRemote *)storageDriver(storageRepo))->compressType, compressTypeGz, "check compress type");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("network compression type not supported by remote");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        const Storage *storageRemote = NULL;
+        TEST_ASSIGN(
+            storageRemote,
+            storageRemoteNew(
+                STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, false, NULL, protocolRemoteGet(protocolStorageTypeRepo, 0),
+                compressTypeXz, 3),
+            "new storage");
+        TEST_RESULT_UINT(((StorageRemote *)storageDriver(storageRemote))->compressType, compressTypeGz, "check compress type");
+        TEST_RESULT_LOG("P00 DETAIL: remote does not support network compression type 'xz', using 'gz' instead");
+
+        harnessLogLevelReset();
     }
 
     // *****************************************************************************************************************************
@@ -346,6 +368,32 @@ testRun(void)
         TEST_RESULT_BOOL(
             ((StorageReadRemote *)fileRead->driver)->protocolReadBytes < bufSize(contentBuf), true, "check compressed read size");
 
+#ifdef HAVE_LIBLZ4
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file with lz4 compression");
+
+        ((StorageRemote *)storageDriver(storageRepo))->compressType = compressTypeLz4;
+
+        TEST_ASSIGN(
+            fileRead, storageNewReadP(storageRepo, STRDEF("test.txt"), .compressible = true), "get file (protocol compress)");
+        TEST_RESULT_BOOL(bufEq(storageGetP(fileRead), contentBuf), true, "check contents");
+        TEST_RESULT_BOOL(
+            ((StorageReadRemote *)fileRead->driver)->protocolReadBytes < bufSize(contentBuf), true, "check compressed read size");
+
+        ((StorageRemote *)storageDriver(storageRepo))->compressType = compressTypeGz;
+#endif
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("network compression type none");
+
+        ((StorageRemote *)storageDriver(storageRepo))->compressType = compressTypeNone;
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storageRepo, STRDEF("test.txt"), .compressible = true), "get file (no compress)");
+        TEST_RESULT_BOOL(bufEq(storageGetP(fileRead), contentBuf), true, "check contents");
+        TEST_RESULT_UINT(((StorageReadRemote *)fileRead->driver)->protocolReadBytes, bufSize(contentBuf), "check read size");
+
+        ((StorageRemote *)storageDriver(storageRepo))->compressType = compressTypeGz;
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("file missing");
 
@@ -472,6 +520,22 @@ testRun(void)
         TEST_RESULT_VOID(storagePutP(write, contentBuf), "write file");
         TEST_RESULT_BOOL(
             ((StorageWriteRemote *)write->driver)->protocolWriteBytes < bufSize(contentBuf), true, "check compressed write size");
+
+#ifdef HAVE_LIBLZ4
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write the file again with lz4 protocol compression");
+
+        ((StorageRemote *)storageDriver(storageRepoWrite))->compressType = compressTypeLz4;
+
+        TEST_ASSIGN(
+            write, storageNewWriteP(storageRepoWrite, STRDEF("test2.txt"), .compressible = true), "new write file (compress)");
+        TEST_RESULT_VOID(storagePutP(write, contentBuf), "write file");
+        TEST_RESULT_BOOL(
+            ((StorageWriteRemote *)write->driver)->protocolWriteBytes < bufSize(contentBuf), true, "check compressed write size");
+        TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storageRepo, STRDEF("test2.txt"))), contentBuf), true, "check file");
+
+        ((StorageRemote *)storageDriver(storageRepoWrite))->compressType = compressTypeGz;
+#endif
     }
 
     // *****************************************************************************************************************************
@@ -458,6 +458,7 @@ testRun(void)
                 TEST_RESULT_STR(s3->path, path, "check path");
                 TEST_RESULT_BOOL(storageFeature(s3, storageFeaturePath), false, "check path feature");
                 TEST_RESULT_UINT(driver->partSize, 5 * 1024 * 1024, "check part size");
+                TEST_RESULT_UINT(driver->partMax, 1, "check part max");
 
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("coverage for noop functions");
@@ -935,6 +936,69 @@ testRun(void)
 
                 TEST_RESULT_BOOL(storageInfoP(s3, NULL, .ignoreMissing = true).exists, false, "info for /");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("write file in chunks with concurrent part uploads");
+
+                // Allow two parts to be uploaded at the same time. The second part requires a new connection since the first is
+                // busy.
+                driver->partMax = 2;
+
+                testRequestP(service, s3, HTTP_VERB_POST, "/file.txt?uploads=", .kms = "kmskey1", .sseC = "rA1P");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<InitiateMultipartUploadResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "<Bucket>bucket</Bucket>"
+                        "<Key>file.txt</Key>"
+                        "<UploadId>CC33</UploadId>"
+                        "</InitiateMultipartUploadResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_PUT, "/file.txt?partNumber=1&uploadId=CC33", .content = "1234567890123456",
+                    .sseC = "rA1P");
+
+                hrnServerScriptSession(service, 1);
+                hrnServerScriptAccept(service);
+                testRequestP(
+                    service, s3, HTTP_VERB_PUT, "/file.txt?partNumber=2&uploadId=CC33", .content = "7890123456789012",
+                    .sseC = "rA1P");
+
+                // The oldest part must complete before the third part can be sent
+                hrnServerScriptSession(service, 0);
+                testResponseP(service, .header = "etag:CC331");
+                testRequestP(
+                    service, s3, HTTP_VERB_PUT, "/file.txt?partNumber=3&uploadId=CC33", .content = "34567890", .sseC = "rA1P");
+
+                hrnServerScriptSession(service, 1);
+                testResponseP(service, .header = "etag:CC332");
+
+                hrnServerScriptSession(service, 0);
+                testResponseP(service, .header = "etag:CC333");
+
+                // The first connection to be freed is reused to complete the upload
+                hrnServerScriptSession(service, 1);
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/file.txt?uploadId=CC33",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<CompleteMultipartUpload>"
+                        "<Part><PartNumber>1</PartNumber><ETag>CC331</ETag></Part>"
+                        "<Part><PartNumber>2</PartNumber><ETag>CC332</ETag></Part>"
+                        "<Part><PartNumber>3</PartNumber><ETag>CC333</ETag></Part>"
+                        "</CompleteMultipartUpload>\n");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<CompleteMultipartUploadResult><ETag>XXX</ETag></CompleteMultipartUploadResult>");
+                hrnServerScriptClose(service);
+
+                hrnServerScriptSession(service, 0);
+
+                TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt")), "new write");
+                TEST_RESULT_VOID(storagePutP(write, BUFSTRDEF("1234567890123456789012345678901234567890")), "write");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to service credentials");
 
@@ -1445,6 +1509,205 @@ testRun(void)
 
                 TEST_RESULT_VOID(storageRemoveP(s3, STRDEF("/path/to/test.txt")), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("list path with list split into key ranges");
+
+                // Allow two list requests at the same time. No split character sorts after the last key on the first page so the
+                // rest of the list is a single range starting after the last key.
+                driver->requestMax = 2;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>true</IsTruncated>"
+                        "    <NextContinuationToken>continue</NextContinuationToken>"
+                        "    <Contents><Key>path/a.txt</Key></Contents>"
+                        "    <CommonPrefixes><Prefix>path/b/</Prefix></CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F&start-after=path%2Fb%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents><Key>path/c.txt</Key></Contents>"
+                        "    <CommonPrefixes><Prefix>path/d/</Prefix></CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                TEST_STORAGE_LIST(
+                    s3, "/path",
+                    "a.txt\n"
+                    "b/\n"
+                    "c.txt\n"
+                    "d/\n",
+                    .noRecurse = true);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove files with concurrent requests");
+
+                // Allow two delete requests at the same time. The second request requires a new connection since the first is busy.
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents><Key>path/test1.txt</Key></Contents>"
+                        "    <Contents><Key>path/test2.txt</Key></Contents>"
+                        "    <Contents><Key>path/test3.txt</Key></Contents>"
+                        "    <Contents><Key>path/test4.txt</Key></Contents>"
+                        "    <Contents><Key>path/test5.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/test1.txt</Key></Object>"
+                        "<Object><Key>path/test2.txt</Key></Object>"
+                        "</Delete>\n");
+
+                hrnServerScriptSession(service, 1);
+                hrnServerScriptAccept(service);
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/test3.txt</Key></Object>"
+                        "<Object><Key>path/test4.txt</Key></Object>"
+                        "</Delete>\n");
+
+                // The oldest request must complete before the third request can be sent
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/test5.txt</Key></Object>"
+                        "</Delete>\n");
+
+                hrnServerScriptSession(service, 1);
+                testResponseP(service);
+                hrnServerScriptClose(service);
+
+                hrnServerScriptSession(service, 0);
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path"), .recurse = true), "remove path");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove files with list split into key ranges");
+
+                // Send all deletes in one request so only the list requests are concurrent
+                driver->deleteMax = 1000;
+
+                // The first page is truncated so the rest of the list is split after the last key on the first page
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>true</IsTruncated>"
+                        "    <NextContinuationToken>continue</NextContinuationToken>"
+                        "    <Contents><Key>path/0.txt</Key></Contents>"
+                        "    <Contents><Key>path/D.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                // First pages for the first two ranges are requested at the same time
+                testRequestP(
+                    service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F&start-after=path%2FD.txt");
+
+                hrnServerScriptSession(service, 1);
+                hrnServerScriptAccept(service);
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F&start-after=path%2FE");
+
+                // All pages for the first range are listed before moving on and keys past the end of the range are skipped
+                hrnServerScriptSession(service, 0);
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>true</IsTruncated>"
+                        "    <NextContinuationToken>continue</NextContinuationToken>"
+                        "    <Contents><Key>path/D1.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_GET,
+                    "/bucket/?continuation-token=continue&list-type=2&prefix=path%2F&start-after=path%2FD.txt");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>true</IsTruncated>"
+                        "    <NextContinuationToken>continue2</NextContinuationToken>"
+                        "    <Contents><Key>path/D2.txt</Key></Contents>"
+                        "    <Contents><Key>path/E</Key></Contents>"
+                        "    <Contents><Key>path/E.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                // The last range is requested once the first range is complete
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F&start-after=path%2FF");
+
+                hrnServerScriptSession(service, 1);
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents><Key>path/E.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                hrnServerScriptSession(service, 0);
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents><Key>path/F.txt</Key></Contents>"
+                        "    <Contents><Key>path/a.txt</Key></Contents>"
+                        "</ListBucketResult>");
+
+                // The oldest idle session is reused for the delete
+                hrnServerScriptSession(service, 1);
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/0.txt</Key></Object>"
+                        "<Object><Key>path/D.txt</Key></Object>"
+                        "<Object><Key>path/D1.txt</Key></Object>"
+                        "<Object><Key>path/D2.txt</Key></Object>"
+                        "<Object><Key>path/E</Key></Object>"
+                        "<Object><Key>path/E.txt</Key></Object>"
+                        "<Object><Key>path/F.txt</Key></Object>"
+                        "<Object><Key>path/a.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+                hrnServerScriptClose(service);
+
+                hrnServerScriptSession(service, 0);
+
+                TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path"), .recurse = true), "remove path");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 hrnServerScriptEnd(service);
             }